@@ -16,6 +16,19 @@ function(set_precision precision_name)
   endif()
 endfunction()
 
+# ------------------------------ Shape order ------------------------------- #
+function(set_shape_order order)
+  list(FIND shape_orders ${order} SHAPE_ORDER_FOUND)
+
+  if(${SHAPE_ORDER_FOUND} EQUAL -1)
+    message(
+      FATAL_ERROR
+        "Invalid shape order: ${order}\nValid options are: ${shape_orders}")
+  endif()
+
+  add_compile_options("-DSHAPE_ORDER=${order}")
+endfunction()
+
 # ---------------------------- Problem generator --------------------------- #
 function(set_problem_generator pgen_name)
   if(pgen_name STREQUAL ".")
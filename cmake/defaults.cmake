@@ -19,6 +19,9 @@ set(default_engine
 set(default_precision
     "single"
     CACHE INTERNAL "Default precision")
+set(default_shape_order
+    "1"
+    CACHE INTERNAL "Default particle shape order")
 set(default_pgen
     "."
     CACHE INTERNAL "Default problem generator")
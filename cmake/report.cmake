@@ -37,6 +37,15 @@ printchoices(
   "${Blue}"
   PRECISION_REPORT
   46)
+printchoices(
+  "Shape order"
+  "shape_order"
+  "${shape_orders}"
+  ${shape_order}
+  ${default_shape_order}
+  "${Blue}"
+  SHAPE_ORDER_REPORT
+  46)
 printchoices(
   "Output"
   "output"
@@ -113,6 +122,9 @@ string(
   ${PRECISION_REPORT}
   "\n"
   "  "
+  ${SHAPE_ORDER_REPORT}
+  "\n"
+  "  "
   ${OUTPUT_REPORT}
   "\n")
 
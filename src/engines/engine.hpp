@@ -62,9 +62,11 @@ namespace ntt {
   #endif
 #endif
 
-    SimulationParams m_params;
-    Metadomain<S, M> m_metadomain;
-    user::PGen<S, M> m_pgen;
+    SimulationParams   m_params;
+    // typed copy of the parameters used in the algorithm loop
+    const EngineParams m_eparams;
+    Metadomain<S, M>   m_metadomain;
+    user::PGen<S, M>   m_pgen;
 
     const bool       is_resuming;
     const simtime_t  runtime;
@@ -87,6 +89,7 @@ namespace ntt {
 
     Engine(const SimulationParams& params)
       : m_params { params }
+      , m_eparams { m_params }
       , m_metadomain { m_params.get<unsigned int>("simulation.domain.number"),
                        m_params.get<std::vector<int>>(
                          "simulation.domain.decomposition"),
@@ -119,6 +122,20 @@ namespace ntt {
 
     virtual void step_forward(timer::Timers&, Domain<S, M>&) = 0;
 
+    /**
+     * @brief Advance all the local domains by one timestep
+     * @note Defaults to the per-domain step, which only supports a single
+     * local domain; engines override it to step several domains per rank
+     */
+    virtual void step_forward(timer::Timers& timers) {
+      raise::ErrorIf(m_metadomain.l_subdomain_indices().size() != 1,
+                     "Engine does not support multiple domains per rank",
+                     HERE);
+      m_metadomain.runOnLocalDomains([&timers, this](auto& dom) {
+        step_forward(timers, dom);
+      });
+    }
+
     void run();
   };
 
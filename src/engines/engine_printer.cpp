@@ -469,8 +469,38 @@ namespace ntt {
                                        species.index(),
                                        species.label().c_str());
           auto [size, unit] = bytes_to_human_readable(species.memory_footprint());
-          add_param(report, 10, str.c_str(), "%.2f %s", size, unit.c_str());
+          if (species.store_prev()) {
+            add_param(report, 10, str.c_str(), "%.2f %s", size, unit.c_str());
+          } else {
+            // lean layout: `*_prev` coordinates are not allocated
+            auto [saved, saved_unit] = bytes_to_human_readable(
+              species.maxnpart() * static_cast<std::size_t>(M::Dim) *
+              (sizeof(int) + sizeof(prtldx_t)));
+            add_param(report,
+                      10,
+                      str.c_str(),
+                      "%.2f %s (lean: %.2f %s saved)",
+                      size,
+                      unit.c_str(),
+                      saved,
+                      saved_unit.c_str());
+          }
+        }
+#if defined(MPI_ENABLED)
+        {
+          // persistent buffers are shared by all the domains of a rank
+          const auto& pool            = m_metadomain.comm_buffers();
+          auto [pool_size, pool_unit] = bytes_to_human_readable(
+            pool.memory_footprint());
+          add_param(report,
+                    8,
+                    "Comm buffers",
+                    "%.2f %s (%zu buffers)",
+                    pool_size,
+                    pool_unit.c_str(),
+                    pool.nbuffers());
         }
+#endif
         report.pop_back();
         if (idx == m_metadomain.ndomains() - 1) {
           report += "\n\n";
@@ -21,8 +21,8 @@ namespace ntt {
          "ParticlePusher", "FieldBoundaries",
          "ParticleBoundaries", "Communications",
          "Injector", "Custom",
-         "PrtlClear", "Output",
-         "Checkpoint" },
+         "PrtlClear", "PrtlSort",
+         "Output", "Checkpoint" },
         []() {
           Kokkos::fence();
          },
@@ -34,13 +34,19 @@ namespace ntt {
       auto       time_history   = pbar::DurationHistory { 1000 };
       const auto clear_interval = m_params.template get<timestep_t>(
         "particles.clear_interval");
+      const auto sort_interval = m_params.template get<timestep_t>(
+        "particles.sort_interval");
+#if defined(MPI_ENABLED)
+      const auto rebalance_interval = m_params.template get<timestep_t>(
+        "simulation.domain.rebalance.interval");
+      // time spent on particles since the last rebalance
+      duration_t prtl_time = 0.0;
+#endif
 
       // main algorithm loop
       while (step < max_steps) {
         // run the engine-dependent algorithm step
-        m_metadomain.runOnLocalDomains([&timers, this](auto& dom) {
-          step_forward(timers, dom);
-        });
+        step_forward(timers);
         // poststep (if defined)
         if constexpr (
           traits::has_method<traits::pgen::custom_poststep_t, decltype(m_pgen)>::value) {
@@ -52,6 +58,8 @@ namespace ntt {
         }
         auto print_prtl_clear = (clear_interval > 0 and
                                  step % clear_interval == 0 and step > 0);
+        auto print_prtl_sort  = (sort_interval > 0 and
+                                step % sort_interval == 0 and step > 0);
 
         // advance time & step
         time += dt;
@@ -112,6 +120,14 @@ namespace ntt {
         timers.stop("Checkpoint");
 #endif
 
+#if defined(MPI_ENABLED)
+        prtl_time += timers.get("ParticlePusher") + timers.get("CurrentDeposit");
+        if (rebalance_interval > 0 and step % rebalance_interval == 0) {
+          m_metadomain.Rebalance(m_params, prtl_time);
+          prtl_time = 0.0;
+        }
+#endif
+
         // advance time_history
         time_history.tick();
         // print timestep report
@@ -128,12 +144,16 @@ namespace ntt {
             m_metadomain.l_npart_perspec(),
             m_metadomain.l_maxnpart_perspec(),
             print_prtl_clear,
+            print_prtl_sort,
             print_output,
             print_checkpoint,
             m_params.get<bool>("diagnostics.colored_stdout"));
         }
         timers.resetAll();
       }
+#if defined(OUTPUT_ENABLED)
+      m_metadomain.FinishWriting();
+#endif
     }
   }
 
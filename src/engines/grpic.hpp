@@ -74,6 +74,7 @@ namespace ntt {
     using base_t::pgen_is_ok;
     // contents
     using base_t::m_metadomain;
+    using base_t::m_eparams;
     using base_t::m_params;
     using base_t::m_pgen;
     // methods
@@ -93,12 +94,10 @@ namespace ntt {
     ~GRPICEngine() = default;
 
     void step_forward(timer::Timers& timers, domain_t& dom) override {
-      const auto fieldsolver_enabled = m_params.template get<bool>(
-        "algorithms.toggles.fieldsolver");
-      const auto deposit_enabled = m_params.template get<bool>(
-        "algorithms.toggles.deposit");
-      const auto clear_interval = m_params.template get<std::size_t>(
-        "particles.clear_interval");
+      const auto fieldsolver_enabled = m_eparams.toggles.fieldsolver;
+      const auto deposit_enabled     = m_eparams.toggles.deposit;
+      const auto clear_interval      = m_eparams.particles.clear_interval;
+      const auto sort_interval       = m_eparams.particles.sort_interval;
 
       if (step == 0) {
         if (fieldsolver_enabled) {
@@ -539,6 +538,14 @@ namespace ntt {
         timers.stop("PrtlClear");
       }
 
+      if (sort_interval > 0 and step % sort_interval == 0 and step > 0) {
+        timers.start("PrtlSort");
+        m_metadomain.SortParticles(dom,
+                                   m_eparams.particles.sort_tile,
+                                   m_eparams.particles.sort_morton);
+        timers.stop("PrtlSort");
+      }
+
       /**
        * Finally: em0::B   at n-1/2
        *          em0::D   at n
@@ -592,9 +599,8 @@ namespace ntt {
       /**
        * match boundaries
        */
-      const auto ds_array = m_params.template get<boundaries_t<real_t>>(
-        "grid.boundaries.match.ds");
-      const auto dim = direction.get_dim();
+      const auto& ds_array = m_eparams.match_ds;
+      const auto  dim      = direction.get_dim();
       real_t     xg_min, xg_max, xg_edge;
       auto       sign = direction.get_sign();
 
@@ -690,8 +696,7 @@ namespace ntt {
       const auto i1_min = domain.mesh.i_min(in::x1);
       auto range = CreateRangePolicy<Dim::_1D>({ domain.mesh.i_min(in::x2) },
                                                { domain.mesh.i_max(in::x2) + 1 });
-      const auto nfilter = m_params.template get<unsigned short>(
-        "algorithms.current_filters");
+      const auto nfilter = m_eparams.current_filters;
       if (g == gr_bc::main) {
         Kokkos::parallel_for(
           "OpenBCFields",
@@ -855,10 +860,7 @@ namespace ntt {
 
     void Faraday(domain_t& domain, const gr_faraday& g, real_t fraction = ONE) {
       logger::Checkpoint("Launching Faraday kernel", HERE);
-      const auto dT = fraction *
-                      m_params.template get<real_t>(
-                        "algorithms.timestep.correction") *
-                      dt;
+      const auto dT = fraction * m_eparams.correction * dt;
       if (g == gr_faraday::aux) {
         Kokkos::parallel_for(
           "Faraday",
@@ -889,10 +891,7 @@ namespace ntt {
 
     void Ampere(domain_t& domain, const gr_ampere& g, real_t fraction = ONE) {
       logger::Checkpoint("Launching Ampere kernel", HERE);
-      const auto dT = fraction *
-                      m_params.template get<real_t>(
-                        "algorithms.timestep.correction") *
-                      dt;
+      const auto dT = fraction * m_eparams.correction * dt;
       auto range = CreateRangePolicy<Dim::_2D>(
         { domain.mesh.i_min(in::x1), domain.mesh.i_min(in::x2) },
         { domain.mesh.i_max(in::x1), domain.mesh.i_max(in::x2) + 1 });
@@ -938,8 +937,8 @@ namespace ntt {
 
     void AmpereCurrents(domain_t& domain, const gr_ampere& g) {
       logger::Checkpoint("Launching Ampere kernel for adding currents", HERE);
-      const auto q0    = m_params.template get<real_t>("scales.q0");
-      const auto B0    = m_params.template get<real_t>("scales.B0");
+      const auto q0    = m_eparams.scales.q0;
+      const auto B0    = m_eparams.scales.B0;
       const auto coeff = -dt * q0 / B0;
       auto       range = CreateRangePolicy<Dim::_2D>(
         { domain.mesh.i_min(in::x1), domain.mesh.i_min(in::x2) },
@@ -1003,31 +1002,33 @@ namespace ntt {
         if (species.npart() == 0 || cmp::AlmostZero(species.charge())) {
           continue;
         }
-        Kokkos::parallel_for("CurrentsDeposit",
-                             species.rangeActiveParticles(),
-                             kernel::DepositCurrents_kernel<SimEngine::GRPIC, M>(
-                               scatter_cur0,
-                               species.i1,
-                               species.i2,
-                               species.i3,
-                               species.i1_prev,
-                               species.i2_prev,
-                               species.i3_prev,
-                               species.dx1,
-                               species.dx2,
-                               species.dx3,
-                               species.dx1_prev,
-                               species.dx2_prev,
-                               species.dx3_prev,
-                               species.ux1,
-                               species.ux2,
-                               species.ux3,
-                               species.phi,
-                               species.weight,
-                               species.tag,
-                               domain.mesh.metric,
-                               (real_t)(species.charge()),
-                               dt));
+        // first order, consistent with the interpolation of the GR pusher
+        Kokkos::parallel_for(
+          "CurrentsDeposit",
+          species.rangeActiveParticles(),
+          kernel::DepositCurrents_kernel<SimEngine::GRPIC, M, 1>(
+            scatter_cur0,
+            species.i1,
+            species.i2,
+            species.i3,
+            species.i1_prev,
+            species.i2_prev,
+            species.i3_prev,
+            species.dx1,
+            species.dx2,
+            species.dx3,
+            species.dx1_prev,
+            species.dx2_prev,
+            species.dx3_prev,
+            species.ux1,
+            species.ux2,
+            species.ux3,
+            species.phi,
+            species.weight,
+            species.tag,
+            domain.mesh.metric,
+            (real_t)(species.charge()),
+            dt));
       }
       Kokkos::Experimental::contribute(domain.fields.cur0, scatter_cur0);
     }
@@ -1037,8 +1038,7 @@ namespace ntt {
       auto range = CreateRangePolicy<Dim::_2D>(
         { domain.mesh.i_min(in::x1), domain.mesh.i_min(in::x2) },
         { domain.mesh.i_max(in::x1), domain.mesh.i_max(in::x2) + 1 });
-      const auto nfilter = m_params.template get<unsigned short>(
-        "algorithms.current_filters");
+      const auto nfilter = m_eparams.current_filters;
       tuple_t<std::size_t, M::Dim> size;
       size[0] = domain.mesh.n_active(in::x1);
       size[1] = domain.mesh.n_active(in::x2);
@@ -1073,14 +1073,10 @@ namespace ntt {
                                ? species.charge() / species.mass()
                                : ZERO;
         //  coeff = q / m (dt / 2) omegaB0
-        const auto coeff   = q_ovr_m * HALF * dt *
-                           m_params.template get<real_t>(
-                             "algorithms.timestep.correction") *
-                           m_params.template get<real_t>("scales.omegaB0");
-        const auto eps = m_params.template get<real_t>(
-          "algorithms.gr.pusher_eps");
-        const auto niter = m_params.template get<unsigned short>(
-          "algorithms.gr.pusher_niter");
+        const auto coeff   = q_ovr_m * HALF * dt * m_eparams.correction *
+                           m_eparams.scales.omegaB0;
+        const auto eps     = m_eparams.gr.pusher_eps;
+        const auto niter   = m_eparams.gr.pusher_niter;
         // clang-format off
         if (species.pusher() == PrtlPusher::PHOTON) {
         auto range_policy = Kokkos::RangePolicy<Kokkos::DefaultExecutionSpace, kernel::gr::Massless_t>(
@@ -20,6 +20,7 @@
 #include "arch/traits.h"
 #include "utils/log.h"
 #include "utils/numeric.h"
+#include "utils/sorting.h"
 #include "utils/timer.h"
 #include "utils/toml.h"
 
@@ -32,6 +33,7 @@
 #include "engines/engine.hpp"
 #include "kernels/ampere_mink.hpp"
 #include "kernels/ampere_sr.hpp"
+#include "kernels/colocated_fields.hpp"
 #include "kernels/currents_deposit.hpp"
 #include "kernels/digital_filter.hpp"
 #include "kernels/faraday_mink.hpp"
@@ -39,11 +41,15 @@
 #include "kernels/fields_bcs.hpp"
 #include "kernels/particle_moments.hpp"
 #include "kernels/particle_pusher_sr.hpp"
+#include "kernels/utils.hpp"
 #include "pgen.hpp"
 
 #include <Kokkos_Core.hpp>
 #include <Kokkos_ScatterView.hpp>
+#include <Kokkos_Sort.hpp>
 
+#include <algorithm>
+#include <type_traits>
 #include <utility>
 
 namespace ntt {
@@ -51,13 +57,15 @@ namespace ntt {
   template <class M>
   class SRPICEngine : public Engine<SimEngine::SRPIC, M> {
 
-    using base_t   = Engine<SimEngine::SRPIC, M>;
-    using pgen_t   = user::PGen<SimEngine::SRPIC, M>;
-    using domain_t = Domain<SimEngine::SRPIC, M>;
+    using base_t      = Engine<SimEngine::SRPIC, M>;
+    using pgen_t      = user::PGen<SimEngine::SRPIC, M>;
+    using domain_t    = Domain<SimEngine::SRPIC, M>;
+    using particles_t = Particles<M::Dim, M::CoordType>;
     // constexprs
     using base_t::pgen_is_ok;
     // contents
     using base_t::m_metadomain;
+    using base_t::m_eparams;
     using base_t::m_params;
     using base_t::m_pgen;
     // methods
@@ -77,134 +85,198 @@ namespace ntt {
     ~SRPICEngine() = default;
 
     void step_forward(timer::Timers& timers, domain_t& dom) override {
-      const auto fieldsolver_enabled = m_params.template get<bool>(
-        "algorithms.toggles.fieldsolver");
-      const auto deposit_enabled = m_params.template get<bool>(
-        "algorithms.toggles.deposit");
-      const auto clear_interval = m_params.template get<std::size_t>(
-        "particles.clear_interval");
+      raise::ErrorIf(m_metadomain.l_subdomain_indices().size() != 1,
+                     "Per-domain step requires a single local domain",
+                     HERE);
+      (void)dom;
+      step_forward(timers);
+    }
+
+    /**
+     * @brief Advance all the local domains by one timestep
+     * @note Each substep is done for all the local domains before their
+     * neighbors are exchanged, so that the exchanged data is at the same time
+     */
+    void step_forward(timer::Timers& timers) override {
+      const auto fieldsolver_enabled = m_eparams.toggles.fieldsolver;
+      const auto deposit_enabled     = m_eparams.toggles.deposit;
+      const auto clear_interval      = m_eparams.particles.clear_interval;
+      const auto sort_interval       = m_eparams.particles.sort_interval;
+      const auto overlap_comm        = m_eparams.fieldsolver.overlap_comm;
 
       if (step == 0) {
         // communicate fields and apply BCs on the first timestep
-        m_metadomain.CommunicateFields(dom, Comm::B | Comm::E);
-        FieldBoundaries(dom, BC::B | BC::E);
-        ParticleInjector(dom);
+        m_metadomain.CommunicateFields(Comm::B | Comm::E);
+        m_metadomain.runOnLocalDomains([&](auto& dom) {
+          FieldBoundaries(dom, BC::B | BC::E);
+          ParticleInjector(dom);
+        });
       }
 
       if (fieldsolver_enabled) {
-        timers.start("FieldSolver");
-        Faraday(dom, HALF);
-        timers.stop("FieldSolver");
+        if (overlap_comm) {
+          FaradayOverlapped(timers, HALF, false);
+        } else {
+          timers.start("FieldSolver");
+          m_metadomain.runOnLocalDomains([&](auto& dom) {
+            Faraday(dom, HALF);
+          });
+          timers.stop("FieldSolver");
 
-        timers.start("Communications");
-        m_metadomain.CommunicateFields(dom, Comm::B);
-        timers.stop("Communications");
+          timers.start("Communications");
+          m_metadomain.CommunicateFields(Comm::B);
+          timers.stop("Communications");
+        }
 
         timers.start("FieldBoundaries");
-        FieldBoundaries(dom, BC::B);
+        m_metadomain.runOnLocalDomains([&](auto& dom) {
+          FieldBoundaries(dom, BC::B);
+        });
         timers.stop("FieldBoundaries");
         Kokkos::fence();
       }
 
       {
         timers.start("ParticlePusher");
-        ParticlePush(dom);
+        m_metadomain.runOnLocalDomains([&](auto& dom) {
+          if (deposit_enabled) {
+            // currents may be deposited within the pusher (fused kernel)
+            Kokkos::deep_copy(dom.fields.cur, ZERO);
+          }
+          ParticlePush(dom);
+        });
         timers.stop("ParticlePusher");
 
         if (deposit_enabled) {
           timers.start("CurrentDeposit");
-          Kokkos::deep_copy(dom.fields.cur, ZERO);
-          CurrentsDeposit(dom);
+          m_metadomain.runOnLocalDomains([&](auto& dom) {
+            CurrentsDeposit(dom);
+          });
           timers.stop("CurrentDeposit");
 
           timers.start("Communications");
-          m_metadomain.SynchronizeFields(dom, Comm::J);
-          m_metadomain.CommunicateFields(dom, Comm::J);
+          m_metadomain.SynchronizeFields(Comm::J);
+          m_metadomain.CommunicateFields(Comm::J);
           timers.stop("Communications");
 
           timers.start("CurrentFiltering");
-          CurrentsFilter(dom);
+          CurrentsFilter();
           timers.stop("CurrentFiltering");
         }
 
         timers.start("Communications");
-        m_metadomain.CommunicateParticles(dom);
+        m_metadomain.CommunicateParticles();
         timers.stop("Communications");
       }
 
       if (fieldsolver_enabled) {
-        timers.start("FieldSolver");
-        Faraday(dom, HALF);
-        timers.stop("FieldSolver");
+        if (overlap_comm) {
+          // the interior E is also advanced while B is being exchanged
+          FaradayOverlapped(timers, HALF, true);
 
-        timers.start("Communications");
-        m_metadomain.CommunicateFields(dom, Comm::B);
-        timers.stop("Communications");
+          timers.start("FieldBoundaries");
+          m_metadomain.runOnLocalDomains([&](auto& dom) {
+            FieldBoundaries(dom, BC::B);
+          });
+          timers.stop("FieldBoundaries");
 
-        timers.start("FieldBoundaries");
-        FieldBoundaries(dom, BC::B);
-        timers.stop("FieldBoundaries");
+          timers.start("FieldSolver");
+          m_metadomain.runOnLocalDomains([&](auto& dom) {
+            for (const auto& range : dom.mesh.rangesBoundaryLayer()) {
+              Ampere(dom, range, ONE);
+            }
+          });
+          timers.stop("FieldSolver");
+        } else {
+          timers.start("FieldSolver");
+          m_metadomain.runOnLocalDomains([&](auto& dom) {
+            Faraday(dom, HALF);
+          });
+          timers.stop("FieldSolver");
+
+          timers.start("Communications");
+          m_metadomain.CommunicateFields(Comm::B);
+          timers.stop("Communications");
+
+          timers.start("FieldBoundaries");
+          m_metadomain.runOnLocalDomains([&](auto& dom) {
+            FieldBoundaries(dom, BC::B);
+          });
+          timers.stop("FieldBoundaries");
 
-        timers.start("FieldSolver");
-        Ampere(dom, ONE);
-        timers.stop("FieldSolver");
+          timers.start("FieldSolver");
+          m_metadomain.runOnLocalDomains([&](auto& dom) {
+            Ampere(dom, ONE);
+          });
+          timers.stop("FieldSolver");
+        }
 
         if (deposit_enabled) {
           timers.start("FieldSolver");
-          CurrentsAmpere(dom);
+          m_metadomain.runOnLocalDomains([&](auto& dom) {
+            CurrentsAmpere(dom);
+          });
           timers.stop("FieldSolver");
         }
 
         timers.start("Communications");
-        m_metadomain.CommunicateFields(dom, Comm::E | Comm::J);
+        m_metadomain.CommunicateFields(Comm::E | Comm::J);
         timers.stop("Communications");
 
         timers.start("FieldBoundaries");
-        FieldBoundaries(dom, BC::E);
+        m_metadomain.runOnLocalDomains([&](auto& dom) {
+          FieldBoundaries(dom, BC::E);
+        });
         timers.stop("FieldBoundaries");
       }
 
       {
         timers.start("Injector");
-        ParticleInjector(dom);
+        m_metadomain.runOnLocalDomains([&](auto& dom) {
+          ParticleInjector(dom);
+        });
         timers.stop("Injector");
       }
 
       if (clear_interval > 0 and step % clear_interval == 0 and step > 0) {
         timers.start("PrtlClear");
-        m_metadomain.RemoveDeadParticles(dom);
+        m_metadomain.runOnLocalDomains([&](auto& dom) {
+          m_metadomain.RemoveDeadParticles(dom);
+        });
         timers.stop("PrtlClear");
       }
+
+      if (sort_interval > 0 and step % sort_interval == 0 and step > 0) {
+        timers.start("PrtlSort");
+        m_metadomain.runOnLocalDomains([&](auto& dom) {
+          m_metadomain.SortParticles(dom,
+                                     m_eparams.particles.sort_tile,
+                                     m_eparams.particles.sort_morton);
+        });
+        timers.stop("PrtlSort");
+      }
     }
 
     /* algorithm substeps --------------------------------------------------- */
     void Faraday(domain_t& domain, real_t fraction = ONE) {
+      Faraday(domain, domain.mesh.rangeActiveCells(), fraction);
+    }
+
+    void Faraday(domain_t& domain, const range_t<M::Dim>& range, real_t fraction) {
       logger::Checkpoint("Launching Faraday kernel", HERE);
-      const auto dT = fraction *
-                      m_params.template get<real_t>(
-                        "algorithms.timestep.correction") *
-                      dt;
+      const auto dT = fraction * m_eparams.correction * dt;
       if constexpr (M::CoordType == Coord::Cart) {
         // minkowski case
         const auto dx = math::sqrt(domain.mesh.metric.template h_<1, 1>({}));
-        const auto deltax = m_params.template get<real_t>(
-          "algorithms.fieldsolver.delta_x");
-        const auto deltay = m_params.template get<real_t>(
-          "algorithms.fieldsolver.delta_y");
-        const auto betaxy = m_params.template get<real_t>(
-          "algorithms.fieldsolver.beta_xy");
-        const auto betayx = m_params.template get<real_t>(
-          "algorithms.fieldsolver.beta_yx");
-        const auto deltaz = m_params.template get<real_t>(
-          "algorithms.fieldsolver.delta_z");
-        const auto betaxz = m_params.template get<real_t>(
-          "algorithms.fieldsolver.beta_xz");
-        const auto betazx = m_params.template get<real_t>(
-          "algorithms.fieldsolver.beta_zx");
-        const auto betayz = m_params.template get<real_t>(
-          "algorithms.fieldsolver.beta_yz");
-        const auto betazy = m_params.template get<real_t>(
-          "algorithms.fieldsolver.beta_zy");
+        const auto deltax = m_eparams.fieldsolver.delta_x;
+        const auto deltay = m_eparams.fieldsolver.delta_y;
+        const auto betaxy = m_eparams.fieldsolver.beta_xy;
+        const auto betayx = m_eparams.fieldsolver.beta_yx;
+        const auto deltaz = m_eparams.fieldsolver.delta_z;
+        const auto betaxz = m_eparams.fieldsolver.beta_xz;
+        const auto betazx = m_eparams.fieldsolver.beta_zx;
+        const auto betayz = m_eparams.fieldsolver.beta_yz;
+        const auto betazy = m_eparams.fieldsolver.beta_zy;
         real_t coeff1, coeff2;
         if constexpr (M::Dim == Dim::_2D) {
           coeff1 = dT / SQR(dx);
@@ -214,7 +286,7 @@ namespace ntt {
           coeff2 = ZERO;
         }
         Kokkos::parallel_for("Faraday",
-                             domain.mesh.rangeActiveCells(),
+                             range,
                              kernel::mink::Faraday_kernel<M::Dim>(domain.fields.em,
                                                                   coeff1,
                                                                   coeff2,
@@ -229,7 +301,7 @@ namespace ntt {
                                                                   betazy));
       } else {
         Kokkos::parallel_for("Faraday",
-                             domain.mesh.rangeActiveCells(),
+                             range,
                              kernel::sr::Faraday_kernel<M>(domain.fields.em,
                                                            domain.mesh.metric,
                                                            dT,
@@ -238,12 +310,12 @@ namespace ntt {
     }
 
     void Ampere(domain_t& domain, real_t fraction = ONE) {
+      Ampere(domain, range_with_axis_BCs(domain), fraction);
+    }
+
+    void Ampere(domain_t& domain, const range_t<M::Dim>& range, real_t fraction) {
       logger::Checkpoint("Launching Ampere kernel", HERE);
-      const auto dT = fraction *
-                      m_params.template get<real_t>(
-                        "algorithms.timestep.correction") *
-                      dt;
-      auto range = range_with_axis_BCs(domain);
+      const auto dT = fraction * m_eparams.correction * dt;
       if constexpr (M::CoordType == Coord::Cart) {
         // minkowski case
         const auto dx = math::sqrt(domain.mesh.metric.template h_<1, 1>({}));
@@ -272,6 +344,40 @@ namespace ntt {
       }
     }
 
+    /**
+     * @brief Faraday substep with the exchange of B overlapped with the update
+     * @note The boundary layer (the cells sent to the neighbors) is advanced
+     * first, and the interior -- once the messages are posted; if requested,
+     * the interior E is also advanced (with a full Ampere step) before the
+     * ghost cells of B are received
+     */
+    void FaradayOverlapped(timer::Timers& timers, real_t fraction, bool with_ampere) {
+      timers.start("FieldSolver");
+      m_metadomain.runOnLocalDomains([&](auto& dom) {
+        for (const auto& range : dom.mesh.rangesBoundaryLayer()) {
+          Faraday(dom, range, fraction);
+        }
+      });
+      timers.stop("FieldSolver");
+
+      timers.start("Communications");
+      m_metadomain.BeginCommunicateFields(Comm::B);
+      timers.stop("Communications");
+
+      timers.start("FieldSolver");
+      m_metadomain.runOnLocalDomains([&](auto& dom) {
+        Faraday(dom, dom.mesh.rangeInteriorCells(), fraction);
+        if (with_ampere) {
+          Ampere(dom, dom.mesh.rangeInteriorCells(), ONE);
+        }
+      });
+      timers.stop("FieldSolver");
+
+      timers.start("Communications");
+      m_metadomain.EndCommunicateFields(Comm::B);
+      timers.stop("Communications");
+    }
+
     void ParticlePush(domain_t& domain) {
       real_t gx1 { ZERO }, gx2 { ZERO }, gx3 { ZERO }, ds { ZERO };
       real_t x_surf { ZERO };
@@ -282,9 +388,8 @@ namespace ntt {
                          "Only one direction is allowed to have atm boundaries",
                          HERE);
           has_atmosphere = true;
-          const auto g   = m_params.template get<real_t>(
-            "grid.boundaries.atmosphere.g");
-          ds = m_params.template get<real_t>("grid.boundaries.atmosphere.ds");
+          const auto g   = m_eparams.atmosphere.g;
+          ds             = m_eparams.atmosphere.ds;
           const auto [sign, dim, xg_min, xg_max] = get_atm_extent(direction);
           if (dim == in::x1) {
             gx1 = sign > 0 ? g : -g;
@@ -308,11 +413,36 @@ namespace ntt {
           }
         }
       }
+      scatter_ndfield_t<M::Dim, 3> scatter_cur;
+      auto                         any_fused = false;
+      for (const auto& species : domain.species) {
+        any_fused |= DepositFusedWithPush(species);
+      }
+      if (any_fused) {
+        scatter_cur = Kokkos::Experimental::create_scatter_view(domain.fields.cur);
+      }
+      if (m_eparams.gather.colocated) {
+        // node-centered copy of the fields shared by all the species
+        tuple_t<ncells_t, M::Dim> range_min { 0 };
+        tuple_t<ncells_t, M::Dim> range_max { 0 };
+        for (auto d { 0u }; d < M::Dim; ++d) {
+          range_min[d] = 1;
+          range_max[d] = domain.fields.em.extent(d);
+        }
+        Kokkos::parallel_for(
+          "ColocateFields",
+          CreateRangePolicy<M::Dim>(range_min, range_max),
+          kernel::ColocateFields_kernel<M::Dim>(domain.fields.em,
+                                                domain.fields.bckp));
+      }
+      AverageFieldsForSubcycling(domain);
       for (auto& species : domain.species) {
-        if ((species.pusher() == PrtlPusher::NONE) or (species.npart() == 0)) {
+        if ((species.pusher() == PrtlPusher::NONE) or (species.npart() == 0) or
+            not species.pushed_at(step)) {
           continue;
         }
         species.set_unsorted();
+        const auto fuse_deposit = DepositFusedWithPush(species);
         logger::Checkpoint(
           fmt::format("Launching particle pusher kernel for %d [%s] : %lu",
                       species.index(),
@@ -322,9 +452,10 @@ namespace ntt {
         const auto q_ovr_m = species.mass() > ZERO
                                ? species.charge() / species.mass()
                                : ZERO;
+        // sub-cycled species are pushed with a longer timestep
+        const auto dt_sp   = dt * static_cast<real_t>(species.subcycle());
         //  coeff = q / m (dt / 2) omegaB0
-        const auto coeff   = q_ovr_m * HALF * dt *
-                           m_params.template get<real_t>("scales.omegaB0");
+        const auto coeff   = q_ovr_m * HALF * dt_sp * m_eparams.scales.omegaB0;
         PrtlPusher::type pusher;
         if (species.pusher() == PrtlPusher::PHOTON) {
           pusher = PrtlPusher::PHOTON;
@@ -340,33 +471,25 @@ namespace ntt {
         // coefficients to be forwarded to the dispatcher
         // gca
         const auto has_gca         = species.use_gca();
-        const auto gca_larmor_max  = has_gca ? m_params.template get<real_t>(
-                                                "algorithms.gca.larmor_max")
-                                             : ZERO;
-        const auto gca_eovrb_max   = has_gca ? m_params.template get<real_t>(
-                                               "algorithms.gca.e_ovr_b_max")
-                                             : ZERO;
+        const auto gca_larmor_max  = has_gca ? m_eparams.gca.larmor_max : ZERO;
+        const auto gca_eovrb_max   = has_gca ? m_eparams.gca.e_ovr_b_max : ZERO;
         // cooling
         const auto has_synchrotron = (cooling == Cooling::SYNCHROTRON);
         const auto has_compton = (cooling == Cooling::COMPTON);
         const auto sync_grad       = has_synchrotron
-                                       ? m_params.template get<real_t>(
-                                     "algorithms.synchrotron.gamma_rad")
+                                       ? m_eparams.cooling.synchrotron_gamma_rad
                                        : ZERO;
         const auto sync_coeff      = has_synchrotron
-                                       ? (real_t)(0.1) * dt *
-                                      m_params.template get<real_t>(
-                                        "scales.omegaB0") /
+                                       ? (real_t)(0.1) * dt_sp *
+                                      m_eparams.scales.omegaB0 /
                                       (SQR(sync_grad) * species.mass())
                                        : ZERO;
         const auto comp_grad       = has_compton
-                                      ? m_params.template get<real_t>(
-                                     "algorithms.compton.gamma_rad")
+                                      ? m_eparams.cooling.compton_gamma_rad
                                       : ZERO; 
         const auto comp_coeff      = has_compton
-                                      ? (real_t)(0.1) * dt * 
-                                      m_params.template get<real_t>(
-                                          "scales.omegaB0") / (SQR(comp_grad) * species.mass())
+                                      ? (real_t)(0.1) * dt_sp *
+                                      m_eparams.scales.omegaB0 / (SQR(comp_grad) * species.mass())
                                       : ZERO;
         // toggle to indicate whether pgen defines the external force
         bool has_extforce = false;
@@ -390,28 +513,10 @@ namespace ntt {
         }
         // clang-format off
         if (not has_atmosphere and not has_extforce) {
-          Kokkos::parallel_for(
-            "ParticlePusher",
-            species.rangeActiveParticles(),
-            kernel::sr::Pusher_kernel<M>(
-                pusher, has_gca, false,
-                cooling_tags,
-                domain.fields.em,
-                species.index(),
-                species.i1,        species.i2,       species.i3,
-                species.i1_prev,   species.i2_prev,  species.i3_prev,
-                species.dx1,       species.dx2,      species.dx3,
-                species.dx1_prev,  species.dx2_prev, species.dx3_prev,
-                species.ux1,       species.ux2,      species.ux3,
-                species.phi,       species.tag,
-                domain.mesh.metric,
-                time, coeff, dt,
-                domain.mesh.n_active(in::x1),
-                domain.mesh.n_active(in::x2),
-                domain.mesh.n_active(in::x3),
-                domain.mesh.prtl_bc(),
-                gca_larmor_max, gca_eovrb_max, sync_coeff, comp_coeff
-            ));
+          DispatchPusher(domain, species, fuse_deposit, scatter_cur,
+                         kernel::sr::NoForce_t {}, false,
+                         pusher, has_gca, cooling_tags, coeff,
+                         gca_larmor_max, gca_eovrb_max, sync_coeff, comp_coeff);
         } else if (has_atmosphere and not has_extforce) {
           const auto force =
             kernel::sr::Force<M::PrtlDim, M::CoordType, kernel::sr::NoForce_t, true> {
@@ -419,58 +524,20 @@ namespace ntt {
               x_surf,
               ds
             };
-          Kokkos::parallel_for(
-            "ParticlePusher",
-            species.rangeActiveParticles(),
-            kernel::sr::Pusher_kernel<M, decltype(force)>(
-                pusher, has_gca, false,
-                cooling_tags,
-                domain.fields.em,
-                species.index(),
-                species.i1,        species.i2,       species.i3,
-                species.i1_prev,   species.i2_prev,  species.i3_prev,
-                species.dx1,       species.dx2,      species.dx3,
-                species.dx1_prev,  species.dx2_prev, species.dx3_prev,
-                species.ux1,       species.ux2,      species.ux3,
-                species.phi,       species.tag,
-                domain.mesh.metric,
-                force,
-                time, coeff, dt,
-                domain.mesh.n_active(in::x1),
-                domain.mesh.n_active(in::x2),
-                domain.mesh.n_active(in::x3),
-                domain.mesh.prtl_bc(),
-                gca_larmor_max, gca_eovrb_max, sync_coeff, comp_coeff
-            ));
+          DispatchPusher(domain, species, fuse_deposit, scatter_cur,
+                         force, false,
+                         pusher, has_gca, cooling_tags, coeff,
+                         gca_larmor_max, gca_eovrb_max, sync_coeff, comp_coeff);
         } else if (not has_atmosphere and has_extforce) {
           if constexpr (traits::has_member<traits::pgen::ext_force_t, pgen_t>::value) {
             const auto force =
               kernel::sr::Force<M::PrtlDim, M::CoordType, decltype(m_pgen.ext_force), false> {
                 m_pgen.ext_force
               };
-            Kokkos::parallel_for(
-              "ParticlePusher",
-              species.rangeActiveParticles(),
-              kernel::sr::Pusher_kernel<M, decltype(force)>(
-                  pusher, has_gca, true,
-                  cooling_tags,
-                  domain.fields.em,
-                  species.index(),
-                  species.i1,        species.i2,       species.i3,
-                  species.i1_prev,   species.i2_prev,  species.i3_prev,
-                  species.dx1,       species.dx2,      species.dx3,
-                  species.dx1_prev,  species.dx2_prev, species.dx3_prev,
-                  species.ux1,       species.ux2,      species.ux3,
-                  species.phi,       species.tag,
-                  domain.mesh.metric,
-                  force,
-                  time, coeff, dt,
-                  domain.mesh.n_active(in::x1),
-                  domain.mesh.n_active(in::x2),
-                  domain.mesh.n_active(in::x3),
-                  domain.mesh.prtl_bc(),
-                  gca_larmor_max, gca_eovrb_max, sync_coeff, comp_coeff
-              ));
+            DispatchPusher(domain, species, fuse_deposit, scatter_cur,
+                           force, true,
+                           pusher, has_gca, cooling_tags, coeff,
+                           gca_larmor_max, gca_eovrb_max, sync_coeff, comp_coeff);
           } else {
             raise::Error("External force not implemented", HERE);
           }
@@ -480,35 +547,225 @@ namespace ntt {
               kernel::sr::Force<M::PrtlDim, M::CoordType, decltype(m_pgen.ext_force), true> {
                 m_pgen.ext_force, {gx1, gx2, gx3}, x_surf, ds
               };
-            Kokkos::parallel_for(
-              "ParticlePusher",
-              species.rangeActiveParticles(),
-              kernel::sr::Pusher_kernel<M, decltype(force)>(
-                  pusher, has_gca, true,
-                  cooling_tags,
-                  domain.fields.em,
-                  species.index(),
-                  species.i1,        species.i2,       species.i3,
-                  species.i1_prev,   species.i2_prev,  species.i3_prev,
-                  species.dx1,       species.dx2,      species.dx3,
-                  species.dx1_prev,  species.dx2_prev, species.dx3_prev,
-                  species.ux1,       species.ux2,      species.ux3,
-                  species.phi,       species.tag,
-                  domain.mesh.metric,
-                  force,
-                  time, coeff, dt,
-                  domain.mesh.n_active(in::x1),
-                  domain.mesh.n_active(in::x2),
-                  domain.mesh.n_active(in::x3),
-                  domain.mesh.prtl_bc(),
-                  gca_larmor_max, gca_eovrb_max, sync_coeff, comp_coeff
-              ));
+            DispatchPusher(domain, species, fuse_deposit, scatter_cur,
+                           force, true,
+                           pusher, has_gca, cooling_tags, coeff,
+                           gca_larmor_max, gca_eovrb_max, sync_coeff, comp_coeff);
           } else {
             raise::Error("External force not implemented", HERE);
-          }          
+          }
         }
         // clang-format on
       }
+      if (any_fused) {
+        Kokkos::Experimental::contribute(domain.fields.cur, scatter_cur);
+      }
+    }
+
+    /**
+     * @brief Launch the pusher kernel specialized for the species
+     * @note The pusher algorithm, GCA & cooling are resolved here once per
+     * species, so that each launched kernel contains only the path it needs
+     * @note Forces, GCA & cooling do not apply to photons
+     * @note With `algorithms.gather.colocated` the fields are gathered from the
+     * node-centered copy in `bckp`
+     * @note Sub-cycled species are pushed with `subcycle * dt` & the fields
+     * averaged in `em0` (always with the staggered gather)
+     */
+    template <class F>
+    void DispatchPusher(domain_t&                     domain,
+                        particles_t&                  species,
+                        bool                          fuse_deposit,
+                        scatter_ndfield_t<M::Dim, 3>& scatter_cur,
+                        const F&                      force,
+                        bool                          has_extforce,
+                        PrtlPusher::type              pusher,
+                        bool                          has_gca,
+                        kernel::sr::CoolingTags       cooling_tags,
+                        real_t                        coeff,
+                        real_t                        gca_larmor_max,
+                        real_t                        gca_eovrb_max,
+                        real_t                        sync_coeff,
+                        real_t                        comp_coeff) {
+      namespace cool = kernel::sr::Cooling;
+      // fields prepared in `bckp` & `em0` by `ParticlePush`
+      const auto subcycled = (species.subcycle() > 1);
+      const auto colocated = m_eparams.gather.colocated and not subcycled;
+      const auto dt_sp     = dt * static_cast<real_t>(species.subcycle());
+      // P_t, G_t & CL_t are std::integral_constant tags of the specialization
+      const auto launch = [&](auto P_t, auto G_t, auto CL_t, const auto& frc) {
+        using force_t  = std::decay_t<decltype(frc)>;
+        using kernel_t = kernel::sr::Pusher_kernel<M,
+                                                   force_t,
+                                                   decltype(P_t)::value,
+                                                   decltype(G_t)::value,
+                                                   decltype(CL_t)::value>;
+        const auto is_photon = (decltype(P_t)::value == PrtlPusher::PHOTON);
+        // clang-format off
+        LaunchPusher(
+          domain, species, fuse_deposit, scatter_cur,
+          kernel_t(pusher, has_gca and not is_photon, has_extforce and not is_photon,
+                   is_photon ? kernel::sr::CoolingTags { cool::None } : cooling_tags,
+                   subcycled   ? domain.fields.em0
+                   : colocated ? domain.fields.bckp
+                               : domain.fields.em,
+                   species.index(),
+                   species.i1,        species.i2,       species.i3,
+                   species.i1_prev,   species.i2_prev,  species.i3_prev,
+                   species.dx1,       species.dx2,      species.dx3,
+                   species.dx1_prev,  species.dx2_prev, species.dx3_prev,
+                   species.ux1,       species.ux2,      species.ux3,
+                   species.phi,       species.tag,
+                   domain.mesh.metric,
+                   frc,
+                   time, coeff, dt_sp,
+                   domain.mesh.n_active(in::x1),
+                   domain.mesh.n_active(in::x2),
+                   domain.mesh.n_active(in::x3),
+                   domain.mesh.prtl_bc(),
+                   gca_larmor_max, gca_eovrb_max, sync_coeff, comp_coeff,
+                   colocated));
+        // clang-format on
+      };
+      const auto dispatch_cooling = [&](auto P_t, auto G_t) {
+        if (cooling_tags == cool::None) {
+          launch(P_t, G_t, std::integral_constant<int, cool::None> {}, force);
+        } else if (cooling_tags == cool::Synchrotron) {
+          launch(P_t, G_t, std::integral_constant<int, cool::Synchrotron> {}, force);
+        } else if (cooling_tags == cool::Compton) {
+          launch(P_t, G_t, std::integral_constant<int, cool::Compton> {}, force);
+        } else {
+          launch(P_t, G_t, std::integral_constant<int, cool::All> {}, force);
+        }
+      };
+      const auto dispatch_gca = [&](auto P_t) {
+        if (has_gca) {
+          dispatch_cooling(P_t, std::true_type {});
+        } else {
+          dispatch_cooling(P_t, std::false_type {});
+        }
+      };
+      if (pusher == PrtlPusher::PHOTON) {
+        launch(std::integral_constant<PrtlPusher::type, PrtlPusher::PHOTON> {},
+               std::false_type {},
+               std::integral_constant<int, cool::None> {},
+               kernel::sr::NoForce_t {});
+      } else if (pusher == PrtlPusher::BORIS) {
+        dispatch_gca(std::integral_constant<PrtlPusher::type, PrtlPusher::BORIS> {});
+      } else if (pusher == PrtlPusher::VAY) {
+        dispatch_gca(std::integral_constant<PrtlPusher::type, PrtlPusher::VAY> {});
+      } else {
+        raise::Fatal("Invalid particle pusher", HERE);
+      }
+    }
+
+    /**
+     * @brief Whether the current deposit of the species is done within the pusher
+     * @note Always used for species without the `*_prev` arrays (lean layout),
+     * including those with GCA or radiative cooling: the fused kernel wraps the
+     * same pusher, so it is valid for all of them
+     * @note With `algorithms.deposit.fused`, species with GCA or radiative
+     * cooling that store `*_prev` keep the separate deposit (their heavier
+     * pusher gains little from the fusion)
+     */
+    auto DepositFusedWithPush(const particles_t& species) const -> bool {
+      if (not m_eparams.toggles.deposit or
+          (species.pusher() == PrtlPusher::NONE) or
+          (species.pusher() == PrtlPusher::PHOTON) or
+          cmp::AlmostZero_host(species.charge())) {
+        return false;
+      }
+      if (not species.store_prev()) {
+        return true;
+      }
+      return m_eparams.deposit.fused and
+             not species.use_gca() and (species.cooling() == Cooling::NONE);
+    }
+
+    /**
+     * @brief Update the running average of the fields (in `em0`) over the
+     * current sub-cycle, when any of the species is sub-cycled
+     * @note `em0` is (re)allocated on first use & after a restart, in which
+     * case the average is restarted from the current step (i.e., it only
+     * includes the remaining steps of the cycle)
+     */
+    void AverageFieldsForSubcycling(domain_t& domain) {
+      unsigned short nsub = 1;
+      for (const auto& species : domain.species) {
+        nsub = std::max(nsub, species.subcycle());
+      }
+      if (nsub == 1) {
+        return;
+      }
+      // a freshly allocated average is overwritten with the current fields
+      auto n = static_cast<unsigned short>(step % nsub + 1);
+      if (domain.fields.em0.span() != domain.fields.em.span()) {
+        domain.fields.em0 = ndfield_t<M::Dim, 6> { "EM0",
+                                                   domain.fields.em.layout() };
+        n = 1;
+      }
+      tuple_t<ncells_t, M::Dim> range_min { 0 };
+      tuple_t<ncells_t, M::Dim> range_max { 0 };
+      for (auto d { 0u }; d < M::Dim; ++d) {
+        range_max[d] = domain.fields.em.extent(d);
+      }
+      Kokkos::parallel_for(
+        "AverageFields",
+        CreateRangePolicy<M::Dim>(range_min, range_max),
+        kernel::RunningAverage_kernel<M::Dim, 6>(domain.fields.em,
+                                                 domain.fields.em0,
+                                                 n));
+    }
+
+    /**
+     * @brief Launch the pusher kernel, optionally fused with the current deposit
+     * @note With `algorithms.pusher.vectorized` on a host execution space the
+     * (unfused) pusher runs over chunks of `kernel::sr::ChunkWidth` particles
+     */
+    template <class P>
+    void LaunchPusher(domain_t&                     domain,
+                      particles_t&                  species,
+                      bool                          fuse_deposit,
+                      scatter_ndfield_t<M::Dim, 3>& scatter_cur,
+                      const P&                      pusher_kernel) {
+      if constexpr (std::is_same_v<Kokkos::DefaultExecutionSpace,
+                                   Kokkos::DefaultHostExecutionSpace>) {
+        if (m_eparams.pusher.vectorized and not fuse_deposit) {
+          constexpr npart_t width   = kernel::sr::ChunkWidth;
+          const auto        npart   = species.npart();
+          const auto        nchunks = (npart + width - 1) / width;
+          Kokkos::parallel_for("ParticlePusherChunked",
+                               CreateParticleRangePolicy(0u, nchunks),
+                               kernel::sr::PusherChunked_kernel<P>(pusher_kernel,
+                                                                   npart));
+          return;
+        }
+      }
+      if (not fuse_deposit) {
+        Kokkos::parallel_for("ParticlePusher",
+                             species.rangeActiveParticles(),
+                             pusher_kernel);
+        return;
+      }
+      // the current of a sub-cycled species accounts for its whole sub-cycle
+      const auto nsub = static_cast<real_t>(species.subcycle());
+      // clang-format off
+      Kokkos::parallel_for(
+        "ParticlePusherDeposit",
+        species.rangeActiveParticles(),
+        kernel::sr::PusherDeposit_kernel<P, kernel::DepositCurrents_kernel<SimEngine::SRPIC, M>>(
+          pusher_kernel,
+          kernel::DepositCurrents_kernel<SimEngine::SRPIC, M>(
+            scatter_cur,
+            species.i1, species.i2, species.i3,
+            species.i1_prev, species.i2_prev, species.i3_prev,
+            species.dx1, species.dx2, species.dx3,
+            species.dx1_prev, species.dx2_prev, species.dx3_prev,
+            species.ux1, species.ux2, species.ux3,
+            species.phi, species.weight, species.tag,
+            domain.mesh.metric,
+            (real_t)(species.charge()) * nsub, dt * nsub)));
+      // clang-format on
     }
 
     void ParticleInjector(domain_t& domain, InjTags tags = Inj::None) {
@@ -520,13 +777,20 @@ namespace ntt {
     }
 
     void CurrentsDeposit(domain_t& domain) {
+      if (m_eparams.deposit.tiled) {
+        CurrentsDepositTiled(domain);
+        return;
+      }
       auto scatter_cur = Kokkos::Experimental::create_scatter_view(
         domain.fields.cur);
       for (auto& species : domain.species) {
         if ((species.pusher() == PrtlPusher::NONE) or (species.npart() == 0) or
-            cmp::AlmostZero_host(species.charge())) {
+            cmp::AlmostZero_host(species.charge()) or
+            DepositFusedWithPush(species) or not species.pushed_at(step)) {
           continue;
         }
+        // the current of a sub-cycled species accounts for its whole sub-cycle
+        const auto nsub = static_cast<real_t>(species.subcycle());
         logger::Checkpoint(
           fmt::format("Launching currents deposit kernel for %d [%s] : %lu %f",
                       species.index(),
@@ -546,21 +810,89 @@ namespace ntt {
                                species.ux1, species.ux2, species.ux3,
                                species.phi, species.weight, species.tag,
                                domain.mesh.metric,
-                               (real_t)(species.charge()), dt));
+                               (real_t)(species.charge()) * nsub, dt * nsub));
         // clang-format on
       }
       Kokkos::Experimental::contribute(domain.fields.cur, scatter_cur);
     }
 
+    void CurrentsDepositTiled(domain_t& domain) {
+      const auto tile   = static_cast<int>(m_eparams.deposit.tile_size);
+      const auto ncells = domain.mesh.n_active();
+      int        ntiles_per_dim[3] { 1, 1, 1 };
+      for (auto d { 0u }; d < ncells.size(); ++d) {
+        ntiles_per_dim[d] = static_cast<int>((ncells[d] + tile - 1) / tile);
+      }
+      const auto ntiles = ntiles_per_dim[0] * ntiles_per_dim[1] *
+                          ntiles_per_dim[2];
+      using kernel_t = kernel::DepositCurrents_kernel<SimEngine::SRPIC, M>;
+      using key_t    = array_t<int*>;
+      using binop_t  = sort::BinCell<key_t>;
+      for (auto& species : domain.species) {
+        if ((species.pusher() == PrtlPusher::NONE) or (species.npart() == 0) or
+            cmp::AlmostZero_host(species.charge()) or
+            DepositFusedWithPush(species) or not species.pushed_at(step)) {
+          continue;
+        }
+        // the current of a sub-cycled species accounts for its whole sub-cycle
+        const auto nsub = static_cast<real_t>(species.subcycle());
+        logger::Checkpoint(
+          fmt::format("Launching tiled currents deposit kernel for %d [%s] : %lu %f",
+                      species.index(),
+                      species.label().c_str(),
+                      species.npart(),
+                      (double)species.charge()),
+          HERE);
+        key_t tile_keys { "tile_keys", species.npart() };
+        Kokkos::parallel_for("TileKeys",
+                             species.rangeActiveParticles(),
+                             kernel::ComputeTileKeys_kernel<M::Dim>(species.i1_prev,
+                                                                    species.i2_prev,
+                                                                    species.i3_prev,
+                                                                    species.tag,
+                                                                    tile_keys,
+                                                                    ncells,
+                                                                    tile,
+                                                                    ntiles_per_dim[0],
+                                                                    ntiles_per_dim[1],
+                                                                    ntiles));
+        // dead particles are put in the extra bin which is never deposited
+        Kokkos::BinSort<key_t, binop_t, typename key_t::device_type, npart_t> sorter {
+          tile_keys,
+          binop_t { ntiles + 1 },
+          false
+        };
+        sorter.create_permute_vector();
+        // clang-format off
+        Kokkos::parallel_for("CurrentsDepositTiled",
+                             team_policy_t(ntiles, Kokkos::AUTO)
+                               .set_scratch_size(0, Kokkos::PerTeam(kernel_t::scratch_size(tile))),
+                             kernel_t(
+                               domain.fields.cur,
+                               sorter.get_bin_offsets(), sorter.get_bin_count(),
+                               sorter.get_permute_vector(),
+                               tile, ntiles_per_dim[0], ntiles_per_dim[1],
+                               species.i1, species.i2, species.i3,
+                               species.i1_prev, species.i2_prev, species.i3_prev,
+                               species.dx1, species.dx2, species.dx3,
+                               species.dx1_prev, species.dx2_prev, species.dx3_prev,
+                               species.ux1, species.ux2, species.ux3,
+                               species.phi, species.weight, species.tag,
+                               domain.mesh.metric,
+                               (real_t)(species.charge()) * nsub, dt * nsub));
+        // clang-format on
+      }
+    }
+
     void CurrentsAmpere(domain_t& domain) {
       logger::Checkpoint("Launching Ampere kernel for adding currents", HERE);
-      const auto q0 = m_params.template get<real_t>("scales.q0");
-      const auto n0 = m_params.template get<real_t>("scales.n0");
-      const auto B0 = m_params.template get<real_t>("scales.B0");
+      const auto q0 = m_eparams.scales.q0;
+      const auto n0 = m_eparams.scales.n0;
+      const auto B0 = m_eparams.scales.B0;
       if constexpr (M::CoordType == Coord::Cart) {
         // minkowski case
-        const auto V0    = m_params.template get<real_t>("scales.V0");
-        const auto ppc0  = m_params.template get<real_t>("particles.ppc0");
+        const auto V0    = m_eparams.scales.V0;
+        const auto ppc0  = m_eparams.particles.ppc0;
         const auto coeff = -dt * q0 / (B0 * V0);
         if constexpr (
           traits::has_member<traits::pgen::ext_current_t, pgen_t>::value) {
@@ -604,32 +936,33 @@ namespace ntt {
       }
     }
 
-    void CurrentsFilter(domain_t& domain) {
+    void CurrentsFilter() {
       logger::Checkpoint("Launching currents filtering kernels", HERE);
-      auto       range   = range_with_axis_BCs(domain);
-      const auto nfilter = m_params.template get<unsigned short>(
-        "algorithms.current_filters");
-      tuple_t<ncells_t, M::Dim> size;
-      if constexpr (M::Dim == Dim::_1D || M::Dim == Dim::_2D || M::Dim == Dim::_3D) {
-        size[0] = domain.mesh.n_active(in::x1);
-      }
-      if constexpr (M::Dim == Dim::_2D || M::Dim == Dim::_3D) {
-        size[1] = domain.mesh.n_active(in::x2);
-      }
-      if constexpr (M::Dim == Dim::_3D) {
-        size[2] = domain.mesh.n_active(in::x3);
-      }
+      const auto nfilter = m_eparams.current_filters;
       // !TODO: this needs to be done more efficiently
       for (auto i { 0u }; i < nfilter; ++i) {
-        Kokkos::deep_copy(domain.fields.buff, domain.fields.cur);
-        Kokkos::parallel_for("CurrentsFilter",
-                             range,
-                             kernel::DigitalFilter_kernel<M::Dim, M::CoordType>(
-                               domain.fields.cur,
-                               domain.fields.buff,
-                               size,
-                               domain.mesh.flds_bc()));
-        m_metadomain.CommunicateFields(domain, Comm::J);
+        m_metadomain.runOnLocalDomains([&](auto& domain) {
+          auto range = range_with_axis_BCs(domain);
+          tuple_t<ncells_t, M::Dim> size;
+          if constexpr (M::Dim == Dim::_1D || M::Dim == Dim::_2D || M::Dim == Dim::_3D) {
+            size[0] = domain.mesh.n_active(in::x1);
+          }
+          if constexpr (M::Dim == Dim::_2D || M::Dim == Dim::_3D) {
+            size[1] = domain.mesh.n_active(in::x2);
+          }
+          if constexpr (M::Dim == Dim::_3D) {
+            size[2] = domain.mesh.n_active(in::x3);
+          }
+          Kokkos::deep_copy(domain.fields.buff, domain.fields.cur);
+          Kokkos::parallel_for("CurrentsFilter",
+                               range,
+                               kernel::DigitalFilter_kernel<M::Dim, M::CoordType>(
+                                 domain.fields.cur,
+                                 domain.fields.buff,
+                                 size,
+                                 domain.mesh.flds_bc()));
+        });
+        m_metadomain.CommunicateFields(Comm::J);
       }
     }
 
@@ -667,9 +1000,8 @@ namespace ntt {
       /**
        * matching boundaries
        */
-      const auto ds_array = m_params.template get<boundaries_t<real_t>>(
-        "grid.boundaries.match.ds");
-      const auto dim = direction.get_dim();
+      const auto& ds_array = m_eparams.match_ds;
+      const auto  dim      = direction.get_dim();
       real_t     xg_min, xg_max, xg_edge;
       auto       sign = direction.get_sign();
       real_t     ds;
@@ -1215,24 +1547,19 @@ namespace ntt {
                                InjTags                         tags) {
       const auto [sign, dim, xg_min, xg_max] = get_atm_extent(direction);
 
-      const auto x_surf = sign > 0 ? xg_min : xg_max;
-      const auto ds     = m_params.template get<real_t>(
-        "grid.boundaries.atmosphere.ds");
-      const auto temp = m_params.template get<real_t>(
-        "grid.boundaries.atmosphere.temperature");
-      const auto height = m_params.template get<real_t>(
-        "grid.boundaries.atmosphere.height");
-      const auto species = m_params.template get<std::pair<spidx_t, spidx_t>>(
-        "grid.boundaries.atmosphere.species");
-      const auto nmax = m_params.template get<real_t>(
-        "grid.boundaries.atmosphere.density");
+      const auto x_surf  = sign > 0 ? xg_min : xg_max;
+      const auto ds      = m_eparams.atmosphere.ds;
+      const auto temp    = m_eparams.atmosphere.temperature;
+      const auto height  = m_eparams.atmosphere.height;
+      const auto species = m_eparams.atmosphere.species;
+      const auto nmax    = m_eparams.atmosphere.density;
 
       Kokkos::deep_copy(domain.fields.bckp, ZERO);
       auto scatter_bckp = Kokkos::Experimental::create_scatter_view(
         domain.fields.bckp);
       const auto use_weights = M::CoordType != Coord::Cart;
       const auto ni2         = domain.mesh.n_active(in::x2);
-      const auto inv_n0      = ONE / m_params.template get<real_t>("scales.n0");
+      const auto inv_n0      = ONE / m_eparams.scales.n0;
 
       // compute the density of the two species
       if (tags & Inj::AssumeEmpty) {
@@ -1459,9 +1786,7 @@ namespace ntt {
       -> std::tuple<short, in, real_t, real_t> {
       const auto sign     = direction.get_sign();
       const auto dim      = direction.get_dim();
-      const auto min_buff = m_params.template get<unsigned short>(
-                              "algorithms.current_filters") +
-                            2;
+      const auto min_buff = m_eparams.current_filters + 2;
       const auto buffer_ncells = min_buff > 5 ? min_buff : 5;
       if (M::CoordType != Coord::Cart and (dim != in::x1 or sign > 0)) {
         raise::Error("For non-cartesian coordinates atmosphere BCs is "
@@ -0,0 +1,126 @@
+/**
+ * @file framework/containers/comm_buffers.h
+ * @brief Persistent pool of the send/recv buffers used in communications
+ * @implements
+ *   - ntt::CommBuffer
+ *   - ntt::CommBufferPool
+ * @namespaces:
+ *   - ntt::
+ */
+
+#ifndef FRAMEWORK_CONTAINERS_COMM_BUFFERS_H
+#define FRAMEWORK_CONTAINERS_COMM_BUFFERS_H
+
+#include "global.h"
+
+#include "arch/kokkos_aliases.h"
+
+#include <Kokkos_Core.hpp>
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <tuple>
+
+namespace ntt {
+
+  /**
+   * @brief Unmanaged views of the requested size into a pooled buffer
+   * @note `host` aliases `data` when the device memory is host-accessible
+   */
+  struct CommBuffer {
+    array_t<char*>        data;
+    array_mirror_t<char*> host;
+  };
+
+  /**
+   * @brief Pool of persistent communication buffers
+   * @note Buffers are identified by a (comm tag, domain, direction) key, and are
+   * ... allocated on first request; afterwards they are only reallocated when
+   * ... the requested size exceeds the capacity, growing geometrically
+   */
+  class CommBufferPool {
+  public:
+    // comm tag (e.g., "em", "cur", "prtl"), index of the (local) domain & hash
+    // of the direction
+    using key_t = std::tuple<std::string, unsigned int, short>;
+
+    static constexpr double growth_factor { 2.0 };
+
+    CommBufferPool()  = default;
+    ~CommBufferPool() = default;
+
+    CommBufferPool(const CommBufferPool&)            = delete;
+    CommBufferPool& operator=(const CommBufferPool&) = delete;
+
+    /**
+     * @brief Get the send buffer of at least `nbytes` for a given key
+     */
+    auto send(const key_t& key, std::size_t nbytes) -> CommBuffer {
+      return get(m_send, key, nbytes);
+    }
+
+    /**
+     * @brief Get the recv buffer of at least `nbytes` for a given key
+     */
+    auto recv(const key_t& key, std::size_t nbytes) -> CommBuffer {
+      return get(m_recv, key, nbytes);
+    }
+
+    /**
+     * @brief Number of allocated buffers
+     */
+    [[nodiscard]]
+    auto nbuffers() const -> std::size_t {
+      return m_send.size() + m_recv.size();
+    }
+
+    /**
+     * @brief Total allocated memory (including the host staging buffers)
+     */
+    [[nodiscard]]
+    auto memory_footprint() const -> std::size_t {
+      std::size_t footprint = 0;
+      for (const auto* buffers : { &m_send, &m_recv }) {
+        for (const auto& [key, buff] : *buffers) {
+          footprint += buff.data.extent(0);
+          if (buff.host.data() != buff.data.data()) {
+            footprint += buff.host.extent(0);
+          }
+        }
+      }
+      return footprint;
+    }
+
+  private:
+    struct Storage {
+      array_t<char*>        data;
+      array_mirror_t<char*> host;
+    };
+
+    std::map<key_t, Storage> m_send, m_recv;
+
+    static auto get(std::map<key_t, Storage>& buffers,
+                    const key_t&              key,
+                    std::size_t               nbytes) -> CommBuffer {
+      auto& buff = buffers[key];
+      if (buff.data.extent(0) < nbytes) {
+        const auto capacity = std::max(
+          nbytes,
+          static_cast<std::size_t>(growth_factor * buff.data.extent(0)));
+        buff.data = array_t<char*> {
+          Kokkos::view_alloc(Kokkos::WithoutInitializing,
+                             "comm_buff_" + std::get<0>(key)),
+          capacity
+        };
+        buff.host = Kokkos::create_mirror_view(Kokkos::WithoutInitializing,
+                                               buff.data);
+      }
+      return { array_t<char*> { buff.data.data(), nbytes },
+               array_mirror_t<char*> { buff.host.data(), nbytes } };
+    }
+  };
+
+} // namespace ntt
+
+#endif // FRAMEWORK_CONTAINERS_COMM_BUFFERS_H
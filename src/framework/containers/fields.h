@@ -7,7 +7,8 @@
  *   - fields.cpp
  * @namespaces:
  *   - ntt::
- * @note SRPIC engine allocates em(6), bckp(6), cur(3), buff(3)
+ * @note SRPIC engine allocates em(6), bckp(6), cur(3), buff(3), and em0(6)
+ *       (lazily) when any of the species is sub-cycled
  * @note GRPIC engine allocates em(6), bckp(6), cur(3), buff(3), aux(6), em0(6), cur0(3)
  * @note Each field has resolution + 2 * N_GHOSTS components in each direction
  * @note Vector field components are stored as the last index in corresponding field
@@ -175,7 +176,15 @@ namespace ntt {
     void CheckpointRead(adios2::IO&,
                         adios2::Engine&,
                         const adios2::Box<adios2::Dims>&);
-    void CheckpointWrite(adios2::IO&, adios2::Engine&) const;
+
+    /**
+     * @brief Write the `slice` of the local fields into the `range` of the
+     * global (ghost-padded) checkpoint arrays
+     */
+    void CheckpointWrite(adios2::IO&,
+                         adios2::Engine&,
+                         const adios2::Box<adios2::Dims>&,
+                         const std::vector<range_tuple_t>&) const;
 #endif
   };
 
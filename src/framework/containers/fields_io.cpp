@@ -1,18 +1,22 @@
 #include "enums.h"
 #include "global.h"
 
+#include "arch/kokkos_aliases.h"
+#include "utils/error.h"
 #include "utils/log.h"
 
 #include "framework/containers/fields.h"
 #include "output/utils/readers.h"
 #include "output/utils/writers.h"
 
+#include <Kokkos_Core.hpp>
 #include <adios2.h>
 
 #if defined(MPI_ENABLED)
   #include <mpi.h>
 #endif
 
+#include <string>
 #include <vector>
 
 namespace ntt {
@@ -64,14 +68,57 @@ namespace ntt {
     }
   }
 
+  /**
+   * @brief Write a slice of the field (the components are appended to `range`)
+   */
+  template <Dimension D, int N>
+  void WriteFieldSlice(adios2::IO&                       io,
+                       adios2::Engine&                   writer,
+                       const std::string&                name,
+                       const ndfield_t<D, N>&            field,
+                       const adios2::Box<adios2::Dims>&  range,
+                       const std::vector<range_tuple_t>& slice) {
+    auto rangeN = adios2::Box<adios2::Dims>(range.first, range.second);
+    rangeN.first.push_back(0);
+    rangeN.second.push_back(N);
+    // the slice is copied to a contiguous buffer first
+    ndfield_t<D, N> buffer;
+    if constexpr (D == Dim::_1D) {
+      buffer = ndfield_t<D, N> { "buffer", slice[0].second - slice[0].first };
+      Kokkos::deep_copy(buffer, Kokkos::subview(field, slice[0], Kokkos::ALL));
+    } else if constexpr (D == Dim::_2D) {
+      buffer = ndfield_t<D, N> { "buffer",
+                                 slice[0].second - slice[0].first,
+                                 slice[1].second - slice[1].first };
+      Kokkos::deep_copy(buffer,
+                        Kokkos::subview(field, slice[0], slice[1], Kokkos::ALL));
+    } else if constexpr (D == Dim::_3D) {
+      buffer = ndfield_t<D, N> { "buffer",
+                                 slice[0].second - slice[0].first,
+                                 slice[1].second - slice[1].first,
+                                 slice[2].second - slice[2].first };
+      Kokkos::deep_copy(
+        buffer,
+        Kokkos::subview(field, slice[0], slice[1], slice[2], Kokkos::ALL));
+    }
+    out::WriteNDField<D, N>(io, writer, name, buffer, rangeN);
+  }
+
   template <Dimension D, SimEngine::type S>
-  void Fields<D, S>::CheckpointWrite(adios2::IO& io, adios2::Engine& writer) const {
+  void Fields<D, S>::CheckpointWrite(
+    adios2::IO&                       io,
+    adios2::Engine&                   writer,
+    const adios2::Box<adios2::Dims>&  range,
+    const std::vector<range_tuple_t>& slice) const {
     logger::Checkpoint("Writing fields checkpoint", HERE);
+    raise::ErrorIf(slice.size() != static_cast<std::size_t>(D),
+                   "Invalid slice when writing fields checkpoint",
+                   HERE);
 
-    out::WriteNDField<D, 6>(io, writer, "em", em);
+    WriteFieldSlice<D, 6>(io, writer, "em", em, range, slice);
     if (S == ntt::SimEngine::GRPIC) {
-      out::WriteNDField<D, 6>(io, writer, "em0", em0);
-      out::WriteNDField<D, 3>(io, writer, "cur0", cur0);
+      WriteFieldSlice<D, 6>(io, writer, "em0", em0, range, slice);
+      WriteFieldSlice<D, 3>(io, writer, "cur0", cur0, range, slice);
     }
   }
 
@@ -84,7 +131,11 @@ namespace ntt {
   template void Fields<D, S>::CheckpointRead(adios2::IO&,                       \
                                              adios2::Engine&,                   \
                                              const adios2::Box<adios2::Dims>&); \
-  template void Fields<D, S>::CheckpointWrite(adios2::IO&, adios2::Engine&) const;
+  template void Fields<D, S>::CheckpointWrite(                                  \
+    adios2::IO&,                                                                \
+    adios2::Engine&,                                                            \
+    const adios2::Box<adios2::Dims>&,                                           \
+    const std::vector<range_tuple_t>&) const;
 
   FIELDS_CHECKPOINTS(Dim::_1D, SimEngine::SRPIC)
   FIELDS_CHECKPOINTS(Dim::_2D, SimEngine::SRPIC)
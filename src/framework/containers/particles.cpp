@@ -4,13 +4,18 @@
 #include "global.h"
 
 #include "arch/kokkos_aliases.h"
+#include "utils/error.h"
+#include "utils/sorting.h"
 
 #include "framework/containers/species.h"
 
 #include <Kokkos_Core.hpp>
 #include <Kokkos_ScatterView.hpp>
+#include <Kokkos_Sort.hpp>
 #include <Kokkos_StdAlgorithms.hpp>
 
+#include <algorithm>
+#include <limits>
 #include <string>
 #include <vector>
 
@@ -26,7 +31,9 @@ namespace ntt {
                              bool               use_gca,
                              const Cooling&     cooling,
                              unsigned short     npld_r,
-                             unsigned short     npld_i)
+                             unsigned short     npld_i,
+                             bool               store_prev,
+                             unsigned short     subcycle)
     : ParticleSpecies(index,
                       label,
                       m,
@@ -37,27 +44,35 @@ namespace ntt {
                       use_gca,
                       cooling,
                       npld_r,
-                      npld_i) {
+                      npld_i,
+                      store_prev,
+                      subcycle) {
 
     if constexpr (D == Dim::_1D or D == Dim::_2D or D == Dim::_3D) {
-      i1       = array_t<int*> { label + "_i1", maxnpart };
-      dx1      = array_t<prtldx_t*> { label + "_dx1", maxnpart };
-      i1_prev  = array_t<int*> { label + "_i1_prev", maxnpart };
-      dx1_prev = array_t<prtldx_t*> { label + "_dx1_prev", maxnpart };
+      i1  = array_t<int*> { label + "_i1", maxnpart };
+      dx1 = array_t<prtldx_t*> { label + "_dx1", maxnpart };
+      if (store_prev) {
+        i1_prev  = array_t<int*> { label + "_i1_prev", maxnpart };
+        dx1_prev = array_t<prtldx_t*> { label + "_dx1_prev", maxnpart };
+      }
     }
 
     if constexpr (D == Dim::_2D or D == Dim::_3D) {
-      i2       = array_t<int*> { label + "_i2", maxnpart };
-      dx2      = array_t<prtldx_t*> { label + "_dx2", maxnpart };
-      i2_prev  = array_t<int*> { label + "_i2_prev", maxnpart };
-      dx2_prev = array_t<prtldx_t*> { label + "_dx2_prev", maxnpart };
+      i2  = array_t<int*> { label + "_i2", maxnpart };
+      dx2 = array_t<prtldx_t*> { label + "_dx2", maxnpart };
+      if (store_prev) {
+        i2_prev  = array_t<int*> { label + "_i2_prev", maxnpart };
+        dx2_prev = array_t<prtldx_t*> { label + "_dx2_prev", maxnpart };
+      }
     }
 
     if constexpr (D == Dim::_3D) {
-      i3       = array_t<int*> { label + "_i3", maxnpart };
-      dx3      = array_t<prtldx_t*> { label + "_dx3", maxnpart };
-      i3_prev  = array_t<int*> { label + "_i3_prev", maxnpart };
-      dx3_prev = array_t<prtldx_t*> { label + "_dx3_prev", maxnpart };
+      i3  = array_t<int*> { label + "_i3", maxnpart };
+      dx3 = array_t<prtldx_t*> { label + "_dx3", maxnpart };
+      if (store_prev) {
+        i3_prev  = array_t<int*> { label + "_i3_prev", maxnpart };
+        dx3_prev = array_t<prtldx_t*> { label + "_dx3_prev", maxnpart };
+      }
     }
 
     ux1 = array_t<real_t*> { label + "_ux1", maxnpart };
@@ -124,6 +139,10 @@ namespace ntt {
 
   template <typename T>
   void RemoveDeadInArray(array_t<T*>& arr, const array_t<npart_t*>& indices_alive) {
+    if (arr.extent(0) == 0) {
+      // array is not allocated (e.g., `*_prev` for lean species)
+      return;
+    }
     npart_t n_alive = indices_alive.extent(0);
     auto    buffer  = Kokkos::View<T*>("buffer", n_alive);
     Kokkos::parallel_for(
@@ -245,6 +264,174 @@ namespace ntt {
     m_is_sorted = true;
   }
 
+  template <Dimension D, Coord::type C>
+  void Particles<D, C>::SortByCell(const std::vector<ncells_t>& ncells,
+                                   ncells_t                     tile,
+                                   bool                         morton) {
+    raise::ErrorIf(ncells.size() != static_cast<std::size_t>(D),
+                   "wrong number of dimensions in ncells",
+                   HERE);
+    raise::ErrorIf(tile == 0, "sorting tile size must be nonzero", HERE);
+    if (npart() == 0) {
+      m_is_sorted = true;
+      return;
+    }
+
+    // number of tiles (or cells if tile = 1) in each direction
+    ncells_t ntiles[3] { 1, 1, 1 };
+    ncells_t nmax = 1;
+    for (auto d { 0u }; d < static_cast<unsigned short>(D); ++d) {
+      ntiles[d] = (ncells[d] + tile - 1) / tile;
+      nmax      = std::max(nmax, ntiles[d]);
+    }
+    const ncells_t nbins = ntiles[0] * ntiles[1] * ntiles[2];
+    // the last bin is reserved for the dead particles
+    raise::ErrorIf(nbins + 1 > static_cast<ncells_t>(
+                                 std::numeric_limits<int>::max()),
+                   "too many bins for particle sorting",
+                   HERE);
+    const auto dead_bin = static_cast<int>(nbins);
+
+    const int nt1 = ntiles[0], nt2 = ntiles[1];
+    const int n1 = ncells[0], n2 = (D != Dim::_1D) ? ncells[1] : 1,
+              n3 = (D == Dim::_3D) ? ncells[2] : 1;
+    const int ntile = static_cast<int>(tile);
+
+    // rank of each tile along the morton curve: the bins stay dense (one per
+    // tile) instead of spanning the whole power-of-2 cube of morton keys
+    array_t<int*> tile_rank;
+    if (morton) {
+      raise::ErrorIf(nmax > (static_cast<ncells_t>(1) << (31 / (unsigned short)D)),
+                     "too many cells per direction for morton sorting",
+                     HERE);
+      tile_rank = array_t<int*> { "tile_rank", nbins };
+      // morton key in the upper bits, tile index in the lower ones
+      array_t<unsigned long long*> tile_keys { "tile_keys", nbins };
+      Kokkos::parallel_for(
+        "ComputeMortonTileKeys",
+        nbins,
+        Lambda(index_t t) {
+          const auto c1 = static_cast<unsigned int>(t % nt1);
+          const auto c2 = static_cast<unsigned int>((t / nt1) % nt2);
+          const auto c3 = static_cast<unsigned int>(t / (nt1 * nt2));
+          tile_keys(t)  = (static_cast<unsigned long long>(sort::morton(
+                            static_cast<unsigned short>(D), c1, c2, c3))
+                          << 32) |
+                         static_cast<unsigned long long>(t);
+        });
+      Kokkos::sort(tile_keys);
+      Kokkos::parallel_for(
+        "ComputeMortonTileRanks",
+        nbins,
+        Lambda(index_t r) {
+          tile_rank(tile_keys(r) & 0xffffffffull) = static_cast<int>(r);
+        });
+    }
+
+    array_t<int*> keys { "cell_keys", npart() };
+    npart_t       n_alive = 0, n_dead = 0;
+    auto&         this_tag = tag;
+    auto&         this_i1  = i1;
+    auto&         this_i2  = i2;
+    auto&         this_i3  = i3;
+
+    Kokkos::parallel_reduce(
+      "ComputeCellKeys",
+      rangeActiveParticles(),
+      Lambda(index_t p, npart_t & nalive, npart_t & ndead) {
+        if (this_tag(p) != ParticleTag::alive) {
+          if (this_tag(p) != ParticleTag::dead) {
+            raise::KernelError(HERE, "wrong particle tag");
+          }
+          keys(p)  = dead_bin;
+          ndead   += 1;
+          return;
+        }
+        nalive        += 1;
+        unsigned int c[3] { 0u, 0u, 0u };
+        c[0] = math::min(math::max(this_i1(p), 0), n1 - 1) / ntile;
+        if constexpr (D == Dim::_2D or D == Dim::_3D) {
+          c[1] = math::min(math::max(this_i2(p), 0), n2 - 1) / ntile;
+        }
+        if constexpr (D == Dim::_3D) {
+          c[2] = math::min(math::max(this_i3(p), 0), n3 - 1) / ntile;
+        }
+        const auto t = static_cast<int>(c[0] + nt1 * (c[1] + nt2 * c[2]));
+        keys(p)      = morton ? tile_rank(t) : t;
+      },
+      n_alive,
+      n_dead);
+
+    using KeyType = array_t<int*>;
+    using BinOp   = sort::BinCell<KeyType>;
+    Kokkos::BinSort<KeyType, BinOp, typename KeyType::device_type, npart_t> sorter {
+      keys,
+      BinOp { dead_bin + 1 },
+      false
+    };
+    sorter.create_permute_vector();
+
+    // the first n_alive entries of the permutation point to alive particles
+    array_t<npart_t*> indices_sorted { "indices_sorted", n_alive };
+    Kokkos::deep_copy(
+      indices_sorted,
+      Kokkos::subview(sorter.get_permute_vector(),
+                      std::make_pair(static_cast<npart_t>(0), n_alive)));
+
+    if constexpr (D == Dim::_1D or D == Dim::_2D or D == Dim::_3D) {
+      RemoveDeadInArray(i1, indices_sorted);
+      RemoveDeadInArray(i1_prev, indices_sorted);
+      RemoveDeadInArray(dx1, indices_sorted);
+      RemoveDeadInArray(dx1_prev, indices_sorted);
+    }
+
+    if constexpr (D == Dim::_2D or D == Dim::_3D) {
+      RemoveDeadInArray(i2, indices_sorted);
+      RemoveDeadInArray(i2_prev, indices_sorted);
+      RemoveDeadInArray(dx2, indices_sorted);
+      RemoveDeadInArray(dx2_prev, indices_sorted);
+    }
+
+    if constexpr (D == Dim::_3D) {
+      RemoveDeadInArray(i3, indices_sorted);
+      RemoveDeadInArray(i3_prev, indices_sorted);
+      RemoveDeadInArray(dx3, indices_sorted);
+      RemoveDeadInArray(dx3_prev, indices_sorted);
+    }
+
+    RemoveDeadInArray(ux1, indices_sorted);
+    RemoveDeadInArray(ux2, indices_sorted);
+    RemoveDeadInArray(ux3, indices_sorted);
+    RemoveDeadInArray(weight, indices_sorted);
+
+    if constexpr (D == Dim::_2D && C != Coord::Cart) {
+      RemoveDeadInArray(phi, indices_sorted);
+    }
+
+    if (npld_r() > 0) {
+      RemoveDeadInArray(pld_r, indices_sorted);
+    }
+
+    if (npld_i() > 0) {
+      RemoveDeadInArray(pld_i, indices_sorted);
+    }
+
+    Kokkos::Experimental::fill(
+      "TagAliveParticles",
+      Kokkos::DefaultExecutionSpace(),
+      Kokkos::subview(this_tag, std::make_pair(static_cast<npart_t>(0), n_alive)),
+      ParticleTag::alive);
+
+    Kokkos::Experimental::fill(
+      "TagDeadParticles",
+      Kokkos::DefaultExecutionSpace(),
+      Kokkos::subview(this_tag, std::make_pair(n_alive, n_alive + n_dead)),
+      ParticleTag::dead);
+
+    set_npart(n_alive);
+    m_is_sorted = true;
+  }
+
   template struct Particles<Dim::_1D, Coord::Cart>;
   template struct Particles<Dim::_2D, Coord::Cart>;
   template struct Particles<Dim::_3D, Coord::Cart>;
@@ -3,6 +3,7 @@
  * @brief Definition of the particle container class
  * @implements
  *   - ntt::Particles<> : ntt::ParticleSpecies
+ *   - ntt::PrtlExchange<>
  * @cpp:
  *   - particles.cpp
  * @macros:
@@ -20,19 +21,47 @@
 #include "utils/error.h"
 #include "utils/formatting.h"
 
+#include "framework/containers/comm_buffers.h"
 #include "framework/containers/species.h"
 
 #include <Kokkos_Core.hpp>
 
+#if defined(MPI_ENABLED)
+  #include <mpi.h>
+#endif
+
 #if defined(OUTPUT_ENABLED)
   #include <adios2.h>
 #endif
 
 #include <string>
+#include <utility>
 #include <vector>
 
+namespace kernel {
+  struct PrtlSelection;
+} // namespace kernel
+
 namespace ntt {
 
+#if defined(MPI_ENABLED)
+  /**
+   * @brief Outgoing particles of a species between the phases of an exchange
+   */
+  template <Dimension D>
+  struct PrtlExchange {
+    // number of particles per tag (outgoing ones are tagged by the direction)
+    std::vector<npart_t>      npart_per_tag;
+    // indices of the outgoing particles (to be filled by the incoming ones)
+    array_t<npart_t*>         outgoing_indices;
+    // packed outgoing particles per direction
+    dir::map_t<D, CommBuffer> send_buffs;
+    // a particle as an MPI datatype & the requests of the sends in flight
+    MPI_Datatype              prtl_type;
+    std::vector<MPI_Request>  requests;
+  };
+#endif
+
   /**
    * @brief Container class to carry particle information for a specific species
    * @tparam D The dimension of the simulation
@@ -61,7 +90,7 @@ namespace ntt {
     array_t<real_t*>   ux1, ux2, ux3;
     // Particle weights.
     array_t<real_t*>   weight;
-    // Previous timestep coordinates
+    // Previous timestep coordinates (not allocated when `store_prev = false`)
     array_t<int*>      i1_prev, i2_prev, i3_prev;
     array_t<prtldx_t*> dx1_prev, dx2_prev, dx3_prev;
     // Array to tag the particles
@@ -89,6 +118,8 @@ namespace ntt {
      * @param cooling The cooling mechanism assigned for the species
      * @param npld_r The number of real-valued payloads for the species
      * @param npld_i The number of integer-valued payloads for the species
+     * @param store_prev Allocate arrays for the previous-timestep coordinates
+     * @param subcycle Push the species once every `subcycle` timesteps
      */
     Particles(spidx_t            index,
               const std::string& label,
@@ -99,8 +130,10 @@ namespace ntt {
               bool               use_gca,
               bool               use_tracking,
               const Cooling&     cooling,
-              unsigned short     npld_r = 0,
-              unsigned short     npld_i = 0);
+              unsigned short     npld_r     = 0,
+              unsigned short     npld_i     = 0,
+              bool               store_prev = true,
+              unsigned short     subcycle   = 1);
 
     /**
      * @brief Constructor for the particle container
@@ -118,7 +151,9 @@ namespace ntt {
                   spec.use_gca(),
                   spec.cooling(),
                   spec.npld_r(),
-                  spec.npld_i()) {}
+                  spec.npld_i(),
+                  spec.store_prev(),
+                  spec.subcycle()) {}
 
     Particles(const Particles&)            = delete;
     Particles& operator=(const Particles&) = delete;
@@ -249,6 +284,17 @@ namespace ntt {
      */
     void RemoveDead();
 
+    /**
+     * @brief Reorder alive particles by their cell index & remove the dead ones
+     * @param ncells The number of active cells in each direction
+     * @param tile The size of a tile (in cells): particles are grouped per tile
+     * @param morton Use the Morton (Z-order) ordering of cells/tiles
+     * @note tile = 1 corresponds to a plain cell-by-cell ordering
+     * @note With morton ordering, the tiles are binned by their rank along the
+     * Z-order curve (one bin per tile)
+     */
+    void SortByCell(const std::vector<ncells_t>&, ncells_t, bool);
+
     /**
      * @brief Copy particle data from device to host.
      */
@@ -256,36 +302,124 @@ namespace ntt {
 
 #if defined(MPI_ENABLED)
     /**
-     * @brief Communicate particles across neighboring meshblocks
+     * @brief Pack the outgoing particles (one buffer per direction) & post the
+     * sends to the meshblocks of other ranks
      * @param dirs_to_comm The directions requiring communication
      * @param shifts_in_x1 The coordinate shifts in x1 direction per each communicated particle
      * @param shifts_in_x2 The coordinate shifts in x2 direction per each communicated particle
      * @param shifts_in_x3 The coordinate shifts in x3 direction per each communicated particle
      * @param send_ranks The map of ranks per each send direction
+     * @param send_tags The map of MPI tags per each send direction
+     * @param buffers The pool of persistent send/recv buffers
+     * @param domain_idx The index of the meshblock
+     * @returns The state of the exchange (to be passed to `RecvIncoming`)
+     * @note Particles sent to a meshblock of the same rank are only packed
+     */
+    auto SendOutgoing(const dir::dirs_t<D>&,
+                      const array_t<int*>&,
+                      const array_t<int*>&,
+                      const array_t<int*>&,
+                      const dir::map_t<D, int>&,
+                      const dir::map_t<D, int>&,
+                      CommBufferPool&,
+                      unsigned int) -> PrtlExchange<D>;
+
+    /**
+     * @brief Receive the incoming particles & fill the holes left by the
+     * outgoing ones (the rest are appended)
+     * @param exchange The state returned by `SendOutgoing`
+     * @param dirs_to_comm The directions requiring communication
      * @param recv_ranks The map of ranks per each recv direction
+     * @param recv_tags The map of MPI tags per each recv direction
+     * @param local_senders The exchanges of the senders of the same rank per direction
+     * @param buffers The pool of persistent send/recv buffers
+     * @param domain_idx The index of the meshblock
+     * @note Particles from the meshblocks of the same rank are copied directly
+     * from their packed buffers
+     * @note Remote messages are matched (`MPI_Improbe`) & received
+     * (`MPI_Imrecv`) in the order they arrive
+     */
+    void RecvIncoming(PrtlExchange<D>&,
+                      const dir::dirs_t<D>&,
+                      const dir::map_t<D, int>&,
+                      const dir::map_t<D, int>&,
+                      const dir::map_t<D, const PrtlExchange<D>*>&,
+                      CommBufferPool&,
+                      unsigned int);
+
+    /**
+     * @brief Wait for the sends posted in `SendOutgoing` to complete
      */
-    void Communicate(const dir::dirs_t<D>&,
-                     const array_t<int*>&,
-                     const array_t<int*>&,
-                     const array_t<int*>&,
-                     const dir::map_t<D, int>&,
-                     const dir::map_t<D, int>&);
+    void FinishSending(PrtlExchange<D>&) const;
 #endif
 
 #if defined(OUTPUT_ENABLED)
-    void OutputDeclare(adios2::IO&) const;
+    /**
+     * @param packed Declare two packed variables (`pR_*`, `pI_*`) instead of one
+     * variable per quantity
+     * @note In the packed mode, each row of a variable holds one quantity; the
+     * names of the rows are stored in the `pR_*_fields` & `pI_*_fields` attributes
+     */
+    void OutputDeclare(adios2::IO&, bool) const;
 
+    /**
+     * @brief Compact the indices of the particles passing the output selection
+     * @returns The indices & the number of the selected particles
+     * @note Removes the dead particles if the species is not sorted
+     */
+    template <SimEngine::type S, class M>
+    auto OutputSelect(const kernel::PrtlSelection&, const M&)
+      -> std::pair<array_t<npart_t*>, npart_t>;
+
+    /**
+     * @param selection The criteria for the particles to be written
+     * @param out_indices The indices of the selected particles (`OutputSelect`)
+     * @param nout The number of the selected particles
+     * @param packed Gather all the quantities into a single buffer & write it at once
+     * @param nout_total The number of particles written by all the domains
+     * @param nout_offset The number of particles written by the preceding domains
+     */
     template <SimEngine::type S, class M>
     void OutputWrite(adios2::IO&,
                      adios2::Engine&,
+                     const kernel::PrtlSelection&,
+                     const array_t<npart_t*>&,
+                     npart_t,
+                     bool,
+                     npart_t,
                      npart_t,
-                     std::size_t,
-                     std::size_t,
                      const M&);
 
     void CheckpointDeclare(adios2::IO&) const;
-    void CheckpointRead(adios2::IO&, adios2::Engine&, std::size_t, std::size_t);
-    void CheckpointWrite(adios2::IO&, adios2::Engine&, std::size_t, std::size_t) const;
+
+    /**
+     * @brief Append the particles written by one domain of the checkpoint
+     * @param npart_offset The index of the first particle to read
+     * @param npart_count The number of particles to read
+     * @param shift Offset (in cells) of the written domain w.r.t. this one
+     * @param ncells The number of active cells of this domain
+     * @note Particles which do not fall into this domain are discarded, so the
+     * checkpoint may be read with a different domain decomposition
+     */
+    void CheckpointRead(adios2::IO&,
+                        adios2::Engine&,
+                        npart_t,
+                        npart_t,
+                        const std::vector<int>&,
+                        const std::vector<ncells_t>&);
+
+    /**
+     * @param npart_total The number of particles of all the domains
+     * @param npart_offset The number of particles of the preceding domains
+     * @param domains_total The total number of domains
+     * @param domains_offset The index of the domain
+     */
+    void CheckpointWrite(adios2::IO&,
+                         adios2::Engine&,
+                         npart_t,
+                         npart_t,
+                         std::size_t,
+                         std::size_t) const;
 #endif
   };
 
@@ -15,199 +15,106 @@
 
 #include <mpi.h>
 
-#include <numeric>
+#include <utility>
 #include <vector>
 
 namespace ntt {
 
   namespace prtls {
-    template <typename T>
-    void send_recv(array_t<T*>& send_arr,
-                   array_t<T*>& recv_arr,
-                   int          send_rank,
-                   int          recv_rank,
-                   npart_t      nsend,
-                   npart_t      nrecv,
-                   npart_t      offset) {
-#if !defined(DEVICE_ENABLED) || defined(GPU_AWARE_MPI)
-      MPI_Sendrecv(send_arr.data(),
-                   nsend,
-                   mpi::get_type<T>(),
-                   send_rank,
-                   0,
-                   recv_arr.data() + offset,
-                   nrecv,
-                   mpi::get_type<T>(),
-                   recv_rank,
-                   0,
-                   MPI_COMM_WORLD,
-                   MPI_STATUS_IGNORE);
-#else
-      const auto slice = std::make_pair(offset, offset + nrecv);
-
-      auto send_arr_h = Kokkos::create_mirror_view(send_arr);
-      auto recv_arr_h = Kokkos::create_mirror_view(
-        Kokkos::subview(recv_arr, slice));
-      Kokkos::deep_copy(send_arr_h, send_arr);
-      MPI_Sendrecv(send_arr_h.data(),
-                   nsend,
-                   mpi::get_type<T>(),
-                   send_rank,
-                   0,
-                   recv_arr_h.data(),
-                   nrecv,
-                   mpi::get_type<T>(),
-                   recv_rank,
-                   0,
-                   MPI_COMM_WORLD,
-                   MPI_STATUS_IGNORE);
-      Kokkos::deep_copy(Kokkos::subview(recv_arr, slice), recv_arr_h);
-#endif
-    }
-
-    void send_recv_count(int      send_rank,
-                         int      recv_rank,
-                         npart_t  send_count,
-                         npart_t& recv_count) {
-      if ((send_rank >= 0) && (recv_rank >= 0)) {
-        MPI_Sendrecv(&send_count,
-                     1,
-                     mpi::get_type<npart_t>(),
-                     send_rank,
-                     0,
-                     &recv_count,
-                     1,
-                     mpi::get_type<npart_t>(),
-                     recv_rank,
-                     0,
-                     MPI_COMM_WORLD,
-                     MPI_STATUS_IGNORE);
-      } else if (send_rank >= 0) {
-        MPI_Send(&send_count, 1, mpi::get_type<npart_t>(), send_rank, 0, MPI_COMM_WORLD);
-      } else if (recv_rank >= 0) {
-        MPI_Recv(&recv_count,
-                 1,
-                 mpi::get_type<npart_t>(),
-                 recv_rank,
-                 0,
-                 MPI_COMM_WORLD,
-                 MPI_STATUS_IGNORE);
-      } else {
-        raise::Error("ParticleSendRecvCount called with negative ranks", HERE);
+    /**
+     * @brief Layout of the buffer with all the quantities of outgoing particles
+     * @note One buffer (= one message) per direction, with the sections
+     * ordered by decreasing type size so that each is naturally aligned:
+     * [ pld_i | reals | pld_r | prtldx | ints ]
+     */
+    struct PackedLayout {
+      const unsigned short NINTS, NREALS, NPRTLDX, NPLDS_R, NPLDS_I;
+
+      /**
+       * @brief Number of bytes per particle
+       */
+      [[nodiscard]]
+      auto stride() const -> std::size_t {
+        return NPLDS_I * sizeof(npart_t) + (NREALS + NPLDS_R) * sizeof(real_t) +
+               NPRTLDX * sizeof(prtldx_t) + NINTS * sizeof(int);
       }
+    };
+
+    static_assert(sizeof(npart_t) >= sizeof(real_t) and
+                    sizeof(real_t) >= sizeof(prtldx_t) and
+                    sizeof(prtldx_t) >= sizeof(int),
+                  "packed particle buffer sections would be misaligned");
+
+    /**
+     * @brief Layout of the packed buffers for a given species
+     */
+    template <Dimension D, Coord::type C>
+    auto Layout(bool store_prev, unsigned short npld_r, unsigned short npld_i)
+      -> PackedLayout {
+      // number of arrays of each type to send/recv
+      const unsigned short NREALS = 4 + static_cast<unsigned short>(
+                                          D == Dim::_2D and C != Coord::Cart);
+      // lean species do not carry the `*_prev` coordinates
+      const unsigned short NCRD    = store_prev ? 2 : 1;
+      const unsigned short NINTS   = NCRD * static_cast<unsigned short>(D);
+      const unsigned short NPRTLDX = NCRD * static_cast<unsigned short>(D);
+      return { NINTS, NREALS, NPRTLDX, npld_r, npld_i };
     }
 
-    template <typename T>
-    void send(array_t<T*>& send_arr, int send_rank, npart_t nsend) {
-#if !defined(DEVICE_ENABLED) || defined(GPU_AWARE_MPI)
-      MPI_Send(send_arr.data(), nsend, mpi::get_type<T>(), send_rank, 0, MPI_COMM_WORLD);
-#else
-      auto send_arr_h = Kokkos::create_mirror_view(send_arr);
-      Kokkos::deep_copy(send_arr_h, send_arr);
-      MPI_Send(send_arr_h.data(), nsend, mpi::get_type<T>(), send_rank, 0, MPI_COMM_WORLD);
-#endif
-    }
-
-    template <typename T>
-    void recv(array_t<T*>& recv_arr, int recv_rank, npart_t nrecv, npart_t offset) {
-#if !defined(DEVICE_ENABLED) || defined(GPU_AWARE_MPI)
-      MPI_Recv(recv_arr.data() + offset,
-               nrecv,
-               mpi::get_type<T>(),
-               recv_rank,
-               0,
-               MPI_COMM_WORLD,
-               MPI_STATUS_IGNORE);
-#else
-      const auto slice = std::make_pair(offset, offset + nrecv);
-
-      auto recv_arr_h = Kokkos::create_mirror_view(
-        Kokkos::subview(recv_arr, slice));
-      MPI_Recv(recv_arr_h.data(),
-               nrecv,
-               mpi::get_type<T>(),
-               recv_rank,
-               0,
-               MPI_COMM_WORLD,
-               MPI_STATUS_IGNORE);
-      Kokkos::deep_copy(Kokkos::subview(recv_arr, slice), recv_arr_h);
-#endif
-    }
-
-    template <typename T>
-    void communicate(array_t<T*>& send_arr,
-                     array_t<T*>& recv_arr,
-                     int          send_rank,
-                     int          recv_rank,
-                     npart_t      nsend,
-                     npart_t      nrecv,
-                     npart_t      offset) {
-      if (send_rank >= 0 && recv_rank >= 0) {
-        raise::ErrorIf(
-          nrecv + offset > recv_arr.extent(0),
-          "recv_arr is not large enough to hold the received particles",
-          HERE);
-        send_recv<T>(send_arr, recv_arr, send_rank, recv_rank, nsend, nrecv, offset);
-      } else if (send_rank >= 0) {
-        send<T>(send_arr, send_rank, nsend);
-      } else if (recv_rank >= 0) {
-        raise::ErrorIf(
-          nrecv + offset > recv_arr.extent(0),
-          "recv_arr is not large enough to hold the received particles",
-          HERE);
-        recv<T>(recv_arr, recv_rank, nrecv, offset);
-      } else {
-        raise::Error("CommunicateParticles called with negative ranks", HERE);
+    /**
+     * @brief Typed (unmanaged) views into the sections of a packed buffer
+     */
+    struct PackedBuffers {
+      array_t<int*>      ints;
+      array_t<real_t*>   reals;
+      array_t<prtldx_t*> prtldx;
+      array_t<real_t*>   pld_r;
+      array_t<npart_t*>  pld_i;
+
+      PackedBuffers(const array_t<char*>& buff,
+                    npart_t               npart,
+                    const PackedLayout&   layout) {
+        auto ptr = buff.data();
+        pld_i    = array_t<npart_t*> { reinterpret_cast<npart_t*>(ptr),
+                                    npart * layout.NPLDS_I };
+        ptr     += npart * layout.NPLDS_I * sizeof(npart_t);
+        reals    = array_t<real_t*> { reinterpret_cast<real_t*>(ptr),
+                                   npart * layout.NREALS };
+        ptr     += npart * layout.NREALS * sizeof(real_t);
+        pld_r    = array_t<real_t*> { reinterpret_cast<real_t*>(ptr),
+                                   npart * layout.NPLDS_R };
+        ptr     += npart * layout.NPLDS_R * sizeof(real_t);
+        prtldx   = array_t<prtldx_t*> { reinterpret_cast<prtldx_t*>(ptr),
+                                      npart * layout.NPRTLDX };
+        ptr     += npart * layout.NPRTLDX * sizeof(prtldx_t);
+        ints     = array_t<int*> { reinterpret_cast<int*>(ptr),
+                               npart * layout.NINTS };
       }
-    }
+    };
   } // namespace prtls
 
   template <Dimension D, Coord::type C>
-  void Particles<D, C>::Communicate(const dir::dirs_t<D>&     dirs_to_comm,
-                                    const array_t<int*>&      shifts_in_x1,
-                                    const array_t<int*>&      shifts_in_x2,
-                                    const array_t<int*>&      shifts_in_x3,
-                                    const dir::map_t<D, int>& send_ranks,
-                                    const dir::map_t<D, int>& recv_ranks) {
+  auto Particles<D, C>::SendOutgoing(const dir::dirs_t<D>&     dirs_to_comm,
+                                     const array_t<int*>&      shifts_in_x1,
+                                     const array_t<int*>&      shifts_in_x2,
+                                     const array_t<int*>&      shifts_in_x3,
+                                     const dir::map_t<D, int>& send_ranks,
+                                     const dir::map_t<D, int>& send_tags,
+                                     CommBufferPool&           buffers,
+                                     unsigned int domain_idx) -> PrtlExchange<D> {
     logger::Checkpoint(fmt::format("Communicating species #%d\n", index()), HERE);
 
+    PrtlExchange<D> exchange;
+
     // at this point particles should already be tagged in the pusher
     auto [npptag_vec, tag_offsets] = NpartsPerTagAndOffsets();
     const auto npart_dead          = npptag_vec[ParticleTag::dead];
     const auto npart_alive         = npptag_vec[ParticleTag::alive];
 
-    // # of particles to receive per each tag (direction)
-    std::vector<npart_t> npptag_recv_vec(ntags() - 2, 0);
-
-    // total # of received particles from all directions
-    npart_t npart_recv_tot = 0u;
-
-    // loop dir
-    for (const auto& direction : dirs_to_comm) {
-      // tags corresponding to the direction (both send & recv)
-      const auto tag_recv = mpi::PrtlSendTag<D>::dir2tag(-direction);
-      const auto tag_send = mpi::PrtlSendTag<D>::dir2tag(direction);
-
-      // get ranks of send/recv meshblocks
-      const auto send_rank = send_ranks.at(direction);
-      const auto recv_rank = recv_ranks.at(direction);
-
-      // record the # of particles to-be-sent
-      const auto nsend = npptag_vec[tag_send];
-
-      // request the # of particles to-be-received ...
-      // ... and send the # of particles to-be-sent
-      npart_t nrecv = 0;
-      prtls::send_recv_count(send_rank, recv_rank, nsend, nrecv);
-      npart_recv_tot                += nrecv;
-      npptag_recv_vec[tag_recv - 2]  = nrecv;
-
-      raise::ErrorIf((npart() + npart_recv_tot) >= maxnpart(),
-                     "Too many particles to receive (cannot fit into maxptl)",
-                     HERE);
-    }
-
-    array_t<npart_t*> outgoing_indices { "outgoing_indices", npart() - npart_alive };
+    exchange.npart_per_tag    = npptag_vec;
+    exchange.outgoing_indices = array_t<npart_t*> { "outgoing_indices",
+                                                    npart() - npart_alive };
+    auto& outgoing_indices    = exchange.outgoing_indices;
     // clang-format off
     Kokkos::parallel_for(
       "PrepareOutgoingPrtls",
@@ -223,62 +130,30 @@ namespace ntt {
     );
     // clang-format on
 
-    // number of arrays of each type to send/recv
-    const unsigned short NREALS = 4 + static_cast<unsigned short>(
-                                        D == Dim::_2D and C != Coord::Cart);
-    const unsigned short NINTS   = 2 * static_cast<unsigned short>(D);
-    const unsigned short NPRTLDX = 2 * static_cast<unsigned short>(D);
-    const unsigned short NPLDS_R = npld_r();
-    const unsigned short NPLDS_I = npld_i();
-
-    // buffers to store recv data
-    const auto       npart_recv = std::accumulate(npptag_recv_vec.begin(),
-                                            npptag_recv_vec.end(),
-                                            static_cast<npart_t>(0));
-    array_t<int*>    recv_buff_int { "recv_buff_int", npart_recv * NINTS };
-    array_t<real_t*> recv_buff_real { "recv_buff_real", npart_recv * NREALS };
-    array_t<prtldx_t*> recv_buff_prtldx { "recv_buff_prtldx", npart_recv * NPRTLDX };
-    array_t<real_t*>  recv_buff_pld_r;
-    array_t<npart_t*> recv_buff_pld_i;
-
-    if (NPLDS_R > 0) {
-      recv_buff_pld_r = array_t<real_t*> { "recv_buff_pld_r", npart_recv * NPLDS_R };
-    }
-    if (NPLDS_I > 0) {
-      recv_buff_pld_i = array_t<npart_t*> { "recv_buff_pld_i",
-                                            npart_recv * NPLDS_I };
-    }
+    const auto layout = prtls::Layout<D, C>(store_prev(), npld_r(), npld_i());
+
+    // all particle quantities are packed into one message per direction ...
+    // ... a particle is a single element of `prtl_type`, so the element
+    // ... count of the message is the number of communicated particles
+    MPI_Type_contiguous(static_cast<int>(layout.stride()),
+                        MPI_BYTE,
+                        &exchange.prtl_type);
+    MPI_Type_commit(&exchange.prtl_type);
 
-    auto iteration        = 0;
-    auto current_received = 0;
+    auto tag_offsets_h = Kokkos::create_mirror_view(tag_offsets);
+    Kokkos::deep_copy(tag_offsets_h, tag_offsets);
 
+    // pack the outgoing particles for all the directions
     for (const auto& direction : dirs_to_comm) {
-      const auto send_rank     = send_ranks.at(direction);
-      const auto recv_rank     = recv_ranks.at(direction);
-      const auto tag_send      = mpi::PrtlSendTag<D>::dir2tag(direction);
-      const auto tag_recv      = mpi::PrtlSendTag<D>::dir2tag(-direction);
-      const auto npart_send_in = npptag_vec[tag_send];
-      const auto npart_recv_in = npptag_recv_vec[tag_recv - 2];
-      if (send_rank < 0 and recv_rank < 0) {
+      const auto send_rank = send_ranks.at(direction);
+      if (send_rank < 0) {
         continue;
       }
-      array_t<int*> send_buff_int { "send_buff_int", npart_send_in * NINTS };
-      array_t<real_t*> send_buff_real { "send_buff_real", npart_send_in * NREALS };
-      array_t<prtldx_t*> send_buff_prtldx { "send_buff_prtldx",
-                                            npart_send_in * NPRTLDX };
-      array_t<real_t*>   send_buff_pld_r;
-      array_t<npart_t*>  send_buff_pld_i;
-      if (NPLDS_R > 0) {
-        send_buff_pld_r = array_t<real_t*> { "send_buff_pld_r",
-                                             npart_send_in * NPLDS_R };
-      }
-      if (NPLDS_I > 0) {
-        send_buff_pld_i = array_t<npart_t*> { "send_buff_pld_i",
-                                              npart_send_in * NPLDS_I };
-      }
-
-      auto tag_offsets_h = Kokkos::create_mirror_view(tag_offsets);
-      Kokkos::deep_copy(tag_offsets_h, tag_offsets);
+      const auto tag_send  = mpi::PrtlSendTag<D>::dir2tag(direction);
+      const auto nsend     = npptag_vec[tag_send];
+      const auto send_buff = buffers.send({ "prtl", domain_idx, direction.hash() },
+                                          nsend * layout.stride());
+      prtls::PackedBuffers send { send_buff.data, nsend, layout };
 
       npart_t idx_offset = npart_dead;
       if (tag_send > 2) {
@@ -287,10 +162,11 @@ namespace ntt {
       // clang-format off
       Kokkos::parallel_for(
         "PopulatePrtlSendBuffer",
-        npart_send_in,
+        nsend,
         kernel::comm::PopulatePrtlSendBuffer_kernel<D, C>(
-          send_buff_int, send_buff_real, send_buff_prtldx, send_buff_pld_r, send_buff_pld_i,
-          NINTS, NREALS, NPRTLDX, NPLDS_R, NPLDS_I, idx_offset,
+          send.ints, send.reals, send.prtldx, send.pld_r, send.pld_i,
+          layout.NINTS, layout.NREALS, layout.NPRTLDX, layout.NPLDS_R, layout.NPLDS_I,
+          idx_offset,
           i1, i1_prev, dx1, dx1_prev,
           i2, i2_prev, dx2, dx2_prev,
           i3, i3_prev, dx3, dx3_prev,
@@ -299,73 +175,168 @@ namespace ntt {
           outgoing_indices)
       );
       // clang-format on
+      exchange.send_buffs[direction] = send_buff;
+    }
+    Kokkos::fence();
 
-      const auto recv_offset_int    = current_received * NINTS;
-      const auto recv_offset_real   = current_received * NREALS;
-      const auto recv_offset_prtldx = current_received * NPRTLDX;
-      const auto recv_offset_pld_r  = current_received * NPLDS_R;
-      const auto recv_offset_pld_i  = current_received * NPLDS_I;
-
-      prtls::communicate<int>(send_buff_int,
-                              recv_buff_int,
-                              send_rank,
-                              recv_rank,
-                              npart_send_in * NINTS,
-                              npart_recv_in * NINTS,
-                              recv_offset_int);
-      prtls::communicate<real_t>(send_buff_real,
-                                 recv_buff_real,
-                                 send_rank,
-                                 recv_rank,
-                                 npart_send_in * NREALS,
-                                 npart_recv_in * NREALS,
-                                 recv_offset_real);
-      prtls::communicate<prtldx_t>(send_buff_prtldx,
-                                   recv_buff_prtldx,
-                                   send_rank,
-                                   recv_rank,
-                                   npart_send_in * NPRTLDX,
-                                   npart_recv_in * NPRTLDX,
-                                   recv_offset_prtldx);
-      if (NPLDS_R > 0) {
-        prtls::communicate<real_t>(send_buff_pld_r,
-                                   recv_buff_pld_r,
-                                   send_rank,
-                                   recv_rank,
-                                   npart_send_in * NPLDS_R,
-                                   npart_recv_in * NPLDS_R,
-                                   recv_offset_pld_r);
-      }
-      if (NPLDS_I > 0) {
-        prtls::communicate<npart_t>(send_buff_pld_i,
-                                    recv_buff_pld_i,
-                                    send_rank,
-                                    recv_rank,
-                                    npart_send_in * NPLDS_I,
-                                    npart_recv_in * NPLDS_I,
-                                    recv_offset_pld_i);
+    // post all the sends to other ranks at once
+    int rank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    exchange.requests.reserve(dirs_to_comm.size());
+    for (const auto& [direction, send_buff] : exchange.send_buffs) {
+      const auto send_rank = send_ranks.at(direction);
+      if (send_rank == rank) {
+        continue;
       }
-      current_received += npart_recv_in;
-      iteration++;
+      const auto nsend = static_cast<int>(
+        npptag_vec[mpi::PrtlSendTag<D>::dir2tag(direction)]);
+      exchange.requests.emplace_back();
+#if !defined(DEVICE_ENABLED) || defined(GPU_AWARE_MPI)
+      MPI_Isend(send_buff.data.data(),
+                nsend,
+                exchange.prtl_type,
+                send_rank,
+                send_tags.at(direction),
+                MPI_COMM_WORLD,
+                &exchange.requests.back());
+#else
+      Kokkos::deep_copy(send_buff.host, send_buff.data);
+      MPI_Isend(send_buff.host.data(),
+                nsend,
+                exchange.prtl_type,
+                send_rank,
+                send_tags.at(direction),
+                MPI_COMM_WORLD,
+                &exchange.requests.back());
+#endif
+    }
+    return exchange;
+  }
 
-    } // end direction loop
+  template <Dimension D, Coord::type C>
+  void Particles<D, C>::RecvIncoming(
+    PrtlExchange<D>&                             exchange,
+    const dir::dirs_t<D>&                        dirs_to_comm,
+    const dir::map_t<D, int>&                    recv_ranks,
+    const dir::map_t<D, int>&                    recv_tags,
+    const dir::map_t<D, const PrtlExchange<D>*>& local_senders,
+    CommBufferPool&                              buffers,
+    unsigned int                                 domain_idx) {
+    const auto layout = prtls::Layout<D, C>(store_prev(), npld_r(), npld_i());
+
+    int rank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+    // particles from the same rank are taken from the sender's buffers ...
+    // ... the remote messages are received in the order they arrive
+    std::vector<CommBuffer> recv_buffs;
+    std::vector<npart_t>    nrecv_vec;
+    std::vector<bool>       is_remote;
+    npart_t                 npart_recv = 0;
+
+    // directions still waiting for a message (with their slot in the above)
+    std::vector<std::pair<dir::direction_t<D>, std::size_t>> pending;
+    for (const auto& direction : dirs_to_comm) {
+      const auto recv_rank = recv_ranks.at(direction);
+      if (recv_rank < 0) {
+        continue;
+      }
+      if (recv_rank == rank) {
+        const auto* sender = local_senders.at(direction);
+        nrecv_vec.push_back(
+          sender->npart_per_tag[mpi::PrtlSendTag<D>::dir2tag(direction)]);
+        recv_buffs.push_back(sender->send_buffs.at(direction));
+        is_remote.push_back(false);
+        npart_recv += nrecv_vec.back();
+      } else {
+        pending.emplace_back(direction, recv_buffs.size());
+        nrecv_vec.push_back(0);
+        recv_buffs.emplace_back();
+        is_remote.push_back(true);
+      }
+    }
 
-    // clang-format off
-    Kokkos::parallel_for(
-      "PopulateFromRecvBuffer",
-      npart_recv,
-      kernel::comm::ExtractReceivedPrtls_kernel<D, C>(
-            recv_buff_int, recv_buff_real, recv_buff_prtldx, recv_buff_pld_r, recv_buff_pld_i,
-            NINTS, NREALS, NPRTLDX, NPLDS_R, NPLDS_I,
-            npart(),
-            i1, i1_prev, dx1, dx1_prev,
-            i2, i2_prev, dx2, dx2_prev,
-            i3, i3_prev, dx3, dx3_prev,
-            ux1, ux2, ux3,
-            weight, phi, pld_r, pld_i, tag,
-            outgoing_indices)
-    );
-    // clang-format on
+    // poll the pending directions: a matched message is received right away,
+    // so a late neighbor does not hold back the others
+    std::vector<MPI_Request> requests;
+    requests.reserve(pending.size());
+    while (not pending.empty()) {
+      for (auto p { 0u }; p < pending.size();) {
+        const auto& [direction, slot] = pending[p];
+        int         flag              = 0;
+        MPI_Message message;
+        MPI_Status  status;
+        MPI_Improbe(recv_ranks.at(direction),
+                    recv_tags.at(direction),
+                    MPI_COMM_WORLD,
+                    &flag,
+                    &message,
+                    &status);
+        if (not flag) {
+          ++p;
+          continue;
+        }
+        int nrecv_int = 0;
+        MPI_Get_count(&status, exchange.prtl_type, &nrecv_int);
+        nrecv_vec[slot]  = static_cast<npart_t>(nrecv_int);
+        npart_recv      += nrecv_vec[slot];
+        recv_buffs[slot] = buffers.recv(
+          { "prtl", domain_idx, direction.hash() },
+          nrecv_vec[slot] * layout.stride());
+        requests.emplace_back();
+#if !defined(DEVICE_ENABLED) || defined(GPU_AWARE_MPI)
+        MPI_Imrecv(recv_buffs[slot].data.data(),
+                   nrecv_int,
+                   exchange.prtl_type,
+                   &message,
+                   &requests.back());
+#else
+        MPI_Imrecv(recv_buffs[slot].host.data(),
+                   nrecv_int,
+                   exchange.prtl_type,
+                   &message,
+                   &requests.back());
+#endif
+        pending[p] = pending.back();
+        pending.pop_back();
+      }
+    }
+    raise::ErrorIf((npart() + npart_recv) >= maxnpart(),
+                   "Too many particles to receive (cannot fit into maxptl)",
+                   HERE);
+
+    MPI_Waitall(static_cast<int>(requests.size()),
+                requests.data(),
+                MPI_STATUSES_IGNORE);
+
+    // unpack the received particles into the holes (and then to the end)
+    const auto& outgoing_indices = exchange.outgoing_indices;
+    npart_t     current_received = 0;
+    for (auto r { 0u }; r < recv_buffs.size(); ++r) {
+#if defined(DEVICE_ENABLED) && !defined(GPU_AWARE_MPI)
+      if (is_remote[r]) {
+        Kokkos::deep_copy(recv_buffs[r].data, recv_buffs[r].host);
+      }
+#endif
+      prtls::PackedBuffers recv { recv_buffs[r].data, nrecv_vec[r], layout };
+      // clang-format off
+      Kokkos::parallel_for(
+        "PopulateFromRecvBuffer",
+        nrecv_vec[r],
+        kernel::comm::ExtractReceivedPrtls_kernel<D, C>(
+              recv.ints, recv.reals, recv.prtldx, recv.pld_r, recv.pld_i,
+              layout.NINTS, layout.NREALS, layout.NPRTLDX, layout.NPLDS_R, layout.NPLDS_I,
+              npart(), current_received,
+              i1, i1_prev, dx1, dx1_prev,
+              i2, i2_prev, dx2, dx2_prev,
+              i3, i3_prev, dx3, dx3_prev,
+              ux1, ux2, ux3,
+              weight, phi, pld_r, pld_i, tag,
+              outgoing_indices)
+      );
+      // clang-format on
+      current_received += nrecv_vec[r];
+    }
 
     const auto npart_holes = outgoing_indices.extent(0);
     if (npart_recv > npart_holes) {
@@ -374,13 +345,33 @@ namespace ntt {
     set_unsorted();
   }
 
+  template <Dimension D, Coord::type C>
+  void Particles<D, C>::FinishSending(PrtlExchange<D>& exchange) const {
+    MPI_Waitall(static_cast<int>(exchange.requests.size()),
+                exchange.requests.data(),
+                MPI_STATUSES_IGNORE);
+    exchange.requests.clear();
+    MPI_Type_free(&exchange.prtl_type);
+  }
+
 #define PARTICLES_COMM(D, C)                                                   \
-  template void Particles<D, C>::Communicate(const dir::dirs_t<D>&,            \
-                                             const array_t<int*>&,             \
-                                             const array_t<int*>&,             \
-                                             const array_t<int*>&,             \
-                                             const dir::map_t<D, int>&,        \
-                                             const dir::map_t<D, int>&);
+  template auto Particles<D, C>::SendOutgoing(const dir::dirs_t<D>&,           \
+                                              const array_t<int*>&,            \
+                                              const array_t<int*>&,            \
+                                              const array_t<int*>&,            \
+                                              const dir::map_t<D, int>&,       \
+                                              const dir::map_t<D, int>&,       \
+                                              CommBufferPool&,                 \
+                                              unsigned int) -> PrtlExchange<D>; \
+  template void Particles<D, C>::RecvIncoming(                                 \
+    PrtlExchange<D>&,                                                          \
+    const dir::dirs_t<D>&,                                                     \
+    const dir::map_t<D, int>&,                                                 \
+    const dir::map_t<D, int>&,                                                 \
+    const dir::map_t<D, const PrtlExchange<D>*>&,                              \
+    CommBufferPool&,                                                           \
+    unsigned int);                                                             \
+  template void Particles<D, C>::FinishSending(PrtlExchange<D>&) const;
 
   PARTICLES_COMM(Dim::_1D, Coord::Cart)
   PARTICLES_COMM(Dim::_2D, Coord::Cart)
@@ -17,6 +17,7 @@
 #include "output/utils/readers.h"
 #include "output/utils/writers.h"
 
+#include "kernels/particle_selection.hpp"
 #include "kernels/prtls_to_phys.hpp"
 
 #include <Kokkos_Core.hpp>
@@ -26,14 +27,64 @@
   #include <mpi.h>
 #endif
 
+#include <algorithm>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
 namespace ntt {
   /* * * * * * * * *
    * Output
    * * * * * * * * */
   template <Dimension D, Coord::type C>
-  void Particles<D, C>::OutputDeclare(adios2::IO& io) const {
+  void Particles<D, C>::OutputDeclare(adios2::IO& io, bool packed) const {
     const auto n_addition_coords = ((D == Dim::_2D) and (C != Coord::Cart)) ? 1
                                                                             : 0;
+    if (packed) {
+      // one row per quantity, in the same order as in the packing kernel
+      std::vector<std::string> fields_r, fields_i;
+      for (auto d { 0u }; d < D + n_addition_coords; ++d) {
+        fields_r.push_back(fmt::format("X%d", d + 1));
+      }
+      for (auto d { 0u }; d < Dim::_3D; ++d) {
+        fields_r.push_back(fmt::format("U%d", d + 1));
+      }
+      fields_r.push_back("W");
+      for (auto pr { 0 }; pr < npld_r(); ++pr) {
+        fields_r.push_back(fmt::format("PLDR%d", pr));
+      }
+      auto num_track_plds = 0;
+      if (use_tracking()) {
+        fields_i.push_back("IDX");
+#if !defined(MPI_ENABLED)
+        num_track_plds = 1;
+#else
+        num_track_plds = 2;
+        fields_i.push_back("RNK");
+#endif
+      }
+      for (auto pr { num_track_plds }; pr < npld_i(); ++pr) {
+        fields_i.push_back(fmt::format("PLDI%d", pr - num_track_plds));
+      }
+      io.DefineVariable<real_t>(fmt::format("pR_%d", index()),
+                                { fields_r.size(), adios2::UnknownDim },
+                                { 0, adios2::UnknownDim },
+                                { fields_r.size(), adios2::UnknownDim });
+      io.DefineAttribute<std::string>(fmt::format("pR_%d_fields", index()),
+                                      fields_r.data(),
+                                      fields_r.size());
+      if (not fields_i.empty()) {
+        io.DefineVariable<npart_t>(fmt::format("pI_%d", index()),
+                                   { fields_i.size(), adios2::UnknownDim },
+                                   { 0, adios2::UnknownDim },
+                                   { fields_i.size(), adios2::UnknownDim });
+        io.DefineAttribute<std::string>(fmt::format("pI_%d_fields", index()),
+                                        fields_i.data(),
+                                        fields_i.size());
+      }
+      return;
+    }
     for (auto d { 0u }; d < D + n_addition_coords; ++d) {
       io.DefineVariable<real_t>(fmt::format("pX%d_%d", d + 1, index()),
                                 { adios2::UnknownDim },
@@ -87,66 +138,84 @@ namespace ntt {
 
   template <Dimension D, Coord::type C>
   template <SimEngine::type S, class M>
-  void Particles<D, C>::OutputWrite(adios2::IO&     io,
-                                    adios2::Engine& writer,
-                                    npart_t         prtl_stride,
-                                    std::size_t     domains_total,
-                                    std::size_t     domains_offset,
-                                    const M&        metric) {
+  auto Particles<D, C>::OutputSelect(const kernel::PrtlSelection& selection,
+                                     const M&                     metric)
+    -> std::pair<array_t<npart_t*>, npart_t> {
     if (not is_sorted()) {
       RemoveDead();
     }
-    npart_t           nout;
-    array_t<npart_t*> out_indices;
-    if (!use_tracking()) {
-      nout = npart() / prtl_stride;
-    } else {
-      nout               = 0u;
-      const auto tag_d   = this->tag;
-      const auto pld_i_d = this->pld_i;
-      Kokkos::parallel_reduce(
-        "CountOutputParticles",
-        rangeActiveParticles(),
-        Lambda(index_t p, npart_t & l_nout) {
-          if ((tag_d(p) == ParticleTag::alive) and
-              (pld_i_d(p, pldi::spcCtr) % prtl_stride == 0)) {
-            l_nout += 1;
-          }
-        },
-        nout);
-      out_indices = array_t<npart_t*> { "out_indices", nout };
-      array_t<npart_t> out_counter { "out_counter" };
-      Kokkos::parallel_for(
-        "RecordOutputIndices",
-        rangeActiveParticles(),
-        Lambda(index_t p) {
-          if ((tag_d(p) == ParticleTag::alive) and
-              (pld_i_d(p, pldi::spcCtr) % prtl_stride == 0)) {
-            const auto p_out   = Kokkos::atomic_fetch_add(&out_counter(), 1);
-            out_indices(p_out) = p;
-          }
-        });
-    }
+    // indices of the selected particles are compacted in one pass ...
+    // ... the total returned by the scan sizes the output buffers
+    array_t<npart_t*> out_indices { "out_indices", npart() };
+    npart_t           nout = 0u;
+    // clang-format off
+    Kokkos::parallel_scan(
+      "SelectOutputParticles",
+      rangeActiveParticles(),
+      kernel::SelectPrtls_kernel<S, M>(selection, out_indices,
+                                       i1, i2, i3,
+                                       dx1, dx2, dx3,
+                                       ux1, ux2, ux3,
+                                       tag, pld_i,
+                                       mass(), use_tracking(),
+                                       metric),
+      nout);
+    // clang-format on
+    return { out_indices, nout };
+  }
 
-    npart_t nout_offset = 0;
-    npart_t nout_total  = nout;
-#if defined(MPI_ENABLED)
-    auto nout_total_vec = std::vector<npart_t>(domains_total);
-    MPI_Allgather(&nout,
-                  1,
-                  mpi::get_type<npart_t>(),
-                  nout_total_vec.data(),
-                  1,
-                  mpi::get_type<npart_t>(),
-                  MPI_COMM_WORLD);
-    nout_total = 0;
-    for (auto r = 0; r < domains_total; ++r) {
-      if (r < domains_offset) {
-        nout_offset += nout_total_vec[r];
+  template <Dimension D, Coord::type C>
+  template <SimEngine::type S, class M>
+  void Particles<D, C>::OutputWrite(adios2::IO&                  io,
+                                    adios2::Engine&              writer,
+                                    const kernel::PrtlSelection& selection,
+                                    const array_t<npart_t*>&     out_indices,
+                                    npart_t                      nout,
+                                    bool                         packed,
+                                    npart_t                      nout_total,
+                                    npart_t                      nout_offset,
+                                    const M&                     metric) {
+    if (packed) {
+      // all the quantities are gathered in one kernel into a row-major buffer
+      // ... and written with a single transfer per type
+      using kernel_t = kernel::PrtlToPhysPacked_kernel<S, M>;
+      packed_array_t<real_t**>  buff_r { "prtl_r",
+                                         kernel_t::n_x + 4u + npld_r(),
+                                         nout };
+      packed_array_t<npart_t**> buff_i { "prtl_i", npld_i(), nout };
+      if (nout > 0) {
+        // clang-format off
+        Kokkos::parallel_for(
+          "PrtlToPhysPacked",
+          nout,
+          kernel_t(out_indices,
+                   buff_r, buff_i,
+                   i1, i2, i3,
+                   dx1, dx2, dx3,
+                   ux1, ux2, ux3,
+                   phi, weight,
+                   pld_r, pld_i,
+                   metric));
+        // clang-format on
+      }
+      out::WritePackedArray<real_t>(io,
+                                    writer,
+                                    fmt::format("pR_%d", index()),
+                                    buff_r,
+                                    nout,
+                                    nout_total,
+                                    nout_offset);
+      if (npld_i() > 0) {
+        out::WritePackedArray<npart_t>(io,
+                                       writer,
+                                       fmt::format("pI_%d", index()),
+                                       buff_i,
+                                       nout,
+                                       nout_total,
+                                       nout_offset);
       }
-      nout_total += nout_total_vec[r];
+      return;
     }
-#endif // MPI_ENABLED
 
     array_t<real_t*> buff_x1, buff_x2, buff_x3;
     array_t<real_t*> buff_ux1 { "ux1", nout };
@@ -173,41 +242,22 @@ namespace ntt {
     }
 
     if (nout > 0) {
-      if (!use_tracking()) {
-        // clang-format off
-        Kokkos::parallel_for(
-          "PrtlToPhys",
-          nout,
-          kernel::PrtlToPhys_kernel<S, M, false>(prtl_stride, out_indices,
-                                                 buff_x1, buff_x2, buff_x3,
-                                                 buff_ux1, buff_ux2, buff_ux3,
-                                                 buff_wei, 
-                                                 buff_pldr, buff_pldi,
-                                                 i1, i2, i3,
-                                                 dx1, dx2, dx3,
-                                                 ux1, ux2, ux3,
-                                                 phi, weight, 
-                                                 pld_r, pld_i,
-                                                 metric));
-        // clang-format on
-      } else {
-        // clang-format off
-        Kokkos::parallel_for(
-          "PrtlToPhys",
-          nout,
-          kernel::PrtlToPhys_kernel<S, M, true>(prtl_stride, out_indices,
-                                                buff_x1, buff_x2, buff_x3,
-                                                buff_ux1, buff_ux2, buff_ux3,
-                                                buff_wei, 
-                                                buff_pldr, buff_pldi,
-                                                i1, i2, i3,
-                                                dx1, dx2, dx3,
-                                                ux1, ux2, ux3,
-                                                phi, weight, 
-                                                pld_r, pld_i,
-                                                metric));
-        // clang-format on
-      }
+      // clang-format off
+      Kokkos::parallel_for(
+        "PrtlToPhys",
+        nout,
+        kernel::PrtlToPhys_kernel<S, M, true>(selection.stride, out_indices,
+                                              buff_x1, buff_x2, buff_x3,
+                                              buff_ux1, buff_ux2, buff_ux3,
+                                              buff_wei,
+                                              buff_pldr, buff_pldi,
+                                              i1, i2, i3,
+                                              dx1, dx2, dx3,
+                                              ux1, ux2, ux3,
+                                              phi, weight,
+                                              pld_r, pld_i,
+                                              metric));
+      // clang-format on
     }
     out::Write1DArray<real_t>(io,
                               writer,
@@ -369,14 +419,17 @@ namespace ntt {
                                   { adios2::UnknownDim },
                                   { adios2::UnknownDim },
                                   { adios2::UnknownDim });
-      io.DefineVariable<int>(fmt::format("s%d_i%d_prev", index(), d + 1),
-                             { adios2::UnknownDim },
-                             { adios2::UnknownDim },
-                             { adios2::UnknownDim });
-      io.DefineVariable<prtldx_t>(fmt::format("s%d_dx%d_prev", index(), d + 1),
-                                  { adios2::UnknownDim },
-                                  { adios2::UnknownDim },
-                                  { adios2::UnknownDim });
+      if (store_prev()) {
+        io.DefineVariable<int>(fmt::format("s%d_i%d_prev", index(), d + 1),
+                               { adios2::UnknownDim },
+                               { adios2::UnknownDim },
+                               { adios2::UnknownDim });
+        io.DefineVariable<prtldx_t>(
+          fmt::format("s%d_dx%d_prev", index(), d + 1),
+          { adios2::UnknownDim },
+          { adios2::UnknownDim },
+          { adios2::UnknownDim });
+      }
     }
 
     if constexpr (D == Dim::_2D and C != ntt::Coord::Cart) {
@@ -416,222 +469,189 @@ namespace ntt {
   }
 
   template <Dimension D, Coord::type C>
-  void Particles<D, C>::CheckpointRead(adios2::IO&     io,
-                                       adios2::Engine& reader,
-                                       std::size_t     domains_total,
-                                       std::size_t     domains_offset) {
+  void Particles<D, C>::CheckpointRead(adios2::IO&                  io,
+                                       adios2::Engine&              reader,
+                                       npart_t                      npart_offset,
+                                       npart_t                      npart_count,
+                                       const std::vector<int>&      shift,
+                                       const std::vector<ncells_t>& ncells) {
     logger::Checkpoint(
       fmt::format("Reading particle checkpoint for species #%d", index()),
       HERE);
-    raise::ErrorIf(npart() > 0,
-                   "Particles already initialized before reading checkpoint",
+    raise::ErrorIf((shift.size() != static_cast<std::size_t>(D)) or
+                     (ncells.size() != static_cast<std::size_t>(D)),
+                   "Invalid domain shape when reading checkpoint",
                    HERE);
-    npart_t npart_offset = 0u;
-    npart_t npart_read;
-
-    out::ReadVariable<npart_t>(io,
-                               reader,
-                               fmt::format("s%d_npart", index()),
-                               npart_read,
-                               domains_offset);
-    set_npart(npart_read);
 
-#if defined(MPI_ENABLED)
-    {
-      const auto           npart_send = npart();
-      std::vector<npart_t> glob_nparts(domains_total);
-      MPI_Allgather(&npart_send,
-                    1,
-                    mpi::get_type<npart_t>(),
-                    glob_nparts.data(),
-                    1,
-                    mpi::get_type<npart_t>(),
-                    MPI_COMM_WORLD);
-      for (auto d { 0u }; d < domains_offset; ++d) {
-        npart_offset += glob_nparts[d];
+    const auto read_array = [&](const std::string& name,
+                                auto&              arr,
+                                npart_t            nread,
+                                npart_t            offset) {
+      using T = typename std::remove_reference_t<decltype(arr)>::value_type;
+      out::Read1DArray<T>(io,
+                          reader,
+                          fmt::format("s%d_%s", index(), name.c_str()),
+                          arr,
+                          nread,
+                          offset,
+                          npart());
+    };
+
+    // checkpoints written in the lean layout have no `*_prev` arrays ...
+    // ... those are then initialized from the current coordinates
+    const auto has_prev = store_prev() and
+                          static_cast<bool>(io.InquireVariable<int>(
+                            fmt::format("s%d_i1_prev", index())));
+    const auto read_prev = [&](const std::string& name,
+                               auto&              arr_prev,
+                               const auto&        arr,
+                               npart_t            nread,
+                               npart_t            offset) {
+      if (has_prev) {
+        read_array(name + "_prev", arr_prev, nread, offset);
+      } else {
+        const auto range = std::make_pair(npart(), npart() + nread);
+        Kokkos::deep_copy(Kokkos::subview(arr_prev, range),
+                          Kokkos::subview(arr, range));
       }
-    }
-#endif
-    out::ReadVariable<npart_t>(io,
-                               reader,
-                               fmt::format("s%d_counter", index()),
-                               m_counter,
-                               domains_offset);
-
-    if constexpr (D == Dim::_1D or D == Dim::_2D or D == Dim::_3D) {
-      out::Read1DArray<int>(io,
-                            reader,
-                            fmt::format("s%d_i1", index()),
-                            i1,
-                            npart(),
-                            npart_offset);
-      out::Read1DArray<prtldx_t>(io,
-                                 reader,
-                                 fmt::format("s%d_dx1", index()),
-                                 dx1,
-                                 npart(),
-                                 npart_offset);
-      out::Read1DArray<int>(io,
-                            reader,
-                            fmt::format("s%d_i1_prev", index()),
-                            i1_prev,
-                            npart(),
-                            npart_offset);
-      out::Read1DArray<prtldx_t>(io,
-                                 reader,
-                                 fmt::format("s%d_dx1_prev", index()),
-                                 dx1_prev,
-                                 npart(),
-                                 npart_offset);
-    }
+    };
 
-    if constexpr (D == Dim::_2D or D == Dim::_3D) {
-      out::Read1DArray<int>(io,
-                            reader,
-                            fmt::format("s%d_i2", index()),
-                            i2,
-                            npart(),
-                            npart_offset);
-      out::Read1DArray<prtldx_t>(io,
-                                 reader,
-                                 fmt::format("s%d_dx2", index()),
-                                 dx2,
-                                 npart(),
-                                 npart_offset);
-      out::Read1DArray<int>(io,
-                            reader,
-                            fmt::format("s%d_i2_prev", index()),
-                            i2_prev,
-                            npart(),
-                            npart_offset);
-      out::Read1DArray<prtldx_t>(io,
-                                 reader,
-                                 fmt::format("s%d_dx2_prev", index()),
-                                 dx2_prev,
-                                 npart(),
-                                 npart_offset);
-    }
-
-    if constexpr (D == Dim::_3D) {
-      out::Read1DArray<int>(io,
-                            reader,
-                            fmt::format("s%d_i3", index()),
-                            i3,
-                            npart(),
-                            npart_offset);
-      out::Read1DArray<prtldx_t>(io,
-                                 reader,
-                                 fmt::format("s%d_dx3", index()),
-                                 dx3,
-                                 npart(),
-                                 npart_offset);
-      out::Read1DArray<int>(io,
-                            reader,
-                            fmt::format("s%d_i3_prev", index()),
-                            i3_prev,
-                            npart(),
-                            npart_offset);
-      out::Read1DArray<prtldx_t>(io,
+    int sh[3] { 0, 0, 0 }, ni[3] { 0, 0, 0 };
+    for (auto d { 0u }; d < static_cast<unsigned short>(D); ++d) {
+      sh[d] = shift[d];
+      ni[d] = static_cast<int>(ncells[d]);
+    }
+    const auto sh1 = sh[0], sh2 = sh[1], sh3 = sh[2];
+    const auto ni1 = ni[0], ni2 = ni[1], ni3 = ni[2];
+
+    // the particles are read in chunks that fit into the free space ...
+    // ... those outside of the domain are discarded after each chunk
+    while (npart_count > 0) {
+      raise::ErrorIf(npart() >= maxnpart(),
+                     "Too many particles to read from checkpoint (cannot fit "
+                     "into maxptl)",
+                     HERE);
+      const auto nread = std::min(npart_count, maxnpart() - npart());
+
+      if constexpr (D == Dim::_1D or D == Dim::_2D or D == Dim::_3D) {
+        read_array("i1", i1, nread, npart_offset);
+        read_array("dx1", dx1, nread, npart_offset);
+        if (store_prev()) {
+          read_prev("i1", i1_prev, i1, nread, npart_offset);
+          read_prev("dx1", dx1_prev, dx1, nread, npart_offset);
+        }
+      }
+      if constexpr (D == Dim::_2D or D == Dim::_3D) {
+        read_array("i2", i2, nread, npart_offset);
+        read_array("dx2", dx2, nread, npart_offset);
+        if (store_prev()) {
+          read_prev("i2", i2_prev, i2, nread, npart_offset);
+          read_prev("dx2", dx2_prev, dx2, nread, npart_offset);
+        }
+      }
+      if constexpr (D == Dim::_3D) {
+        read_array("i3", i3, nread, npart_offset);
+        read_array("dx3", dx3, nread, npart_offset);
+        if (store_prev()) {
+          read_prev("i3", i3_prev, i3, nread, npart_offset);
+          read_prev("dx3", dx3_prev, dx3, nread, npart_offset);
+        }
+      }
+      if constexpr (D == Dim::_2D and C != Coord::Cart) {
+        read_array("phi", phi, nread, npart_offset);
+      }
+      read_array("ux1", ux1, nread, npart_offset);
+      read_array("ux2", ux2, nread, npart_offset);
+      read_array("ux3", ux3, nread, npart_offset);
+      read_array("tag", tag, nread, npart_offset);
+      read_array("weight", weight, nread, npart_offset);
+      if (npld_r() > 0) {
+        out::Read2DArray<real_t>(io,
                                  reader,
-                                 fmt::format("s%d_dx3_prev", index()),
-                                 dx3_prev,
-                                 npart(),
-                                 npart_offset);
-    }
-
-    if constexpr (D == Dim::_2D and C != Coord::Cart) {
-      out::Read1DArray<real_t>(io,
-                               reader,
-                               fmt::format("s%d_phi", index()),
-                               phi,
-                               npart(),
-                               npart_offset);
-    }
-
-    out::Read1DArray<real_t>(io,
-                             reader,
-                             fmt::format("s%d_ux1", index()),
-                             ux1,
-                             npart(),
-                             npart_offset);
-    out::Read1DArray<real_t>(io,
-                             reader,
-                             fmt::format("s%d_ux2", index()),
-                             ux2,
-                             npart(),
-                             npart_offset);
-    out::Read1DArray<real_t>(io,
-                             reader,
-                             fmt::format("s%d_ux3", index()),
-                             ux3,
-                             npart(),
-                             npart_offset);
-    out::Read1DArray<short>(io,
-                            reader,
-                            fmt::format("s%d_tag", index()),
-                            tag,
-                            npart(),
-                            npart_offset);
-    out::Read1DArray<real_t>(io,
-                             reader,
-                             fmt::format("s%d_weight", index()),
-                             weight,
-                             npart(),
-                             npart_offset);
+                                 fmt::format("s%d_pld_r", index()),
+                                 pld_r,
+                                 npld_r(),
+                                 nread,
+                                 npart_offset,
+                                 npart());
+      }
+      if (npld_i() > 0) {
+        out::Read2DArray<npart_t>(io,
+                                  reader,
+                                  fmt::format("s%d_pld_i", index()),
+                                  pld_i,
+                                  npld_i(),
+                                  nread,
+                                  npart_offset,
+                                  npart());
+      }
 
-    if (npld_r() > 0) {
-      out::Read2DArray<real_t>(io,
-                               reader,
-                               fmt::format("s%d_pld_r", index()),
-                               pld_r,
-                               npld_r(),
-                               npart(),
-                               npart_offset);
-    }
+      // move to the coordinates of this domain & discard the outsiders
+      auto       i1 = this->i1, i2 = this->i2, i3 = this->i3;
+      auto       i1_prev = this->i1_prev, i2_prev = this->i2_prev,
+           i3_prev = this->i3_prev;
+      auto       tag        = this->tag;
+      const auto store_prev = this->store_prev();
+      npart_t    ndead      = 0;
+      Kokkos::parallel_reduce(
+        "ShiftCheckpointPrtls",
+        CreateParticleRangePolicy(npart(), npart() + nread),
+        Lambda(index_t p, npart_t & nd) {
+          if (tag(p) != ParticleTag::alive) {
+            nd += 1;
+            return;
+          }
+          bool outside = false;
+          if constexpr (D == Dim::_1D or D == Dim::_2D or D == Dim::_3D) {
+            i1(p)   += sh1;
+            outside |= (i1(p) < 0) or (i1(p) >= ni1);
+            if (store_prev) {
+              i1_prev(p) += sh1;
+            }
+          }
+          if constexpr (D == Dim::_2D or D == Dim::_3D) {
+            i2(p)   += sh2;
+            outside |= (i2(p) < 0) or (i2(p) >= ni2);
+            if (store_prev) {
+              i2_prev(p) += sh2;
+            }
+          }
+          if constexpr (D == Dim::_3D) {
+            i3(p)   += sh3;
+            outside |= (i3(p) < 0) or (i3(p) >= ni3);
+            if (store_prev) {
+              i3_prev(p) += sh3;
+            }
+          }
+          if (outside) {
+            tag(p)  = ParticleTag::dead;
+            nd     += 1;
+          }
+        },
+        ndead);
 
-    if (npld_i() > 0) {
-      out::Read2DArray<npart_t>(io,
-                                reader,
-                                fmt::format("s%d_pld_i", index()),
-                                pld_i,
-                                npld_i(),
-                                npart(),
-                                npart_offset);
+      set_npart(npart() + nread);
+      if (ndead > 0) {
+        RemoveDead();
+      }
+      npart_offset += nread;
+      npart_count  -= nread;
     }
+    set_counter(npart());
+    set_unsorted();
   }
 
   template <Dimension D, Coord::type C>
   void Particles<D, C>::CheckpointWrite(adios2::IO&     io,
                                         adios2::Engine& writer,
+                                        npart_t         npart_total,
+                                        npart_t         npart_offset,
                                         std::size_t     domains_total,
                                         std::size_t     domains_offset) const {
     logger::Checkpoint(
       fmt::format("Writing particle checkpoint for species #%d", index()),
       HERE);
 
-    npart_t npart_offset = 0u;
-    npart_t npart_total  = npart();
-
-#if defined(MPI_ENABLED)
-    {
-      std::vector<npart_t> glob_nparts(domains_total);
-      MPI_Allgather(&m_npart,
-                    1,
-                    mpi::get_type<npart_t>(),
-                    glob_nparts.data(),
-                    1,
-                    mpi::get_type<npart_t>(),
-                    MPI_COMM_WORLD);
-      npart_total = 0u;
-      for (auto r = 0; r < domains_total; ++r) {
-        if (r < domains_offset) {
-          npart_offset += glob_nparts[r];
-        }
-        npart_total += glob_nparts[r];
-      }
-    }
-#endif
-
     out::WriteVariable<npart_t>(io,
                                 writer,
                                 fmt::format("s%d_npart", index()),
@@ -660,20 +680,22 @@ namespace ntt {
                                   npart(),
                                   npart_total,
                                   npart_offset);
-      out::Write1DArray<int>(io,
-                             writer,
-                             fmt::format("s%d_i1_prev", index()),
-                             i1_prev,
-                             npart(),
-                             npart_total,
-                             npart_offset);
-      out::Write1DArray<prtldx_t>(io,
-                                  writer,
-                                  fmt::format("s%d_dx1_prev", index()),
-                                  dx1_prev,
-                                  npart(),
-                                  npart_total,
-                                  npart_offset);
+      if (store_prev()) {
+        out::Write1DArray<int>(io,
+                               writer,
+                               fmt::format("s%d_i1_prev", index()),
+                               i1_prev,
+                               npart(),
+                               npart_total,
+                               npart_offset);
+        out::Write1DArray<prtldx_t>(io,
+                                    writer,
+                                    fmt::format("s%d_dx1_prev", index()),
+                                    dx1_prev,
+                                    npart(),
+                                    npart_total,
+                                    npart_offset);
+      }
     }
 
     if constexpr (D == Dim::_2D or D == Dim::_3D) {
@@ -691,20 +713,22 @@ namespace ntt {
                                   npart(),
                                   npart_total,
                                   npart_offset);
-      out::Write1DArray<int>(io,
-                             writer,
-                             fmt::format("s%d_i2_prev", index()),
-                             i2_prev,
-                             npart(),
-                             npart_total,
-                             npart_offset);
-      out::Write1DArray<prtldx_t>(io,
-                                  writer,
-                                  fmt::format("s%d_dx2_prev", index()),
-                                  dx2_prev,
-                                  npart(),
-                                  npart_total,
-                                  npart_offset);
+      if (store_prev()) {
+        out::Write1DArray<int>(io,
+                               writer,
+                               fmt::format("s%d_i2_prev", index()),
+                               i2_prev,
+                               npart(),
+                               npart_total,
+                               npart_offset);
+        out::Write1DArray<prtldx_t>(io,
+                                    writer,
+                                    fmt::format("s%d_dx2_prev", index()),
+                                    dx2_prev,
+                                    npart(),
+                                    npart_total,
+                                    npart_offset);
+      }
     }
 
     if constexpr (D == Dim::_3D) {
@@ -722,20 +746,22 @@ namespace ntt {
                                   npart(),
                                   npart_total,
                                   npart_offset);
-      out::Write1DArray<int>(io,
-                             writer,
-                             fmt::format("s%d_i3_prev", index()),
-                             i3_prev,
-                             npart(),
-                             npart_total,
-                             npart_offset);
-      out::Write1DArray<prtldx_t>(io,
-                                  writer,
-                                  fmt::format("s%d_dx3_prev", index()),
-                                  dx3_prev,
-                                  npart(),
-                                  npart_total,
-                                  npart_offset);
+      if (store_prev()) {
+        out::Write1DArray<int>(io,
+                               writer,
+                               fmt::format("s%d_i3_prev", index()),
+                               i3_prev,
+                               npart(),
+                               npart_total,
+                               npart_offset);
+        out::Write1DArray<prtldx_t>(io,
+                                    writer,
+                                    fmt::format("s%d_dx3_prev", index()),
+                                    dx3_prev,
+                                    npart(),
+                                    npart_total,
+                                    npart_offset);
+      }
     }
 
     if constexpr (D == Dim::_2D and C != Coord::Cart) {
@@ -807,7 +833,7 @@ namespace ntt {
   }
 
 #define PARTICLES_OUTPUT_DECLARE(D, C)                                         \
-  template void Particles<D, C>::OutputDeclare(adios2::IO&) const;
+  template void Particles<D, C>::OutputDeclare(adios2::IO&, bool) const;
 
   PARTICLES_OUTPUT_DECLARE(Dim::_1D, Coord::Cart)
   PARTICLES_OUTPUT_DECLARE(Dim::_2D, Coord::Cart)
@@ -817,12 +843,18 @@ namespace ntt {
 #undef PARTICLES_OUTPUT_DECLARE
 
 #define PARTICLES_OUTPUT_WRITE(S, M, D)                                         \
+  template auto Particles<M<D>::Dim, M<D>::CoordType>::OutputSelect<S, M<D>>(  \
+    const kernel::PrtlSelection&,                                              \
+    const M<D>&) -> std::pair<array_t<npart_t*>, npart_t>;                     \
   template void Particles<M<D>::Dim, M<D>::CoordType>::OutputWrite<S, M<D>>(   \
     adios2::IO&,                                                               \
     adios2::Engine&,                                                           \
+    const kernel::PrtlSelection&,                                              \
+    const array_t<npart_t*>&,                                                  \
+    npart_t,                                                                   \
+    bool,                                                                      \
+    npart_t,                                                                   \
     npart_t,                                                                   \
-    std::size_t,                                                               \
-    std::size_t,                                                               \
     const M<D>&);
 
   NTT_FOREACH_SPECIALIZATION(PARTICLES_OUTPUT_WRITE)
@@ -830,12 +862,17 @@ namespace ntt {
 
 #define PARTICLES_CHECKPOINTS(D, C)                                            \
   template void Particles<D, C>::CheckpointDeclare(adios2::IO&) const;         \
-  template void Particles<D, C>::CheckpointRead(adios2::IO&,                   \
-                                                adios2::Engine&,               \
-                                                std::size_t,                   \
-                                                std::size_t);                  \
+  template void Particles<D, C>::CheckpointRead(                               \
+    adios2::IO&,                                                               \
+    adios2::Engine&,                                                           \
+    npart_t,                                                                   \
+    npart_t,                                                                   \
+    const std::vector<int>&,                                                   \
+    const std::vector<ncells_t>&);                                             \
   template void Particles<D, C>::CheckpointWrite(adios2::IO&,                  \
                                                  adios2::Engine&,              \
+                                                 npart_t,                      \
+                                                 npart_t,                      \
                                                  std::size_t,                  \
                                                  std::size_t) const;
 
@@ -12,6 +12,9 @@
 #define FRAMEWORK_CONTAINERS_SPECIES_H
 
 #include "enums.h"
+#include "global.h"
+
+#include "utils/error.h"
 
 #include <string>
 
@@ -46,6 +49,12 @@ namespace ntt {
     const unsigned short m_npld_r;
     const unsigned short m_npld_i;
 
+    // Store the previous-timestep coordinates in dedicated arrays
+    const bool m_store_prev;
+
+    // Number of timesteps per push of the species
+    const unsigned short m_subcycle;
+
   public:
     ParticleSpecies()
       : m_index { 0u }
@@ -58,7 +67,9 @@ namespace ntt {
       , m_use_gca { false }
       , m_cooling { Cooling::INVALID }
       , m_npld_r { 0 }
-      , m_npld_i { 0 } {}
+      , m_npld_i { 0 }
+      , m_store_prev { true }
+      , m_subcycle { 1 } {}
 
     /**
      * @brief Constructor for the particle species container.
@@ -74,6 +85,10 @@ namespace ntt {
      * @param cooling The cooling mechanism assigned for the species.
      * @param npld_r The number of real-valued payloads for the species
      * @param npld_i The number of integer-valued payloads for the species
+     * @param store_prev Allocate arrays for the previous-timestep coordinates
+     * @param subcycle Push the species once every `subcycle` timesteps
+     * @note with `store_prev = false` the coordinates at the beginning of the
+     * timestep are only kept in registers (push & deposit are fused)
      */
     ParticleSpecies(spidx_t            index,
                     const std::string& label,
@@ -85,7 +100,9 @@ namespace ntt {
                     bool               use_gca,
                     const Cooling&     cooling,
                     unsigned short     npld_r = 0,
-                    unsigned short     npld_i = 0)
+                    unsigned short     npld_i     = 0,
+                    bool               store_prev = true,
+                    unsigned short     subcycle   = 1)
       : m_index { index }
       , m_label { std::move(label) }
       , m_mass { m }
@@ -96,7 +113,9 @@ namespace ntt {
       , m_use_gca { use_gca }
       , m_cooling { cooling }
       , m_npld_r { npld_r }
-      , m_npld_i { npld_i } {
+      , m_npld_i { npld_i }
+      , m_store_prev { store_prev }
+      , m_subcycle { subcycle } {
       if (use_tracking) {
 #if !defined(MPI_ENABLED)
         raise::ErrorIf(m_npld_i < 1,
@@ -172,6 +191,27 @@ namespace ntt {
     auto npld_i() const -> unsigned short {
       return m_npld_i;
     }
+
+    [[nodiscard]]
+    auto store_prev() const -> bool {
+      return m_store_prev;
+    }
+
+    [[nodiscard]]
+    auto subcycle() const -> unsigned short {
+      return m_subcycle;
+    }
+
+    /**
+     * @brief Whether the species is pushed (& its current deposited) at a step
+     * @note A species sub-cycled over `N` steps is pushed on the last step of
+     * each cycle (i.e., once the fields are averaged over the whole cycle)
+     */
+    [[nodiscard]]
+    auto pushed_at(timestep_t step) const -> bool {
+      const auto nsub = static_cast<timestep_t>(m_subcycle);
+      return (step % nsub) == (nsub - 1);
+    }
   };
 } // namespace ntt
 
@@ -3,6 +3,7 @@
 #include "enums.h"
 #include "global.h"
 
+#include "arch/mpi_aliases.h"
 #include "utils/error.h"
 #include "utils/formatting.h"
 #include "utils/log.h"
@@ -18,28 +19,31 @@
 #include "framework/specialization_registry.h"
 #include "framework/parameters.h"
 
+#include <string>
+#include <vector>
+
 namespace ntt {
 
   template <SimEngine::type S, class M>
   void Metadomain<S, M>::InitCheckpointWriter(adios2::ADIOS*          ptr_adios,
                                               const SimulationParams& params) {
     raise::ErrorIf(ptr_adios == nullptr, "adios == nullptr", HERE);
-    raise::ErrorIf(
-      l_subdomain_indices().size() != 1,
-      "Checkpoint writing for now is only supported for one subdomain per rank",
-      HERE);
+    raise::ErrorIf(l_subdomain_indices().empty(),
+                   "no local subdomains to checkpoint",
+                   HERE);
+    // variables are declared with the layout of the first local domain, the
+    // selection is then reset for each local domain when writing
     auto local_domain = subdomain_ptr(l_subdomain_indices()[0]);
     raise::ErrorIf(local_domain->is_placeholder(),
                    "local_domain is a placeholder",
                    HERE);
 
+    // fields are stored as one array of the whole grid (with the ghost cells
+    // along its outer edges only), independent of the domain decomposition
     std::vector<ncells_t> glob_shape_with_ghosts, off_ncells_with_ghosts;
     for (auto d { 0u }; d < M::Dim; ++d) {
-      off_ncells_with_ghosts.push_back(
-        local_domain->offset_ncells()[d] +
-        2 * N_GHOSTS * local_domain->offset_ndomains()[d]);
-      glob_shape_with_ghosts.push_back(
-        mesh().n_active()[d] + 2 * N_GHOSTS * ndomains_per_dim()[d]);
+      off_ncells_with_ghosts.push_back(local_domain->offset_ncells()[d]);
+      glob_shape_with_ghosts.push_back(mesh().n_active()[d] + 2 * N_GHOSTS);
     }
     auto loc_shape_with_ghosts = local_domain->mesh.n_all();
 
@@ -59,6 +63,15 @@ namespace ntt {
       params.template get<simtime_t>("checkpoint.interval_time"),
       params.template get<int>("checkpoint.keep"),
       params.template get<std::string>("checkpoint.walltime"));
+    const auto local_root = params.template get<std::string>(
+      "checkpoint.local.path");
+    if (not local_root.empty()) {
+      g_checkpoint_writer.initStaging(
+        local_root,
+        params.template get<timestep_t>("checkpoint.local.interval"),
+        params.template get<simtime_t>("checkpoint.local.interval_time"),
+        params.template get<int>("checkpoint.local.keep"));
+    }
     if (g_checkpoint_writer.enabled()) {
       local_domain->fields.CheckpointDeclare(g_checkpoint_writer.io(),
                                              loc_shape_with_ghosts,
@@ -67,6 +80,23 @@ namespace ntt {
       for (const auto& species : local_domain->species) {
         species.CheckpointDeclare(g_checkpoint_writer.io());
       }
+      // # of cells of the domains along each dimension (can change at runtime)
+      for (auto d { 0u }; d < M::Dim; ++d) {
+        const std::size_t ndoms = ndomains_per_dim()[d];
+        g_checkpoint_writer.io().template DefineVariable<ncells_t>(
+          fmt::format("domain_ncells_x%d", d + 1),
+          { ndoms },
+          { 0 },
+          { ndoms });
+      }
+      // offset & # of cells of each domain (to redistribute the particles)
+      for (const auto& name : { "domain_offsets", "domain_ncells" }) {
+        g_checkpoint_writer.io().template DefineVariable<ncells_t>(
+          name,
+          { ndomains(), M::Dim },
+          { 0, 0 },
+          { ndomains(), M::Dim });
+      }
     }
   }
 
@@ -76,39 +106,94 @@ namespace ntt {
                                          timestep_t              finished_step,
                                          simtime_t               current_time,
                                          simtime_t finished_time) -> bool {
-    raise::ErrorIf(
-      l_subdomain_indices().size() != 1,
-      "Checkpointing for now is only supported for one subdomain per rank",
-      HERE);
     if (not g_checkpoint_writer.shouldSave(finished_step, finished_time) or
         finished_step <= 1) {
       return false;
     }
-    auto local_domain = subdomain_ptr(l_subdomain_indices()[0]);
-    raise::ErrorIf(local_domain->is_placeholder(),
-                   "local_domain is a placeholder",
-                   HERE);
+    const auto local_domains = localDomains();
+    for (const auto* local_domain : local_domains) {
+      raise::ErrorIf(local_domain->is_placeholder(),
+                     "local_domain is a placeholder",
+                     HERE);
+    }
     logger::Checkpoint("Writing checkpoint", HERE);
     g_checkpoint_writer.beginSaving(current_step, current_time);
     {
-      if (g_checkpoint_writer.written().empty()) {
+      if (g_checkpoint_writer.current().second.empty()) {
         raise::Fatal("No checkpoint file to save metadata", HERE);
       }
-      params.saveTOML(g_checkpoint_writer.written().back().second, current_time);
+      params.saveTOML(g_checkpoint_writer.current().second, current_time);
 
-      local_domain->fields.CheckpointWrite(g_checkpoint_writer.io(),
-                                           g_checkpoint_writer.writer());
-#if !defined(MPI_ENABLED)
-      const std::size_t dom_tot = 1, dom_offset = 0;
-#else
-      const std::size_t dom_tot = g_mpi_size, dom_offset = g_mpi_rank;
-#endif // MPI_ENABLED
+      const auto layout = ncells_per_dim();
+      std::vector<ncells_t> domain_offsets, domain_ncells;
+      for (const auto& domain : g_subdomains) {
+        for (auto d { 0u }; d < M::Dim; ++d) {
+          domain_offsets.push_back(domain.offset_ncells()[d]);
+          domain_ncells.push_back(domain.mesh.n_active()[d]);
+        }
+      }
+      CallOnce(
+        [](auto&       writer,
+           const auto& layout,
+           const auto& domain_offsets,
+           const auto& domain_ncells) {
+          for (auto d { 0u }; d < layout.size(); ++d) {
+            writer.writer().Put(writer.io().template InquireVariable<ncells_t>(
+                                  fmt::format("domain_ncells_x%d", d + 1)),
+                                layout[d].data(),
+                                adios2::Mode::Sync);
+          }
+          writer.writer().Put(
+            writer.io().template InquireVariable<ncells_t>("domain_offsets"),
+            domain_offsets.data(),
+            adios2::Mode::Sync);
+          writer.writer().Put(
+            writer.io().template InquireVariable<ncells_t>("domain_ncells"),
+            domain_ncells.data(),
+            adios2::Mode::Sync);
+        },
+        g_checkpoint_writer,
+        layout,
+        domain_offsets,
+        domain_ncells);
 
-      for (const auto& species : local_domain->species) {
-        species.CheckpointWrite(g_checkpoint_writer.io(),
-                                g_checkpoint_writer.writer(),
-                                dom_tot,
-                                dom_offset);
+      for (const auto* local_domain : local_domains) {
+        // each domain writes its active cells, together with the ghost cells
+        // which lie beyond the edges of the global grid
+        adios2::Box<adios2::Dims>  range;
+        std::vector<range_tuple_t> slice;
+        for (auto d { 0u }; d < M::Dim; ++d) {
+          const auto at_min = local_domain->offset_ndomains()[d] == 0;
+          const auto at_max = local_domain->offset_ndomains()[d] ==
+                              ndomains_per_dim()[d] - 1;
+          const ncells_t i_min = at_min ? 0 : N_GHOSTS;
+          const ncells_t i_max = local_domain->mesh.n_active()[d] + N_GHOSTS +
+                                 (at_max ? N_GHOSTS : 0);
+          range.first.push_back(local_domain->offset_ncells()[d] + i_min);
+          range.second.push_back(i_max - i_min);
+          slice.emplace_back(i_min, i_max);
+        }
+        local_domain->fields.CheckpointWrite(g_checkpoint_writer.io(),
+                                             g_checkpoint_writer.writer(),
+                                             range,
+                                             slice);
+      }
+
+      for (auto s { 0u }; s < local_domains[0]->species.size(); ++s) {
+        std::vector<npart_t> npart_local;
+        for (const auto* local_domain : local_domains) {
+          npart_local.push_back(local_domain->species[s].npart());
+        }
+        const auto [npart_offsets, npart_total] = gatherDomainOffsets(npart_local);
+        for (auto i { 0u }; i < local_domains.size(); ++i) {
+          local_domains[i]->species[s].CheckpointWrite(
+            g_checkpoint_writer.io(),
+            g_checkpoint_writer.writer(),
+            npart_total,
+            npart_offsets[i],
+            ndomains(),
+            local_domains[i]->index());
+        }
       }
     }
     g_checkpoint_writer.endSaving();
@@ -139,19 +224,122 @@ namespace ntt {
 #endif
 
     reader.BeginStep();
+    // checkpoints which store the domain boxes can be read with any domain
+    // decomposition, older ones only with the one they were written with
+    const auto elastic = static_cast<bool>(
+      io.InquireVariable<ncells_t>("domain_offsets"));
+    {
+      // restore the domain layout (if the domains were rebalanced)
+      auto       layout    = ncells_per_dim();
+      const auto current   = layout;
+      auto       same_ndom = true;
+      for (auto d { 0u }; d < M::Dim; ++d) {
+        auto var = io.InquireVariable<ncells_t>(
+          fmt::format("domain_ncells_x%d", d + 1));
+        if (not var) {
+          continue;
+        }
+        if (var.Shape()[0] != layout[d].size()) {
+          same_ndom = false;
+          continue;
+        }
+        var.SetSelection(adios2::Box<adios2::Dims>({ 0 }, { layout[d].size() }));
+        reader.Get(var, layout[d].data(), adios2::Mode::Sync);
+      }
+      raise::ErrorIf(not(same_ndom or elastic),
+                     "Checkpoint has a different # of domains",
+                     HERE);
+      if (not same_ndom) {
+        logger::Checkpoint(
+          "Checkpoint has a different domain decomposition, redistributing",
+          HERE);
+      } else if (layout != current) {
+        logger::Checkpoint("Restoring the domain layout from the checkpoint", HERE);
+        setLayout(layout, true);
+        resetOutputMeshBlocks();
+      }
+    }
+
+    // offset & # of cells of each of the domains in the checkpoint
+    std::vector<std::vector<ncells_t>> ckpt_offsets, ckpt_ncells;
+    if (elastic) {
+      auto var_offsets = io.InquireVariable<ncells_t>("domain_offsets");
+      auto var_ncells  = io.InquireVariable<ncells_t>("domain_ncells");
+      raise::ErrorIf(not var_ncells or (var_offsets.Shape()[1] != M::Dim),
+                     "Invalid domain boxes in the checkpoint",
+                     HERE);
+      const std::size_t ndoms = var_offsets.Shape()[0];
+      auto offsets = std::vector<ncells_t>(ndoms * M::Dim);
+      auto ncells  = std::vector<ncells_t>(ndoms * M::Dim);
+      const auto box = adios2::Box<adios2::Dims>({ 0, 0 }, { ndoms, M::Dim });
+      var_offsets.SetSelection(box);
+      var_ncells.SetSelection(box);
+      reader.Get(var_offsets, offsets.data(), adios2::Mode::Sync);
+      reader.Get(var_ncells, ncells.data(), adios2::Mode::Sync);
+      for (auto idx { 0u }; idx < ndoms; ++idx) {
+        ckpt_offsets.emplace_back(offsets.begin() + idx * M::Dim,
+                                  offsets.begin() + (idx + 1) * M::Dim);
+        ckpt_ncells.emplace_back(ncells.begin() + idx * M::Dim,
+                                 ncells.begin() + (idx + 1) * M::Dim);
+      }
+    } else {
+      for (const auto& domain : g_subdomains) {
+        ckpt_offsets.push_back(domain.offset_ncells());
+        ckpt_ncells.push_back(domain.mesh.n_active());
+      }
+    }
+
+    // # of particles written by each of the domains in the checkpoint
+    std::vector<std::vector<npart_t>> ckpt_npart;
+    for (const auto& species : g_species_params) {
+      auto var = io.InquireVariable<npart_t>(
+        fmt::format("s%d_npart", species.index()));
+      raise::ErrorIf(not var or (var.Shape()[0] != ckpt_offsets.size()),
+                     "Invalid # of particles in the checkpoint",
+                     HERE);
+      auto npart = std::vector<npart_t>(ckpt_offsets.size());
+      var.SetSelection(adios2::Box<adios2::Dims>({ 0 }, { npart.size() }));
+      reader.Get(var, npart.data(), adios2::Mode::Sync);
+      ckpt_npart.push_back(npart);
+    }
+
     for (const auto local_domain_idx : l_subdomain_indices()) {
       auto local_domain = subdomain_ptr(local_domain_idx);
 
       adios2::Box<adios2::Dims> range;
       for (auto d { 0u }; d < M::Dim; ++d) {
-        range.first.push_back(local_domain->offset_ncells()[d] +
-                              2 * N_GHOSTS * local_domain->offset_ndomains()[d]);
+        range.first.push_back(
+          local_domain->offset_ncells()[d] +
+          (elastic ? 0 : 2 * N_GHOSTS * local_domain->offset_ndomains()[d]));
         range.second.push_back(local_domain->mesh.n_all()[d]);
       }
       local_domain->fields.CheckpointRead(io, reader, range);
 
-      for (auto& species : local_domain->species) {
-        species.CheckpointRead(io, reader, ndomains(), local_domain_idx);
+      // particles are read from all the domains of the checkpoint which
+      // overlap with this one, and only those within it are kept
+      const auto offset = local_domain->offset_ncells();
+      const auto ncells = local_domain->mesh.n_active();
+      for (auto s { 0u }; s < local_domain->species.size(); ++s) {
+        npart_t npart_offset = 0;
+        for (auto idx { 0u }; idx < ckpt_offsets.size(); ++idx) {
+          auto             overlaps = true;
+          std::vector<int> shift;
+          for (auto d { 0u }; d < M::Dim; ++d) {
+            overlaps &= (ckpt_offsets[idx][d] < offset[d] + ncells[d]) and
+                        (offset[d] < ckpt_offsets[idx][d] + ckpt_ncells[idx][d]);
+            shift.push_back(static_cast<int>(ckpt_offsets[idx][d]) -
+                            static_cast<int>(offset[d]));
+          }
+          if (overlaps and ckpt_npart[s][idx] > 0) {
+            local_domain->species[s].CheckpointRead(io,
+                                                    reader,
+                                                    npart_offset,
+                                                    ckpt_npart[s][idx],
+                                                    shift,
+                                                    ncells);
+          }
+          npart_offset += ckpt_npart[s][idx];
+        }
       }
 
     } // local subdomain loop
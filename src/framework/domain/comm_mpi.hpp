@@ -3,6 +3,9 @@
  * @brief MPI communication routines
  * @implements
  *   - comm::CommunicateField<> -> void
+ *   - comm::BeginCommunicateField<> -> void
+ *   - comm::EndCommunicateField<> -> void
+ *   - comm::CommunicateLocalField<> -> void
  * @namespaces:
  *   - comm::
  * @note This should only be included if the MPI_ENABLED flag is set
@@ -17,6 +20,8 @@
 #include "arch/mpi_aliases.h"
 #include "utils/error.h"
 
+#include "framework/containers/comm_buffers.h"
+
 #include <Kokkos_Core.hpp>
 #include <mpi.h>
 
@@ -26,20 +31,19 @@ namespace comm {
   using namespace ntt;
 
   namespace flds {
-    template <unsigned short D>
-    void send_recv(ndarray_t<D>& send_arr,
-                   ndarray_t<D>& recv_arr,
-                   int           send_rank,
-                   int           recv_rank,
-                   ncells_t      nsend,
-                   ncells_t      nrecv) {
+    inline void send_recv(const CommBuffer& send_buff,
+                          const CommBuffer& recv_buff,
+                          int               send_rank,
+                          int               recv_rank,
+                          ncells_t          nsend,
+                          ncells_t          nrecv) {
 #if !defined(DEVICE_ENABLED) || defined(GPU_AWARE_MPI)
-      MPI_Sendrecv(send_arr.data(),
+      MPI_Sendrecv(send_buff.data.data(),
                    nsend,
                    mpi::get_type<real_t>(),
                    send_rank,
                    0,
-                   recv_arr.data(),
+                   recv_buff.data.data(),
                    nrecv,
                    mpi::get_type<real_t>(),
                    recv_rank,
@@ -47,33 +51,34 @@ namespace comm {
                    MPI_COMM_WORLD,
                    MPI_STATUS_IGNORE);
 #else
-      auto send_arr_h = Kokkos::create_mirror_view(send_arr);
-      auto recv_arr_h = Kokkos::create_mirror_view(recv_arr);
-      Kokkos::deep_copy(send_arr_h, send_arr);
-      MPI_Sendrecv(send_arr_h.data(),
+      Kokkos::deep_copy(send_buff.host, send_buff.data);
+      MPI_Sendrecv(send_buff.host.data(),
                    nsend,
                    mpi::get_type<real_t>(),
                    send_rank,
                    0,
-                   recv_arr_h.data(),
+                   recv_buff.host.data(),
                    nrecv,
                    mpi::get_type<real_t>(),
                    recv_rank,
                    0,
                    MPI_COMM_WORLD,
                    MPI_STATUS_IGNORE);
-      Kokkos::deep_copy(recv_arr, recv_arr_h);
+      Kokkos::deep_copy(recv_buff.data, recv_buff.host);
 #endif
     }
 
-    template <unsigned short D>
-    void send(ndarray_t<D>& send_arr, int send_rank, ncells_t nsend) {
+    inline void send(const CommBuffer& send_buff, int send_rank, ncells_t nsend) {
 #if !defined(DEVICE_ENABLED) || defined(GPU_AWARE_MPI)
-      MPI_Send(send_arr.data(), nsend, mpi::get_type<real_t>(), send_rank, 0, MPI_COMM_WORLD);
+      MPI_Send(send_buff.data.data(),
+               nsend,
+               mpi::get_type<real_t>(),
+               send_rank,
+               0,
+               MPI_COMM_WORLD);
 #else
-      auto send_arr_h = Kokkos::create_mirror_view(send_arr);
-      Kokkos::deep_copy(send_arr_h, send_arr);
-      MPI_Send(send_arr_h.data(),
+      Kokkos::deep_copy(send_buff.host, send_buff.data);
+      MPI_Send(send_buff.host.data(),
                nsend,
                mpi::get_type<real_t>(),
                send_rank,
@@ -82,10 +87,9 @@ namespace comm {
 #endif
     }
 
-    template <unsigned short D>
-    void recv(ndarray_t<D>& recv_arr, int recv_rank, ncells_t nrecv) {
+    inline void recv(const CommBuffer& recv_buff, int recv_rank, ncells_t nrecv) {
 #if !defined(DEVICE_ENABLED) || defined(GPU_AWARE_MPI)
-      MPI_Recv(recv_arr.data(),
+      MPI_Recv(recv_buff.data.data(),
                nrecv,
                mpi::get_type<real_t>(),
                recv_rank,
@@ -93,31 +97,118 @@ namespace comm {
                MPI_COMM_WORLD,
                MPI_STATUS_IGNORE);
 #else
-      auto recv_arr_h = Kokkos::create_mirror_view(recv_arr);
-      MPI_Recv(recv_arr_h.data(),
+      MPI_Recv(recv_buff.host.data(),
                nrecv,
                mpi::get_type<real_t>(),
                recv_rank,
                0,
                MPI_COMM_WORLD,
                MPI_STATUS_IGNORE);
-      Kokkos::deep_copy(recv_arr, recv_arr_h);
+      Kokkos::deep_copy(recv_buff.data, recv_buff.host);
 #endif
     }
 
-    template <unsigned short D>
-    void communicate(ndarray_t<D>& send_arr,
-                     ndarray_t<D>& recv_arr,
-                     int           send_rank,
-                     int           recv_rank,
-                     ncells_t      nsend,
-                     ncells_t      nrecv) {
+    inline void communicate(const CommBuffer& send_buff,
+                            const CommBuffer& recv_buff,
+                            int               send_rank,
+                            int               recv_rank,
+                            ncells_t          nsend,
+                            ncells_t          nrecv) {
       if (send_rank >= 0 and recv_rank >= 0 and nsend > 0 and nrecv > 0) {
-        send_recv<D>(send_arr, recv_arr, send_rank, recv_rank, nsend, nrecv);
+        send_recv(send_buff, recv_buff, send_rank, recv_rank, nsend, nrecv);
       } else if (send_rank >= 0 and nsend > 0) {
-        send<D>(send_arr, send_rank, nsend);
+        send(send_buff, send_rank, nsend);
       } else if (recv_rank >= 0 and nrecv > 0) {
-        recv<D>(recv_arr, recv_rank, nrecv);
+        recv(recv_buff, recv_rank, nrecv);
+      }
+    }
+
+    /**
+     * @brief Unmanaged view with the shape of a field slice over a raw buffer
+     */
+    template <Dimension D>
+    auto slice_view(const CommBuffer&                 buff,
+                    const std::vector<range_tuple_t>& slice,
+                    const range_tuple_t& comps) -> ndarray_t<static_cast<dim_t>(D) + 1> {
+      auto data = reinterpret_cast<real_t*>(buff.data.data());
+      if constexpr (D == Dim::_1D) {
+        return ndarray_t<2>(data,
+                            slice[0].second - slice[0].first,
+                            comps.second - comps.first);
+      } else if constexpr (D == Dim::_2D) {
+        return ndarray_t<3>(data,
+                            slice[0].second - slice[0].first,
+                            slice[1].second - slice[1].first,
+                            comps.second - comps.first);
+      } else if constexpr (D == Dim::_3D) {
+        return ndarray_t<4>(data,
+                            slice[0].second - slice[0].first,
+                            slice[1].second - slice[1].first,
+                            slice[2].second - slice[2].first,
+                            comps.second - comps.first);
+      }
+    }
+
+
+    /**
+     * @brief Copy (or add) `src` into the `slice` of `fld`
+     * @note `src` has the shape of the slice (i.e., it is indexed from zero)
+     */
+    template <Dimension D, int N, class V>
+    void fill(ndfield_t<D, N>&                  fld,
+              const std::vector<range_tuple_t>& slice,
+              const range_tuple_t&              comps,
+              const V&                          src,
+              bool                              additive) {
+      if (not additive) {
+        if constexpr (D == Dim::_1D) {
+          Kokkos::deep_copy(Kokkos::subview(fld, slice[0], comps), src);
+        } else if constexpr (D == Dim::_2D) {
+          Kokkos::deep_copy(Kokkos::subview(fld, slice[0], slice[1], comps), src);
+        } else if constexpr (D == Dim::_3D) {
+          Kokkos::deep_copy(
+            Kokkos::subview(fld, slice[0], slice[1], slice[2], comps),
+            src);
+        }
+        return;
+      }
+      const auto offset_c = comps.first;
+      if constexpr (D == Dim::_1D) {
+        const auto offset_x1 = slice[0].first;
+        Kokkos::parallel_for(
+          "CommunicateField-extract",
+          Kokkos::MDRangePolicy<Kokkos::Rank<2>, Kokkos::DefaultExecutionSpace>(
+            { slice[0].first, comps.first },
+            { slice[0].second, comps.second }),
+          Lambda(index_t i1, index_t ci) {
+            fld(i1, ci) += src(i1 - offset_x1, ci - offset_c);
+          });
+      } else if constexpr (D == Dim::_2D) {
+        const auto offset_x1 = slice[0].first;
+        const auto offset_x2 = slice[1].first;
+        Kokkos::parallel_for(
+          "CommunicateField-extract",
+          Kokkos::MDRangePolicy<Kokkos::Rank<3>, Kokkos::DefaultExecutionSpace>(
+            { slice[0].first, slice[1].first, comps.first },
+            { slice[0].second, slice[1].second, comps.second }),
+          Lambda(index_t i1, index_t i2, index_t ci) {
+            fld(i1, i2, ci) += src(i1 - offset_x1, i2 - offset_x2, ci - offset_c);
+          });
+      } else if constexpr (D == Dim::_3D) {
+        const auto offset_x1 = slice[0].first;
+        const auto offset_x2 = slice[1].first;
+        const auto offset_x3 = slice[2].first;
+        Kokkos::parallel_for(
+          "CommunicateField-extract",
+          Kokkos::MDRangePolicy<Kokkos::Rank<4>, Kokkos::DefaultExecutionSpace>(
+            { slice[0].first, slice[1].first, slice[2].first, comps.first },
+            { slice[0].second, slice[1].second, slice[2].second, comps.second }),
+          Lambda(index_t i1, index_t i2, index_t i3, index_t ci) {
+            fld(i1, i2, i3, ci) += src(i1 - offset_x1,
+                                       i2 - offset_x2,
+                                       i3 - offset_x3,
+                                       ci - offset_c);
+          });
       }
     }
 
@@ -134,7 +225,9 @@ namespace comm {
                                const std::vector<range_tuple_t>& send_slice,
                                const std::vector<range_tuple_t>& recv_slice,
                                const range_tuple_t&              comps,
-                               bool                              additive) {
+                               bool                              additive,
+                               CommBufferPool&                   pool,
+                               const CommBufferPool::key_t&      key) {
     raise::ErrorIf(send_rank < 0 && recv_rank < 0,
                    "CommunicateField called with negative ranks",
                    HERE);
@@ -222,6 +315,7 @@ namespace comm {
       ncells_t nsend { comps.second - comps.first },
         nrecv { comps.second - comps.first };
       ndarray_t<static_cast<dim_t>(D) + 1> send_fld, recv_fld;
+      CommBuffer                           send_buff, recv_buff;
 
       for (short d { 0 }; d < (short)D; ++d) {
         if (send_rank >= 0) {
@@ -231,56 +325,28 @@ namespace comm {
           nrecv *= (recv_slice[d].second - recv_slice[d].first);
         }
       }
+      // send/recv arrays are unmanaged views into the persistent buffers
       if (send_rank >= 0) {
+        send_buff = pool.send(key, nsend * sizeof(real_t));
+        send_fld  = flds::slice_view<D>(send_buff, send_slice, comps);
         if constexpr (D == Dim::_1D) {
-          send_fld = ndarray_t<2>("send_fld",
-                                  send_slice[0].second - send_slice[0].first,
-                                  comps.second - comps.first);
           Kokkos::deep_copy(send_fld, Kokkos::subview(fld, send_slice[0], comps));
         } else if constexpr (D == Dim::_2D) {
-          send_fld = ndarray_t<3>("send_fld",
-                                  send_slice[0].second - send_slice[0].first,
-                                  send_slice[1].second - send_slice[1].first,
-                                  comps.second - comps.first);
           Kokkos::deep_copy(
             send_fld,
             Kokkos::subview(fld, send_slice[0], send_slice[1], comps));
         } else if constexpr (D == Dim::_3D) {
-          send_fld = ndarray_t<4>("send_fld",
-                                  send_slice[0].second - send_slice[0].first,
-                                  send_slice[1].second - send_slice[1].first,
-                                  send_slice[2].second - send_slice[2].first,
-                                  comps.second - comps.first);
           Kokkos::deep_copy(
             send_fld,
             Kokkos::subview(fld, send_slice[0], send_slice[1], send_slice[2], comps));
         }
       }
       if (recv_rank >= 0) {
-        if constexpr (D == Dim::_1D) {
-          recv_fld = ndarray_t<2>("recv_fld",
-                                  recv_slice[0].second - recv_slice[0].first,
-                                  comps.second - comps.first);
-        } else if constexpr (D == Dim::_2D) {
-          recv_fld = ndarray_t<3>("recv_fld",
-                                  recv_slice[0].second - recv_slice[0].first,
-                                  recv_slice[1].second - recv_slice[1].first,
-                                  comps.second - comps.first);
-        } else if constexpr (D == Dim::_3D) {
-          recv_fld = ndarray_t<4>("recv_fld",
-                                  recv_slice[0].second - recv_slice[0].first,
-                                  recv_slice[1].second - recv_slice[1].first,
-                                  recv_slice[2].second - recv_slice[2].first,
-                                  comps.second - comps.first);
-        }
+        recv_buff = pool.recv(key, nrecv * sizeof(real_t));
+        recv_fld  = flds::slice_view<D>(recv_buff, recv_slice, comps);
       }
 
-      flds::communicate<static_cast<unsigned short>(D) + 1>(send_fld,
-                                                            recv_fld,
-                                                            send_rank,
-                                                            recv_rank,
-                                                            nsend,
-                                                            nrecv);
+      flds::communicate(send_buff, recv_buff, send_rank, recv_rank, nsend, nrecv);
 
       if (recv_rank >= 0) {
 
@@ -350,6 +416,187 @@ namespace comm {
     }
   }
 
+  /**
+   * @brief Start the exchange of the ghost cells of `fld` without waiting for
+   * the messages to arrive (the exchange is completed with
+   * `EndCommunicateField`)
+   * @note Send `fld`, recv to `fld_buff` (which may be the same as `fld`)
+   * @note Exchanges with other domains of the same rank are not posted: the
+   * data is copied directly with `CommunicateLocalField` by the receiver
+   * @note Posted requests are appended to `requests`
+   */
+  template <Dimension D, int N>
+  inline void BeginCommunicateField(unsigned int                      idx,
+                                    ndfield_t<D, N>&                  fld,
+                                    ndfield_t<D, N>&                  fld_buff,
+                                    unsigned int                      send_idx,
+                                    unsigned int                      recv_idx,
+                                    int                               send_rank,
+                                    int                               recv_rank,
+                                    const std::vector<range_tuple_t>& send_slice,
+                                    const std::vector<range_tuple_t>& recv_slice,
+                                    const range_tuple_t&              comps,
+                                    bool                              additive,
+                                    CommBufferPool&                   pool,
+                                    const CommBufferPool::key_t&      key,
+                                    int                               send_tag,
+                                    int                               recv_tag,
+                                    std::vector<MPI_Request>&         requests) {
+    raise::ErrorIf(send_rank < 0 && recv_rank < 0,
+                   "BeginCommunicateField called with negative ranks",
+                   HERE);
+    if ((send_idx == idx) and (recv_idx == idx)) {
+      // data is already local: nothing to wait for
+      CommunicateField<D, N>(idx,
+                             fld,
+                             fld_buff,
+                             send_idx,
+                             recv_idx,
+                             send_rank,
+                             recv_rank,
+                             send_slice,
+                             recv_slice,
+                             comps,
+                             additive,
+                             pool,
+                             key);
+      return;
+    }
+    int rank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+    if ((send_rank >= 0) and (send_rank != rank)) {
+      ncells_t nsend { comps.second - comps.first };
+      for (short d { 0 }; d < (short)D; ++d) {
+        nsend *= (send_slice[d].second - send_slice[d].first);
+      }
+      const auto send_buff = pool.send(key, nsend * sizeof(real_t));
+      auto send_fld = flds::slice_view<D>(send_buff, send_slice, comps);
+      if constexpr (D == Dim::_1D) {
+        Kokkos::deep_copy(send_fld, Kokkos::subview(fld, send_slice[0], comps));
+      } else if constexpr (D == Dim::_2D) {
+        Kokkos::deep_copy(send_fld,
+                          Kokkos::subview(fld, send_slice[0], send_slice[1], comps));
+      } else if constexpr (D == Dim::_3D) {
+        Kokkos::deep_copy(
+          send_fld,
+          Kokkos::subview(fld, send_slice[0], send_slice[1], send_slice[2], comps));
+      }
+      requests.emplace_back();
+#if !defined(DEVICE_ENABLED) || defined(GPU_AWARE_MPI)
+      MPI_Isend(send_buff.data.data(),
+                nsend,
+                mpi::get_type<real_t>(),
+                send_rank,
+                send_tag,
+                MPI_COMM_WORLD,
+                &requests.back());
+#else
+      Kokkos::deep_copy(send_buff.host, send_buff.data);
+      MPI_Isend(send_buff.host.data(),
+                nsend,
+                mpi::get_type<real_t>(),
+                send_rank,
+                send_tag,
+                MPI_COMM_WORLD,
+                &requests.back());
+#endif
+    }
+    if ((recv_rank >= 0) and (recv_rank != rank)) {
+      ncells_t nrecv { comps.second - comps.first };
+      for (short d { 0 }; d < (short)D; ++d) {
+        nrecv *= (recv_slice[d].second - recv_slice[d].first);
+      }
+      const auto recv_buff = pool.recv(key, nrecv * sizeof(real_t));
+      requests.emplace_back();
+#if !defined(DEVICE_ENABLED) || defined(GPU_AWARE_MPI)
+      MPI_Irecv(recv_buff.data.data(),
+                nrecv,
+                mpi::get_type<real_t>(),
+                recv_rank,
+                recv_tag,
+                MPI_COMM_WORLD,
+                &requests.back());
+#else
+      MPI_Irecv(recv_buff.host.data(),
+                nrecv,
+                mpi::get_type<real_t>(),
+                recv_rank,
+                recv_tag,
+                MPI_COMM_WORLD,
+                &requests.back());
+#endif
+    }
+  }
+
+  /**
+   * @brief Copy the received data (after the requests posted by
+   * `BeginCommunicateField` have completed) into `fld_buff`
+   * @note When `additive` is set, the data is added instead
+   */
+  template <Dimension D, int N>
+  inline void EndCommunicateField(ndfield_t<D, N>&                  fld_buff,
+                                  int                               recv_rank,
+                                  const std::vector<range_tuple_t>& recv_slice,
+                                  const range_tuple_t&              comps,
+                                  bool                              additive,
+                                  CommBufferPool&                   pool,
+                                  const CommBufferPool::key_t&      key) {
+    int rank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    if ((recv_rank < 0) or (recv_rank == rank)) {
+      return;
+    }
+    ncells_t nrecv { comps.second - comps.first };
+    for (short d { 0 }; d < (short)D; ++d) {
+      nrecv *= (recv_slice[d].second - recv_slice[d].first);
+    }
+    // same key & size: the pool returns the buffer used in the receive
+    const auto recv_buff = pool.recv(key, nrecv * sizeof(real_t));
+#if defined(DEVICE_ENABLED) && !defined(GPU_AWARE_MPI)
+    Kokkos::deep_copy(recv_buff.data, recv_buff.host);
+#endif
+    flds::fill<D, N>(fld_buff,
+                     recv_slice,
+                     comps,
+                     flds::slice_view<D>(recv_buff, recv_slice, comps),
+                     additive);
+  }
+
+  /**
+   * @brief Exchange between two domains of the same rank: copy (or add) the
+   * `send_slice` of `src_fld` directly into the `recv_slice` of `fld_buff`
+   */
+  template <Dimension D, int N>
+  inline void CommunicateLocalField(ndfield_t<D, N>&                  fld_buff,
+                                    const std::vector<range_tuple_t>& recv_slice,
+                                    const ndfield_t<D, N>&            src_fld,
+                                    const std::vector<range_tuple_t>& send_slice,
+                                    const range_tuple_t&              comps,
+                                    bool                              additive) {
+    if constexpr (D == Dim::_1D) {
+      flds::fill<D, N>(fld_buff,
+                       recv_slice,
+                       comps,
+                       Kokkos::subview(src_fld, send_slice[0], comps),
+                       additive);
+    } else if constexpr (D == Dim::_2D) {
+      flds::fill<D, N>(
+        fld_buff,
+        recv_slice,
+        comps,
+        Kokkos::subview(src_fld, send_slice[0], send_slice[1], comps),
+        additive);
+    } else if constexpr (D == Dim::_3D) {
+      flds::fill<D, N>(
+        fld_buff,
+        recv_slice,
+        comps,
+        Kokkos::subview(src_fld, send_slice[0], send_slice[1], send_slice[2], comps),
+        additive);
+    }
+  }
+
 } // namespace comm
 
 #endif // FRAMEWORK_DOMAIN_COMM_MPI_HPP
@@ -16,6 +16,8 @@
 #include "arch/kokkos_aliases.h"
 #include "utils/error.h"
 
+#include "framework/containers/comm_buffers.h"
+
 #include <Kokkos_Core.hpp>
 
 namespace comm {
@@ -36,7 +38,9 @@ namespace comm {
                                const std::vector<range_tuple_t>& send_slice,
                                const std::vector<range_tuple_t>& recv_slice,
                                const range_tuple_t&              comps,
-                               bool                              additive) {
+                               bool                              additive,
+                               CommBufferPool&,
+                               const CommBufferPool::key_t&) {
     raise::ErrorIf(send_rank < 0 && recv_rank < 0,
                    "CommunicateField called with negative ranks",
                    HERE);
@@ -203,18 +203,35 @@ namespace ntt {
     };
   }
 
+  template <Dimension D, int N>
+  struct FieldExchange {
+    std::string     label;
+    ndfield_t<D, N> fld;
+    ndfield_t<D, N> fld_buff;
+    range_tuple_t   comps;
+  };
+
+  /**
+   * @brief Fields of a domain taking part in an exchange
+   * @note Send `fld`, recv to `fld_buff` (same as `fld` unless synchronizing)
+   */
+  template <Dimension D>
+  struct FieldExchanges {
+    std::vector<FieldExchange<D, 6>> flds6;
+    std::vector<FieldExchange<D, 3>> flds3;
+  };
+
   template <SimEngine::type S, class M>
-  void Metadomain<S, M>::CommunicateFields(Domain<S, M>& domain, CommTags tags) {
-    // const auto comm_fields = (tags & Comm::E) or (tags & Comm::B) or
-    //                          (tags & Comm::J) or (tags & Comm::D) or
-    //                          (tags & Comm::D0) or (tags & Comm::B0) or
-    //                          (tags & Comm::H);
+  auto GhostExchanges(Domain<S, M>& domain, CommTags tags)
+    -> FieldExchanges<M::Dim> {
     const auto comm_em = ((S == SimEngine::SRPIC) and
                           ((tags & Comm::E) or (tags & Comm::B))) or
                          ((S == SimEngine::GRPIC) and
                           ((tags & Comm::D) or (tags & Comm::B)));
-    const bool comm_em0 = (S == SimEngine::GRPIC) and
-                          ((tags & Comm::B0) or (tags & Comm::D0));
+    // in SRPIC, `D0` & `B0` refer to the (time-averaged) fields in `em0`
+    const bool comm_em0 = ((tags & Comm::B0) or (tags & Comm::D0)) and
+                          ((S == SimEngine::GRPIC) or
+                           (domain.fields.em0.span() > 0));
     const bool comm_j   = (tags & Comm::J);
     const bool comm_aux = (S == SimEngine::GRPIC) and
                           ((tags & Comm::E) or (tags & Comm::H));
@@ -222,34 +239,6 @@ namespace ntt {
                    "CommunicateFields called with no task",
                    HERE);
 
-    std::string comms = "";
-    if (tags & Comm::E) {
-      comms += "E ";
-    }
-    if (tags & Comm::B) {
-      comms += "B ";
-    }
-    if (tags & Comm::J) {
-      comms += "J ";
-    }
-    if (tags & Comm::D) {
-      comms += "D ";
-    }
-    if (tags & Comm::H) {
-      comms += "H ";
-    }
-    if (tags & Comm::D0) {
-      comms += "D0 ";
-    }
-    if (tags & Comm::B0) {
-      comms += "B0 ";
-    }
-    logger::Checkpoint(fmt::format("Communicating %s\n", comms.c_str()), HERE);
-
-    /**
-     * @note this block is designed to support in the future multiple domains
-     * on a single rank, however that is not yet implemented
-     */
     // establish the last index ranges for fields (i.e., components)
     auto comp_range_fld = range_tuple_t {};
     auto comp_range_cur = range_tuple_t {};
@@ -264,11 +253,12 @@ namespace ntt {
         comp_range_fld = range_tuple_t(em::bx1, em::bx3 + 1);
       }
     } else if constexpr (S == SimEngine::SRPIC) {
-      if ((tags & Comm::E) and (tags & Comm::B)) {
+      if (((tags & Comm::E) and (tags & Comm::B)) or
+          ((tags & Comm::D0) and (tags & Comm::B0))) {
         comp_range_fld = range_tuple_t(em::ex1, em::bx3 + 1);
-      } else if (tags & Comm::E) {
+      } else if ((tags & Comm::E) or (tags & Comm::D0)) {
         comp_range_fld = range_tuple_t(em::ex1, em::ex3 + 1);
-      } else if (tags & Comm::B) {
+      } else if ((tags & Comm::B) or (tags & Comm::B0)) {
         comp_range_fld = range_tuple_t(em::bx1, em::bx3 + 1);
       }
     } else {
@@ -277,112 +267,367 @@ namespace ntt {
     if (comm_j) {
       comp_range_cur = range_tuple_t(cur::jx1, cur::jx3 + 1);
     }
-    // traverse in all directions and send/recv the fields
-    for (auto& direction : dir::Directions<M::Dim>::all) {
-      const auto [send_params,
-                  recv_params] = GetSendRecvParams(this, domain, direction, false);
-      const auto [send_indrank, send_slice] = send_params;
-      const auto [recv_indrank, recv_slice] = recv_params;
-      const auto [send_ind, send_rank]      = send_indrank;
-      const auto [recv_ind, recv_rank]      = recv_indrank;
-      if (send_rank < 0 and recv_rank < 0) {
-        continue;
+
+    FieldExchanges<M::Dim> exchanges;
+    if (comm_em) {
+      exchanges.flds6.push_back(
+        { "em", domain.fields.em, domain.fields.em, comp_range_fld });
+    }
+    if constexpr (S == SimEngine::GRPIC) {
+      if (comm_aux) {
+        exchanges.flds6.push_back(
+          { "aux", domain.fields.aux, domain.fields.aux, comp_range_fld });
+      }
+      if (comm_em0) {
+        // @HACK_GR_1.2.0 -- aux might need to be exchanged here as well
+        exchanges.flds6.push_back(
+          { "em0", domain.fields.em0, domain.fields.em0, comp_range_fld });
+      }
+      if (comm_j) {
+        exchanges.flds3.push_back(
+          { "cur0", domain.fields.cur0, domain.fields.cur0, comp_range_cur });
+      }
+    } else {
+      if (comm_em0) {
+        exchanges.flds6.push_back(
+          { "em0", domain.fields.em0, domain.fields.em0, comp_range_fld });
+      }
+      if (comm_j) {
+        exchanges.flds3.push_back(
+          { "cur", domain.fields.cur, domain.fields.cur, comp_range_cur });
       }
-      if (comm_em) {
-        comm::CommunicateField<M::Dim, 6>(domain.index(),
-                                          domain.fields.em,
-                                          domain.fields.em,
-                                          send_ind,
-                                          recv_ind,
-                                          send_rank,
-                                          recv_rank,
-                                          send_slice,
-                                          recv_slice,
-                                          comp_range_fld,
-                                          false);
+    }
+    return exchanges;
+  }
+
+  template <SimEngine::type S, class M>
+  auto FindDomain(const std::vector<Domain<S, M>*>& domains, unsigned int idx)
+    -> std::size_t {
+    for (auto i { 0u }; i < domains.size(); ++i) {
+      if (domains[i]->index() == idx) {
+        return i;
       }
-      if constexpr (S == SimEngine::GRPIC) {
-        if (comm_aux) {
-          comm::CommunicateField<M::Dim, 6>(domain.index(),
-                                            domain.fields.aux,
-                                            domain.fields.aux,
-                                            send_ind,
-                                            recv_ind,
-                                            send_rank,
-                                            recv_rank,
-                                            send_slice,
-                                            recv_slice,
-                                            comp_range_fld,
-                                            false);
+    }
+    raise::Error(fmt::format("Domain #%u is local to this rank but is not "
+                             "taking part in the exchange (use the overload "
+                             "which communicates all the local domains)",
+                             idx),
+                 HERE);
+    return 0;
+  }
+
+  /**
+   * @brief Start the exchange of the given fields of the given domains
+   * @note Messages to other ranks are posted, while the exchanges with self
+   * (periodic boundaries) are done right away
+   */
+  template <SimEngine::type S, class M>
+  void BeginExchange(Metadomain<S, M>*                    metadomain,
+                     const std::vector<Domain<S, M>*>&    domains,
+                     std::vector<FieldExchanges<M::Dim>>& exchanges,
+                     bool                                 synchronize,
+#if defined(MPI_ENABLED)
+                     CommBufferPool&           pool,
+                     std::vector<MPI_Request>& requests) {
+#else
+                     CommBufferPool& pool) {
+#endif
+    for (auto i { 0u }; i < domains.size(); ++i) {
+      auto& domain = *domains[i];
+      for (auto& direction : dir::Directions<M::Dim>::all) {
+        const auto [send_params, recv_params] = GetSendRecvParams(metadomain,
+                                                                  domain,
+                                                                  direction,
+                                                                  synchronize);
+        const auto [send_indrank, send_slice] = send_params;
+        const auto [recv_indrank, recv_slice] = recv_params;
+        const auto [send_ind, send_rank]      = send_indrank;
+        const auto [recv_ind, recv_rank]      = recv_indrank;
+        if (send_rank < 0 and recv_rank < 0) {
+          continue;
         }
-        if (comm_em0) {
-          comm::CommunicateField<M::Dim, 6>(domain.index(),
-                                            domain.fields.em0,
-                                            domain.fields.em0,
-                                            send_ind,
-                                            recv_ind,
-                                            send_rank,
-                                            recv_rank,
-                                            send_slice,
-                                            recv_slice,
-                                            comp_range_fld,
-                                            false);
-          // @HACK_GR_1.2.0 -- this has to be done carefully
-          // comm::CommunicateField<M::Dim, 6>(domain.index(),
-          //                                   domain.fields.aux,
-          //                                   domain.fields.aux,
-          //                                   send_ind,
-          //                                   recv_ind,
-          //                                   send_rank,
-          //                                   recv_rank,
-          //                                   send_slice,
-          //                                   recv_slice,
-          //                                   comp_range_fld,
-          //                                   false);
+#if defined(MPI_ENABLED)
+        const auto send_tag = (send_rank >= 0)
+                                ? metadomain->comm_tag(direction, send_ind)
+                                : 0;
+        const auto recv_tag = metadomain->comm_tag(direction, domain.index());
+        for (auto& ex : exchanges[i].flds6) {
+          comm::BeginCommunicateField<M::Dim, 6>(
+            domain.index(),
+            ex.fld,
+            ex.fld_buff,
+            send_ind,
+            recv_ind,
+            send_rank,
+            recv_rank,
+            send_slice,
+            recv_slice,
+            ex.comps,
+            synchronize,
+            pool,
+            { ex.label, domain.index(), direction.hash() },
+            send_tag,
+            recv_tag,
+            requests);
         }
-        if (comm_j) {
-          comm::CommunicateField<M::Dim, 3>(domain.index(),
-                                            domain.fields.cur0,
-                                            domain.fields.cur0,
-                                            send_ind,
-                                            recv_ind,
-                                            send_rank,
-                                            recv_rank,
-                                            send_slice,
-                                            recv_slice,
-                                            comp_range_cur,
-                                            false);
+        for (auto& ex : exchanges[i].flds3) {
+          comm::BeginCommunicateField<M::Dim, 3>(
+            domain.index(),
+            ex.fld,
+            ex.fld_buff,
+            send_ind,
+            recv_ind,
+            send_rank,
+            recv_rank,
+            send_slice,
+            recv_slice,
+            ex.comps,
+            synchronize,
+            pool,
+            { ex.label, domain.index(), direction.hash() },
+            send_tag,
+            recv_tag,
+            requests);
         }
-      } else {
-        if (comm_em) {
-          comm::CommunicateField<M::Dim, 6>(domain.index(),
-                                            domain.fields.em,
-                                            domain.fields.em,
-                                            send_ind,
-                                            recv_ind,
-                                            send_rank,
-                                            recv_rank,
-                                            send_slice,
-                                            recv_slice,
-                                            comp_range_fld,
-                                            false);
+#else
+        // without MPI all the exchanges are local, so they complete right away
+        for (auto& ex : exchanges[i].flds6) {
+          comm::CommunicateField<M::Dim, 6>(
+            domain.index(),
+            ex.fld,
+            ex.fld_buff,
+            send_ind,
+            recv_ind,
+            send_rank,
+            recv_rank,
+            send_slice,
+            recv_slice,
+            ex.comps,
+            synchronize,
+            pool,
+            { ex.label, domain.index(), direction.hash() });
         }
-        if (comm_j) {
-          comm::CommunicateField<M::Dim, 3>(domain.index(),
-                                            domain.fields.cur,
-                                            domain.fields.cur,
-                                            send_ind,
-                                            recv_ind,
-                                            send_rank,
-                                            recv_rank,
-                                            send_slice,
-                                            recv_slice,
-                                            comp_range_cur,
-                                            false);
+        for (auto& ex : exchanges[i].flds3) {
+          comm::CommunicateField<M::Dim, 3>(
+            domain.index(),
+            ex.fld,
+            ex.fld_buff,
+            send_ind,
+            recv_ind,
+            send_rank,
+            recv_rank,
+            send_slice,
+            recv_slice,
+            ex.comps,
+            synchronize,
+            pool,
+            { ex.label, domain.index(), direction.hash() });
+        }
+#endif
+      }
+    }
+  }
+
+#if defined(MPI_ENABLED)
+  /**
+   * @brief Complete the exchange started with `BeginExchange`
+   * @note The data from the other domains of the same rank is copied directly
+   * from their fields: all of them have to take part in the exchange
+   */
+  template <SimEngine::type S, class M>
+  void EndExchange(Metadomain<S, M>*                    metadomain,
+                   const std::vector<Domain<S, M>*>&    domains,
+                   std::vector<FieldExchanges<M::Dim>>& exchanges,
+                   bool                                 synchronize,
+                   CommBufferPool&                      pool,
+                   std::vector<MPI_Request>&            requests) {
+    MPI_Waitall(static_cast<int>(requests.size()),
+                requests.data(),
+                MPI_STATUSES_IGNORE);
+    requests.clear();
+    int rank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    for (auto i { 0u }; i < domains.size(); ++i) {
+      auto& domain = *domains[i];
+      for (auto& direction : dir::Directions<M::Dim>::all) {
+        const auto [send_params, recv_params] = GetSendRecvParams(metadomain,
+                                                                  domain,
+                                                                  direction,
+                                                                  synchronize);
+        const auto [recv_indrank, recv_slice] = recv_params;
+        const auto [recv_ind, recv_rank]      = recv_indrank;
+        if (recv_rank < 0 or recv_ind == domain.index()) {
+          continue;
+        }
+        if (recv_rank == rank) {
+          // the neighbor is on the same rank: copy from its fields directly
+          const auto j      = FindDomain(domains, recv_ind);
+          auto&      nghbr  = *domains[j];
+          const auto params = GetSendRecvParams(metadomain,
+                                                nghbr,
+                                                direction,
+                                                synchronize);
+          const auto& nghbr_send_slice = params.first.second;
+          for (auto e { 0u }; e < exchanges[i].flds6.size(); ++e) {
+            auto& ex = exchanges[i].flds6[e];
+            comm::CommunicateLocalField<M::Dim, 6>(ex.fld_buff,
+                                                   recv_slice,
+                                                   exchanges[j].flds6[e].fld,
+                                                   nghbr_send_slice,
+                                                   ex.comps,
+                                                   synchronize);
+          }
+          for (auto e { 0u }; e < exchanges[i].flds3.size(); ++e) {
+            auto& ex = exchanges[i].flds3[e];
+            comm::CommunicateLocalField<M::Dim, 3>(ex.fld_buff,
+                                                   recv_slice,
+                                                   exchanges[j].flds3[e].fld,
+                                                   nghbr_send_slice,
+                                                   ex.comps,
+                                                   synchronize);
+          }
+        } else {
+          for (auto& ex : exchanges[i].flds6) {
+            comm::EndCommunicateField<M::Dim, 6>(
+              ex.fld_buff,
+              recv_rank,
+              recv_slice,
+              ex.comps,
+              synchronize,
+              pool,
+              { ex.label, domain.index(), direction.hash() });
+          }
+          for (auto& ex : exchanges[i].flds3) {
+            comm::EndCommunicateField<M::Dim, 3>(
+              ex.fld_buff,
+              recv_rank,
+              recv_slice,
+              ex.comps,
+              synchronize,
+              pool,
+              { ex.label, domain.index(), direction.hash() });
+          }
         }
       }
     }
   }
+#endif
+
+  template <SimEngine::type S, class M>
+  void Metadomain<S, M>::CommunicateFields(CommTags tags) {
+    communicateFields(localDomains(), tags);
+  }
+
+  template <SimEngine::type S, class M>
+  void Metadomain<S, M>::CommunicateFields(Domain<S, M>& domain, CommTags tags) {
+    communicateFields({ &domain }, tags);
+  }
+
+  template <SimEngine::type S, class M>
+  void Metadomain<S, M>::communicateFields(const domain_ptrs_t& domains,
+                                           CommTags             tags) {
+    std::string comms = "";
+    if (tags & Comm::E) {
+      comms += "E ";
+    }
+    if (tags & Comm::B) {
+      comms += "B ";
+    }
+    if (tags & Comm::J) {
+      comms += "J ";
+    }
+    if (tags & Comm::D) {
+      comms += "D ";
+    }
+    if (tags & Comm::H) {
+      comms += "H ";
+    }
+    if (tags & Comm::D0) {
+      comms += "D0 ";
+    }
+    if (tags & Comm::B0) {
+      comms += "B0 ";
+    }
+    logger::Checkpoint(fmt::format("Communicating %s\n", comms.c_str()), HERE);
+
+    std::vector<FieldExchanges<M::Dim>> exchanges;
+    for (auto* domain : domains) {
+      exchanges.push_back(GhostExchanges(*domain, tags));
+    }
+#if defined(MPI_ENABLED)
+    raise::ErrorIf(not g_comm_requests.empty(),
+                   "CommunicateFields called with an exchange in flight",
+                   HERE);
+    BeginExchange(this, domains, exchanges, false, g_comm_buffers, g_comm_requests);
+    EndExchange(this, domains, exchanges, false, g_comm_buffers, g_comm_requests);
+#else
+    BeginExchange(this, domains, exchanges, false, g_comm_buffers);
+#endif
+  }
+
+  template <SimEngine::type S, class M>
+  void Metadomain<S, M>::BeginCommunicateFields(CommTags tags) {
+    beginCommunicateFields(localDomains(), tags);
+  }
+
+  template <SimEngine::type S, class M>
+  void Metadomain<S, M>::BeginCommunicateFields(Domain<S, M>& domain,
+                                                CommTags      tags) {
+    beginCommunicateFields({ &domain }, tags);
+  }
+
+  template <SimEngine::type S, class M>
+  void Metadomain<S, M>::beginCommunicateFields(const domain_ptrs_t& domains,
+                                                CommTags             tags) {
+    raise::ErrorIf(S != SimEngine::SRPIC,
+                   "Split-phase field communications only implemented for SRPIC",
+                   HERE);
+    raise::ErrorIf(not((tags & Comm::E) or (tags & Comm::B) or (tags & Comm::J)),
+                   "BeginCommunicateFields called with no task",
+                   HERE);
+#if defined(MPI_ENABLED)
+    raise::ErrorIf(not g_comm_requests.empty(),
+                   "BeginCommunicateFields called with an exchange in flight",
+                   HERE);
+    logger::Checkpoint("Starting field communications\n", HERE);
+    std::vector<FieldExchanges<M::Dim>> exchanges;
+    for (auto* domain : domains) {
+      exchanges.push_back(GhostExchanges(*domain, tags));
+    }
+    BeginExchange(this, domains, exchanges, false, g_comm_buffers, g_comm_requests);
+#else
+    // without MPI all the exchanges are local, so they complete right away
+    communicateFields(domains, tags);
+#endif
+  }
+
+  template <SimEngine::type S, class M>
+  void Metadomain<S, M>::EndCommunicateFields(CommTags tags) {
+    endCommunicateFields(localDomains(), tags);
+  }
+
+  template <SimEngine::type S, class M>
+  void Metadomain<S, M>::EndCommunicateFields(Domain<S, M>& domain,
+                                              CommTags      tags) {
+    endCommunicateFields({ &domain }, tags);
+  }
+
+  template <SimEngine::type S, class M>
+  void Metadomain<S, M>::endCommunicateFields(const domain_ptrs_t& domains,
+                                              CommTags             tags) {
+#if defined(MPI_ENABLED)
+    logger::Checkpoint("Finishing field communications\n", HERE);
+    // the exchanged fields are views: rebuilding the list is cheap
+    std::vector<FieldExchanges<M::Dim>> exchanges;
+    for (auto* domain : domains) {
+      exchanges.push_back(GhostExchanges(*domain, tags));
+    }
+    EndExchange(this, domains, exchanges, false, g_comm_buffers, g_comm_requests);
+#else
+    (void)domains;
+    (void)tags;
+#endif
+  }
 
   template <Dimension D, int N>
   void AddBufferedFields(ndfield_t<D, N>&     field,
@@ -423,10 +668,23 @@ namespace ntt {
     }
   }
 
+  template <SimEngine::type S, class M>
+  void Metadomain<S, M>::SynchronizeFields(CommTags             tags,
+                                           const range_tuple_t& components) {
+    synchronizeFields(localDomains(), tags, components);
+  }
+
   template <SimEngine::type S, class M>
   void Metadomain<S, M>::SynchronizeFields(Domain<S, M>&        domain,
                                            CommTags             tags,
                                            const range_tuple_t& components) {
+    synchronizeFields({ &domain }, tags, components);
+  }
+
+  template <SimEngine::type S, class M>
+  void Metadomain<S, M>::synchronizeFields(const domain_ptrs_t& domains,
+                                           CommTags             tags,
+                                           const range_tuple_t& components) {
     const bool comm_j    = (tags & Comm::J);
     const bool comm_bckp = (tags & Comm::Bckp);
     const bool comm_buff = (tags & Comm::Buff);
@@ -450,156 +708,124 @@ namespace ntt {
     }
     logger::Checkpoint(fmt::format("Synchronizing %s\n", comms.c_str()), HERE);
 
-    auto comp_range_cur = range_tuple_t {};
-    if (comm_j) {
-      comp_range_cur = range_tuple_t(cur::jx1, cur::jx3 + 1);
-      Kokkos::deep_copy(domain.fields.buff, ZERO);
-    }
-    ndfield_t<M::Dim, 6> bckp_recv;
-    ndfield_t<M::Dim, 3> buff_recv;
-    if (comm_bckp) {
-      if constexpr (M::Dim == Dim::_1D) {
-        bckp_recv = ndfield_t<M::Dim, 6> { "bckp_recv",
-                                           domain.fields.bckp.extent(0) };
-      } else if constexpr (M::Dim == Dim::_2D) {
-        bckp_recv = ndfield_t<M::Dim, 6> { "bckp_recv",
-                                           domain.fields.bckp.extent(0),
-                                           domain.fields.bckp.extent(1) };
-      } else if constexpr (M::Dim == Dim::_3D) {
-        bckp_recv = ndfield_t<M::Dim, 6> { "bckp_recv",
-                                           domain.fields.bckp.extent(0),
-                                           domain.fields.bckp.extent(1),
-                                           domain.fields.bckp.extent(2) };
-      }
-    }
-    if (comm_buff) {
-      if constexpr (M::Dim == Dim::_1D) {
-        buff_recv = ndfield_t<M::Dim, 3> { "buff_recv",
-                                           domain.fields.buff.extent(0) };
-      } else if constexpr (M::Dim == Dim::_2D) {
-        buff_recv = ndfield_t<M::Dim, 3> { "buff_recv",
-                                           domain.fields.buff.extent(0),
-                                           domain.fields.buff.extent(1) };
-      } else if constexpr (M::Dim == Dim::_3D) {
-        buff_recv = ndfield_t<M::Dim, 3> { "buff_recv",
-                                           domain.fields.buff.extent(0),
-                                           domain.fields.buff.extent(1),
-                                           domain.fields.buff.extent(2) };
-      }
-    }
-    // traverse in all directions and sync the fields
-    for (auto& direction : dir::Directions<M::Dim>::all) {
-      const auto [send_params,
-                  recv_params] = GetSendRecvParams(this, domain, direction, true);
-      const auto [send_indrank, send_slice] = send_params;
-      const auto [recv_indrank, recv_slice] = recv_params;
-      const auto [send_ind, send_rank]      = send_indrank;
-      const auto [recv_ind, recv_rank]      = recv_indrank;
-      if (send_rank < 0 and recv_rank < 0) {
-        continue;
-      }
+    // the data of all the domains is received before anything is added, as
+    // the neighbors on the same rank are read directly
+    const auto comp_range_cur = range_tuple_t(cur::jx1, cur::jx3 + 1);
+    std::vector<FieldExchanges<M::Dim>> exchanges;
+    for (auto* domain : domains) {
+      FieldExchanges<M::Dim> exchange;
       if (comm_j) {
+        Kokkos::deep_copy(domain->fields.buff, ZERO);
         if constexpr (S == SimEngine::GRPIC) {
-          comm::CommunicateField<M::Dim, 3>(domain.index(),
-                                            domain.fields.cur0,
-                                            domain.fields.buff,
-                                            send_ind,
-                                            recv_ind,
-                                            send_rank,
-                                            recv_rank,
-                                            send_slice,
-                                            recv_slice,
-                                            comp_range_cur,
-                                            synchronize);
+          exchange.flds3.push_back({ "cur0_sync",
+                                     domain->fields.cur0,
+                                     domain->fields.buff,
+                                     comp_range_cur });
         } else {
-          comm::CommunicateField<M::Dim, 3>(domain.index(),
-                                            domain.fields.cur,
-                                            domain.fields.buff,
-                                            send_ind,
-                                            recv_ind,
-                                            send_rank,
-                                            recv_rank,
-                                            send_slice,
-                                            recv_slice,
-                                            comp_range_cur,
-                                            synchronize);
+          exchange.flds3.push_back({ "cur_sync",
+                                     domain->fields.cur,
+                                     domain->fields.buff,
+                                     comp_range_cur });
         }
       }
       if (comm_bckp) {
-        comm::CommunicateField<M::Dim, 6>(domain.index(),
-                                          domain.fields.bckp,
-                                          bckp_recv,
-                                          send_ind,
-                                          recv_ind,
-                                          send_rank,
-                                          recv_rank,
-                                          send_slice,
-                                          recv_slice,
-                                          components,
-                                          synchronize);
+        ndfield_t<M::Dim, 6> bckp_recv;
+        if constexpr (M::Dim == Dim::_1D) {
+          bckp_recv = ndfield_t<M::Dim, 6> { "bckp_recv",
+                                             domain->fields.bckp.extent(0) };
+        } else if constexpr (M::Dim == Dim::_2D) {
+          bckp_recv = ndfield_t<M::Dim, 6> { "bckp_recv",
+                                             domain->fields.bckp.extent(0),
+                                             domain->fields.bckp.extent(1) };
+        } else if constexpr (M::Dim == Dim::_3D) {
+          bckp_recv = ndfield_t<M::Dim, 6> { "bckp_recv",
+                                             domain->fields.bckp.extent(0),
+                                             domain->fields.bckp.extent(1),
+                                             domain->fields.bckp.extent(2) };
+        }
+        exchange.flds6.push_back(
+          { "bckp_sync", domain->fields.bckp, bckp_recv, components });
       }
       if (comm_buff) {
-        comm::CommunicateField<M::Dim, 3>(domain.index(),
-                                          domain.fields.buff,
-                                          buff_recv,
-                                          send_ind,
-                                          recv_ind,
-                                          send_rank,
-                                          recv_rank,
-                                          send_slice,
-                                          recv_slice,
-                                          components,
-                                          synchronize);
+        ndfield_t<M::Dim, 3> buff_recv;
+        if constexpr (M::Dim == Dim::_1D) {
+          buff_recv = ndfield_t<M::Dim, 3> { "buff_recv",
+                                             domain->fields.buff.extent(0) };
+        } else if constexpr (M::Dim == Dim::_2D) {
+          buff_recv = ndfield_t<M::Dim, 3> { "buff_recv",
+                                             domain->fields.buff.extent(0),
+                                             domain->fields.buff.extent(1) };
+        } else if constexpr (M::Dim == Dim::_3D) {
+          buff_recv = ndfield_t<M::Dim, 3> { "buff_recv",
+                                             domain->fields.buff.extent(0),
+                                             domain->fields.buff.extent(1),
+                                             domain->fields.buff.extent(2) };
+        }
+        exchange.flds3.push_back(
+          { "buff_sync", domain->fields.buff, buff_recv, components });
       }
+      exchanges.push_back(exchange);
     }
-    if (comm_j) {
-      if constexpr (S == SimEngine::GRPIC) {
-        AddBufferedFields<M::Dim, 3>(domain.fields.cur0,
-                                     domain.fields.buff,
-                                     domain.mesh.rangeActiveCells(),
-                                     comp_range_cur);
-      } else {
-        AddBufferedFields<M::Dim, 3>(domain.fields.cur,
-                                     domain.fields.buff,
-                                     domain.mesh.rangeActiveCells(),
-                                     comp_range_cur);
+
+#if defined(MPI_ENABLED)
+    raise::ErrorIf(not g_comm_requests.empty(),
+                   "SynchronizeFields called with an exchange in flight",
+                   HERE);
+    BeginExchange(this, domains, exchanges, synchronize, g_comm_buffers, g_comm_requests);
+    EndExchange(this, domains, exchanges, synchronize, g_comm_buffers, g_comm_requests);
+#else
+    BeginExchange(this, domains, exchanges, synchronize, g_comm_buffers);
+#endif
+
+    for (auto i { 0u }; i < domains.size(); ++i) {
+      const auto range = domains[i]->mesh.rangeActiveCells();
+      for (auto& ex : exchanges[i].flds6) {
+        AddBufferedFields<M::Dim, 6>(ex.fld, ex.fld_buff, range, ex.comps);
+      }
+      for (auto& ex : exchanges[i].flds3) {
+        AddBufferedFields<M::Dim, 3>(ex.fld, ex.fld_buff, range, ex.comps);
       }
     }
-    if (comm_bckp) {
-      AddBufferedFields<M::Dim, 6>(domain.fields.bckp,
-                                   bckp_recv,
-                                   domain.mesh.rangeActiveCells(),
-                                   components);
-    }
-    if (comm_buff) {
-      AddBufferedFields<M::Dim, 3>(domain.fields.buff,
-                                   buff_recv,
-                                   domain.mesh.rangeActiveCells(),
-                                   components);
-    }
+  }
+
+  template <SimEngine::type S, class M>
+  void Metadomain<S, M>::CommunicateParticles() {
+    communicateParticles(localDomains());
   }
 
   template <SimEngine::type S, class M>
   void Metadomain<S, M>::CommunicateParticles(Domain<S, M>& domain) {
+    communicateParticles({ &domain });
+  }
+
+  template <SimEngine::type S, class M>
+  void Metadomain<S, M>::communicateParticles(const domain_ptrs_t& domains) {
 #if defined(MPI_ENABLED)
     logger::Checkpoint("Communicating particles\n", HERE);
-    for (auto& species : domain.species) {
-      const auto ntags = species.ntags();
-
+    // communication pattern of a domain (the same for all the species)
+    struct PrtlCommPattern {
+      // all directions requiring communication
+      dir::dirs_t<D>     dirs_to_comm;
+      // ranks, indices & tags of meshblocks to send/recv from
+      dir::map_t<D, int> send_ranks, recv_ranks;
+      dir::map_t<D, int> send_tags, recv_tags;
+      dir::map_t<D, int> recv_inds;
       // coordinate shifts per each direction
-      array_t<int*> shifts_in_x1 { "shifts_in_x1", ntags - 2 };
-      array_t<int*> shifts_in_x2 { "shifts_in_x2", ntags - 2 };
-      array_t<int*> shifts_in_x3 { "shifts_in_x3", ntags - 2 };
-      auto          shifts_in_x1_h = Kokkos::create_mirror_view(shifts_in_x1);
-      auto          shifts_in_x2_h = Kokkos::create_mirror_view(shifts_in_x2);
-      auto          shifts_in_x3_h = Kokkos::create_mirror_view(shifts_in_x3);
+      array_t<int*>      shifts_in_x1, shifts_in_x2, shifts_in_x3;
+    };
 
-      // all directions requiring communication
-      dir::dirs_t<D> dirs_to_comm;
+    std::vector<PrtlCommPattern> patterns;
+    for (auto* domain_ptr : domains) {
+      auto&           domain = *domain_ptr;
+      PrtlCommPattern pattern;
 
-      // ranks & indices of meshblock to send/recv from
-      dir::map_t<D, int> send_ranks;
-      dir::map_t<D, int> recv_ranks;
+      const auto nshifts   = dir::Directions<D>::all.size();
+      pattern.shifts_in_x1 = array_t<int*> { "shifts_in_x1", nshifts };
+      pattern.shifts_in_x2 = array_t<int*> { "shifts_in_x2", nshifts };
+      pattern.shifts_in_x3 = array_t<int*> { "shifts_in_x3", nshifts };
+      auto shifts_in_x1_h  = Kokkos::create_mirror_view(pattern.shifts_in_x1);
+      auto shifts_in_x2_h  = Kokkos::create_mirror_view(pattern.shifts_in_x2);
+      auto shifts_in_x3_h  = Kokkos::create_mirror_view(pattern.shifts_in_x3);
 
       for (const auto& direction : dir::Directions<D>::all) {
         // tags corresponding to the direction (both send & recv)
@@ -617,9 +843,14 @@ namespace ntt {
         if (not is_sending and not is_receiving) {
           continue;
         }
-        dirs_to_comm.push_back(direction);
-        send_ranks[direction] = send_rank;
-        recv_ranks[direction] = recv_rank;
+        pattern.dirs_to_comm.push_back(direction);
+        pattern.send_ranks[direction] = send_rank;
+        pattern.recv_ranks[direction] = recv_rank;
+        pattern.recv_inds[direction]  = recv_ind;
+        pattern.send_tags[direction]  = is_sending
+                                          ? comm_tag(direction, send_ind)
+                                          : 0;
+        pattern.recv_tags[direction]  = comm_tag(direction, domain.index());
 
         // if sending, record displacements to apply before
         // ... tag_send - 2: because we only shift tags > 2 (i.e. no dead/alive)
@@ -653,20 +884,53 @@ namespace ntt {
         }
       } // end directions loop
 
-      Kokkos::deep_copy(shifts_in_x1, shifts_in_x1_h);
-      Kokkos::deep_copy(shifts_in_x2, shifts_in_x2_h);
-      Kokkos::deep_copy(shifts_in_x3, shifts_in_x3_h);
-
-      species.Communicate(dirs_to_comm,
-                          shifts_in_x1,
-                          shifts_in_x2,
-                          shifts_in_x3,
-                          send_ranks,
-                          recv_ranks);
+      Kokkos::deep_copy(pattern.shifts_in_x1, shifts_in_x1_h);
+      Kokkos::deep_copy(pattern.shifts_in_x2, shifts_in_x2_h);
+      Kokkos::deep_copy(pattern.shifts_in_x3, shifts_in_x3_h);
+      patterns.push_back(pattern);
+    }
 
+    for (auto s { 0u }; s < g_species_params.size(); ++s) {
+      // all the sends are posted before anything is received ...
+      // ... so that the domains of a rank can be processed in any order
+      std::vector<PrtlExchange<D>> exchanges;
+      for (auto i { 0u }; i < domains.size(); ++i) {
+        const auto& pattern = patterns[i];
+        exchanges.push_back(
+          domains[i]->species[s].SendOutgoing(pattern.dirs_to_comm,
+                                              pattern.shifts_in_x1,
+                                              pattern.shifts_in_x2,
+                                              pattern.shifts_in_x3,
+                                              pattern.send_ranks,
+                                              pattern.send_tags,
+                                              g_comm_buffers,
+                                              domains[i]->index()));
+      }
+      for (auto i { 0u }; i < domains.size(); ++i) {
+        const auto& pattern = patterns[i];
+        // particles from the domains of the same rank are read directly
+        dir::map_t<D, const PrtlExchange<D>*> local_senders;
+        for (const auto& direction : pattern.dirs_to_comm) {
+          if (pattern.recv_ranks.at(direction) == g_mpi_rank) {
+            const auto j = FindDomain(domains,
+                                      (unsigned int)pattern.recv_inds.at(direction));
+            local_senders[direction] = &exchanges[j];
+          }
+        }
+        domains[i]->species[s].RecvIncoming(exchanges[i],
+                                            pattern.dirs_to_comm,
+                                            pattern.recv_ranks,
+                                            pattern.recv_tags,
+                                            local_senders,
+                                            g_comm_buffers,
+                                            domains[i]->index());
+      }
+      for (auto i { 0u }; i < domains.size(); ++i) {
+        domains[i]->species[s].FinishSending(exchanges[i]);
+      }
     } // end species loop
 #else
-    (void)domain;
+    (void)domains;
 #endif
   }
 
@@ -677,14 +941,90 @@ namespace ntt {
     }
   }
 
+  template <SimEngine::type S, class M>
+  void Metadomain<S, M>::SortParticles(Domain<S, M>& domain,
+                                       ncells_t      tile,
+                                       bool          morton) {
+    for (auto& species : domain.species) {
+      species.SortByCell(domain.mesh.n_active(), tile, morton);
+    }
+  }
+
+  template <SimEngine::type S, class M>
+  void Metadomain<S, M>::ReserveCommBuffers(Domain<S, M>& domain) {
+#if defined(MPI_ENABLED)
+    // field buffers have a fixed size, so they can be allocated upfront ...
+    // ... particle buffers are allocated on first use & grow when necessary
+    std::vector<std::pair<std::string, ncells_t>> fld_buffers;
+    if constexpr (S == SimEngine::GRPIC) {
+      fld_buffers = {
+        {   "em", 6 },
+        {  "em0", 6 },
+        {  "aux", 6 },
+        { "cur0", 3 }
+      };
+    } else {
+      fld_buffers = {
+        {  "em", 6 },
+        { "cur", 3 }
+      };
+    }
+    for (auto& direction : dir::Directions<M::Dim>::all) {
+      const auto [send_params,
+                  recv_params] = GetSendRecvParams(this, domain, direction, false);
+      const auto [send_indrank, send_slice] = send_params;
+      const auto [recv_indrank, recv_slice] = recv_params;
+      const auto [send_ind, send_rank]      = send_indrank;
+      const auto [recv_ind, recv_rank]      = recv_indrank;
+      // exchanges with self & with domains of the same rank do not use the
+      // buffers
+      const auto is_sending   = (send_rank >= 0) and (send_rank != g_mpi_rank);
+      const auto is_receiving = (recv_rank >= 0) and (recv_rank != g_mpi_rank);
+      ncells_t nsend { 1 }, nrecv { 1 };
+      for (auto d { 0u }; d < (unsigned int)(M::Dim); ++d) {
+        if (is_sending) {
+          nsend *= (send_slice[d].second - send_slice[d].first);
+        }
+        if (is_receiving) {
+          nrecv *= (recv_slice[d].second - recv_slice[d].first);
+        }
+      }
+      for (const auto& [label, ncomp] : fld_buffers) {
+        if (is_sending) {
+          g_comm_buffers.send({ label, domain.index(), direction.hash() },
+                              nsend * ncomp * sizeof(real_t));
+        }
+        if (is_receiving) {
+          g_comm_buffers.recv({ label, domain.index(), direction.hash() },
+                              nrecv * ncomp * sizeof(real_t));
+        }
+      }
+    }
+#else
+    (void)domain;
+#endif
+  }
+
 #define METADOMAIN_COMM(S, M, D)                                                \
+  template void Metadomain<S, M<D>>::CommunicateFields(CommTags);              \
+  template void Metadomain<S, M<D>>::BeginCommunicateFields(CommTags);         \
+  template void Metadomain<S, M<D>>::EndCommunicateFields(CommTags);           \
+  template void Metadomain<S, M<D>>::SynchronizeFields(CommTags,               \
+                                                       const range_tuple_t&);  \
+  template void Metadomain<S, M<D>>::CommunicateParticles();                   \
   template void Metadomain<S, M<D>>::CommunicateFields(Domain<S, M<D>>&, CommTags); \
   template void Metadomain<S, M<D>>::SynchronizeFields(                        \
     Domain<S, M<D>>&,                                                         \
     CommTags,                                                                 \
     const range_tuple_t&);                                                    \
   template void Metadomain<S, M<D>>::CommunicateParticles(Domain<S, M<D>>&);   \
-  template void Metadomain<S, M<D>>::RemoveDeadParticles(Domain<S, M<D>>&);
+  template void Metadomain<S, M<D>>::RemoveDeadParticles(Domain<S, M<D>>&);  \
+  template void Metadomain<S, M<D>>::SortParticles(Domain<S, M<D>>&, ncells_t, bool); \
+  template void Metadomain<S, M<D>>::ReserveCommBuffers(Domain<S, M<D>>&);  \
+  template void Metadomain<S, M<D>>::BeginCommunicateFields(Domain<S, M<D>>&,  \
+                                                            CommTags);        \
+  template void Metadomain<S, M<D>>::EndCommunicateFields(Domain<S, M<D>>&,    \
+                                                          CommTags);
 
   NTT_FOREACH_SPECIALIZATION(METADOMAIN_COMM)
 
@@ -77,6 +77,13 @@ namespace ntt {
           imin[i] = i_max((in)i);
           imax[i] = n_all((in)i);
           break;
+        case CellLayer::interiorLayer:
+          raise::ErrorIf(n_active((in)i) < 2 * N_GHOSTS,
+                         "Not enough active cells for the interior layer",
+                         HERE);
+          imin[i] = i_min((in)i) + N_GHOSTS;
+          imax[i] = i_max((in)i) - N_GHOSTS;
+          break;
         default:
           raise::Error("Invalid cell layer", HERE);
           throw;
@@ -115,6 +122,13 @@ namespace ntt {
           imin[i] = i_max((in)i);
           imax[i] = n_all((in)i);
           break;
+        case CellLayer::interiorLayer:
+          raise::ErrorIf(n_active((in)i) < 2 * N_GHOSTS,
+                         "Not enough active cells for the interior layer",
+                         HERE);
+          imin[i] = i_min((in)i) + N_GHOSTS;
+          imax[i] = i_max((in)i) - N_GHOSTS;
+          break;
         default:
           raise::Error("Invalid cell layer", HERE);
       }
@@ -178,6 +192,40 @@ namespace ntt {
     return CreateRangePolicy<D>(imin, imax);
   }
 
+  template <Dimension D>
+  auto Grid<D>::rangeInteriorCells() const -> range_t<D> {
+    box_region_t<D> region;
+    for (auto i { 0u }; i < D; ++i) {
+      region[i] = CellLayer::interiorLayer;
+    }
+    return rangeCells(region);
+  }
+
+  template <Dimension D>
+  auto Grid<D>::rangesBoundaryLayer() const -> std::vector<range_t<D>> {
+    // non-overlapping slabs: for each dimension `d`, take the min/max active
+    // ... layer in `d`, the interior layer in all the preceding dimensions,
+    // ... and the whole active layer in all the following ones
+    std::vector<range_t<D>> ranges;
+    for (auto d { 0u }; d < D; ++d) {
+      for (const auto layer :
+           { CellLayer::minActiveLayer, CellLayer::maxActiveLayer }) {
+        box_region_t<D> region;
+        for (auto i { 0u }; i < D; ++i) {
+          if (i < d) {
+            region[i] = CellLayer::interiorLayer;
+          } else if (i == d) {
+            region[i] = layer;
+          } else {
+            region[i] = CellLayer::activeLayer;
+          }
+        }
+        ranges.push_back(rangeCells(region));
+      }
+    }
+    return ranges;
+  }
+
   template struct Grid<Dim::_1D>;
   template struct Grid<Dim::_2D>;
   template struct Grid<Dim::_3D>;
@@ -199,6 +199,17 @@ namespace ntt {
      * @returns Kokkos range policy with proper min/max indices and dimension
      */
     auto rangeCells(const tuple_t<list_t<int, 2>, D>&) const -> range_t<D>;
+    /**
+     * @brief Loop over the active cells at least N_GHOSTS away from the edges
+     * @returns Kokkos range policy with proper min/max indices and dimension
+     */
+    auto rangeInteriorCells() const -> range_t<D>;
+    /**
+     * @brief Loop over the active cells within N_GHOSTS from the edges
+     * @returns Vector of 2 * D non-overlapping Kokkos range policies which,
+     * together with `rangeInteriorCells`, cover all the active cells
+     */
+    auto rangesBoundaryLayer() const -> std::vector<range_t<D>>;
 
     /* Ranges in the host execution space ----------------------------------- */
     /**
@@ -13,9 +13,12 @@
 #include "framework/specialization_registry.h"
 
 #if defined(MPI_ENABLED)
+  #include "arch/mpi_tags.h"
+
   #include <mpi.h>
 #endif
 
+#include <algorithm>
 #include <limits>
 #include <map>
 #include <string>
@@ -40,8 +43,8 @@ namespace ntt {
 #if defined(MPI_ENABLED)
     MPI_Comm_size(MPI_COMM_WORLD, &g_mpi_size);
     MPI_Comm_rank(MPI_COMM_WORLD, &g_mpi_rank);
-    raise::ErrorIf(global_ndomains != (unsigned int)g_mpi_size,
-                   "Exactly 1 domain per MPI rank is allowed",
+    raise::ErrorIf(global_ndomains < (unsigned int)g_mpi_size,
+                   "At least 1 domain per MPI rank is required",
                    HERE);
 #endif
     initialValidityCheck();
@@ -52,6 +55,10 @@ namespace ntt {
 
     finalValidityCheck();
     metricCompatibilityCheck();
+
+    for (const auto& ldidx : g_local_subdomain_indices) {
+      ReserveCommBuffers(g_subdomains[ldidx]);
+    }
   }
 
   template <SimEngine::type S, class M>
@@ -78,10 +85,6 @@ namespace ntt {
     raise::ErrorIf((status != MPI_SUCCESS) || (init_flag != 1),
                    "MPI not initialized",
                    HERE);
-    raise::ErrorIf((unsigned int)g_mpi_size != g_ndomains,
-                   "ndomains != g_mpi_size is not implemented with MPI",
-                   HERE);
-
 #else // not MPI_ENABLED
   #if !defined(DEBUG)
     raise::ErrorIf(g_ndomains != 1,
@@ -92,12 +95,20 @@ namespace ntt {
   }
 
   template <SimEngine::type S, class M>
-  void Metadomain<S, M>::createEmptyDomains() {
+  void Metadomain<S, M>::createEmptyDomains(
+    const std::vector<std::vector<ncells_t>>& layout,
+    bool                                      allocate) {
     /* decompose and compute cell & domain offsets ------------------------ */
-    auto d_ncells = tools::Decompose(g_ndomains, g_mesh.n_active(), g_decomposition);
+    auto d_ncells = layout.empty() ? tools::Decompose(g_ndomains,
+                                                      g_mesh.n_active(),
+                                                      g_decomposition)
+                                   : layout;
     raise::ErrorIf(d_ncells.size() != (std::size_t)D,
                    "Invalid number of dimensions received",
                    HERE);
+    g_ndomains_per_dim.clear();
+    g_local_subdomain_indices.clear();
+    g_domain_offset2index.clear();
     auto d_offset_ncells = std::vector<std::vector<ncells_t>> {};
     auto d_offset_ndoms  = std::vector<std::vector<unsigned int>> {};
     for (auto& d : d_ncells) {
@@ -127,6 +138,9 @@ namespace ntt {
     if (not g_subdomains.empty()) {
       g_subdomains.clear();
     }
+#if defined(MPI_ENABLED)
+    g_domain_slots.clear();
+#endif
     for (unsigned int idx { 0 }; idx < g_ndomains; ++idx) {
       auto                 l_offset_ndomains = domain_offset_ndoms[idx];
       auto                 l_ncells          = domain_ncells[idx];
@@ -147,10 +161,11 @@ namespace ntt {
       }
 
 #if defined(MPI_ENABLED)
-      // !TODO: need to change to support multiple domains per rank
-      // assuming ONE local subdomain
-      const auto local = ((int)idx == g_mpi_rank);
-      if (not local) {
+      // each rank gets a contiguous block of domains
+      const auto owner = (int)(((std::size_t)idx * (std::size_t)g_mpi_size) /
+                               (std::size_t)g_ndomains);
+      const auto local = (owner == g_mpi_rank);
+      if (not local or not allocate) {
         g_subdomains.emplace_back(false,
                                   idx,
                                   l_offset_ndomains,
@@ -168,24 +183,85 @@ namespace ntt {
                                   g_metric_params,
                                   g_species_params);
       }
-      g_subdomains.back().set_mpi_rank(idx);
+      g_subdomains.back().set_mpi_rank(owner);
       if (g_subdomains.back().mpi_rank() == g_mpi_rank) {
         g_local_subdomain_indices.push_back(idx);
       }
+      if ((idx == 0) or (g_subdomains[idx - 1].mpi_rank() != owner)) {
+        g_domain_slots.push_back(0);
+      } else {
+        g_domain_slots.push_back(g_domain_slots.back() + 1);
+      }
 #else  // not MPI_ENABLED
-      g_subdomains.emplace_back(idx,
-                                l_offset_ndomains,
-                                l_offset_ncells,
-                                l_ncells,
-                                l_extent,
-                                g_metric_params,
-                                g_species_params);
+      if (not allocate) {
+        g_subdomains.emplace_back(false,
+                                  idx,
+                                  l_offset_ndomains,
+                                  l_offset_ncells,
+                                  l_ncells,
+                                  l_extent,
+                                  g_metric_params,
+                                  g_species_params);
+      } else {
+        g_subdomains.emplace_back(idx,
+                                  l_offset_ndomains,
+                                  l_offset_ncells,
+                                  l_ncells,
+                                  l_extent,
+                                  g_metric_params,
+                                  g_species_params);
+      }
       g_local_subdomain_indices.push_back(idx);
 #endif // MPI_ENABLED
       g_domain_offset2index[l_offset_ndomains] = idx;
     }
   }
 
+  template <SimEngine::type S, class M>
+  auto Metadomain<S, M>::ncells_per_dim() const
+    -> std::vector<std::vector<ncells_t>> {
+    std::vector<std::vector<ncells_t>> layout;
+    for (auto d { 0u }; d < (unsigned int)D; ++d) {
+      std::vector<ncells_t> ncells;
+      auto                  offset = std::vector<unsigned int>(D, 0);
+      for (auto n { 0u }; n < g_ndomains_per_dim[d]; ++n) {
+        offset[d] = n;
+        ncells.push_back(
+          g_subdomains[g_domain_offset2index.at(offset)].mesh.n_active()[d]);
+      }
+      layout.push_back(ncells);
+    }
+    return layout;
+  }
+
+  template <SimEngine::type S, class M>
+  void Metadomain<S, M>::setLayout(const std::vector<std::vector<ncells_t>>& layout,
+                                   bool allocate) {
+    raise::ErrorIf(layout.size() != (std::size_t)D, "Invalid layout", HERE);
+    for (auto d { 0u }; d < (unsigned int)D; ++d) {
+      raise::ErrorIf(layout[d].size() != g_ndomains_per_dim[d],
+                     "The layout must keep the number of domains per dimension",
+                     HERE);
+      ncells_t ncells { 0 };
+      for (const auto& n : layout[d]) {
+        ncells += n;
+      }
+      raise::ErrorIf(ncells != g_mesh.n_active()[d],
+                     "The layout does not cover the whole grid",
+                     HERE);
+    }
+    createEmptyDomains(layout, allocate);
+    redefineNeighbors();
+    redefineBoundaries();
+
+    finalValidityCheck();
+    metricCompatibilityCheck();
+
+    for (const auto& ldidx : g_local_subdomain_indices) {
+      ReserveCommBuffers(g_subdomains[ldidx]);
+    }
+  }
+
   template <SimEngine::type S, class M>
   void Metadomain<S, M>::redefineNeighbors() {
     for (unsigned int idx { 0 }; idx < g_ndomains; ++idx) {
@@ -358,6 +434,21 @@ namespace ntt {
                        HERE);
       }
     }
+#if defined(MPI_ENABLED)
+    // messages between the domains of two ranks are told apart by their tags
+    void* tag_ub_ptr = nullptr;
+    int   flag       = 0;
+    MPI_Comm_get_attr(MPI_COMM_WORLD, MPI_TAG_UB, &tag_ub_ptr, &flag);
+    if ((flag != 0) and (tag_ub_ptr != nullptr) and (not g_domain_slots.empty())) {
+      const auto max_slot = *std::max_element(g_domain_slots.begin(),
+                                              g_domain_slots.end());
+      const auto max_tag = ((int)dir::Directions<D>::all.size() + 2) *
+                           ((int)max_slot + 1);
+      raise::ErrorIf(max_tag > *static_cast<int*>(tag_ub_ptr),
+                     "Too many domains per MPI rank (MPI_TAG_UB exceeded)",
+                     HERE);
+    }
+#endif
   }
 
   template <SimEngine::type S, class M>
@@ -377,7 +468,7 @@ namespace ntt {
         " " + std::to_string(dx_min_from_domains),
       HERE);
 #if defined(MPI_ENABLED)
-    auto dx_mins        = std::vector<real_t>(g_ndomains);
+    auto dx_mins        = std::vector<real_t>(g_mpi_size);
     dx_mins[g_mpi_rank] = dx_min;
     MPI_Allgather(&dx_min,
                   1,
@@ -394,6 +485,64 @@ namespace ntt {
 #endif
   }
 
+#if defined(MPI_ENABLED)
+  template <SimEngine::type S, class M>
+  auto Metadomain<S, M>::comm_tag(const dir::direction_t<D>& direction,
+                                  unsigned int idx) const -> int {
+    raise::ErrorIf(idx >= g_domain_slots.size(), "comm_tag() failed", HERE);
+    // tags of all the directions (+ dead/alive) for each domain of a rank
+    const auto ntags = (int)dir::Directions<D>::all.size() + 2;
+    return mpi::PrtlSendTag<D>::dir2tag(direction) +
+           ntags * (int)g_domain_slots[idx];
+  }
+#endif
+
+  template <SimEngine::type S, class M>
+  auto Metadomain<S, M>::gatherDomainOffsets(
+    const std::vector<npart_t>& counts) const
+    -> std::pair<std::vector<npart_t>, npart_t> {
+    raise::ErrorIf(counts.size() != g_local_subdomain_indices.size(),
+                   "gatherDomainOffsets() expects one count per local domain",
+                   HERE);
+    npart_t offset = 0u, total = 0u;
+#if defined(MPI_ENABLED)
+    // domains are assigned to ranks in contiguous blocks, so the counts of all
+    // the domains of the preceding ranks go first
+    const int nlocal = (int)counts.size();
+    auto      nlocal_all = std::vector<int>(g_mpi_size);
+    MPI_Allgather(&nlocal, 1, MPI_INT, nlocal_all.data(), 1, MPI_INT, MPI_COMM_WORLD);
+    auto displs = std::vector<int>(g_mpi_size, 0);
+    for (auto r { 1 }; r < g_mpi_size; ++r) {
+      displs[r] = displs[r - 1] + nlocal_all[r - 1];
+    }
+    auto counts_all = std::vector<npart_t>(displs.back() + nlocal_all.back());
+    MPI_Allgatherv(counts.data(),
+                   nlocal,
+                   mpi::get_type<npart_t>(),
+                   counts_all.data(),
+                   nlocal_all.data(),
+                   displs.data(),
+                   mpi::get_type<npart_t>(),
+                   MPI_COMM_WORLD);
+    for (auto i { 0 }; i < (int)counts_all.size(); ++i) {
+      if (i < displs[g_mpi_rank]) {
+        offset += counts_all[i];
+      }
+      total += counts_all[i];
+    }
+#else
+    for (const auto& count : counts) {
+      total += count;
+    }
+#endif
+    auto offsets = std::vector<npart_t>(counts.size());
+    for (auto i { 0u }; i < counts.size(); ++i) {
+      offsets[i]  = offset;
+      offset     += counts[i];
+    }
+    return { offsets, total };
+  }
+
   template <SimEngine::type S, class M>
   void Metadomain<S, M>::setFldsBC(const bc_in& dir, const FldsBC& new_bcs) {
     if (dir == bc_in::Mx1) {
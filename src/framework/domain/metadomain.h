@@ -18,8 +18,10 @@
 #include "enums.h"
 #include "global.h"
 
+#include "arch/directions.h"
 #include "arch/kokkos_aliases.h"
 
+#include "framework/containers/comm_buffers.h"
 #include "framework/containers/species.h"
 #include "framework/domain/domain.h"
 #include "framework/domain/mesh.h"
@@ -59,8 +61,12 @@ namespace ntt {
     /**
      * @brief Populates the g_subdomains vector with ...
      * ... domains of proper shape, extent, index, and offset
+     * @param layout # of cells of the domains along each dimension (if empty,
+     * the grid is decomposed evenly)
+     * @param allocate if false, local domains are created as placeholders
      */
-    void createEmptyDomains();
+    void createEmptyDomains(const std::vector<std::vector<ncells_t>>& = {},
+                            bool = true);
 
     /**
      * @brief Populates the neighbor-pointers of each domain in g_subdomains
@@ -86,10 +92,46 @@ namespace ntt {
       }
     }
 
+    /**
+     * @brief Exchange the ghost cells of all the local domains
+     * @note Neighbors on the same rank are copied directly (no MPI), the
+     * overloads taking a single domain require it to be the only local one
+     */
+    void CommunicateFields(CommTags);
     void CommunicateFields(Domain<S, M>&, CommTags);
+
+    /**
+     * @brief Split-phase exchange of the ghost cells of E, B and/or J (SRPIC)
+     * @note The outgoing data is copied when the exchange begins, while the
+     * ghost cells are only filled when it ends
+     */
+    void BeginCommunicateFields(CommTags);
+    void BeginCommunicateFields(Domain<S, M>&, CommTags);
+    void EndCommunicateFields(CommTags);
+    void EndCommunicateFields(Domain<S, M>&, CommTags);
+    void SynchronizeFields(CommTags, const range_tuple_t& = { 0, 0 });
     void SynchronizeFields(Domain<S, M>&, CommTags, const range_tuple_t& = { 0, 0 });
+    void CommunicateParticles();
     void CommunicateParticles(Domain<S, M>&);
     void RemoveDeadParticles(Domain<S, M>&);
+    void SortParticles(Domain<S, M>&, ncells_t, bool);
+
+    /**
+     * @brief Allocates the persistent buffers for the field exchanges
+     */
+    void ReserveCommBuffers(Domain<S, M>&);
+
+#if defined(MPI_ENABLED)
+    /**
+     * @brief Shift the domain boundaries so that the work is evenly shared
+     * @param params simulation parameters (`simulation.domain.rebalance.*`)
+     * @param prtl_time time spent on particles by this rank since the last call
+     * @returns true if the domains have been redistributed
+     * @note Fields & particles are migrated to the new layout in place; the
+     * boundaries only move within the neighboring domains at each call
+     */
+    auto Rebalance(const SimulationParams&, duration_t) -> bool;
+#endif
 
     /**
      * @param global_ndomains total number of domains
@@ -128,6 +170,16 @@ namespace ntt {
                                   timestep_t,
                                   simtime_t,
                                   const Domain<S, M>&)> = nullptr) -> bool;
+
+    /**
+     * @brief Block until the pending (asynchronous) output is written to disk
+     * & the staged checkpoints are copied
+     */
+    void FinishWriting() {
+      g_writer.waitForWriting();
+      g_checkpoint_writer.waitForFlush();
+    }
+
     void InitCheckpointWriter(adios2::ADIOS*, const SimulationParams&);
     auto WriteCheckpoint(const SimulationParams&,
                          timestep_t,
@@ -135,6 +187,12 @@ namespace ntt {
                          simtime_t,
                          simtime_t) -> bool;
 
+    /**
+     * @brief Read the fields & particles of the local domains from a checkpoint
+     * @note The checkpoint may have been written with a different # of ranks
+     * or domain decomposition: fields are read as boxes of the global grid,
+     * and particles from all the overlapping domains are filtered by cell
+     */
     void ContinueFromCheckpoint(adios2::ADIOS*, const SimulationParams&);
 #endif
 
@@ -163,6 +221,12 @@ namespace ntt {
       return g_ndomains_per_dim;
     }
 
+    /**
+     * @brief # of active cells of the domains along each of the dimensions
+     */
+    [[nodiscard]]
+    auto ncells_per_dim() const -> std::vector<std::vector<ncells_t>>;
+
     [[nodiscard]]
     auto subdomain(unsigned int idx) const -> const Domain<S, M>& {
       raise::ErrorIf(idx >= g_subdomains.size(), "subdomain() failed", HERE);
@@ -231,6 +295,20 @@ namespace ntt {
       return ncells_local;
     }
 
+#if defined(MPI_ENABLED)
+    /**
+     * @brief MPI tag of the messages received by a domain from a direction
+     * @note Unique among the domains of a rank
+     */
+    [[nodiscard]]
+    auto comm_tag(const dir::direction_t<D>&, unsigned int) const -> int;
+#endif
+
+    [[nodiscard]]
+    auto comm_buffers() const -> const CommBufferPool& {
+      return g_comm_buffers;
+    }
+
     [[nodiscard]]
     auto species_labels() const -> std::vector<std::string> {
       std::vector<std::string> labels;
@@ -241,6 +319,37 @@ namespace ntt {
     }
 
   private:
+    using domain_ptrs_t = std::vector<Domain<S, M>*>;
+
+    /**
+     * @brief Recreate the domains with a given # of cells along each dimension
+     * @note The neighbors, boundaries & comm buffers are redefined as well
+     */
+    void setLayout(const std::vector<std::vector<ncells_t>>&, bool);
+
+    auto localDomains() -> domain_ptrs_t {
+      domain_ptrs_t domains;
+      for (const auto& ldidx : g_local_subdomain_indices) {
+        domains.push_back(&g_subdomains[ldidx]);
+      }
+      return domains;
+    }
+
+    /**
+     * @brief Global offsets of per-domain counts (e.g., particles to write)
+     * @param counts One count per local domain (in the local domain order)
+     * @returns Offset of each local domain & the total count over all ranks
+     * @note Offsets follow the global domain index order
+     */
+    auto gatherDomainOffsets(const std::vector<npart_t>&) const
+      -> std::pair<std::vector<npart_t>, npart_t>;
+
+    void communicateFields(const domain_ptrs_t&, CommTags);
+    void beginCommunicateFields(const domain_ptrs_t&, CommTags);
+    void endCommunicateFields(const domain_ptrs_t&, CommTags);
+    void synchronizeFields(const domain_ptrs_t&, CommTags, const range_tuple_t&);
+    void communicateParticles(const domain_ptrs_t&);
+
     // domain information
     unsigned int g_ndomains;
 
@@ -258,9 +367,18 @@ namespace ntt {
 
     stats::Writer g_stats_writer;
 
+    // persistent send/recv buffers (only used with MPI)
+    CommBufferPool g_comm_buffers;
+
 #if defined(OUTPUT_ENABLED)
     out::Writer        g_writer;
     checkpoint::Writer g_checkpoint_writer;
+
+    /**
+     * @brief Register the meshblocks of the local domains with the writer
+     * @note Needs to be called whenever the domain layout changes
+     */
+    void resetOutputMeshBlocks();
   #if defined(MPI_ENABLED)
     void CommunicateVectorPotential(unsigned short);
   #endif
@@ -268,6 +386,12 @@ namespace ntt {
 
 #if defined(MPI_ENABLED)
     int g_mpi_rank, g_mpi_size;
+
+    // position of each domain among the domains of its rank
+    std::vector<unsigned int> g_domain_slots;
+
+    // requests of the field exchange in flight
+    std::vector<MPI_Request> g_comm_requests;
 #endif
   };
 
@@ -21,7 +21,11 @@
 
 #include "kernels/divergences.hpp"
 #include "kernels/fields_to_phys.hpp"
+#include "kernels/particle_histogram.hpp"
 #include "kernels/particle_moments.hpp"
+#include "kernels/particle_selection.hpp"
+#include "output/fields.h"
+#include "output/spectra.h"
 
 #include <Kokkos_Core.hpp>
 #include <Kokkos_ScatterView.hpp>
@@ -33,47 +37,78 @@
 
 #include <algorithm>
 #include <iterator>
+#include <string>
 #include <vector>
 
 namespace ntt {
 
+  /**
+   * @brief Position & size (in cells) of the meshblock of a domain in the output
+   */
+  template <SimEngine::type S, class M>
+  auto OutputMeshBlock(const Domain<S, M>& domain, bool incl_ghosts)
+    -> std::pair<std::vector<ncells_t>, std::vector<ncells_t>> {
+    auto off_ncells_with_ghosts = domain.offset_ncells();
+    auto loc_shape_with_ghosts  = domain.mesh.n_active();
+    if (incl_ghosts) {
+      for (auto d { 0 }; d < M::Dim; ++d) {
+        off_ncells_with_ghosts[d] += 2 * N_GHOSTS * domain.offset_ndomains()[d];
+        loc_shape_with_ghosts[d]  += 2 * N_GHOSTS;
+      }
+    }
+    return { off_ncells_with_ghosts, loc_shape_with_ghosts };
+  }
+
   template <SimEngine::type S, class M>
   void Metadomain<S, M>::InitWriter(adios2::ADIOS*          ptr_adios,
                                     const SimulationParams& params) {
-    raise::ErrorIf(
-      l_subdomain_indices().size() != 1,
-      "Output for now is only supported for one subdomain per rank",
-      HERE);
-    auto local_domain = subdomain_ptr(l_subdomain_indices()[0]);
-    raise::ErrorIf(local_domain->is_placeholder(),
-                   "local_domain is a placeholder",
-                   HERE);
+    const auto local_domains = localDomains();
+    raise::ErrorIf(local_domains.empty(), "no local subdomains to output", HERE);
+    for (const auto* local_domain : local_domains) {
+      raise::ErrorIf(local_domain->is_placeholder(),
+                     "local_domain is a placeholder",
+                     HERE);
+    }
     const auto incl_ghosts = params.template get<bool>("output.debug.ghosts");
 
     auto glob_shape_with_ghosts = mesh().n_active();
-    auto off_ncells_with_ghosts = local_domain->offset_ncells();
-    auto off_ndomains           = local_domain->offset_ndomains();
-    auto loc_shape_with_ghosts  = local_domain->mesh.n_active();
     if (incl_ghosts) {
-      for (auto d { 0 }; d <= M::Dim; ++d) {
+      for (auto d { 0 }; d < M::Dim; ++d) {
         glob_shape_with_ghosts[d] += 2 * N_GHOSTS * ndomains_per_dim()[d];
-        off_ncells_with_ghosts[d] += 2 * N_GHOSTS * off_ndomains[d];
-        loc_shape_with_ghosts[d]  += 2 * N_GHOSTS;
       }
     }
-
     g_writer.init(ptr_adios,
                   params.template get<std::string>("output.format"),
                   params.template get<std::string>("simulation.name"),
-                  params.template get<bool>("output.separate_files"));
-    g_writer.defineMeshLayout(glob_shape_with_ghosts,
-                              off_ncells_with_ghosts,
-                              loc_shape_with_ghosts,
-                              { local_domain->index(), ndomains() },
-                              params.template get<std::vector<unsigned int>>(
-                                "output.fields.downsampling"),
-                              incl_ghosts,
-                              M::CoordType);
+                  params.template get<bool>("output.separate_files"),
+                  params.template get<bool>("output.async"));
+    g_writer.setCompression(
+      params.template get<std::string>("output.compression.fields"),
+      params.template get<std::string>("output.compression.particles"),
+      params.template get<real_t>("output.compression.accuracy"),
+      params.template get<unsigned short>("output.compression.level"),
+      params.template get<bool>("output.compression.single_precision"));
+    {
+      // variables are declared with the first local meshblock, the rest are
+      // written as additional blocks of the same variables
+      const auto [corner, shape] = OutputMeshBlock(*local_domains[0], incl_ghosts);
+      g_writer.defineMeshLayout(glob_shape_with_ghosts,
+                                corner,
+                                shape,
+                                { local_domains[0]->index(), ndomains() },
+                                params.template get<std::vector<unsigned int>>(
+                                  "output.fields.downsampling"),
+                                incl_ghosts,
+                                M::CoordType,
+                                Downsampling::pick(
+                                  params.template get<std::string>(
+                                    "output.fields.downsampling_mode").c_str()));
+      for (auto i { 1u }; i < local_domains.size(); ++i) {
+        const auto [corner_i, shape_i] = OutputMeshBlock(*local_domains[i],
+                                                         incl_ghosts);
+        g_writer.addMeshBlock(corner_i, shape_i, local_domains[i]->index());
+      }
+    }
     const auto fields_to_write = params.template get<std::vector<std::string>>(
       "output.fields.quantities");
     const auto custom_fields_to_write = params.template get<std::vector<std::string>>(
@@ -96,9 +131,11 @@ namespace ntt {
     for (const auto& s : species_to_write) {
       g_writer.addSpeciesIndex(s);
     }
+    const auto prtl_packed = params.template get<bool>("output.particles.packed");
     for (const auto sp : g_writer.speciesIndices()) {
-      local_domain->species[sp - 1].OutputDeclare(g_writer.io());
+      local_domains[0]->species[sp - 1].OutputDeclare(g_writer.io(), prtl_packed);
     }
+    g_writer.compressParticleOutputs();
 
     // spectra write all particle species
     std::vector<spidx_t> spectra_species {};
@@ -106,6 +143,38 @@ namespace ntt {
       spectra_species.push_back(sp.index());
     }
     g_writer.defineSpectraOutputs(spectra_species);
+    // generic particle histograms
+    const auto hist_labels = params.template get<std::vector<std::string>>(
+      "output.spectra.histograms.labels");
+    const auto hist_species = params.template get<std::vector<std::vector<spidx_t>>>(
+      "output.spectra.histograms.species");
+    const auto hist_axes = params.template get<std::vector<std::vector<std::string>>>(
+      "output.spectra.histograms.axes");
+    const auto hist_nbins = params.template get<std::vector<std::vector<std::size_t>>>(
+      "output.spectra.histograms.n_bins");
+    const auto hist_min = params.template get<std::vector<std::vector<real_t>>>(
+      "output.spectra.histograms.min");
+    const auto hist_max = params.template get<std::vector<std::vector<real_t>>>(
+      "output.spectra.histograms.max");
+    const auto hist_log = params.template get<std::vector<std::vector<unsigned short>>>(
+      "output.spectra.histograms.log_bins");
+    std::vector<out::OutputHistogram> histograms;
+    for (auto h { 0u }; h < hist_labels.size(); ++h) {
+      std::vector<SpecAxis> axes;
+      std::vector<bool>     log_bins;
+      for (auto d { 0u }; d < hist_axes[h].size(); ++d) {
+        axes.push_back(SpecAxis::pick(hist_axes[h][d].c_str()));
+        log_bins.push_back(hist_log[h][d] != 0);
+      }
+      histograms.emplace_back(hist_labels[h],
+                              hist_species[h],
+                              axes,
+                              hist_nbins[h],
+                              hist_min[h],
+                              hist_max[h],
+                              log_bins);
+    }
+    g_writer.defineHistogramOutputs(histograms);
     for (const auto& type : { "fields", "particles", "spectra" }) {
       g_writer.addTracker(type,
                           params.template get<timestep_t>(
@@ -116,27 +185,108 @@ namespace ntt {
     g_writer.writeAttrs(params);
   }
 
-  template <SimEngine::type S, class M, FldsID::type F>
-  void ComputeMoments(const SimulationParams& params,
-                      const Mesh<M>&          mesh,
-                      const std::vector<Particles<M::Dim, M::CoordType>>& prtl_species,
-                      const std::vector<spidx_t>&        species,
-                      const std::vector<unsigned short>& components,
-                      ndfield_t<M::Dim, 6>&              buffer,
-                      idx_t                              buff_idx) {
-    std::vector<spidx_t> specs = species;
-    if (specs.size() == 0) {
-      // if no species specified, take all massive species
-      for (auto& sp : prtl_species) {
-        if (sp.mass() > 0) {
-          specs.push_back(sp.index());
+  template <SimEngine::type S, class M>
+  void Metadomain<S, M>::resetOutputMeshBlocks() {
+    if (g_writer.meshBlocks().empty()) {
+      // mesh layout has not been defined (no output)
+      return;
+    }
+    g_writer.clearMeshBlocks();
+    for (const auto* local_domain : localDomains()) {
+      const auto [corner, shape] = OutputMeshBlock(*local_domain,
+                                                   g_writer.fieldsWithGhosts());
+      g_writer.addMeshBlock(corner, shape, local_domain->index());
+    }
+  }
+
+  /**
+   * @brief Moment requested for the output, deposited to the `slot` component
+   * of the moments buffer
+   */
+  struct MomentOutput {
+    FldsID::type                id;
+    std::vector<unsigned short> comps;
+    std::vector<spidx_t>        species;
+    unsigned short              slot;
+  };
+
+  /**
+   * @brief Add the moments needed to output the field `fld` (one per component)
+   * @note For the bulk 3-velocity, the mass density used for the normalization
+   * is added as the 4-th component
+   */
+  template <SimEngine::type S>
+  void AddMomentOutputs(const out::OutputField&    fld,
+                        std::vector<MomentOutput>& moments) {
+    const auto add = [&](FldsID::type id, const std::vector<unsigned short>& comps) {
+      moments.push_back(
+        { id, comps, fld.species, static_cast<unsigned short>(moments.size()) });
+    };
+    if (fld.id() == FldsID::V and S == SimEngine::GRPIC) {
+      raise::Error("Bulk velocity not supported for GRPIC", HERE);
+    }
+    if (fld.comp.size() == 0 || fld.comp.size() == 1) { // scalar
+      if (fld.id() == FldsID::T or fld.id() == FldsID::V) {
+        raise::ErrorIf(fld.comp.size() != 1,
+                       "Wrong # of components requested for T output",
+                       HERE);
+        add(fld.id(), fld.comp[0]);
+      } else if (fld.id() == FldsID::Rho or fld.id() == FldsID::Charge or
+                 fld.id() == FldsID::N or fld.id() == FldsID::Nppc) {
+        add(fld.id(), {});
+      } else {
+        raise::Error("Wrong moment requested for output", HERE);
+      }
+    } else if (fld.comp.size() == 3) { // vector
+      for (auto i = 0; i < 3; ++i) {
+        if (fld.id() == FldsID::T) {
+          raise::ErrorIf(fld.comp[i].size() != 2,
+                         "Wrong # of components requested for moment",
+                         HERE);
+        } else if (fld.id() == FldsID::V) {
+          raise::ErrorIf(fld.comp[i].size() != 1,
+                         "Wrong # of components requested for 3vel",
+                         HERE);
+        } else {
+          raise::Error("Wrong moment requested for output", HERE);
         }
+        add(fld.id(), fld.comp[i]);
+      }
+      if (fld.id() == FldsID::V) {
+        add(FldsID::Rho, {});
+      }
+    } else if (fld.comp.size() == 6) { // tensor
+      for (auto i = 0; i < 6; ++i) {
+        raise::ErrorIf(fld.comp[i].size() != 2,
+                       "Wrong # of components requested for moment",
+                       HERE);
+        add(FldsID::T, fld.comp[i]);
       }
+    } else {
+      raise::Error("Wrong # of components requested for output", HERE);
     }
-    for (const auto& sp : specs) {
-      raise::ErrorIf((sp > prtl_species.size()) or (sp == 0),
-                     "Invalid species index " + std::to_string(sp),
+  }
+
+  /**
+   * @brief Deposit all the requested moments with a single sweep over the
+   * particles of each species
+   */
+  template <SimEngine::type S, class M>
+  void ComputeMoments(const SimulationParams& params,
+                      const Mesh<M>&          mesh,
+                      const std::vector<Particles<M::Dim, M::CoordType>>& prtl_species,
+                      const std::vector<MomentOutput>& moments,
+                      ndarray_t<M::Dim + 1>&           buffer) {
+    using kernel_t = kernel::ParticleMomentsBatch_kernel<S, M>;
+    for (const auto& moment : moments) {
+      raise::ErrorIf(moment.slot >= buffer.extent(M::Dim),
+                     "Invalid moments buffer index",
                      HERE);
+      for (const auto& sp : moment.species) {
+        raise::ErrorIf((sp > prtl_species.size()) or (sp == 0),
+                       "Invalid species index " + std::to_string(sp),
+                       HERE);
+      }
     }
     auto scatter_buff = Kokkos::Experimental::create_scatter_view(buffer);
 
@@ -147,26 +297,73 @@ namespace ntt {
     const auto window      = params.template get<unsigned short>(
       "output.fields.mom_smooth");
 
-    for (const auto& sp : specs) {
-      auto& prtl_spec = prtl_species[sp - 1];
-      // clang-format off
-      Kokkos::parallel_for(
-        "ComputeMoments",
-        prtl_spec.rangeActiveParticles(),
-        kernel::ParticleMoments_kernel<S, M, F, 6>(components, scatter_buff, buff_idx,
-                                                   prtl_spec.i1, prtl_spec.i2, prtl_spec.i3,
-                                                   prtl_spec.dx1, prtl_spec.dx2, prtl_spec.dx3,
-                                                   prtl_spec.ux1, prtl_spec.ux2, prtl_spec.ux3,
-                                                   prtl_spec.phi, prtl_spec.weight, prtl_spec.tag,
-                                                   prtl_spec.mass(), prtl_spec.charge(),
-                                                   use_weights,
-                                                   mesh.metric, mesh.flds_bc(),
-                                                   ni2, inv_n0, window));
-      // clang-format on
+    for (const auto& prtl_spec : prtl_species) {
+      // moments this species contributes to ...
+      // ... (if no species specified, take all massive species)
+      std::vector<kernel::MomentSpec> specs;
+      for (const auto& moment : moments) {
+        const auto contributes = moment.species.empty()
+                                   ? (prtl_spec.mass() > 0)
+                                   : (std::find(moment.species.begin(),
+                                                moment.species.end(),
+                                                prtl_spec.index()) !=
+                                      moment.species.end());
+        if (not contributes) {
+          continue;
+        }
+        kernel::MomentSpec spec;
+        spec.id       = moment.id;
+        spec.c1       = (moment.comps.size() > 0) ? moment.comps[0] : 0;
+        spec.c2       = (moment.comps.size() == 2) ? moment.comps[1] : 0;
+        spec.buff_idx = moment.slot;
+        specs.push_back(spec);
+      }
+      for (auto first { 0u }; first < specs.size(); first += kernel_t::MaxMoments) {
+        const auto last = std::min(first + kernel_t::MaxMoments,
+                                   static_cast<unsigned int>(specs.size()));
+        // clang-format off
+        Kokkos::parallel_for(
+          "ComputeMoments",
+          prtl_spec.rangeActiveParticles(),
+          kernel_t(std::vector<kernel::MomentSpec>(specs.begin() + first,
+                                                   specs.begin() + last),
+                   scatter_buff,
+                   prtl_spec.i1, prtl_spec.i2, prtl_spec.i3,
+                   prtl_spec.dx1, prtl_spec.dx2, prtl_spec.dx3,
+                   prtl_spec.ux1, prtl_spec.ux2, prtl_spec.ux3,
+                   prtl_spec.phi, prtl_spec.weight, prtl_spec.tag,
+                   prtl_spec.mass(), prtl_spec.charge(),
+                   use_weights,
+                   mesh.metric, mesh.flds_bc(),
+                   ni2, inv_n0, window));
+        // clang-format on
+      }
     }
     Kokkos::Experimental::contribute(buffer, scatter_buff);
   }
 
+  /**
+   * @brief Copy the component `from` of the moments buffer to the component
+   * `to` of a field
+   */
+  template <Dimension D, int N>
+  void CopyMoment(const ndarray_t<D + 1>& moments,
+                  unsigned short          from,
+                  ndfield_t<D, N>&        fld,
+                  std::size_t             to) {
+    if constexpr (D == Dim::_1D) {
+      Kokkos::deep_copy(Kokkos::subview(fld, Kokkos::ALL, to),
+                        Kokkos::subview(moments, Kokkos::ALL, from));
+    } else if constexpr (D == Dim::_2D) {
+      Kokkos::deep_copy(Kokkos::subview(fld, Kokkos::ALL, Kokkos::ALL, to),
+                        Kokkos::subview(moments, Kokkos::ALL, Kokkos::ALL, from));
+    } else if constexpr (D == Dim::_3D) {
+      Kokkos::deep_copy(
+        Kokkos::subview(fld, Kokkos::ALL, Kokkos::ALL, Kokkos::ALL, to),
+        Kokkos::subview(moments, Kokkos::ALL, Kokkos::ALL, Kokkos::ALL, from));
+    }
+  }
+
   template <Dimension D, int N, int M>
   void DeepCopyFields(ndfield_t<D, N>&     fld_from,
                       ndfield_t<D, M>&     fld_to,
@@ -192,6 +389,58 @@ namespace ntt {
     }
   }
 
+  /**
+   * @brief Bin the particles of the local domain into the histogram
+   * @note Uses team-local histograms when these fit into the scratch memory
+   * @note Field-aligned quantities use the cell-centered magnetic field (tetrad
+   * basis) which has to be prepared in `bckp(:, 3, 4, 5)`
+   */
+  template <SimEngine::type S, class M>
+  void ComputeHistogram(const out::OutputHistogram& hist,
+                        const Domain<S, M>&         domain,
+                        array_t<real_t*>&           counts) {
+    using kernel_t      = kernel::ParticleHistogram_kernel<S, M>;
+    const auto nbins    = hist.size();
+    const auto scratch  = kernel_t::scratch_size(nbins);
+    const auto use_team = scratch <= static_cast<std::size_t>(
+                                       team_policy_t::scratch_size_max(0));
+    const auto chunk    = kernel_t::chunk_size(nbins);
+    for (const auto& species : domain.species) {
+      // if no species specified, take all massive species
+      const auto binned = hist.species.empty()
+                            ? (species.mass() > 0)
+                            : (std::find(hist.species.begin(),
+                                         hist.species.end(),
+                                         species.index()) != hist.species.end());
+      if ((not binned) or (species.npart() == 0)) {
+        continue;
+      }
+      const auto npart = species.npart();
+      // clang-format off
+      const auto kernel = kernel_t(counts,
+                                   hist.axes, hist.n_bins, hist.min, hist.max, hist.log_bins,
+                                   species.i1, species.i2, species.i3,
+                                   species.dx1, species.dx2, species.dx3,
+                                   species.ux1, species.ux2, species.ux3,
+                                   species.phi, species.weight, species.tag,
+                                   species.mass(),
+                                   domain.fields.bckp, 3,
+                                   domain.mesh.metric,
+                                   npart, chunk);
+      // clang-format on
+      if (use_team) {
+        Kokkos::parallel_for("ParticleHistogram",
+                             team_policy_t((npart + chunk - 1) / chunk, Kokkos::AUTO)
+                               .set_scratch_size(0, Kokkos::PerTeam(scratch)),
+                             kernel);
+      } else {
+        Kokkos::parallel_for("ParticleHistogram",
+                             species.rangeActiveParticles(),
+                             kernel);
+      }
+    }
+  }
+
   template <SimEngine::type S, class M>
   void ComputeVectorPotential(ndfield_t<M::Dim, 6>& buffer,
                               ndfield_t<M::Dim, 6>& EM,
@@ -335,10 +584,6 @@ namespace ntt {
                        timestep_t,
                        simtime_t,
                        const Domain<S, M>&)> CustomFieldOutput) -> bool {
-    raise::ErrorIf(
-      l_subdomain_indices().size() != 1,
-      "Output for now is only supported for one subdomain per rank",
-      HERE);
     const auto write_fields = params.template get<bool>(
                                 "output.fields.enable") and
                               g_writer.shouldWrite("fields",
@@ -359,254 +604,323 @@ namespace ntt {
         extension != "disabled") {
       return false;
     }
-    auto local_domain = subdomain_ptr(l_subdomain_indices()[0]);
-    raise::ErrorIf(local_domain->is_placeholder(),
-                   "local_domain is a placeholder",
-                   HERE);
+    const auto local_domains = localDomains();
+    for (const auto* local_domain : local_domains) {
+      raise::ErrorIf(local_domain->is_placeholder(),
+                     "local_domain is a placeholder",
+                     HERE);
+    }
     logger::Checkpoint("Writing output", HERE);
     if (write_fields) {
       g_writer.beginWriting(WriteMode::Fields, current_step, current_time);
       const auto incl_ghosts = params.template get<bool>("output.debug.ghosts");
       const auto dwn         = params.template get<std::vector<unsigned int>>(
         "output.fields.downsampling");
+      // with box reductions the cell-centers are placed in the middle of boxes
+      const auto dwn_boxes = params.template get<std::string>(
+                               "output.fields.downsampling_mode") != "sample";
+
+      // meshblocks are registered in the order of the local domains
+      for (auto b { 0u }; b < local_domains.size(); ++b) {
+        const auto* local_domain = local_domains[b];
 
-      auto off_ncells_with_ghosts = local_domain->offset_ncells();
-      auto loc_shape_with_ghosts  = local_domain->mesh.n_active();
-      { // compute positions/sizes of meshblocks in cells in all dimensions
-        const auto off_ndomains = local_domain->offset_ndomains();
-        if (incl_ghosts) {
-          for (auto d { 0 }; d <= M::Dim; ++d) {
-            off_ncells_with_ghosts[d] += 2 * N_GHOSTS * off_ndomains[d];
-            loc_shape_with_ghosts[d]  += 2 * N_GHOSTS;
+        auto off_ncells_with_ghosts = local_domain->offset_ncells();
+        auto loc_shape_with_ghosts  = local_domain->mesh.n_active();
+        { // compute positions/sizes of meshblocks in cells in all dimensions
+          const auto off_ndomains = local_domain->offset_ndomains();
+          if (incl_ghosts) {
+            for (auto d { 0 }; d < M::Dim; ++d) {
+              off_ncells_with_ghosts[d] += 2 * N_GHOSTS * off_ndomains[d];
+              loc_shape_with_ghosts[d]  += 2 * N_GHOSTS;
+            }
           }
         }
-      }
-      for (auto dim { 0u }; dim < M::Dim; ++dim) {
-        const auto l_size   = local_domain->mesh.n_active()[dim];
-        const auto l_offset = local_domain->offset_ncells()[dim];
-        const auto g_size   = mesh().n_active()[dim];
+        for (auto dim { 0u }; dim < M::Dim; ++dim) {
+          const auto l_size   = local_domain->mesh.n_active()[dim];
+          const auto l_offset = local_domain->offset_ncells()[dim];
+          const auto g_size   = mesh().n_active()[dim];
 
-        const auto dwn_in_dim = dwn[dim];
+          const auto dwn_in_dim = dwn[dim];
 
-        const double n = l_size;
-        const double d = dwn_in_dim;
-        const double l = l_offset;
-        const double f = math::ceil(l / d) * d - l;
+          const double n = l_size;
+          const double d = dwn_in_dim;
+          const double l = l_offset;
+          const double f = math::ceil(l / d) * d - l;
 
-        const auto first_cell = static_cast<ncells_t>(f);
-        const auto l_size_dwn = static_cast<ncells_t>(math::ceil((n - f) / d));
+          const auto first_cell = static_cast<ncells_t>(f);
+          const auto l_size_dwn = static_cast<ncells_t>(math::ceil((n - f) / d));
 
-        const auto is_last = l_offset + l_size == g_size;
+          const auto is_last = l_offset + l_size == g_size;
 
-        const auto add_ghost = (incl_ghosts ? 2 * N_GHOSTS : 0);
-        const auto add_last  = (is_last ? 1 : 0);
+          const auto add_ghost = (incl_ghosts ? 2 * N_GHOSTS : 0);
+          const auto add_last  = (is_last ? 1 : 0);
 
-        array_t<real_t*> xc { "Xc", l_size_dwn + add_ghost };
-        array_t<real_t*> xe { "Xe", l_size_dwn + add_ghost + add_last };
+          array_t<real_t*> xc { "Xc", l_size_dwn + add_ghost };
+          array_t<real_t*> xe { "Xe", l_size_dwn + add_ghost + add_last };
 
-        const auto offset = (incl_ghosts ? N_GHOSTS : 0);
-        const auto ncells = l_size_dwn;
+          const auto offset = (incl_ghosts ? N_GHOSTS : 0);
+          const auto ncells = l_size_dwn;
 
-        const auto& metric = local_domain->mesh.metric;
+          const auto& metric = local_domain->mesh.metric;
 
-        Kokkos::parallel_for(
-          "GenerateMesh",
-          ncells,
-          Lambda(index_t i_dwn) {
-            const auto      i  = first_cell + i_dwn * dwn_in_dim;
-            const auto      i_ = static_cast<real_t>(i);
-            coord_t<M::Dim> x_Cd { ZERO }, x_Ph { ZERO };
-            x_Cd[dim] = i_ + HALF;
-            // TODO : change to convert by component
-            metric.template convert<Crd::Cd, Crd::Ph>(x_Cd, x_Ph);
-            xc(offset + i_dwn) = x_Ph[dim];
-            x_Cd[dim]          = i_;
-            metric.template convert<Crd::Cd, Crd::Ph>(x_Cd, x_Ph);
-            xe(offset + i_dwn) = x_Ph[dim];
-            if (is_last && i_dwn == ncells - 1) {
-              x_Cd[dim] = i_ + ONE;
+          Kokkos::parallel_for(
+            "GenerateMesh",
+            ncells,
+            Lambda(index_t i_dwn) {
+              const auto i  = first_cell + i_dwn * dwn_in_dim;
+              const auto i_ = static_cast<real_t>(i);
+              const auto w_ = dwn_boxes ? static_cast<real_t>(math::min(
+                                            static_cast<ncells_t>(dwn_in_dim),
+                                            static_cast<ncells_t>(l_size - i)))
+                                        : ONE;
+              coord_t<M::Dim> x_Cd { ZERO }, x_Ph { ZERO };
+              x_Cd[dim] = i_ + HALF * w_;
+              // TODO : change to convert by component
               metric.template convert<Crd::Cd, Crd::Ph>(x_Cd, x_Ph);
-              xe(offset + i_dwn + 1) = x_Ph[dim];
-            }
-          });
-        g_writer.writeMesh(
-          dim,
-          xc,
-          xe,
-          { off_ncells_with_ghosts[dim], loc_shape_with_ghosts[dim] });
+              xc(offset + i_dwn) = x_Ph[dim];
+              x_Cd[dim]          = i_;
+              metric.template convert<Crd::Cd, Crd::Ph>(x_Cd, x_Ph);
+              xe(offset + i_dwn) = x_Ph[dim];
+              if (is_last && i_dwn == ncells - 1) {
+                x_Cd[dim] = i_ + ONE;
+                metric.template convert<Crd::Cd, Crd::Ph>(x_Cd, x_Ph);
+                xe(offset + i_dwn + 1) = x_Ph[dim];
+              }
+            });
+          g_writer.writeMesh(
+            dim,
+            xc,
+            xe,
+            { off_ncells_with_ghosts[dim], loc_shape_with_ghosts[dim] },
+            b);
+        }
+      }
+      const auto  output_asis = params.template get<bool>("output.debug.as_is");
+      const auto& fld_writers = g_writer.fieldWriters();
+
+      // all the requested moments are deposited at once into a wider buffer ...
+      // ... with a single sweep over the particles of each species
+      std::vector<MomentOutput>          moments;
+      std::vector<unsigned short>        moment_slots(fld_writers.size(), 0);
+      std::vector<ndarray_t<M::Dim + 1>> moment_buffs;
+      for (auto f { 0u }; f < fld_writers.size(); ++f) {
+        if (fld_writers[f].is_moment()) {
+          moment_slots[f] = static_cast<unsigned short>(moments.size());
+          AddMomentOutputs<S>(fld_writers[f], moments);
+        }
+      }
+      if (not moments.empty()) {
+        for (auto* local_domain : local_domains) {
+          const auto& bckp = local_domain->fields.bckp;
+          if constexpr (M::Dim == Dim::_1D) {
+            moment_buffs.emplace_back("moments", bckp.extent(0), moments.size());
+          } else if constexpr (M::Dim == Dim::_2D) {
+            moment_buffs.emplace_back("moments",
+                                      bckp.extent(0),
+                                      bckp.extent(1),
+                                      moments.size());
+          } else if constexpr (M::Dim == Dim::_3D) {
+            moment_buffs.emplace_back("moments",
+                                      bckp.extent(0),
+                                      bckp.extent(1),
+                                      bckp.extent(2),
+                                      moments.size());
+          }
+          ComputeMoments<S, M>(params,
+                               local_domain->mesh,
+                               local_domain->species,
+                               moments,
+                               moment_buffs.back());
+        }
       }
-      const auto output_asis = params.template get<bool>("output.debug.as_is");
+
       // !TODO: this can probably be optimized to dump things at once
-      for (auto& fld : g_writer.fieldWriters()) {
-        Kokkos::deep_copy(local_domain->fields.bckp, ZERO);
+      for (auto f { 0u }; f < fld_writers.size(); ++f) {
+        const auto& fld = fld_writers[f];
         std::vector<std::string> names;
         std::vector<std::size_t> addresses;
         if (fld.comp.size() == 0 || fld.comp.size() == 1) { // scalar
           names.push_back(fld.name());
           addresses.push_back(0);
-          if (fld.is_moment()) {
-            // output a particle distribution moment (single component)
-            // this includes T, Rho, Charge, N, Nppc
-            const auto c = static_cast<idx_t>(addresses.back());
-            if (fld.id() == FldsID::T) {
-              raise::ErrorIf(fld.comp.size() != 1,
-                             "Wrong # of components requested for T output",
+        } else if (fld.comp.size() == 3) { // vector
+          for (auto i = 0; i < 3; ++i) {
+            names.push_back(fld.name(i));
+            addresses.push_back(i + 3);
+          }
+        } else if (fld.comp.size() == 6) { // tensor
+          raise::ErrorIf(not fld.is_moment() or fld.id() != FldsID::T,
+                         "Only T tensor has 6 components",
+                         HERE);
+          for (auto i = 0; i < 6; ++i) {
+            names.push_back(fld.name(i));
+            addresses.push_back(i);
+          }
+        } else {
+          raise::Error("Wrong # of components requested for output", HERE);
+        }
+        // moments/scalars are computed in each local domain first, and then
+        // synchronized across all the domains at once
+        for (auto b { 0u }; b < local_domains.size(); ++b) {
+          auto* local_domain = local_domains[b];
+          Kokkos::deep_copy(local_domain->fields.bckp, ZERO);
+          if (fld.comp.size() == 0 || fld.comp.size() == 1) { // scalar
+            if (fld.is_moment()) {
+              // output a particle distribution moment (single component)
+              // this includes T, Rho, Charge, N, Nppc
+              CopyMoment<M::Dim, 6>(moment_buffs[b],
+                                    moment_slots[f],
+                                    local_domain->fields.bckp,
+                                    addresses.back());
+            } else if (fld.is_divergence()) {
+              // @TODO: is this correct for GR too? not em0?
+              const auto c = static_cast<idx_t>(addresses.back());
+              Kokkos::parallel_for(
+                "ComputeDivergence",
+                local_domain->mesh.rangeActiveCells(),
+                kernel::ComputeDivergence_kernel<M, 6>(local_domain->mesh.metric,
+                                                       local_domain->fields.em,
+                                                       local_domain->fields.bckp,
+                                                       c));
+            } else if (fld.is_custom()) {
+              if (CustomFieldOutput) {
+                CustomFieldOutput(fld.name().substr(1),
+                                  local_domain->fields.bckp,
+                                  addresses.back(),
+                                  finished_step,
+                                  finished_time,
+                                  *local_domain);
+              } else {
+                raise::Error("Custom output requested but no function provided",
                              HERE);
-              ComputeMoments<S, M, FldsID::T>(params,
-                                              local_domain->mesh,
-                                              local_domain->species,
-                                              fld.species,
-                                              fld.comp[0],
-                                              local_domain->fields.bckp,
-                                              c);
-            } else if (fld.id() == FldsID::Rho) {
-              ComputeMoments<S, M, FldsID::Rho>(params,
-                                                local_domain->mesh,
-                                                local_domain->species,
-                                                fld.species,
-                                                {},
-                                                local_domain->fields.bckp,
-                                                c);
-            } else if (fld.id() == FldsID::Charge) {
-              ComputeMoments<S, M, FldsID::Charge>(params,
-                                                   local_domain->mesh,
-                                                   local_domain->species,
-                                                   fld.species,
-                                                   {},
-                                                   local_domain->fields.bckp,
-                                                   c);
-            } else if (fld.id() == FldsID::N) {
-              ComputeMoments<S, M, FldsID::N>(params,
-                                              local_domain->mesh,
-                                              local_domain->species,
-                                              fld.species,
-                                              {},
-                                              local_domain->fields.bckp,
-                                              c);
-            } else if (fld.id() == FldsID::Nppc) {
-              ComputeMoments<S, M, FldsID::Nppc>(params,
-                                                 local_domain->mesh,
-                                                 local_domain->species,
-                                                 fld.species,
-                                                 {},
-                                                 local_domain->fields.bckp,
-                                                 c);
-            } else if (fld.id() == FldsID::V) {
-              if constexpr (S != SimEngine::GRPIC) {
-                ComputeMoments<S, M, FldsID::V>(params,
-                                                local_domain->mesh,
-                                                local_domain->species,
-                                                fld.species,
-                                                fld.comp[0],
-                                                local_domain->fields.bckp,
-                                                c);
+              }
+            } else if (fld.is_vpotential()) {
+              if constexpr (S == SimEngine::GRPIC && M::Dim == Dim::_2D) {
+                const auto c = static_cast<unsigned short>(addresses.back());
+                ComputeVectorPotential<S, M>(local_domain->fields.bckp,
+                                             local_domain->fields.em,
+                                             c,
+                                             local_domain->mesh);
+#if defined(MPI_ENABLED)
+                CommunicateVectorPotential(c);
+#endif
               } else {
-                raise::Error("Bulk velocity not supported for GRPIC", HERE);
+                raise::Error(
+                  "Vector potential can only be computed for GRPIC in 2D",
+                  HERE);
               }
             } else {
-              raise::Error("Wrong moment requested for output", HERE);
-            }
-          } else if (fld.is_divergence()) {
-            // @TODO: is this correct for GR too? not em0?
-            const auto c = static_cast<idx_t>(addresses.back());
-            Kokkos::parallel_for(
-              "ComputeDivergence",
-              local_domain->mesh.rangeActiveCells(),
-              kernel::ComputeDivergence_kernel<M, 6>(local_domain->mesh.metric,
-                                                     local_domain->fields.em,
-                                                     local_domain->fields.bckp,
-                                                     c));
-          } else if (fld.is_custom()) {
-            if (CustomFieldOutput) {
-              CustomFieldOutput(fld.name().substr(1),
-                                local_domain->fields.bckp,
-                                addresses.back(),
-                                finished_step,
-                                finished_time,
-                                *local_domain);
-            } else {
-              raise::Error("Custom output requested but no function provided",
+              raise::Error("Wrong # of components requested for "
+                           "non-moment/non-custom output",
                            HERE);
             }
-          } else if (fld.is_vpotential()) {
-            if constexpr (S == SimEngine::GRPIC && M::Dim == Dim::_2D) {
-              const auto c = static_cast<unsigned short>(addresses.back());
-              ComputeVectorPotential<S, M>(local_domain->fields.bckp,
-                                           local_domain->fields.em,
-                                           c,
-                                           local_domain->mesh);
-#if defined(MPI_ENABLED)
-              CommunicateVectorPotential(c);
-#endif
+          } else if (fld.comp.size() == 3) { // vector
+            if (fld.is_moment()) {
+              for (auto i = 0; i < 3; ++i) {
+                CopyMoment<M::Dim, 6>(moment_buffs[b],
+                                      moment_slots[f] + i,
+                                      local_domain->fields.bckp,
+                                      addresses[i]);
+              }
+              if (fld.id() == FldsID::V) {
+                // rho for the normalization
+                CopyMoment<M::Dim, 6>(moment_buffs[b],
+                                      moment_slots[f] + 3,
+                                      local_domain->fields.bckp,
+                                      0);
+              }
             } else {
-              raise::Error(
-                "Vector potential can only be computed for GRPIC in 2D",
-                HERE);
-            }
-          } else {
-            raise::Error("Wrong # of components requested for "
-                         "non-moment/non-custom output",
-                         HERE);
-          }
-          SynchronizeFields(*local_domain,
-                            Comm::Bckp,
-                            { addresses.back(), addresses.back() + 1 });
-        } else if (fld.comp.size() == 3) { // vector
-          for (auto i = 0; i < 3; ++i) {
-            names.push_back(fld.name(i));
-            addresses.push_back(i + 3);
-          }
-          if (fld.is_moment()) {
-            for (auto i = 0; i < 3; ++i) {
-              const auto c = static_cast<idx_t>(addresses[i]);
-              if (fld.id() == FldsID::T) {
-                raise::ErrorIf(fld.comp[i].size() != 2,
-                               "Wrong # of components requested for moment",
-                               HERE);
-                ComputeMoments<S, M, FldsID::T>(params,
-                                                local_domain->mesh,
-                                                local_domain->species,
-                                                fld.species,
-                                                fld.comp[i],
-                                                local_domain->fields.bckp,
-                                                c);
-              } else if (fld.id() == FldsID::V) {
-                raise::ErrorIf(fld.comp[i].size() != 1,
-                               "Wrong # of components requested for 3vel",
-                               HERE);
-                if constexpr (S == SimEngine::SRPIC) {
-                  ComputeMoments<S, M, FldsID::V>(params,
-                                                  local_domain->mesh,
-                                                  local_domain->species,
-                                                  fld.species,
-                                                  fld.comp[i],
-                                                  local_domain->fields.bckp,
-                                                  c);
+              // copy fields to bckp (:, 0, 1, 2)
+              // if as-is specified ==> copy directly to 3, 4, 5
+              range_tuple_t copy_to = { 0, 3 };
+              if (output_asis) {
+                copy_to = { 3, 6 };
+              }
+              if (fld.is_current()) {
+                DeepCopyFields<M::Dim, 3, 6>(local_domain->fields.cur,
+                                             local_domain->fields.bckp,
+                                             { cur::jx1, cur::jx3 + 1 },
+                                             copy_to);
+              } else if (fld.is_field()) {
+                if (S == SimEngine::GRPIC && fld.is_gr_aux_field()) {
+                  if (fld.is_efield()) {
+                    // GR: E
+                    DeepCopyFields<M::Dim, 6, 6>(local_domain->fields.aux,
+                                                 local_domain->fields.bckp,
+                                                 { em::ex1, em::ex3 + 1 },
+                                                 copy_to);
+                  } else {
+                    // GR: H
+                    DeepCopyFields<M::Dim, 6, 6>(local_domain->fields.aux,
+                                                 local_domain->fields.bckp,
+                                                 { em::hx1, em::hx3 + 1 },
+                                                 copy_to);
+                  }
                 } else {
-                  raise::Error("Bulk velocity not supported for GRPIC", HERE);
+                  if (fld.is_efield()) {
+                    // GR/SR: D/E
+                    DeepCopyFields<M::Dim, 6, 6>(local_domain->fields.em,
+                                                 local_domain->fields.bckp,
+                                                 { em::ex1, em::ex3 + 1 },
+                                                 copy_to);
+                  } else {
+                    // GR/SR: B
+                    DeepCopyFields<M::Dim, 6, 6>(local_domain->fields.em,
+                                                 local_domain->fields.bckp,
+                                                 { em::bx1, em::bx3 + 1 },
+                                                 copy_to);
+                  }
                 }
               } else {
-                raise::Error("Wrong moment requested for output", HERE);
+                raise::Error("Wrong field requested for output", HERE);
+              }
+              if (not output_asis) {
+                // copy fields from bckp(:, 0, 1, 2) -> bckp(:, 3, 4, 5)
+                // converting to proper basis and properly interpolating
+                list_t<idx_t, 3> comp_from = { 0, 1, 2 };
+                list_t<idx_t, 3> comp_to   = { 3, 4, 5 };
+                DeepCopyFields<M::Dim, 6, 6>(local_domain->fields.bckp,
+                                             local_domain->fields.bckp,
+                                             { 0, 3 },
+                                             { 3, 6 });
+                Kokkos::parallel_for("FieldsToPhys",
+                                     local_domain->mesh.rangeActiveCells(),
+                                     kernel::FieldsToPhys_kernel<M, 6, 6>(
+                                       local_domain->fields.bckp,
+                                       local_domain->fields.bckp,
+                                       comp_from,
+                                       comp_to,
+                                       fld.interp_flag | fld.prepare_flag,
+                                       local_domain->mesh.metric));
               }
             }
-            raise::ErrorIf(addresses[1] - addresses[0] !=
-                             addresses[2] - addresses[1],
-                           "Indices for the backup are not contiguous",
-                           HERE);
-            SynchronizeFields(*local_domain,
-                              Comm::Bckp,
-                              { addresses[0], addresses[2] + 1 });
-            if constexpr (S == SimEngine::SRPIC) {
-              if (fld.id() == FldsID::V) {
-                // normalize 3vel * rho (combuted above) by rho
-                ComputeMoments<S, M, FldsID::Rho>(params,
-                                                  local_domain->mesh,
-                                                  local_domain->species,
-                                                  fld.species,
-                                                  {},
-                                                  local_domain->fields.bckp,
-                                                  0u);
-                SynchronizeFields(*local_domain, Comm::Bckp, { 0, 1 });
+          } else { // tensor
+            for (auto i = 0; i < 6; ++i) {
+              CopyMoment<M::Dim, 6>(moment_buffs[b],
+                                    moment_slots[f] + i,
+                                    local_domain->fields.bckp,
+                                    addresses[i]);
+            }
+          }
+        } // local domain loop
+
+        if (fld.comp.size() == 0 || fld.comp.size() == 1) {
+          SynchronizeFields(Comm::Bckp,
+                            { addresses.back(), addresses.back() + 1 });
+        } else if (fld.comp.size() == 3 and fld.is_moment()) {
+          raise::ErrorIf(addresses[1] - addresses[0] !=
+                           addresses[2] - addresses[1],
+                         "Indices for the backup are not contiguous",
+                         HERE);
+          if (fld.id() == FldsID::V) {
+            // rho (used for the normalization) is in component 0
+            SynchronizeFields(Comm::Bckp, { 0, addresses[2] + 1 });
+          } else {
+            SynchronizeFields(Comm::Bckp, { addresses[0], addresses[2] + 1 });
+          }
+          if constexpr (S == SimEngine::SRPIC) {
+            if (fld.id() == FldsID::V) {
+              // normalize 3vel * rho (computed above) by rho
+              for (auto* local_domain : local_domains) {
                 Kokkos::parallel_for("NormalizeVectorByRho",
                                      local_domain->mesh.rangeActiveCells(),
                                      kernel::NormalizeVectorByRho_kernel<M::Dim, 6>(
@@ -618,113 +932,66 @@ namespace ntt {
                                        addresses[2]));
               }
             }
-          } else {
-            // copy fields to bckp (:, 0, 1, 2)
-            // if as-is specified ==> copy directly to 3, 4, 5
-            range_tuple_t copy_to = { 0, 3 };
-            if (output_asis) {
-              copy_to = { 3, 6 };
-            }
-            if (fld.is_current()) {
-              DeepCopyFields<M::Dim, 3, 6>(local_domain->fields.cur,
-                                           local_domain->fields.bckp,
-                                           { cur::jx1, cur::jx3 + 1 },
-                                           copy_to);
-            } else if (fld.is_field()) {
-              if (S == SimEngine::GRPIC && fld.is_gr_aux_field()) {
-                if (fld.is_efield()) {
-                  // GR: E
-                  DeepCopyFields<M::Dim, 6, 6>(local_domain->fields.aux,
-                                               local_domain->fields.bckp,
-                                               { em::ex1, em::ex3 + 1 },
-                                               copy_to);
-                } else {
-                  // GR: H
-                  DeepCopyFields<M::Dim, 6, 6>(local_domain->fields.aux,
-                                               local_domain->fields.bckp,
-                                               { em::hx1, em::hx3 + 1 },
-                                               copy_to);
-                }
-              } else {
-                if (fld.is_efield()) {
-                  // GR/SR: D/E
-                  DeepCopyFields<M::Dim, 6, 6>(local_domain->fields.em,
-                                               local_domain->fields.bckp,
-                                               { em::ex1, em::ex3 + 1 },
-                                               copy_to);
-                } else {
-                  // GR/SR: B
-                  DeepCopyFields<M::Dim, 6, 6>(local_domain->fields.em,
-                                               local_domain->fields.bckp,
-                                               { em::bx1, em::bx3 + 1 },
-                                               copy_to);
-                }
-              }
-            } else {
-              raise::Error("Wrong field requested for output", HERE);
-            }
-            if (not output_asis) {
-              // copy fields from bckp(:, 0, 1, 2) -> bckp(:, 3, 4, 5)
-              // converting to proper basis and properly interpolating
-              list_t<idx_t, 3> comp_from = { 0, 1, 2 };
-              list_t<idx_t, 3> comp_to   = { 3, 4, 5 };
-              DeepCopyFields<M::Dim, 6, 6>(local_domain->fields.bckp,
-                                           local_domain->fields.bckp,
-                                           { 0, 3 },
-                                           { 3, 6 });
-              Kokkos::parallel_for("FieldsToPhys",
-                                   local_domain->mesh.rangeActiveCells(),
-                                   kernel::FieldsToPhys_kernel<M, 6, 6>(
-                                     local_domain->fields.bckp,
-                                     local_domain->fields.bckp,
-                                     comp_from,
-                                     comp_to,
-                                     fld.interp_flag | fld.prepare_flag,
-                                     local_domain->mesh.metric));
-            }
           }
-        } else if (fld.comp.size() == 6) { // tensor
-          raise::ErrorIf(not fld.is_moment() or fld.id() != FldsID::T,
-                         "Only T tensor has 6 components",
-                         HERE);
-          for (auto i = 0; i < 6; ++i) {
-            names.push_back(fld.name(i));
-            addresses.push_back(i);
-            const auto c = static_cast<idx_t>(addresses.back());
-            raise::ErrorIf(fld.comp[i].size() != 2,
-                           "Wrong # of components requested for moment",
-                           HERE);
-            ComputeMoments<S, M, FldsID::T>(params,
-                                            local_domain->mesh,
-                                            local_domain->species,
-                                            fld.species,
-                                            fld.comp[i],
-                                            local_domain->fields.bckp,
-                                            c);
-          }
-          SynchronizeFields(*local_domain,
-                            Comm::Bckp,
-                            { addresses[0], addresses[5] + 1 });
-        } else {
-          raise::Error("Wrong # of components requested for output", HERE);
+        } else if (fld.comp.size() == 6) {
+          SynchronizeFields(Comm::Bckp, { addresses[0], addresses[5] + 1 });
+        }
+        for (auto b { 0u }; b < local_domains.size(); ++b) {
+          g_writer.writeField<M::Dim, 6>(names,
+                                         local_domains[b]->fields.bckp,
+                                         addresses,
+                                         b);
         }
-        g_writer.writeField<M::Dim, 6>(names, local_domain->fields.bckp, addresses);
       }
       g_writer.endWriting(WriteMode::Fields);
     } // end shouldWrite("fields", step, time)
 
     if (write_particles) {
       g_writer.beginWriting(WriteMode::Particles, current_step, current_time);
-      const auto prtl_stride = params.template get<npart_t>(
-        "output.particles.stride");
+      kernel::PrtlSelection selection;
+      selection.stride = params.template get<npart_t>("output.particles.stride");
+      const auto box   = params.template get<std::vector<std::vector<real_t>>>(
+        "output.particles.box");
+      for (auto d { 0u }; d < box.size(); ++d) {
+        selection.x_min[d] = box[d][0];
+        selection.x_max[d] = box[d][1];
+      }
+      selection.e_min = params.template get<real_t>("output.particles.e_min");
+      selection.e_max = params.template get<real_t>("output.particles.e_max");
+      const auto counter = params.template get<std::vector<npart_t>>(
+        "output.particles.counter");
+      if (counter.size() == 2) {
+        selection.ctr_min = counter[0];
+        selection.ctr_max = counter[1];
+      }
+      const auto prtl_packed = params.template get<bool>(
+        "output.particles.packed");
       for (const auto spec : g_writer.speciesIndices()) {
-        local_domain->species[spec - 1].template OutputWrite<S, M>(
-          g_writer.io(),
-          g_writer.writer(),
-          prtl_stride,
-          ndomains(),
-          local_domain->index(),
-          local_domain->mesh.metric);
+        // particles are selected once; the counts give the offsets of each
+        // domain in the global particle arrays
+        std::vector<array_t<npart_t*>> out_indices;
+        std::vector<npart_t>           nout_local;
+        for (auto* local_domain : local_domains) {
+          const auto [indices, nout] = local_domain->species[spec - 1]
+                                         .template OutputSelect<S, M>(
+                                           selection,
+                                           local_domain->mesh.metric);
+          out_indices.push_back(indices);
+          nout_local.push_back(nout);
+        }
+        const auto [nout_offsets, nout_total] = gatherDomainOffsets(nout_local);
+        for (auto i { 0u }; i < local_domains.size(); ++i) {
+          local_domains[i]->species[spec - 1].template OutputWrite<S, M>(
+            g_writer.io(),
+            g_writer.writer(),
+            selection,
+            out_indices[i],
+            nout_local[i],
+            prtl_packed,
+            nout_total,
+            nout_offsets[i],
+            local_domains[i]->mesh.metric);
+        }
       }
       g_writer.endWriting(WriteMode::Particles);
     } // end shouldWrite("particles", step, time)
@@ -753,47 +1020,102 @@ namespace ntt {
           }
         });
       for (const auto& spec : g_writer.spectraWriters()) {
-        auto&            species = local_domain->species[spec.species() - 1];
         array_t<real_t*> dn { "dn", n_bins };
-        auto       dn_scatter = Kokkos::Experimental::create_scatter_view(dn);
-        auto       ux1        = species.ux1;
-        auto       ux2        = species.ux2;
-        auto       ux3        = species.ux3;
-        auto       weight     = species.weight;
-        auto       tag        = species.tag;
-        const auto is_massive = species.mass() > 0.0f;
-        Kokkos::parallel_for(
-          "ComputeSpectra",
-          species.rangeActiveParticles(),
-          Lambda(index_t p) {
-            if (tag(p) != ParticleTag::alive) {
-              return;
-            }
-            real_t en;
-            if (is_massive) {
-              en = U2GAMMA(ux1(p), ux2(p), ux3(p)) - ONE;
-            } else {
-              en = NORM(ux1(p), ux2(p), ux3(p));
-            }
-            if (log_bins) {
-              en = math::log10(en);
-            }
-            std::size_t e_ind = 0;
-            if (en <= e_min) {
-              e_ind = 0;
-            } else if (en >= e_max) {
-              e_ind = n_bins;
-            } else {
-              e_ind = static_cast<std::size_t>(
-                static_cast<real_t>(n_bins) * (en - e_min) / (e_max - e_min));
-            }
-            auto dn_acc    = dn_scatter.access();
-            dn_acc(e_ind) += weight(p);
-          });
-        Kokkos::Experimental::contribute(dn, dn_scatter);
+        // accumulate the spectrum over all the local domains
+        for (const auto* local_domain : local_domains) {
+          auto& species = local_domain->species[spec.species() - 1];
+          auto  dn_scatter = Kokkos::Experimental::create_scatter_view(dn);
+          auto       ux1        = species.ux1;
+          auto       ux2        = species.ux2;
+          auto       ux3        = species.ux3;
+          auto       weight     = species.weight;
+          auto       tag        = species.tag;
+          const auto is_massive = species.mass() > 0.0f;
+          Kokkos::parallel_for(
+            "ComputeSpectra",
+            species.rangeActiveParticles(),
+            Lambda(index_t p) {
+              if (tag(p) != ParticleTag::alive) {
+                return;
+              }
+              real_t en;
+              if (is_massive) {
+                en = U2GAMMA(ux1(p), ux2(p), ux3(p)) - ONE;
+              } else {
+                en = NORM(ux1(p), ux2(p), ux3(p));
+              }
+              if (log_bins) {
+                en = math::log10(en);
+              }
+              std::size_t e_ind = 0;
+              if (en <= e_min) {
+                e_ind = 0;
+              } else if (en >= e_max) {
+                e_ind = n_bins;
+              } else {
+                e_ind = static_cast<std::size_t>(
+                  static_cast<real_t>(n_bins) * (en - e_min) / (e_max - e_min));
+              }
+              auto dn_acc    = dn_scatter.access();
+              dn_acc(e_ind) += weight(p);
+            });
+          Kokkos::Experimental::contribute(dn, dn_scatter);
+        }
         g_writer.writeSpectrum(dn, spec.name());
       }
       g_writer.writeSpectrumBins(energy, "sEbn");
+
+      // generic histograms (summed over all the local domains)
+      const auto&                   histograms = g_writer.histogramWriters();
+      std::vector<array_t<real_t*>> hist_counts;
+      auto                          need_b = false;
+      for (const auto& hist : histograms) {
+        hist_counts.emplace_back(hist.name(), hist.size());
+        need_b |= hist.is_field_aligned();
+      }
+      if (not histograms.empty()) {
+        for (auto* local_domain : local_domains) {
+          if (need_b) {
+            // cell-centered magnetic field in the tetrad basis -> bckp(:, 3, 4, 5)
+            DeepCopyFields<M::Dim, 6, 6>(local_domain->fields.em,
+                                         local_domain->fields.bckp,
+                                         { em::bx1, em::bx3 + 1 },
+                                         { 0, 3 });
+            Kokkos::parallel_for("FieldsToPhys",
+                                 local_domain->mesh.rangeActiveCells(),
+                                 kernel::FieldsToPhys_kernel<M, 6, 6>(
+                                   local_domain->fields.bckp,
+                                   local_domain->fields.bckp,
+                                   { 0, 1, 2 },
+                                   { 3, 4, 5 },
+                                   PrepareOutput::InterpToCellCenterFromFaces |
+                                     PrepareOutput::ConvertToHat,
+                                   local_domain->mesh.metric));
+          }
+          for (auto h { 0u }; h < histograms.size(); ++h) {
+            ComputeHistogram<S, M>(histograms[h], *local_domain, hist_counts[h]);
+          }
+        }
+      }
+      for (auto h { 0u }; h < histograms.size(); ++h) {
+        const auto& hist = histograms[h];
+        g_writer.writeHistogram(hist_counts[h], hist);
+        for (auto d { 0u }; d < hist.axes.size(); ++d) {
+          const auto n_edges  = hist.n_bins[d];
+          const auto log_edge = hist.log_bins[d];
+          const auto v_min    = log_edge ? math::log10(hist.min[d]) : hist.min[d];
+          const auto v_max    = log_edge ? math::log10(hist.max[d]) : hist.max[d];
+          array_t<real_t*> edges { "edges", n_edges + 1 };
+          Kokkos::parallel_for(
+            "GenerateHistogramBins",
+            n_edges + 1,
+            Lambda(index_t e) {
+              const auto v = v_min + (v_max - v_min) * e / n_edges;
+              edges(e)     = log_edge ? math::pow(10.0, v) : v;
+            });
+          g_writer.writeSpectrumBins(edges, hist.binsName(d));
+        }
+      }
       g_writer.endWriting(WriteMode::Spectra);
     } // end shouldWrite("spectra", step, time)
 
@@ -803,6 +1125,7 @@ namespace ntt {
 #define METADOMAIN_OUTPUT(S, M, D)                                              \
   template void Metadomain<S, M<D>>::InitWriter(adios2::ADIOS*,                \
                                                 const SimulationParams&);      \
+  template void Metadomain<S, M<D>>::resetOutputMeshBlocks();                  \
   template auto Metadomain<S, M<D>>::Write(                                    \
     const SimulationParams&,                                                   \
     timestep_t,                                                                \
@@ -0,0 +1,441 @@
+#include "enums.h"
+#include "global.h"
+
+#include "arch/directions.h"
+#include "arch/kokkos_aliases.h"
+#include "arch/mpi_aliases.h"
+#include "arch/mpi_tags.h"
+#include "utils/error.h"
+#include "utils/formatting.h"
+#include "utils/log.h"
+
+#include "metrics/kerr_schild.h"
+#include "metrics/kerr_schild_0.h"
+#include "metrics/minkowski.h"
+#include "metrics/qkerr_schild.h"
+#include "metrics/qspherical.h"
+#include "metrics/spherical.h"
+
+#include "framework/domain/comm_mpi.hpp"
+#include "framework/domain/metadomain.h"
+#include "framework/domain/rebalance.hpp"
+#include "framework/specialization_registry.h"
+
+#include <Kokkos_Core.hpp>
+#include <mpi.h>
+
+#include <algorithm>
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace ntt {
+
+  /**
+   * @brief Copy the components `comps` of the `src_slice` of `src` into the
+   * `dst_slice` of `dst`
+   */
+  template <Dimension D, int N>
+  void CopyFieldSlice(ndfield_t<D, N>&                  dst,
+                      const std::vector<range_tuple_t>& dst_slice,
+                      const ndfield_t<D, N>&            src,
+                      const std::vector<range_tuple_t>& src_slice,
+                      const range_tuple_t&              comps) {
+    if constexpr (D == Dim::_1D) {
+      Kokkos::deep_copy(Kokkos::subview(dst, dst_slice[0], comps),
+                        Kokkos::subview(src, src_slice[0], comps));
+    } else if constexpr (D == Dim::_2D) {
+      Kokkos::deep_copy(Kokkos::subview(dst, dst_slice[0], dst_slice[1], comps),
+                        Kokkos::subview(src, src_slice[0], src_slice[1], comps));
+    } else if constexpr (D == Dim::_3D) {
+      Kokkos::deep_copy(
+        Kokkos::subview(dst, dst_slice[0], dst_slice[1], dst_slice[2], comps),
+        Kokkos::subview(src, src_slice[0], src_slice[1], src_slice[2], comps));
+    }
+  }
+
+  /**
+   * @brief Move the active cells of a field from the old to the new layout
+   * @param field pointer to the field member of `Fields`
+   * @note Each new domain overlaps with the old domain of the same index and
+   * its neighbors; overlaps between domains of the same rank are copied
+   * directly, the rest are exchanged with non-blocking MPI calls
+   */
+  template <SimEngine::type S, class M, int N>
+  void MigrateField(ndfield_t<M::Dim, N> Fields<M::Dim, S>::*field,
+                    std::vector<Domain<S, M>>&              old_domains,
+                    std::vector<Domain<S, M>>&              new_domains,
+                    const std::vector<unsigned int>&        local_indices,
+                    const std::vector<unsigned int>&        slots,
+                    CommBufferPool&                         pool) {
+    constexpr auto D = M::Dim;
+    int            rank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    const auto nslots = (int)(*std::max_element(slots.begin(), slots.end())) + 1;
+    const auto comps  = range_tuple_t(0, N);
+    {
+      void* tag_ub_ptr = nullptr;
+      int   flag       = 0;
+      MPI_Comm_get_attr(MPI_COMM_WORLD, MPI_TAG_UB, &tag_ub_ptr, &flag);
+      raise::ErrorIf(flag and (nslots * nslots > *static_cast<int*>(tag_ub_ptr)),
+                     "Too many domains per rank to rebalance",
+                     HERE);
+    }
+
+    // overlap of the active cells of two domains (in local coordinates of both)
+    const auto overlap = [](const Domain<S, M>& from, const Domain<S, M>& to)
+      -> std::pair<std::vector<range_tuple_t>, std::vector<range_tuple_t>> {
+      std::vector<range_tuple_t> from_slice, to_slice;
+      for (auto d { 0u }; d < (unsigned int)D; ++d) {
+        const auto from_min = from.offset_ncells()[d];
+        const auto from_max = from_min + from.mesh.n_active()[d];
+        const auto to_min   = to.offset_ncells()[d];
+        const auto to_max   = to_min + to.mesh.n_active()[d];
+        const auto xmin     = std::max(from_min, to_min);
+        const auto xmax     = std::min(from_max, to_max);
+        if (xmin >= xmax) {
+          return {};
+        }
+        from_slice.push_back({ xmin - from_min + N_GHOSTS, xmax - from_min + N_GHOSTS });
+        to_slice.push_back({ xmin - to_min + N_GHOSTS, xmax - to_min + N_GHOSTS });
+      }
+      return { from_slice, to_slice };
+    };
+    // the old domain itself & its neighbors (the grid of domains is unchanged)
+    const auto candidates = [&](unsigned int idx) {
+      std::set<unsigned int> indices { idx };
+      for (const auto& direction : dir::Directions<D>::all) {
+        indices.insert(new_domains[idx].neighbor_idx_in(direction));
+      }
+      return std::vector<unsigned int>(indices.begin(), indices.end());
+    };
+
+    struct Transfer {
+      unsigned int               to_idx;
+      int                        from_rank;
+      std::vector<range_tuple_t> slice;
+      CommBufferPool::key_t      key;
+    };
+
+    std::vector<MPI_Request> requests;
+    std::vector<Transfer>    incoming;
+    for (const auto idx : local_indices) {
+      const auto nghbrs = candidates(idx);
+      for (auto j { 0u }; j < nghbrs.size(); ++j) {
+        const auto nidx = nghbrs[j];
+        // send the part of the old domain `idx` which now belongs to `nidx`
+        {
+          const auto [from_slice, to_slice] = overlap(old_domains[idx],
+                                                      new_domains[nidx]);
+          if (not from_slice.empty()) {
+            const auto to_rank = new_domains[nidx].mpi_rank();
+            if (to_rank == rank) {
+              CopyFieldSlice<D, N>(new_domains[nidx].fields.*field,
+                                   to_slice,
+                                   old_domains[idx].fields.*field,
+                                   from_slice,
+                                   comps);
+            } else {
+              auto& fld = old_domains[idx].fields.*field;
+              comm::BeginCommunicateField<D, N>(idx,
+                                                fld,
+                                                fld,
+                                                nidx,
+                                                nidx,
+                                                to_rank,
+                                                -1,
+                                                from_slice,
+                                                {},
+                                                comps,
+                                                false,
+                                                pool,
+                                                { "rebalance", idx, (short)j },
+                                                (int)slots[idx] * nslots +
+                                                  (int)slots[nidx],
+                                                0,
+                                                requests);
+            }
+          }
+        }
+        // receive the part of the new domain `idx` held by the old `nidx`
+        {
+          const auto [from_slice, to_slice] = overlap(old_domains[nidx],
+                                                      new_domains[idx]);
+          const auto from_rank = new_domains[nidx].mpi_rank();
+          if ((not from_slice.empty()) and (from_rank != rank)) {
+            const CommBufferPool::key_t key { "rebalance", idx, (short)j };
+            auto& fld = new_domains[idx].fields.*field;
+            comm::BeginCommunicateField<D, N>(idx,
+                                              fld,
+                                              fld,
+                                              nidx,
+                                              nidx,
+                                              -1,
+                                              from_rank,
+                                              {},
+                                              to_slice,
+                                              comps,
+                                              false,
+                                              pool,
+                                              key,
+                                              0,
+                                              (int)slots[nidx] * nslots +
+                                                (int)slots[idx],
+                                              requests);
+            incoming.push_back({ idx, from_rank, to_slice, key });
+          }
+        }
+      }
+    }
+    if (not requests.empty()) {
+      MPI_Waitall((int)requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+    }
+    for (const auto& transfer : incoming) {
+      comm::EndCommunicateField<D, N>(new_domains[transfer.to_idx].fields.*field,
+                                      transfer.from_rank,
+                                      transfer.slice,
+                                      comps,
+                                      false,
+                                      pool,
+                                      transfer.key);
+    }
+  }
+
+  template <SimEngine::type S, class M>
+  auto Metadomain<S, M>::Rebalance(const SimulationParams& params,
+                                   duration_t prtl_time) -> bool {
+    const auto threshold = params.template get<real_t>(
+      "simulation.domain.rebalance.threshold");
+    const auto cell_weight = params.template get<real_t>(
+      "simulation.domain.rebalance.cell_weight");
+
+    /* measure the cost of each domain ------------------------------------ */
+    const auto local_domains = localDomains();
+    npart_t    npart_rank    = 0;
+    for (const auto* local_domain : local_domains) {
+      for (const auto& species : local_domain->species) {
+        npart_rank += species.npart();
+      }
+    }
+    // time per particle on this rank relative to the average one ...
+    // ... (accounts for, e.g., the species or the hardware being more costly)
+    double prtl_factor = 1.0;
+    {
+      const double local[2] = { prtl_time, (double)npart_rank };
+      auto         all      = std::vector<double>(2 * g_mpi_size);
+      MPI_Allgather(local, 2, MPI_DOUBLE, all.data(), 2, MPI_DOUBLE, MPI_COMM_WORLD);
+      double time_tot = 0.0, npart_tot = 0.0;
+      for (auto r { 0 }; r < g_mpi_size; ++r) {
+        time_tot  += all[2 * r];
+        npart_tot += all[2 * r + 1];
+      }
+      if ((time_tot > 0.0) and (npart_tot > 0.0) and (prtl_time > 0.0) and
+          (npart_rank > 0)) {
+        prtl_factor = (prtl_time / (double)npart_rank) / (time_tot / npart_tot);
+      }
+    }
+    std::vector<double> cost_local;
+    for (const auto* local_domain : local_domains) {
+      npart_t npart = 0;
+      for (const auto& species : local_domain->species) {
+        npart += species.npart();
+      }
+      ncells_t ncells = 1;
+      for (const auto& n : local_domain->mesh.n_active()) {
+        ncells *= n;
+      }
+      cost_local.push_back(prtl_factor * (double)npart +
+                           (double)cell_weight * (double)ncells);
+    }
+    // domains are assigned to ranks in contiguous blocks
+    auto cost = std::vector<double>(g_ndomains, 0.0);
+    {
+      const int nlocal     = (int)cost_local.size();
+      auto      nlocal_all = std::vector<int>(g_mpi_size);
+      MPI_Allgather(&nlocal, 1, MPI_INT, nlocal_all.data(), 1, MPI_INT, MPI_COMM_WORLD);
+      auto displs = std::vector<int>(g_mpi_size, 0);
+      for (auto r { 1 }; r < g_mpi_size; ++r) {
+        displs[r] = displs[r - 1] + nlocal_all[r - 1];
+      }
+      MPI_Allgatherv(cost_local.data(),
+                     nlocal,
+                     MPI_DOUBLE,
+                     cost.data(),
+                     nlocal_all.data(),
+                     displs.data(),
+                     MPI_DOUBLE,
+                     MPI_COMM_WORLD);
+    }
+
+    /* check whether rebalancing is worth it ------------------------------ */
+    {
+      auto cost_per_rank = std::vector<double>(g_mpi_size, 0.0);
+      for (auto idx { 0u }; idx < g_ndomains; ++idx) {
+        cost_per_rank[g_subdomains[idx].mpi_rank()] += cost[idx];
+      }
+      double cost_max = 0.0, cost_mean = 0.0;
+      for (const auto& c : cost_per_rank) {
+        cost_max   = std::max(cost_max, c);
+        cost_mean += c / (double)g_mpi_size;
+      }
+      if ((cost_mean <= 0.0) or (cost_max / cost_mean < (double)threshold)) {
+        return false;
+      }
+      logger::Checkpoint(fmt::format("Rebalancing domains (max/mean load: %.2f)",
+                                     cost_max / cost_mean),
+                         HERE);
+    }
+
+    /* new # of cells along each dimension -------------------------------- */
+    const auto old_layout = ncells_per_dim();
+    auto       new_layout = old_layout;
+    for (auto d { 0u }; d < (unsigned int)D; ++d) {
+      auto cost_per_slab = std::vector<double>(g_ndomains_per_dim[d], 0.0);
+      for (auto idx { 0u }; idx < g_ndomains; ++idx) {
+        cost_per_slab[g_subdomains[idx].offset_ndomains()[d]] += cost[idx];
+      }
+      // domains have to be at least as wide as the ghost zones they send
+      new_layout[d] = BalanceAlongDimension(old_layout[d],
+                                            cost_per_slab,
+                                            2 * N_GHOSTS);
+    }
+    if (new_layout == old_layout) {
+      return false;
+    }
+
+    /* recreate the domains & migrate the data ---------------------------- */
+    std::vector<Domain<S, M>> old_domains;
+    old_domains.swap(g_subdomains);
+    setLayout(new_layout, false);
+    // in SRPIC, `em0` only holds the fields averaged for sub-cycled species
+    bool has_em0 = (S == SimEngine::GRPIC);
+    if constexpr (S == SimEngine::SRPIC) {
+      for (const auto idx : g_local_subdomain_indices) {
+        has_em0 |= (old_domains[idx].fields.em0.span() > 0);
+      }
+    }
+    for (const auto idx : g_local_subdomain_indices) {
+      auto& domain = g_subdomains[idx];
+      domain.fields      = Fields<D, S> { domain.mesh.n_active() };
+      domain.random_pool = old_domains[idx].random_pool;
+      if ((S == SimEngine::SRPIC) and has_em0) {
+        domain.fields.em0 = ndfield_t<D, 6> { "EM0",
+                                              domain.fields.em.layout() };
+      }
+    }
+
+    MigrateField<S, M, 6>(&Fields<D, S>::em,
+                          old_domains,
+                          g_subdomains,
+                          g_local_subdomain_indices,
+                          g_domain_slots,
+                          g_comm_buffers);
+    if (has_em0) {
+      MigrateField<S, M, 6>(&Fields<D, S>::em0,
+                            old_domains,
+                            g_subdomains,
+                            g_local_subdomain_indices,
+                            g_domain_slots,
+                            g_comm_buffers);
+    }
+    if constexpr (S == SimEngine::GRPIC) {
+      MigrateField<S, M, 3>(&Fields<D, S>::cur0,
+                            old_domains,
+                            g_subdomains,
+                            g_local_subdomain_indices,
+                            g_domain_slots,
+                            g_comm_buffers);
+    }
+
+    // particles keep their domain, but are expressed in its new coordinates ...
+    // ... those which now fall outside are tagged to be sent to the neighbors
+    for (const auto idx : g_local_subdomain_indices) {
+      auto& domain = g_subdomains[idx];
+      domain.species = std::move(old_domains[idx].species);
+
+      int shift[3] { 0, 0, 0 }, ni[3] { 0, 0, 0 };
+      for (auto d { 0u }; d < (unsigned int)D; ++d) {
+        shift[d] = (int)old_domains[idx].offset_ncells()[d] -
+                   (int)domain.offset_ncells()[d];
+        ni[d]    = (int)domain.mesh.n_active()[d];
+      }
+      for (auto& species : domain.species) {
+        auto       i1 = species.i1, i2 = species.i2, i3 = species.i3;
+        auto       i1_prev = species.i1_prev, i2_prev = species.i2_prev,
+             i3_prev = species.i3_prev;
+        auto       tag        = species.tag;
+        const auto store_prev = species.store_prev();
+        const auto sh1 = shift[0], sh2 = shift[1], sh3 = shift[2];
+        const auto ni1 = ni[0], ni2 = ni[1], ni3 = ni[2];
+        Kokkos::parallel_for(
+          "RebalanceParticles",
+          species.rangeActiveParticles(),
+          Lambda(index_t p) {
+            if (tag(p) != ParticleTag::alive) {
+              return;
+            }
+            if constexpr (D == Dim::_1D) {
+              i1(p) += sh1;
+              if (store_prev) {
+                i1_prev(p) += sh1;
+              }
+              tag(p) = mpi::SendTag(tag(p), i1(p) < 0, i1(p) >= ni1);
+            } else if constexpr (D == Dim::_2D) {
+              i1(p) += sh1;
+              i2(p) += sh2;
+              if (store_prev) {
+                i1_prev(p) += sh1;
+                i2_prev(p) += sh2;
+              }
+              tag(p) = mpi::SendTag(tag(p),
+                                    i1(p) < 0,
+                                    i1(p) >= ni1,
+                                    i2(p) < 0,
+                                    i2(p) >= ni2);
+            } else if constexpr (D == Dim::_3D) {
+              i1(p) += sh1;
+              i2(p) += sh2;
+              i3(p) += sh3;
+              if (store_prev) {
+                i1_prev(p) += sh1;
+                i2_prev(p) += sh2;
+                i3_prev(p) += sh3;
+              }
+              tag(p) = mpi::SendTag(tag(p),
+                                    i1(p) < 0,
+                                    i1(p) >= ni1,
+                                    i2(p) < 0,
+                                    i2(p) >= ni2,
+                                    i3(p) < 0,
+                                    i3(p) >= ni3);
+            }
+          });
+        species.set_unsorted();
+      }
+    }
+    old_domains.clear();
+    CommunicateParticles();
+
+    // refill the ghost cells
+    if constexpr (S == SimEngine::GRPIC) {
+      CommunicateFields(Comm::D | Comm::B | Comm::D0 | Comm::B0);
+    } else if (has_em0) {
+      CommunicateFields(Comm::E | Comm::B | Comm::D0 | Comm::B0);
+    } else {
+      CommunicateFields(Comm::E | Comm::B);
+    }
+#if defined(OUTPUT_ENABLED)
+    resetOutputMeshBlocks();
+#endif
+    return true;
+  }
+
+#define METADOMAIN_REBALANCE(S, M, D)                                           \
+  template auto Metadomain<S, M<D>>::Rebalance(const SimulationParams&,        \
+                                               duration_t) -> bool;
+
+  NTT_FOREACH_SPECIALIZATION(METADOMAIN_REBALANCE)
+
+#undef METADOMAIN_REBALANCE
+
+} // namespace ntt
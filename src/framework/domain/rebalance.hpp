@@ -0,0 +1,92 @@
+/**
+ * @file framework/domain/rebalance.hpp
+ * @brief Layout of the domains balancing the measured cost
+ * @implements
+ *   - ntt::BalanceAlongDimension -> std::vector<ncells_t>
+ * @namespaces:
+ *   - ntt::
+ */
+
+#ifndef FRAMEWORK_DOMAIN_REBALANCE_HPP
+#define FRAMEWORK_DOMAIN_REBALANCE_HPP
+
+#include "global.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace ntt {
+
+  /**
+   * @brief New # of cells of the domains along one dimension
+   * @param ncells current # of cells of the domains
+   * @param cost measured cost of each slab of domains
+   * @param min_ncells minimum # of cells of a domain
+   * @note The cost is assumed uniform within each slab; a boundary may only
+   * move within its two adjacent domains, so that all the data can be migrated
+   * with the regular neighbor exchanges
+   */
+  inline auto BalanceAlongDimension(const std::vector<ncells_t>& ncells,
+                                    const std::vector<double>&   cost,
+                                    ncells_t min_ncells) -> std::vector<ncells_t> {
+    const auto ndoms = ncells.size();
+    if (ndoms < 2) {
+      return ncells;
+    }
+    double cost_total = 0.0;
+    for (const auto& c : cost) {
+      cost_total += c;
+    }
+    if (cost_total <= 0.0) {
+      return ncells;
+    }
+    // current & new boundaries (in cells)
+    std::vector<long int> bounds { 0 }, new_bounds { 0 };
+    for (const auto& n : ncells) {
+      bounds.push_back(bounds.back() + (long int)n);
+    }
+    for (auto k { 1u }; k < ndoms; ++k) {
+      // position where the cumulative cost reaches k / ndoms of the total
+      const auto target   = cost_total * (double)k / (double)ndoms;
+      auto       j        = 0u;
+      auto       cost_acc = 0.0;
+      while ((j < ndoms - 1) and (cost_acc + cost[j] < target)) {
+        cost_acc += cost[j];
+        ++j;
+      }
+      const auto frac = (cost[j] > 0.0)
+                          ? std::clamp((target - cost_acc) / cost[j], 0.0, 1.0)
+                          : 0.5;
+      const auto bound = bounds[j] +
+                         (long int)(frac * (double)ncells[j] + 0.5);
+      new_bounds.push_back(
+        std::clamp(bound, bounds[k - 1] + 1, bounds[k + 1] - 1));
+    }
+    new_bounds.push_back(bounds.back());
+    // enforce the minimum size of the domains
+    for (auto k { 1u }; k < ndoms; ++k) {
+      new_bounds[k] = std::max(new_bounds[k],
+                               new_bounds[k - 1] + (long int)min_ncells);
+    }
+    for (auto k { ndoms - 1 }; k > 0; --k) {
+      new_bounds[k] = std::min(new_bounds[k],
+                               new_bounds[k + 1] - (long int)min_ncells);
+    }
+    std::vector<ncells_t> new_ncells;
+    for (auto k { 1u }; k <= ndoms; ++k) {
+      const auto stays_adjacent = (k == ndoms) or
+                                  ((new_bounds[k] > bounds[k - 1]) and
+                                   (new_bounds[k] < bounds[k + 1]));
+      if ((new_bounds[k] - new_bounds[k - 1] < (long int)min_ncells) or
+          (not stays_adjacent)) {
+        // constraints cannot be satisfied: keep the current layout
+        return ncells;
+      }
+      new_ncells.push_back((ncells_t)(new_bounds[k] - new_bounds[k - 1]));
+    }
+    return new_ncells;
+  }
+
+} // namespace ntt
+
+#endif // FRAMEWORK_DOMAIN_REBALANCE_HPP
@@ -1,6 +1,7 @@
 #include "enums.h"
 #include "global.h"
 
+#include "arch/kokkos_aliases.h"
 #include "utils/comparators.h"
 #include "utils/error.h"
 #include "utils/log.h"
@@ -21,25 +22,30 @@
 
 #include "kernels/reduced_stats.hpp"
 
+#if defined(MPI_ENABLED)
+  #include "arch/mpi_aliases.h"
+
+  #include <mpi.h>
+#endif
+
 #include <Kokkos_Core.hpp>
-#include <Kokkos_ScatterView.hpp>
-#include <Kokkos_StdAlgorithms.hpp>
 
+#include <algorithm>
 #include <filesystem>
+#include <string>
+#include <utility>
+#include <vector>
 
 namespace ntt {
 
   template <SimEngine::type S, class M>
   void Metadomain<S, M>::InitStatsWriter(const SimulationParams& params,
                                          bool                    is_resuming) {
-    raise::ErrorIf(
-      l_subdomain_indices().size() != 1,
-      "StatsWriter for now is only supported for one subdomain per rank",
-      HERE);
-    auto local_domain = subdomain_ptr(l_subdomain_indices()[0]);
-    raise::ErrorIf(local_domain->is_placeholder(),
-                   "local_domain is a placeholder",
-                   HERE);
+    for (const auto ldidx : l_subdomain_indices()) {
+      raise::ErrorIf(subdomain_ptr(ldidx)->is_placeholder(),
+                     "local_domain is a placeholder",
+                     HERE);
+    }
     const auto simname  = params.template get<std::string>("simulation.name");
     const auto filename = std::filesystem::path(simname) /
                           (simname + "_stats.csv");
@@ -69,123 +75,89 @@ namespace ntt {
     }
   }
 
-  template <SimEngine::type S, class M, StatsID::type P>
-  auto ComputeMoments(const SimulationParams& params,
-                      const Mesh<M>&          mesh,
-                      const M&                global_metric,
-                      const std::vector<Particles<M::Dim, M::CoordType>>& prtl_species,
-                      const std::vector<spidx_t>&        species,
-                      const std::vector<unsigned short>& components) -> real_t {
-    std::vector<spidx_t> specs = species;
-    if (specs.size() == 0) {
-      // if no species specified, take all massive species
-      for (auto& sp : prtl_species) {
-        if (sp.mass() > 0) {
-          specs.push_back(sp.index());
-        }
+  /**
+   * @brief A requested stat with its columns in the stats row
+   */
+  struct StatSlots {
+    kernel::StatSpec spec;
+    std::size_t      slot;
+  };
+
+  /**
+   * @brief Stats type of the output (as used by the reduction kernels)
+   */
+  auto StatType(const stats::OutputStats& stat) -> StatsID::type {
+    for (const auto& variant : StatsID::variants) {
+      if (stat.id() == variant) {
+        return variant;
       }
     }
-    for (const auto& sp : specs) {
-      raise::ErrorIf((sp > prtl_species.size()) or (sp == 0),
-                     "Invalid species index " + std::to_string(sp),
-                     HERE);
-    }
-    // some parameters
-    const auto use_weights = params.template get<bool>("particles.use_weights");
+    return StatsID::INVALID;
+  }
 
-    real_t buffer = static_cast<real_t>(0);
-    for (const auto& sp : specs) {
-      auto& prtl_spec = prtl_species[sp - 1];
-      if (P == StatsID::Charge and cmp::AlmostZero_host(prtl_spec.charge())) {
-        continue;
-      }
-      if (P == StatsID::Rho and cmp::AlmostZero_host(prtl_spec.mass())) {
-        continue;
+  /**
+   * @brief Reduce the requested particle stats of a given species in a single
+   * sweep per (at most `MaxStats`) batch; result is added to the row
+   */
+  template <SimEngine::type S, class M>
+  void ReduceMoments(const SimulationParams&                params,
+                     const Domain<S, M>&                    domain,
+                     const Particles<M::Dim, M::CoordType>& prtl_spec,
+                     const std::vector<StatSlots>&          stats,
+                     std::vector<real_t>&                   row) {
+    using kernel_t = kernel::ReducedParticleMomentsBatch_kernel<S, M>;
+    const auto use_weights = params.template get<bool>("particles.use_weights");
+    for (std::size_t first { 0 }; first < stats.size(); first += kernel_t::MaxStats) {
+      const auto last = std::min(first + kernel_t::MaxStats, stats.size());
+      std::vector<kernel::StatSpec> specs;
+      for (auto n { first }; n < last; ++n) {
+        specs.push_back(stats[n].spec);
       }
-      real_t temp_buff = ZERO;
+      array_h_t<real_t*> result { "moments", specs.size() };
       Kokkos::parallel_reduce(
-        "ComputeMoments",
+        "ReduceMoments",
         prtl_spec.rangeActiveParticles(),
         // clang-format off
-        kernel::ReducedParticleMoments_kernel<S, M, P>(components,
-                                                       prtl_spec.i1, prtl_spec.i2, prtl_spec.i3,
-                                                       prtl_spec.dx1, prtl_spec.dx2, prtl_spec.dx3,
-                                                       prtl_spec.ux1, prtl_spec.ux2, prtl_spec.ux3,
-                                                       prtl_spec.phi, prtl_spec.weight, prtl_spec.tag,
-                                                       prtl_spec.mass(), prtl_spec.charge(),
-                                                       use_weights, mesh.metric),
+        kernel_t(specs,
+                 prtl_spec.i1, prtl_spec.i2, prtl_spec.i3,
+                 prtl_spec.dx1, prtl_spec.dx2, prtl_spec.dx3,
+                 prtl_spec.ux1, prtl_spec.ux2, prtl_spec.ux3,
+                 prtl_spec.phi, prtl_spec.weight, prtl_spec.tag,
+                 prtl_spec.mass(), prtl_spec.charge(),
+                 use_weights, domain.mesh.metric),
         // clang-format on
-        temp_buff);
-      buffer += temp_buff;
-    }
-    if (P != StatsID::Npart) {
-      return buffer / (global_metric.totVolume() *
-                       params.template get<real_t>("particles.ppc0"));
-    } else {
-      return buffer;
+        result);
+      for (auto n { first }; n < last; ++n) {
+        row[stats[n].slot] += result(n - first);
+      }
     }
   }
 
-  template <SimEngine::type S, class M, StatsID::type F>
-  auto ReduceFields(Domain<S, M>*                      domain,
-                    const M&                           global_metric,
-                    const std::vector<unsigned short>& components) -> real_t {
-    auto buffer { ZERO };
-    if constexpr (F == StatsID::JdotE) {
-      if (components.size() == 0) {
-        Kokkos::parallel_reduce(
-          "ReduceFields",
-          domain->mesh.rangeActiveCells(),
-          kernel::ReducedFields_kernel<S, M, F, 0>(domain->fields.em,
-                                                   domain->fields.cur,
-                                                   domain->mesh.metric),
-          buffer);
-      } else {
-        raise::Error("Components not supported for JdotE", HERE);
+  /**
+   * @brief Reduce the requested field stats in a single sweep over the cells
+   * per (at most `MaxStats`) batch; result is added to the row
+   */
+  template <SimEngine::type S, class M>
+  void ReduceFields(const Domain<S, M>&           domain,
+                    const std::vector<StatSlots>& stats,
+                    std::vector<real_t>&          row) {
+    using kernel_t = kernel::ReducedFieldsBatch_kernel<S, M>;
+    for (std::size_t first { 0 }; first < stats.size(); first += kernel_t::MaxStats) {
+      const auto last = std::min(first + kernel_t::MaxStats, stats.size());
+      std::vector<kernel::StatSpec> specs;
+      for (auto n { first }; n < last; ++n) {
+        specs.push_back(stats[n].spec);
       }
-    } else if constexpr (
-      (S == SimEngine::SRPIC) and
-      (F == StatsID::B2 or F == StatsID::E2 or F == StatsID::ExB)) {
-      raise::ErrorIf(components.size() != 1,
-                     "Components must be of size 1 for B2, E2 or ExB stats",
-                     HERE);
-      const auto comp = components[0];
-      if (comp == 1) {
-        Kokkos::parallel_reduce(
-          "ReduceFields",
-          domain->mesh.rangeActiveCells(),
-          kernel::ReducedFields_kernel<S, M, F, 1>(domain->fields.em,
-                                                   domain->fields.cur,
-                                                   domain->mesh.metric),
-          buffer);
-      } else if (comp == 2) {
-        Kokkos::parallel_reduce(
-          "ReduceFields",
-          domain->mesh.rangeActiveCells(),
-          kernel::ReducedFields_kernel<S, M, F, 2>(domain->fields.em,
-                                                   domain->fields.cur,
-                                                   domain->mesh.metric),
-          buffer);
-      } else if (comp == 3) {
-        Kokkos::parallel_reduce(
-          "ReduceFields",
-          domain->mesh.rangeActiveCells(),
-          kernel::ReducedFields_kernel<S, M, F, 3>(domain->fields.em,
-                                                   domain->fields.cur,
-                                                   domain->mesh.metric),
-          buffer);
-      } else {
-        raise::Error(
-          "Invalid component for B2, E2 or ExB stats: " + std::to_string(comp),
-          HERE);
+      array_h_t<real_t*> result { "fields", specs.size() };
+      Kokkos::parallel_reduce(
+        "ReduceFields",
+        domain.mesh.rangeActiveCells(),
+        kernel_t(specs, domain.fields.em, domain.fields.cur, domain.mesh.metric),
+        result);
+      for (auto n { first }; n < last; ++n) {
+        row[stats[n].slot] += result(n - first);
       }
-    } else {
-      raise::Error("ReduceFields not implemented for this stats ID + SimEngine "
-                   "combination",
-                   HERE);
     }
-
-    return buffer / global_metric.totVolume();
   }
 
   template <SimEngine::type S, class M>
@@ -201,80 +173,85 @@ namespace ntt {
             g_stats_writer.shouldWrite(finished_step, finished_time))) {
       return false;
     }
-    auto local_domain = subdomain_ptr(l_subdomain_indices()[0]);
+    const auto local_domains = localDomains();
     logger::Checkpoint("Writing stats", HERE);
-    g_stats_writer.write(current_step, false);
-    g_stats_writer.write(current_time, false);
+
+    const auto& prtl_species_0 = local_domains[0]->species;
+    const auto  norm_volume    = ONE / g_mesh.metric.totVolume();
+    const auto  norm_moments   = norm_volume /
+                              params.template get<real_t>("particles.ppc0");
+
+    // all the (additive) stats are accumulated into a single row in the order
+    // of the header; particle stats are grouped per species & field stats are
+    // grouped together, so that each is reduced in a single sweep
+    std::vector<real_t>                 row, norms;
+    std::vector<std::vector<StatSlots>> prtl_stats(prtl_species_0.size());
+    std::vector<StatSlots>              fld_stats;
+    const auto add_slot = [&](real_t norm) -> std::size_t {
+      row.push_back(ZERO);
+      norms.push_back(norm);
+      return row.size() - 1;
+    };
     for (const auto& stat : g_stats_writer.statsWriters()) {
       if (stat.id() == StatsID::Custom) {
-        if (CustomStat != nullptr) {
-          g_stats_writer.write(
-            CustomStat(stat.name(), finished_step, finished_time, *local_domain));
-        } else {
-          raise::Error("Custom output requested but no function provided", HERE);
+        raise::ErrorIf(CustomStat == nullptr,
+                       "Custom output requested but no function provided",
+                       HERE);
+        // custom stats are summed over the local domains
+        const auto slot = add_slot(ONE);
+        for (const auto* local_domain : local_domains) {
+          row[slot] += CustomStat(stat.name(), finished_step, finished_time, *local_domain);
         }
-      } else if (stat.id() == StatsID::N) {
-        g_stats_writer.write(ComputeMoments<S, M, StatsID::N>(params,
-                                                              local_domain->mesh,
-                                                              g_mesh.metric,
-                                                              local_domain->species,
-                                                              stat.species,
-                                                              {}));
-      } else if (stat.id() == StatsID::Npart) {
-        g_stats_writer.write(
-          ComputeMoments<S, M, StatsID::Npart>(params,
-                                               local_domain->mesh,
-                                               g_mesh.metric,
-                                               local_domain->species,
-                                               stat.species,
-                                               {}));
-      } else if (stat.id() == StatsID::Rho) {
-        g_stats_writer.write(
-          ComputeMoments<S, M, StatsID::Rho>(params,
-                                             local_domain->mesh,
-                                             g_mesh.metric,
-                                             local_domain->species,
-                                             stat.species,
-                                             {}));
-      } else if (stat.id() == StatsID::Charge) {
-        g_stats_writer.write(
-          ComputeMoments<S, M, StatsID::Charge>(params,
-                                                local_domain->mesh,
-                                                g_mesh.metric,
-                                                local_domain->species,
-                                                stat.species,
-                                                {}));
-      } else if (stat.id() == StatsID::T) {
-        for (const auto& comp : stat.comp) {
-          g_stats_writer.write(
-            ComputeMoments<S, M, StatsID::T>(params,
-                                             local_domain->mesh,
-                                             g_mesh.metric,
-                                             local_domain->species,
-                                             stat.species,
-                                             comp));
+      } else if (stat.is_moment()) {
+        std::vector<spidx_t> species = stat.species;
+        if (species.size() == 0) {
+          // if no species specified, take all massive species
+          for (const auto& sp : prtl_species_0) {
+            if (sp.mass() > 0) {
+              species.push_back(sp.index());
+            }
+          }
+        }
+        for (const auto& sp : species) {
+          raise::ErrorIf((sp > prtl_species_0.size()) or (sp == 0),
+                         "Invalid species index " + std::to_string(sp),
+                         HERE);
+        }
+        const auto id   = StatType(stat);
+        const auto norm = (id == StatsID::Npart) ? ONE : norm_moments;
+        std::vector<std::vector<unsigned short>> comps = stat.comp;
+        if (comps.empty()) {
+          comps.push_back({});
+        }
+        for (const auto& comp : comps) {
+          kernel::StatSpec spec;
+          spec.id         = id;
+          spec.c1         = (comp.size() > 0) ? comp[0] : 0;
+          spec.c2         = (comp.size() == 2) ? comp[1] : 0;
+          const auto slot = add_slot(norm);
+          for (const auto& sp : species) {
+            const auto& prtl_spec = prtl_species_0[sp - 1];
+            if (id == StatsID::Charge and cmp::AlmostZero_host(prtl_spec.charge())) {
+              continue;
+            }
+            if (id == StatsID::Rho and cmp::AlmostZero_host(prtl_spec.mass())) {
+              continue;
+            }
+            prtl_stats[sp - 1].push_back({ spec, slot });
+          }
         }
       } else if (stat.id() == StatsID::JdotE) {
-        g_stats_writer.write(
-          ReduceFields<S, M, StatsID::JdotE>(local_domain, g_mesh.metric, {}));
+        fld_stats.push_back({ { StatsID::JdotE, 0, 0 }, add_slot(norm_volume) });
       } else if (S == SimEngine::SRPIC) {
-        if (stat.id() == StatsID::E2) {
-          for (const auto& comp : stat.comp) {
-            g_stats_writer.write(
-              ReduceFields<S, M, StatsID::E2>(local_domain, g_mesh.metric, comp));
-          }
-        } else if (stat.id() == StatsID::B2) {
-          for (const auto& comp : stat.comp) {
-            g_stats_writer.write(
-              ReduceFields<S, M, StatsID::B2>(local_domain, g_mesh.metric, comp));
-          }
-        } else if (stat.id() == StatsID::ExB) {
-          for (const auto& comp : stat.comp) {
-            g_stats_writer.write(
-              ReduceFields<S, M, StatsID::ExB>(local_domain, g_mesh.metric, comp));
-          }
-        } else {
-          raise::Error("Unrecognized stats ID " + stat.name(), HERE);
+        raise::ErrorIf(not stat.is_vector(),
+                       "Unrecognized stats ID " + stat.name(),
+                       HERE);
+        for (const auto& comp : stat.comp) {
+          raise::ErrorIf(comp.size() != 1,
+                         "Components must be of size 1 for B2, E2 or ExB stats",
+                         HERE);
+          fld_stats.push_back({ { StatType(stat), comp[0], 0 },
+                                add_slot(norm_volume) });
         }
       } else {
         raise::Error("StatsID not implemented for particular SimEngine: " +
@@ -282,7 +259,38 @@ namespace ntt {
                      HERE);
       }
     }
-    g_stats_writer.endWriting();
+
+    for (const auto* local_domain : local_domains) {
+      for (auto s { 0u }; s < prtl_stats.size(); ++s) {
+        if (not prtl_stats[s].empty()) {
+          ReduceMoments<S, M>(params,
+                              *local_domain,
+                              local_domain->species[s],
+                              prtl_stats[s],
+                              row);
+        }
+      }
+      if (not fld_stats.empty()) {
+        ReduceFields<S, M>(*local_domain, fld_stats, row);
+      }
+    }
+
+    // a single collective for the whole row
+#if defined(MPI_ENABLED)
+    std::vector<real_t> row_tot(row.size(), ZERO);
+    MPI_Reduce(row.data(),
+               row_tot.data(),
+               static_cast<int>(row.size()),
+               mpi::get_type<real_t>(),
+               MPI_SUM,
+               MPI_ROOT_RANK,
+               MPI_COMM_WORLD);
+    row = std::move(row_tot);
+#endif
+    for (auto n { 0u }; n < row.size(); ++n) {
+      row[n] *= norms[n];
+    }
+    g_stats_writer.writeRow(current_step, current_time, row);
     return true;
   }
 
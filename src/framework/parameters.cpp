@@ -23,6 +23,7 @@
   #include <mpi.h>
 #endif
 
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 #include <map>
@@ -177,6 +178,14 @@ namespace ntt {
     raise::ErrorIf(ppc0 <= 0.0, "ppc0 must be positive", HERE);
     set("particles.use_weights",
         toml::find_or(toml_data, "particles", "use_weights", false));
+    set("particles.lean_layout",
+        toml::find_or(toml_data, "particles", "lean_layout", defaults::lean_layout));
+    raise::ErrorIf(get<bool>("particles.lean_layout") and
+                     engine_enum != SimEngine::SRPIC,
+                   "`particles.lean_layout` is only supported for SRPIC",
+                   HERE);
+    // lean layout: `*_prev` arrays are not allocated
+    const auto store_prev = not get<bool>("particles.lean_layout");
 
     /* [particles.species] -------------------------------------------------- */
     std::vector<ParticleSpecies> species;
@@ -186,7 +195,9 @@ namespace ntt {
                                                         toml::array {});
     set("particles.nspec", species_tab.size());
 
-    spidx_t idx = 1;
+    spidx_t        idx             = 1;
+    // fields are time-averaged over a single sub-cycle shared by the species
+    unsigned short common_subcycle = 1;
     for (const auto& sp : species_tab) {
       const auto label  = toml::find_or<std::string>(sp,
                                                     "label",
@@ -217,6 +228,28 @@ namespace ntt {
 #endif
       }
       const auto cooling = toml::find_or(sp, "cooling", std::string("None"));
+      const auto subcycle = toml::find_or(sp,
+                                          "subcycle",
+                                          static_cast<unsigned short>(1));
+      raise::ErrorIf(subcycle == 0, "`subcycle` must be at least 1", HERE);
+      if (subcycle > 1) {
+        raise::ErrorIf(engine_enum != SimEngine::SRPIC,
+                       "sub-cycling is only supported for SRPIC",
+                       HERE);
+        raise::ErrorIf((common_subcycle > 1) and (subcycle != common_subcycle),
+                       "all sub-cycled species must share the same `subcycle`",
+                       HERE);
+        // the deposit assumes the particles cross at most one cell per push
+        const auto cfl = toml::find_or(toml_data,
+                                       "algorithms",
+                                       "timestep",
+                                       "CFL",
+                                       defaults::cfl);
+        raise::ErrorIf(static_cast<real_t>(subcycle) * cfl > ONE,
+                       "`subcycle * CFL` must not exceed 1",
+                       HERE);
+        common_subcycle = subcycle;
+      }
       raise::ErrorIf((fmt::toLower(cooling) != "none") && is_massless,
                      "cooling is only applicable to massive particles",
                      HERE);
@@ -265,7 +298,9 @@ namespace ntt {
                                            use_gca,
                                            cooling_enum,
                                            npayloads_real,
-                                           npayloads_int));
+                                           npayloads_int,
+                                           store_prev,
+                                           subcycle));
       idx += 1;
     }
     set("particles.species", species);
@@ -358,6 +393,30 @@ namespace ntt {
         toml::find<std::string>(toml_data, "simulation", "name"));
     set("simulation.runtime",
         toml::find<simtime_t>(toml_data, "simulation", "runtime"));
+    set("simulation.domain.rebalance.interval",
+        toml::find_or(toml_data,
+                      "simulation",
+                      "domain",
+                      "rebalance",
+                      "interval",
+                      defaults::rebalance::interval));
+    set("simulation.domain.rebalance.threshold",
+        toml::find_or(toml_data,
+                      "simulation",
+                      "domain",
+                      "rebalance",
+                      "threshold",
+                      defaults::rebalance::threshold));
+    set("simulation.domain.rebalance.cell_weight",
+        toml::find_or(toml_data,
+                      "simulation",
+                      "domain",
+                      "rebalance",
+                      "cell_weight",
+                      defaults::rebalance::cell_weight));
+    raise::ErrorIf(get<real_t>("simulation.domain.rebalance.threshold") < ONE,
+                   "`simulation.domain.rebalance.threshold` must be >= 1",
+                   HERE);
 
     /* [grid.boundaraies] --------------------------------------------------- */
     auto flds_bc = toml::find<std::vector<std::vector<std::string>>>(
@@ -437,6 +496,56 @@ namespace ntt {
     set("algorithms.toggles.deposit",
         toml::find_or(toml_data, "algorithms", "toggles", "deposit", true));
 
+    /* [algorithms.deposit] ------------------------------------------------- */
+    set("algorithms.deposit.tiled",
+        toml::find_or(toml_data,
+                      "algorithms",
+                      "deposit",
+                      "tiled",
+                      defaults::deposit::tiled));
+    set("algorithms.deposit.tile_size",
+        toml::find_or(toml_data,
+                      "algorithms",
+                      "deposit",
+                      "tile_size",
+                      defaults::deposit::tile_size));
+    raise::ErrorIf(get<unsigned short>("algorithms.deposit.tile_size") == 0,
+                   "`algorithms.deposit.tile_size` must be nonzero",
+                   HERE);
+    set("algorithms.deposit.fused",
+        toml::find_or(toml_data,
+                      "algorithms",
+                      "deposit",
+                      "fused",
+                      defaults::deposit::fused));
+    raise::ErrorIf(get<bool>("algorithms.deposit.fused") and
+                     get<bool>("algorithms.deposit.tiled"),
+                   "`algorithms.deposit.fused` and `algorithms.deposit.tiled` "
+                   "cannot be used together",
+                   HERE);
+
+    /* [algorithms.gather] -------------------------------------------------- */
+    set("algorithms.gather.colocated",
+        toml::find_or(toml_data,
+                      "algorithms",
+                      "gather",
+                      "colocated",
+                      defaults::gather::colocated));
+    // the node-centered gather is first-order only: with higher-order shapes
+    // it would not match the shape of the deposit (self-force & heating)
+    raise::ErrorIf(get<bool>("algorithms.gather.colocated") and (SHAPE_ORDER > 1),
+                   "`algorithms.gather.colocated` requires the first-order "
+                   "particle shape (shape_order = 1)",
+                   HERE);
+
+    /* [algorithms.pusher] -------------------------------------------------- */
+    set("algorithms.pusher.vectorized",
+        toml::find_or(toml_data,
+                      "algorithms",
+                      "pusher",
+                      "vectorized",
+                      defaults::pusher::vectorized));
+
     /* [algorithms.fieldsolver] --------------------------------------------- */
     set("algorithms.fieldsolver.delta_x",
         toml::find_or(toml_data,
@@ -492,6 +601,28 @@ namespace ntt {
                       "fieldsolver",
                       "beta_zy",
                       defaults::fieldsolver::beta_zy));
+    set("algorithms.fieldsolver.overlap_comm",
+        toml::find_or(toml_data,
+                      "algorithms",
+                      "fieldsolver",
+                      "overlap_comm",
+                      defaults::fieldsolver::overlap_comm));
+    if (get<bool>("algorithms.fieldsolver.overlap_comm")) {
+      raise::ErrorIf(engine_enum != SimEngine::SRPIC,
+                     "`algorithms.fieldsolver.overlap_comm` is only supported "
+                     "for SRPIC",
+                     HERE);
+      // field BCs may modify cells deep inside the domain, so the interior
+      // ... cannot be advanced before they are applied
+      for (const auto& bcs : flds_bc) {
+        for (const auto& bc : bcs) {
+          raise::ErrorIf(fmt::toLower(bc) != "periodic",
+                         "`algorithms.fieldsolver.overlap_comm` requires "
+                         "periodic field boundaries",
+                         HERE);
+        }
+      }
+    }
     /* [algorithms.timestep] ------------------------------------------------ */
     set("algorithms.timestep.CFL",
         toml::find_or(toml_data, "algorithms", "timestep", "CFL", defaults::cfl));
@@ -522,6 +653,15 @@ namespace ntt {
     /* [particles] ---------------------------------------------------------- */
     set("particles.clear_interval",
         toml::find_or(toml_data, "particles", "clear_interval", defaults::clear_interval));
+    set("particles.sort_interval",
+        toml::find_or(toml_data, "particles", "sort_interval", defaults::sort_interval));
+    set("particles.sort_tile",
+        toml::find_or(toml_data, "particles", "sort_tile", defaults::sort_tile));
+    raise::ErrorIf(get<ncells_t>("particles.sort_tile") == 0,
+                   "`particles.sort_tile` must be nonzero",
+                   HERE);
+    set("particles.sort_morton",
+        toml::find_or(toml_data, "particles", "sort_morton", defaults::sort_morton));
     const auto species_tab               = toml::find_or<toml::array>(toml_data,
                                                         "particles",
                                                         "species",
@@ -549,7 +689,9 @@ namespace ntt {
                                particle_species.use_gca(),
                                particle_species.cooling(),
                                particle_species.npld_r(),
-                               particle_species.npld_i());
+                               particle_species.npld_i(),
+                               particle_species.store_prev(),
+                               particle_species.subcycle());
       idxM1++;
     }
     set("particles.species", new_species);
@@ -564,6 +706,41 @@ namespace ntt {
         toml::find_or<simtime_t>(toml_data, "output", "interval_time", -1.0));
     set("output.separate_files",
         toml::find_or<bool>(toml_data, "output", "separate_files", true));
+    set("output.async", toml::find_or<bool>(toml_data, "output", "async", false));
+
+    // compression
+    for (const auto& kind : { "fields", "particles" }) {
+      const auto compression = fmt::toLower(
+        toml::find_or(toml_data,
+                      "output",
+                      "compression",
+                      kind,
+                      defaults::output::compression));
+      raise::ErrorIf(
+        (compression != "none") and (compression != "blosc") and
+          (compression != "bzip2") and (compression != "zfp") and
+          (compression != "sz") and (compression != "mgard"),
+        fmt::format("invalid `output.compression.%s`: %s", kind, compression.c_str()),
+        HERE);
+      set(fmt::format("output.compression.%s", kind), compression);
+    }
+    const auto compr_accuracy = toml::find_or(toml_data,
+                                              "output",
+                                              "compression",
+                                              "accuracy",
+                                              defaults::output::compr_accuracy);
+    raise::ErrorIf(compr_accuracy <= 0.0,
+                   "`output.compression.accuracy` must be positive",
+                   HERE);
+    set("output.compression.accuracy", compr_accuracy);
+    set("output.compression.level",
+        toml::find_or(toml_data,
+                      "output",
+                      "compression",
+                      "level",
+                      defaults::output::compr_level));
+    set("output.compression.single_precision",
+        toml::find_or(toml_data, "output", "compression", "single_precision", false));
 
     promiseToDefine("output.fields.enable");
     promiseToDefine("output.fields.interval");
@@ -631,6 +808,15 @@ namespace ntt {
       raise::ErrorIf(dwn == 0, "downsampling factor must be nonzero", HERE);
     }
     set("output.fields.downsampling", field_dwn);
+    set("output.fields.downsampling_mode",
+        std::string(Downsampling::pick(
+                      toml::find_or(toml_data,
+                                    "output",
+                                    "fields",
+                                    "downsampling_mode",
+                                    defaults::output::dwn_mode)
+                        .c_str())
+                      .to_string()));
 
     // particles
     auto       all_specs = std::vector<spidx_t> {};
@@ -650,6 +836,45 @@ namespace ntt {
                       "particles",
                       "stride",
                       defaults::output::prtl_stride));
+    raise::ErrorIf(get<npart_t>("output.particles.stride") == 0,
+                   "output.particles.stride must be positive",
+                   HERE);
+    // selection of the particles to write (all the criteria are optional)
+    const auto prtl_box = toml::find_or<std::vector<std::vector<real_t>>>(
+      toml_data,
+      "output",
+      "particles",
+      "box",
+      {});
+    raise::ErrorIf(not(prtl_box.empty() or
+                       (prtl_box.size() == static_cast<std::size_t>(dim))),
+                   "output.particles.box must have one [min, max] per dimension",
+                   HERE);
+    for (const auto& minmax : prtl_box) {
+      raise::ErrorIf(minmax.size() != 2,
+                     "output.particles.box must have one [min, max] per dimension",
+                     HERE);
+    }
+    set("output.particles.box", prtl_box);
+    set("output.particles.e_min",
+        toml::find_or<real_t>(toml_data, "output", "particles", "e_min", -ONE));
+    set("output.particles.e_max",
+        toml::find_or<real_t>(toml_data, "output", "particles", "e_max", -ONE));
+    const auto prtl_counter = toml::find_or<std::vector<npart_t>>(toml_data,
+                                                                  "output",
+                                                                  "particles",
+                                                                  "counter",
+                                                                  {});
+    raise::ErrorIf(not(prtl_counter.empty() or (prtl_counter.size() == 2)),
+                   "output.particles.counter must be [min, max]",
+                   HERE);
+    set("output.particles.counter", prtl_counter);
+    set("output.particles.packed",
+        toml::find_or(toml_data,
+                      "output",
+                      "particles",
+                      "packed",
+                      defaults::output::prtl_packed));
 
     // spectra
     set("output.spectra.e_min",
@@ -668,6 +893,103 @@ namespace ntt {
                       "spectra",
                       "n_bins",
                       defaults::output::spec_nbins));
+    // [[output.spectra.histograms]]: stored axis-by-axis for each histogram
+    const auto histograms_tab = toml::find_or<toml::array>(toml_data,
+                                                           "output",
+                                                           "spectra",
+                                                           "histograms",
+                                                           toml::array {});
+    std::vector<std::string>                 hist_labels;
+    std::vector<std::vector<spidx_t>>        hist_species;
+    std::vector<std::vector<std::string>>    hist_axes;
+    std::vector<std::vector<std::size_t>>    hist_nbins;
+    std::vector<std::vector<real_t>>         hist_min, hist_max;
+    std::vector<std::vector<unsigned short>> hist_log;
+    for (const auto& hist : histograms_tab) {
+      const auto label = toml::find_or<std::string>(
+        hist,
+        "label",
+        "h" + std::to_string(hist_labels.size() + 1));
+      raise::ErrorIf(std::find(hist_labels.begin(), hist_labels.end(), label) !=
+                       hist_labels.end(),
+                     "duplicate histogram label: " + label,
+                     HERE);
+      const auto axes  = toml::find<std::vector<std::string>>(hist, "axes");
+      const auto naxes = axes.size();
+      raise::ErrorIf((naxes == 0) or (naxes > 3),
+                     "histogram " + label + " must have 1 to 3 axes",
+                     HERE);
+      const auto nbins = toml::find<std::vector<std::size_t>>(hist, "n_bins");
+      const auto min   = toml::find<std::vector<real_t>>(hist, "min");
+      const auto max   = toml::find<std::vector<real_t>>(hist, "max");
+      const auto logs  = toml::find_or<std::vector<bool>>(hist,
+                                                         "log_bins",
+                                                         std::vector<bool>(naxes,
+                                                                           false));
+      raise::ErrorIf((nbins.size() != naxes) or (min.size() != naxes) or
+                       (max.size() != naxes) or (logs.size() != naxes),
+                     "histogram " + label +
+                       ": `n_bins`, `min`, `max` & `log_bins` must have one "
+                       "entry per axis",
+                     HERE);
+      std::vector<std::string>    axes_lower;
+      std::vector<unsigned short> log_flags;
+      for (auto d { 0u }; d < naxes; ++d) {
+        const auto axis = fmt::toLower(axes[d]);
+        raise::ErrorIf(not SpecAxis::contains(axis.c_str()),
+                       "histogram " + label + ": unknown axis " + axes[d],
+                       HERE);
+        raise::ErrorIf(std::find(axes_lower.begin(), axes_lower.end(), axis) !=
+                         axes_lower.end(),
+                       "histogram " + label + ": duplicate axis " + axes[d],
+                       HERE);
+        const auto axis_enum = SpecAxis::pick(axis.c_str());
+        raise::ErrorIf(((axis_enum == SpecAxis::X2) and (dim == Dim::_1D)) or
+                         ((axis_enum == SpecAxis::X3) and (dim != Dim::_3D)),
+                       "histogram " + label + ": axis " + axes[d] +
+                         " not available in this dimension",
+                       HERE);
+        raise::ErrorIf(((axis_enum == SpecAxis::Upar) or
+                        (axis_enum == SpecAxis::Uperp) or
+                        (axis_enum == SpecAxis::Pitch)) and
+                         (engine_enum != SimEngine::SRPIC),
+                       "histogram " + label + ": field-aligned axes are only "
+                                              "available for SRPIC",
+                       HERE);
+        raise::ErrorIf(nbins[d] == 0,
+                       "histogram " + label + ": `n_bins` must be > 0",
+                       HERE);
+        raise::ErrorIf(not(max[d] > min[d]),
+                       "histogram " + label + ": `max` must be > `min`",
+                       HERE);
+        raise::ErrorIf(logs[d] and (min[d] <= ZERO),
+                       "histogram " + label + ": `min` must be > 0 for log bins",
+                       HERE);
+        axes_lower.push_back(axis);
+        log_flags.push_back(logs[d] ? 1 : 0);
+      }
+      const auto species = toml::find_or(hist, "species", std::vector<spidx_t> {});
+      for (const auto& sp : species) {
+        raise::ErrorIf((sp == 0) or (sp > nspec),
+                       "histogram " + label + ": invalid species index " +
+                         std::to_string(sp),
+                       HERE);
+      }
+      hist_labels.push_back(label);
+      hist_species.push_back(species);
+      hist_axes.push_back(axes_lower);
+      hist_nbins.push_back(nbins);
+      hist_min.push_back(min);
+      hist_max.push_back(max);
+      hist_log.push_back(log_flags);
+    }
+    set("output.spectra.histograms.labels", hist_labels);
+    set("output.spectra.histograms.species", hist_species);
+    set("output.spectra.histograms.axes", hist_axes);
+    set("output.spectra.histograms.n_bins", hist_nbins);
+    set("output.spectra.histograms.min", hist_min);
+    set("output.spectra.histograms.max", hist_max);
+    set("output.spectra.histograms.log_bins", hist_log);
 
     // stats
     set("output.stats.quantities",
@@ -754,6 +1076,29 @@ namespace ntt {
     set("checkpoint.write_path", checkpoint_write_path);
     set("checkpoint.read_path",
         toml::find_or(toml_data, "checkpoint", "read_path", checkpoint_write_path));
+    set("checkpoint.local.path",
+        toml::find_or<std::string>(toml_data, "checkpoint", "local", "path", ""));
+    set("checkpoint.local.interval",
+        toml::find_or(toml_data,
+                      "checkpoint",
+                      "local",
+                      "interval",
+                      defaults::checkpoint::local::interval));
+    set("checkpoint.local.interval_time",
+        toml::find_or<simtime_t>(toml_data,
+                                 "checkpoint",
+                                 "local",
+                                 "interval_time",
+                                 -1.0));
+    set("checkpoint.local.keep",
+        toml::find_or(toml_data,
+                      "checkpoint",
+                      "local",
+                      "keep",
+                      defaults::checkpoint::local::keep));
+    raise::ErrorIf(get<int>("checkpoint.local.keep") < 1,
+                   "checkpoint.local.keep must be at least 1",
+                   HERE);
 
     /* [diagnostics] -------------------------------------------------------- */
     set("diagnostics.interval",
@@ -1104,6 +1449,78 @@ namespace ntt {
                    HERE);
   }
 
+  EngineParams::EngineParams(const SimulationParams& params) {
+    toggles.fieldsolver = params.get<bool>("algorithms.toggles.fieldsolver");
+    toggles.deposit     = params.get<bool>("algorithms.toggles.deposit");
+
+    deposit.tiled     = params.get<bool>("algorithms.deposit.tiled");
+    deposit.tile_size = params.get<unsigned short>("algorithms.deposit.tile_size");
+    deposit.fused     = params.get<bool>("algorithms.deposit.fused");
+
+    gather.colocated = params.get<bool>("algorithms.gather.colocated");
+
+    pusher.vectorized = params.get<bool>("algorithms.pusher.vectorized");
+
+    fieldsolver.delta_x = params.get<real_t>("algorithms.fieldsolver.delta_x");
+    fieldsolver.delta_y = params.get<real_t>("algorithms.fieldsolver.delta_y");
+    fieldsolver.delta_z = params.get<real_t>("algorithms.fieldsolver.delta_z");
+    fieldsolver.beta_xy = params.get<real_t>("algorithms.fieldsolver.beta_xy");
+    fieldsolver.beta_yx = params.get<real_t>("algorithms.fieldsolver.beta_yx");
+    fieldsolver.beta_xz = params.get<real_t>("algorithms.fieldsolver.beta_xz");
+    fieldsolver.beta_zx = params.get<real_t>("algorithms.fieldsolver.beta_zx");
+    fieldsolver.beta_yz = params.get<real_t>("algorithms.fieldsolver.beta_yz");
+    fieldsolver.beta_zy = params.get<real_t>("algorithms.fieldsolver.beta_zy");
+    fieldsolver.overlap_comm = params.get<bool>(
+      "algorithms.fieldsolver.overlap_comm");
+
+    current_filters = params.get<unsigned short>("algorithms.current_filters");
+    correction      = params.get<real_t>("algorithms.timestep.correction");
+
+    if (params.contains("algorithms.gca.larmor_max")) {
+      gca.larmor_max  = params.get<real_t>("algorithms.gca.larmor_max");
+      gca.e_ovr_b_max = params.get<real_t>("algorithms.gca.e_ovr_b_max");
+    }
+    if (params.contains("algorithms.synchrotron.gamma_rad")) {
+      cooling.synchrotron_gamma_rad = params.get<real_t>(
+        "algorithms.synchrotron.gamma_rad");
+    }
+    if (params.contains("algorithms.compton.gamma_rad")) {
+      cooling.compton_gamma_rad = params.get<real_t>(
+        "algorithms.compton.gamma_rad");
+    }
+    if (params.contains("algorithms.gr.pusher_eps")) {
+      gr.pusher_eps   = params.get<real_t>("algorithms.gr.pusher_eps");
+      gr.pusher_niter = params.get<unsigned short>("algorithms.gr.pusher_niter");
+    }
+
+    scales.q0      = params.get<real_t>("scales.q0");
+    scales.n0      = params.get<real_t>("scales.n0");
+    scales.B0      = params.get<real_t>("scales.B0");
+    scales.V0      = params.get<real_t>("scales.V0");
+    scales.omegaB0 = params.get<real_t>("scales.omegaB0");
+
+    particles.ppc0           = params.get<real_t>("particles.ppc0");
+    particles.clear_interval = params.get<timestep_t>("particles.clear_interval");
+    particles.sort_interval  = params.get<timestep_t>("particles.sort_interval");
+    particles.sort_tile      = params.get<ncells_t>("particles.sort_tile");
+    particles.sort_morton    = params.get<bool>("particles.sort_morton");
+
+    if (params.contains("grid.boundaries.match.ds")) {
+      match_ds = params.get<boundaries_t<real_t>>("grid.boundaries.match.ds");
+    }
+    if (params.contains("grid.boundaries.atmosphere.temperature")) {
+      atmosphere.temperature = params.get<real_t>(
+        "grid.boundaries.atmosphere.temperature");
+      atmosphere.density = params.get<real_t>(
+        "grid.boundaries.atmosphere.density");
+      atmosphere.height = params.get<real_t>("grid.boundaries.atmosphere.height");
+      atmosphere.ds     = params.get<real_t>("grid.boundaries.atmosphere.ds");
+      atmosphere.g      = params.get<real_t>("grid.boundaries.atmosphere.g");
+      atmosphere.species = params.get<std::pair<spidx_t, spidx_t>>(
+        "grid.boundaries.atmosphere.species");
+    }
+  }
+
   void SimulationParams::saveTOML(const std::string& path, simtime_t time) const {
     CallOnce([&]() {
       std::ofstream metadata;
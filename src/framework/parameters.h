@@ -3,6 +3,7 @@
  * @brief Structure for defining and holding initial simulation parameters
  * @implements
  *   - ntt::SimulationParams : ntt::Parameters
+ *   - ntt::EngineParams
  * @cpp:
  *   - parameters.cpp
  * @namespaces:
@@ -17,10 +18,14 @@
 #ifndef FRAMEWORK_PARAMETERS_H
 #define FRAMEWORK_PARAMETERS_H
 
+#include "global.h"
+
+#include "utils/numeric.h"
 #include "utils/param_container.h"
 #include "utils/toml.h"
 
 #include <string>
+#include <utility>
 
 namespace ntt {
 
@@ -60,6 +65,86 @@ namespace ntt {
     toml::value raw_data;
   };
 
+  /**
+   * @brief Typed snapshot of the parameters read by the engines every timestep
+   * @note Compiled once from the (fully defined) `SimulationParams`, so that the
+   * algorithm substeps do not go through the string-keyed container
+   * @note Parameters not defined for the given setup (e.g., atmosphere
+   * boundaries, or GR-only ones for SRPIC) are left zero-initialized
+   */
+  struct EngineParams {
+    struct {
+      bool fieldsolver { false };
+      bool deposit { false };
+    } toggles;
+
+    struct {
+      bool           tiled { false };
+      unsigned short tile_size { 0 };
+      bool           fused { false };
+    } deposit;
+
+    struct {
+      bool colocated { false };
+    } gather;
+
+    struct {
+      bool vectorized { false };
+    } pusher;
+
+    struct {
+      real_t delta_x { ZERO }, delta_y { ZERO }, delta_z { ZERO };
+      real_t beta_xy { ZERO }, beta_yx { ZERO };
+      real_t beta_xz { ZERO }, beta_zx { ZERO };
+      real_t beta_yz { ZERO }, beta_zy { ZERO };
+      bool   overlap_comm { false };
+    } fieldsolver;
+
+    unsigned short current_filters { 0 };
+    // timestep correction
+    real_t         correction { ONE };
+
+    struct {
+      real_t larmor_max { ZERO };
+      real_t e_ovr_b_max { ZERO };
+    } gca;
+
+    struct {
+      real_t synchrotron_gamma_rad { ZERO };
+      real_t compton_gamma_rad { ZERO };
+    } cooling;
+
+    struct {
+      real_t         pusher_eps { ZERO };
+      unsigned short pusher_niter { 0 };
+    } gr;
+
+    struct {
+      real_t q0 { ZERO }, n0 { ZERO }, B0 { ZERO }, V0 { ZERO };
+      real_t omegaB0 { ZERO };
+    } scales;
+
+    struct {
+      real_t     ppc0 { ZERO };
+      timestep_t clear_interval { 0 };
+      timestep_t sort_interval { 0 };
+      ncells_t   sort_tile { 1 };
+      bool       sort_morton { false };
+    } particles;
+
+    // [grid.boundaries.match]
+    boundaries_t<real_t> match_ds;
+
+    struct {
+      real_t                       temperature { ZERO }, density { ZERO };
+      real_t                       height { ZERO }, ds { ZERO }, g { ZERO };
+      std::pair<spidx_t, spidx_t> species { 0, 0 };
+    } atmosphere;
+
+    EngineParams() = default;
+    explicit EngineParams(const SimulationParams&);
+  };
+
 } // namespace ntt
 
 #endif // FRAMEWORK_PARAMETERS_H
@@ -0,0 +1,278 @@
+#include "enums.h"
+#include "global.h"
+
+#include "arch/kokkos_aliases.h"
+#include "utils/error.h"
+#include "utils/formatting.h"
+#include "utils/toml.h"
+
+#include "metrics/minkowski.h"
+
+#include "framework/containers/species.h"
+#include "framework/domain/metadomain.h"
+#include "framework/parameters.h"
+
+#include <Kokkos_Core.hpp>
+#include <adios2.h>
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace ntt;
+using namespace metric;
+
+using metadomain_t = Metadomain<SimEngine::SRPIC, Minkowski<Dim::_2D>>;
+
+const std::string ckpt_root = "checkpoint-test.ckpt";
+
+void cleanup() {
+  namespace fs = std::filesystem;
+  fs::remove_all(fs::path { ckpt_root });
+}
+
+// value of the field component `c` at a (global, ghost-excluded) cell
+auto field_value(int i1, int i2, int c) -> real_t {
+  return static_cast<real_t>(c) + HALF * static_cast<real_t>(i1) -
+         (real_t)(0.25) * static_cast<real_t>(i2);
+}
+
+struct Totals {
+  npart_t npart { 0 };
+  double  weight { 0.0 };
+  // weighted sum of the global coordinates
+  double  x1 { 0.0 }, x2 { 0.0 };
+};
+
+/*
+ * sums over the particles of all the domains (also checks that the
+ * particles lie within their domains)
+ */
+auto particleTotals(metadomain_t& metadomain) -> Totals {
+  Totals totals;
+  for (auto idx { 0u }; idx < metadomain.ndomains(); ++idx) {
+    auto*       domain  = metadomain.subdomain_ptr(idx);
+    const auto  offset  = domain->offset_ncells();
+    const auto  ncells  = domain->mesh.n_active();
+    const auto& species = domain->species[0];
+    auto        i1_h    = Kokkos::create_mirror_view(species.i1);
+    auto        i2_h    = Kokkos::create_mirror_view(species.i2);
+    auto        dx1_h   = Kokkos::create_mirror_view(species.dx1);
+    auto        dx2_h   = Kokkos::create_mirror_view(species.dx2);
+    auto        w_h     = Kokkos::create_mirror_view(species.weight);
+    auto        tag_h   = Kokkos::create_mirror_view(species.tag);
+    Kokkos::deep_copy(i1_h, species.i1);
+    Kokkos::deep_copy(i2_h, species.i2);
+    Kokkos::deep_copy(dx1_h, species.dx1);
+    Kokkos::deep_copy(dx2_h, species.dx2);
+    Kokkos::deep_copy(w_h, species.weight);
+    Kokkos::deep_copy(tag_h, species.tag);
+    for (npart_t p { 0 }; p < species.npart(); ++p) {
+      raise::ErrorIf(tag_h(p) != ParticleTag::alive,
+                     "Restored particle is not alive",
+                     HERE);
+      raise::ErrorIf((i1_h(p) < 0) or (i1_h(p) >= (int)ncells[0]) or
+                       (i2_h(p) < 0) or (i2_h(p) >= (int)ncells[1]),
+                     fmt::format("Particle outside of domain #%u", idx),
+                     HERE);
+      const auto x1  = static_cast<double>(offset[0] + i1_h(p)) + dx1_h(p);
+      const auto x2  = static_cast<double>(offset[1] + i2_h(p)) + dx2_h(p);
+      totals.npart  += 1;
+      totals.weight += w_h(p);
+      totals.x1     += w_h(p) * x1;
+      totals.x2     += w_h(p) * x2;
+    }
+  }
+  return totals;
+}
+
+/*
+ * a checkpoint written with one domain decomposition is restarted with
+ * another one: the fields should match cell by cell (including the ghost
+ * cells), the particles should be redistributed without losses
+ */
+void testElasticRestart(const std::vector<ncells_t>& res,
+                        const std::vector<int>&      decomp_write,
+                        const std::vector<int>&      decomp_read) {
+  const boundaries_t<real_t> extent {
+    { 0.0, (real_t)(res[0]) },
+    { 0.0, (real_t)(res[1]) }
+  };
+  const boundaries_t<FldsBC> fldsbc {
+    { FldsBC::PERIODIC, FldsBC::PERIODIC },
+    { FldsBC::PERIODIC, FldsBC::PERIODIC }
+  };
+  const boundaries_t<PrtlBC> prtlbc {
+    { PrtlBC::PERIODIC, PrtlBC::PERIODIC },
+    { PrtlBC::PERIODIC, PrtlBC::PERIODIC }
+  };
+  const auto species = std::vector<ParticleSpecies> {
+    ParticleSpecies(1u,
+                    "e-",
+                    1.0,
+                    -1.0,
+                    4000,
+                    PrtlPusher::BORIS,
+                    false,
+                    false,
+                    Cooling::NONE)
+  };
+  const auto ndomains_of = [](const std::vector<int>& decomp) -> unsigned int {
+    return static_cast<unsigned int>(decomp[0] * decomp[1]);
+  };
+
+  auto params = SimulationParams();
+  params.set("checkpoint.write_path", ckpt_root);
+  params.set("checkpoint.read_path", ckpt_root);
+  params.set("checkpoint.interval", (timestep_t)1);
+  params.set("checkpoint.interval_time", (simtime_t)(-1.0));
+  params.set("checkpoint.keep", 1);
+  params.set("checkpoint.walltime", std::string { "00:00:00" });
+  params.set("checkpoint.local.path", std::string { "" });
+  params.set("checkpoint.start_step", (timestep_t)10);
+  params.setRawData(toml::table {});
+
+  adios2::ADIOS adios;
+  Totals        written;
+
+  {
+    metadomain_t metadomain { ndomains_of(decomp_write),
+                              decomp_write,
+                              res,
+                              extent,
+                              fldsbc,
+                              prtlbc,
+                              {},
+                              species };
+    for (auto idx { 0u }; idx < metadomain.ndomains(); ++idx) {
+      auto*      domain = metadomain.subdomain_ptr(idx);
+      const auto offset = domain->offset_ncells();
+      // fields (including the ghost cells) in the global coordinates
+      auto       em_h   = Kokkos::create_mirror_view(domain->fields.em);
+      for (auto i1 { 0u }; i1 < domain->mesh.n_all()[0]; ++i1) {
+        for (auto i2 { 0u }; i2 < domain->mesh.n_all()[1]; ++i2) {
+          for (auto c { 0 }; c < 6; ++c) {
+            em_h(i1, i2, c) = field_value((int)(offset[0] + i1) - N_GHOSTS,
+                                          (int)(offset[1] + i2) - N_GHOSTS,
+                                          c);
+          }
+        }
+      }
+      Kokkos::deep_copy(domain->fields.em, em_h);
+
+      // particles scattered over the domain (a different # in each)
+      auto&         prtls  = domain->species[0];
+      const auto    ncells = domain->mesh.n_active();
+      const npart_t npart  = 150 + 20 * idx;
+      auto          i1_h   = Kokkos::create_mirror_view(prtls.i1);
+      auto          i2_h   = Kokkos::create_mirror_view(prtls.i2);
+      auto          dx1_h  = Kokkos::create_mirror_view(prtls.dx1);
+      auto          dx2_h  = Kokkos::create_mirror_view(prtls.dx2);
+      auto          ux1_h  = Kokkos::create_mirror_view(prtls.ux1);
+      auto          w_h    = Kokkos::create_mirror_view(prtls.weight);
+      auto          tag_h  = Kokkos::create_mirror_view(prtls.tag);
+      for (npart_t p { 0 }; p < npart; ++p) {
+        i1_h(p)  = static_cast<int>((p * 37 + 11 * idx) % ncells[0]);
+        i2_h(p)  = static_cast<int>((p * 53 + 7 * idx) % ncells[1]);
+        dx1_h(p) = static_cast<prtldx_t>((p * 7) % 10) / (prtldx_t)(10.0);
+        dx2_h(p) = static_cast<prtldx_t>((p * 3) % 10) / (prtldx_t)(10.0);
+        ux1_h(p) = static_cast<real_t>(p);
+        w_h(p)   = HALF + static_cast<real_t>((p + idx) % 13);
+        tag_h(p) = ParticleTag::alive;
+      }
+      Kokkos::deep_copy(prtls.i1, i1_h);
+      Kokkos::deep_copy(prtls.i2, i2_h);
+      Kokkos::deep_copy(prtls.dx1, dx1_h);
+      Kokkos::deep_copy(prtls.dx2, dx2_h);
+      Kokkos::deep_copy(prtls.ux1, ux1_h);
+      Kokkos::deep_copy(prtls.weight, w_h);
+      Kokkos::deep_copy(prtls.tag, tag_h);
+      prtls.set_npart(npart);
+    }
+    written = particleTotals(metadomain);
+
+    metadomain.InitCheckpointWriter(&adios, params);
+    raise::ErrorIf(not metadomain.WriteCheckpoint(params, 10, 9, 1.0, 0.9),
+                   "Checkpoint not written",
+                   HERE);
+  }
+
+  {
+    metadomain_t metadomain { ndomains_of(decomp_read),
+                              decomp_read,
+                              res,
+                              extent,
+                              fldsbc,
+                              prtlbc,
+                              {},
+                              species };
+    const auto ndomains_write = std::vector<unsigned int> {
+      static_cast<unsigned int>(decomp_write[0]),
+      static_cast<unsigned int>(decomp_write[1])
+    };
+    raise::ErrorIf(metadomain.ndomains_per_dim() == ndomains_write,
+                   "The decompositions should differ",
+                   HERE);
+    metadomain.ContinueFromCheckpoint(&adios, params);
+
+    std::size_t nwrong { 0 };
+    for (auto idx { 0u }; idx < metadomain.ndomains(); ++idx) {
+      auto*      domain = metadomain.subdomain_ptr(idx);
+      const auto offset = domain->offset_ncells();
+      auto       em_h   = Kokkos::create_mirror_view(domain->fields.em);
+      Kokkos::deep_copy(em_h, domain->fields.em);
+      for (auto i1 { 0u }; i1 < domain->mesh.n_all()[0]; ++i1) {
+        for (auto i2 { 0u }; i2 < domain->mesh.n_all()[1]; ++i2) {
+          for (auto c { 0 }; c < 6; ++c) {
+            nwrong += (em_h(i1, i2, c) !=
+                       field_value((int)(offset[0] + i1) - N_GHOSTS,
+                                   (int)(offset[1] + i2) - N_GHOSTS,
+                                   c));
+          }
+        }
+      }
+    }
+    raise::ErrorIf(nwrong != 0,
+                   fmt::format("Fields differ after restart in %zu cells",
+                               nwrong),
+                   HERE);
+
+    const auto read = particleTotals(metadomain);
+    raise::ErrorIf(read.npart != written.npart,
+                   fmt::format("# of particles not conserved: %lu != %lu",
+                               read.npart,
+                               written.npart),
+                   HERE);
+    const auto close = [](double a, double b) -> bool {
+      return std::abs(a - b) <= 1e-6 * std::max(std::abs(a), std::abs(b));
+    };
+    raise::ErrorIf(not close(read.weight, written.weight),
+                   "Total weight not conserved",
+                   HERE);
+    raise::ErrorIf(not close(read.x1, written.x1) or
+                     not close(read.x2, written.x2),
+                   "Particle positions not conserved",
+                   HERE);
+  }
+  cleanup();
+}
+
+auto main(int argc, char* argv[]) -> int {
+  Kokkos::initialize(argc, argv);
+  try {
+    testElasticRestart({ 36, 24 }, { 2, 2 }, { 3, 1 });
+    testElasticRestart({ 36, 24 }, { 3, 1 }, { 1, 4 });
+  } catch (std::exception& e) {
+    std::cerr << e.what() << std::endl;
+    cleanup();
+    Kokkos::finalize();
+    return 1;
+  }
+  Kokkos::finalize();
+  return 0;
+}
@@ -27,6 +27,7 @@ auto main(int argc, char* argv[]) -> int {
 
     const ncells_t nx1 = 11, nx2 = 15;
     ndfield_t<Dim::_2D, 3> fld { "fld", nx1 + 2 * N_GHOSTS, nx2 + 2 * N_GHOSTS };
+    CommBufferPool         pool;
 
     Kokkos::parallel_for(
       "Fill",
@@ -67,7 +68,9 @@ auto main(int argc, char* argv[]) -> int {
                                           send_slice,
                                           recv_slice,
                                           comp_slice,
-                                          false);
+                                          false,
+                                          pool,
+                                          { "fld", (unsigned int)(rank), 1 });
     }
     {
       // recv right, send left
@@ -95,7 +98,9 @@ auto main(int argc, char* argv[]) -> int {
                                           send_slice,
                                           recv_slice,
                                           comp_slice,
-                                          false);
+                                          false,
+                                          pool,
+                                          { "fld", (unsigned int)(rank), -1 });
     }
 
     {
@@ -170,7 +175,9 @@ auto main(int argc, char* argv[]) -> int {
                                           send_slice,
                                           recv_slice,
                                           comp_slice,
-                                          true);
+                                          true,
+                                          pool,
+                                          { "fld", (unsigned int)(rank), 1 });
     }
     {
       // recv right, send left
@@ -198,7 +205,9 @@ auto main(int argc, char* argv[]) -> int {
                                           send_slice,
                                           recv_slice,
                                           comp_slice,
-                                          true);
+                                          true,
+                                          pool,
+                                          { "fld", (unsigned int)(rank), -1 });
     }
 
     {
@@ -231,6 +240,11 @@ auto main(int argc, char* argv[]) -> int {
           }
         });
     }
+
+    // one send & one recv buffer per direction, reused in both exchanges
+    raise::ErrorIf((size > 1) and (pool.nbuffers() != 4),
+                   "Communication buffers are not reused",
+                   HERE);
   } catch (std::exception& e) {
     std::cerr << "Exception: " << e.what() << std::endl;
     MPI_Finalize();
@@ -19,6 +19,7 @@ auto main(int argc, char* argv[]) -> int {
     const std::size_t nx1 = 15, nx2 = 15;
     ndfield_t<Dim::_2D, 3> fld { "fld", nx1 + 2 * N_GHOSTS, nx2 + 2 * N_GHOSTS };
     ndfield_t<Dim::_2D, 3> buff { "buff", nx1 + 2 * N_GHOSTS, nx2 + 2 * N_GHOSTS };
+    CommBufferPool         pool;
 
     Kokkos::parallel_for(
       "Fill",
@@ -108,7 +109,9 @@ auto main(int argc, char* argv[]) -> int {
                                           send_slice,
                                           recv_slice,
                                           comp_slice,
-                                          true);
+                                          true,
+                                          pool,
+                                          { "fld", 0u, direction.hash() });
     }
     // add buffers
     Kokkos::parallel_for(
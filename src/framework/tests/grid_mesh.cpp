@@ -41,6 +41,35 @@ auto main(int argc, char* argv[]) -> int {
       not cmp::AlmostEqual(mesh.metric.dxMin(), (real_t)(0.2 / std::sqrt(3.0))),
       "dxMin wrong",
       HERE);
+
+    // interior + boundary layer cover all the active cells exactly once
+    Kokkos::View<int***> hits { "hits",
+                                mesh.n_all(in::x1),
+                                mesh.n_all(in::x2),
+                                mesh.n_all(in::x3) };
+    auto ranges = mesh.rangesBoundaryLayer();
+    ranges.push_back(mesh.rangeInteriorCells());
+    raise::ErrorIf(ranges.size() != 7, "wrong number of ranges", HERE);
+    for (const auto& range : ranges) {
+      Kokkos::parallel_for(
+        "Hit",
+        range,
+        Lambda(index_t i1, index_t i2, index_t i3) { hits(i1, i2, i3) += 1; });
+    }
+    std::size_t nwrong = 0;
+    Kokkos::parallel_reduce(
+      "CountHits",
+      mesh.rangeAllCells(),
+      Lambda(index_t i1, index_t i2, index_t i3, std::size_t & nw) {
+        const auto is_active = (i1 >= N_GHOSTS) and (i1 < 10 + N_GHOSTS) and
+                               (i2 >= N_GHOSTS) and (i2 < 10 + N_GHOSTS) and
+                               (i3 >= N_GHOSTS) and (i3 < 10 + N_GHOSTS);
+        if (hits(i1, i2, i3) != (is_active ? 1 : 0)) {
+          nw += 1;
+        }
+      },
+      nwrong);
+    raise::ErrorIf(nwrong != 0, "boundary layer & interior ranges wrong", HERE);
   } catch (const std::exception& e) {
     std::cerr << e.what() << std::endl;
     Kokkos::finalize();
@@ -4,9 +4,12 @@
 #include "global.h"
 
 #include "utils/error.h"
+#include "utils/sorting.h"
 
+#include <algorithm>
 #include <iostream>
 #include <string>
+#include <vector>
 
 template <Dimension D, ntt::Coord::type C>
 void testParticles(int                    index,
@@ -106,6 +109,262 @@ void testParticles(int                    index,
   }
 }
 
+template <Dimension D, ntt::Coord::type C>
+void testLeanParticles(std::size_t maxnpart) {
+  using namespace ntt;
+  auto full = Particles<D, C>(1,
+                              "e-",
+                              1.0,
+                              -1.0,
+                              maxnpart,
+                              PrtlPusher::BORIS,
+                              false,
+                              false,
+                              Cooling::NONE);
+  auto lean = Particles<D, C>(1,
+                              "e-",
+                              1.0,
+                              -1.0,
+                              maxnpart,
+                              PrtlPusher::BORIS,
+                              false,
+                              false,
+                              Cooling::NONE,
+                              0,
+                              0,
+                              false);
+  raise::ErrorIf(not full.store_prev() or lean.store_prev(),
+                 "store_prev mismatch",
+                 HERE);
+  raise::ErrorIf(lean.i1.extent(0) != maxnpart, "i1 incorrectly allocated", HERE);
+  raise::ErrorIf(lean.i1_prev.extent(0) != 0 or lean.dx1_prev.extent(0) != 0 or
+                   lean.i2_prev.extent(0) != 0 or lean.dx2_prev.extent(0) != 0 or
+                   lean.i3_prev.extent(0) != 0 or lean.dx3_prev.extent(0) != 0,
+                 "prev arrays allocated in lean layout",
+                 HERE);
+  const auto saved = maxnpart * static_cast<std::size_t>(D) *
+                     (sizeof(int) + sizeof(prtldx_t));
+  raise::ErrorIf(full.memory_footprint() - lean.memory_footprint() != saved,
+                 "lean layout memory footprint mismatch",
+                 HERE);
+}
+
+template <Dimension D, ntt::Coord::type C>
+void testSortByCell(const std::vector<ncells_t>& ncells,
+                    ncells_t                     tile,
+                    bool                         morton) {
+  using namespace ntt;
+  const npart_t npart = 1000;
+  auto          p     = Particles<D, C>(1,
+                                   "e-",
+                                   1.0,
+                                   -1.0,
+                                   npart,
+                                   PrtlPusher::BORIS,
+                                   false,
+                                   false,
+                                   Cooling::NONE,
+                                   1,
+                                   1);
+  // key of the tile a particle belongs to (same as in `SortByCell`)
+  const auto key = [&](int i1, int i2, int i3) -> unsigned int {
+    unsigned int c[3] { 0u, 0u, 0u };
+    const int    i[3] { i1, i2, i3 };
+    ncells_t     nt[3] { 1, 1, 1 };
+    for (auto d { 0u }; d < static_cast<unsigned short>(D); ++d) {
+      const auto n = static_cast<int>(ncells[d]);
+      c[d]         = std::min(std::max(i[d], 0), n - 1) / static_cast<int>(tile);
+      nt[d]        = (ncells[d] + tile - 1) / tile;
+    }
+    if (morton) {
+      return sort::morton(static_cast<unsigned short>(D), c[0], c[1], c[2]);
+    }
+    return c[0] + nt[0] * (c[1] + nt[1] * c[2]);
+  };
+
+  // particles are identified by their `ux1` (i.e., the original index)
+  std::vector<int>    i_orig[3], i_prev_orig[3];
+  std::vector<real_t> dx_orig[3];
+  {
+    auto i1_h      = Kokkos::create_mirror_view(p.i1);
+    auto i2_h      = Kokkos::create_mirror_view(p.i2);
+    auto i3_h      = Kokkos::create_mirror_view(p.i3);
+    auto i1_prev_h = Kokkos::create_mirror_view(p.i1_prev);
+    auto i2_prev_h = Kokkos::create_mirror_view(p.i2_prev);
+    auto i3_prev_h = Kokkos::create_mirror_view(p.i3_prev);
+    auto dx1_h     = Kokkos::create_mirror_view(p.dx1);
+    auto dx2_h     = Kokkos::create_mirror_view(p.dx2);
+    auto dx3_h     = Kokkos::create_mirror_view(p.dx3);
+    auto ux1_h     = Kokkos::create_mirror_view(p.ux1);
+    auto ux2_h     = Kokkos::create_mirror_view(p.ux2);
+    auto ux3_h     = Kokkos::create_mirror_view(p.ux3);
+    auto weight_h  = Kokkos::create_mirror_view(p.weight);
+    auto phi_h     = Kokkos::create_mirror_view(p.phi);
+    auto pld_r_h   = Kokkos::create_mirror_view(p.pld_r);
+    auto pld_i_h   = Kokkos::create_mirror_view(p.pld_i);
+    auto tag_h     = Kokkos::create_mirror_view(p.tag);
+    for (npart_t n { 0 }; n < npart; ++n) {
+      // cells in a scrambled order (including the ghost ones)
+      int i[3] { 0, 0, 0 };
+      for (auto d { 0u }; d < static_cast<unsigned short>(D); ++d) {
+        const auto nd = static_cast<int>(ncells[d]) + 2;
+        i[d]          = static_cast<int>((n * (37 + 11 * d) + 5 * d) % nd) - 1;
+        dx_orig[d].push_back(static_cast<real_t>((n * (7 + d)) % 10) / 10.0);
+        i_orig[d].push_back(i[d]);
+        i_prev_orig[d].push_back(i[d] + 1);
+      }
+      if constexpr (D == Dim::_1D or D == Dim::_2D or D == Dim::_3D) {
+        i1_h(n)      = i_orig[0][n];
+        i1_prev_h(n) = i_prev_orig[0][n];
+        dx1_h(n)     = static_cast<prtldx_t>(dx_orig[0][n]);
+      }
+      if constexpr (D == Dim::_2D or D == Dim::_3D) {
+        i2_h(n)      = i_orig[1][n];
+        i2_prev_h(n) = i_prev_orig[1][n];
+        dx2_h(n)     = static_cast<prtldx_t>(dx_orig[1][n]);
+      }
+      if constexpr (D == Dim::_3D) {
+        i3_h(n)      = i_orig[2][n];
+        i3_prev_h(n) = i_prev_orig[2][n];
+        dx3_h(n)     = static_cast<prtldx_t>(dx_orig[2][n]);
+      }
+      ux1_h(n)    = static_cast<real_t>(n);
+      ux2_h(n)    = static_cast<real_t>(2 * n);
+      ux3_h(n)    = static_cast<real_t>(3 * n);
+      weight_h(n) = static_cast<real_t>(n) + 0.5;
+      if constexpr (D == Dim::_2D and C != Coord::Cart) {
+        phi_h(n) = static_cast<real_t>(n) * 0.25;
+      }
+      pld_r_h(n, 0) = -static_cast<real_t>(n);
+      pld_i_h(n, 0) = n + 7;
+      tag_h(n)      = (n % 9 == 4) ? ParticleTag::dead : ParticleTag::alive;
+    }
+    Kokkos::deep_copy(p.i1, i1_h);
+    Kokkos::deep_copy(p.i2, i2_h);
+    Kokkos::deep_copy(p.i3, i3_h);
+    Kokkos::deep_copy(p.i1_prev, i1_prev_h);
+    Kokkos::deep_copy(p.i2_prev, i2_prev_h);
+    Kokkos::deep_copy(p.i3_prev, i3_prev_h);
+    Kokkos::deep_copy(p.dx1, dx1_h);
+    Kokkos::deep_copy(p.dx2, dx2_h);
+    Kokkos::deep_copy(p.dx3, dx3_h);
+    Kokkos::deep_copy(p.ux1, ux1_h);
+    Kokkos::deep_copy(p.ux2, ux2_h);
+    Kokkos::deep_copy(p.ux3, ux3_h);
+    Kokkos::deep_copy(p.weight, weight_h);
+    Kokkos::deep_copy(p.phi, phi_h);
+    Kokkos::deep_copy(p.pld_r, pld_r_h);
+    Kokkos::deep_copy(p.pld_i, pld_i_h);
+    Kokkos::deep_copy(p.tag, tag_h);
+  }
+  p.set_npart(npart);
+  npart_t n_alive = 0;
+  for (npart_t n { 0 }; n < npart; ++n) {
+    n_alive += (n % 9 != 4);
+  }
+
+  p.SortByCell(ncells, tile, morton);
+
+  raise::ErrorIf(not p.is_sorted(), "species not marked as sorted", HERE);
+  raise::ErrorIf(p.npart() != n_alive, "dead particles not removed", HERE);
+
+  auto i1_h      = Kokkos::create_mirror_view(p.i1);
+  auto i2_h      = Kokkos::create_mirror_view(p.i2);
+  auto i3_h      = Kokkos::create_mirror_view(p.i3);
+  auto i1_prev_h = Kokkos::create_mirror_view(p.i1_prev);
+  auto i2_prev_h = Kokkos::create_mirror_view(p.i2_prev);
+  auto i3_prev_h = Kokkos::create_mirror_view(p.i3_prev);
+  auto dx1_h     = Kokkos::create_mirror_view(p.dx1);
+  auto dx2_h     = Kokkos::create_mirror_view(p.dx2);
+  auto dx3_h     = Kokkos::create_mirror_view(p.dx3);
+  auto ux1_h     = Kokkos::create_mirror_view(p.ux1);
+  auto ux2_h     = Kokkos::create_mirror_view(p.ux2);
+  auto ux3_h     = Kokkos::create_mirror_view(p.ux3);
+  auto weight_h  = Kokkos::create_mirror_view(p.weight);
+  auto phi_h     = Kokkos::create_mirror_view(p.phi);
+  auto pld_r_h   = Kokkos::create_mirror_view(p.pld_r);
+  auto pld_i_h   = Kokkos::create_mirror_view(p.pld_i);
+  auto tag_h     = Kokkos::create_mirror_view(p.tag);
+  Kokkos::deep_copy(i1_h, p.i1);
+  Kokkos::deep_copy(i2_h, p.i2);
+  Kokkos::deep_copy(i3_h, p.i3);
+  Kokkos::deep_copy(i1_prev_h, p.i1_prev);
+  Kokkos::deep_copy(i2_prev_h, p.i2_prev);
+  Kokkos::deep_copy(i3_prev_h, p.i3_prev);
+  Kokkos::deep_copy(dx1_h, p.dx1);
+  Kokkos::deep_copy(dx2_h, p.dx2);
+  Kokkos::deep_copy(dx3_h, p.dx3);
+  Kokkos::deep_copy(ux1_h, p.ux1);
+  Kokkos::deep_copy(ux2_h, p.ux2);
+  Kokkos::deep_copy(ux3_h, p.ux3);
+  Kokkos::deep_copy(weight_h, p.weight);
+  Kokkos::deep_copy(phi_h, p.phi);
+  Kokkos::deep_copy(pld_r_h, p.pld_r);
+  Kokkos::deep_copy(pld_i_h, p.pld_i);
+  Kokkos::deep_copy(tag_h, p.tag);
+
+  std::vector<int> seen(npart, 0);
+  unsigned int     key_prev = 0u;
+  for (npart_t n { 0 }; n < n_alive; ++n) {
+    raise::ErrorIf(tag_h(n) != ParticleTag::alive, "dead particle kept", HERE);
+    const auto id = static_cast<npart_t>(ux1_h(n));
+    raise::ErrorIf(id >= npart or (id % 9 == 4), "wrong particle kept", HERE);
+    seen[id] += 1;
+
+    int i[3] { 0, 0, 0 };
+    if constexpr (D == Dim::_1D or D == Dim::_2D or D == Dim::_3D) {
+      i[0] = i1_h(n);
+      raise::ErrorIf(i1_h(n) != i_orig[0][id] or
+                       i1_prev_h(n) != i_prev_orig[0][id] or
+                       dx1_h(n) != static_cast<prtldx_t>(dx_orig[0][id]),
+                     "x1 not permuted consistently",
+                     HERE);
+    }
+    if constexpr (D == Dim::_2D or D == Dim::_3D) {
+      i[1] = i2_h(n);
+      raise::ErrorIf(i2_h(n) != i_orig[1][id] or
+                       i2_prev_h(n) != i_prev_orig[1][id] or
+                       dx2_h(n) != static_cast<prtldx_t>(dx_orig[1][id]),
+                     "x2 not permuted consistently",
+                     HERE);
+    }
+    if constexpr (D == Dim::_3D) {
+      i[2] = i3_h(n);
+      raise::ErrorIf(i3_h(n) != i_orig[2][id] or
+                       i3_prev_h(n) != i_prev_orig[2][id] or
+                       dx3_h(n) != static_cast<prtldx_t>(dx_orig[2][id]),
+                     "x3 not permuted consistently",
+                     HERE);
+    }
+    raise::ErrorIf(ux2_h(n) != static_cast<real_t>(2 * id) or
+                     ux3_h(n) != static_cast<real_t>(3 * id) or
+                     weight_h(n) != static_cast<real_t>(id) + 0.5,
+                   "momenta/weights not permuted consistently",
+                   HERE);
+    if constexpr (D == Dim::_2D and C != Coord::Cart) {
+      raise::ErrorIf(phi_h(n) != static_cast<real_t>(id) * 0.25,
+                     "phi not permuted consistently",
+                     HERE);
+    }
+    raise::ErrorIf(pld_r_h(n, 0) != -static_cast<real_t>(id) or
+                     pld_i_h(n, 0) != id + 7,
+                   "payloads not permuted consistently",
+                   HERE);
+
+    const auto key_n = key(i[0], i[1], i[2]);
+    raise::ErrorIf(n > 0 and key_n < key_prev, "cell keys not sorted", HERE);
+    key_prev = key_n;
+  }
+  for (npart_t id { 0 }; id < npart; ++id) {
+    raise::ErrorIf(seen[id] != ((id % 9 == 4) ? 0 : 1),
+                   "particle lost or duplicated by the sort",
+                   HERE);
+  }
+  for (npart_t n { n_alive }; n < npart; ++n) {
+    raise::ErrorIf(tag_h(n) != ParticleTag::dead, "dead particles not tagged", HERE);
+  }
+}
+
 auto main(int argc, char** argv) -> int {
   Kokkos::initialize(argc, argv);
   try {
@@ -157,6 +416,15 @@ auto main(int argc, char** argv) -> int {
                                          Cooling::NONE,
                                          1,
                                          2);
+    testLeanParticles<Dim::_1D, Coord::Cart>(100);
+    testLeanParticles<Dim::_2D, Coord::Sph>(100);
+    testLeanParticles<Dim::_3D, Coord::Cart>(100);
+    testSortByCell<Dim::_1D, Coord::Cart>({ 64 }, 1, false);
+    testSortByCell<Dim::_2D, Coord::Cart>({ 30, 20 }, 1, false);
+    testSortByCell<Dim::_2D, Coord::Cart>({ 30, 20 }, 4, true);
+    testSortByCell<Dim::_3D, Coord::Cart>({ 10, 12, 8 }, 2, false);
+    testSortByCell<Dim::_3D, Coord::Cart>({ 10, 12, 8 }, 1, true);
+    testSortByCell<Dim::_2D, Coord::Sph>({ 24, 16 }, 4, false);
   } catch (const std::exception& e) {
     std::cerr << "Error: " << e.what() << std::endl;
     Kokkos::finalize();
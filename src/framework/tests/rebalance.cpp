@@ -0,0 +1,168 @@
+#include "global.h"
+
+#include "utils/error.h"
+#include "utils/formatting.h"
+
+#include "framework/domain/rebalance.hpp"
+
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace ntt;
+
+auto boundaries(const std::vector<ncells_t>& ncells) -> std::vector<ncells_t> {
+  std::vector<ncells_t> bounds { 0 };
+  for (const auto& n : ncells) {
+    bounds.push_back(bounds.back() + n);
+  }
+  return bounds;
+}
+
+/*
+ * checks the constraints of the new layout: same total # of cells, domains
+ * not narrower than the minimum, and each boundary within its two adjacent
+ * (old) domains
+ */
+void checkLayout(const std::vector<ncells_t>& ncells,
+                 const std::vector<ncells_t>& new_ncells,
+                 ncells_t                     min_ncells,
+                 const std::string&           label) {
+  raise::ErrorIf(new_ncells.size() != ncells.size(),
+                 label + ": # of domains changed",
+                 HERE);
+  raise::ErrorIf(std::accumulate(new_ncells.begin(), new_ncells.end(), 0ul) !=
+                   std::accumulate(ncells.begin(), ncells.end(), 0ul),
+                 label + ": total # of cells not conserved",
+                 HERE);
+  for (const auto& n : new_ncells) {
+    raise::ErrorIf(n < min_ncells,
+                   fmt::format("%s: domain of %lu < %lu cells",
+                               label.c_str(),
+                               n,
+                               min_ncells),
+                   HERE);
+  }
+  const auto bounds     = boundaries(ncells);
+  const auto new_bounds = boundaries(new_ncells);
+  for (auto k { 1u }; k < ncells.size(); ++k) {
+    raise::ErrorIf((new_bounds[k] <= bounds[k - 1]) or
+                     (new_bounds[k] >= bounds[k + 1]),
+                   fmt::format("%s: boundary #%u left the adjacent domains",
+                               label.c_str(),
+                               k),
+                   HERE);
+  }
+}
+
+/*
+ * the cost is concentrated in the slab `heavy`: all the boundaries move
+ * towards it (at least one strictly), and the heavy domain shrinks
+ */
+void testSkewed(const std::vector<ncells_t>& ncells,
+                std::size_t                  heavy,
+                double                       weight) {
+  constexpr ncells_t min_ncells = 2 * N_GHOSTS;
+  auto               cost       = std::vector<double>(ncells.size(), 1.0);
+  cost[heavy]                   = weight;
+  const auto label = fmt::format("skewed (heavy #%lu, x%.0f)", heavy, weight);
+  const auto new_ncells = BalanceAlongDimension(ncells, cost, min_ncells);
+  checkLayout(ncells, new_ncells, min_ncells, label);
+  raise::ErrorIf(new_ncells == ncells, label + ": layout unchanged", HERE);
+  raise::ErrorIf(new_ncells[heavy] >= ncells[heavy],
+                 label + ": expensive domain did not shrink",
+                 HERE);
+  const auto bounds     = boundaries(ncells);
+  const auto new_bounds = boundaries(new_ncells);
+  for (auto k { 1u }; k < ncells.size(); ++k) {
+    // boundaries below the heavy slab move up, the ones above move down
+    const auto moved_away = (k <= heavy) ? (new_bounds[k] < bounds[k])
+                                         : (new_bounds[k] > bounds[k]);
+    raise::ErrorIf(moved_away,
+                   fmt::format("%s: boundary #%u moved away from the "
+                               "expensive domain",
+                               label.c_str(),
+                               k),
+                   HERE);
+  }
+}
+
+auto main(int argc, char* argv[]) -> int {
+  try {
+    constexpr ncells_t min_ncells = 2 * N_GHOSTS;
+
+    // uniform cost (per slab) leaves the layout unchanged
+    for (const auto& ncells : std::vector<std::vector<ncells_t>> {
+           { 16, 16 },
+           { 10, 10, 10, 10 },
+           { 8, 12, 10, 14 },
+           { 9, 11, 13 }
+    }) {
+      const auto cost = std::vector<double>(ncells.size(), 3.0);
+      raise::ErrorIf(BalanceAlongDimension(ncells, cost, min_ncells) != ncells,
+                     "uniform cost changed the layout",
+                     HERE);
+    }
+
+    // single domain & zero cost
+    raise::ErrorIf(BalanceAlongDimension({ 32 }, { 5.0 }, min_ncells) !=
+                     std::vector<ncells_t> { 32 },
+                   "single domain changed",
+                   HERE);
+    raise::ErrorIf(
+      BalanceAlongDimension({ 16, 16 }, { 0.0, 0.0 }, min_ncells) !=
+        std::vector<ncells_t> { 16, 16 },
+      "zero cost changed the layout",
+      HERE);
+
+    // skewed cost moves the boundaries towards the expensive side
+    testSkewed({ 20, 20, 20, 20 }, 0, 4.0);
+    testSkewed({ 20, 20, 20, 20 }, 3, 4.0);
+    testSkewed({ 20, 20, 20, 20, 20 }, 2, 3.0);
+    testSkewed({ 24, 16, 32 }, 1, 5.0);
+
+    // extreme skew: boundaries are limited by the adjacent domains and
+    // by the minimum width
+    for (const auto& cost : std::vector<std::vector<double>> {
+           { 1e3, 0.0, 0.0, 0.0 },
+           { 0.0, 0.0, 0.0, 1e3 },
+           { 0.0, 1e3, 0.0, 0.0 },
+           { 1e3, 0.0, 0.0, 1e3 }
+    }) {
+      const auto ncells     = std::vector<ncells_t> { 16, 16, 16, 16 };
+      const auto new_ncells = BalanceAlongDimension(ncells, cost, min_ncells);
+      checkLayout(ncells, new_ncells, min_ncells, "extreme skew");
+    }
+
+    // domains already at the minimum width cannot shrink
+    {
+      const auto ncells = std::vector<ncells_t> { min_ncells, min_ncells };
+      raise::ErrorIf(BalanceAlongDimension(ncells, { 5.0, 1.0 }, min_ncells) !=
+                       ncells,
+                     "domains narrower than the minimum",
+                     HERE);
+    }
+
+    // constraints hold for a sweep of cost profiles
+    for (auto ndoms { 2u }; ndoms <= 6; ++ndoms) {
+      for (auto seed { 0u }; seed < 16; ++seed) {
+        std::vector<ncells_t> ncells;
+        std::vector<double>   cost;
+        for (auto k { 0u }; k < ndoms; ++k) {
+          ncells.push_back(min_ncells + (7 * k + 3 * seed) % 11);
+          cost.push_back((double)((5 * k * k + seed) % 9));
+        }
+        checkLayout(ncells,
+                    BalanceAlongDimension(ncells, cost, min_ncells),
+                    min_ncells,
+                    fmt::format("sweep (%u domains, #%u)", ndoms, seed));
+      }
+    }
+  } catch (std::exception& e) {
+    std::cerr << e.what() << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -4,9 +4,11 @@
  * @implements
  *   - ClassLambda, Lambda, Function, Inline macros
  *   - array_t, array_mirror_t, scatter_array_t
+ *   - packed_array_t
  *   - ndarray_t, ndfield_t
  *   - ndfield_mirror_t, scatter_ndfield_t
  *   - range_t, range_h_t
+ *   - team_policy_t, team_member_t, scratch_array_t
  *   - CreateRangePolicy, CreateRangePolicyOnHost
  *   - random_number_pool_t, random_generator_t
  *   - Random function
@@ -39,6 +41,10 @@ using array_t = Kokkos::View<T>;
 template <typename T>
 using array_h_t = Kokkos::View<T, Kokkos::HostSpace>;
 
+// Row-major array alias (contiguous rows on every backend)
+template <typename T>
+using packed_array_t = Kokkos::View<T, Kokkos::LayoutRight>;
+
 // Array mirror alias of arbitrary type
 template <typename T>
 using array_mirror_t = typename array_t<T>::HostMirror;
@@ -222,6 +228,17 @@ namespace kokkos_aliases_hidden {
 template <Dimension D>
 using range_h_t = typename kokkos_aliases_hidden::range_h_impl<D>::type;
 
+// Team policy aliases for the device space (for kernels using scratch memory)
+using team_policy_t = Kokkos::TeamPolicy<Kokkos::DefaultExecutionSpace>;
+using team_member_t = typename team_policy_t::member_type;
+
+// Unmanaged array of arbitrary type in the team scratch memory
+template <typename T>
+using scratch_array_t =
+  Kokkos::View<T,
+               typename Kokkos::DefaultExecutionSpace::scratch_memory_space,
+               Kokkos::MemoryTraits<Kokkos::Unmanaged>>;
+
 /**
  * @brief Function template for generating 1D Kokkos range policy for particles.
  * @param p1 `npart_t`: min.
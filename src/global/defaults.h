@@ -25,6 +25,24 @@ namespace ntt::defaults {
   const std::string em_pusher      = "Boris";
   const std::string ph_pusher      = "Photon";
   const timestep_t  clear_interval = 100;
+  const timestep_t  sort_interval  = 0;
+  const ncells_t    sort_tile      = 1;
+  const bool        sort_morton    = false;
+  const bool        lean_layout    = false;
+
+  namespace deposit {
+    const bool           tiled     = false;
+    const unsigned short tile_size = 8;
+    const bool           fused     = false;
+  } // namespace deposit
+
+  namespace gather {
+    const bool colocated = false;
+  } // namespace gather
+
+  namespace pusher {
+    const bool vectorized = false;
+  } // namespace pusher
 
   namespace fieldsolver {
     const real_t delta_x = 0.0;
@@ -38,6 +56,8 @@ namespace ntt::defaults {
     const real_t beta_zx = 0.0;
     const real_t beta_yz = 0.0;
     const real_t beta_zy = 0.0;
+
+    const bool overlap_comm = false;
   } // namespace fieldsolver
 
   namespace qsph {
@@ -68,7 +88,12 @@ namespace ntt::defaults {
     const std::string              format           = "BPFile";
     const timestep_t               interval         = 100;
     const unsigned short           mom_smooth       = 0;
+    const std::string              dwn_mode         = "sample";
+    const std::string              compression      = "none";
+    const real_t                   compr_accuracy   = 1e-6;
+    const unsigned short           compr_level      = 5;
     const npart_t                  prtl_stride      = 100;
+    const bool                     prtl_packed      = false;
     const real_t                   spec_emin        = 1e-3;
     const real_t                   spec_emax        = 1e3;
     const bool                     spec_log         = true;
@@ -80,11 +105,22 @@ namespace ntt::defaults {
                                                         "T00" };
   } // namespace output
 
+  namespace rebalance {
+    const timestep_t interval    = 0;
+    const real_t     threshold   = 1.2;
+    const real_t     cell_weight = 1.0;
+  } // namespace rebalance
+
   namespace checkpoint {
     const timestep_t  interval   = 1000;
     const int         keep       = 2;
     const std::string walltime   = "00:00:00";
     const std::string write_path = "%s.ckpt";
+
+    namespace local {
+      const timestep_t interval = 100;
+      const int        keep     = 1;
+    } // namespace local
   } // namespace checkpoint
 
   namespace diag {
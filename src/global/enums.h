@@ -16,6 +16,8 @@
  *                                    a, t, rho, charge, n, nppc, v, custom
  *   - enum ntt::StatsID           // b^2, e^2, exb, j.e, t, rho,
  *                                    charge, n, npart
+ *   - enum ntt::Downsampling      // sample, mean, max, min
+ *   - enum ntt::SpecAxis          // energy, upar, uperp, pitch, x1, x2, x3
  * @namespaces:
  *   - ntt::
  * @note Enums of the same type can be compared with each other and with strings
@@ -337,6 +339,47 @@ namespace ntt {
     static constexpr std::size_t total = sizeof(variants) / sizeof(variants[0]);
   };
 
+  struct Downsampling : public enums_hidden::BaseEnum<Downsampling> {
+    static constexpr const char* label = "downsampling";
+
+    enum type : uint8_t {
+      INVALID = 0,
+      SAMPLE  = 1,
+      MEAN    = 2,
+      MAX     = 3,
+      MIN     = 4,
+    };
+
+    constexpr Downsampling(uint8_t c)
+      : enums_hidden::BaseEnum<Downsampling> { c } {}
+
+    static constexpr type        variants[] = { SAMPLE, MEAN, MAX, MIN };
+    static constexpr const char* lookup[]   = { "sample", "mean", "max", "min" };
+    static constexpr std::size_t total = sizeof(variants) / sizeof(variants[0]);
+  };
+
+  struct SpecAxis : public enums_hidden::BaseEnum<SpecAxis> {
+    static constexpr const char* label = "spectra_axis";
+
+    enum type : uint8_t {
+      INVALID = 0,
+      Energy  = 1,
+      Upar    = 2,
+      Uperp   = 3,
+      Pitch   = 4,
+      X1      = 5,
+      X2      = 6,
+      X3      = 7,
+    };
+
+    constexpr SpecAxis(uint8_t c) : enums_hidden::BaseEnum<SpecAxis> { c } {}
+
+    static constexpr type variants[] = { Energy, Upar, Uperp, Pitch, X1, X2, X3 };
+    static constexpr const char* lookup[] = { "energy", "upar", "uperp", "pitch",
+                                              "x1",     "x2",   "x3" };
+    static constexpr std::size_t total = sizeof(variants) / sizeof(variants[0]);
+  };
+
 } // namespace ntt
 
 #endif // GLOBAL_ENUMS_H
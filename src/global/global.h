@@ -3,6 +3,7 @@
  * @brief Global constants, macros, aliases and enums
  * @implements
  *   - ntt::N_GHOSTS
+ *   - macro SHAPE_ORDER
  *   - macro COORD
  *   - macro HERE
  *   - enum Dimension, enum Dim
@@ -12,7 +13,8 @@
  *   - type PrepareOutputFlags
  *   - enum PrepareOutput
  *   - enum CellLayer           // allLayer, activeLayer, minGhostLayer,
- *                                 minActiveLayer, maxActiveLayer, maxGhostLayer
+ *                                 minActiveLayer, maxActiveLayer, maxGhostLayer,
+ *                                 interiorLayer
  *   - enum Idx                // U, D, T, XYZ, Sph, PU, PD
  *   - enum Crd                // Cd, Ph, XYZ, Sph
  *   - enum in                 // x1, x2, x3
@@ -37,6 +39,7 @@
  *   - files::
  * @macros:
  *   - MPI_ENABLED
+ *   - SHAPE_ORDER
  * @note
  * CellLayer enum:
  *
@@ -48,6 +51,7 @@
  * minActiveLayer:           .   |* *              \   .
  * maxActiveLayer:           .   |              * *\   .
  * maxGhostLayer:            .   |                 \* *.
+ * interiorLayer:            .   |    * * * * *    \   .
  *
  * @example
  * Usage of the CellLayer enum:
@@ -111,9 +115,17 @@ namespace files {
   };
 } // namespace files
 
+// Order of the particle shape function (1: CIC, 2: TSC, 3: PQS)
+#if !defined(SHAPE_ORDER)
+  #define SHAPE_ORDER 1
+#endif
+
+static_assert((SHAPE_ORDER >= 1) && (SHAPE_ORDER <= 3), "Invalid SHAPE_ORDER");
+
 namespace ntt {
 
-  inline constexpr std::size_t N_GHOSTS = 2;
+  // higher-order shapes extend by one more cell on each side of the particle
+  inline constexpr std::size_t N_GHOSTS = (SHAPE_ORDER == 1) ? 2 : 3;
 // Coordinate shift to account for ghost cells
 #define COORD(I)                                                               \
   (static_cast<real_t>(static_cast<int>((I)) - static_cast<int>(N_GHOSTS)))
@@ -169,7 +181,8 @@ enum class CellLayer {
   minGhostLayer,
   minActiveLayer,
   maxActiveLayer,
-  maxGhostLayer
+  maxGhostLayer,
+  interiorLayer
 };
 
 enum class Idx {
@@ -232,6 +245,7 @@ namespace Timer {
     PrintPrtlClear  = 1 << 4,
     PrintCheckpoint = 1 << 5,
     PrintNormed     = 1 << 6,
+    PrintPrtlSort   = 1 << 7,
     Default         = PrintNormed | PrintTotal | PrintTitle | AutoConvert,
   };
 } // namespace Timer
@@ -74,6 +74,10 @@ auto main() -> int {
   enum_str_t all_out_stats = { "b^2", "e^2",    "exb", "j.e",   "t",
                                "rho", "charge", "n",   "npart", "custom" };
 
+  enum_str_t all_downsamplings = { "sample", "mean", "max", "min" };
+  enum_str_t all_spec_axes     = { "energy", "upar", "uperp", "pitch",
+                                   "x1",     "x2",   "x3" };
+
   checkEnum<Coord>(all_coords);
   checkEnum<Metric>(all_metrics);
   checkEnum<SimEngine>(all_simulation_engines);
@@ -83,6 +87,8 @@ auto main() -> int {
   checkEnum<Cooling>(all_coolings);
   checkEnum<FldsID>(all_out_flds);
   checkEnum<StatsID>(all_out_stats);
+  checkEnum<Downsampling>(all_downsamplings);
+  checkEnum<SpecAxis>(all_spec_axes);
 
   return 0;
 }
@@ -105,6 +105,43 @@ auto main(int argc, char* argv[]) -> int {
           raise::KernelError(HERE, "Short sort failed");
         }
       });
+
+    // morton indexing
+    raise::ErrorIf(sort::morton(1, 5) != 5, "1D morton index failed", HERE);
+    raise::ErrorIf(sort::morton(2, 1, 0) != 1 or sort::morton(2, 0, 1) != 2 or
+                     sort::morton(2, 1, 1) != 3 or sort::morton(2, 2, 0) != 4 or
+                     sort::morton(2, 3, 3) != 15,
+                   "2D morton index failed",
+                   HERE);
+    raise::ErrorIf(sort::morton(3, 1, 1, 1) != 7 or sort::morton(3, 0, 0, 2) != 32,
+                   "3D morton index failed",
+                   HERE);
+
+    // sort by cell keys
+    constexpr int ncells    = 7;
+    auto          keys_cell = Kokkos::View<int*>("keys_cell", n);
+    Kokkos::parallel_for(
+      n,
+      KOKKOS_LAMBDA(const std::size_t i) {
+        keys_cell(i) = static_cast<int>((n - 1 - i) % ncells);
+        values(i)    = keys_cell(i);
+      });
+
+    using KeyType_cell = Kokkos::View<int*>;
+    using BinOp_cell   = sort::BinCell<KeyType_cell>;
+    Kokkos::BinSort<KeyType_cell, BinOp_cell> sorter_cell(keys_cell,
+                                                          BinOp_cell(ncells),
+                                                          false);
+    sorter_cell.create_permute_vector();
+    sorter_cell.sort(values);
+
+    Kokkos::parallel_for(
+      n - 1,
+      KOKKOS_LAMBDA(const std::size_t i) {
+        if (values(i) > values(i + 1)) {
+          raise::KernelError(HERE, "Cell sort failed");
+        }
+      });
   } catch (const std::exception& e) {
     std::cerr << e.what() << std::endl;
     Kokkos::finalize();
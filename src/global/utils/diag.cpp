@@ -84,6 +84,7 @@ namespace diag {
                         const std::vector<npart_t>&     species_npart,
                         const std::vector<npart_t>&     species_maxnpart,
                         bool                            print_prtl_clear,
+                        bool                            print_prtl_sort,
                         bool                            print_output,
                         bool                            print_checkpoint,
                         bool                            print_colors) {
@@ -98,6 +99,9 @@ namespace diag {
     if (print_prtl_clear) {
       timer_flags |= Timer::PrintPrtlClear;
     }
+    if (print_prtl_sort) {
+      timer_flags |= Timer::PrintPrtlSort;
+    }
     if (print_output) {
       timer_flags |= Timer::PrintOutput;
     }
@@ -35,6 +35,7 @@ namespace diag {
    * @param npart (per each species)
    * @param maxnpart (per each species)
    * @param prtlclear (if true, dead particles were removed)
+   * @param prtlsort (if true, particles were sorted by cells)
    * @param output (if true, output was written)
    * @param checkpoint (if true, checkpoint was written)
    * @param colorful_print (if true, print with colors)
@@ -52,6 +53,7 @@ namespace diag {
                         bool,
                         bool,
                         bool,
+                        bool,
                         bool);
 
 } // namespace diag
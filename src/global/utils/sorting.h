@@ -4,10 +4,13 @@
  * @implements
  *   - sort::BinBool<>
  *   - sort::BinTag<>
+ *   - sort::BinCell<>
+ *   - sort::morton -> unsigned int
  * @namespaces:
  *   - sort::
  * @note BinBool sorts by boolean values "true" then "false"
  * @note BinTag sorts by tag values "1" then "0" then "2" ... "n"
+ * @note BinCell sorts by precomputed non-negative keys (e.g., cell indices)
  */
 
 #ifndef GLOBAL_UTILS_SORTING_H
@@ -58,6 +61,50 @@ namespace sort {
     const int m_max_bins;
   };
 
+  template <class KeyViewType>
+  struct BinCell {
+    BinCell(int max_bins) : m_max_bins { max_bins } {}
+
+    template <class ViewType>
+    Inline auto bin(ViewType& keys, int i) const -> int {
+      return keys(i);
+    }
+
+    Inline auto max_bins() const -> int {
+      return m_max_bins;
+    }
+
+    template <class ViewType, typename iT1, typename iT2>
+    Inline auto operator()(ViewType&, iT1&, iT2&) const -> bool {
+      return false;
+    }
+
+  private:
+    const int m_max_bins;
+  };
+
+  /**
+   * @brief Morton (Z-order) index from the interleaved bits of the coordinates
+   * @param ndim number of dimensions used (1, 2 or 3)
+   * @note Only the lowest 31 / ndim bits of each coordinate are used
+   */
+  Inline auto morton(unsigned short ndim,
+                     unsigned int   x1,
+                     unsigned int   x2 = 0u,
+                     unsigned int   x3 = 0u) -> unsigned int {
+    unsigned int key = 0u;
+    for (auto b { 0u }; (b + 1u) * ndim <= 31u; ++b) {
+      key |= ((x1 >> b) & 1u) << (ndim * b);
+      if (ndim > 1) {
+        key |= ((x2 >> b) & 1u) << (ndim * b + 1u);
+      }
+      if (ndim > 2) {
+        key |= ((x3 >> b) & 1u) << (ndim * b + 2u);
+      }
+    }
+    return key;
+  }
+
 } // namespace sort
 
 #endif // GLOBAL_UTILS_SORTING_H
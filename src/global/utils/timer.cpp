@@ -133,7 +133,10 @@ namespace timer {
   auto Timers::printAll(TimerFlags flags,
                         npart_t    npart,
                         ncells_t   ncells) const -> std::string {
-    const std::vector<std::string> extras { "PrtlClear", "Output", "Checkpoint" };
+    const std::vector<std::string> extras { "PrtlClear",
+                                            "PrtlSort",
+                                            "Output",
+                                            "Checkpoint" };
     const auto stats = gather(extras, npart, ncells);
     if (stats.empty()) {
       return "";
@@ -258,6 +261,7 @@ namespace timer {
 
     // print extra timers for output/checkpoint/prtlClear
     const std::vector<TimerFlags> extras_f { Timer::PrintPrtlClear,
+                                             Timer::PrintPrtlSort,
                                              Timer::PrintOutput,
                                              Timer::PrintCheckpoint };
     for (auto i { 0u }; i < extras.size(); ++i) {
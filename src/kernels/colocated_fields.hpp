@@ -0,0 +1,123 @@
+/**
+ * @file kernels/colocated_fields.hpp
+ * @brief Interpolation of the staggered E & B to the nodes of the grid
+ * @implements
+ *   - kernel::ColocateFields_kernel<>
+ * @namespaces:
+ *   - kernel::
+ * @note
+ * The node values of all 6 components are stored together in one cell
+ * of the output field, so that the particles can then read them with a
+ * single (bi/tri)linear gather instead of the per-component staggered one
+ */
+
+#ifndef KERNELS_COLOCATED_FIELDS_HPP
+#define KERNELS_COLOCATED_FIELDS_HPP
+
+#include "global.h"
+
+#include "arch/kokkos_aliases.h"
+#include "utils/error.h"
+#include "utils/numeric.h"
+
+namespace kernel {
+  using namespace ntt;
+
+  /**
+   * @brief Averages each staggered component to the node (i, j, k)
+   * @note A component is averaged between `i - 1` & `i` along the directions
+   * in which it is dual (i.e., defined at half-integer positions)
+   * @note Requires `i, j, k >= 1`; the ghost cells have to be up-to-date
+   */
+  template <Dimension D>
+  class ColocateFields_kernel {
+    const ndfield_t<D, 6> EB;
+    ndfield_t<D, 6>       EB_node;
+
+  public:
+    ColocateFields_kernel(const ndfield_t<D, 6>& EB, ndfield_t<D, 6>& EB_node)
+      : EB { EB }
+      , EB_node { EB_node } {}
+
+    Inline void operator()(index_t i1) const {
+      if constexpr (D == Dim::_1D) {
+        EB_node(i1, em::ex1) = average<true, false, false>(i1, 0, 0, em::ex1);
+        EB_node(i1, em::ex2) = EB(i1, em::ex2);
+        EB_node(i1, em::ex3) = EB(i1, em::ex3);
+        EB_node(i1, em::bx1) = EB(i1, em::bx1);
+        EB_node(i1, em::bx2) = average<true, false, false>(i1, 0, 0, em::bx2);
+        EB_node(i1, em::bx3) = average<true, false, false>(i1, 0, 0, em::bx3);
+      } else {
+        raise::KernelError(
+          HERE,
+          "ColocateFields_kernel: 1D implementation called for D != 1");
+      }
+    }
+
+    Inline void operator()(index_t i1, index_t i2) const {
+      if constexpr (D == Dim::_2D) {
+        // clang-format off
+        EB_node(i1, i2, em::ex1) = average<true, false, false>(i1, i2, 0, em::ex1);
+        EB_node(i1, i2, em::ex2) = average<false, true, false>(i1, i2, 0, em::ex2);
+        EB_node(i1, i2, em::ex3) = EB(i1, i2, em::ex3);
+        EB_node(i1, i2, em::bx1) = average<false, true, false>(i1, i2, 0, em::bx1);
+        EB_node(i1, i2, em::bx2) = average<true, false, false>(i1, i2, 0, em::bx2);
+        EB_node(i1, i2, em::bx3) = average<true, true, false>(i1, i2, 0, em::bx3);
+        // clang-format on
+      } else {
+        raise::KernelError(
+          HERE,
+          "ColocateFields_kernel: 2D implementation called for D != 2");
+      }
+    }
+
+    Inline void operator()(index_t i1, index_t i2, index_t i3) const {
+      if constexpr (D == Dim::_3D) {
+        // clang-format off
+        EB_node(i1, i2, i3, em::ex1) = average<true, false, false>(i1, i2, i3, em::ex1);
+        EB_node(i1, i2, i3, em::ex2) = average<false, true, false>(i1, i2, i3, em::ex2);
+        EB_node(i1, i2, i3, em::ex3) = average<false, false, true>(i1, i2, i3, em::ex3);
+        EB_node(i1, i2, i3, em::bx1) = average<false, true, true>(i1, i2, i3, em::bx1);
+        EB_node(i1, i2, i3, em::bx2) = average<true, false, true>(i1, i2, i3, em::bx2);
+        EB_node(i1, i2, i3, em::bx3) = average<true, true, false>(i1, i2, i3, em::bx3);
+        // clang-format on
+      } else {
+        raise::KernelError(
+          HERE,
+          "ColocateFields_kernel: 3D implementation called for D != 3");
+      }
+    }
+
+  private:
+    /**
+     * @tparam X1, X2, X3 whether the component is dual along each direction
+     */
+    template <bool X1, bool X2, bool X3>
+    Inline auto average(index_t i1, index_t i2, index_t i3, idx_t comp) const
+      -> real_t {
+      constexpr int n1 = X1 ? 2 : 1;
+      constexpr int n2 = X2 ? 2 : 1;
+      constexpr int n3 = X3 ? 2 : 1;
+      real_t        sum { ZERO };
+      for (auto s1 { 0 }; s1 < n1; ++s1) {
+        if constexpr (D == Dim::_1D) {
+          sum += EB(i1 - s1, comp);
+        } else {
+          for (auto s2 { 0 }; s2 < n2; ++s2) {
+            if constexpr (D == Dim::_2D) {
+              sum += EB(i1 - s1, i2 - s2, comp);
+            } else {
+              for (auto s3 { 0 }; s3 < n3; ++s3) {
+                sum += EB(i1 - s1, i2 - s2, i3 - s3, comp);
+              }
+            }
+          }
+        }
+      }
+      return sum / static_cast<real_t>(n1 * n2 * n3);
+    }
+  };
+
+} // namespace kernel
+
+#endif // KERNELS_COLOCATED_FIELDS_HPP
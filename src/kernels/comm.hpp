@@ -32,6 +32,7 @@ namespace kernel::comm {
 
     array_t<int*>         i1, i1_prev, i2, i2_prev, i3, i3_prev;
     const array_t<short*> tag;
+    const bool            store_prev;
 
     const array_t<npart_t*> tag_offsets;
 
@@ -69,6 +70,7 @@ namespace kernel::comm {
       , i3 { i3 }
       , i3_prev { i3_prev }
       , tag { tag }
+      , store_prev { i1_prev.extent(0) > 0 }
       , tag_offsets { tag_offsets }
       , current_offset { "current_offset", ntags } {}
 
@@ -89,16 +91,22 @@ namespace kernel::comm {
         // apply offsets
         if (tag(p) != ParticleTag::dead) {
           if constexpr (D == Dim::_1D or D == Dim::_2D or D == Dim::_3D) {
-            i1(p)      += shifts_in_x1(tag(p) - 2);
-            i1_prev(p) += shifts_in_x1(tag(p) - 2);
+            i1(p) += shifts_in_x1(tag(p) - 2);
+            if (store_prev) {
+              i1_prev(p) += shifts_in_x1(tag(p) - 2);
+            }
           }
           if constexpr (D == Dim::_2D or D == Dim::_3D) {
-            i2(p)      += shifts_in_x2(tag(p) - 2);
-            i2_prev(p) += shifts_in_x2(tag(p) - 2);
+            i2(p) += shifts_in_x2(tag(p) - 2);
+            if (store_prev) {
+              i2_prev(p) += shifts_in_x2(tag(p) - 2);
+            }
           }
           if constexpr (D == Dim::_3D) {
-            i3(p)      += shifts_in_x3(tag(p) - 2);
-            i3_prev(p) += shifts_in_x3(tag(p) - 2);
+            i3(p) += shifts_in_x3(tag(p) - 2);
+            if (store_prev) {
+              i3_prev(p) += shifts_in_x3(tag(p) - 2);
+            }
           }
         }
       }
@@ -115,6 +123,8 @@ namespace kernel::comm {
 
     const unsigned short NINTS, NREALS, NPRTLDX, NPLDS_R, NPLDS_I;
     const npart_t        idx_offset;
+    // # of coordinates per dimension: 2 with `*_prev` arrays, 1 without
+    const unsigned short NCRD;
 
     const array_t<int*>      i1, i1_prev, i2, i2_prev, i3, i3_prev;
     const array_t<prtldx_t*> dx1, dx1_prev, dx2, dx2_prev, dx3, dx3_prev;
@@ -168,6 +178,7 @@ namespace kernel::comm {
       , NPLDS_R { NPLDS_R }
       , NPLDS_I { NPLDS_I }
       , idx_offset { idx_offset }
+      , NCRD { static_cast<unsigned short>(i1_prev.extent(0) > 0 ? 2 : 1) }
       , i1 { i1 }
       , i1_prev { i1_prev }
       , i2 { i2 }
@@ -194,21 +205,27 @@ namespace kernel::comm {
       const auto idx = outgoing_indices(idx_offset + p);
       if constexpr (D == Dim::_1D or D == Dim::_2D or D == Dim::_3D) {
         send_buff_int(NINTS * p + 0)      = i1(idx);
-        send_buff_int(NINTS * p + 1)      = i1_prev(idx);
         send_buff_prtldx(NPRTLDX * p + 0) = dx1(idx);
-        send_buff_prtldx(NPRTLDX * p + 1) = dx1_prev(idx);
+        if (NCRD > 1) {
+          send_buff_int(NINTS * p + 1)      = i1_prev(idx);
+          send_buff_prtldx(NPRTLDX * p + 1) = dx1_prev(idx);
+        }
       }
       if constexpr (D == Dim::_2D or D == Dim::_3D) {
-        send_buff_int(NINTS * p + 2)      = i2(idx);
-        send_buff_int(NINTS * p + 3)      = i2_prev(idx);
-        send_buff_prtldx(NPRTLDX * p + 2) = dx2(idx);
-        send_buff_prtldx(NPRTLDX * p + 3) = dx2_prev(idx);
+        send_buff_int(NINTS * p + NCRD * 1)      = i2(idx);
+        send_buff_prtldx(NPRTLDX * p + NCRD * 1) = dx2(idx);
+        if (NCRD > 1) {
+          send_buff_int(NINTS * p + NCRD * 1 + 1)      = i2_prev(idx);
+          send_buff_prtldx(NPRTLDX * p + NCRD * 1 + 1) = dx2_prev(idx);
+        }
       }
       if constexpr (D == Dim::_3D) {
-        send_buff_int(NINTS * p + 4)      = i3(idx);
-        send_buff_int(NINTS * p + 5)      = i3_prev(idx);
-        send_buff_prtldx(NPRTLDX * p + 4) = dx3(idx);
-        send_buff_prtldx(NPRTLDX * p + 5) = dx3_prev(idx);
+        send_buff_int(NINTS * p + NCRD * 2)      = i3(idx);
+        send_buff_prtldx(NPRTLDX * p + NCRD * 2) = dx3(idx);
+        if (NCRD > 1) {
+          send_buff_int(NINTS * p + NCRD * 2 + 1)      = i3_prev(idx);
+          send_buff_prtldx(NPRTLDX * p + NCRD * 2 + 1) = dx3_prev(idx);
+        }
       }
       send_buff_real(NREALS * p + 0) = ux1(idx);
       send_buff_real(NREALS * p + 1) = ux2(idx);
@@ -240,7 +257,9 @@ namespace kernel::comm {
     const array_t<npart_t*>  recv_buff_pld_i;
 
     const unsigned short NINTS, NREALS, NPRTLDX, NPLDS_R, NPLDS_I;
-    const npart_t        npart, npart_holes;
+    const npart_t        npart, offset, npart_holes;
+    // # of coordinates per dimension: 2 with `*_prev` arrays, 1 without
+    const unsigned short NCRD;
 
     array_t<int*>           i1, i1_prev, i2, i2_prev, i3, i3_prev;
     array_t<prtldx_t*>      dx1, dx1_prev, dx2, dx2_prev, dx3, dx3_prev;
@@ -262,6 +281,7 @@ namespace kernel::comm {
                                 unsigned short            NPLDS_R,
                                 unsigned short            NPLDS_I,
                                 npart_t                   npart,
+                                npart_t                   offset,
                                 array_t<int*>&            i1,
                                 array_t<int*>&            i1_prev,
                                 array_t<prtldx_t*>&       dx1,
@@ -294,7 +314,9 @@ namespace kernel::comm {
       , NPLDS_R { NPLDS_R }
       , NPLDS_I { NPLDS_I }
       , npart { npart }
+      , offset { offset }
       , npart_holes { outgoing_indices.extent(0) }
+      , NCRD { static_cast<unsigned short>(i1_prev.extent(0) > 0 ? 2 : 1) }
       , i1 { i1 }
       , i1_prev { i1_prev }
       , i2 { i2 }
@@ -318,29 +340,37 @@ namespace kernel::comm {
       , outgoing_indices { outgoing_indices } {}
 
     Inline void operator()(index_t p) const {
-      npart_t idx;
-      if (p >= npart_holes) {
-        idx = npart + p - npart_holes;
+      // index among all received particles (from all directions)
+      const npart_t q = offset + p;
+      npart_t       idx;
+      if (q >= npart_holes) {
+        idx = npart + q - npart_holes;
       } else {
-        idx = outgoing_indices(p);
+        idx = outgoing_indices(q);
       }
       if constexpr (D == Dim::_1D or D == Dim::_2D or D == Dim::_3D) {
-        i1(idx)       = recv_buff_int(NINTS * p + 0);
-        i1_prev(idx)  = recv_buff_int(NINTS * p + 1);
-        dx1(idx)      = recv_buff_prtldx(NPRTLDX * p + 0);
-        dx1_prev(idx) = recv_buff_prtldx(NPRTLDX * p + 1);
+        i1(idx)  = recv_buff_int(NINTS * p + 0);
+        dx1(idx) = recv_buff_prtldx(NPRTLDX * p + 0);
+        if (NCRD > 1) {
+          i1_prev(idx)  = recv_buff_int(NINTS * p + 1);
+          dx1_prev(idx) = recv_buff_prtldx(NPRTLDX * p + 1);
+        }
       }
       if constexpr (D == Dim::_2D or D == Dim::_3D) {
-        i2(idx)       = recv_buff_int(NINTS * p + 2);
-        i2_prev(idx)  = recv_buff_int(NINTS * p + 3);
-        dx2(idx)      = recv_buff_prtldx(NPRTLDX * p + 2);
-        dx2_prev(idx) = recv_buff_prtldx(NPRTLDX * p + 3);
+        i2(idx)  = recv_buff_int(NINTS * p + NCRD * 1);
+        dx2(idx) = recv_buff_prtldx(NPRTLDX * p + NCRD * 1);
+        if (NCRD > 1) {
+          i2_prev(idx)  = recv_buff_int(NINTS * p + NCRD * 1 + 1);
+          dx2_prev(idx) = recv_buff_prtldx(NPRTLDX * p + NCRD * 1 + 1);
+        }
       }
       if constexpr (D == Dim::_3D) {
-        i3(idx)       = recv_buff_int(NINTS * p + 4);
-        i3_prev(idx)  = recv_buff_int(NINTS * p + 5);
-        dx3(idx)      = recv_buff_prtldx(NPRTLDX * p + 4);
-        dx3_prev(idx) = recv_buff_prtldx(NPRTLDX * p + 5);
+        i3(idx)  = recv_buff_int(NINTS * p + NCRD * 2);
+        dx3(idx) = recv_buff_prtldx(NPRTLDX * p + NCRD * 2);
+        if (NCRD > 1) {
+          i3_prev(idx)  = recv_buff_int(NINTS * p + NCRD * 2 + 1);
+          dx3_prev(idx) = recv_buff_prtldx(NPRTLDX * p + NCRD * 2 + 1);
+        }
       }
       ux1(idx)    = recv_buff_real(NREALS * p + 0);
       ux2(idx)    = recv_buff_real(NREALS * p + 1);
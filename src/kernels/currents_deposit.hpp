@@ -2,6 +2,9 @@
  * @file kernels/current_deposit.hpp
  * @brief Covariant algorithms for the current deposition
  * @implements
+ *   - kernel::PrtlPrev_t
+ *   - kernel::TileAccess<>
+ *   - kernel::ComputeTileKeys_kernel<>
  *   - kernel::DepositCurrents_kernel<>
  * @namespaces:
  *   - kernel::
@@ -16,22 +19,145 @@
 #include "arch/kokkos_aliases.h"
 #include "utils/numeric.h"
 
+#include "kernels/particle_shapes.hpp"
+
 #include <Kokkos_Core.hpp>
 
+#include <vector>
+
 #define i_di_to_Xi(I, DI) static_cast<real_t>((I)) + static_cast<real_t>((DI))
 
 namespace kernel {
   using namespace ntt;
 
+  /**
+   * @brief Particle coordinates at the beginning of the timestep
+   * @note Filled by the pusher and consumed by the current deposit
+   */
+  struct PrtlPrev_t {
+    int      i1 { 0 }, i2 { 0 }, i3 { 0 };
+    prtldx_t dx1 { 0 }, dx2 { 0 }, dx3 { 0 };
+  };
+
+  /**
+   * @brief Accessor to a team-local tile of the current field
+   * @note Buffer covers [o, o + nbuff) cells in each direction (with ghosts)
+   * @note Contributions outside the tile go directly to the global field
+   */
+  template <Dimension D>
+  struct TileAccess {
+    struct AtomicAdd_t {
+      real_t* ptr;
+
+      Inline void operator+=(real_t value) const {
+        Kokkos::atomic_add(ptr, value);
+      }
+    };
+
+    const scratch_array_t<real_t*> buff;
+    const ndfield_t<D, 3>          J;
+    const int                      o1, o2, o3, nbuff;
+
+    Inline auto local(int i, int o) const -> int {
+      return ((i >= o) and (i < o + nbuff)) ? (i - o) : -1;
+    }
+
+    Inline auto operator()(int i1, int c) const -> AtomicAdd_t {
+      const auto l1 = local(i1, o1);
+      if (l1 < 0) {
+        return { &J(i1, c) };
+      }
+      return { &buff(c * nbuff + l1) };
+    }
+
+    Inline auto operator()(int i1, int i2, int c) const -> AtomicAdd_t {
+      const auto l1 = local(i1, o1), l2 = local(i2, o2);
+      if (l1 < 0 or l2 < 0) {
+        return { &J(i1, i2, c) };
+      }
+      return { &buff((c * nbuff + l2) * nbuff + l1) };
+    }
+
+    Inline auto operator()(int i1, int i2, int i3, int c) const -> AtomicAdd_t {
+      const auto l1 = local(i1, o1), l2 = local(i2, o2), l3 = local(i3, o3);
+      if (l1 < 0 or l2 < 0 or l3 < 0) {
+        return { &J(i1, i2, i3, c) };
+      }
+      return { &buff(((c * nbuff + l3) * nbuff + l2) * nbuff + l1) };
+    }
+  };
+
+  /**
+   * @brief Assigns particles to tiles by their position at the start of the step
+   * @note Dead particles are assigned to the extra last tile (= ntiles)
+   */
+  template <Dimension D>
+  class ComputeTileKeys_kernel {
+    const array_t<int*>   i1_prev, i2_prev, i3_prev;
+    const array_t<short*> tag;
+    array_t<int*>         keys;
+    const int             tile, n1, n2, n3, nt1, nt2, dead_key;
+
+  public:
+    ComputeTileKeys_kernel(const array_t<int*>&         i1_prev,
+                           const array_t<int*>&         i2_prev,
+                           const array_t<int*>&         i3_prev,
+                           const array_t<short*>&       tag,
+                           array_t<int*>&               keys,
+                           const std::vector<ncells_t>& ncells,
+                           int                          tile,
+                           int                          nt1,
+                           int                          nt2,
+                           int                          dead_key)
+      : i1_prev { i1_prev }
+      , i2_prev { i2_prev }
+      , i3_prev { i3_prev }
+      , tag { tag }
+      , keys { keys }
+      , tile { tile }
+      , n1 { static_cast<int>(ncells[0]) }
+      , n2 { (D != Dim::_1D) ? static_cast<int>(ncells[1]) : 1 }
+      , n3 { (D == Dim::_3D) ? static_cast<int>(ncells[2]) : 1 }
+      , nt1 { nt1 }
+      , nt2 { nt2 }
+      , dead_key { dead_key } {}
+
+    Inline void operator()(index_t p) const {
+      if (tag(p) == ParticleTag::dead) {
+        keys(p) = dead_key;
+        return;
+      }
+      int t1 { 0 }, t2 { 0 }, t3 { 0 };
+      t1 = math::min(math::max(i1_prev(p), 0), n1 - 1) / tile;
+      if constexpr (D == Dim::_2D or D == Dim::_3D) {
+        t2 = math::min(math::max(i2_prev(p), 0), n2 - 1) / tile;
+      }
+      if constexpr (D == Dim::_3D) {
+        t3 = math::min(math::max(i3_prev(p), 0), n3 - 1) / tile;
+      }
+      keys(p) = t1 + nt1 * (t2 + nt2 * t3);
+    }
+  };
+
   /**
    * @brief Algorithm for the current deposition
+   * @tparam O Order of the particle shape
+   * @note With a range policy, particles deposit to a scatter view
+   * @note With a team policy, each team deposits the particles of a single tile
+   * into a scratch buffer, which is then added to the global field once
+   * @note First order uses the zigzag scheme, higher orders use the scheme of
+   * Esirkepov (2001); both conserve the charge (deposited with the same shape)
    */
-  template <SimEngine::type S, class M>
+  template <SimEngine::type S, class M, unsigned short O = SHAPE_ORDER>
   class DepositCurrents_kernel {
     static_assert(M::is_metric, "M must be a metric class");
+    static_assert((O >= 1) and (O <= 3), "Invalid shape order");
     static constexpr auto D = M::Dim;
+    // # of cells covered beyond the cell of the particle (before its motion)
+    static constexpr int  halo = (O == 1) ? 1 : 2;
 
     scatter_ndfield_t<D, 3>  J;
+    const ndfield_t<D, 3>    J_glob;
     const array_t<int*>      i1, i2, i3;
     const array_t<int*>      i1_prev, i2_prev, i3_prev;
     const array_t<prtldx_t*> dx1, dx2, dx3;
@@ -43,6 +169,12 @@ namespace kernel {
     const M                  metric;
     const real_t             charge, inv_dt;
 
+    // tiling (used only with the team policy)
+    const array_t<const npart_t*> tile_offsets;
+    const array_t<const int*>     tile_counts;
+    const array_t<const npart_t*> tile_permute;
+    const int                     tile, nt1, nt2;
+
   public:
     /**
      * @brief explicit constructor.
@@ -90,13 +222,209 @@ namespace kernel {
       , tag { tag }
       , metric { metric }
       , charge { charge }
-      , inv_dt { ONE / dt } {}
+      , inv_dt { ONE / dt }
+      , tile { 0 }
+      , nt1 { 0 }
+      , nt2 { 0 } {}
+
+    /**
+     * @brief constructor for the tiled deposit (used with the team policy).
+     * @param tile_offsets offsets of each tile in `tile_permute`
+     * @param tile_counts number of particles in each tile
+     * @param tile_permute particle indices sorted by tiles
+     * @param tile tile size (in cells)
+     * @param nt1, nt2 number of tiles in x1 and x2
+     */
+    DepositCurrents_kernel(const ndfield_t<D, 3>&          cur,
+                           const array_t<const npart_t*>& tile_offsets,
+                           const array_t<const int*>&     tile_counts,
+                           const array_t<const npart_t*>& tile_permute,
+                           int                            tile,
+                           int                            nt1,
+                           int                            nt2,
+                           const array_t<int*>&           i1,
+                           const array_t<int*>&           i2,
+                           const array_t<int*>&           i3,
+                           const array_t<int*>&           i1_prev,
+                           const array_t<int*>&           i2_prev,
+                           const array_t<int*>&           i3_prev,
+                           const array_t<prtldx_t*>&      dx1,
+                           const array_t<prtldx_t*>&      dx2,
+                           const array_t<prtldx_t*>&      dx3,
+                           const array_t<prtldx_t*>&      dx1_prev,
+                           const array_t<prtldx_t*>&      dx2_prev,
+                           const array_t<prtldx_t*>&      dx3_prev,
+                           const array_t<real_t*>&        ux1,
+                           const array_t<real_t*>&        ux2,
+                           const array_t<real_t*>&        ux3,
+                           const array_t<real_t*>&        phi,
+                           const array_t<real_t*>&        weight,
+                           const array_t<short*>&         tag,
+                           const M&                       metric,
+                           real_t                         charge,
+                           real_t                         dt)
+      : J_glob { cur }
+      , i1 { i1 }
+      , i2 { i2 }
+      , i3 { i3 }
+      , i1_prev { i1_prev }
+      , i2_prev { i2_prev }
+      , i3_prev { i3_prev }
+      , dx1 { dx1 }
+      , dx2 { dx2 }
+      , dx3 { dx3 }
+      , dx1_prev { dx1_prev }
+      , dx2_prev { dx2_prev }
+      , dx3_prev { dx3_prev }
+      , ux1 { ux1 }
+      , ux2 { ux2 }
+      , ux3 { ux3 }
+      , phi { phi }
+      , weight { weight }
+      , tag { tag }
+      , metric { metric }
+      , charge { charge }
+      , inv_dt { ONE / dt }
+      , tile_offsets { tile_offsets }
+      , tile_counts { tile_counts }
+      , tile_permute { tile_permute }
+      , tile { tile }
+      , nt1 { nt1 }
+      , nt2 { nt2 } {}
+
+    /**
+     * @brief size of the tile buffer (in cells along each direction)
+     * @note particles move by at most one cell, and the stencil extends by
+     * `halo` cells around it
+     */
+    static constexpr auto buffer_size(int tile_size) -> int {
+      return tile_size + 2 * halo + 1;
+    }
+
+    /**
+     * @brief size of the scratch memory (in bytes) required per team
+     */
+    static auto scratch_size(int tile_size) -> std::size_t {
+      std::size_t ncells = 3;
+      for (auto d { 0u }; d < static_cast<unsigned short>(D); ++d) {
+        ncells *= buffer_size(tile_size);
+      }
+      return scratch_array_t<real_t*>::shmem_size(ncells);
+    }
 
     /**
      * @brief Iteration of the loop over particles.
      * @param p index.
      */
     Inline auto operator()(index_t p) const -> void {
+      auto J_acc = J.access();
+      deposit(p, J_acc);
+    }
+
+    /**
+     * @brief Deposit with the previous coordinates provided by the caller.
+     * @param p index.
+     * @param prev coordinates of the particle at the beginning of the timestep.
+     * @note Used when fused with the pusher (`*_prev` arrays are not accessed).
+     */
+    Inline auto operator()(index_t p, const PrtlPrev_t& prev) const -> void {
+      auto J_acc = J.access();
+      deposit(p, prev, J_acc);
+    }
+
+    /**
+     * @brief Deposit the currents of a single tile.
+     * @param team team member (one team per tile).
+     */
+    Inline auto operator()(const team_member_t& team) const -> void {
+      const int t      = team.league_rank();
+      const int nbuff  = buffer_size(tile);
+      int       nbuffD = nbuff;
+      int       o1 { 0 }, o2 { 0 }, o3 { 0 };
+      // first (ghost-included) cell of the buffer
+      o1 = (t % nt1) * tile - halo + static_cast<int>(N_GHOSTS);
+      if constexpr (D == Dim::_2D or D == Dim::_3D) {
+        o2      = ((t / nt1) % nt2) * tile - halo + static_cast<int>(N_GHOSTS);
+        nbuffD *= nbuff;
+      }
+      if constexpr (D == Dim::_3D) {
+        o3      = (t / (nt1 * nt2)) * tile - halo + static_cast<int>(N_GHOSTS);
+        nbuffD *= nbuff;
+      }
+      scratch_array_t<real_t*> buff { team.team_scratch(0), 3 * nbuffD };
+      Kokkos::parallel_for(Kokkos::TeamThreadRange(team, 3 * nbuffD),
+                           [&](int k) { buff(k) = ZERO; });
+      team.team_barrier();
+
+      const TileAccess<D> J_acc { buff, J_glob, o1, o2, o3, nbuff };
+      const auto          offset = tile_offsets(t);
+      Kokkos::parallel_for(Kokkos::TeamThreadRange(team, tile_counts(t)),
+                           [&](int k) { deposit(tile_permute(offset + k), J_acc); });
+      team.team_barrier();
+
+      // flush the buffer (including the halo) to the global field
+      Kokkos::parallel_for(Kokkos::TeamThreadRange(team, 3 * nbuffD), [&](int k) {
+        if (buff(k) == ZERO) {
+          return;
+        }
+        const int c  = k / nbuffD;
+        const int l1 = (k % nbuffD) % nbuff;
+        const int g1 = o1 + l1;
+        if (g1 < 0 or g1 >= static_cast<int>(J_glob.extent(0))) {
+          return;
+        }
+        if constexpr (D == Dim::_1D) {
+          Kokkos::atomic_add(&J_glob(g1, c), buff(k));
+        } else {
+          const int g2 = o2 + ((k % nbuffD) / nbuff) % nbuff;
+          if (g2 < 0 or g2 >= static_cast<int>(J_glob.extent(1))) {
+            return;
+          }
+          if constexpr (D == Dim::_2D) {
+            Kokkos::atomic_add(&J_glob(g1, g2, c), buff(k));
+          } else {
+            const int g3 = o3 + (k % nbuffD) / (nbuff * nbuff);
+            if (g3 < 0 or g3 >= static_cast<int>(J_glob.extent(2))) {
+              return;
+            }
+            Kokkos::atomic_add(&J_glob(g1, g2, g3, c), buff(k));
+          }
+        }
+      });
+    }
+
+    /**
+     * @brief Deposit the current of a single particle.
+     * @param p index.
+     * @param J_acc accessor to the current field.
+     */
+    template <class A>
+    Inline auto deposit(index_t p, const A& J_acc) const -> void {
+      PrtlPrev_t prev;
+      if constexpr (D == Dim::_1D or D == Dim::_2D or D == Dim::_3D) {
+        prev.i1  = i1_prev(p);
+        prev.dx1 = dx1_prev(p);
+      }
+      if constexpr (D == Dim::_2D or D == Dim::_3D) {
+        prev.i2  = i2_prev(p);
+        prev.dx2 = dx2_prev(p);
+      }
+      if constexpr (D == Dim::_3D) {
+        prev.i3  = i3_prev(p);
+        prev.dx3 = dx3_prev(p);
+      }
+      deposit(p, prev, J_acc);
+    }
+
+    /**
+     * @brief Deposit the current of a single particle.
+     * @param p index.
+     * @param prev coordinates of the particle at the beginning of the timestep.
+     * @param J_acc accessor to the current field.
+     */
+    template <class A>
+    Inline auto deposit(index_t p, const PrtlPrev_t& prev, const A& J_acc) const
+      -> void {
       if (tag(p) == ParticleTag::dead) {
         return;
       }
@@ -157,27 +485,29 @@ namespace kernel {
       }
 
       const real_t coeff { weight(p) * charge };
+      if constexpr (O > 1) {
+        depositShaped(p, prev, vp, coeff, J_acc);
+        return;
+      }
 
-      const auto dxp_r_1 { static_cast<prtldx_t>(i1(p) == i1_prev(p)) *
-                           (dx1(p) + dx1_prev(p)) * static_cast<prtldx_t>(INV_2) };
+      const auto dxp_r_1 { static_cast<prtldx_t>(i1(p) == prev.i1) *
+                           (dx1(p) + prev.dx1) * static_cast<prtldx_t>(INV_2) };
 
-      const real_t Wx1_1 { INV_2 * (dxp_r_1 + dx1_prev(p) +
-                                    static_cast<real_t>(i1(p) > i1_prev(p))) };
+      const real_t Wx1_1 { INV_2 * (dxp_r_1 + prev.dx1 +
+                                    static_cast<real_t>(i1(p) > prev.i1)) };
       const real_t Wx1_2 { INV_2 * (dx1(p) + dxp_r_1 +
                                     static_cast<real_t>(
-                                      static_cast<int>(i1(p) > i1_prev(p)) +
-                                      i1_prev(p) - i1(p))) };
-      const real_t Fx1_1 { (static_cast<real_t>(i1(p) > i1_prev(p)) + dxp_r_1 -
-                            dx1_prev(p)) *
+                                      static_cast<int>(i1(p) > prev.i1) +
+                                      prev.i1 - i1(p))) };
+      const real_t Fx1_1 { (static_cast<real_t>(i1(p) > prev.i1) + dxp_r_1 -
+                            prev.dx1) *
                            coeff * inv_dt };
       const real_t Fx1_2 { (static_cast<real_t>(
-                              i1(p) - i1_prev(p) -
-                              static_cast<int>(i1(p) > i1_prev(p))) +
+                              i1(p) - prev.i1 -
+                              static_cast<int>(i1(p) > prev.i1)) +
                             dx1(p) - dxp_r_1) *
                            coeff * inv_dt };
 
-      auto J_acc = J.access();
-
       // tuple_t<prtldx_t, D> dxp_r;
       if constexpr (D == Dim::_1D) {
         const real_t Fx2_1 { HALF * vp[1] * coeff };
@@ -186,35 +516,35 @@ namespace kernel {
         const real_t Fx3_1 { HALF * vp[2] * coeff };
         const real_t Fx3_2 { HALF * vp[2] * coeff };
 
-        J_acc(i1_prev(p) + N_GHOSTS, cur::jx1) += Fx1_1;
-        J_acc(i1(p) + N_GHOSTS, cur::jx1)      += Fx1_2;
+        J_acc(prev.i1 + N_GHOSTS, cur::jx1) += Fx1_1;
+        J_acc(i1(p) + N_GHOSTS, cur::jx1)   += Fx1_2;
 
-        J_acc(i1_prev(p) + N_GHOSTS, cur::jx2)     += Fx2_1 * (ONE - Wx1_1);
-        J_acc(i1_prev(p) + N_GHOSTS + 1, cur::jx2) += Fx2_1 * Wx1_1;
-        J_acc(i1(p) + N_GHOSTS, cur::jx2)          += Fx2_2 * (ONE - Wx1_2);
-        J_acc(i1(p) + N_GHOSTS + 1, cur::jx2)      += Fx2_2 * Wx1_2;
+        J_acc(prev.i1 + N_GHOSTS, cur::jx2)     += Fx2_1 * (ONE - Wx1_1);
+        J_acc(prev.i1 + N_GHOSTS + 1, cur::jx2) += Fx2_1 * Wx1_1;
+        J_acc(i1(p) + N_GHOSTS, cur::jx2)       += Fx2_2 * (ONE - Wx1_2);
+        J_acc(i1(p) + N_GHOSTS + 1, cur::jx2)   += Fx2_2 * Wx1_2;
 
-        J_acc(i1_prev(p) + N_GHOSTS, cur::jx3)     += Fx3_1 * (ONE - Wx1_1);
-        J_acc(i1_prev(p) + N_GHOSTS + 1, cur::jx3) += Fx3_1 * Wx1_1;
-        J_acc(i1(p) + N_GHOSTS, cur::jx3)          += Fx3_2 * (ONE - Wx1_2);
-        J_acc(i1(p) + N_GHOSTS + 1, cur::jx3)      += Fx3_2 * Wx1_2;
+        J_acc(prev.i1 + N_GHOSTS, cur::jx3)     += Fx3_1 * (ONE - Wx1_1);
+        J_acc(prev.i1 + N_GHOSTS + 1, cur::jx3) += Fx3_1 * Wx1_1;
+        J_acc(i1(p) + N_GHOSTS, cur::jx3)       += Fx3_2 * (ONE - Wx1_2);
+        J_acc(i1(p) + N_GHOSTS + 1, cur::jx3)   += Fx3_2 * Wx1_2;
       } else if constexpr (D == Dim::_2D || D == Dim::_3D) {
-        const auto dxp_r_2 { static_cast<prtldx_t>(i2(p) == i2_prev(p)) *
-                             (dx2(p) + dx2_prev(p)) *
+        const auto dxp_r_2 { static_cast<prtldx_t>(i2(p) == prev.i2) *
+                             (dx2(p) + prev.dx2) *
                              static_cast<prtldx_t>(INV_2) };
 
-        const real_t Wx2_1 { INV_2 * (dxp_r_2 + dx2_prev(p) +
-                                      static_cast<real_t>(i2(p) > i2_prev(p))) };
+        const real_t Wx2_1 { INV_2 * (dxp_r_2 + prev.dx2 +
+                                      static_cast<real_t>(i2(p) > prev.i2)) };
         const real_t Wx2_2 { INV_2 * (dx2(p) + dxp_r_2 +
                                       static_cast<real_t>(
-                                        static_cast<int>(i2(p) > i2_prev(p)) +
-                                        i2_prev(p) - i2(p))) };
-        const real_t Fx2_1 { (static_cast<real_t>(i2(p) > i2_prev(p)) +
-                              dxp_r_2 - dx2_prev(p)) *
+                                        static_cast<int>(i2(p) > prev.i2) +
+                                        prev.i2 - i2(p))) };
+        const real_t Fx2_1 { (static_cast<real_t>(i2(p) > prev.i2) +
+                              dxp_r_2 - prev.dx2) *
                              coeff * inv_dt };
         const real_t Fx2_2 { (static_cast<real_t>(
-                                i2(p) - i2_prev(p) -
-                                static_cast<int>(i2(p) > i2_prev(p))) +
+                                i2(p) - prev.i2 -
+                                static_cast<int>(i2(p) > prev.i2)) +
                               dx2(p) - dxp_r_2) *
                              coeff * inv_dt };
 
@@ -222,37 +552,37 @@ namespace kernel {
           const real_t Fx3_1 { HALF * vp[2] * coeff };
           const real_t Fx3_2 { HALF * vp[2] * coeff };
 
-          J_acc(i1_prev(p) + N_GHOSTS,
-                i2_prev(p) + N_GHOSTS,
+          J_acc(prev.i1 + N_GHOSTS,
+                prev.i2 + N_GHOSTS,
                 cur::jx1) += Fx1_1 * (ONE - Wx2_1);
-          J_acc(i1_prev(p) + N_GHOSTS,
-                i2_prev(p) + N_GHOSTS + 1,
+          J_acc(prev.i1 + N_GHOSTS,
+                prev.i2 + N_GHOSTS + 1,
                 cur::jx1) += Fx1_1 * Wx2_1;
           J_acc(i1(p) + N_GHOSTS, i2(p) + N_GHOSTS, cur::jx1) += Fx1_2 *
                                                                  (ONE - Wx2_2);
           J_acc(i1(p) + N_GHOSTS, i2(p) + N_GHOSTS + 1, cur::jx1) += Fx1_2 * Wx2_2;
 
-          J_acc(i1_prev(p) + N_GHOSTS,
-                i2_prev(p) + N_GHOSTS,
+          J_acc(prev.i1 + N_GHOSTS,
+                prev.i2 + N_GHOSTS,
                 cur::jx2) += Fx2_1 * (ONE - Wx1_1);
-          J_acc(i1_prev(p) + N_GHOSTS + 1,
-                i2_prev(p) + N_GHOSTS,
+          J_acc(prev.i1 + N_GHOSTS + 1,
+                prev.i2 + N_GHOSTS,
                 cur::jx2) += Fx2_1 * Wx1_1;
           J_acc(i1(p) + N_GHOSTS, i2(p) + N_GHOSTS, cur::jx2) += Fx2_2 *
                                                                  (ONE - Wx1_2);
           J_acc(i1(p) + N_GHOSTS + 1, i2(p) + N_GHOSTS, cur::jx2) += Fx2_2 * Wx1_2;
 
-          J_acc(i1_prev(p) + N_GHOSTS,
-                i2_prev(p) + N_GHOSTS,
+          J_acc(prev.i1 + N_GHOSTS,
+                prev.i2 + N_GHOSTS,
                 cur::jx3) += Fx3_1 * (ONE - Wx1_1) * (ONE - Wx2_1);
-          J_acc(i1_prev(p) + N_GHOSTS + 1,
-                i2_prev(p) + N_GHOSTS,
+          J_acc(prev.i1 + N_GHOSTS + 1,
+                prev.i2 + N_GHOSTS,
                 cur::jx3) += Fx3_1 * Wx1_1 * (ONE - Wx2_1);
-          J_acc(i1_prev(p) + N_GHOSTS,
-                i2_prev(p) + N_GHOSTS + 1,
+          J_acc(prev.i1 + N_GHOSTS,
+                prev.i2 + N_GHOSTS + 1,
                 cur::jx3) += Fx3_1 * (ONE - Wx1_1) * Wx2_1;
-          J_acc(i1_prev(p) + N_GHOSTS + 1,
-                i2_prev(p) + N_GHOSTS + 1,
+          J_acc(prev.i1 + N_GHOSTS + 1,
+                prev.i2 + N_GHOSTS + 1,
                 cur::jx3) += Fx3_1 * Wx1_1 * Wx2_1;
 
           J_acc(i1(p) + N_GHOSTS, i2(p) + N_GHOSTS, cur::jx3) += Fx3_2 *
@@ -268,39 +598,39 @@ namespace kernel {
                                                                          Wx1_2 *
                                                                          Wx2_2;
         } else {
-          const auto   dxp_r_3 { static_cast<prtldx_t>(i3(p) == i3_prev(p)) *
-                               (dx3(p) + dx3_prev(p)) *
+          const auto   dxp_r_3 { static_cast<prtldx_t>(i3(p) == prev.i3) *
+                               (dx3(p) + prev.dx3) *
                                static_cast<prtldx_t>(INV_2) };
-          const real_t Wx3_1 { INV_2 * (dxp_r_3 + dx3_prev(p) +
-                                        static_cast<real_t>(i3(p) > i3_prev(p))) };
+          const real_t Wx3_1 { INV_2 * (dxp_r_3 + prev.dx3 +
+                                        static_cast<real_t>(i3(p) > prev.i3)) };
           const real_t Wx3_2 { INV_2 * (dx3(p) + dxp_r_3 +
                                         static_cast<real_t>(
-                                          static_cast<int>(i3(p) > i3_prev(p)) +
-                                          i3_prev(p) - i3(p))) };
-          const real_t Fx3_1 { (static_cast<real_t>(i3(p) > i3_prev(p)) +
-                                dxp_r_3 - dx3_prev(p)) *
+                                          static_cast<int>(i3(p) > prev.i3) +
+                                          prev.i3 - i3(p))) };
+          const real_t Fx3_1 { (static_cast<real_t>(i3(p) > prev.i3) +
+                                dxp_r_3 - prev.dx3) *
                                coeff * inv_dt };
           const real_t Fx3_2 { (static_cast<real_t>(
-                                  i3(p) - i3_prev(p) -
-                                  static_cast<int>(i3(p) > i3_prev(p))) +
+                                  i3(p) - prev.i3 -
+                                  static_cast<int>(i3(p) > prev.i3)) +
                                 dx3(p) - dxp_r_3) *
                                coeff * inv_dt };
 
-          J_acc(i1_prev(p) + N_GHOSTS,
-                i2_prev(p) + N_GHOSTS,
-                i3_prev(p) + N_GHOSTS,
+          J_acc(prev.i1 + N_GHOSTS,
+                prev.i2 + N_GHOSTS,
+                prev.i3 + N_GHOSTS,
                 cur::jx1) += Fx1_1 * (ONE - Wx2_1) * (ONE - Wx3_1);
-          J_acc(i1_prev(p) + N_GHOSTS,
-                i2_prev(p) + N_GHOSTS + 1,
-                i3_prev(p) + N_GHOSTS,
+          J_acc(prev.i1 + N_GHOSTS,
+                prev.i2 + N_GHOSTS + 1,
+                prev.i3 + N_GHOSTS,
                 cur::jx1) += Fx1_1 * Wx2_1 * (ONE - Wx3_1);
-          J_acc(i1_prev(p) + N_GHOSTS,
-                i2_prev(p) + N_GHOSTS,
-                i3_prev(p) + N_GHOSTS + 1,
+          J_acc(prev.i1 + N_GHOSTS,
+                prev.i2 + N_GHOSTS,
+                prev.i3 + N_GHOSTS + 1,
                 cur::jx1) += Fx1_1 * (ONE - Wx2_1) * Wx3_1;
-          J_acc(i1_prev(p) + N_GHOSTS,
-                i2_prev(p) + N_GHOSTS + 1,
-                i3_prev(p) + N_GHOSTS + 1,
+          J_acc(prev.i1 + N_GHOSTS,
+                prev.i2 + N_GHOSTS + 1,
+                prev.i3 + N_GHOSTS + 1,
                 cur::jx1) += Fx1_1 * Wx2_1 * Wx3_1;
 
           J_acc(i1(p) + N_GHOSTS,
@@ -320,21 +650,21 @@ namespace kernel {
                 i3(p) + N_GHOSTS + 1,
                 cur::jx1) += Fx1_2 * Wx2_2 * Wx3_2;
 
-          J_acc(i1_prev(p) + N_GHOSTS,
-                i2_prev(p) + N_GHOSTS,
-                i3_prev(p) + N_GHOSTS,
+          J_acc(prev.i1 + N_GHOSTS,
+                prev.i2 + N_GHOSTS,
+                prev.i3 + N_GHOSTS,
                 cur::jx2) += Fx2_1 * (ONE - Wx1_1) * (ONE - Wx3_1);
-          J_acc(i1_prev(p) + N_GHOSTS + 1,
-                i2_prev(p) + N_GHOSTS,
-                i3_prev(p) + N_GHOSTS,
+          J_acc(prev.i1 + N_GHOSTS + 1,
+                prev.i2 + N_GHOSTS,
+                prev.i3 + N_GHOSTS,
                 cur::jx2) += Fx2_1 * Wx1_1 * (ONE - Wx3_1);
-          J_acc(i1_prev(p) + N_GHOSTS,
-                i2_prev(p) + N_GHOSTS,
-                i3_prev(p) + N_GHOSTS + 1,
+          J_acc(prev.i1 + N_GHOSTS,
+                prev.i2 + N_GHOSTS,
+                prev.i3 + N_GHOSTS + 1,
                 cur::jx2) += Fx2_1 * (ONE - Wx1_1) * Wx3_1;
-          J_acc(i1_prev(p) + N_GHOSTS + 1,
-                i2_prev(p) + N_GHOSTS,
-                i3_prev(p) + N_GHOSTS + 1,
+          J_acc(prev.i1 + N_GHOSTS + 1,
+                prev.i2 + N_GHOSTS,
+                prev.i3 + N_GHOSTS + 1,
                 cur::jx2) += Fx2_1 * Wx1_1 * Wx3_1;
 
           J_acc(i1(p) + N_GHOSTS,
@@ -354,21 +684,21 @@ namespace kernel {
                 i3(p) + N_GHOSTS + 1,
                 cur::jx2) += Fx2_2 * Wx1_2 * Wx3_2;
 
-          J_acc(i1_prev(p) + N_GHOSTS,
-                i2_prev(p) + N_GHOSTS,
-                i3_prev(p) + N_GHOSTS,
+          J_acc(prev.i1 + N_GHOSTS,
+                prev.i2 + N_GHOSTS,
+                prev.i3 + N_GHOSTS,
                 cur::jx3) += Fx3_1 * (ONE - Wx1_1) * (ONE - Wx2_1);
-          J_acc(i1_prev(p) + N_GHOSTS + 1,
-                i2_prev(p) + N_GHOSTS,
-                i3_prev(p) + N_GHOSTS,
+          J_acc(prev.i1 + N_GHOSTS + 1,
+                prev.i2 + N_GHOSTS,
+                prev.i3 + N_GHOSTS,
                 cur::jx3) += Fx3_1 * Wx1_1 * (ONE - Wx2_1);
-          J_acc(i1_prev(p) + N_GHOSTS,
-                i2_prev(p) + N_GHOSTS + 1,
-                i3_prev(p) + N_GHOSTS,
+          J_acc(prev.i1 + N_GHOSTS,
+                prev.i2 + N_GHOSTS + 1,
+                prev.i3 + N_GHOSTS,
                 cur::jx3) += Fx3_1 * (ONE - Wx1_1) * Wx2_1;
-          J_acc(i1_prev(p) + N_GHOSTS + 1,
-                i2_prev(p) + N_GHOSTS + 1,
-                i3_prev(p) + N_GHOSTS,
+          J_acc(prev.i1 + N_GHOSTS + 1,
+                prev.i2 + N_GHOSTS + 1,
+                prev.i3 + N_GHOSTS,
                 cur::jx3) += Fx3_1 * Wx1_1 * Wx2_1;
 
           J_acc(i1(p) + N_GHOSTS,
@@ -390,6 +720,142 @@ namespace kernel {
         }
       }
     }
+
+    /**
+     * @brief Shape at the start & its change between the two positions
+     * @note Both are stored on the `O + 2` edges starting from `i_min`
+     * (ghost-included), since the particle moves by at most one cell
+     */
+    Inline static void shapeChange(int      i_0,
+                                   prtldx_t dx_0,
+                                   int      i_1,
+                                   prtldx_t dx_1,
+                                   int&     i_min,
+                                   real_t (&S0)[O + 2],
+                                   real_t (&DS)[O + 2]) {
+      int    i0_min, i1_min;
+      real_t s0[O + 1], s1[O + 1];
+      shape::order<O>(i_0, static_cast<real_t>(dx_0), i0_min, s0);
+      shape::order<O>(i_1, static_cast<real_t>(dx_1), i1_min, s1);
+      i_min           = IMIN(i0_min, i1_min);
+      const auto off0 = i0_min - i_min;
+      const auto off1 = i1_min - i_min;
+      for (auto a { 0 }; a < O + 2; ++a) {
+        S0[a] = ZERO;
+        DS[a] = ZERO;
+      }
+      for (auto a { 0 }; a <= O; ++a) {
+        S0[a + off0] += s0[a];
+        DS[a + off0] -= s0[a];
+        DS[a + off1] += s1[a];
+      }
+      i_min += static_cast<int>(N_GHOSTS);
+    }
+
+    /**
+     * @brief Weight of the two directions transverse to the flux
+     * @note Average of the product of the shapes along the straight path
+     */
+    Inline static auto transverse(real_t S0_a,
+                                  real_t DS_a,
+                                  real_t S0_b,
+                                  real_t DS_b) -> real_t {
+      return S0_a * S0_b + HALF * (DS_a * S0_b + S0_a * DS_b) +
+             DS_a * DS_b / THREE;
+    }
+
+    /**
+     * @brief Charge-conserving deposit with the higher-order particle shapes
+     * @param vp 3-velocity (for the components along the ignored directions)
+     * @note The fluxes along each simulated direction are accumulated from the
+     * change of the shape (at the cell edges) between the two positions; the
+     * stencil covers `O + 2` edges since the particle moves by at most one cell
+     */
+    template <class A>
+    Inline auto depositShaped(index_t                p,
+                              const PrtlPrev_t&      prev,
+                              const vec_t<Dim::_3D>& vp,
+                              real_t                 coeff,
+                              const A&               J_acc) const -> void {
+      constexpr int L = O + 2;
+      const real_t  Fx { coeff * inv_dt };
+
+      // shapes at the beginning (S0) and their change over the timestep (DS)
+      real_t S0[3][L], DS[3][L];
+      int    i_min[3] { 0, 0, 0 };
+      shapeChange(prev.i1, prev.dx1, i1(p), dx1(p), i_min[0], S0[0], DS[0]);
+      if constexpr (D == Dim::_1D) {
+        real_t Jx1 { ZERO };
+        for (auto a1 { 0 }; a1 < L; ++a1) {
+          const auto j1 = i_min[0] + a1;
+          const auto W  = S0[0][a1] + HALF * DS[0][a1];
+          if (a1 < L - 1) {
+            Jx1                 -= Fx * DS[0][a1];
+            J_acc(j1, cur::jx1) += Jx1;
+          }
+          J_acc(j1, cur::jx2) += coeff * vp[1] * W;
+          J_acc(j1, cur::jx3) += coeff * vp[2] * W;
+        }
+      } else if constexpr (D == Dim::_2D) {
+        shapeChange(prev.i2, prev.dx2, i2(p), dx2(p), i_min[1], S0[1], DS[1]);
+        real_t Jx2[L] { ZERO };
+        for (auto a2 { 0 }; a2 < L; ++a2) {
+          const auto j2 = i_min[1] + a2;
+          real_t     Jx1 { ZERO };
+          for (auto a1 { 0 }; a1 < L; ++a1) {
+            const auto j1 = i_min[0] + a1;
+            if (a1 < L - 1) {
+              Jx1 -= Fx * DS[0][a1] * (S0[1][a2] + HALF * DS[1][a2]);
+              J_acc(j1, j2, cur::jx1) += Jx1;
+            }
+            if (a2 < L - 1) {
+              Jx2[a1] -= Fx * DS[1][a2] * (S0[0][a1] + HALF * DS[0][a1]);
+              J_acc(j1, j2, cur::jx2) += Jx2[a1];
+            }
+            J_acc(j1, j2, cur::jx3) += coeff * vp[2] *
+                                       transverse(S0[0][a1],
+                                                  DS[0][a1],
+                                                  S0[1][a2],
+                                                  DS[1][a2]);
+          }
+        }
+      } else if constexpr (D == Dim::_3D) {
+        shapeChange(prev.i2, prev.dx2, i2(p), dx2(p), i_min[1], S0[1], DS[1]);
+        shapeChange(prev.i3, prev.dx3, i3(p), dx3(p), i_min[2], S0[2], DS[2]);
+        real_t Jx3[L][L] { { ZERO } };
+        for (auto a3 { 0 }; a3 < L; ++a3) {
+          const auto j3 = i_min[2] + a3;
+          real_t     Jx2[L] { ZERO };
+          for (auto a2 { 0 }; a2 < L; ++a2) {
+            const auto j2 = i_min[1] + a2;
+            real_t     Jx1 { ZERO };
+            for (auto a1 { 0 }; a1 < L; ++a1) {
+              const auto j1 = i_min[0] + a1;
+              if (a1 < L - 1) {
+                Jx1 -= Fx * DS[0][a1] *
+                       transverse(S0[1][a2], DS[1][a2], S0[2][a3], DS[2][a3]);
+                J_acc(j1, j2, j3, cur::jx1) += Jx1;
+              }
+              if (a2 < L - 1) {
+                Jx2[a1] -= Fx * DS[1][a2] *
+                           transverse(S0[0][a1],
+                                      DS[0][a1],
+                                      S0[2][a3],
+                                      DS[2][a3]);
+                J_acc(j1, j2, j3, cur::jx2) += Jx2[a1];
+              }
+              if (a3 < L - 1) {
+                Jx3[a2][a1] -= Fx * DS[2][a3] * transverse(S0[0][a1],
+                                                           DS[0][a1],
+                                                           S0[1][a2],
+                                                           DS[1][a2]);
+                J_acc(j1, j2, j3, cur::jx3) += Jx3[a2][a1];
+              }
+            }
+          }
+        }
+      }
+    }
   };
 
 } // namespace kernel
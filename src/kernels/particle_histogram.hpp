@@ -0,0 +1,361 @@
+/**
+ * @file kernels/particle_histogram.hpp
+ * @brief Weighted histograms of particle quantities in up to 3 dimensions
+ * @implements
+ *   - kernel::ParticleHistogram_kernel<>
+ * @namespaces:
+ *   - kernel::
+ */
+
+#ifndef KERNELS_PARTICLE_HISTOGRAM_HPP
+#define KERNELS_PARTICLE_HISTOGRAM_HPP
+
+#include "enums.h"
+#include "global.h"
+
+#include "arch/kokkos_aliases.h"
+#include "utils/error.h"
+#include "utils/numeric.h"
+
+#include <Kokkos_Core.hpp>
+
+#include <algorithm>
+#include <vector>
+
+namespace kernel {
+  using namespace ntt;
+
+  /**
+   * @brief Bins the particles of one species into a (flattened) histogram
+   * @tparam S simulation engine
+   * @tparam M metric
+   * @note Binned quantities:
+   * ... energy: gamma - 1 (massive), |u| (massless)
+   * ... upar, uperp: 4-velocity along/across the local magnetic field
+   * ... pitch: cosine of the pitch angle w.r.t. the local magnetic field
+   * ... x1, x2, x3: physical coordinates
+   * @note The local magnetic field is the cell-centered (tetrad basis) value in
+   * ... the cell of the particle; field-aligned quantities are SRPIC-only
+   * @note Particles outside the histogram range are not counted (the upper
+   * ... edge is included into the last bin)
+   * @note With a team policy, each team bins a chunk of particles into a copy of
+   * ... the histogram in the scratch memory, which is then atomically added to
+   * ... the global one; with a range policy, the global histogram is updated
+   * ... atomically (for histograms which do not fit into the scratch memory)
+   */
+  template <SimEngine::type S, class M>
+  class ParticleHistogram_kernel {
+    static_assert(M::is_metric, "M must be a metric class");
+    static constexpr auto D = M::Dim;
+
+  public:
+    static constexpr unsigned short MaxAxes { 3 };
+    static constexpr npart_t        PrtlsPerTeam { 4096 };
+
+  private:
+    array_t<real_t*>  Hist;
+    const std::size_t nbins_tot;
+
+    unsigned short                         naxes;
+    Kokkos::Array<SpecAxis::type, MaxAxes> axes;
+    Kokkos::Array<std::size_t, MaxAxes>    nbins;
+    Kokkos::Array<real_t, MaxAxes>         vmin, vmax;
+    Kokkos::Array<bool, MaxAxes>           logs;
+    bool                                   need_x { false }, need_b { false };
+
+    const array_t<int*>      i1, i2, i3;
+    const array_t<prtldx_t*> dx1, dx2, dx3;
+    const array_t<real_t*>   ux1, ux2, ux3;
+    const array_t<real_t*>   phi;
+    const array_t<real_t*>   weight;
+    const array_t<short*>    tag;
+    const float              mass;
+    // cell-centered magnetic field in components (cb, cb + 1, cb + 2)
+    const ndfield_t<D, 6>    Bcc;
+    const unsigned short     cb;
+    const M                  metric;
+    const npart_t            npart, chunk;
+
+  public:
+    ParticleHistogram_kernel(const array_t<real_t*>&         hist,
+                             const std::vector<SpecAxis>&    axes_,
+                             const std::vector<std::size_t>& n_bins,
+                             const std::vector<real_t>&      min,
+                             const std::vector<real_t>&      max,
+                             const std::vector<bool>&        log_bins,
+                             const array_t<int*>&            i1,
+                             const array_t<int*>&            i2,
+                             const array_t<int*>&            i3,
+                             const array_t<prtldx_t*>&       dx1,
+                             const array_t<prtldx_t*>&       dx2,
+                             const array_t<prtldx_t*>&       dx3,
+                             const array_t<real_t*>&         ux1,
+                             const array_t<real_t*>&         ux2,
+                             const array_t<real_t*>&         ux3,
+                             const array_t<real_t*>&         phi,
+                             const array_t<real_t*>&         weight,
+                             const array_t<short*>&          tag,
+                             float                           mass,
+                             const ndfield_t<D, 6>&          Bcc,
+                             unsigned short                  cb,
+                             const M&                        metric,
+                             npart_t                         npart,
+                             npart_t                         chunk)
+      : Hist { hist }
+      , nbins_tot { hist.extent(0) }
+      , naxes { static_cast<unsigned short>(axes_.size()) }
+      , i1 { i1 }
+      , i2 { i2 }
+      , i3 { i3 }
+      , dx1 { dx1 }
+      , dx2 { dx2 }
+      , dx3 { dx3 }
+      , ux1 { ux1 }
+      , ux2 { ux2 }
+      , ux3 { ux3 }
+      , phi { phi }
+      , weight { weight }
+      , tag { tag }
+      , mass { mass }
+      , Bcc { Bcc }
+      , cb { cb }
+      , metric { metric }
+      , npart { npart }
+      , chunk { chunk } {
+      raise::ErrorIf(axes_.empty() or (axes_.size() > MaxAxes),
+                     "Invalid number of histogram axes",
+                     HERE);
+      raise::ErrorIf((n_bins.size() != axes_.size()) or
+                       (min.size() != axes_.size()) or
+                       (max.size() != axes_.size()) or
+                       (log_bins.size() != axes_.size()),
+                     "Inconsistent histogram axes",
+                     HERE);
+      raise::ErrorIf(cb > 3, "Invalid magnetic field component", HERE);
+      std::size_t ntot = 1;
+      for (auto d { 0u }; d < naxes; ++d) {
+        axes[d] = SpecAxis::INVALID;
+        for (const auto& variant : SpecAxis::variants) {
+          if (axes_[d] == variant) {
+            axes[d] = variant;
+          }
+        }
+        raise::ErrorIf(axes[d] == SpecAxis::INVALID, "Invalid histogram axis", HERE);
+        raise::ErrorIf(n_bins[d] == 0, "Empty histogram axis", HERE);
+        raise::ErrorIf(
+          ((axes[d] == SpecAxis::X2) and (D == Dim::_1D)) or
+            ((axes[d] == SpecAxis::X3) and (D != Dim::_3D)),
+          "Histogram axis not available in this dimension",
+          HERE);
+        nbins[d] = n_bins[d];
+        logs[d]  = log_bins[d];
+        vmin[d]  = logs[d] ? math::log10(min[d]) : min[d];
+        vmax[d]  = logs[d] ? math::log10(max[d]) : max[d];
+        raise::ErrorIf(not(vmax[d] > vmin[d]), "Invalid histogram range", HERE);
+        need_x |= (axes[d] == SpecAxis::X1) or (axes[d] == SpecAxis::X2) or
+                  (axes[d] == SpecAxis::X3);
+        need_b |= (axes[d] == SpecAxis::Upar) or (axes[d] == SpecAxis::Uperp) or
+                  (axes[d] == SpecAxis::Pitch);
+        ntot *= nbins[d];
+      }
+      raise::ErrorIf(ntot != nbins_tot, "Histogram buffer has a wrong size", HERE);
+      raise::ErrorIf(need_b and (S != SimEngine::SRPIC),
+                     "Field-aligned histograms are only available for SRPIC",
+                     HERE);
+      raise::ErrorIf(chunk == 0, "Invalid number of particles per team", HERE);
+    }
+
+    /**
+     * @brief number of particles binned by each team
+     * @note at least the number of bins, so that the flush of the team-local
+     * ... histogram stays subdominant
+     */
+    static auto chunk_size(std::size_t nbins_tot) -> npart_t {
+      return static_cast<npart_t>(
+        std::max(nbins_tot, static_cast<std::size_t>(PrtlsPerTeam)));
+    }
+
+    /**
+     * @brief size of the scratch memory (in bytes) required per team
+     */
+    static auto scratch_size(std::size_t nbins_tot) -> std::size_t {
+      return scratch_array_t<real_t*>::shmem_size(nbins_tot);
+    }
+
+    /**
+     * @brief Bin a single particle directly into the global histogram.
+     * @param p index.
+     */
+    Inline void operator()(index_t p) const {
+      const auto b = bin(p);
+      if (b < nbins_tot) {
+        Kokkos::atomic_add(&Hist(b), weight(p));
+      }
+    }
+
+    /**
+     * @brief Bin a chunk of particles into a team-local histogram.
+     * @param team team member (one team per chunk).
+     */
+    Inline void operator()(const team_member_t& team) const {
+      scratch_array_t<real_t*> buff { team.team_scratch(0), nbins_tot };
+      Kokkos::parallel_for(Kokkos::TeamThreadRange(team, nbins_tot),
+                           [&](std::size_t k) { buff(k) = ZERO; });
+      team.team_barrier();
+
+      const npart_t first = static_cast<npart_t>(team.league_rank()) * chunk;
+      const npart_t last  = (first + chunk < npart) ? (first + chunk) : npart;
+      Kokkos::parallel_for(Kokkos::TeamThreadRange(team, first, math::max(first, last)),
+                           [&](npart_t p) {
+                             const auto b = bin(p);
+                             if (b < nbins_tot) {
+                               Kokkos::atomic_add(&buff(b), weight(p));
+                             }
+                           });
+      team.team_barrier();
+
+      Kokkos::parallel_for(Kokkos::TeamThreadRange(team, nbins_tot),
+                           [&](std::size_t k) {
+                             if (buff(k) != ZERO) {
+                               Kokkos::atomic_add(&Hist(k), buff(k));
+                             }
+                           });
+    }
+
+  private:
+    /**
+     * @brief Flattened bin index of the particle
+     * @returns `nbins_tot` if the particle is not counted
+     */
+    Inline auto bin(index_t p) const -> std::size_t {
+      if (tag(p) != ParticleTag::alive) {
+        return nbins_tot;
+      }
+      coord_t<D> x_Cd { ZERO };
+      x_Cd[0] = static_cast<real_t>(i1(p)) + static_cast<real_t>(dx1(p));
+      if constexpr (D == Dim::_2D or D == Dim::_3D) {
+        x_Cd[1] = static_cast<real_t>(i2(p)) + static_cast<real_t>(dx2(p));
+      }
+      if constexpr (D == Dim::_3D) {
+        x_Cd[2] = static_cast<real_t>(i3(p)) + static_cast<real_t>(dx3(p));
+      }
+      const auto u_sqr = NORM_SQR(ux1(p), ux2(p), ux3(p));
+      real_t     u_par { ZERO };
+      bool       has_b { false };
+      if constexpr (S == SimEngine::SRPIC) {
+        if (need_b) {
+          has_b = fieldAligned(p, x_Cd, u_par);
+        }
+      }
+      coord_t<D> x_Ph { ZERO };
+      if (need_x) {
+        metric.template convert<Crd::Cd, Crd::Ph>(x_Cd, x_Ph);
+      }
+
+      std::size_t idx = 0;
+      for (auto d { 0u }; d < naxes; ++d) {
+        real_t value { ZERO };
+        if (axes[d] == SpecAxis::Energy) {
+          value = (mass == 0.0f) ? math::sqrt(u_sqr)
+                                 : math::sqrt(ONE + u_sqr) - ONE;
+        } else if (axes[d] == SpecAxis::Upar) {
+          if (not has_b) {
+            return nbins_tot;
+          }
+          value = u_par;
+        } else if (axes[d] == SpecAxis::Uperp) {
+          if (not has_b) {
+            return nbins_tot;
+          }
+          value = math::sqrt(math::max(u_sqr - SQR(u_par), ZERO));
+        } else if (axes[d] == SpecAxis::Pitch) {
+          if ((not has_b) or (u_sqr == ZERO)) {
+            return nbins_tot;
+          }
+          value = u_par / math::sqrt(u_sqr);
+        } else if (axes[d] == SpecAxis::X1) {
+          value = x_Ph[0];
+        } else if (axes[d] == SpecAxis::X2) {
+          if constexpr (D == Dim::_2D or D == Dim::_3D) {
+            value = x_Ph[1];
+          }
+        } else if (axes[d] == SpecAxis::X3) {
+          if constexpr (D == Dim::_3D) {
+            value = x_Ph[2];
+          }
+        }
+        if (logs[d]) {
+          if (value <= ZERO) {
+            return nbins_tot;
+          }
+          value = math::log10(value);
+        }
+        if ((value < vmin[d]) or (value > vmax[d])) {
+          return nbins_tot;
+        }
+        auto i = static_cast<std::size_t>(static_cast<real_t>(nbins[d]) *
+                                          (value - vmin[d]) / (vmax[d] - vmin[d]));
+        if (i >= nbins[d]) {
+          i = nbins[d] - 1;
+        }
+        idx = idx * nbins[d] + i;
+      }
+      return idx;
+    }
+
+    /**
+     * @brief Projection of the 4-velocity onto the local magnetic field
+     * @returns false if the magnetic field vanishes
+     */
+    Inline auto fieldAligned(index_t           p,
+                             const coord_t<D>& x_Cd,
+                             real_t&           u_par) const -> bool {
+      vec_t<Dim::_3D> b_T { ZERO };
+      const int       i { i1(p) + static_cast<int>(N_GHOSTS) };
+      if constexpr (D == Dim::_1D) {
+        b_T[0] = Bcc(i, cb);
+        b_T[1] = Bcc(i, cb + 1);
+        b_T[2] = Bcc(i, cb + 2);
+      } else if constexpr (D == Dim::_2D) {
+        const int j { i2(p) + static_cast<int>(N_GHOSTS) };
+        b_T[0] = Bcc(i, j, cb);
+        b_T[1] = Bcc(i, j, cb + 1);
+        b_T[2] = Bcc(i, j, cb + 2);
+      } else {
+        const int j { i2(p) + static_cast<int>(N_GHOSTS) };
+        const int k { i3(p) + static_cast<int>(N_GHOSTS) };
+        b_T[0] = Bcc(i, j, k, cb);
+        b_T[1] = Bcc(i, j, k, cb + 1);
+        b_T[2] = Bcc(i, j, k, cb + 2);
+      }
+      const auto b_norm = NORM(b_T[0], b_T[1], b_T[2]);
+      if (b_norm == ZERO) {
+        return false;
+      }
+      vec_t<Dim::_3D> u_T { ZERO };
+      if constexpr (M::CoordType == Coord::Cart) {
+        u_T[0] = ux1(p);
+        u_T[1] = ux2(p);
+        u_T[2] = ux3(p);
+      } else {
+        // particle velocities are stored in the global Cartesian basis
+        coord_t<M::PrtlDim> x_Code { ZERO };
+        x_Code[0] = x_Cd[0];
+        x_Code[1] = x_Cd[1];
+        if constexpr (D == Dim::_3D) {
+          x_Code[2] = x_Cd[2];
+        } else {
+          x_Code[2] = phi(p);
+        }
+        metric.template transform_xyz<Idx::XYZ, Idx::T>(x_Code,
+                                                        { ux1(p), ux2(p), ux3(p) },
+                                                        u_T);
+      }
+      u_par = DOT(u_T[0], u_T[1], u_T[2], b_T[0], b_T[1], b_T[2]) / b_norm;
+      return true;
+    }
+  };
+
+} // namespace kernel
+
+#endif // KERNELS_PARTICLE_HISTOGRAM_HPP
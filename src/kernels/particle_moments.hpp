@@ -2,7 +2,12 @@
  * @file kernels/particle_moments.hpp
  * @brief Algorithm for computing different moments from particle distribution
  * @implements
+ *   - kernel::PrtlMomentFactors
+ *   - kernel::ComputePrtlMomentFactors<>
+ *   - kernel::PrtlMomentCoeff
  *   - kernel::ParticleMoments_kernel<>
+ *   - kernel::MomentSpec
+ *   - kernel::ParticleMomentsBatch_kernel<>
  * @namespaces:
  *   - kernel::
  */
@@ -18,25 +23,166 @@
 #include "utils/error.h"
 #include "utils/numeric.h"
 
+#include "kernels/particle_shapes.hpp"
+
 #include <vector>
 
 namespace kernel {
   using namespace ntt;
 
-  template <FldsID::type F>
-  auto get_contrib(float mass, float charge) -> real_t {
-    if constexpr (F == FldsID::Rho) {
-      return mass;
-    } else if constexpr (F == FldsID::Charge) {
-      return charge;
-    } else {
-      return ONE;
+  /**
+   * @brief Particle-dependent factors of the moments
+   * @param u_Phys 4-velocity (SR: tetrad basis, GR: physical contravariant)
+   * @param gamma Lorentz factor (or |u| for massless particles)
+   * @param energy gamma * mass (or |u| for massless particles)
+   * @param volume smoothing, inverse cell volume & weight factor
+   */
+  struct PrtlMomentFactors {
+    vec_t<Dim::_3D> u_Phys { ZERO };
+    real_t          gamma { ONE }, energy { ONE }, volume { ONE };
+  };
+
+  /**
+   * @brief Computes the factors of a particle shared by all of its moments
+   * @param with_velocity compute the 4-velocity & energy (needed for T & V)
+   */
+  template <SimEngine::type S, class M>
+  Inline auto ComputePrtlMomentFactors(index_t                   p,
+                                       const M&                  metric,
+                                       const array_t<int*>&      i1,
+                                       const array_t<int*>&      i2,
+                                       const array_t<int*>&      i3,
+                                       const array_t<prtldx_t*>& dx1,
+                                       const array_t<prtldx_t*>& dx2,
+                                       const array_t<prtldx_t*>& dx3,
+                                       const array_t<real_t*>&   ux1,
+                                       const array_t<real_t*>&   ux2,
+                                       const array_t<real_t*>&   ux3,
+                                       const array_t<real_t*>&   phi,
+                                       const array_t<real_t*>&   weight,
+                                       float                     mass,
+                                       bool                      use_weights,
+                                       real_t                    smooth,
+                                       bool with_velocity) -> PrtlMomentFactors {
+    constexpr auto    D = M::Dim;
+    PrtlMomentFactors f;
+    if (with_velocity) {
+      if constexpr (S == SimEngine::SRPIC) {
+        // tetrad (hatted) basis
+        if constexpr (M::CoordType == Coord::Cart) {
+          f.u_Phys[0] = ux1(p);
+          f.u_Phys[1] = ux2(p);
+          f.u_Phys[2] = ux3(p);
+        } else {
+          static_assert(D != Dim::_1D, "non-Cartesian SRPIC 1D");
+          coord_t<M::PrtlDim> x_Code { ZERO };
+          x_Code[0] = static_cast<real_t>(i1(p)) + static_cast<real_t>(dx1(p));
+          x_Code[1] = static_cast<real_t>(i2(p)) + static_cast<real_t>(dx2(p));
+          if constexpr (D == Dim::_3D) {
+            x_Code[2] = static_cast<real_t>(i3(p)) + static_cast<real_t>(dx3(p));
+          } else {
+            x_Code[2] = phi(p);
+          }
+          metric.template transform_xyz<Idx::XYZ, Idx::T>(
+            x_Code,
+            { ux1(p), ux2(p), ux3(p) },
+            f.u_Phys);
+        }
+        if (mass == ZERO) {
+          f.gamma = NORM(f.u_Phys[0], f.u_Phys[1], f.u_Phys[2]);
+        } else {
+          f.gamma = math::sqrt(
+            ONE + NORM_SQR(f.u_Phys[0], f.u_Phys[1], f.u_Phys[2]));
+        }
+      } else {
+        // contravariant basis
+        static_assert(D != Dim::_1D, "GRPIC 1D");
+        coord_t<D> x_Code { ZERO };
+        x_Code[0] = static_cast<real_t>(i1(p)) + static_cast<real_t>(dx1(p));
+        x_Code[1] = static_cast<real_t>(i2(p)) + static_cast<real_t>(dx2(p));
+        if constexpr (D == Dim::_3D) {
+          x_Code[2] = static_cast<real_t>(i3(p)) + static_cast<real_t>(dx3(p));
+        }
+        vec_t<Dim::_3D> u_Cntrv { ZERO };
+        // compute u_i u^i for energy
+        metric.template transform<Idx::D, Idx::U>(x_Code,
+                                                  { ux1(p), ux2(p), ux3(p) },
+                                                  u_Cntrv);
+        f.gamma = u_Cntrv[0] * ux1(p) + u_Cntrv[1] * ux2(p) +
+                  u_Cntrv[2] * ux3(p);
+        if (mass == ZERO) {
+          f.gamma = math::sqrt(f.gamma);
+        } else {
+          f.gamma = math::sqrt(ONE + f.gamma);
+        }
+        metric.template transform<Idx::U, Idx::PU>(x_Code, u_Cntrv, f.u_Phys);
+      }
+      f.energy = (mass == ZERO) ? f.gamma : mass * f.gamma;
+    }
+    f.volume = smooth;
+    if constexpr (D == Dim::_1D) {
+      f.volume /= metric.sqrt_det_h({ static_cast<real_t>(i1(p)) + HALF });
+    } else if constexpr (D == Dim::_2D) {
+      f.volume /= metric.sqrt_det_h({ static_cast<real_t>(i1(p)) + HALF,
+                                      static_cast<real_t>(i2(p)) + HALF });
+    } else if constexpr (D == Dim::_3D) {
+      f.volume /= metric.sqrt_det_h({ static_cast<real_t>(i1(p)) + HALF,
+                                      static_cast<real_t>(i2(p)) + HALF,
+                                      static_cast<real_t>(i3(p)) + HALF });
+    }
+    if (use_weights) {
+      f.volume *= weight(p);
+    }
+    return f;
+  }
+
+  /**
+   * @brief Contribution of a particle to a single moment
+   * @param c1, c2 components (T: both, V: only c1)
+   * @note Nppc does not take the volume, weights or smoothing into account
+   */
+  Inline auto PrtlMomentCoeff(FldsID::type             id,
+                              unsigned short           c1,
+                              unsigned short           c2,
+                              float                    mass,
+                              float                    charge,
+                              const PrtlMomentFactors& f) -> real_t {
+    real_t coeff { ONE };
+    if (id == FldsID::T) {
+      coeff = ONE / f.energy;
+      for (const auto& c : { c1, c2 }) {
+        if (c == 0) {
+          coeff *= f.energy;
+        } else {
+          coeff *= ((mass == ZERO) ? ONE : mass) * f.u_Phys[c - 1];
+        }
+      }
+    } else if (id == FldsID::V) {
+      coeff = f.u_Phys[c1 - 1] / f.gamma;
+    } else if (id == FldsID::Rho) {
+      coeff = mass;
+    } else if (id == FldsID::Charge) {
+      coeff = charge;
+    }
+    if (id != FldsID::Nppc) {
+      coeff *= f.volume;
     }
+    return coeff;
   }
 
-  template <SimEngine::type S, class M, FldsID::type F, unsigned short N>
+  /**
+   * @tparam O Order of the particle shape: the moments are deposited to the
+   * cell centers with the shape of order `O - 1` (i.e., each particle
+   * contributes to its own cell for the first order)
+   */
+  template <SimEngine::type S,
+            class M,
+            FldsID::type   F,
+            unsigned short N,
+            unsigned short O = SHAPE_ORDER>
   class ParticleMoments_kernel {
     static_assert(M::is_metric, "M must be a metric class");
+    static_assert((O >= 1) and (O <= 3), "Invalid shape order");
     static constexpr auto D = M::Dim;
 
     static_assert(!((S == SimEngine::GRPIC) && (F == FldsID::V)),
@@ -61,7 +207,6 @@ namespace kernel {
     const int                ni2;
     const unsigned short     window;
 
-    const real_t contrib;
     const real_t smooth;
     bool         is_axis_i2min { false }, is_axis_i2max { false };
 
@@ -113,11 +258,12 @@ namespace kernel {
       , metric { metric }
       , ni2 { static_cast<int>(ni2) }
       , window { window }
-      , contrib { get_contrib<F>(mass, charge) }
       , smooth { inv_n0 / (real_t)(math::pow(TWO * (real_t)window + ONE,
                                              static_cast<int>(D))) } {
       raise::ErrorIf(buff_idx >= N, "Invalid buffer index", HERE);
-      raise::ErrorIf(window > N_GHOSTS, "Window size too large", HERE);
+      raise::ErrorIf(window + ((O > 1) ? 1 : 0) > N_GHOSTS,
+                     "Window size too large",
+                     HERE);
       raise::ErrorIf(((F == FldsID::Rho) || (F == FldsID::Charge)) && (mass == ZERO),
                      "Rho & Charge for massless particles not defined",
                      HERE);
@@ -133,239 +279,285 @@ namespace kernel {
       if (tag(p) == ParticleTag::dead) {
         return;
       }
-      real_t coeff { ZERO };
-      if constexpr (F == FldsID::T) {
-        real_t          energy { ZERO };
-        // for stress-energy tensor
-        vec_t<Dim::_3D> u_Phys { ZERO };
-        if constexpr (S == SimEngine::SRPIC) {
-          // SR
-          // stress-energy tensor for SR is computed in the tetrad (hatted) basis
-          if constexpr (M::CoordType == Coord::Cart) {
-            u_Phys[0] = ux1(p);
-            u_Phys[1] = ux2(p);
-            u_Phys[2] = ux3(p);
-          } else {
-            static_assert(D != Dim::_1D, "non-Cartesian SRPIC 1D");
-            coord_t<M::PrtlDim> x_Code { ZERO };
-            x_Code[0] = static_cast<real_t>(i1(p)) + static_cast<real_t>(dx1(p));
-            x_Code[1] = static_cast<real_t>(i2(p)) + static_cast<real_t>(dx2(p));
-            if constexpr (D == Dim::_3D) {
-              x_Code[2] = static_cast<real_t>(i3(p)) + static_cast<real_t>(dx3(p));
-            } else {
-              x_Code[2] = phi(p);
-            }
-            metric.template transform_xyz<Idx::XYZ, Idx::T>(
-              x_Code,
-              { ux1(p), ux2(p), ux3(p) },
-              u_Phys);
-          }
-          if (mass == ZERO) {
-            energy = NORM(u_Phys[0], u_Phys[1], u_Phys[2]);
-          } else {
-            energy = mass *
-              math::sqrt(ONE + NORM_SQR(u_Phys[0], u_Phys[1], u_Phys[2]));
-          }
-        } else {
-          // GR
-          // stress-energy tensor for GR is computed in contravariant basis
-          static_assert(D != Dim::_1D, "GRPIC 1D");
-          coord_t<D> x_Code { ZERO };
-          x_Code[0] = static_cast<real_t>(i1(p)) + static_cast<real_t>(dx1(p));
-          x_Code[1] = static_cast<real_t>(i2(p)) + static_cast<real_t>(dx2(p));
-          if constexpr (D == Dim::_3D) {
-            x_Code[2] = static_cast<real_t>(i3(p)) + static_cast<real_t>(dx3(p));
-          }
-          vec_t<Dim::_3D> u_Cntrv { ZERO };
-          // compute u_i u^i for energy
-          metric.template transform<Idx::D, Idx::U>(x_Code,
-                                                    { ux1(p), ux2(p), ux3(p) },
-                                                    u_Cntrv);
-          energy = u_Cntrv[0] * ux1(p) + u_Cntrv[1] * ux2(p) + u_Cntrv[2] * ux3(p);
-          if (mass == ZERO) {
-            energy = math::sqrt(energy);
-          } else {
-            energy = mass * math::sqrt(ONE + energy);
+      // clang-format off
+      const auto f = ComputePrtlMomentFactors<S, M>(p, metric,
+                                                    i1, i2, i3,
+                                                    dx1, dx2, dx3,
+                                                    ux1, ux2, ux3,
+                                                    phi, weight,
+                                                    mass, use_weights, smooth,
+                                                    (F == FldsID::T) or
+                                                      (F == FldsID::V));
+      // clang-format on
+      const auto coeff = PrtlMomentCoeff(F, c1, c2, mass, charge, f);
+      // cells covered by the particle (without ghosts) & their weights
+      int    k_min[3] { 0, 0, 0 };
+      real_t W[3][O];
+      shape::order<O - 1, true>(i1(p), dx1(p), k_min[0], W[0]);
+      if constexpr (D == Dim::_2D or D == Dim::_3D) {
+        shape::order<O - 1, true>(i2(p), dx2(p), k_min[1], W[1]);
+      }
+      if constexpr (D == Dim::_3D) {
+        shape::order<O - 1, true>(i3(p), dx3(p), k_min[2], W[2]);
+      }
+      auto buff_access = Buff.access();
+      if constexpr (D == Dim::_1D) {
+        for (auto di1 { -window }; di1 <= window; ++di1) {
+          for (auto s1 { 0 }; s1 < O; ++s1) {
+            const auto j1 = k_min[0] + s1 + di1 + N_GHOSTS;
+            buff_access(j1, buff_idx) += coeff * W[0][s1];
           }
-          metric.template transform<Idx::U, Idx::PU>(x_Code, u_Cntrv, u_Phys);
         }
-        // compute the corresponding moment
-        coeff = ONE / energy;
-#pragma unroll
-        for (const auto& c : { c1, c2 }) {
-          if (c == 0) {
-            coeff *= energy;
-          } else {
-            coeff *= ((mass == ZERO) ? ONE : mass) * u_Phys[c - 1];
+      } else if constexpr (D == Dim::_2D) {
+        for (auto di2 { -window }; di2 <= window; ++di2) {
+          for (auto s2 { 0 }; s2 < O; ++s2) {
+            const auto j2 = cellIndex_i2(k_min[1] + s2 + di2);
+            for (auto di1 { -window }; di1 <= window; ++di1) {
+              for (auto s1 { 0 }; s1 < O; ++s1) {
+                const auto j1 = k_min[0] + s1 + di1 + N_GHOSTS;
+                buff_access(j1, j2, buff_idx) += coeff * W[0][s1] * W[1][s2];
+              }
+            }
           }
         }
-      } else if constexpr (F == FldsID::V) {
-        real_t          gamma { ZERO };
-        // for bulk 3vel (tetrad basis)
-        vec_t<Dim::_3D> u_Phys { ZERO };
-        if constexpr (M::CoordType == Coord::Cart) {
-          u_Phys[0] = ux1(p);
-          u_Phys[1] = ux2(p);
-          u_Phys[2] = ux3(p);
-        } else {
-          coord_t<M::PrtlDim> x_Code { ZERO };
-          x_Code[0] = static_cast<real_t>(i1(p)) + static_cast<real_t>(dx1(p));
-          x_Code[1] = static_cast<real_t>(i2(p)) + static_cast<real_t>(dx2(p));
-          if constexpr (D == Dim::_3D) {
-            x_Code[2] = static_cast<real_t>(i3(p)) + static_cast<real_t>(dx3(p));
-          } else {
-            x_Code[2] = phi(p);
+      } else if constexpr (D == Dim::_3D) {
+        for (auto di3 { -window }; di3 <= window; ++di3) {
+          for (auto s3 { 0 }; s3 < O; ++s3) {
+            const auto j3 = k_min[2] + s3 + di3 + N_GHOSTS;
+            for (auto di2 { -window }; di2 <= window; ++di2) {
+              for (auto s2 { 0 }; s2 < O; ++s2) {
+                const auto j2 = cellIndex_i2(k_min[1] + s2 + di2);
+                for (auto di1 { -window }; di1 <= window; ++di1) {
+                  for (auto s1 { 0 }; s1 < O; ++s1) {
+                    const auto j1 = k_min[0] + s1 + di1 + N_GHOSTS;
+                    buff_access(j1, j2, j3, buff_idx) += coeff * W[0][s1] *
+                                                         W[1][s2] * W[2][s3];
+                  }
+                }
+              }
+            }
           }
-          metric.template transform_xyz<Idx::XYZ, Idx::T>(x_Code,
-                                                          { ux1(p), ux2(p), ux3(p) },
-                                                          u_Phys);
         }
-        if (mass == ZERO) {
-          gamma = NORM(u_Phys[0], u_Phys[1], u_Phys[2]);
-        } else {
-          gamma = math::sqrt(ONE + NORM_SQR(u_Phys[0], u_Phys[1], u_Phys[2]));
-        }
-        // compute the corresponding moment
-        coeff = (mass == ZERO ? ONE : mass) * u_Phys[c1 - 1] / gamma;
-      } else {
-        // for other cases, use the `contrib` defined above
-        coeff = contrib;
       }
+    }
 
-      if constexpr (F == FldsID::V) {
-        real_t          gamma { ZERO };
-        // for stress-energy tensor
-        vec_t<Dim::_3D> u_Phys { ZERO };
-        if constexpr (S == SimEngine::SRPIC) {
-          // SR
-          // stress-energy tensor for SR is computed in the tetrad (hatted) basis
-          if constexpr (M::CoordType == Coord::Cart) {
-            u_Phys[0] = ux1(p);
-            u_Phys[1] = ux2(p);
-            u_Phys[2] = ux3(p);
-          } else {
-            static_assert(D != Dim::_1D, "non-Cartesian SRPIC 1D");
-            coord_t<M::PrtlDim> x_Code { ZERO };
-            x_Code[0] = static_cast<real_t>(i1(p)) + static_cast<real_t>(dx1(p));
-            x_Code[1] = static_cast<real_t>(i2(p)) + static_cast<real_t>(dx2(p));
-            if constexpr (D == Dim::_3D) {
-              x_Code[2] = static_cast<real_t>(i3(p)) + static_cast<real_t>(dx3(p));
-            } else {
-              x_Code[2] = phi(p);
-            }
-            metric.template transform_xyz<Idx::XYZ, Idx::T>(
-              x_Code,
-              { ux1(p), ux2(p), ux3(p) },
-              u_Phys);
-          }
-          if (mass == ZERO) {
-            gamma = NORM(u_Phys[0], u_Phys[1], u_Phys[2]);
-          } else {
-            gamma = math::sqrt(ONE + NORM_SQR(u_Phys[0], u_Phys[1], u_Phys[2]));
-          }
-        } else {
-          // GR
-          // stress-energy tensor for GR is computed in contravariant basis
-          static_assert(D != Dim::_1D, "GRPIC 1D");
-          coord_t<D> x_Code { ZERO };
-          x_Code[0] = static_cast<real_t>(i1(p)) + static_cast<real_t>(dx1(p));
-          x_Code[1] = static_cast<real_t>(i2(p)) + static_cast<real_t>(dx2(p));
-          if constexpr (D == Dim::_3D) {
-            x_Code[2] = static_cast<real_t>(i3(p)) + static_cast<real_t>(dx3(p));
-          }
-          vec_t<Dim::_3D> u_Cntrv { ZERO };
-          // compute u_i u^i for energy
-          metric.template transform<Idx::D, Idx::U>(x_Code,
-                                                    { ux1(p), ux2(p), ux3(p) },
-                                                    u_Cntrv);
-          gamma = u_Cntrv[0] * ux1(p) + u_Cntrv[1] * ux2(p) + u_Cntrv[2] * ux3(p);
-          if (mass == ZERO) {
-            gamma = math::sqrt(gamma);
-          } else {
-            gamma = math::sqrt(ONE + gamma);
-          }
-          metric.template transform<Idx::U, Idx::PU>(x_Code, u_Cntrv, u_Phys);
+  private:
+    /**
+     * @brief Ghost-included index of the cell `k2` along x2
+     * @note Contributions beyond the axes are reflected back
+     */
+    Inline auto cellIndex_i2(int k2) const -> int {
+      if constexpr (M::CoordType != Coord::Cart) {
+        if (is_axis_i2min && (k2 < 0)) {
+          return static_cast<int>(N_GHOSTS) - k2;
+        } else if (is_axis_i2max && (k2 >= ni2)) {
+          return 2 * ni2 - k2 + static_cast<int>(N_GHOSTS);
         }
-        // compute the corresponding moment
-        coeff = u_Phys[c1 - 1] / gamma;
       }
+      return k2 + static_cast<int>(N_GHOSTS);
+    }
+  };
 
-      if constexpr (F != FldsID::Nppc) {
-        // for nppc calculation ...
-        // ... do not take volume, weights or smoothing into account
-        if constexpr (D == Dim::_1D) {
-          coeff *= smooth /
-                   metric.sqrt_det_h({ static_cast<real_t>(i1(p)) + HALF });
-        } else if constexpr (D == Dim::_2D) {
-          coeff *= smooth /
-                   metric.sqrt_det_h({ static_cast<real_t>(i1(p)) + HALF,
-                                       static_cast<real_t>(i2(p)) + HALF });
-        } else if constexpr (D == Dim::_3D) {
-          coeff *= smooth /
-                   metric.sqrt_det_h({ static_cast<real_t>(i1(p)) + HALF,
-                                       static_cast<real_t>(i2(p)) + HALF,
-                                       static_cast<real_t>(i3(p)) + HALF });
-        }
-        if (use_weights) {
-          coeff *= weight(p);
-        }
+  /**
+   * @brief A single moment deposited by `ParticleMomentsBatch_kernel`
+   * @param id moment type (Rho, Charge, N, Nppc, T or V)
+   * @param c1, c2 components (T: both, V: only c1)
+   * @param buff_idx component of the buffer to deposit to
+   */
+  struct MomentSpec {
+    FldsID::type   id { FldsID::INVALID };
+    unsigned short c1 { 0 }, c2 { 0 };
+    unsigned short buff_idx { 0 };
+  };
+
+  /**
+   * @brief Deposits several moments of one species in a single particle sweep
+   * @tparam S simulation engine
+   * @tparam M metric
+   * @tparam O order of the particle shape (see `ParticleMoments_kernel`)
+   * @note Same definitions as `ParticleMoments_kernel` (both use
+   * `ComputePrtlMomentFactors` & `PrtlMomentCoeff`); the particle-dependent
+   * factors are computed once and shared between all the moments
+   * @note The buffer has a runtime number of components (the last index);
+   * `buff_idx` of each moment is assumed to be within its range
+   */
+  template <SimEngine::type S, class M, unsigned short O = SHAPE_ORDER>
+  class ParticleMomentsBatch_kernel {
+    static_assert(M::is_metric, "M must be a metric class");
+    static_assert((O >= 1) and (O <= 3), "Invalid shape order");
+    static constexpr auto D = M::Dim;
+
+  public:
+    static constexpr unsigned short MaxMoments { 16 };
+    using buffer_t = ndarray_t<static_cast<unsigned short>(D) + 1>;
+
+  private:
+    Kokkos::Array<MomentSpec, MaxMoments>         moments;
+    const unsigned short                          nmoments;
+    scatter_array_t<typename buffer_t::data_type> Buff;
+    const array_t<int*>                           i1, i2, i3;
+    const array_t<prtldx_t*>                      dx1, dx2, dx3;
+    const array_t<real_t*>                        ux1, ux2, ux3;
+    const array_t<real_t*>                        phi;
+    const array_t<real_t*>                        weight;
+    const array_t<short*>                         tag;
+    const float                                   mass;
+    const float                                   charge;
+    const bool                                    use_weights;
+    const M                                       metric;
+    const int                                     ni2;
+    const int                                     window;
+    const real_t                                  smooth;
+    bool is_axis_i2min { false }, is_axis_i2max { false };
+    bool needs_velocity { false };
+
+  public:
+    ParticleMomentsBatch_kernel(
+      const std::vector<MomentSpec>&                       moment_specs,
+      const scatter_array_t<typename buffer_t::data_type>& scatter_buff,
+      const array_t<int*>&                                 i1,
+      const array_t<int*>&                                 i2,
+      const array_t<int*>&                                 i3,
+      const array_t<prtldx_t*>&                            dx1,
+      const array_t<prtldx_t*>&                            dx2,
+      const array_t<prtldx_t*>&                            dx3,
+      const array_t<real_t*>&                              ux1,
+      const array_t<real_t*>&                              ux2,
+      const array_t<real_t*>&                              ux3,
+      const array_t<real_t*>&                              phi,
+      const array_t<real_t*>&                              weight,
+      const array_t<short*>&                               tag,
+      float                                                mass,
+      float                                                charge,
+      bool                                                 use_weights,
+      const M&                                             metric,
+      const boundaries_t<FldsBC>&                          boundaries,
+      ncells_t                                             ni2,
+      real_t                                               inv_n0,
+      unsigned short                                       window)
+      : nmoments { static_cast<unsigned short>(moment_specs.size()) }
+      , Buff { scatter_buff }
+      , i1 { i1 }
+      , i2 { i2 }
+      , i3 { i3 }
+      , dx1 { dx1 }
+      , dx2 { dx2 }
+      , dx3 { dx3 }
+      , ux1 { ux1 }
+      , ux2 { ux2 }
+      , ux3 { ux3 }
+      , phi { phi }
+      , weight { weight }
+      , tag { tag }
+      , mass { mass }
+      , charge { charge }
+      , use_weights { use_weights }
+      , metric { metric }
+      , ni2 { static_cast<int>(ni2) }
+      , window { static_cast<int>(window) }
+      , smooth { inv_n0 / (real_t)(math::pow(TWO * (real_t)window + ONE,
+                                             static_cast<int>(D))) } {
+      raise::ErrorIf(moment_specs.empty() or (moment_specs.size() > MaxMoments),
+                     "Invalid # of moments in a batch",
+                     HERE);
+      raise::ErrorIf(window + ((O > 1) ? 1 : 0) > N_GHOSTS,
+                     "Window size too large",
+                     HERE);
+      for (auto m { 0u }; m < moment_specs.size(); ++m) {
+        const auto& spec = moment_specs[m];
+        raise::ErrorIf((spec.id != FldsID::Rho) and (spec.id != FldsID::Charge) and
+                         (spec.id != FldsID::N) and (spec.id != FldsID::Nppc) and
+                         (spec.id != FldsID::T) and (spec.id != FldsID::V),
+                       "Invalid field ID",
+                       HERE);
+        raise::ErrorIf((S == SimEngine::GRPIC) and (spec.id == FldsID::V),
+                       "Bulk velocity not supported for GRPIC",
+                       HERE);
+        raise::ErrorIf(((spec.id == FldsID::Rho) or (spec.id == FldsID::Charge)) and
+                         (mass == ZERO),
+                       "Rho & Charge for massless particles not defined",
+                       HERE);
+        needs_velocity |= (spec.id == FldsID::T) or (spec.id == FldsID::V);
+        moments[m] = spec;
+      }
+      if constexpr ((M::CoordType != Coord::Cart) &&
+                    ((D == Dim::_2D) || (D == Dim::_3D))) {
+        raise::ErrorIf(boundaries.size() < 2, "boundaries defined incorrectly", HERE);
+        is_axis_i2min = (boundaries[1].first == FldsBC::AXIS);
+        is_axis_i2max = (boundaries[1].second == FldsBC::AXIS);
+      }
+    }
+
+    Inline void operator()(index_t p) const {
+      if (tag(p) == ParticleTag::dead) {
+        return;
+      }
+      // clang-format off
+      const auto f = ComputePrtlMomentFactors<S, M>(p, metric,
+                                                    i1, i2, i3,
+                                                    dx1, dx2, dx3,
+                                                    ux1, ux2, ux3,
+                                                    phi, weight,
+                                                    mass, use_weights, smooth,
+                                                    needs_velocity);
+      // clang-format on
+      real_t coeffs[MaxMoments];
+      for (auto m { 0u }; m < nmoments; ++m) {
+        const auto& spec = moments[m];
+        coeffs[m] = PrtlMomentCoeff(spec.id, spec.c1, spec.c2, mass, charge, f);
+      }
+
+      // cells covered by the particle (without ghosts) & their weights
+      int    k_min[3] { 0, 0, 0 };
+      real_t W[3][O];
+      shape::order<O - 1, true>(i1(p), dx1(p), k_min[0], W[0]);
+      if constexpr (D == Dim::_2D or D == Dim::_3D) {
+        shape::order<O - 1, true>(i2(p), dx2(p), k_min[1], W[1]);
+      }
+      if constexpr (D == Dim::_3D) {
+        shape::order<O - 1, true>(i3(p), dx3(p), k_min[2], W[2]);
       }
       auto buff_access = Buff.access();
       if constexpr (D == Dim::_1D) {
         for (auto di1 { -window }; di1 <= window; ++di1) {
-          buff_access(i1(p) + di1 + N_GHOSTS, buff_idx) += coeff;
+          for (auto s1 { 0 }; s1 < O; ++s1) {
+            const auto j1 = k_min[0] + s1 + di1 + N_GHOSTS;
+            for (auto m { 0u }; m < nmoments; ++m) {
+              buff_access(j1, moments[m].buff_idx) += coeffs[m] * W[0][s1];
+            }
+          }
         }
       } else if constexpr (D == Dim::_2D) {
         for (auto di2 { -window }; di2 <= window; ++di2) {
-          for (auto di1 { -window }; di1 <= window; ++di1) {
-            if constexpr (M::CoordType == Coord::Cart) {
-              buff_access(i1(p) + di1 + N_GHOSTS,
-                          i2(p) + di2 + N_GHOSTS,
-                          buff_idx) += coeff;
-            } else {
-              // reflect contribution at axes
-              if (is_axis_i2min && (i2(p) + di2 < 0)) {
-                buff_access(i1(p) + di1 + N_GHOSTS,
-                            N_GHOSTS - (i2(p) + di2),
-                            buff_idx) += coeff;
-              } else if (is_axis_i2max && (i2(p) + di2 >= ni2)) {
-                buff_access(i1(p) + di1 + N_GHOSTS,
-                            2 * ni2 - (i2(p) + di2) + N_GHOSTS,
-                            buff_idx) += coeff;
-              } else {
-                buff_access(i1(p) + di1 + N_GHOSTS,
-                            i2(p) + di2 + N_GHOSTS,
-                            buff_idx) += coeff;
+          for (auto s2 { 0 }; s2 < O; ++s2) {
+            const auto j2 = cellIndex_i2(k_min[1] + s2 + di2);
+            for (auto di1 { -window }; di1 <= window; ++di1) {
+              for (auto s1 { 0 }; s1 < O; ++s1) {
+                const auto j1 = k_min[0] + s1 + di1 + N_GHOSTS;
+                const auto w  = W[0][s1] * W[1][s2];
+                for (auto m { 0u }; m < nmoments; ++m) {
+                  buff_access(j1, j2, moments[m].buff_idx) += coeffs[m] * w;
+                }
               }
             }
           }
         }
       } else if constexpr (D == Dim::_3D) {
         for (auto di3 { -window }; di3 <= window; ++di3) {
-          for (auto di2 { -window }; di2 <= window; ++di2) {
-            for (auto di1 { -window }; di1 <= window; ++di1) {
-              if constexpr (M::CoordType == Coord::Cart) {
-                buff_access(i1(p) + di1 + N_GHOSTS,
-                            i2(p) + di2 + N_GHOSTS,
-                            i3(p) + di3 + N_GHOSTS,
-                            buff_idx) += coeff;
-              } else {
-                // reflect contribution at axes
-                if (is_axis_i2min && (i2(p) + di2 < 0)) {
-                  buff_access(i1(p) + di1 + N_GHOSTS,
-                              N_GHOSTS - (i2(p) + di2),
-                              i3(p) + di3 + N_GHOSTS,
-                              buff_idx) += coeff;
-                } else if (is_axis_i2max && (i2(p) + di2 >= ni2)) {
-                  buff_access(i1(p) + di1 + N_GHOSTS,
-                              2 * ni2 - (i2(p) + di2) + N_GHOSTS,
-                              i3(p) + di3 + N_GHOSTS,
-                              buff_idx) += coeff;
-                } else {
-                  buff_access(i1(p) + di1 + N_GHOSTS,
-                              i2(p) + di2 + N_GHOSTS,
-                              i3(p) + di3 + N_GHOSTS,
-                              buff_idx) += coeff;
+          for (auto s3 { 0 }; s3 < O; ++s3) {
+            const auto j3 = k_min[2] + s3 + di3 + N_GHOSTS;
+            for (auto di2 { -window }; di2 <= window; ++di2) {
+              for (auto s2 { 0 }; s2 < O; ++s2) {
+                const auto j2 = cellIndex_i2(k_min[1] + s2 + di2);
+                for (auto di1 { -window }; di1 <= window; ++di1) {
+                  for (auto s1 { 0 }; s1 < O; ++s1) {
+                    const auto j1 = k_min[0] + s1 + di1 + N_GHOSTS;
+                    const auto w  = W[0][s1] * W[1][s2] * W[2][s3];
+                    for (auto m { 0u }; m < nmoments; ++m) {
+                      const auto idx = moments[m].buff_idx;
+                      buff_access(j1, j2, j3, idx) += coeffs[m] * w;
+                    }
+                  }
                 }
               }
             }
@@ -373,6 +565,22 @@ namespace kernel {
         }
       }
     }
+
+  private:
+    /**
+     * @brief Ghost-included index of the cell `k2` along x2
+     * @note Contributions beyond the axes are reflected back
+     */
+    Inline auto cellIndex_i2(int k2) const -> int {
+      if constexpr (M::CoordType != Coord::Cart) {
+        if (is_axis_i2min && (k2 < 0)) {
+          return static_cast<int>(N_GHOSTS) - k2;
+        } else if (is_axis_i2max && (k2 >= ni2)) {
+          return 2 * ni2 - k2 + static_cast<int>(N_GHOSTS);
+        }
+      }
+      return k2 + static_cast<int>(N_GHOSTS);
+    }
   };
 
   template <Dimension D, unsigned short N>
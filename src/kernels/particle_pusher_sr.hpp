@@ -3,10 +3,13 @@
  * @brief Particle pusher for the SR
  * @implements
  *   - kernel::sr::Pusher_kernel<>
+ *   - kernel::sr::PusherDeposit_kernel<>
+ *   - kernel::sr::PusherChunked_kernel<>
  * @namespaces:
  *   - kernel::sr::
  * @macros:
  *   - MPI_ENABLED
+ *   - _OPENMP
  * @note
  * At the end of the boundary condition call, if MPI is enabled particles
  * are additionally tagged depending on which direction they are leaving
@@ -22,6 +25,9 @@
 #include "utils/error.h"
 #include "utils/numeric.h"
 
+#include "kernels/currents_deposit.hpp"
+#include "kernels/particle_shapes.hpp"
+
 #if defined(MPI_ENABLED)
   #include "arch/mpi_tags.h"
 #endif
@@ -42,6 +48,13 @@
 
 #define i_di_to_Xi(I, DI) static_cast<real_t>((I)) + static_cast<real_t>((DI))
 
+// loops over the lanes of a particle chunk are safe to vectorize
+#if defined(_OPENMP)
+  #define VECTORIZE_LANES _Pragma("omp simd")
+#else
+  #define VECTORIZE_LANES
+#endif
+
 /* -------------------------------------------------------------------------- */
 
 namespace kernel::sr {
@@ -52,11 +65,18 @@ namespace kernel::sr {
       None        = 0,
       Synchrotron = 1 << 0,
       Compton     = 1 << 1,
+      All         = Synchrotron | Compton,
     };
   } // namespace Cooling
 
   typedef int CoolingTags;
 
+  /**
+   * @brief Number of particles pushed together by `PusherChunked_kernel`
+   * @note One 512-bit vector register of `real_t`
+   */
+  inline constexpr unsigned short ChunkWidth = 64 / sizeof(real_t);
+
   struct NoForce_t {
     NoForce_t() {}
   };
@@ -187,18 +207,41 @@ namespace kernel::sr {
   /**
    * @tparam M Metric
    * @tparam F Additional force
+   * @tparam P Pusher algorithm (`INVALID`: picked at runtime from `pusher`)
+   * @tparam G Compile the GCA path (used only when `GCA` is also set)
+   * @tparam CL Cooling mechanisms compiled in (applied only if set in `cooling`)
+   * @tparam O Order of the particle shape used to interpolate the fields
+   * @note The defaults compile all the paths and branch at runtime; the engine
+   * launches specializations which contain only the path used by the species
    */
-  template <class M, class F = NoForce_t>
+  template <class M,
+            class F            = NoForce_t,
+            PrtlPusher::type P = PrtlPusher::INVALID,
+            bool             G = true,
+            CoolingTags      CL = Cooling::All,
+            unsigned short   O  = SHAPE_ORDER>
   struct Pusher_kernel {
     static_assert(M::is_metric, "M must be a metric class");
     static constexpr auto D        = M::Dim;
     static constexpr auto ExtForce = not std::is_same<F, NoForce_t>::value;
+    static_assert((P == PrtlPusher::INVALID) or (P == PrtlPusher::BORIS) or
+                    (P == PrtlPusher::VAY) or (P == PrtlPusher::PHOTON),
+                  "Invalid pusher specialization");
+    static_assert((O >= 1) and (O <= 3), "Invalid shape order");
+    // the massive pushes in Cartesian coordinates without forces & cooling
+    // have a lane-wise path over particle chunks (see `pushChunk`)
+    static constexpr bool Vectorized = (M::CoordType == Coord::Cart) and
+                                       ((P == PrtlPusher::BORIS) or
+                                        (P == PrtlPusher::VAY)) and
+                                       (not ExtForce) and (CL == Cooling::None);
 
   private:
     const PrtlPusher::type pusher;
     const bool             GCA;
     const bool             ext_force;
     const CoolingTags      cooling;
+    // `EB` holds the node-centered fields (see `kernel::ColocateFields_kernel`)
+    const bool             colocated;
 
     const randacc_ndfield_t<D, 6> EB;
     const spidx_t                 sp;
@@ -214,6 +257,8 @@ namespace kernel::sr {
 
     const real_t time, coeff, dt;
     const int    ni1, ni2, ni3;
+    // `*_prev` arrays are allocated (not the case for the lean layout)
+    const bool   store_prev;
     bool         is_absorb_i1min { false }, is_absorb_i1max { false };
     bool         is_absorb_i2min { false }, is_absorb_i2max { false };
     bool         is_absorb_i3min { false }, is_absorb_i3max { false };
@@ -265,11 +310,13 @@ namespace kernel::sr {
                   real_t                         gca_larmor_max,
                   real_t                         gca_eovrb_max,
                   real_t                         coeff_sync,
-                  real_t                         coeff_comp)
+                  real_t                         coeff_comp,
+                  bool                           colocated = false)
       : pusher { pusher }
       , GCA { GCA }
       , ext_force { ext_force }
       , cooling { cooling }
+      , colocated { colocated }
       , EB { EB }
       , sp { sp }
       , i1 { i1 }
@@ -297,10 +344,20 @@ namespace kernel::sr {
       , ni1 { ni1 }
       , ni2 { ni2 }
       , ni3 { ni3 }
+      , store_prev { i1_prev.extent(0) > 0 }
       , gca_larmor { gca_larmor_max }
       , gca_EovrB_sqr { SQR(gca_eovrb_max) }
       , coeff_sync { coeff_sync }
       , coeff_comp { coeff_comp } {
+      raise::ErrorIf((P != PrtlPusher::INVALID) and (pusher != P),
+                     "pusher does not match the kernel specialization",
+                     HERE);
+      raise::ErrorIf(GCA and not G,
+                     "GCA is not compiled into the kernel specialization",
+                     HERE);
+      raise::ErrorIf((cooling & ~CL) != 0,
+                     "cooling is not compiled into the kernel specialization",
+                     HERE);
       raise::ErrorIf(boundaries.size() < 1, "boundaries defined incorrectly", HERE);
       is_absorb_i1min = (boundaries[0].first == PrtlBC::ATMOSPHERE) ||
                         (boundaries[0].first == PrtlBC::ABSORB);
@@ -370,7 +427,8 @@ namespace kernel::sr {
                   real_t                      gca_larmor_max,
                   real_t                      gca_eovrb_max,
                   real_t                      coeff_sync,
-                  real_t                      coeff_comp)
+                  real_t                      coeff_comp,
+                  bool                        colocated = false)
       : Pusher_kernel(pusher,
                       GCA,
                       ext_force,
@@ -406,7 +464,8 @@ namespace kernel::sr {
                       gca_larmor_max,
                       gca_eovrb_max,
                       coeff_sync,
-                      coeff_comp) {}
+                      coeff_comp,
+                      colocated) {}
 
     Inline void synchrotronDrag(index_t                p,
                                 vec_t<Dim::_3D>&       u_prime,
@@ -474,18 +533,277 @@ namespace kernel::sr {
     }
 
     Inline void operator()(index_t p) const {
+      PrtlPrev_t prev;
+      if (not push(p, prev) or not store_prev) {
+        return;
+      }
+      if constexpr (D == Dim::_1D || D == Dim::_2D || D == Dim::_3D) {
+        i1_prev(p)  = prev.i1;
+        dx1_prev(p) = prev.dx1;
+      }
+      if constexpr (D == Dim::_2D || D == Dim::_3D) {
+        i2_prev(p)  = prev.i2;
+        dx2_prev(p) = prev.dx2;
+      }
+      if constexpr (D == Dim::_3D) {
+        i3_prev(p)  = prev.i3;
+        dx3_prev(p) = prev.dx3;
+      }
+    }
+
+    /**
+     * @brief push the particles `p_start ... p_end - 1` (at most `ChunkWidth`)
+     * @note Each stage (field gather, velocity & position update) runs over
+     * all the lanes of the chunk, so that it can be vectorized; dead particles
+     * & the tail of the last chunk are masked out, GCA lanes are blended in,
+     * and the boundary conditions are only applied to the lanes leaving the
+     * domain
+     * @note Specializations without the lane-wise path (see `Vectorized`)
+     * push the particles of the chunk one by one
+     */
+    Inline void pushChunk(npart_t p_start, npart_t p_end) const {
+      if constexpr (not Vectorized) {
+        for (auto p { p_start }; p < p_end; ++p) {
+          (*this)(p);
+        }
+      } else {
+        if (colocated) {
+          for (auto p { p_start }; p < p_end; ++p) {
+            (*this)(p);
+          }
+          return;
+        }
+        constexpr auto W = ChunkWidth;
+        bool           active[W];
+        int            ip[3][W], ip_prev[3][W];
+        prtldx_t       dxp[3][W], dxp_prev[3][W];
+        real_t         u[3][W], e[3][W], b[3][W];
+        // load the particles into the lanes
+        for (auto l { 0u }; l < W; ++l) {
+          const auto p = p_start + l;
+          active[l]    = (p < p_end) and (tag(p) == ParticleTag::alive);
+          if ((p < p_end) and not active[l] and (tag(p) != ParticleTag::dead)) {
+            raise::KernelError(HERE, "Invalid particle tag in pusher");
+          }
+          for (auto d { 0u }; d < 3; ++d) {
+            ip[d][l]  = 0;
+            dxp[d][l] = static_cast<prtldx_t>(0);
+            u[d][l]   = ZERO;
+          }
+          if (not active[l]) {
+            continue;
+          }
+          ip[0][l]  = i1(p);
+          dxp[0][l] = dx1(p);
+          if constexpr (D == Dim::_2D || D == Dim::_3D) {
+            ip[1][l]  = i2(p);
+            dxp[1][l] = dx2(p);
+          }
+          if constexpr (D == Dim::_3D) {
+            ip[2][l]  = i3(p);
+            dxp[2][l] = dx3(p);
+          }
+          u[0][l] = ux1(p);
+          u[1][l] = ux2(p);
+          u[2][l] = ux3(p);
+        }
+        // gather the fields
+        VECTORIZE_LANES
+        for (auto l { 0u }; l < W; ++l) {
+          const int    i[3] { ip[0][l], ip[1][l], ip[2][l] };
+          const real_t dx[3] { static_cast<real_t>(dxp[0][l]),
+                               static_cast<real_t>(dxp[1][l]),
+                               static_cast<real_t>(dxp[2][l]) };
+          coord_t<M::PrtlDim> xp_Cd { ZERO };
+          for (auto d { 0u }; d < M::PrtlDim; ++d) {
+            xp_Cd[d] = i_di_to_Xi(i[d], dx[d]);
+          }
+          vec_t<Dim::_3D> ei { ZERO }, bi { ZERO };
+          vec_t<Dim::_3D> ei_Cart { ZERO }, bi_Cart { ZERO };
+          getShapedFlds(i, dx, ei, bi);
+          metric.template transform_xyz<Idx::U, Idx::XYZ>(xp_Cd, ei, ei_Cart);
+          metric.template transform_xyz<Idx::U, Idx::XYZ>(xp_Cd, bi, bi_Cart);
+          for (auto c { 0u }; c < 3; ++c) {
+            e[c][l] = ei_Cart[c];
+            b[c][l] = bi_Cart[c];
+          }
+        }
+        // lanes pushed with the guiding center approximation
+        bool is_gca[W];
+        bool any_gca { false };
+        for (auto l { 0u }; l < W; ++l) {
+          is_gca[l] = false;
+        }
+        if constexpr (G) {
+          if (GCA) {
+            VECTORIZE_LANES
+            for (auto l { 0u }; l < W; ++l) {
+              const auto E2 { NORM_SQR(e[0][l], e[1][l], e[2][l]) };
+              const auto B2 { NORM_SQR(b[0][l], b[1][l], b[2][l]) };
+              const auto U2 { NORM_SQR(u[0][l], u[1][l], u[2][l]) };
+              const auto rL { math::sqrt(ONE + U2) * dt /
+                              (TWO * math::abs(coeff) * math::sqrt(B2)) };
+              is_gca[l] = active[l] and (B2 > ZERO) and (rL < gca_larmor) and
+                          ((E2 / B2) < gca_EovrB_sqr);
+            }
+            for (auto l { 0u }; l < W; ++l) {
+              any_gca |= is_gca[l];
+            }
+          }
+        }
+        // update the velocities
+        VECTORIZE_LANES
+        for (auto l { 0u }; l < W; ++l) {
+          vec_t<Dim::_3D> u0 { u[0][l], u[1][l], u[2][l] };
+          vec_t<Dim::_3D> u_gca { u[0][l], u[1][l], u[2][l] };
+          if (any_gca) {
+            vec_t<Dim::_3D> e0 { e[0][l], e[1][l], e[2][l] };
+            vec_t<Dim::_3D> b0 { b[0][l], b[1][l], b[2][l] };
+            gcaUpd(u_gca, e0, b0);
+          }
+          vec_t<Dim::_3D> e0 { e[0][l], e[1][l], e[2][l] };
+          vec_t<Dim::_3D> b0 { b[0][l], b[1][l], b[2][l] };
+          if constexpr (P == PrtlPusher::BORIS) {
+            borisUpd(u0, e0, b0);
+          } else {
+            vayUpd(u0, e0, b0);
+          }
+          for (auto c { 0u }; c < 3; ++c) {
+            u[c][l] = is_gca[l] ? u_gca[c] : u0[c];
+          }
+        }
+        // update the positions (i+di push)
+        VECTORIZE_LANES
+        for (auto l { 0u }; l < W; ++l) {
+          coord_t<M::PrtlDim> xp { ZERO };
+          for (auto d { 0u }; d < M::PrtlDim; ++d) {
+            xp[d] = i_di_to_Xi(ip[d][l], dxp[d][l]);
+          }
+          const real_t dt_inv_energy {
+            dt / math::sqrt(ONE + SQR(u[0][l]) + SQR(u[1][l]) + SQR(u[2][l]))
+          };
+          for (auto d { 0u }; d < 3; ++d) {
+            ip_prev[d][l]  = ip[d][l];
+            dxp_prev[d][l] = dxp[d][l];
+          }
+          if constexpr (D == Dim::_1D || D == Dim::_2D || D == Dim::_3D) {
+            dxp[0][l] += metric.template transform<1, Idx::XYZ, Idx::U>(
+                           xp,
+                           u[0][l]) *
+                         dt_inv_energy;
+          }
+          if constexpr (D == Dim::_2D || D == Dim::_3D) {
+            dxp[1][l] += metric.template transform<2, Idx::XYZ, Idx::U>(
+                           xp,
+                           u[1][l]) *
+                         dt_inv_energy;
+          }
+          if constexpr (D == Dim::_3D) {
+            dxp[2][l] += metric.template transform<3, Idx::XYZ, Idx::U>(
+                           xp,
+                           u[2][l]) *
+                         dt_inv_energy;
+          }
+          for (auto d { 0u }; d < D; ++d) {
+            ip[d][l] += static_cast<int>(dxp[d][l] >= ONE) -
+                        static_cast<int>(dxp[d][l] < ZERO);
+            dxp[d][l] -= (dxp[d][l] >= ONE);
+            dxp[d][l] += (dxp[d][l] < ZERO);
+          }
+        }
+        // store the particles back & apply the boundary conditions
+        for (auto l { 0u }; l < W; ++l) {
+          if (not active[l]) {
+            continue;
+          }
+          const auto p = p_start + l;
+          ux1(p)       = u[0][l];
+          ux2(p)       = u[1][l];
+          ux3(p)       = u[2][l];
+          PrtlPrev_t prev;
+          bool       leaving { false };
+          if constexpr (D == Dim::_1D || D == Dim::_2D || D == Dim::_3D) {
+            i1(p)     = ip[0][l];
+            dx1(p)    = dxp[0][l];
+            prev.i1   = ip_prev[0][l];
+            prev.dx1  = dxp_prev[0][l];
+            leaving  |= (ip[0][l] < 0) or (ip[0][l] >= ni1);
+          }
+          if constexpr (D == Dim::_2D || D == Dim::_3D) {
+            i2(p)     = ip[1][l];
+            dx2(p)    = dxp[1][l];
+            prev.i2   = ip_prev[1][l];
+            prev.dx2  = dxp_prev[1][l];
+            leaving  |= (ip[1][l] < 0) or (ip[1][l] >= ni2);
+          }
+          if constexpr (D == Dim::_3D) {
+            i3(p)     = ip[2][l];
+            dx3(p)    = dxp[2][l];
+            prev.i3   = ip_prev[2][l];
+            prev.dx3  = dxp_prev[2][l];
+            leaving  |= (ip[2][l] < 0) or (ip[2][l] >= ni3);
+          }
+          if (leaving) {
+            coord_t<M::PrtlDim> xp { ZERO };
+            for (auto d { 0u }; d < M::PrtlDim; ++d) {
+              xp[d] = i_di_to_Xi(ip_prev[d][l], dxp_prev[d][l]);
+            }
+            boundaryConditions(p, xp, prev);
+          }
+          if (store_prev) {
+            if constexpr (D == Dim::_1D || D == Dim::_2D || D == Dim::_3D) {
+              i1_prev(p)  = prev.i1;
+              dx1_prev(p) = prev.dx1;
+            }
+            if constexpr (D == Dim::_2D || D == Dim::_3D) {
+              i2_prev(p)  = prev.i2;
+              dx2_prev(p) = prev.dx2;
+            }
+            if constexpr (D == Dim::_3D) {
+              i3_prev(p)  = prev.i3;
+              dx3_prev(p) = prev.dx3;
+            }
+          }
+        }
+      }
+    }
+
+    /**
+     * @brief push a single particle
+     * @param p index
+     * @param prev coordinates at the beginning of the timestep (filled here)
+     * @returns false if the particle is not alive (not pushed)
+     */
+    Inline auto push(index_t p, PrtlPrev_t& prev) const -> bool {
       if (tag(p) != ParticleTag::alive) {
         if (tag(p) != ParticleTag::dead) {
           raise::KernelError(HERE, "Invalid particle tag in pusher");
         }
-        return;
+        return false;
       }
       coord_t<M::PrtlDim> xp_Cd { ZERO };
       getPrtlPos(p, xp_Cd);
-      if (pusher == PrtlPusher::PHOTON) {
-        posUpd(false, p, xp_Cd);
-        return;
+      if constexpr (P == PrtlPusher::PHOTON) {
+        posUpd(false, p, xp_Cd, prev);
+        return true;
+      } else {
+        if constexpr (P == PrtlPusher::INVALID) {
+          if (pusher == PrtlPusher::PHOTON) {
+            posUpd(false, p, xp_Cd, prev);
+            return true;
+          }
+        }
+        pushMassive(p, xp_Cd, prev);
+        return true;
       }
+    }
+
+    /**
+     * @brief velocity (incl. cooling) & position update of a massive particle
+     */
+    Inline void pushMassive(index_t              p,
+                            coord_t<M::PrtlDim>& xp_Cd,
+                            PrtlPrev_t&          prev) const {
       // update cartesian velocity
       vec_t<Dim::_3D> ei { ZERO }, bi { ZERO };
       vec_t<Dim::_3D> ei_Cart { ZERO }, bi_Cart { ZERO };
@@ -497,17 +815,19 @@ namespace kernel::sr {
       getInterpFlds(p, ei, bi);
       metric.template transform_xyz<Idx::U, Idx::XYZ>(xp_Cd, ei, ei_Cart);
       metric.template transform_xyz<Idx::U, Idx::XYZ>(xp_Cd, bi, bi_Cart);
-      if (cooling != 0) {
-        // backup fields & velocities to use later in cooling
-        ei_Cart_rad[0] = ei_Cart[0];
-        ei_Cart_rad[1] = ei_Cart[1];
-        ei_Cart_rad[2] = ei_Cart[2];
-        bi_Cart_rad[0] = bi_Cart[0];
-        bi_Cart_rad[1] = bi_Cart[1];
-        bi_Cart_rad[2] = bi_Cart[2];
-        u_prime[0]     = ux1(p);
-        u_prime[1]     = ux2(p);
-        u_prime[2]     = ux3(p);
+      if constexpr (CL != Cooling::None) {
+        if (cooling != 0) {
+          // backup fields & velocities to use later in cooling
+          ei_Cart_rad[0] = ei_Cart[0];
+          ei_Cart_rad[1] = ei_Cart[1];
+          ei_Cart_rad[2] = ei_Cart[2];
+          bi_Cart_rad[0] = bi_Cart[0];
+          bi_Cart_rad[1] = bi_Cart[1];
+          bi_Cart_rad[2] = bi_Cart[2];
+          u_prime[0]     = ux1(p);
+          u_prime[1]     = ux2(p);
+          u_prime[2]     = ux3(p);
+        }
       }
       if constexpr (ExtForce) {
         coord_t<M::PrtlDim> xp_Ph { ZERO };
@@ -525,37 +845,26 @@ namespace kernel::sr {
             force.fx3(sp, time, ext_force, xp_Ph) },
           force_Cart);
       }
-      if (GCA) {
-        /* hybrid GCA/conventional mode --------------------------------- */
-        const auto E2 { NORM_SQR(ei_Cart[0], ei_Cart[1], ei_Cart[2]) };
-        const auto B2 { NORM_SQR(bi_Cart[0], bi_Cart[1], bi_Cart[2]) };
-        const auto rL { math::sqrt(ONE + NORM_SQR(ux1(p), ux2(p), ux3(p))) *
-                        dt / (TWO * math::abs(coeff) * math::sqrt(B2)) };
-        if (B2 > ZERO && rL < gca_larmor && (E2 / B2) < gca_EovrB_sqr) {
-          is_gca = true;
-          // update with GCA
-          if constexpr (ExtForce) {
-            velUpd(true, p, force_Cart, ei_Cart, bi_Cart);
-          } else {
-            velUpd(true, p, ei_Cart, bi_Cart);
-          }
-        } else {
-          // update with conventional pusher
-          if constexpr (ExtForce) {
-            ux1(p) += HALF * dt * force_Cart[0];
-            ux2(p) += HALF * dt * force_Cart[1];
-            ux3(p) += HALF * dt * force_Cart[2];
-          }
-          velUpd(false, p, ei_Cart, bi_Cart);
-          if constexpr (ExtForce) {
-            ux1(p) += HALF * dt * force_Cart[0];
-            ux2(p) += HALF * dt * force_Cart[1];
-            ux3(p) += HALF * dt * force_Cart[2];
+      if constexpr (G) {
+        if (GCA) {
+          /* hybrid GCA/conventional mode ------------------------------- */
+          const auto E2 { NORM_SQR(ei_Cart[0], ei_Cart[1], ei_Cart[2]) };
+          const auto B2 { NORM_SQR(bi_Cart[0], bi_Cart[1], bi_Cart[2]) };
+          const auto rL { math::sqrt(ONE + NORM_SQR(ux1(p), ux2(p), ux3(p))) *
+                          dt / (TWO * math::abs(coeff) * math::sqrt(B2)) };
+          if (B2 > ZERO && rL < gca_larmor && (E2 / B2) < gca_EovrB_sqr) {
+            is_gca = true;
+            // update with GCA
+            if constexpr (ExtForce) {
+              velUpd(true, p, force_Cart, ei_Cart, bi_Cart);
+            } else {
+              velUpd(true, p, ei_Cart, bi_Cart);
+            }
           }
         }
-      } else {
+      }
+      if (not is_gca) {
         /* conventional pusher mode ------------------------------------- */
-        // update with conventional pusher
         if constexpr (ExtForce) {
           ux1(p) += HALF * dt * force_Cart[0];
           ux2(p) += HALF * dt * force_Cart[1];
@@ -569,16 +878,16 @@ namespace kernel::sr {
         }
       }
       // cooling
-      if (cooling & Cooling::Synchrotron) {
-        if (!is_gca) {
+      if constexpr ((CL & Cooling::Synchrotron) != 0) {
+        if ((cooling & Cooling::Synchrotron) and not is_gca) {
           u_prime[0] = HALF * (u_prime[0] + ux1(p));
           u_prime[1] = HALF * (u_prime[1] + ux2(p));
           u_prime[2] = HALF * (u_prime[2] + ux3(p));
           synchrotronDrag(p, u_prime, ei_Cart_rad, bi_Cart_rad);
         }
       }
-      if (cooling & Cooling::Compton) {
-        if (!is_gca) {
+      if constexpr ((CL & Cooling::Compton) != 0) {
+        if ((cooling & Cooling::Compton) and not is_gca) {
           u_prime[0] = HALF * (u_prime[0] + ux1(p));
           u_prime[1] = HALF * (u_prime[1] + ux2(p));
           u_prime[2] = HALF * (u_prime[2] + ux3(p));
@@ -586,10 +895,13 @@ namespace kernel::sr {
         }
       }
       // update position
-      posUpd(true, p, xp_Cd);
+      posUpd(true, p, xp_Cd, prev);
     }
 
-    Inline void posUpd(bool massive, index_t p, coord_t<M::PrtlDim>& xp) const {
+    Inline void posUpd(bool                 massive,
+                       index_t              p,
+                       coord_t<M::PrtlDim>& xp,
+                       PrtlPrev_t&          prev) const {
       // get cartesian velocity
       if constexpr (M::CoordType == Coord::Cart) {
         // i+di push for Cartesian basis
@@ -599,8 +911,8 @@ namespace kernel::sr {
             : (dt / math::sqrt(SQR(ux1(p)) + SQR(ux2(p)) + SQR(ux3(p))))
         };
         if constexpr (D == Dim::_1D || D == Dim::_2D || D == Dim::_3D) {
-          i1_prev(p)  = i1(p);
-          dx1_prev(p) = dx1(p);
+          prev.i1  = i1(p);
+          prev.dx1 = dx1(p);
           dx1(p) += metric.template transform<1, Idx::XYZ, Idx::U>(xp, ux1(p)) *
                     dt_inv_energy;
           i1(p) += static_cast<int>(dx1(p) >= ONE) -
@@ -609,8 +921,8 @@ namespace kernel::sr {
           dx1(p) += (dx1(p) < ZERO);
         }
         if constexpr (D == Dim::_2D || D == Dim::_3D) {
-          i2_prev(p)  = i2(p);
-          dx2_prev(p) = dx2(p);
+          prev.i2  = i2(p);
+          prev.dx2 = dx2(p);
           dx2(p) += metric.template transform<2, Idx::XYZ, Idx::U>(xp, ux2(p)) *
                     dt_inv_energy;
           i2(p) += static_cast<int>(dx2(p) >= ONE) -
@@ -619,8 +931,8 @@ namespace kernel::sr {
           dx2(p) += (dx2(p) < ZERO);
         }
         if constexpr (D == Dim::_3D) {
-          i3_prev(p)  = i3(p);
-          dx3_prev(p) = dx3(p);
+          prev.i3  = i3(p);
+          prev.dx3 = dx3(p);
           dx3(p) += metric.template transform<3, Idx::XYZ, Idx::U>(xp, ux3(p)) *
                     dt_inv_energy;
           i3(p) += static_cast<int>(dx3(p) >= ONE) -
@@ -649,15 +961,15 @@ namespace kernel::sr {
 
         // update x1
         if constexpr (D == Dim::_1D || D == Dim::_2D || D == Dim::_3D) {
-          i1_prev(p)  = i1(p);
-          dx1_prev(p) = dx1(p);
+          prev.i1  = i1(p);
+          prev.dx1 = dx1(p);
           from_Xi_to_i_di(xp[0], i1(p), dx1(p));
         }
 
         // update x2 & phi
         if constexpr (D == Dim::_2D || D == Dim::_3D) {
-          i2_prev(p)  = i2(p);
-          dx2_prev(p) = dx2(p);
+          prev.i2  = i2(p);
+          prev.dx2 = dx2(p);
           from_Xi_to_i_di(xp[1], i2(p), dx2(p));
           if constexpr (D == Dim::_2D && M::PrtlDim == Dim::_3D) {
             phi(p) = xp[2];
@@ -666,12 +978,12 @@ namespace kernel::sr {
 
         // update x3
         if constexpr (D == Dim::_3D) {
-          i3_prev(p)  = i3(p);
-          dx3_prev(p) = dx3(p);
+          prev.i3  = i3(p);
+          prev.dx3 = dx3(p);
           from_Xi_to_i_di(xp[2], i3(p), dx3(p));
         }
       }
-      boundaryConditions(p, xp);
+      boundaryConditions(p, xp, prev);
     }
 
     /**
@@ -683,115 +995,164 @@ namespace kernel::sr {
                        index_t          p,
                        vec_t<Dim::_3D>& e0,
                        vec_t<Dim::_3D>& b0) const {
-      if (with_gca) {
-        const auto eb_sqr { NORM_SQR(e0[0], e0[1], e0[2]) +
-                            NORM_SQR(b0[0], b0[1], b0[2]) };
-
-        const vec_t<Dim::_3D> wE {
-          CROSS_x1(e0[0], e0[1], e0[2], b0[0], b0[1], b0[2]) / eb_sqr,
-          CROSS_x2(e0[0], e0[1], e0[2], b0[0], b0[1], b0[2]) / eb_sqr,
-          CROSS_x3(e0[0], e0[1], e0[2], b0[0], b0[1], b0[2]) / eb_sqr
-        };
-
-        {
-          const auto b_norm_inv { ONE / NORM(b0[0], b0[1], b0[2]) };
-          b0[0] *= b_norm_inv;
-          b0[1] *= b_norm_inv;
-          b0[2] *= b_norm_inv;
-        }
-        auto upar { DOT(ux1(p), ux2(p), ux3(p), b0[0], b0[1], b0[2]) +
-                    coeff * TWO * DOT(e0[0], e0[1], e0[2], b0[0], b0[1], b0[2]) };
-
-        real_t factor;
-        {
-          const auto wE_sqr { NORM_SQR(wE[0], wE[1], wE[2]) };
-          if (wE_sqr < static_cast<real_t>(0.01)) {
-            factor = ONE + wE_sqr + TWO * SQR(wE_sqr) + FIVE * SQR(wE_sqr) * wE_sqr;
-          } else {
-            factor = (ONE - math::sqrt(ONE - FOUR * wE_sqr)) / (TWO * wE_sqr);
-          }
-        }
-        const vec_t<Dim::_3D> vE_Cart { wE[0] * factor,
-                                        wE[1] * factor,
-                                        wE[2] * factor };
-        const auto            Gamma { math::sqrt(ONE + SQR(upar)) /
-                           math::sqrt(
-                             ONE - NORM_SQR(vE_Cart[0], vE_Cart[1], vE_Cart[2])) };
-        ux1(p) = upar * b0[0] + vE_Cart[0] * Gamma;
-        ux2(p) = upar * b0[1] + vE_Cart[1] * Gamma;
-        ux3(p) = upar * b0[2] + vE_Cart[2] * Gamma;
+      if (G and with_gca) {
+        vec_t<Dim::_3D> u { ux1(p), ux2(p), ux3(p) };
+        gcaUpd(u, e0, b0);
+        ux1(p) = u[0];
+        ux2(p) = u[1];
+        ux3(p) = u[2];
+      } else if constexpr (P == PrtlPusher::BORIS) {
+        borisUpd(p, e0, b0);
+      } else if constexpr (P == PrtlPusher::VAY) {
+        vayUpd(p, e0, b0);
       } else if (pusher == PrtlPusher::BORIS) {
-        real_t COEFF { coeff };
-
-        e0[0] *= COEFF;
-        e0[1] *= COEFF;
-        e0[2] *= COEFF;
-        vec_t<Dim::_3D> u0 { ux1(p) + e0[0], ux2(p) + e0[1], ux3(p) + e0[2] };
-
-        COEFF *= ONE / math::sqrt(ONE + NORM_SQR(u0[0], u0[1], u0[2]));
-        b0[0] *= COEFF;
-        b0[1] *= COEFF;
-        b0[2] *= COEFF;
-        COEFF  = TWO / (ONE + NORM_SQR(b0[0], b0[1], b0[2]));
-
-        vec_t<Dim::_3D> u1 {
-          (u0[0] + CROSS_x1(u0[0], u0[1], u0[2], b0[0], b0[1], b0[2])) * COEFF,
-          (u0[1] + CROSS_x2(u0[0], u0[1], u0[2], b0[0], b0[1], b0[2])) * COEFF,
-          (u0[2] + CROSS_x3(u0[0], u0[1], u0[2], b0[0], b0[1], b0[2])) * COEFF
-        };
+        borisUpd(p, e0, b0);
+      } else if (pusher == PrtlPusher::VAY) {
+        vayUpd(p, e0, b0);
+      }
+    }
 
-        u0[0] += CROSS_x1(u1[0], u1[1], u1[2], b0[0], b0[1], b0[2]) + e0[0];
-        u0[1] += CROSS_x2(u1[0], u1[1], u1[2], b0[0], b0[1], b0[2]) + e0[1];
-        u0[2] += CROSS_x3(u1[0], u1[1], u1[2], b0[0], b0[1], b0[2]) + e0[2];
+    Inline void borisUpd(index_t          p,
+                         vec_t<Dim::_3D>& e0,
+                         vec_t<Dim::_3D>& b0) const {
+      vec_t<Dim::_3D> u { ux1(p), ux2(p), ux3(p) };
+      borisUpd(u, e0, b0);
+      ux1(p) = u[0];
+      ux2(p) = u[1];
+      ux3(p) = u[2];
+    }
 
-        ux1(p) = u0[0];
-        ux2(p) = u0[1];
-        ux3(p) = u0[2];
-      } else if (pusher == PrtlPusher::VAY) {
-        auto COEFF { coeff };
-        e0[0] *= COEFF;
-        e0[1] *= COEFF;
-        e0[2] *= COEFF;
-
-        b0[0] *= COEFF;
-        b0[1] *= COEFF;
-        b0[2] *= COEFF;
-
-        COEFF = ONE / math::sqrt(ONE + NORM_SQR(ux1(p), ux2(p), ux3(p)));
-
-        vec_t<Dim::_3D> u1 {
-          (ux1(p) + TWO * e0[0] +
-           CROSS_x1(ux1(p), ux2(p), ux3(p), b0[0], b0[1], b0[2]) * COEFF),
-          (ux2(p) + TWO * e0[1] +
-           CROSS_x2(ux1(p), ux2(p), ux3(p), b0[0], b0[1], b0[2]) * COEFF),
-          (ux3(p) + TWO * e0[2] +
-           CROSS_x3(ux1(p), ux2(p), ux3(p), b0[0], b0[1], b0[2]) * COEFF)
-        };
-        COEFF = DOT(u1[0], u1[1], u1[2], b0[0], b0[1], b0[2]);
-        auto COEFF2 { ONE + NORM_SQR(u1[0], u1[1], u1[2]) -
-                      NORM_SQR(b0[0], b0[1], b0[2]) };
-
-        COEFF = ONE / math::sqrt(
-                        INV_2 *
-                        (COEFF2 + math::sqrt(SQR(COEFF2) +
-                                             FOUR * (SQR(b0[0]) + SQR(b0[1]) +
-                                                     SQR(b0[2]) + SQR(COEFF)))));
-        COEFF2 = ONE / (ONE + SQR(b0[0] * COEFF) + SQR(b0[1] * COEFF) +
-                        SQR(b0[2] * COEFF));
-
-        ux1(p) = COEFF2 * (u1[0] +
-                           COEFF * DOT(u1[0], u1[1], u1[2], b0[0], b0[1], b0[2]) *
-                             (b0[0] * COEFF) +
-                           u1[1] * b0[2] * COEFF - u1[2] * b0[1] * COEFF);
-        ux2(p) = COEFF2 * (u1[1] +
-                           COEFF * DOT(u1[0], u1[1], u1[2], b0[0], b0[1], b0[2]) *
-                             (b0[1] * COEFF) +
-                           u1[2] * b0[0] * COEFF - u1[0] * b0[2] * COEFF);
-        ux3(p) = COEFF2 * (u1[2] +
-                           COEFF * DOT(u1[0], u1[1], u1[2], b0[0], b0[1], b0[2]) *
-                             (b0[2] * COEFF) +
-                           u1[0] * b0[1] * COEFF - u1[1] * b0[0] * COEFF);
+    Inline void vayUpd(index_t          p,
+                       vec_t<Dim::_3D>& e0,
+                       vec_t<Dim::_3D>& b0) const {
+      vec_t<Dim::_3D> u { ux1(p), ux2(p), ux3(p) };
+      vayUpd(u, e0, b0);
+      ux1(p) = u[0];
+      ux2(p) = u[1];
+      ux3(p) = u[2];
+    }
+
+    /**
+     * @brief guiding center update of the 4-velocity `u`
+     */
+    Inline void gcaUpd(vec_t<Dim::_3D>& u,
+                       vec_t<Dim::_3D>& e0,
+                       vec_t<Dim::_3D>& b0) const {
+      const auto eb_sqr { NORM_SQR(e0[0], e0[1], e0[2]) +
+                          NORM_SQR(b0[0], b0[1], b0[2]) };
+
+      const vec_t<Dim::_3D> wE {
+        CROSS_x1(e0[0], e0[1], e0[2], b0[0], b0[1], b0[2]) / eb_sqr,
+        CROSS_x2(e0[0], e0[1], e0[2], b0[0], b0[1], b0[2]) / eb_sqr,
+        CROSS_x3(e0[0], e0[1], e0[2], b0[0], b0[1], b0[2]) / eb_sqr
+      };
+
+      {
+        const auto b_norm_inv { ONE / NORM(b0[0], b0[1], b0[2]) };
+        b0[0] *= b_norm_inv;
+        b0[1] *= b_norm_inv;
+        b0[2] *= b_norm_inv;
+      }
+      auto upar { DOT(u[0], u[1], u[2], b0[0], b0[1], b0[2]) +
+                  coeff * TWO * DOT(e0[0], e0[1], e0[2], b0[0], b0[1], b0[2]) };
+
+      real_t factor;
+      {
+        const auto wE_sqr { NORM_SQR(wE[0], wE[1], wE[2]) };
+        if (wE_sqr < static_cast<real_t>(0.01)) {
+          factor = ONE + wE_sqr + TWO * SQR(wE_sqr) + FIVE * SQR(wE_sqr) * wE_sqr;
+        } else {
+          factor = (ONE - math::sqrt(ONE - FOUR * wE_sqr)) / (TWO * wE_sqr);
+        }
       }
+      const vec_t<Dim::_3D> vE_Cart { wE[0] * factor,
+                                      wE[1] * factor,
+                                      wE[2] * factor };
+      const auto            Gamma { math::sqrt(ONE + SQR(upar)) /
+                         math::sqrt(
+                           ONE - NORM_SQR(vE_Cart[0], vE_Cart[1], vE_Cart[2])) };
+      u[0] = upar * b0[0] + vE_Cart[0] * Gamma;
+      u[1] = upar * b0[1] + vE_Cart[1] * Gamma;
+      u[2] = upar * b0[2] + vE_Cart[2] * Gamma;
+    }
+
+    Inline void borisUpd(vec_t<Dim::_3D>& u,
+                         vec_t<Dim::_3D>& e0,
+                         vec_t<Dim::_3D>& b0) const {
+      real_t COEFF { coeff };
+
+      e0[0] *= COEFF;
+      e0[1] *= COEFF;
+      e0[2] *= COEFF;
+      vec_t<Dim::_3D> u0 { u[0] + e0[0], u[1] + e0[1], u[2] + e0[2] };
+
+      COEFF *= ONE / math::sqrt(ONE + NORM_SQR(u0[0], u0[1], u0[2]));
+      b0[0] *= COEFF;
+      b0[1] *= COEFF;
+      b0[2] *= COEFF;
+      COEFF  = TWO / (ONE + NORM_SQR(b0[0], b0[1], b0[2]));
+
+      vec_t<Dim::_3D> u1 {
+        (u0[0] + CROSS_x1(u0[0], u0[1], u0[2], b0[0], b0[1], b0[2])) * COEFF,
+        (u0[1] + CROSS_x2(u0[0], u0[1], u0[2], b0[0], b0[1], b0[2])) * COEFF,
+        (u0[2] + CROSS_x3(u0[0], u0[1], u0[2], b0[0], b0[1], b0[2])) * COEFF
+      };
+
+      u0[0] += CROSS_x1(u1[0], u1[1], u1[2], b0[0], b0[1], b0[2]) + e0[0];
+      u0[1] += CROSS_x2(u1[0], u1[1], u1[2], b0[0], b0[1], b0[2]) + e0[1];
+      u0[2] += CROSS_x3(u1[0], u1[1], u1[2], b0[0], b0[1], b0[2]) + e0[2];
+
+      u[0] = u0[0];
+      u[1] = u0[1];
+      u[2] = u0[2];
+    }
+
+    Inline void vayUpd(vec_t<Dim::_3D>& u,
+                       vec_t<Dim::_3D>& e0,
+                       vec_t<Dim::_3D>& b0) const {
+      auto COEFF { coeff };
+      e0[0] *= COEFF;
+      e0[1] *= COEFF;
+      e0[2] *= COEFF;
+
+      b0[0] *= COEFF;
+      b0[1] *= COEFF;
+      b0[2] *= COEFF;
+
+      COEFF = ONE / math::sqrt(ONE + NORM_SQR(u[0], u[1], u[2]));
+
+      vec_t<Dim::_3D> u1 {
+        (u[0] + TWO * e0[0] +
+         CROSS_x1(u[0], u[1], u[2], b0[0], b0[1], b0[2]) * COEFF),
+        (u[1] + TWO * e0[1] +
+         CROSS_x2(u[0], u[1], u[2], b0[0], b0[1], b0[2]) * COEFF),
+        (u[2] + TWO * e0[2] +
+         CROSS_x3(u[0], u[1], u[2], b0[0], b0[1], b0[2]) * COEFF)
+      };
+      COEFF = DOT(u1[0], u1[1], u1[2], b0[0], b0[1], b0[2]);
+      auto COEFF2 { ONE + NORM_SQR(u1[0], u1[1], u1[2]) -
+                    NORM_SQR(b0[0], b0[1], b0[2]) };
+
+      COEFF = ONE / math::sqrt(
+                      INV_2 *
+                      (COEFF2 + math::sqrt(SQR(COEFF2) +
+                                           FOUR * (SQR(b0[0]) + SQR(b0[1]) +
+                                                   SQR(b0[2]) + SQR(COEFF)))));
+      COEFF2 = ONE / (ONE + SQR(b0[0] * COEFF) + SQR(b0[1] * COEFF) +
+                      SQR(b0[2] * COEFF));
+
+      u[0] = COEFF2 * (u1[0] +
+                       COEFF * DOT(u1[0], u1[1], u1[2], b0[0], b0[1], b0[2]) *
+                         (b0[0] * COEFF) +
+                       u1[1] * b0[2] * COEFF - u1[2] * b0[1] * COEFF);
+      u[1] = COEFF2 * (u1[1] +
+                       COEFF * DOT(u1[0], u1[1], u1[2], b0[0], b0[1], b0[2]) *
+                         (b0[1] * COEFF) +
+                       u1[2] * b0[0] * COEFF - u1[0] * b0[2] * COEFF);
+      u[2] = COEFF2 * (u1[2] +
+                       COEFF * DOT(u1[0], u1[1], u1[2], b0[0], b0[1], b0[2]) *
+                         (b0[2] * COEFF) +
+                       u1[0] * b0[1] * COEFF - u1[1] * b0[0] * COEFF);
     }
 
     Inline void velUpd(bool,
@@ -856,6 +1217,16 @@ namespace kernel::sr {
     Inline void getInterpFlds(index_t          p,
                               vec_t<Dim::_3D>& e0,
                               vec_t<Dim::_3D>& b0) const {
+      if constexpr (O > 1) {
+        // the node-centered copy is first order only (rejected in the input),
+        // so the gather always matches the shape of the deposit
+        getShapedFlds(p, e0, b0);
+        return;
+      }
+      if (colocated) {
+        getColocatedFlds(p, e0, b0);
+        return;
+      }
       if constexpr (D == Dim::_1D) {
         const int  i { i1(p) + static_cast<int>(N_GHOSTS) };
         const auto dx1_ { static_cast<real_t>(dx1(p)) };
@@ -1117,14 +1488,155 @@ namespace kernel::sr {
       }
     }
 
+    /**
+     * @brief Staggered interpolation with the higher-order particle shapes
+     * @note Each component is weighted with the shape evaluated at the cell
+     * edges (resp. centers) along the directions where it is primal (resp.
+     * dual)
+     */
+    Inline void getShapedFlds(index_t          p,
+                              vec_t<Dim::_3D>& e0,
+                              vec_t<Dim::_3D>& b0) const {
+      int    i[3] { i1(p), 0, 0 };
+      real_t dx[3] { static_cast<real_t>(dx1(p)), ZERO, ZERO };
+      if constexpr (D == Dim::_2D or D == Dim::_3D) {
+        i[1]  = i2(p);
+        dx[1] = static_cast<real_t>(dx2(p));
+      }
+      if constexpr (D == Dim::_3D) {
+        i[2]  = i3(p);
+        dx[2] = static_cast<real_t>(dx3(p));
+      }
+      getShapedFlds(i, dx, e0, b0);
+    }
+
+    /**
+     * @param i, dx cell & position of the particle within it along each axis
+     */
+    Inline void getShapedFlds(const int (&i)[3],
+                              const real_t (&dx)[3],
+                              vec_t<Dim::_3D>& e0,
+                              vec_t<Dim::_3D>& b0) const {
+      // staggering of ex1, ex2, ex3, bx1, bx2, bx3 (0: primal, 1: dual)
+      const unsigned short stag[6][3] = {
+        { 1, 0, 0 },
+        { 0, 1, 0 },
+        { 0, 0, 1 },
+        { 0, 1, 1 },
+        { 1, 0, 1 },
+        { 1, 1, 0 }
+      };
+      // [primal, dual] stencils along each direction
+      int    i_min[2][3] { { 0, 0, 0 }, { 0, 0, 0 } };
+      real_t S[2][3][O + 1];
+      for (auto d { 0u }; d < D; ++d) {
+        shape::order<O, false>(i[d], dx[d], i_min[0][d], S[0][d]);
+        shape::order<O, true>(i[d], dx[d], i_min[1][d], S[1][d]);
+      }
+      for (auto c { 0u }; c < 6; ++c) {
+        const auto s1 = stag[c][0], s2 = stag[c][1], s3 = stag[c][2];
+        const int  j1 = i_min[s1][0] + static_cast<int>(N_GHOSTS);
+        real_t     fld { ZERO };
+        if constexpr (D == Dim::_1D) {
+          for (auto a1 { 0 }; a1 <= O; ++a1) {
+            fld += S[s1][0][a1] * EB(j1 + a1, c);
+          }
+        } else if constexpr (D == Dim::_2D) {
+          const int j2 = i_min[s2][1] + static_cast<int>(N_GHOSTS);
+          for (auto a2 { 0 }; a2 <= O; ++a2) {
+            real_t fld1 { ZERO };
+            for (auto a1 { 0 }; a1 <= O; ++a1) {
+              fld1 += S[s1][0][a1] * EB(j1 + a1, j2 + a2, c);
+            }
+            fld += S[s2][1][a2] * fld1;
+          }
+        } else if constexpr (D == Dim::_3D) {
+          const int j2 = i_min[s2][1] + static_cast<int>(N_GHOSTS);
+          const int j3 = i_min[s3][2] + static_cast<int>(N_GHOSTS);
+          for (auto a3 { 0 }; a3 <= O; ++a3) {
+            real_t fld2 { ZERO };
+            for (auto a2 { 0 }; a2 <= O; ++a2) {
+              real_t fld1 { ZERO };
+              for (auto a1 { 0 }; a1 <= O; ++a1) {
+                fld1 += S[s1][0][a1] * EB(j1 + a1, j2 + a2, j3 + a3, c);
+              }
+              fld2 += S[s2][1][a2] * fld1;
+            }
+            fld += S[s3][2][a3] * fld2;
+          }
+        }
+        if (c < 3) {
+          e0[c] = fld;
+        } else {
+          b0[c - 3] = fld;
+        }
+      }
+    }
+
+    /**
+     * @brief Gather of all the components from the surrounding nodes
+     * @note Used when `EB` is node-centered: the weights are the same for all
+     * the components, and the 6 values are read together from each node
+     */
+    Inline void getColocatedFlds(index_t          p,
+                                 vec_t<Dim::_3D>& e0,
+                                 vec_t<Dim::_3D>& b0) const {
+      for (auto c { 0u }; c < 3; ++c) {
+        e0[c] = ZERO;
+        b0[c] = ZERO;
+      }
+      int    i_min[3] { 0, 0, 0 };
+      real_t w1[O + 1], w2[O + 1], w3[O + 1];
+      shape::order<O>(i1(p), dx1(p), i_min[0], w1);
+      const int i { i_min[0] + static_cast<int>(N_GHOSTS) };
+      if constexpr (D == Dim::_1D) {
+        for (auto s1 { 0 }; s1 <= O; ++s1) {
+          for (auto c { 0u }; c < 3; ++c) {
+            e0[c] += w1[s1] * EB(i + s1, em::ex1 + c);
+            b0[c] += w1[s1] * EB(i + s1, em::bx1 + c);
+          }
+        }
+      } else if constexpr (D == Dim::_2D) {
+        shape::order<O>(i2(p), dx2(p), i_min[1], w2);
+        const int j { i_min[1] + static_cast<int>(N_GHOSTS) };
+        for (auto s2 { 0 }; s2 <= O; ++s2) {
+          for (auto s1 { 0 }; s1 <= O; ++s1) {
+            const auto w = w1[s1] * w2[s2];
+            for (auto c { 0u }; c < 3; ++c) {
+              e0[c] += w * EB(i + s1, j + s2, em::ex1 + c);
+              b0[c] += w * EB(i + s1, j + s2, em::bx1 + c);
+            }
+          }
+        }
+      } else if constexpr (D == Dim::_3D) {
+        shape::order<O>(i2(p), dx2(p), i_min[1], w2);
+        shape::order<O>(i3(p), dx3(p), i_min[2], w3);
+        const int j { i_min[1] + static_cast<int>(N_GHOSTS) };
+        const int k { i_min[2] + static_cast<int>(N_GHOSTS) };
+        for (auto s3 { 0 }; s3 <= O; ++s3) {
+          for (auto s2 { 0 }; s2 <= O; ++s2) {
+            for (auto s1 { 0 }; s1 <= O; ++s1) {
+              const auto w = w1[s1] * w2[s2] * w3[s3];
+              for (auto c { 0u }; c < 3; ++c) {
+                e0[c] += w * EB(i + s1, j + s2, k + s3, em::ex1 + c);
+                b0[c] += w * EB(i + s1, j + s2, k + s3, em::bx1 + c);
+              }
+            }
+          }
+        }
+      }
+    }
+
     // Extra
-    Inline void boundaryConditions(index_t p, coord_t<M::PrtlDim>& xp) const {
+    Inline void boundaryConditions(index_t              p,
+                                   coord_t<M::PrtlDim>& xp,
+                                   PrtlPrev_t&          prev) const {
       if constexpr (D == Dim::_1D || D == Dim::_2D || D == Dim::_3D) {
         auto invert_vel = false;
         if (i1(p) < 0) {
           if (is_periodic_i1min) {
-            i1(p)      += ni1;
-            i1_prev(p) += ni1;
+            i1(p)  += ni1;
+            prev.i1 += ni1;
           } else if (is_absorb_i1min) {
             tag(p) = ParticleTag::dead;
           } else if (is_reflect_i1min) {
@@ -1134,8 +1646,8 @@ namespace kernel::sr {
           }
         } else if (i1(p) >= ni1) {
           if (is_periodic_i1max) {
-            i1(p)      -= ni1;
-            i1_prev(p) -= ni1;
+            i1(p)  -= ni1;
+            prev.i1 -= ni1;
           } else if (is_absorb_i1max) {
             tag(p) = ParticleTag::dead;
           } else if (is_reflect_i1max) {
@@ -1165,8 +1677,8 @@ namespace kernel::sr {
         auto invert_vel = false;
         if (i2(p) < 0) {
           if (is_periodic_i2min) {
-            i2(p)      += ni2;
-            i2_prev(p) += ni2;
+            i2(p)  += ni2;
+            prev.i2 += ni2;
           } else if (is_absorb_i2min) {
             tag(p) = ParticleTag::dead;
           } else if (is_reflect_i2min) {
@@ -1179,8 +1691,8 @@ namespace kernel::sr {
           }
         } else if (i2(p) >= ni2) {
           if (is_periodic_i2max) {
-            i2(p)      -= ni2;
-            i2_prev(p) -= ni2;
+            i2(p)  -= ni2;
+            prev.i2 -= ni2;
           } else if (is_absorb_i2max) {
             tag(p) = ParticleTag::dead;
           } else if (is_reflect_i2max) {
@@ -1213,8 +1725,8 @@ namespace kernel::sr {
         auto invert_vel = false;
         if (i3(p) < 0) {
           if (is_periodic_i3min) {
-            i3(p)      += ni3;
-            i3_prev(p) += ni3;
+            i3(p)  += ni3;
+            prev.i3 += ni3;
           } else if (is_absorb_i3min) {
             tag(p) = ParticleTag::dead;
           } else if (is_reflect_i3min) {
@@ -1224,8 +1736,8 @@ namespace kernel::sr {
           }
         } else if (i3(p) >= ni3) {
           if (is_periodic_i3max) {
-            i3(p)      -= ni3;
-            i3_prev(p) -= ni3;
+            i3(p)  -= ni3;
+            prev.i3 -= ni3;
           } else if (is_absorb_i3max) {
             tag(p) = ParticleTag::dead;
           } else if (is_reflect_i3max) {
@@ -1269,8 +1781,59 @@ namespace kernel::sr {
     }
   };
 
+  /**
+   * @brief Pusher fused with the current deposition in a single particle loop
+   * @tparam P Pusher kernel
+   * @tparam J Current deposition kernel
+   * @note Particle data updated by the pusher is reused by the deposit while
+   * still in registers/cache, instead of being re-read in a separate sweep
+   * @note The coordinates at the beginning of the step are passed in registers,
+   * so the `*_prev` arrays are neither read nor written (and may be unallocated)
+   */
+  template <class P, class J>
+  struct PusherDeposit_kernel {
+    const P pusher;
+    const J deposit;
+
+    PusherDeposit_kernel(const P& pusher, const J& deposit)
+      : pusher { pusher }
+      , deposit { deposit } {}
+
+    Inline void operator()(index_t p) const {
+      PrtlPrev_t prev;
+      if (pusher.push(p, prev)) {
+        deposit(p, prev);
+      }
+    }
+  };
+
+  /**
+   * @brief Pusher over chunks of `ChunkWidth` consecutive particles
+   * @tparam P Pusher kernel
+   * @note Meant for the host execution spaces, where the lanes of a chunk
+   * are processed with vector instructions (see `Pusher_kernel::pushChunk`)
+   */
+  template <class P>
+  struct PusherChunked_kernel {
+    const P       pusher;
+    const npart_t npart;
+
+    PusherChunked_kernel(const P& pusher, npart_t npart)
+      : pusher { pusher }
+      , npart { npart } {}
+
+    Inline void operator()(index_t c) const {
+      const npart_t p_start = c * ChunkWidth;
+      const npart_t p_end   = (p_start + ChunkWidth < npart)
+                                ? (p_start + ChunkWidth)
+                                : npart;
+      pusher.pushChunk(p_start, p_end);
+    }
+  };
+
 } // namespace kernel::sr
 
+#undef VECTORIZE_LANES
 #undef from_Xi_to_i_di
 #undef from_Xi_to_i
 #undef i_di_to_Xi
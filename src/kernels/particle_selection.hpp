@@ -0,0 +1,180 @@
+/**
+ * @file kernels/particle_selection.hpp
+ * @brief Selection of the particles to be written to the output
+ * @implements
+ *   - kernel::PrtlSelection
+ *   - kernel::SelectPrtls_kernel<>
+ * @namespaces:
+ *   - kernel::
+ * @note
+ * The indices of the selected particles are compacted with a single scan,
+ * so that all the quantities can then be gathered from the same indices
+ */
+
+#ifndef KERNELS_PARTICLE_SELECTION_HPP
+#define KERNELS_PARTICLE_SELECTION_HPP
+
+#include "enums.h"
+#include "global.h"
+
+#include "arch/kokkos_aliases.h"
+#include "utils/error.h"
+#include "utils/numeric.h"
+
+namespace kernel {
+  using namespace ntt;
+
+  /**
+   * @brief Criteria for the particles to be written
+   * @note A particle is selected if it passes all the enabled criteria
+   */
+  struct PrtlSelection {
+    // every `stride`-th particle (by the species counter for tracked species)
+    npart_t stride { 1 };
+    // box in physical coordinates (disabled along the dimensions with min >= max)
+    real_t  x_min[3] { ZERO, ZERO, ZERO };
+    real_t  x_max[3] { ZERO, ZERO, ZERO };
+    // energy (gamma - 1 for massive, |u| for massless) range (disabled if < 0)
+    real_t  e_min { -ONE };
+    real_t  e_max { -ONE };
+    // range of the species counter [min, max) (disabled if min >= max)
+    // @note: only applies to the tracked species
+    npart_t ctr_min { 0 };
+    npart_t ctr_max { 0 };
+  };
+
+  /**
+   * @brief Compacts the indices of the selected particles
+   * @note To be used with `Kokkos::parallel_scan`, the total is the number of
+   * selected particles; `out_indices` should fit all the active particles
+   */
+  template <SimEngine::type S, class M>
+  class SelectPrtls_kernel {
+    static_assert(M::is_metric, "M must be a metric class");
+    static constexpr Dimension D = M::Dim;
+
+    const PrtlSelection      sel;
+    array_t<npart_t*>        out_indices;
+    const array_t<int*>      i1, i2, i3;
+    const array_t<prtldx_t*> dx1, dx2, dx3;
+    const array_t<real_t*>   ux1, ux2, ux3;
+    const array_t<short*>    tag;
+    const array_t<npart_t**> pld_i;
+    const float              mass;
+    const bool               use_tracking;
+    const M                  metric;
+
+    bool use_box { false }, use_energy { false }, use_counter { false };
+
+  public:
+    using value_type = npart_t;
+
+    SelectPrtls_kernel(const PrtlSelection&      sel,
+                       const array_t<npart_t*>&  out_indices,
+                       const array_t<int*>&      i1,
+                       const array_t<int*>&      i2,
+                       const array_t<int*>&      i3,
+                       const array_t<prtldx_t*>& dx1,
+                       const array_t<prtldx_t*>& dx2,
+                       const array_t<prtldx_t*>& dx3,
+                       const array_t<real_t*>&   ux1,
+                       const array_t<real_t*>&   ux2,
+                       const array_t<real_t*>&   ux3,
+                       const array_t<short*>&    tag,
+                       const array_t<npart_t**>& pld_i,
+                       float                     mass,
+                       bool                      use_tracking,
+                       const M&                  metric)
+      : sel { sel }
+      , out_indices { out_indices }
+      , i1 { i1 }
+      , i2 { i2 }
+      , i3 { i3 }
+      , dx1 { dx1 }
+      , dx2 { dx2 }
+      , dx3 { dx3 }
+      , ux1 { ux1 }
+      , ux2 { ux2 }
+      , ux3 { ux3 }
+      , tag { tag }
+      , pld_i { pld_i }
+      , mass { mass }
+      , use_tracking { use_tracking }
+      , metric { metric } {
+      raise::ErrorIf(sel.stride == 0, "Output stride has to be positive", HERE);
+      for (auto d { 0u }; d < static_cast<unsigned short>(D); ++d) {
+        use_box |= (sel.x_min[d] < sel.x_max[d]);
+      }
+      use_energy  = (sel.e_min >= ZERO) or (sel.e_max >= ZERO);
+      use_counter = use_tracking and (sel.ctr_min < sel.ctr_max);
+    }
+
+    Inline void operator()(index_t p, npart_t& idx, bool final) const {
+      if (selected(p)) {
+        if (final) {
+          out_indices(idx) = p;
+        }
+        idx += 1;
+      }
+    }
+
+    Inline auto selected(index_t p) const -> bool {
+      if (tag(p) != ParticleTag::alive) {
+        return false;
+      }
+      if (use_tracking) {
+        const auto ctr = pld_i(p, pldi::spcCtr);
+        if ((ctr % sel.stride != 0) or
+            (use_counter and ((ctr < sel.ctr_min) or (ctr >= sel.ctr_max)))) {
+          return false;
+        }
+      } else if (p % sel.stride != 0) {
+        return false;
+      }
+      if (not(use_box or use_energy)) {
+        return true;
+      }
+      coord_t<D> x_Cd { ZERO };
+      x_Cd[0] = static_cast<real_t>(i1(p)) + static_cast<real_t>(dx1(p));
+      if constexpr (D == Dim::_2D or D == Dim::_3D) {
+        x_Cd[1] = static_cast<real_t>(i2(p)) + static_cast<real_t>(dx2(p));
+      }
+      if constexpr (D == Dim::_3D) {
+        x_Cd[2] = static_cast<real_t>(i3(p)) + static_cast<real_t>(dx3(p));
+      }
+      if (use_box) {
+        coord_t<D> x_Ph { ZERO };
+        metric.template convert<Crd::Cd, Crd::Ph>(x_Cd, x_Ph);
+        for (auto d { 0u }; d < static_cast<unsigned short>(D); ++d) {
+          if ((sel.x_min[d] < sel.x_max[d]) and
+              ((x_Ph[d] < sel.x_min[d]) or (x_Ph[d] >= sel.x_max[d]))) {
+            return false;
+          }
+        }
+      }
+      if (use_energy) {
+        real_t u_sqr { ZERO };
+        if constexpr (S == SimEngine::SRPIC) {
+          u_sqr = NORM_SQR(ux1(p), ux2(p), ux3(p));
+        } else {
+          // u_i u^i with the covariant components stored
+          vec_t<Dim::_3D> u_Cntrv { ZERO };
+          metric.template transform<Idx::D, Idx::U>(x_Cd,
+                                                    { ux1(p), ux2(p), ux3(p) },
+                                                    u_Cntrv);
+          u_sqr = u_Cntrv[0] * ux1(p) + u_Cntrv[1] * ux2(p) + u_Cntrv[2] * ux3(p);
+        }
+        const auto energy = (mass == 0.0f) ? math::sqrt(u_sqr)
+                                           : math::sqrt(ONE + u_sqr) - ONE;
+        if (((sel.e_min >= ZERO) and (energy < sel.e_min)) or
+            ((sel.e_max >= ZERO) and (energy > sel.e_max))) {
+          return false;
+        }
+      }
+      return true;
+    }
+  };
+
+} // namespace kernel
+
+#endif // KERNELS_PARTICLE_SELECTION_HPP
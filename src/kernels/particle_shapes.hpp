@@ -0,0 +1,79 @@
+/**
+ * @file kernels/particle_shapes.hpp
+ * @brief B-spline shape functions of the particles
+ * @implements
+ *   - kernel::shape::order<>
+ * @namespaces:
+ *   - kernel::shape::
+ * @note
+ * Shapes are defined in units of the cell size: order 0 is the nearest grid
+ * point, 1 is the cloud-in-cell, 2 is the triangular-shaped cloud, and 3 is
+ * the piecewise-cubic spline; each of them covers `O + 1` grid points
+ */
+
+#ifndef KERNELS_PARTICLE_SHAPES_HPP
+#define KERNELS_PARTICLE_SHAPES_HPP
+
+#include "global.h"
+
+#include "arch/kokkos_aliases.h"
+#include "utils/numeric.h"
+
+namespace kernel::shape {
+  using namespace ntt;
+
+  /**
+   * @brief Weights of the grid points covered by a particle
+   * @tparam O order of the shape function [0 -> 3]
+   * @tparam Dual grid points are at the cell centers (`i + 1/2`) if true,
+   * and at the cell edges (`i`) otherwise
+   * @param i cell of the particle
+   * @param dx position of the particle within the cell [0, 1)
+   * @param i_min [out] index of the first grid point covered
+   * @param S [out] weights of the grid points `i_min ... i_min + O`
+   */
+  template <unsigned short O, bool Dual = false>
+  Inline void order(int i, real_t dx, int& i_min, real_t (&S)[O + 1]) {
+    static_assert(O <= 3, "Invalid shape order");
+    if constexpr (Dual) {
+      // distance from the cell center at `i - 1/2` or `i + 1/2`
+      if (dx < HALF) {
+        i  -= 1;
+        dx += HALF;
+      } else {
+        dx -= HALF;
+      }
+    }
+    if constexpr (O == 0) {
+      i_min = (dx < HALF) ? i : i + 1;
+      S[0]  = ONE;
+    } else if constexpr (O == 1) {
+      i_min = i;
+      S[0]  = ONE - dx;
+      S[1]  = dx;
+    } else if constexpr (O == 2) {
+      // distance from the nearest grid point
+      if (dx < HALF) {
+        i_min = i - 1;
+      } else {
+        i_min  = i;
+        dx    -= ONE;
+      }
+      S[0] = HALF * SQR(HALF - dx);
+      S[1] = static_cast<real_t>(0.75) - SQR(dx);
+      S[2] = HALF * SQR(HALF + dx);
+    } else if constexpr (O == 3) {
+      constexpr auto inv_6  = ONE / static_cast<real_t>(6);
+      const auto     dx_sqr = SQR(dx);
+      const auto     dx_cub = dx_sqr * dx;
+      i_min                 = i - 1;
+      S[0]                  = inv_6 * CUBE(ONE - dx);
+      S[1] = inv_6 * (FOUR - THREE * (TWO * dx_sqr - dx_cub));
+      S[2] = inv_6 * (ONE + THREE * (dx + dx_sqr - dx_cub));
+      S[3] = inv_6 * dx_cub;
+    }
+  }
+
+} // namespace kernel::shape
+
+#endif // KERNELS_PARTICLE_SHAPES_HPP
@@ -3,6 +3,7 @@
  * @brief Convert particle positions & velocities to physical units
  * @implements
  *   - kernel::PrtlToPhys_kernel<>
+ *   - kernel::PrtlToPhysPacked_kernel<>
  * @namespaces:
  *   - kernel::
  * @note
@@ -10,6 +11,8 @@
  * and velocities to physical units
  * @note SR : to the corresponding tetrad basis
  * @note GR : x -- coordinate basis, u -- covariant basis
+ * @note The packed version gathers all the quantities into a single row-major
+ * buffer with one row per quantity (see Particles::OutputWrite)
  */
 
 #ifndef KERNELS_PRTLS_TO_PHYS_HPP
@@ -51,6 +54,39 @@ namespace kernel {
     const array_t<npart_t**> pld_i;
     const M                  metric;
 
+    // used by the packed kernel, which has its own output buffers
+    PrtlToPhys_kernel(array_t<npart_t*>         out_indices,
+                      const array_t<int*>&      i1,
+                      const array_t<int*>&      i2,
+                      const array_t<int*>&      i3,
+                      const array_t<prtldx_t*>& dx1,
+                      const array_t<prtldx_t*>& dx2,
+                      const array_t<prtldx_t*>& dx3,
+                      const array_t<real_t*>&   ux1,
+                      const array_t<real_t*>&   ux2,
+                      const array_t<real_t*>&   ux3,
+                      const array_t<real_t*>&   phi,
+                      const array_t<real_t*>&   weight,
+                      const array_t<real_t**>&  pld_r,
+                      const array_t<npart_t**>& pld_i,
+                      const M&                  metric)
+      : stride { 1 }
+      , out_indices { out_indices }
+      , i1 { i1 }
+      , i2 { i2 }
+      , i3 { i3 }
+      , dx1 { dx1 }
+      , dx2 { dx2 }
+      , dx3 { dx3 }
+      , ux1 { ux1 }
+      , ux2 { ux2 }
+      , ux3 { ux3 }
+      , phi { phi }
+      , weight { weight }
+      , pld_r { pld_r }
+      , pld_i { pld_i }
+      , metric { metric } {}
+
   public:
     PrtlToPhys_kernel(npart_t                   stride,
                       array_t<npart_t*>         out_indices,
@@ -132,24 +168,46 @@ namespace kernel {
     }
 
     Inline void bufferX(index_t p_from, index_t p_to) const {
+      vec_t<Dim::_3D> x_Ph { ZERO };
+      toPhysX(p_from, x_Ph);
+      if constexpr ((D == Dim::_1D) || (D == Dim::_2D) || (D == Dim::_3D)) {
+        buff_x1(p_to) = x_Ph[0];
+      }
+      if constexpr ((D == Dim::_2D) || (D == Dim::_3D)) {
+        buff_x2(p_to) = x_Ph[1];
+      }
+      if constexpr (((D == Dim::_2D) && (M::CoordType != Coord::Cart)) ||
+                    (D == Dim::_3D)) {
+        buff_x3(p_to) = x_Ph[2];
+      }
+    }
+
+    Inline void bufferU(index_t p_from, index_t p_to) const {
+      vec_t<Dim::_3D> u_Phys { ZERO };
+      toPhysU(p_from, u_Phys);
+      buff_ux1(p_to) = u_Phys[0];
+      buff_ux2(p_to) = u_Phys[1];
+      buff_ux3(p_to) = u_Phys[2];
+    }
+
+    Inline void toPhysX(index_t p_from, vec_t<Dim::_3D>& x_Ph) const {
       if constexpr ((D == Dim::_1D) || (D == Dim::_2D) || (D == Dim::_3D)) {
-        buff_x1(p_to) = metric.template convert<1, Crd::Cd, Crd::Ph>(
+        x_Ph[0] = metric.template convert<1, Crd::Cd, Crd::Ph>(
           static_cast<real_t>(i1(p_from)) + static_cast<real_t>(dx1(p_from)));
       }
       if constexpr ((D == Dim::_2D) || (D == Dim::_3D)) {
-        buff_x2(p_to) = metric.template convert<2, Crd::Cd, Crd::Ph>(
+        x_Ph[1] = metric.template convert<2, Crd::Cd, Crd::Ph>(
           static_cast<real_t>(i2(p_from)) + static_cast<real_t>(dx2(p_from)));
       }
       if constexpr ((D == Dim::_2D) && (M::CoordType != Coord::Cart)) {
-        buff_x3(p_to) = phi(p_from);
+        x_Ph[2] = phi(p_from);
       } else if constexpr (D == Dim::_3D) {
-        buff_x3(p_to) = metric.template convert<3, Crd::Cd, Crd::Ph>(
+        x_Ph[2] = metric.template convert<3, Crd::Cd, Crd::Ph>(
           static_cast<real_t>(i3(p_from)) + static_cast<real_t>(dx3(p_from)));
       }
     }
 
-    Inline void bufferU(index_t p_from, index_t p_to) const {
-      vec_t<Dim::_3D> u_Phys { ZERO };
+    Inline void toPhysU(index_t p_from, vec_t<Dim::_3D>& u_Phys) const {
       if constexpr (D == Dim::_1D) {
         if constexpr (M::CoordType == Coord::Cart) {
           metric.template transform_xyz<Idx::XYZ, Idx::T>(
@@ -201,9 +259,6 @@ namespace kernel {
           raise::KernelError(HERE, "Unrecognized simulation engine");
         }
       }
-      buff_ux1(p_to) = u_Phys[0];
-      buff_ux2(p_to) = u_Phys[1];
-      buff_ux3(p_to) = u_Phys[2];
     }
 
     Inline void bufferPlds(index_t p_from, index_t p_to) const {
@@ -215,6 +270,69 @@ namespace kernel {
       }
     }
   };
+
+  /**
+   * @brief Gathers the selected particles into a single packed buffer
+   * @note Rows of `buff_r`: x (D, or 3 for 2D non-Cartesian), u (3), weight,
+   * real payloads; rows of `buff_i`: integer payloads (incl. the tracking ones)
+   */
+  template <SimEngine::type S, class M>
+  class PrtlToPhysPacked_kernel : public PrtlToPhys_kernel<S, M, true> {
+    using base_t                 = PrtlToPhys_kernel<S, M, true>;
+    static constexpr Dimension D = M::Dim;
+
+    packed_array_t<real_t**>  buff_r;
+    packed_array_t<npart_t**> buff_i;
+
+  public:
+    static constexpr unsigned short n_x =
+      static_cast<unsigned short>(D) +
+      (((D == Dim::_2D) && (M::CoordType != Coord::Cart)) ? 1 : 0);
+
+    PrtlToPhysPacked_kernel(array_t<npart_t*>          out_indices,
+                            packed_array_t<real_t**>&  buff_r,
+                            packed_array_t<npart_t**>& buff_i,
+                            const array_t<int*>&       i1,
+                            const array_t<int*>&       i2,
+                            const array_t<int*>&       i3,
+                            const array_t<prtldx_t*>&  dx1,
+                            const array_t<prtldx_t*>&  dx2,
+                            const array_t<prtldx_t*>&  dx3,
+                            const array_t<real_t*>&    ux1,
+                            const array_t<real_t*>&    ux2,
+                            const array_t<real_t*>&    ux3,
+                            const array_t<real_t*>&    phi,
+                            const array_t<real_t*>&    weight,
+                            const array_t<real_t**>&   pld_r,
+                            const array_t<npart_t**>&  pld_i,
+                            const M&                   metric)
+      : base_t { out_indices, i1,  i2,  i3,     dx1,   dx2,   dx3,   ux1,
+                 ux2,         ux3, phi, weight, pld_r, pld_i, metric }
+      , buff_r { buff_r }
+      , buff_i { buff_i } {
+      raise::ErrorIf(buff_r.extent(0) < n_x + 4, "Invalid buffer size", HERE);
+    }
+
+    Inline void operator()(index_t p) const {
+      const auto      p_from = this->out_indices(p);
+      vec_t<Dim::_3D> x_Ph { ZERO }, u_Phys { ZERO };
+      this->toPhysX(p_from, x_Ph);
+      this->toPhysU(p_from, u_Phys);
+      for (auto d { 0u }; d < n_x; ++d) {
+        buff_r(d, p) = x_Ph[d];
+      }
+      buff_r(n_x, p)     = u_Phys[0];
+      buff_r(n_x + 1, p) = u_Phys[1];
+      buff_r(n_x + 2, p) = u_Phys[2];
+      buff_r(n_x + 3, p) = this->weight(p_from);
+      for (auto pr { 0u }; pr < buff_r.extent(0) - (n_x + 4); ++pr) {
+        buff_r(n_x + 4 + pr, p) = this->pld_r(p_from, pr);
+      }
+      for (auto pi { 0u }; pi < buff_i.extent(0); ++pi) {
+        buff_i(pi, p) = this->pld_i(p_from, pi);
+      }
+    }
+  };
 } // namespace kernel
 
 #endif // KERNELS_PRTLS_TO_PHYS_HPP
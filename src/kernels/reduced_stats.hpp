@@ -3,7 +3,9 @@
  * @brief Compute reduced field/moment quantities for stats output
  * @implements
  *   - kernel::ReducedFields_kernel<>
+ *   - kernel::ReducedFieldsBatch_kernel<>
  *   - kernel::ReducedParticleMoments_kernel<>
+ *   - kernel::ReducedParticleMomentsBatch_kernel<>
  * @namespaces:
  *   - kernel::
  */
@@ -386,6 +388,157 @@ namespace kernel {
     }
   };
 
+  /**
+   * @brief A single quantity reduced by the batched stats kernels
+   * @param id stats type
+   * @param c1, c2 components (E^2, B^2, ExB: only c1 = 1, 2 or 3; T: both)
+   */
+  struct StatSpec {
+    StatsID::type  id { StatsID::INVALID };
+    unsigned short c1 { 0 }, c2 { 0 };
+  };
+
+  /**
+   * @brief Reduces several field stats in a single sweep over the cells
+   * @tparam S simulation engine
+   * @tparam M metric
+   * @note Same definitions as `ReducedFields_kernel`; the n-th entry of the
+   * (array) result accumulates the n-th requested stat
+   * @note E^2, B^2 & ExB are only available for SRPIC
+   */
+  template <SimEngine::type S, class M>
+  class ReducedFieldsBatch_kernel {
+    static_assert(M::is_metric, "M must be a metric class");
+
+  public:
+    static constexpr std::size_t MaxStats { 16 };
+
+    using value_type = real_t[];
+    const unsigned int value_count;
+
+  private:
+    // 0: J.E, 1-3: B^2, 4-6: E^2, 7-9: ExB (components 1-3)
+    Kokkos::Array<unsigned short, MaxStats> stats;
+
+    const ReducedFields_kernel<S, M, StatsID::JdotE, 0> jdote;
+    const ReducedFields_kernel<S, M, StatsID::B2, 1>    b2_1;
+    const ReducedFields_kernel<S, M, StatsID::B2, 2>    b2_2;
+    const ReducedFields_kernel<S, M, StatsID::B2, 3>    b2_3;
+    const ReducedFields_kernel<S, M, StatsID::E2, 1>    e2_1;
+    const ReducedFields_kernel<S, M, StatsID::E2, 2>    e2_2;
+    const ReducedFields_kernel<S, M, StatsID::E2, 3>    e2_3;
+    const ReducedFields_kernel<S, M, StatsID::ExB, 1>   exb_1;
+    const ReducedFields_kernel<S, M, StatsID::ExB, 2>   exb_2;
+    const ReducedFields_kernel<S, M, StatsID::ExB, 3>   exb_3;
+
+    template <typename... I>
+    Inline void reduce(value_type buff, I... i) const {
+      for (auto n { 0u }; n < value_count; ++n) {
+        if (stats[n] == 0) {
+          jdote(i..., buff[n]);
+        } else if constexpr (S == SimEngine::SRPIC) {
+          switch (stats[n]) {
+            case 1:
+              b2_1(i..., buff[n]);
+              break;
+            case 2:
+              b2_2(i..., buff[n]);
+              break;
+            case 3:
+              b2_3(i..., buff[n]);
+              break;
+            case 4:
+              e2_1(i..., buff[n]);
+              break;
+            case 5:
+              e2_2(i..., buff[n]);
+              break;
+            case 6:
+              e2_3(i..., buff[n]);
+              break;
+            case 7:
+              exb_1(i..., buff[n]);
+              break;
+            case 8:
+              exb_2(i..., buff[n]);
+              break;
+            default:
+              exb_3(i..., buff[n]);
+              break;
+          }
+        }
+      }
+    }
+
+  public:
+    ReducedFieldsBatch_kernel(const std::vector<StatSpec>& specs,
+                              const ndfield_t<M::Dim, 6>&  EM,
+                              const ndfield_t<M::Dim, 3>&  J,
+                              const M&                     metric)
+      : value_count { static_cast<unsigned int>(specs.size()) }
+      , jdote { EM, J, metric }
+      , b2_1 { EM, J, metric }
+      , b2_2 { EM, J, metric }
+      , b2_3 { EM, J, metric }
+      , e2_1 { EM, J, metric }
+      , e2_2 { EM, J, metric }
+      , e2_3 { EM, J, metric }
+      , exb_1 { EM, J, metric }
+      , exb_2 { EM, J, metric }
+      , exb_3 { EM, J, metric } {
+      raise::ErrorIf(specs.empty() or (specs.size() > MaxStats),
+                     "Invalid number of stats for ReducedFieldsBatch",
+                     HERE);
+      for (auto n { 0u }; n < specs.size(); ++n) {
+        const auto& spec = specs[n];
+        if (spec.id == StatsID::JdotE) {
+          stats[n] = 0;
+          continue;
+        }
+        raise::ErrorIf(S != SimEngine::SRPIC,
+                       "E^2, B^2 & ExB stats are only implemented for SRPIC",
+                       HERE);
+        raise::ErrorIf((spec.c1 < 1) or (spec.c1 > 3),
+                       "Invalid component for B2, E2 or ExB stats: " +
+                         std::to_string(spec.c1),
+                       HERE);
+        if (spec.id == StatsID::B2) {
+          stats[n] = spec.c1;
+        } else if (spec.id == StatsID::E2) {
+          stats[n] = 3 + spec.c1;
+        } else if (spec.id == StatsID::ExB) {
+          stats[n] = 6 + spec.c1;
+        } else {
+          raise::Error("Invalid stats ID for ReducedFieldsBatch", HERE);
+        }
+      }
+    }
+
+    Inline void init(value_type buff) const {
+      for (auto n { 0u }; n < value_count; ++n) {
+        buff[n] = ZERO;
+      }
+    }
+
+    Inline void join(value_type dst, const value_type src) const {
+      for (auto n { 0u }; n < value_count; ++n) {
+        dst[n] += src[n];
+      }
+    }
+
+    Inline void operator()(index_t i1, value_type buff) const {
+      reduce(buff, i1);
+    }
+
+    Inline void operator()(index_t i1, index_t i2, value_type buff) const {
+      reduce(buff, i1, i2);
+    }
+
+    Inline void operator()(index_t i1, index_t i2, index_t i3, value_type buff) const {
+      reduce(buff, i1, i2, i3);
+    }
+  };
+
   template <StatsID::type P>
   auto get_contrib(float mass, float charge) -> real_t {
     if constexpr (P == StatsID::Rho) {
@@ -466,97 +619,236 @@ namespace kernel {
                      HERE);
     }
 
-    Inline void operator()(index_t p, real_t& buff) const {
-      if (tag(p) != ParticleTag::alive) {
-        return;
+    /**
+     * @brief Volume element at the position of the particle
+     */
+    Inline auto volume(index_t p) const -> real_t {
+      coord_t<D> x_Code { ZERO };
+      if constexpr ((D == Dim::_1D) or (D == Dim::_2D) or (D == Dim::_3D)) {
+        x_Code[0] = static_cast<real_t>(i1(p)) + static_cast<real_t>(dx1(p));
       }
-      auto dV = ONE;
+      if constexpr ((D == Dim::_2D) or (D == Dim::_3D)) {
+        x_Code[1] = static_cast<real_t>(i2(p)) + static_cast<real_t>(dx2(p));
+      }
+      if constexpr (D == Dim::_3D) {
+        x_Code[2] = static_cast<real_t>(i3(p)) + static_cast<real_t>(dx3(p));
+      }
+      return metric.sqrt_det_h(x_Code);
+    }
 
-      if constexpr (P == StatsID::Npart) {
-        buff += ONE;
-        return;
-      } else {
-        coord_t<D> x_Code { ZERO };
-        if constexpr ((D == Dim::_1D) or (D == Dim::_2D) or (D == Dim::_3D)) {
+    /**
+     * @brief Energy & 4-velocity of the particle
+     * @note SR: tetrad (hatted) basis, GR: contravariant basis
+     */
+    Inline void energyMomentum(index_t          p,
+                               real_t&          energy,
+                               vec_t<Dim::_3D>& u_Phys) const {
+      if constexpr (S == SimEngine::SRPIC) {
+        // SR
+        // stress-energy tensor for SR is computed in the tetrad (hatted) basis
+        if constexpr (M::CoordType == Coord::Cart) {
+          u_Phys[0] = ux1(p);
+          u_Phys[1] = ux2(p);
+          u_Phys[2] = ux3(p);
+        } else {
+          static_assert(D != Dim::_1D, "non-Cartesian SRPIC 1D");
+          coord_t<M::PrtlDim> x_Code { ZERO };
           x_Code[0] = static_cast<real_t>(i1(p)) + static_cast<real_t>(dx1(p));
-        }
-        if constexpr ((D == Dim::_2D) or (D == Dim::_3D)) {
           x_Code[1] = static_cast<real_t>(i2(p)) + static_cast<real_t>(dx2(p));
+          if constexpr (D == Dim::_3D) {
+            x_Code[2] = static_cast<real_t>(i3(p)) + static_cast<real_t>(dx3(p));
+          } else {
+            x_Code[2] = phi(p);
+          }
+          metric.template transform_xyz<Idx::XYZ, Idx::T>(
+            x_Code,
+            { ux1(p), ux2(p), ux3(p) },
+            u_Phys);
+        }
+        if (mass == ZERO) {
+          energy = NORM(u_Phys[0], u_Phys[1], u_Phys[2]);
+        } else {
+          energy = mass *
+                   math::sqrt(ONE + NORM_SQR(u_Phys[0], u_Phys[1], u_Phys[2]));
         }
+      } else {
+        // GR
+        // stress-energy tensor for GR is computed in contravariant basis
+        static_assert(D != Dim::_1D, "GRPIC 1D");
+        coord_t<D> x_Code { ZERO };
+        x_Code[0] = static_cast<real_t>(i1(p)) + static_cast<real_t>(dx1(p));
+        x_Code[1] = static_cast<real_t>(i2(p)) + static_cast<real_t>(dx2(p));
         if constexpr (D == Dim::_3D) {
           x_Code[2] = static_cast<real_t>(i3(p)) + static_cast<real_t>(dx3(p));
         }
-        dV = metric.sqrt_det_h(x_Code);
+        vec_t<Dim::_3D> u_Cntrv { ZERO };
+        // compute u_i u^i for energy
+        metric.template transform<Idx::D, Idx::U>(x_Code,
+                                                  { ux1(p), ux2(p), ux3(p) },
+                                                  u_Cntrv);
+        energy = u_Cntrv[0] * ux1(p) + u_Cntrv[1] * ux2(p) + u_Cntrv[2] * ux3(p);
+        if (mass == ZERO) {
+          energy = math::sqrt(energy);
+        } else {
+          energy = mass * math::sqrt(ONE + energy);
+        }
+        metric.template transform<Idx::U, Idx::PU>(x_Code, u_Cntrv, u_Phys);
+      }
+    }
+
+    /**
+     * @brief Stress-energy tensor component of the particle (per unit volume)
+     */
+    Inline static auto tensorComponent(unsigned short         c1,
+                                       unsigned short         c2,
+                                       real_t                 energy,
+                                       const vec_t<Dim::_3D>& u_Phys) -> real_t {
+      real_t coeff = ONE;
+#pragma unroll
+      for (const auto& c : { c1, c2 }) {
+        if (c == 0) {
+          coeff *= energy;
+        } else {
+          coeff *= u_Phys[c - 1];
+        }
+      }
+      return coeff / energy;
+    }
+
+    Inline void operator()(index_t p, real_t& buff) const {
+      if (tag(p) != ParticleTag::alive) {
+        return;
+      }
+      if constexpr (P == StatsID::Npart) {
+        buff += ONE;
+        return;
+      } else {
+        const auto dV = volume(p);
         if constexpr (P == StatsID::N or P == StatsID::Rho or P == StatsID::Charge) {
           buff += dV * (use_weights ? weight(p) : contrib);
         } else {
           // for stress-energy tensor
           real_t          energy { ZERO };
           vec_t<Dim::_3D> u_Phys { ZERO };
-          if constexpr (S == SimEngine::SRPIC) {
-            // SR
-            // stress-energy tensor for SR is computed in the tetrad (hatted) basis
-            if constexpr (M::CoordType == Coord::Cart) {
-              u_Phys[0] = ux1(p);
-              u_Phys[1] = ux2(p);
-              u_Phys[2] = ux3(p);
-            } else {
-              static_assert(D != Dim::_1D, "non-Cartesian SRPIC 1D");
-              coord_t<M::PrtlDim> x_Code { ZERO };
-              x_Code[0] = static_cast<real_t>(i1(p)) + static_cast<real_t>(dx1(p));
-              x_Code[1] = static_cast<real_t>(i2(p)) + static_cast<real_t>(dx2(p));
-              if constexpr (D == Dim::_3D) {
-                x_Code[2] = static_cast<real_t>(i3(p)) +
-                            static_cast<real_t>(dx3(p));
-              } else {
-                x_Code[2] = phi(p);
-              }
-              metric.template transform_xyz<Idx::XYZ, Idx::T>(
-                x_Code,
-                { ux1(p), ux2(p), ux3(p) },
-                u_Phys);
-            }
-            if (mass == ZERO) {
-              energy = NORM(u_Phys[0], u_Phys[1], u_Phys[2]);
-            } else {
-              energy = mass * math::sqrt(
-                                ONE + NORM_SQR(u_Phys[0], u_Phys[1], u_Phys[2]));
-            }
-          } else {
-            // GR
-            // stress-energy tensor for GR is computed in contravariant basis
-            static_assert(D != Dim::_1D, "GRPIC 1D");
-            coord_t<D> x_Code { ZERO };
-            x_Code[0] = static_cast<real_t>(i1(p)) + static_cast<real_t>(dx1(p));
-            x_Code[1] = static_cast<real_t>(i2(p)) + static_cast<real_t>(dx2(p));
-            if constexpr (D == Dim::_3D) {
-              x_Code[2] = static_cast<real_t>(i3(p)) + static_cast<real_t>(dx3(p));
-            }
-            vec_t<Dim::_3D> u_Cntrv { ZERO };
-            // compute u_i u^i for energy
-            metric.template transform<Idx::D, Idx::U>(x_Code,
-                                                      { ux1(p), ux2(p), ux3(p) },
-                                                      u_Cntrv);
-            energy = u_Cntrv[0] * ux1(p) + u_Cntrv[1] * ux2(p) +
-                     u_Cntrv[2] * ux3(p);
-            if (mass == ZERO) {
-              energy = math::sqrt(energy);
-            } else {
-              energy = mass * math::sqrt(ONE + energy);
-            }
-            metric.template transform<Idx::U, Idx::PU>(x_Code, u_Cntrv, u_Phys);
-          }
+          energyMomentum(p, energy, u_Phys);
           // compute the corresponding moment
-          real_t coeff = ONE;
-#pragma unroll
-          for (const auto& c : { c1, c2 }) {
-            if (c == 0) {
-              coeff *= energy;
-            } else {
-              coeff *= u_Phys[c - 1];
-            }
-          }
-          buff += dV * coeff / energy;
+          buff += dV * tensorComponent(c1, c2, energy, u_Phys);
+        }
+      }
+    }
+  };
+
+  /**
+   * @brief Reduces several particle stats of one species in a single sweep
+   * @tparam S simulation engine
+   * @tparam M metric
+   * @note Same definitions as `ReducedParticleMoments_kernel`; the n-th entry
+   * of the (array) result accumulates the n-th requested stat
+   */
+  template <SimEngine::type S, class M>
+  class ReducedParticleMomentsBatch_kernel {
+    static_assert(M::is_metric, "M must be a metric class");
+
+  public:
+    static constexpr std::size_t MaxStats { 16 };
+
+    using value_type = real_t[];
+    const unsigned int value_count;
+
+  private:
+    // particle-dependent quantities are computed via the T-kernel helpers
+    const ReducedParticleMoments_kernel<S, M, StatsID::T> prtl;
+
+    Kokkos::Array<StatSpec, MaxStats> specs;
+    Kokkos::Array<real_t, MaxStats>   contribs;
+
+    const array_t<real_t*> weight;
+    const array_t<short*>  tag;
+    const bool             use_weights;
+    bool                   need_energy { false };
+
+  public:
+    ReducedParticleMomentsBatch_kernel(const std::vector<StatSpec>& stats,
+                                       const array_t<int*>&         i1,
+                                       const array_t<int*>&         i2,
+                                       const array_t<int*>&         i3,
+                                       const array_t<prtldx_t*>&    dx1,
+                                       const array_t<prtldx_t*>&    dx2,
+                                       const array_t<prtldx_t*>&    dx3,
+                                       const array_t<real_t*>&      ux1,
+                                       const array_t<real_t*>&      ux2,
+                                       const array_t<real_t*>&      ux3,
+                                       const array_t<real_t*>&      phi,
+                                       const array_t<real_t*>&      weight,
+                                       const array_t<short*>&       tag,
+                                       float                        mass,
+                                       float                        charge,
+                                       bool                         use_weights,
+                                       const M&                     metric)
+      : value_count { static_cast<unsigned int>(stats.size()) }
+      // clang-format off
+      , prtl { {}, i1, i2, i3, dx1, dx2, dx3, ux1, ux2, ux3,
+               phi, weight, tag, mass, charge, use_weights, metric }
+      // clang-format on
+      , weight { weight }
+      , tag { tag }
+      , use_weights { use_weights } {
+      raise::ErrorIf(stats.empty() or (stats.size() > MaxStats),
+                     "Invalid number of stats for ReducedParticleMomentsBatch",
+                     HERE);
+      for (auto n { 0u }; n < stats.size(); ++n) {
+        const auto id = stats[n].id;
+        raise::ErrorIf((id != StatsID::Rho) && (id != StatsID::Charge) &&
+                         (id != StatsID::N) && (id != StatsID::Npart) &&
+                         (id != StatsID::T),
+                       "Invalid stats ID for ReducedParticleMomentsBatch",
+                       HERE);
+        raise::ErrorIf(((id == StatsID::Rho) || (id == StatsID::Charge)) &&
+                         (mass == ZERO),
+                       "Rho & Charge for massless particles not defined",
+                       HERE);
+        specs[n]    = stats[n];
+        contribs[n] = (id == StatsID::Rho)    ? static_cast<real_t>(mass)
+                      : (id == StatsID::Charge) ? static_cast<real_t>(charge)
+                                                : ONE;
+        need_energy |= (id == StatsID::T);
+      }
+    }
+
+    Inline void init(value_type buff) const {
+      for (auto n { 0u }; n < value_count; ++n) {
+        buff[n] = ZERO;
+      }
+    }
+
+    Inline void join(value_type dst, const value_type src) const {
+      for (auto n { 0u }; n < value_count; ++n) {
+        dst[n] += src[n];
+      }
+    }
+
+    Inline void operator()(index_t p, value_type buff) const {
+      if (tag(p) != ParticleTag::alive) {
+        return;
+      }
+      const auto      dV = prtl.volume(p);
+      real_t          energy { ZERO };
+      vec_t<Dim::_3D> u_Phys { ZERO };
+      if (need_energy) {
+        prtl.energyMomentum(p, energy, u_Phys);
+      }
+      for (auto n { 0u }; n < value_count; ++n) {
+        const auto& spec = specs[n];
+        if (spec.id == StatsID::Npart) {
+          buff[n] += ONE;
+        } else if (spec.id == StatsID::T) {
+          buff[n] += dV * ReducedParticleMoments_kernel<S, M, StatsID::T>::tensorComponent(
+                            spec.c1,
+                            spec.c2,
+                            energy,
+                            u_Phys);
+        } else {
+          buff[n] += dV * (use_weights ? weight(p) : contribs[n]);
         }
       }
     }
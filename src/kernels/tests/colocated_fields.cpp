@@ -0,0 +1,147 @@
+#include "kernels/colocated_fields.hpp"
+
+#include "enums.h"
+#include "global.h"
+
+#include "arch/kokkos_aliases.h"
+
+#include <Kokkos_Core.hpp>
+
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace ntt;
+
+void errorIf(bool condition, const std::string& message) {
+  if (condition) {
+    throw std::runtime_error(message);
+  }
+}
+
+Inline auto equal(real_t a, real_t b, const char* msg, real_t acc) -> bool {
+  if (not(math::abs(a - b) < acc)) {
+    Kokkos::printf("%.12e != %.12e [%.12e] %s\n", a, b, math::abs(a - b), msg);
+    return false;
+  }
+  return true;
+}
+
+// staggering of ex1, ex2, ex3, bx1, bx2, bx3 along x1, x2, x3 (1 = dual)
+Inline auto is_dual(idx_t comp, unsigned short d) -> bool {
+  const bool dual[6][3] = {
+    { true,  false, false },
+    { false, true,  false },
+    { false, false, true  },
+    { false, true,  true  },
+    { true,  false, true  },
+    { true,  true,  false }
+  };
+  return dual[comp][d];
+}
+
+// a linear function is reproduced exactly at the nodes
+Inline auto linear(idx_t comp, real_t x1, real_t x2, real_t x3) -> real_t {
+  return static_cast<real_t>(comp + 1) + (real_t)(0.25) * x1 -
+         (real_t)(0.5) * x2 + (real_t)(0.75) * x3;
+}
+
+void testColocate2D(const std::vector<std::size_t>& res) {
+  errorIf(res.size() != 2, "res.size() != 2");
+  const auto nx1 = res[0] + 2 * N_GHOSTS, nx2 = res[1] + 2 * N_GHOSTS;
+  ndfield_t<Dim::_2D, 6> emfield { "emfield", nx1, nx2 };
+  ndfield_t<Dim::_2D, 6> emnode { "emnode", nx1, nx2 };
+
+  Kokkos::parallel_for(
+    "init 2D",
+    CreateRangePolicy<Dim::_2D>({ 0, 0 }, { nx1, nx2 }),
+    Lambda(index_t i1, index_t i2) {
+      for (idx_t c { 0 }; c < 6; ++c) {
+        emfield(i1, i2, c) = linear(c,
+                                    (real_t)i1 + (is_dual(c, 0) ? HALF : ZERO),
+                                    (real_t)i2 + (is_dual(c, 1) ? HALF : ZERO),
+                                    ZERO);
+      }
+    });
+
+  const auto range = CreateRangePolicy<Dim::_2D>({ 1, 1 }, { nx1, nx2 });
+  Kokkos::parallel_for("colocate 2D",
+                       range,
+                       kernel::ColocateFields_kernel<Dim::_2D>(emfield, emnode));
+
+  unsigned long all_wrongs = 0;
+  Kokkos::parallel_reduce(
+    "check 2D",
+    range,
+    Lambda(index_t i1, index_t i2, unsigned long& wrongs) {
+      for (idx_t c { 0 }; c < 6; ++c) {
+        wrongs += not equal(emnode(i1, i2, c),
+                            linear(c, (real_t)i1, (real_t)i2, ZERO),
+                            "colocate 2D",
+                            (real_t)(1e-4));
+      }
+    },
+    all_wrongs);
+  errorIf(all_wrongs != 0,
+          "colocate for 2D failed with " + std::to_string(all_wrongs) +
+            " errors");
+}
+
+void testColocate3D(const std::vector<std::size_t>& res) {
+  errorIf(res.size() != 3, "res.size() != 3");
+  const auto nx1 = res[0] + 2 * N_GHOSTS, nx2 = res[1] + 2 * N_GHOSTS,
+             nx3 = res[2] + 2 * N_GHOSTS;
+  ndfield_t<Dim::_3D, 6> emfield { "emfield", nx1, nx2, nx3 };
+  ndfield_t<Dim::_3D, 6> emnode { "emnode", nx1, nx2, nx3 };
+
+  Kokkos::parallel_for(
+    "init 3D",
+    CreateRangePolicy<Dim::_3D>({ 0, 0, 0 }, { nx1, nx2, nx3 }),
+    Lambda(index_t i1, index_t i2, index_t i3) {
+      for (idx_t c { 0 }; c < 6; ++c) {
+        emfield(i1, i2, i3, c) = linear(
+          c,
+          (real_t)i1 + (is_dual(c, 0) ? HALF : ZERO),
+          (real_t)i2 + (is_dual(c, 1) ? HALF : ZERO),
+          (real_t)i3 + (is_dual(c, 2) ? HALF : ZERO));
+      }
+    });
+
+  const auto range = CreateRangePolicy<Dim::_3D>({ 1, 1, 1 }, { nx1, nx2, nx3 });
+  Kokkos::parallel_for("colocate 3D",
+                       range,
+                       kernel::ColocateFields_kernel<Dim::_3D>(emfield, emnode));
+
+  unsigned long all_wrongs = 0;
+  Kokkos::parallel_reduce(
+    "check 3D",
+    range,
+    Lambda(index_t i1, index_t i2, index_t i3, unsigned long& wrongs) {
+      for (idx_t c { 0 }; c < 6; ++c) {
+        wrongs += not equal(emnode(i1, i2, i3, c),
+                            linear(c, (real_t)i1, (real_t)i2, (real_t)i3),
+                            "colocate 3D",
+                            (real_t)(1e-4));
+      }
+    },
+    all_wrongs);
+  errorIf(all_wrongs != 0,
+          "colocate for 3D failed with " + std::to_string(all_wrongs) +
+            " errors");
+}
+
+auto main(int argc, char* argv[]) -> int {
+  Kokkos::initialize(argc, argv);
+
+  try {
+    testColocate2D({ 16, 12 });
+    testColocate3D({ 8, 10, 6 });
+  } catch (std::exception& e) {
+    std::cerr << e.what() << std::endl;
+    Kokkos::finalize();
+    return 1;
+  }
+  Kokkos::finalize();
+  return 0;
+}
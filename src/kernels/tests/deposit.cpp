@@ -3,6 +3,7 @@
 
 #include "arch/kokkos_aliases.h"
 #include "utils/comparators.h"
+#include "utils/sorting.h"
 
 #include "metrics/kerr_schild.h"
 #include "metrics/kerr_schild_0.h"
@@ -15,11 +16,13 @@
 
 #include <Kokkos_Core.hpp>
 #include <Kokkos_ScatterView.hpp>
+#include <Kokkos_Sort.hpp>
 
 #include <iostream>
 #include <map>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 void errorIf(bool condition, const std::string& message) {
   if (condition) {
@@ -172,6 +175,527 @@ void testDeposit(const std::vector<std::size_t>&      res,
           "DepositCurrents_kernel::Jy1 is incorrect");
   errorIf(not equal(J_h(i0 + 1 + N_GHOSTS, j0 + N_GHOSTS, cur::jx2), Jy2, "", eps),
           "DepositCurrents_kernel::Jy2 is incorrect");
+
+  // tiled deposit should reproduce the scatter-view deposit
+  const int  tile = 8;
+  const int  nt1 = (nx1 + tile - 1) / tile, nt2 = (nx2 + tile - 1) / tile;
+  const int  ntiles = nt1 * nt2;
+  using key_t       = array_t<int*>;
+  using binop_t     = sort::BinCell<key_t>;
+  using kernel_t    = kernel::DepositCurrents_kernel<S, M>;
+  ndfield_t<M::Dim, 3> J_tiled { "J_tiled", nx1 + 2 * N_GHOSTS, nx2 + 2 * N_GHOSTS };
+  key_t                keys { "keys", 10 };
+  Kokkos::parallel_for("TileKeys",
+                       10,
+                       kernel::ComputeTileKeys_kernel<M::Dim>(i1_prev,
+                                                              i2_prev,
+                                                              i3_prev,
+                                                              tag,
+                                                              keys,
+                                                              res,
+                                                              tile,
+                                                              nt1,
+                                                              nt2,
+                                                              ntiles));
+  Kokkos::BinSort<key_t, binop_t, typename key_t::device_type, npart_t> sorter {
+    keys,
+    binop_t { ntiles + 1 },
+    false
+  };
+  sorter.create_permute_vector();
+
+  // clang-format off
+  Kokkos::parallel_for("CurrentsDepositTiled",
+                       team_policy_t(ntiles, Kokkos::AUTO)
+                         .set_scratch_size(0, Kokkos::PerTeam(kernel_t::scratch_size(tile))),
+                       kernel_t(J_tiled,
+                                sorter.get_bin_offsets(), sorter.get_bin_count(),
+                                sorter.get_permute_vector(),
+                                tile, nt1, nt2,
+                                i1, i2, i3,
+                                i1_prev, i2_prev, i3_prev,
+                                dx1, dx2, dx3,
+                                dx1_prev, dx2_prev, dx3_prev,
+                                ux1, ux2, ux3,
+                                phi, weight, tag,
+                                metric, charge, inv_dt));
+  // clang-format on
+
+  auto J_tiled_h = Kokkos::create_mirror_view(J_tiled);
+  Kokkos::deep_copy(J_tiled_h, J_tiled);
+  for (auto i { 0u }; i < nx1 + 2 * N_GHOSTS; ++i) {
+    for (auto j { 0u }; j < nx2 + 2 * N_GHOSTS; ++j) {
+      for (auto c { 0u }; c < 3; ++c) {
+        errorIf(not cmp::AlmostEqual_host(J_tiled_h(i, j, c), J_h(i, j, c), eps),
+                "DepositCurrents_kernel::tiled deposit mismatch");
+      }
+    }
+  }
+}
+
+/*
+ * many particles spread over several tiles (some crossing the tile edges, some
+ * dead): the tiled deposit should reproduce the scatter-view deposit
+ */
+template <typename M, ntt::SimEngine::type S>
+void testTiledDeposit(const std::vector<std::size_t>&      res,
+                      const boundaries_t<real_t>&          ext,
+                      const std::map<std::string, real_t>& params,
+                      const real_t                         eps) {
+  static_assert(M::Dim == 2);
+  errorIf(res.size() != M::Dim, "res.size() != M::Dim");
+  using namespace ntt;
+
+  auto extents = ext;
+  if constexpr (M::CoordType != Coord::Cart) {
+    extents.emplace_back(ZERO, (real_t)(constant::PI));
+  }
+
+  M metric { res, extents, params };
+
+  const int     nx1 = res[0], nx2 = res[1];
+  const int     tile  = 8;
+  const npart_t npart = 512;
+  const real_t  charge { 1.0 }, inv_dt { 1.0 };
+
+  array_t<int*>      i1 { "i1", npart }, i2 { "i2", npart }, i3 { "i3", npart };
+  array_t<int*>      i1_prev { "i1_prev", npart }, i2_prev { "i2_prev", npart },
+    i3_prev { "i3_prev", npart };
+  array_t<prtldx_t*> dx1 { "dx1", npart }, dx2 { "dx2", npart },
+    dx3 { "dx3", npart };
+  array_t<prtldx_t*> dx1_prev { "dx1_prev", npart },
+    dx2_prev { "dx2_prev", npart }, dx3_prev { "dx3_prev", npart };
+  array_t<real_t*>   ux1 { "ux1", npart }, ux2 { "ux2", npart },
+    ux3 { "ux3", npart };
+  array_t<real_t*>   phi { "phi", npart }, weight { "weight", npart };
+  array_t<short*>    tag { "tag", npart };
+
+  {
+    auto i1_h       = Kokkos::create_mirror_view(i1);
+    auto i2_h       = Kokkos::create_mirror_view(i2);
+    auto i1_prev_h  = Kokkos::create_mirror_view(i1_prev);
+    auto i2_prev_h  = Kokkos::create_mirror_view(i2_prev);
+    auto dx1_h      = Kokkos::create_mirror_view(dx1);
+    auto dx2_h      = Kokkos::create_mirror_view(dx2);
+    auto dx1_prev_h = Kokkos::create_mirror_view(dx1_prev);
+    auto dx2_prev_h = Kokkos::create_mirror_view(dx2_prev);
+    auto ux1_h      = Kokkos::create_mirror_view(ux1);
+    auto ux2_h      = Kokkos::create_mirror_view(ux2);
+    auto ux3_h      = Kokkos::create_mirror_view(ux3);
+    auto weight_h   = Kokkos::create_mirror_view(weight);
+    auto tag_h      = Kokkos::create_mirror_view(tag);
+
+    // deterministic pseudo-random numbers in [0, 1)
+    unsigned long long seed = 12345u;
+    const auto         rnd  = [&seed]() -> real_t {
+      seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+      return static_cast<real_t>((seed >> 11) % 1000000u) / (real_t)(1e6);
+    };
+    // new position after a displacement of less than a cell
+    const auto move = [](int       i,
+                         real_t    dx,
+                         real_t    disp,
+                         int&      i_new,
+                         prtldx_t& dx_new) {
+      const auto x = static_cast<real_t>(i) + dx + disp;
+      i_new        = static_cast<int>(math::floor(x));
+      dx_new       = static_cast<prtldx_t>(x - static_cast<real_t>(i_new));
+    };
+    // particles are kept away from the edges of the domain (i.e., the axis)
+    const auto cell = [&rnd](int nx) -> int {
+      return 2 + static_cast<int>(rnd() * static_cast<real_t>(nx - 4));
+    };
+    // cell next to a tile edge (on either side of it)
+    const auto edge_cell = [&rnd](int nx, int tile) -> int {
+      const auto nedges = (nx - 4) / tile;
+      const auto edge   = tile * (1 + static_cast<int>(
+                                        rnd() * static_cast<real_t>(nedges)));
+      return (rnd() < HALF) ? edge - 1 : edge;
+    };
+
+    for (npart_t p { 0 }; p < npart; ++p) {
+      real_t disp1 = (real_t)(1.8) * rnd() - (real_t)(0.9);
+      real_t disp2 = (real_t)(1.8) * rnd() - (real_t)(0.9);
+      if (p % 4 == 0) {
+        // crossing an edge between the tiles (along one or both directions)
+        i1_prev_h(p)  = edge_cell(nx1, tile);
+        dx1_prev_h(p) = (i1_prev_h(p) % tile == 0) ? (prtldx_t)(0.1)
+                                                   : (prtldx_t)(0.9);
+        disp1 = (i1_prev_h(p) % tile == 0) ? (real_t)(-0.4) : (real_t)(0.4);
+        i2_prev_h(p)  = (p % 8 == 0) ? edge_cell(nx2, tile) : cell(nx2);
+        dx2_prev_h(p) = static_cast<prtldx_t>(rnd());
+        if (p % 8 == 0) {
+          dx2_prev_h(p) = (i2_prev_h(p) % tile == 0) ? (prtldx_t)(0.1)
+                                                     : (prtldx_t)(0.9);
+          disp2 = (i2_prev_h(p) % tile == 0) ? (real_t)(-0.4) : (real_t)(0.4);
+        }
+      } else {
+        i1_prev_h(p)  = cell(nx1);
+        i2_prev_h(p)  = cell(nx2);
+        dx1_prev_h(p) = static_cast<prtldx_t>(rnd());
+        dx2_prev_h(p) = static_cast<prtldx_t>(rnd());
+      }
+      move(i1_prev_h(p), dx1_prev_h(p), disp1, i1_h(p), dx1_h(p));
+      move(i2_prev_h(p), dx2_prev_h(p), disp2, i2_h(p), dx2_h(p));
+      ux1_h(p)    = disp1;
+      ux2_h(p)    = disp2;
+      ux3_h(p)    = rnd() - HALF;
+      weight_h(p) = HALF + rnd();
+      tag_h(p)    = (p % 7 == 3) ? ParticleTag::dead : ParticleTag::alive;
+    }
+    Kokkos::deep_copy(i1, i1_h);
+    Kokkos::deep_copy(i2, i2_h);
+    Kokkos::deep_copy(i1_prev, i1_prev_h);
+    Kokkos::deep_copy(i2_prev, i2_prev_h);
+    Kokkos::deep_copy(dx1, dx1_h);
+    Kokkos::deep_copy(dx2, dx2_h);
+    Kokkos::deep_copy(dx1_prev, dx1_prev_h);
+    Kokkos::deep_copy(dx2_prev, dx2_prev_h);
+    Kokkos::deep_copy(ux1, ux1_h);
+    Kokkos::deep_copy(ux2, ux2_h);
+    Kokkos::deep_copy(ux3, ux3_h);
+    Kokkos::deep_copy(weight, weight_h);
+    Kokkos::deep_copy(tag, tag_h);
+  }
+
+  // reference: scatter-view deposit
+  ndfield_t<M::Dim, 3> J { "J", nx1 + 2 * N_GHOSTS, nx2 + 2 * N_GHOSTS };
+  auto J_scat = Kokkos::Experimental::create_scatter_view(J);
+  // clang-format off
+  Kokkos::parallel_for("CurrentsDeposit", npart,
+                       kernel::DepositCurrents_kernel<S, M>(J_scat,
+                                                            i1, i2, i3,
+                                                            i1_prev, i2_prev, i3_prev,
+                                                            dx1, dx2, dx3,
+                                                            dx1_prev, dx2_prev, dx3_prev,
+                                                            ux1, ux2, ux3,
+                                                            phi, weight, tag,
+                                                            metric, charge, inv_dt));
+  // clang-format on
+  Kokkos::Experimental::contribute(J, J_scat);
+
+  // tiled deposit: particles binned by the tile of their previous position
+  const int  nt1 = (nx1 + tile - 1) / tile, nt2 = (nx2 + tile - 1) / tile;
+  const int  ntiles = nt1 * nt2;
+  using key_t       = array_t<int*>;
+  using binop_t     = sort::BinCell<key_t>;
+  using kernel_t    = kernel::DepositCurrents_kernel<S, M>;
+  ndfield_t<M::Dim, 3> J_tiled { "J_tiled", nx1 + 2 * N_GHOSTS, nx2 + 2 * N_GHOSTS };
+  key_t                keys { "keys", npart };
+  Kokkos::parallel_for("TileKeys",
+                       npart,
+                       kernel::ComputeTileKeys_kernel<M::Dim>(i1_prev,
+                                                              i2_prev,
+                                                              i3_prev,
+                                                              tag,
+                                                              keys,
+                                                              res,
+                                                              tile,
+                                                              nt1,
+                                                              nt2,
+                                                              ntiles));
+  Kokkos::BinSort<key_t, binop_t, typename key_t::device_type, npart_t> sorter {
+    keys,
+    binop_t { ntiles + 1 },
+    false
+  };
+  sorter.create_permute_vector();
+
+  // every particle is binned exactly once (the dead ones in the last bin)
+  {
+    const auto offsets   = sorter.get_bin_offsets();
+    const auto counts    = sorter.get_bin_count();
+    const auto permute   = sorter.get_permute_vector();
+    auto       offsets_h = Kokkos::create_mirror_view(offsets);
+    auto       counts_h  = Kokkos::create_mirror_view(counts);
+    auto       permute_h = Kokkos::create_mirror_view(permute);
+    auto       keys_h    = Kokkos::create_mirror_view(keys);
+    Kokkos::deep_copy(offsets_h, offsets);
+    Kokkos::deep_copy(counts_h, counts);
+    Kokkos::deep_copy(permute_h, permute);
+    Kokkos::deep_copy(keys_h, keys);
+    std::vector<int> seen(npart, 0);
+    npart_t          nbinned = 0;
+    int              nfilled = 0;
+    for (auto t { 0 }; t <= ntiles; ++t) {
+      nfilled += (t < ntiles) and (counts_h(t) > 0);
+      for (auto k { 0 }; k < static_cast<int>(counts_h(t)); ++k) {
+        const auto p = permute_h(offsets_h(t) + k);
+        errorIf(keys_h(p) != t, "particle binned into the wrong tile");
+        ++seen[p];
+        ++nbinned;
+      }
+    }
+    errorIf(nbinned != npart, "not all the particles are binned");
+    for (const auto& s : seen) {
+      errorIf(s != 1, "particle binned more than once");
+    }
+    errorIf(nfilled < 4, "particles should cover several tiles");
+  }
+
+  // clang-format off
+  Kokkos::parallel_for("CurrentsDepositTiled",
+                       team_policy_t(ntiles, Kokkos::AUTO)
+                         .set_scratch_size(0, Kokkos::PerTeam(kernel_t::scratch_size(tile))),
+                       kernel_t(J_tiled,
+                                sorter.get_bin_offsets(), sorter.get_bin_count(),
+                                sorter.get_permute_vector(),
+                                tile, nt1, nt2,
+                                i1, i2, i3,
+                                i1_prev, i2_prev, i3_prev,
+                                dx1, dx2, dx3,
+                                dx1_prev, dx2_prev, dx3_prev,
+                                ux1, ux2, ux3,
+                                phi, weight, tag,
+                                metric, charge, inv_dt));
+  // clang-format on
+
+  auto J_h       = Kokkos::create_mirror_view(J);
+  auto J_tiled_h = Kokkos::create_mirror_view(J_tiled);
+  Kokkos::deep_copy(J_h, J);
+  Kokkos::deep_copy(J_tiled_h, J_tiled);
+  // contributions are summed in a different order, so the difference is
+  // compared to the largest current (rather than to each, possibly cancelling,
+  // value)
+  real_t J_max = ZERO;
+  for (auto i { 0 }; i < nx1 + 2 * N_GHOSTS; ++i) {
+    for (auto j { 0 }; j < nx2 + 2 * N_GHOSTS; ++j) {
+      for (auto c { 0 }; c < 3; ++c) {
+        J_max = math::max(J_max, math::abs(J_h(i, j, c)));
+      }
+    }
+  }
+  errorIf(J_max <= ZERO, "DepositCurrents_kernel::no current deposited");
+  std::size_t nwrong = 0;
+  for (auto i { 0 }; i < nx1 + 2 * N_GHOSTS; ++i) {
+    for (auto j { 0 }; j < nx2 + 2 * N_GHOSTS; ++j) {
+      for (auto c { 0 }; c < 3; ++c) {
+        nwrong += (math::abs(J_tiled_h(i, j, c) - J_h(i, j, c)) > eps * J_max);
+      }
+    }
+  }
+  errorIf(nwrong != 0,
+          "DepositCurrents_kernel::tiled deposit mismatch in " +
+            std::to_string(nwrong) + " cells");
+}
+
+/*
+ * higher-order shapes (Esirkepov scheme): particles moving along one axis,
+ * diagonally & (in 3D) along all the axes, crossing the cell edges or not;
+ * the divergence of the deposited current should match the change of the
+ * charge density (deposited with the same shape) at every node
+ */
+template <Dimension D, unsigned short O>
+void testShapedDeposit(const std::vector<std::size_t>& res, const real_t eps) {
+  static_assert((D == Dim::_2D) or (D == Dim::_3D));
+  static_assert(O > 1);
+  errorIf(res.size() != (std::size_t)D, "res.size() != D");
+  using namespace ntt;
+  using M = metric::Minkowski<D>;
+
+  boundaries_t<real_t> extents;
+  for (auto d { 0u }; d < (unsigned int)D; ++d) {
+    extents.emplace_back(ZERO, (real_t)(res[d]));
+  }
+  M metric { res, extents, {} };
+
+  // # of nodes (ghost-included) along each direction
+  const int n1 = res[0] + 2 * N_GHOSTS;
+  const int n2 = res[1] + 2 * N_GHOSTS;
+  const int n3 = (D == Dim::_3D) ? res[2] + 2 * N_GHOSTS : 1;
+
+  // { i, dx } before the motion & the displacement along each direction
+  // clang-format off
+  const std::vector<std::vector<real_t>> moves {
+    { 40, 0.70, 40, 0.30, 40, 0.50,  0.60,  0.00,  0.00 },
+    { 45, 0.20, 42, 0.10, 41, 0.50,  0.00, -0.70,  0.00 },
+    { 50, 0.80, 50, 0.90, 40, 0.40,  0.45,  0.35,  0.00 },
+    { 55, 0.10, 47, 0.25, 43, 0.60, -0.60, -0.80,  0.00 },
+    { 60, 0.50, 58, 0.50, 56, 0.90,  0.55, -0.65,  0.30 },
+    { 35, 0.05, 36, 0.95, 37, 0.02, -0.30,  0.40, -0.50 },
+    { 41, 0.40, 52, 0.60, 44, 0.30,  0.10, -0.20,  0.15 },
+    { 48, 0.30, 48, 0.30, 48, 0.30,  0.90,  0.90,  0.90 }
+  };
+  // clang-format on
+  const npart_t npart  = moves.size();
+  const npart_t p_dead = npart - 1;
+  const real_t  charge { -1.0 }, inv_dt { 2.0 };
+
+  array_t<int*>      i1 { "i1", npart }, i2 { "i2", npart }, i3 { "i3", npart };
+  array_t<int*>      i1_prev { "i1_prev", npart }, i2_prev { "i2_prev", npart },
+    i3_prev { "i3_prev", npart };
+  array_t<prtldx_t*> dx1 { "dx1", npart }, dx2 { "dx2", npart },
+    dx3 { "dx3", npart };
+  array_t<prtldx_t*> dx1_prev { "dx1_prev", npart },
+    dx2_prev { "dx2_prev", npart }, dx3_prev { "dx3_prev", npart };
+  array_t<real_t*>   ux1 { "ux1", npart }, ux2 { "ux2", npart },
+    ux3 { "ux3", npart };
+  array_t<real_t*>   phi { "phi", npart }, weight { "weight", npart };
+  array_t<short*>    tag { "tag", npart };
+
+  // charge density before & after the motion (with the shape of order `O`)
+  std::vector<real_t> rho_prev(n1 * n2 * n3, ZERO), rho(n1 * n2 * n3, ZERO);
+  const auto          deposit_rho = [&](std::vector<real_t>& rho_,
+                                const int (&i)[3],
+                                const real_t (&dx)[3],
+                                real_t w) {
+    int    i_min[3] { 0, 0, 0 };
+    real_t S[3][O + 1];
+    for (auto d { 0u }; d < 3; ++d) {
+      S[d][0] = ONE;
+      for (auto a { 1 }; a <= O; ++a) {
+        S[d][a] = ZERO;
+      }
+    }
+    for (auto d { 0u }; d < (unsigned int)D; ++d) {
+      kernel::shape::order<O>(i[d], dx[d], i_min[d], S[d]);
+      i_min[d] += N_GHOSTS;
+    }
+    const auto a3_max = (D == Dim::_3D) ? O : 0;
+    for (auto a1 { 0 }; a1 <= O; ++a1) {
+      for (auto a2 { 0 }; a2 <= O; ++a2) {
+        for (auto a3 { 0 }; a3 <= a3_max; ++a3) {
+          const auto k = ((i_min[0] + a1) * n2 + (i_min[1] + a2)) * n3 +
+                         (i_min[2] + a3);
+          rho_[k] += w * S[0][a1] * S[1][a2] * S[2][a3];
+        }
+      }
+    }
+  };
+
+  {
+    auto i1_h       = Kokkos::create_mirror_view(i1);
+    auto i2_h       = Kokkos::create_mirror_view(i2);
+    auto i3_h       = Kokkos::create_mirror_view(i3);
+    auto i1_prev_h  = Kokkos::create_mirror_view(i1_prev);
+    auto i2_prev_h  = Kokkos::create_mirror_view(i2_prev);
+    auto i3_prev_h  = Kokkos::create_mirror_view(i3_prev);
+    auto dx1_h      = Kokkos::create_mirror_view(dx1);
+    auto dx2_h      = Kokkos::create_mirror_view(dx2);
+    auto dx3_h      = Kokkos::create_mirror_view(dx3);
+    auto dx1_prev_h = Kokkos::create_mirror_view(dx1_prev);
+    auto dx2_prev_h = Kokkos::create_mirror_view(dx2_prev);
+    auto dx3_prev_h = Kokkos::create_mirror_view(dx3_prev);
+    auto ux1_h      = Kokkos::create_mirror_view(ux1);
+    auto ux2_h      = Kokkos::create_mirror_view(ux2);
+    auto ux3_h      = Kokkos::create_mirror_view(ux3);
+    auto weight_h   = Kokkos::create_mirror_view(weight);
+    auto tag_h      = Kokkos::create_mirror_view(tag);
+    for (npart_t p { 0 }; p < npart; ++p) {
+      const auto& mv = moves[p];
+      int         i_prev[3], i[3];
+      real_t      dxr_prev[3], dxr[3];
+      prtldx_t    dx_prev[3], dx[3];
+      for (auto d { 0u }; d < 3; ++d) {
+        i_prev[d]  = static_cast<int>(mv[2 * d]);
+        dx_prev[d] = static_cast<prtldx_t>(mv[2 * d + 1]);
+        const auto x_new = static_cast<real_t>(i_prev[d]) + dx_prev[d] +
+                           mv[6 + d];
+        i[d]  = static_cast<int>(math::floor(x_new));
+        dx[d] = static_cast<prtldx_t>(x_new - static_cast<real_t>(i[d]));
+        dxr_prev[d] = static_cast<real_t>(dx_prev[d]);
+        dxr[d]      = static_cast<real_t>(dx[d]);
+      }
+      i1_prev_h(p)  = i_prev[0];
+      i2_prev_h(p)  = i_prev[1];
+      i3_prev_h(p)  = i_prev[2];
+      dx1_prev_h(p) = dx_prev[0];
+      dx2_prev_h(p) = dx_prev[1];
+      dx3_prev_h(p) = dx_prev[2];
+      i1_h(p)       = i[0];
+      i2_h(p)       = i[1];
+      i3_h(p)       = i[2];
+      dx1_h(p)      = dx[0];
+      dx2_h(p)      = dx[1];
+      dx3_h(p)      = dx[2];
+      ux1_h(p)      = mv[6];
+      ux2_h(p)      = mv[7];
+      ux3_h(p)      = mv[8];
+      weight_h(p)   = ONE + (real_t)(0.25) * static_cast<real_t>(p);
+      tag_h(p) = (p == p_dead) ? ParticleTag::dead : ParticleTag::alive;
+      if (p != p_dead) {
+        deposit_rho(rho_prev, i_prev, dxr_prev, weight_h(p) * charge);
+        deposit_rho(rho, i, dxr, weight_h(p) * charge);
+      }
+    }
+    Kokkos::deep_copy(i1, i1_h);
+    Kokkos::deep_copy(i2, i2_h);
+    Kokkos::deep_copy(i3, i3_h);
+    Kokkos::deep_copy(i1_prev, i1_prev_h);
+    Kokkos::deep_copy(i2_prev, i2_prev_h);
+    Kokkos::deep_copy(i3_prev, i3_prev_h);
+    Kokkos::deep_copy(dx1, dx1_h);
+    Kokkos::deep_copy(dx2, dx2_h);
+    Kokkos::deep_copy(dx3, dx3_h);
+    Kokkos::deep_copy(dx1_prev, dx1_prev_h);
+    Kokkos::deep_copy(dx2_prev, dx2_prev_h);
+    Kokkos::deep_copy(dx3_prev, dx3_prev_h);
+    Kokkos::deep_copy(ux1, ux1_h);
+    Kokkos::deep_copy(ux2, ux2_h);
+    Kokkos::deep_copy(ux3, ux3_h);
+    Kokkos::deep_copy(weight, weight_h);
+    Kokkos::deep_copy(tag, tag_h);
+  }
+
+  ndfield_t<D, 3> J;
+  if constexpr (D == Dim::_2D) {
+    J = ndfield_t<D, 3> { "J", res[0] + 2 * N_GHOSTS, res[1] + 2 * N_GHOSTS };
+  } else {
+    J = ndfield_t<D, 3> { "J",
+                          res[0] + 2 * N_GHOSTS,
+                          res[1] + 2 * N_GHOSTS,
+                          res[2] + 2 * N_GHOSTS };
+  }
+  using kernel_t = kernel::DepositCurrents_kernel<SimEngine::SRPIC, M, O>;
+  auto J_scat    = Kokkos::Experimental::create_scatter_view(J);
+  // clang-format off
+  Kokkos::parallel_for("CurrentsDeposit", npart,
+                       kernel_t(J_scat,
+                                i1, i2, i3,
+                                i1_prev, i2_prev, i3_prev,
+                                dx1, dx2, dx3,
+                                dx1_prev, dx2_prev, dx3_prev,
+                                ux1, ux2, ux3,
+                                phi, weight, tag,
+                                metric, charge, inv_dt));
+  // clang-format on
+  Kokkos::Experimental::contribute(J, J_scat);
+
+  auto J_h = Kokkos::create_mirror_view(J);
+  Kokkos::deep_copy(J_h, J);
+  const auto J_at = [&J_h](int i, int j, int k, int c) -> real_t {
+    if (i < 0 or j < 0 or k < 0) {
+      return ZERO;
+    }
+    if constexpr (D == Dim::_2D) {
+      return J_h(i, j, c);
+    } else {
+      return J_h(i, j, k, c);
+    }
+  };
+
+  // div J = -(rho - rho_prev) / dt at every node
+  real_t      J_max = ZERO;
+  std::size_t nwrong { 0 };
+  for (auto i { 0 }; i < n1; ++i) {
+    for (auto j { 0 }; j < n2; ++j) {
+      for (auto k { 0 }; k < n3; ++k) {
+        real_t divJ = J_at(i, j, k, cur::jx1) - J_at(i - 1, j, k, cur::jx1) +
+                      J_at(i, j, k, cur::jx2) - J_at(i, j - 1, k, cur::jx2);
+        if constexpr (D == Dim::_3D) {
+          divJ += J_at(i, j, k, cur::jx3) - J_at(i, j, k - 1, cur::jx3);
+        }
+        const auto idx   = (i * n2 + j) * n3 + k;
+        const auto drho  = (rho[idx] - rho_prev[idx]) * inv_dt;
+        nwrong          += (math::abs(divJ + drho) > eps);
+        J_max = math::max(J_max, math::abs(J_at(i, j, k, cur::jx1)));
+      }
+    }
+  }
+  errorIf(J_max <= ZERO, "DepositCurrents_kernel::no current deposited");
+  errorIf(nwrong != 0,
+          "DepositCurrents_kernel::continuity violated with O = " +
+            std::to_string(O) + " in " + std::to_string(nwrong) + " nodes");
 }
 
 auto main(int argc, char* argv[]) -> int {
@@ -202,6 +726,16 @@ auto main(int argc, char* argv[]) -> int {
     testDeposit<QKerrSchild<Dim::_2D>, SimEngine::GRPIC>(res, r_extent, params, eps);
     testDeposit<KerrSchild0<Dim::_2D>, SimEngine::GRPIC>(res, r_extent, params, eps);
 
+    testTiledDeposit<Minkowski<Dim::_2D>, SimEngine::SRPIC>(res, xy_extent, {}, eps);
+    testTiledDeposit<Spherical<Dim::_2D>, SimEngine::SRPIC>(res, r_extent, {}, eps);
+    testTiledDeposit<QSpherical<Dim::_2D>, SimEngine::SRPIC>(res, r_extent, params, eps);
+    testTiledDeposit<KerrSchild<Dim::_2D>, SimEngine::GRPIC>(res, r_extent, params, eps);
+
+    testShapedDeposit<Dim::_2D, 2>(res, eps);
+    testShapedDeposit<Dim::_2D, 3>(res, eps);
+    testShapedDeposit<Dim::_3D, 2>({ 70, 70, 70 }, eps);
+    testShapedDeposit<Dim::_3D, 3>({ 70, 70, 70 }, eps);
+
   } catch (std::exception& e) {
     std::cerr << e.what() << std::endl;
     Kokkos::finalize();
@@ -0,0 +1,223 @@
+#include "kernels/particle_histogram.hpp"
+
+#include "enums.h"
+#include "global.h"
+
+#include "arch/kokkos_aliases.h"
+#include "utils/comparators.h"
+#include "utils/formatting.h"
+#include "utils/numeric.h"
+
+#include "metrics/minkowski.h"
+
+#include <Kokkos_Core.hpp>
+
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace ntt;
+using namespace metric;
+
+void errorIf(bool condition, const std::string& message) {
+  if (condition) {
+    throw std::runtime_error(message);
+  }
+}
+
+template <typename T>
+void put_value(array_t<T*>& arr, T v, index_t p) {
+  auto h = Kokkos::create_mirror_view(arr);
+  Kokkos::deep_copy(h, arr);
+  h(p) = v;
+  Kokkos::deep_copy(arr, h);
+}
+
+/**
+ * @brief Bin the particles with both the range & the team policies
+ */
+template <class M>
+auto binParticles(const std::vector<SpecAxis>&    axes,
+                  const std::vector<std::size_t>& n_bins,
+                  const std::vector<real_t>&      min,
+                  const std::vector<real_t>&      max,
+                  const std::vector<bool>&        log_bins,
+                  const array_t<int*>&            i1,
+                  const array_t<int*>&            i2,
+                  const array_t<prtldx_t*>&       dx1,
+                  const array_t<prtldx_t*>&       dx2,
+                  const array_t<real_t*>&         ux1,
+                  const array_t<real_t*>&         ux2,
+                  const array_t<real_t*>&         ux3,
+                  const array_t<real_t*>&         weight,
+                  const array_t<short*>&          tag,
+                  const ndfield_t<Dim::_2D, 6>&   Bcc,
+                  const M&                        metric)
+  -> std::pair<array_mirror_t<real_t*>, array_mirror_t<real_t*>> {
+  using kernel_t = kernel::ParticleHistogram_kernel<SimEngine::SRPIC, M>;
+  std::size_t ntot = 1;
+  for (const auto& nb : n_bins) {
+    ntot *= nb;
+  }
+  const npart_t    npart = i1.extent(0);
+  const npart_t    chunk = 3;
+  array_t<int*>    i3 { "i3", 0 };
+  array_t<prtldx_t*> dx3 { "dx3", 0 };
+  array_t<real_t*> phi { "phi", 0 };
+
+  array_t<real_t*> hist_range { "hist_range", ntot };
+  array_t<real_t*> hist_team { "hist_team", ntot };
+  // clang-format off
+  Kokkos::parallel_for("ParticleHistogram", npart,
+                       kernel_t(hist_range, axes, n_bins, min, max, log_bins,
+                                i1, i2, i3, dx1, dx2, dx3, ux1, ux2, ux3,
+                                phi, weight, tag, 1.0f, Bcc, 3, metric,
+                                npart, chunk));
+  Kokkos::parallel_for("ParticleHistogram",
+                       team_policy_t((npart + chunk - 1) / chunk, Kokkos::AUTO)
+                         .set_scratch_size(0, Kokkos::PerTeam(kernel_t::scratch_size(ntot))),
+                       kernel_t(hist_team, axes, n_bins, min, max, log_bins,
+                                i1, i2, i3, dx1, dx2, dx3, ux1, ux2, ux3,
+                                phi, weight, tag, 1.0f, Bcc, 3, metric,
+                                npart, chunk));
+  // clang-format on
+  auto hist_range_h = Kokkos::create_mirror_view(hist_range);
+  auto hist_team_h  = Kokkos::create_mirror_view(hist_team);
+  Kokkos::deep_copy(hist_range_h, hist_range);
+  Kokkos::deep_copy(hist_team_h, hist_team);
+  return { hist_range_h, hist_team_h };
+}
+
+void checkHistogram(const array_mirror_t<real_t*>& hist,
+                    const std::vector<real_t>&     expected,
+                    const std::string&             label) {
+  errorIf(hist.extent(0) != expected.size(), "wrong size of " + label);
+  for (auto b { 0u }; b < expected.size(); ++b) {
+    errorIf(not cmp::AlmostEqual_host(hist(b), expected[b]),
+            fmt::format("wrong %s bin %d: %.12e instead of %.12e",
+                        label.c_str(),
+                        b,
+                        hist(b),
+                        expected[b]));
+  }
+}
+
+void testParticleHistogram() {
+  using M = Minkowski<Dim::_2D>;
+
+  const std::size_t nx1 = 10, nx2 = 10;
+  M                 metric {
+    { nx1, nx2 },
+    { { 0.0, 10.0 }, { 0.0, 10.0 } },
+    {}
+  };
+
+  array_t<int*>      i1 { "i1", 10 };
+  array_t<int*>      i2 { "i2", 10 };
+  array_t<prtldx_t*> dx1 { "dx1", 10 };
+  array_t<prtldx_t*> dx2 { "dx2", 10 };
+  array_t<real_t*>   ux1 { "ux1", 10 };
+  array_t<real_t*>   ux2 { "ux2", 10 };
+  array_t<real_t*>   ux3 { "ux3", 10 };
+  array_t<real_t*>   weight { "weight", 10 };
+  array_t<short*>    tag { "tag", 10 };
+
+  // x1 = 5.15, gamma - 1 = sqrt(15) - 1, mu = 1 / sqrt(14)
+  put_value<int>(i1, 5, 0);
+  put_value<int>(i2, 4, 0);
+  put_value<prtldx_t>(dx1, (prtldx_t)(0.15), 0);
+  put_value<prtldx_t>(dx2, (prtldx_t)(0.85), 0);
+  put_value<real_t>(ux1, (real_t)(1.0), 0);
+  put_value<real_t>(ux2, (real_t)(-2.0), 0);
+  put_value<real_t>(ux3, (real_t)(3.0), 0);
+  put_value<short>(tag, ParticleTag::alive, 0);
+  put_value<real_t>(weight, 1.0, 0);
+
+  // x1 = 2.22, gamma - 1 = sqrt(1.25) - 1, mu = 1
+  put_value<int>(i1, 2, 4);
+  put_value<int>(i2, 2, 4);
+  put_value<prtldx_t>(dx1, (prtldx_t)(0.22), 4);
+  put_value<prtldx_t>(dx2, (prtldx_t)(0.55), 4);
+  put_value<real_t>(ux1, (real_t)(0.5), 4);
+  put_value<short>(tag, ParticleTag::alive, 4);
+  put_value<real_t>(weight, 2.0, 4);
+
+  // at rest: not counted in log-energy or pitch angle
+  put_value<int>(i1, 7, 7);
+  put_value<int>(i2, 1, 7);
+  put_value<prtldx_t>(dx1, (prtldx_t)(0.5), 7);
+  put_value<prtldx_t>(dx2, (prtldx_t)(0.5), 7);
+  put_value<short>(tag, ParticleTag::alive, 7);
+  put_value<real_t>(weight, 1.0, 7);
+
+  // uniform magnetic field along x1 (cell-centered, tetrad basis)
+  ndfield_t<Dim::_2D, 6> Bcc { "Bcc", nx1 + 2 * N_GHOSTS, nx2 + 2 * N_GHOSTS };
+  Kokkos::deep_copy(Kokkos::subview(Bcc, Kokkos::ALL, Kokkos::ALL, 3), ONE);
+
+  {
+    // x1 [0, 10] x log(energy) [1e-2, 1e2]
+    const auto [hist_range, hist_team] = binParticles<M>(
+      { SpecAxis::X1, SpecAxis::Energy },
+      { 5, 4 },
+      { 0.0, 1e-2 },
+      { 10.0, 1e2 },
+      { false, true },
+      i1, i2, dx1, dx2, ux1, ux2, ux3, weight, tag, Bcc, metric);
+    std::vector<real_t> expected(20, ZERO);
+    expected[2 * 4 + 2] = 1.0;
+    expected[1 * 4 + 1] = 2.0;
+    checkHistogram(hist_range, expected, "x1-energy (range)");
+    checkHistogram(hist_team, expected, "x1-energy (team)");
+  }
+
+  {
+    // pitch angle cosine [-1, 1] x x2 [0, 10]
+    const auto [hist_range, hist_team] = binParticles<M>(
+      { SpecAxis::Pitch, SpecAxis::X2 },
+      { 4, 2 },
+      { -1.0, 0.0 },
+      { 1.0, 10.0 },
+      { false, false },
+      i1, i2, dx1, dx2, ux1, ux2, ux3, weight, tag, Bcc, metric);
+    std::vector<real_t> expected(8, ZERO);
+    expected[2 * 2 + 0] = 1.0;
+    expected[3 * 2 + 0] = 2.0;
+    checkHistogram(hist_range, expected, "pitch-x2 (range)");
+    checkHistogram(hist_team, expected, "pitch-x2 (team)");
+  }
+
+  {
+    // upar & uperp
+    const auto [hist_range, hist_team] = binParticles<M>(
+      { SpecAxis::Upar, SpecAxis::Uperp },
+      { 4, 4 },
+      { -2.0, 0.0 },
+      { 2.0, 4.0 },
+      { false, false },
+      i1, i2, dx1, dx2, ux1, ux2, ux3, weight, tag, Bcc, metric);
+    std::vector<real_t> expected(16, ZERO);
+    // upar = 1, uperp = sqrt(13)
+    expected[3 * 4 + 3] += 1.0;
+    // upar = 0.5, uperp = 0
+    expected[2 * 4 + 0] += 2.0;
+    // at rest
+    expected[2 * 4 + 0] += 1.0;
+    checkHistogram(hist_range, expected, "upar-uperp (range)");
+    checkHistogram(hist_team, expected, "upar-uperp (team)");
+  }
+}
+
+auto main(int argc, char* argv[]) -> int {
+  Kokkos::initialize(argc, argv);
+  try {
+    testParticleHistogram();
+  } catch (std::exception& e) {
+    std::cerr << e.what() << std::endl;
+    Kokkos::finalize();
+    return 1;
+  }
+  Kokkos::finalize();
+  return 0;
+}
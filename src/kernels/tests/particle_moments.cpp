@@ -196,9 +196,53 @@ void testParticleMoments(const std::vector<std::size_t>&      res,
                                                             mass, charge,
                                                             use_weights,
                                                             metric), t00);
+  // same reduced moments in a single sweep
+  array_h_t<real_t*> reduced_batch { "reduced_batch", 4 };
+  Kokkos::parallel_reduce(
+    "ReducedParticleMomentsBatch", 10,
+    kernel::ReducedParticleMomentsBatch_kernel<S, M>({ { StatsID::N, 0, 0 },
+                                                       { StatsID::Npart, 0, 0 },
+                                                       { StatsID::Rho, 0, 0 },
+                                                       { StatsID::T, 0, 0 } },
+                                                     i1, i2, i3,
+                                                     dx1, dx2, dx3,
+                                                     ux1, ux2, ux3,
+                                                     phi, weight, tag,
+                                                     mass, charge,
+                                                     use_weights,
+                                                     metric), reduced_batch);
   // clang-format on
   Kokkos::Experimental::contribute(buff, scatter_buff);
 
+  // same moments (and the density) deposited in a single sweep
+  ndarray_t<3> buff_batch { "buff_batch", nx1 + 2 * N_GHOSTS, nx2 + 2 * N_GHOSTS, 4 };
+  {
+    std::vector<kernel::MomentSpec> specs(4);
+    for (auto i { 0u }; i < 3; ++i) {
+      specs[i].id       = FldsID::T;
+      specs[i].c1       = 0;
+      specs[i].c2       = static_cast<unsigned short>(i + 1);
+      specs[i].buff_idx = static_cast<unsigned short>(i);
+    }
+    specs[3].id       = FldsID::N;
+    specs[3].buff_idx = 3;
+    auto scatter_batch = Kokkos::Experimental::create_scatter_view(buff_batch);
+    // clang-format off
+    Kokkos::parallel_for(
+      "ParticleMomentsBatch", 10,
+      kernel::ParticleMomentsBatch_kernel<S, M>(specs, scatter_batch,
+                                                i1, i2, i3,
+                                                dx1, dx2, dx3,
+                                                ux1, ux2, ux3,
+                                                phi, weight, tag,
+                                                mass, charge,
+                                                use_weights,
+                                                metric,
+                                                boundaries, nx2, inv_n0, window));
+    // clang-format on
+    Kokkos::Experimental::contribute(buff_batch, scatter_batch);
+  }
+
   auto i1_h = Kokkos::create_mirror_view(i1);
   auto i2_h = Kokkos::create_mirror_view(i2);
   Kokkos::deep_copy(i1_h, i1);
@@ -227,6 +271,32 @@ void testParticleMoments(const std::vector<std::size_t>&      res,
         }
       }
     }
+    auto buff_batch_h = Kokkos::create_mirror_view(buff_batch);
+    Kokkos::deep_copy(buff_batch_h, buff_batch);
+    real_t n_batch = ZERO;
+    for (unsigned int idx1 = 0; idx1 < nx1 + 2 * N_GHOSTS; ++idx1) {
+      for (unsigned int idx2 = 0; idx2 < nx2 + 2 * N_GHOSTS; ++idx2) {
+        for (auto c { 0u }; c < 3; ++c) {
+          errorIf(not cmp::AlmostEqual_host(buff_batch_h(idx1, idx2, c),
+                                            buff_h(idx1, idx2, c),
+                                            epsilon * acc),
+                  fmt::format("batched moment %d differs at (%d, %d) for %dD %s",
+                              c,
+                              idx1,
+                              idx2,
+                              metric.Dim,
+                              metric.Label));
+        }
+        n_batch += buff_batch_h(idx1, idx2, 3) *
+                   ((idx1 < 6) ? h2 : h1);
+      }
+    }
+    errorIf(not cmp::AlmostEqual_host(n_batch, (real_t)2.0, epsilon * acc),
+            fmt::format("wrong batched n %.12e for %dD %s",
+                        n_batch,
+                        metric.Dim,
+                        metric.Label));
+
     const real_t gammaSQR_1 = ONE + v1[0] * v1[0] + v1[1] * v1[1] + v1[2] * v1[2];
     const real_t gammaSQR_2 = ONE + v2[0] * v2[0] + v2[1] * v2[1] + v2[2] * v2[2];
 
@@ -273,6 +343,16 @@ void testParticleMoments(const std::vector<std::size_t>&      res,
                         t00_expect,
                         metric.Dim,
                         metric.Label));
+    const std::vector<real_t> reduced { n, npart, rho, t00 };
+    for (auto r { 0u }; r < reduced.size(); ++r) {
+      errorIf(not cmp::AlmostEqual_host(reduced_batch(r), reduced[r], epsilon * acc),
+              fmt::format("wrong batched reduction #%d %.12e %.12e for %dD %s",
+                          r,
+                          reduced_batch(r),
+                          reduced[r],
+                          metric.Dim,
+                          metric.Label));
+    }
   }
 }
 
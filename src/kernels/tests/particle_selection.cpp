@@ -0,0 +1,172 @@
+#include "kernels/particle_selection.hpp"
+
+#include "enums.h"
+#include "global.h"
+
+#include "arch/kokkos_aliases.h"
+#include "utils/formatting.h"
+#include "utils/numeric.h"
+
+#include "metrics/minkowski.h"
+
+#include <Kokkos_Core.hpp>
+
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace ntt;
+using namespace metric;
+
+void errorIf(bool condition, const std::string& message) {
+  if (condition) {
+    throw std::runtime_error(message);
+  }
+}
+
+template <typename T>
+void put_value(array_t<T*>& arr, T v, index_t p) {
+  auto h = Kokkos::create_mirror_view(arr);
+  Kokkos::deep_copy(h, arr);
+  h(p) = v;
+  Kokkos::deep_copy(arr, h);
+}
+
+using M = Minkowski<Dim::_2D>;
+
+struct Particles {
+  const npart_t      npart = 10;
+  array_t<int*>      i1 { "i1", npart };
+  array_t<int*>      i2 { "i2", npart };
+  array_t<int*>      i3 { "i3", 0 };
+  array_t<prtldx_t*> dx1 { "dx1", npart };
+  array_t<prtldx_t*> dx2 { "dx2", npart };
+  array_t<prtldx_t*> dx3 { "dx3", 0 };
+  array_t<real_t*>   ux1 { "ux1", npart };
+  array_t<real_t*>   ux2 { "ux2", npart };
+  array_t<real_t*>   ux3 { "ux3", npart };
+  array_t<short*>    tag { "tag", npart };
+  array_t<npart_t**> pld_i { "pld_i", npart, 1 };
+};
+
+/**
+ * @brief Select the particles & check the compacted indices
+ */
+void checkSelection(const Particles&            prtls,
+                    const kernel::PrtlSelection& selection,
+                    bool                        use_tracking,
+                    const M&                    metric,
+                    const std::vector<npart_t>& expected,
+                    const std::string&          label) {
+  array_t<npart_t*> out_indices { "out_indices", prtls.npart };
+  npart_t           nout = 0;
+  // clang-format off
+  Kokkos::parallel_scan(
+    "SelectOutputParticles",
+    prtls.npart,
+    kernel::SelectPrtls_kernel<SimEngine::SRPIC, M>(selection, out_indices,
+                                                    prtls.i1, prtls.i2, prtls.i3,
+                                                    prtls.dx1, prtls.dx2, prtls.dx3,
+                                                    prtls.ux1, prtls.ux2, prtls.ux3,
+                                                    prtls.tag, prtls.pld_i,
+                                                    1.0f, use_tracking, metric),
+    nout);
+  // clang-format on
+  errorIf(nout != expected.size(),
+          fmt::format("%s: %d particles selected instead of %d",
+                      label.c_str(),
+                      nout,
+                      expected.size()));
+  auto out_indices_h = Kokkos::create_mirror_view(out_indices);
+  Kokkos::deep_copy(out_indices_h, out_indices);
+  for (auto i { 0u }; i < expected.size(); ++i) {
+    errorIf(out_indices_h(i) != expected[i],
+            fmt::format("%s: wrong index #%d: %d instead of %d",
+                        label.c_str(),
+                        i,
+                        out_indices_h(i),
+                        expected[i]));
+  }
+}
+
+void testParticleSelection() {
+  M metric {
+    { 10, 10 },
+    { { 0.0, 10.0 }, { 0.0, 10.0 } },
+    {}
+  };
+
+  Particles prtls;
+  // particle p: x1 = p + 0.5, x2 = 0.5, gamma - 1 = sqrt(1 + p^2) - 1
+  for (auto p { 0u }; p < prtls.npart; ++p) {
+    put_value<int>(prtls.i1, p, p);
+    put_value<prtldx_t>(prtls.dx1, (prtldx_t)(0.5), p);
+    put_value<prtldx_t>(prtls.dx2, (prtldx_t)(0.5), p);
+    put_value<real_t>(prtls.ux1, static_cast<real_t>(p), p);
+    put_value<short>(prtls.tag, ParticleTag::alive, p);
+  }
+  put_value<short>(prtls.tag, ParticleTag::dead, 6);
+  {
+    // counters in the reverse order
+    auto pld_i_h = Kokkos::create_mirror_view(prtls.pld_i);
+    for (auto p { 0u }; p < prtls.npart; ++p) {
+      pld_i_h(p, pldi::spcCtr) = prtls.npart - 1 - p;
+    }
+    Kokkos::deep_copy(prtls.pld_i, pld_i_h);
+  }
+
+  {
+    kernel::PrtlSelection selection;
+    selection.stride = 4;
+    checkSelection(prtls, selection, false, metric, { 0, 4, 8 }, "stride");
+    // counters 8, 4, 0
+    checkSelection(prtls, selection, true, metric, { 1, 5, 9 }, "stride (tracked)");
+  }
+  {
+    kernel::PrtlSelection selection;
+    selection.x_min[0] = 2.0;
+    selection.x_max[0] = 5.0;
+    checkSelection(prtls, selection, false, metric, { 2, 3, 4 }, "box");
+    // a box along x2 which contains everything
+    selection.x_min[1] = 0.0;
+    selection.x_max[1] = 1.0;
+    checkSelection(prtls, selection, false, metric, { 2, 3, 4 }, "box 2d");
+    selection.x_max[1] = 0.25;
+    checkSelection(prtls, selection, false, metric, {}, "empty box");
+  }
+  {
+    kernel::PrtlSelection selection;
+    selection.e_min = 3.0;
+    checkSelection(prtls, selection, false, metric, { 4, 5, 7, 8, 9 }, "e_min");
+    selection.e_max = 7.5;
+    checkSelection(prtls, selection, false, metric, { 4, 5, 7, 8 }, "e_min & e_max");
+  }
+  {
+    kernel::PrtlSelection selection;
+    selection.ctr_min = 2;
+    selection.ctr_max = 5;
+    // counters 2, 3, 4 -> particles 7, 6 (dead), 5
+    checkSelection(prtls, selection, true, metric, { 5, 7 }, "counter");
+    // ignored without tracking
+    checkSelection(prtls,
+                   selection,
+                   false,
+                   metric,
+                   { 0, 1, 2, 3, 4, 5, 7, 8, 9 },
+                   "counter (not tracked)");
+  }
+}
+
+auto main(int argc, char* argv[]) -> int {
+  Kokkos::initialize(argc, argv);
+  try {
+    testParticleSelection();
+  } catch (std::exception& e) {
+    std::cerr << e.what() << std::endl;
+    Kokkos::finalize();
+    return 1;
+  }
+  Kokkos::finalize();
+  return 0;
+}
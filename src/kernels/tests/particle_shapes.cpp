@@ -0,0 +1,74 @@
+#include "kernels/particle_shapes.hpp"
+
+#include "global.h"
+
+#include "arch/kokkos_aliases.h"
+#include "utils/numeric.h"
+
+#include <Kokkos_Core.hpp>
+
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+using namespace ntt;
+
+void errorIf(bool condition, const std::string& message) {
+  if (condition) {
+    throw std::runtime_error(message);
+  }
+}
+
+// every shape sums to one & preserves the position of the particle
+template <unsigned short O, bool Dual>
+void testShape() {
+  const int     npos        = 200;
+  unsigned long all_wrongs  = 0;
+  const auto    grid_offset = Dual ? HALF : ZERO;
+  Kokkos::parallel_reduce(
+    "check shape",
+    npos,
+    Lambda(index_t n, unsigned long& wrongs) {
+      const int    i  = 5 + static_cast<int>(n % 3);
+      const real_t dx = static_cast<real_t>(n) / static_cast<real_t>(npos);
+      int          i_min;
+      real_t       S[O + 1];
+      kernel::shape::order<O, Dual>(i, dx, i_min, S);
+      real_t sum { ZERO }, x { ZERO };
+      for (auto k { 0 }; k <= O; ++k) {
+        wrongs += (S[k] < ZERO) ? 1 : 0;
+        sum    += S[k];
+        x      += S[k] * (static_cast<real_t>(i_min + k) + grid_offset);
+      }
+      wrongs += (math::abs(sum - ONE) > (real_t)(1e-5)) ? 1 : 0;
+      if constexpr (O > 0) {
+        const auto x_p  = static_cast<real_t>(i) + dx;
+        wrongs         += (math::abs(x - x_p) > (real_t)(1e-4)) ? 1 : 0;
+      }
+    },
+    all_wrongs);
+  errorIf(all_wrongs != 0,
+          "shape of order " + std::to_string(O) + (Dual ? " (dual)" : "") +
+            " failed with " + std::to_string(all_wrongs) + " errors");
+}
+
+auto main(int argc, char* argv[]) -> int {
+  Kokkos::initialize(argc, argv);
+
+  try {
+    testShape<0, false>();
+    testShape<0, true>();
+    testShape<1, false>();
+    testShape<1, true>();
+    testShape<2, false>();
+    testShape<2, true>();
+    testShape<3, false>();
+    testShape<3, true>();
+  } catch (std::exception& e) {
+    std::cerr << e.what() << std::endl;
+    Kokkos::finalize();
+    return 1;
+  }
+  Kokkos::finalize();
+  return 0;
+}
@@ -243,6 +243,49 @@ void testPrtl2PhysSR(const std::vector<std::size_t>&      res,
                                   buff_ux3,
                                   buff_wei,
                                   buff_pld_i));
+
+  // packed rows: x1, x2, x3 (phi), ux1, ux2, ux3, weight & the counter
+  using packed_kernel_t = kernel::PrtlToPhysPacked_kernel<SimEngine::SRPIC, M>;
+  packed_array_t<real_t**>  buff_r { "buff_r",
+                                    packed_kernel_t::n_x + 4u,
+                                    nprtl / stride };
+  packed_array_t<npart_t**> buff_i { "buff_i", 1, nprtl / stride };
+  raise::ErrorIf(buff_r.extent(0) != 7, "Invalid number of packed rows", HERE);
+  Kokkos::parallel_for("Packed",
+                       nprtl / stride,
+                       packed_kernel_t(out_indices,
+                                       buff_r,
+                                       buff_i,
+                                       i1,
+                                       i2,
+                                       i3,
+                                       dx1,
+                                       dx2,
+                                       dx3,
+                                       ux1,
+                                       ux2,
+                                       ux3,
+                                       phi,
+                                       weight,
+                                       pldr,
+                                       pld_i,
+                                       metric));
+  Kokkos::parallel_for(
+    "CheckPacked",
+    nprtl / stride,
+    Lambda(index_t p) {
+      const real_t unpacked[7] = { buff_x1(p),  buff_x2(p),  buff_x3(p),
+                                   buff_ux1(p), buff_ux2(p), buff_ux3(p),
+                                   buff_wei(p) };
+      for (auto r { 0u }; r < 7; ++r) {
+        if (not cmp::AlmostEqual(buff_r(r, p), unpacked[r])) {
+          raise::KernelError(HERE, "buff_r != unpacked buffers");
+        }
+      }
+      if (buff_i(0, p) != buff_pld_i(p, pldi::spcCtr)) {
+        raise::KernelError(HERE, "buff_i != buff_pld_i");
+      }
+    });
 }
 
 auto main(int argc, char* argv[]) -> int {
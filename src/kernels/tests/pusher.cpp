@@ -94,24 +94,24 @@ void testPusher(const std::vector<std::size_t>& res) {
       emfield(i1, i2, i3, em::bx3) = bx3;
     });
 
-  array_t<int*>      i1 { "i1", 2 };
-  array_t<int*>      i2 { "i2", 2 };
-  array_t<int*>      i3 { "i3", 2 };
-  array_t<int*>      i1_prev { "i1_prev", 2 };
-  array_t<int*>      i2_prev { "i2_prev", 2 };
-  array_t<int*>      i3_prev { "i3_prev", 2 };
-  array_t<prtldx_t*> dx1 { "dx1", 2 };
-  array_t<prtldx_t*> dx2 { "dx2", 2 };
-  array_t<prtldx_t*> dx3 { "dx3", 2 };
-  array_t<prtldx_t*> dx1_prev { "dx1_prev", 2 };
-  array_t<prtldx_t*> dx2_prev { "dx2_prev", 2 };
-  array_t<prtldx_t*> dx3_prev { "dx3_prev", 2 };
-  array_t<real_t*>   ux1 { "ux1", 2 };
-  array_t<real_t*>   ux2 { "ux2", 2 };
-  array_t<real_t*>   ux3 { "ux3", 2 };
-  array_t<real_t*>   phi { "phi", 2 };
-  array_t<real_t*>   weight { "weight", 2 };
-  array_t<short*>    tag { "tag", 2 };
+  array_t<int*>      i1 { "i1", 6 };
+  array_t<int*>      i2 { "i2", 6 };
+  array_t<int*>      i3 { "i3", 6 };
+  array_t<int*>      i1_prev { "i1_prev", 6 };
+  array_t<int*>      i2_prev { "i2_prev", 6 };
+  array_t<int*>      i3_prev { "i3_prev", 6 };
+  array_t<prtldx_t*> dx1 { "dx1", 6 };
+  array_t<prtldx_t*> dx2 { "dx2", 6 };
+  array_t<prtldx_t*> dx3 { "dx3", 6 };
+  array_t<prtldx_t*> dx1_prev { "dx1_prev", 6 };
+  array_t<prtldx_t*> dx2_prev { "dx2_prev", 6 };
+  array_t<prtldx_t*> dx3_prev { "dx3_prev", 6 };
+  array_t<real_t*>   ux1 { "ux1", 6 };
+  array_t<real_t*>   ux2 { "ux2", 6 };
+  array_t<real_t*>   ux3 { "ux3", 6 };
+  array_t<real_t*>   phi { "phi", 6 };
+  array_t<real_t*>   weight { "weight", 6 };
+  array_t<short*>    tag { "tag", 6 };
 
   put_value<int>(i1, (int)(x1_0), 0);
   put_value<int>(i2, (int)(x2_0), 0);
@@ -135,6 +135,43 @@ void testPusher(const std::vector<std::size_t>& res) {
   put_value<real_t>(ux3, ux3_0, 1);
   put_value<short>(tag, ParticleTag::alive, 1);
 
+  // same as #1 & #2, pushed with the compile-time specialized kernels
+  put_value<int>(i1, (int)(x1_0), 2);
+  put_value<int>(i2, (int)(x2_0), 2);
+  put_value<int>(i3, (int)(x3_0), 2);
+  put_value<prtldx_t>(dx1, (prtldx_t)(x1_0 - (int)(x1_0)), 2);
+  put_value<prtldx_t>(dx2, (prtldx_t)(x2_0 - (int)(x2_0)), 2);
+  put_value<prtldx_t>(dx3, (prtldx_t)(x3_0 - (int)(x3_0)), 2);
+  put_value<real_t>(ux1, ux1_0, 2);
+  put_value<real_t>(ux2, ux2_0, 2);
+  put_value<real_t>(ux3, ux3_0, 2);
+  put_value<short>(tag, ParticleTag::alive, 2);
+
+  put_value<int>(i1, (int)(x1_0), 3);
+  put_value<int>(i2, (int)(x2_0), 3);
+  put_value<int>(i3, (int)(x3_0), 3);
+  put_value<prtldx_t>(dx1, (prtldx_t)(x1_0 - (int)(x1_0)), 3);
+  put_value<prtldx_t>(dx2, (prtldx_t)(x2_0 - (int)(x2_0)), 3);
+  put_value<prtldx_t>(dx3, (prtldx_t)(x3_0 - (int)(x3_0)), 3);
+  put_value<real_t>(ux1, ux1_0, 3);
+  put_value<real_t>(ux2, ux2_0, 3);
+  put_value<real_t>(ux3, ux3_0, 3);
+  put_value<short>(tag, ParticleTag::alive, 3);
+
+  // same as #1 & #2, pushed with the chunked (vectorized) path
+  for (auto p { 4u }; p < 6u; ++p) {
+    put_value<int>(i1, (int)(x1_0), p);
+    put_value<int>(i2, (int)(x2_0), p);
+    put_value<int>(i3, (int)(x3_0), p);
+    put_value<prtldx_t>(dx1, (prtldx_t)(x1_0 - (int)(x1_0)), p);
+    put_value<prtldx_t>(dx2, (prtldx_t)(x2_0 - (int)(x2_0)), p);
+    put_value<prtldx_t>(dx3, (prtldx_t)(x3_0 - (int)(x3_0)), p);
+    put_value<real_t>(ux1, ux1_0, p);
+    put_value<real_t>(ux2, ux2_0, p);
+    put_value<real_t>(ux3, ux3_0, p);
+    put_value<short>(tag, ParticleTag::alive, p);
+  }
+
   // Particle boundaries
   auto boundaries = boundaries_t<PrtlBC> {};
   boundaries      = {
@@ -196,6 +233,95 @@ void testPusher(const std::vector<std::size_t>& res) {
                                                      boundaries,
                                                      ZERO, ZERO, ZERO, ZERO));
 
+    using boris_t = kernel::sr::Pusher_kernel<Minkowski<Dim::_3D>,
+                                              kernel::sr::NoForce_t,
+                                              PrtlPusher::BORIS,
+                                              false,
+                                              kernel::sr::Cooling::None>;
+    using vay_t   = kernel::sr::Pusher_kernel<Minkowski<Dim::_3D>,
+                                              kernel::sr::NoForce_t,
+                                              PrtlPusher::VAY,
+                                              false,
+                                              kernel::sr::Cooling::None>;
+    // clang-format off
+    Kokkos::parallel_for(
+      "pusher",
+      CreateRangePolicy<Dim::_1D>({2}, {3}),
+      boris_t(PrtlPusher::BORIS,
+              false, false, kernel::sr::Cooling::None,
+              emfield,
+              sp,
+              i1, i2, i3,
+              i1_prev, i2_prev, i3_prev,
+              dx1, dx2, dx3,
+              dx1_prev, dx2_prev, dx3_prev,
+              ux1, ux2, ux3,
+              phi, tag,
+              metric,
+              ZERO, coeff, dt,
+              nx1, nx2, nx3,
+              boundaries,
+              ZERO, ZERO, ZERO, ZERO));
+
+    Kokkos::parallel_for(
+      "pusher",
+      CreateRangePolicy<Dim::_1D>({3}, {4}),
+      vay_t(PrtlPusher::VAY,
+            false, false, kernel::sr::Cooling::None,
+            emfield,
+            sp,
+            i1, i2, i3,
+            i1_prev, i2_prev, i3_prev,
+            dx1, dx2, dx3,
+            dx1_prev, dx2_prev, dx3_prev,
+            ux1, ux2, ux3,
+            phi, tag,
+            metric,
+            ZERO, coeff, dt,
+            nx1, nx2, nx3,
+            boundaries,
+            ZERO, ZERO, ZERO, ZERO));
+
+    // single-particle chunks (the rest of the lanes are masked out)
+    const auto boris_chunked = boris_t(PrtlPusher::BORIS,
+                                       false, false, kernel::sr::Cooling::None,
+                                       emfield,
+                                       sp,
+                                       i1, i2, i3,
+                                       i1_prev, i2_prev, i3_prev,
+                                       dx1, dx2, dx3,
+                                       dx1_prev, dx2_prev, dx3_prev,
+                                       ux1, ux2, ux3,
+                                       phi, tag,
+                                       metric,
+                                       ZERO, coeff, dt,
+                                       nx1, nx2, nx3,
+                                       boundaries,
+                                       ZERO, ZERO, ZERO, ZERO);
+    const auto vay_chunked = vay_t(PrtlPusher::VAY,
+                                   false, false, kernel::sr::Cooling::None,
+                                   emfield,
+                                   sp,
+                                   i1, i2, i3,
+                                   i1_prev, i2_prev, i3_prev,
+                                   dx1, dx2, dx3,
+                                   dx1_prev, dx2_prev, dx3_prev,
+                                   ux1, ux2, ux3,
+                                   phi, tag,
+                                   metric,
+                                   ZERO, coeff, dt,
+                                   nx1, nx2, nx3,
+                                   boundaries,
+                                   ZERO, ZERO, ZERO, ZERO);
+    Kokkos::parallel_for(
+      "pusher chunked",
+      CreateRangePolicy<Dim::_1D>({0}, {1}),
+      Lambda(index_t) {
+        boris_chunked.pushChunk(4, 5);
+        vay_chunked.pushChunk(5, 6);
+      });
+    // clang-format on
+
     auto i1_prev_ = Kokkos::create_mirror_view(i1_prev);
     auto i2_prev_ = Kokkos::create_mirror_view(i2_prev);
     auto i3_prev_ = Kokkos::create_mirror_view(i3_prev);
@@ -253,6 +379,411 @@ void testPusher(const std::vector<std::size_t>& res) {
     check_value(t, ux2_(1), ux2_expect, eps, "Particle #2 ux2");
     check_value(t, ux3_(1), ux3_expect, eps, "Particle #2 ux3");
 
+    // specialized kernels follow the same path as the generic ones
+    for (auto p { 2u }; p < 4u; ++p) {
+      check_value(t, ux1_(p), ux1_(p - 2), eps, "Specialized pusher ux1");
+      check_value(t, ux2_(p), ux2_(p - 2), eps, "Specialized pusher ux2");
+      check_value(t, ux3_(p), ux3_(p - 2), eps, "Specialized pusher ux3");
+    }
+
+    // so does the chunked path
+    for (auto p { 4u }; p < 6u; ++p) {
+      check_value(t, ux1_(p), ux1_(p - 4), eps, "Chunked pusher ux1");
+      check_value(t, ux2_(p), ux2_(p - 4), eps, "Chunked pusher ux2");
+      check_value(t, ux3_(p), ux3_(p - 4), eps, "Chunked pusher ux3");
+      check_value(t,
+                  (real_t)(i1_(p)) + (real_t)(dx1_(p)),
+                  (real_t)(i1_(p - 4)) + (real_t)(dx1_(p - 4)),
+                  eps,
+                  "Chunked pusher x1");
+    }
+
+  }
+}
+
+/*
+ * a full chunk & a partial one are pushed with `PusherChunked_kernel` in a
+ * non-uniform field, while a copy of the same particles is pushed with the
+ * scalar `operator()`; lanes include a dead particle, a particle leaving
+ * through the absorbing x1 boundary & a slow one pushed with the GCA
+ */
+void testChunkedPusher(const std::vector<std::size_t>& res) {
+  using namespace kernel::sr;
+  using pusher_t = Pusher_kernel<Minkowski<Dim::_3D>,
+                                 NoForce_t,
+                                 PrtlPusher::BORIS,
+                                 true,
+                                 Cooling::None>;
+  static_assert(pusher_t::Vectorized);
+  raise::ErrorIf(res.size() != 3, "res.size() != 3", HERE);
+
+  Minkowski<Dim::_3D> metric {
+    res,
+    { { 0.0, (real_t)(res[0]) }, { 0.0, (real_t)(res[1]) }, { 0.0, (real_t)(res[2]) } },
+    {}
+  };
+
+  const int nx1 = res[0];
+  const int nx2 = res[1];
+  const int nx3 = res[2];
+
+  auto emfield   = ndfield_t<Dim::_3D, 6> { "emfield",
+                                          res[0] + 2 * N_GHOSTS,
+                                          res[1] + 2 * N_GHOSTS,
+                                          res[2] + 2 * N_GHOSTS };
+  auto emfield_h = Kokkos::create_mirror_view(emfield);
+  for (auto i1 { 0u }; i1 < emfield.extent(0); ++i1) {
+    for (auto i2 { 0u }; i2 < emfield.extent(1); ++i2) {
+      for (auto i3 { 0u }; i3 < emfield.extent(2); ++i3) {
+        const auto x1 = (real_t)(i1) - (real_t)(N_GHOSTS);
+        const auto x2 = (real_t)(i2) - (real_t)(N_GHOSTS);
+        const auto x3 = (real_t)(i3) - (real_t)(N_GHOSTS);
+        emfield_h(i1, i2, i3, em::ex1) = 0.05 + 0.005 * x2 - 0.003 * x3;
+        emfield_h(i1, i2, i3, em::ex2) = -0.04 + 0.004 * x1;
+        emfield_h(i1, i2, i3, em::ex3) = 0.03 * math::sin(0.4 * x1 + 0.2 * x2);
+        emfield_h(i1, i2, i3, em::bx1) = 0.1 * math::sin(0.3 * x3);
+        emfield_h(i1, i2, i3, em::bx2) = 0.1 + 0.01 * x2;
+        emfield_h(i1, i2, i3, em::bx3) = 1.0 + 0.02 * x1 + 0.01 * x2;
+      }
+    }
+  }
+  Kokkos::deep_copy(emfield, emfield_h);
+
+  // particles `0 ... npart - 1` are pushed in chunks, `npart ... 2 npart - 1`
+  // are their copies pushed one by one
+  const npart_t npart   = ChunkWidth + 5;
+  const npart_t nchunks = (npart + ChunkWidth - 1) / ChunkWidth;
+  const npart_t p_dead  = 3;
+  const npart_t p_gca   = 1;
+  const npart_t p_leave = ChunkWidth + 2;
+
+  array_t<int*>      i1 { "i1", 2 * npart };
+  array_t<int*>      i2 { "i2", 2 * npart };
+  array_t<int*>      i3 { "i3", 2 * npart };
+  array_t<int*>      i1_prev { "i1_prev", 2 * npart };
+  array_t<int*>      i2_prev { "i2_prev", 2 * npart };
+  array_t<int*>      i3_prev { "i3_prev", 2 * npart };
+  array_t<prtldx_t*> dx1 { "dx1", 2 * npart };
+  array_t<prtldx_t*> dx2 { "dx2", 2 * npart };
+  array_t<prtldx_t*> dx3 { "dx3", 2 * npart };
+  array_t<prtldx_t*> dx1_prev { "dx1_prev", 2 * npart };
+  array_t<prtldx_t*> dx2_prev { "dx2_prev", 2 * npart };
+  array_t<prtldx_t*> dx3_prev { "dx3_prev", 2 * npart };
+  array_t<real_t*>   ux1 { "ux1", 2 * npart };
+  array_t<real_t*>   ux2 { "ux2", 2 * npart };
+  array_t<real_t*>   ux3 { "ux3", 2 * npart };
+  array_t<real_t*>   phi { "phi", 2 * npart };
+  array_t<short*>    tag { "tag", 2 * npart };
+
+  auto i1_h  = Kokkos::create_mirror_view(i1);
+  auto i2_h  = Kokkos::create_mirror_view(i2);
+  auto i3_h  = Kokkos::create_mirror_view(i3);
+  auto dx1_h = Kokkos::create_mirror_view(dx1);
+  auto dx2_h = Kokkos::create_mirror_view(dx2);
+  auto dx3_h = Kokkos::create_mirror_view(dx3);
+  auto ux1_h = Kokkos::create_mirror_view(ux1);
+  auto ux2_h = Kokkos::create_mirror_view(ux2);
+  auto ux3_h = Kokkos::create_mirror_view(ux3);
+  auto tag_h = Kokkos::create_mirror_view(tag);
+  for (auto p { 0u }; p < npart; ++p) {
+    const auto ip = static_cast<int>(p);
+    const auto rp = static_cast<real_t>(p);
+    i1_h(p)       = 1 + (3 * ip) % (nx1 - 2);
+    i2_h(p)       = (5 * ip) % nx2;
+    i3_h(p)       = (7 * ip) % nx3;
+    dx1_h(p)      = (prtldx_t)(0.1 + 0.8 * math::abs(math::sin(1.3 * rp)));
+    dx2_h(p)      = (prtldx_t)(0.1 + 0.8 * math::abs(math::cos(0.7 * rp)));
+    dx3_h(p)      = (prtldx_t)(0.1 + 0.8 * math::abs(math::sin(2.1 * rp)));
+    ux1_h(p)      = 2.0 + 0.3 * math::sin(rp);
+    ux2_h(p)      = -1.5 + 0.2 * math::cos(rp);
+    ux3_h(p)      = 1.0 - 0.1 * rp;
+    tag_h(p)      = ParticleTag::alive;
+  }
+  tag_h(p_dead) = ParticleTag::dead;
+  // larmor radius well below `gca_larmor_max`
+  i1_h(p_gca)   = nx1 / 2;
+  ux1_h(p_gca)  = 0.05;
+  ux2_h(p_gca)  = 0.02;
+  ux3_h(p_gca)  = -0.01;
+  // crosses the x1 boundary within the step
+  i1_h(p_leave)  = nx1 - 1;
+  dx1_h(p_leave) = (prtldx_t)(0.95);
+  ux1_h(p_leave) = 5.0;
+  ux2_h(p_leave) = ZERO;
+  ux3_h(p_leave) = ZERO;
+  for (auto p { 0u }; p < npart; ++p) {
+    i1_h(p + npart)  = i1_h(p);
+    i2_h(p + npart)  = i2_h(p);
+    i3_h(p + npart)  = i3_h(p);
+    dx1_h(p + npart) = dx1_h(p);
+    dx2_h(p + npart) = dx2_h(p);
+    dx3_h(p + npart) = dx3_h(p);
+    ux1_h(p + npart) = ux1_h(p);
+    ux2_h(p + npart) = ux2_h(p);
+    ux3_h(p + npart) = ux3_h(p);
+    tag_h(p + npart) = tag_h(p);
+  }
+  Kokkos::deep_copy(i1, i1_h);
+  Kokkos::deep_copy(i2, i2_h);
+  Kokkos::deep_copy(i3, i3_h);
+  Kokkos::deep_copy(dx1, dx1_h);
+  Kokkos::deep_copy(dx2, dx2_h);
+  Kokkos::deep_copy(dx3, dx3_h);
+  Kokkos::deep_copy(ux1, ux1_h);
+  Kokkos::deep_copy(ux2, ux2_h);
+  Kokkos::deep_copy(ux3, ux3_h);
+  Kokkos::deep_copy(tag, tag_h);
+
+  auto boundaries = boundaries_t<PrtlBC> {};
+  boundaries      = {
+    { PrtlBC::ABSORB, PrtlBC::ABSORB },
+    { PrtlBC::PERIODIC, PrtlBC::PERIODIC },
+    { PrtlBC::PERIODIC, PrtlBC::PERIODIC }
+  };
+
+  const spidx_t sp { 1u };
+  const real_t  dt    = 0.1;
+  const real_t  coeff = HALF * dt;
+
+  // clang-format off
+  const auto pusher = pusher_t(PrtlPusher::BORIS,
+                               true, false, Cooling::None,
+                               emfield,
+                               sp,
+                               i1, i2, i3,
+                               i1_prev, i2_prev, i3_prev,
+                               dx1, dx2, dx3,
+                               dx1_prev, dx2_prev, dx3_prev,
+                               ux1, ux2, ux3,
+                               phi, tag,
+                               metric,
+                               ZERO, coeff, dt,
+                               nx1, nx2, nx3,
+                               boundaries,
+                               (real_t)(1.2), (real_t)(0.5), ZERO, ZERO);
+  // clang-format on
+
+  const auto ux1_dead = ux1_h(p_dead);
+  Kokkos::parallel_for("pusher chunked",
+                       CreateParticleRangePolicy(0u, nchunks),
+                       PusherChunked_kernel<pusher_t>(pusher, npart));
+  Kokkos::parallel_for("pusher",
+                       CreateParticleRangePolicy(npart, 2 * npart),
+                       pusher);
+
+  auto i1_prev_h  = Kokkos::create_mirror_view(i1_prev);
+  auto i2_prev_h  = Kokkos::create_mirror_view(i2_prev);
+  auto i3_prev_h  = Kokkos::create_mirror_view(i3_prev);
+  auto dx1_prev_h = Kokkos::create_mirror_view(dx1_prev);
+  auto dx2_prev_h = Kokkos::create_mirror_view(dx2_prev);
+  auto dx3_prev_h = Kokkos::create_mirror_view(dx3_prev);
+  Kokkos::deep_copy(i1_h, i1);
+  Kokkos::deep_copy(i2_h, i2);
+  Kokkos::deep_copy(i3_h, i3);
+  Kokkos::deep_copy(dx1_h, dx1);
+  Kokkos::deep_copy(dx2_h, dx2);
+  Kokkos::deep_copy(dx3_h, dx3);
+  Kokkos::deep_copy(ux1_h, ux1);
+  Kokkos::deep_copy(ux2_h, ux2);
+  Kokkos::deep_copy(ux3_h, ux3);
+  Kokkos::deep_copy(tag_h, tag);
+  Kokkos::deep_copy(i1_prev_h, i1_prev);
+  Kokkos::deep_copy(i2_prev_h, i2_prev);
+  Kokkos::deep_copy(i3_prev_h, i3_prev);
+  Kokkos::deep_copy(dx1_prev_h, dx1_prev);
+  Kokkos::deep_copy(dx2_prev_h, dx2_prev);
+  Kokkos::deep_copy(dx3_prev_h, dx3_prev);
+
+  const real_t eps = std::is_same_v<real_t, float> ? 1e-5 : 1e-10;
+
+  raise::ErrorIf(tag_h(p_dead) != ParticleTag::dead or
+                   ux1_h(p_dead) != ux1_dead,
+                 "Chunked pusher: dead lane was pushed",
+                 HERE);
+  raise::ErrorIf(tag_h(p_leave) == ParticleTag::alive,
+                 "Chunked pusher: leaving lane was not absorbed",
+                 HERE);
+  for (auto p { 0u }; p < npart; ++p) {
+    const auto q = p + npart;
+    raise::ErrorIf(tag_h(p) != tag_h(q),
+                   fmt::format("Chunked pusher: tag mismatch @ %u", p),
+                   HERE);
+    if (tag_h(p) != ParticleTag::alive) {
+      continue;
+    }
+    raise::ErrorIf((i1_h(p) != i1_h(q)) or (i2_h(p) != i2_h(q)) or
+                     (i3_h(p) != i3_h(q)) or (i1_prev_h(p) != i1_prev_h(q)) or
+                     (i2_prev_h(p) != i2_prev_h(q)) or
+                     (i3_prev_h(p) != i3_prev_h(q)),
+                   fmt::format("Chunked pusher: cell mismatch @ %u", p),
+                   HERE);
+    check_value(p, dx1_h(q), dx1_h(p), eps, "Chunked pusher dx1");
+    check_value(p, dx2_h(q), dx2_h(p), eps, "Chunked pusher dx2");
+    check_value(p, dx3_h(q), dx3_h(p), eps, "Chunked pusher dx3");
+    check_value(p,
+                dx1_prev_h(q),
+                dx1_prev_h(p),
+                eps,
+                "Chunked pusher dx1_prev");
+    check_value(p,
+                dx2_prev_h(q),
+                dx2_prev_h(p),
+                eps,
+                "Chunked pusher dx2_prev");
+    check_value(p,
+                dx3_prev_h(q),
+                dx3_prev_h(p),
+                eps,
+                "Chunked pusher dx3_prev");
+    check_value(p, ux1_h(q), ux1_h(p), eps, "Chunked pusher ux1");
+    check_value(p, ux2_h(q), ux2_h(p), eps, "Chunked pusher ux2");
+    check_value(p, ux3_h(q), ux3_h(p), eps, "Chunked pusher ux3");
+  }
+}
+
+/*
+ * the staggered gather with the particle shape of order `O` reproduces a
+ * field which is linear in the coordinates exactly
+ */
+template <unsigned short O>
+void testShapedGather(const std::vector<std::size_t>& res) {
+  using namespace kernel::sr;
+  using pusher_t = Pusher_kernel<Minkowski<Dim::_3D>,
+                                 NoForce_t,
+                                 PrtlPusher::BORIS,
+                                 false,
+                                 Cooling::None,
+                                 O>;
+  raise::ErrorIf(res.size() != 3, "res.size() != 3", HERE);
+
+  Minkowski<Dim::_3D> metric {
+    res,
+    { { 0.0, (real_t)(res[0]) }, { 0.0, (real_t)(res[1]) }, { 0.0, (real_t)(res[2]) } },
+    {}
+  };
+
+  // staggering of ex1, ex2, ex3, bx1, bx2, bx3 (along each direction)
+  const real_t stag[6][3] = {
+    { HALF, ZERO, ZERO },
+    { ZERO, HALF, ZERO },
+    { ZERO, ZERO, HALF },
+    { ZERO, HALF, HALF },
+    { HALF, ZERO, HALF },
+    { HALF, HALF, ZERO }
+  };
+  // value of the component `c` at a given position
+  const auto linear = [](unsigned short c, const real_t (&x)[3]) -> real_t {
+    const auto rc = static_cast<real_t>(c);
+    return (real_t)(0.1) * rc - (real_t)(0.3) +
+           (real_t)(0.02) * (rc + ONE) * x[0] -
+           (real_t)(0.03) * (TWO - rc) * x[1] +
+           (real_t)(0.015) * (rc * rc - THREE) * x[2];
+  };
+
+  auto emfield   = ndfield_t<Dim::_3D, 6> { "emfield",
+                                          res[0] + 2 * N_GHOSTS,
+                                          res[1] + 2 * N_GHOSTS,
+                                          res[2] + 2 * N_GHOSTS };
+  auto emfield_h = Kokkos::create_mirror_view(emfield);
+  for (auto i1 { 0u }; i1 < emfield.extent(0); ++i1) {
+    for (auto i2 { 0u }; i2 < emfield.extent(1); ++i2) {
+      for (auto i3 { 0u }; i3 < emfield.extent(2); ++i3) {
+        for (auto c { 0u }; c < 6; ++c) {
+          const real_t x[3] { (real_t)(i1) - (real_t)(N_GHOSTS) + stag[c][0],
+                              (real_t)(i2) - (real_t)(N_GHOSTS) + stag[c][1],
+                              (real_t)(i3) - (real_t)(N_GHOSTS) + stag[c][2] };
+          emfield_h(i1, i2, i3, c) = linear(c, x);
+        }
+      }
+    }
+  }
+  Kokkos::deep_copy(emfield, emfield_h);
+
+  // positions on either side of the cell centers & close to the edges
+  const std::vector<std::vector<real_t>> positions {
+    { 3.0, 4.5, 5.25 },
+    { 4.1, 5.9, 3.49 },
+    { 6.51, 3.02, 6.98 },
+    { 5.75, 6.25, 4.0 },
+    { 3.33, 4.67, 5.5 }
+  };
+  const npart_t      npos = positions.size();
+  array_t<int*>      i { "i", npos * 3 };
+  array_t<real_t*>   dx { "dx", npos * 3 };
+  array_t<real_t**>  flds { "flds", npos, 6 };
+  auto               i_h  = Kokkos::create_mirror_view(i);
+  auto               dx_h = Kokkos::create_mirror_view(dx);
+  for (auto n { 0u }; n < npos; ++n) {
+    for (auto d { 0u }; d < 3; ++d) {
+      i_h(3 * n + d)  = static_cast<int>(math::floor(positions[n][d]));
+      dx_h(3 * n + d) = positions[n][d] - static_cast<real_t>(i_h(3 * n + d));
+    }
+  }
+  Kokkos::deep_copy(i, i_h);
+  Kokkos::deep_copy(dx, dx_h);
+
+  array_t<int*>      i1 { "i1", 1 }, i2 { "i2", 1 }, i3 { "i3", 1 };
+  array_t<int*>      i1_prev { "i1_prev", 1 }, i2_prev { "i2_prev", 1 },
+    i3_prev { "i3_prev", 1 };
+  array_t<prtldx_t*> dx1 { "dx1", 1 }, dx2 { "dx2", 1 }, dx3 { "dx3", 1 };
+  array_t<prtldx_t*> dx1_prev { "dx1_prev", 1 }, dx2_prev { "dx2_prev", 1 },
+    dx3_prev { "dx3_prev", 1 };
+  array_t<real_t*>   ux1 { "ux1", 1 }, ux2 { "ux2", 1 }, ux3 { "ux3", 1 };
+  array_t<real_t*>   phi { "phi", 1 };
+  array_t<short*>    tag { "tag", 1 };
+
+  auto boundaries = boundaries_t<PrtlBC> {};
+  boundaries      = {
+    { PrtlBC::PERIODIC, PrtlBC::PERIODIC },
+    { PrtlBC::PERIODIC, PrtlBC::PERIODIC },
+    { PrtlBC::PERIODIC, PrtlBC::PERIODIC }
+  };
+
+  // clang-format off
+  const auto pusher = pusher_t(PrtlPusher::BORIS,
+                               false, false, Cooling::None,
+                               emfield,
+                               1u,
+                               i1, i2, i3,
+                               i1_prev, i2_prev, i3_prev,
+                               dx1, dx2, dx3,
+                               dx1_prev, dx2_prev, dx3_prev,
+                               ux1, ux2, ux3,
+                               phi, tag,
+                               metric,
+                               ZERO, ONE, ONE,
+                               (int)(res[0]), (int)(res[1]), (int)(res[2]),
+                               boundaries,
+                               ZERO, ZERO, ZERO, ZERO);
+  // clang-format on
+  Kokkos::parallel_for(
+    "ShapedGather",
+    npos,
+    Lambda(index_t n) {
+      const int    i_[3] { i(3 * n), i(3 * n + 1), i(3 * n + 2) };
+      const real_t dx_[3] { dx(3 * n), dx(3 * n + 1), dx(3 * n + 2) };
+      vec_t<Dim::_3D> e0 { ZERO }, b0 { ZERO };
+      pusher.getShapedFlds(i_, dx_, e0, b0);
+      for (auto c { 0u }; c < 3; ++c) {
+        flds(n, c)     = e0[c];
+        flds(n, c + 3) = b0[c];
+      }
+    });
+
+  auto flds_h = Kokkos::create_mirror_view(flds);
+  Kokkos::deep_copy(flds_h, flds);
+  const real_t eps = std::is_same_v<real_t, float> ? 1e-5 : 1e-10;
+  for (auto n { 0u }; n < npos; ++n) {
+    const real_t x[3] { positions[n][0], positions[n][1], positions[n][2] };
+    for (auto c { 0u }; c < 6; ++c) {
+      check_value(n,
+                  linear(c, x),
+                  flds_h(n, c),
+                  eps,
+                  fmt::format("Shaped gather (O = %d) of component %u",
+                              O,
+                              c));
+    }
   }
 }
 
@@ -263,6 +794,10 @@ auto main(int argc, char* argv[]) -> int {
     using namespace ntt;
 
     testPusher<SimEngine::SRPIC, Minkowski<Dim::_3D>>({ 10, 10, 10 });
+    testChunkedPusher({ 10, 10, 10 });
+    testShapedGather<1>({ 10, 10, 10 });
+    testShapedGather<2>({ 10, 10, 10 });
+    testShapedGather<3>({ 10, 10, 10 });
 
   } catch (std::exception& e) {
     std::cerr << e.what() << std::endl;
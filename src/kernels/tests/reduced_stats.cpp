@@ -9,7 +9,9 @@
 #include "metrics/minkowski.h"
 
 #include <iostream>
+#include <string>
 #include <utility>
+#include <vector>
 
 using namespace ntt;
 using namespace metric;
@@ -276,6 +278,35 @@ void testReducedStats(const std::vector<std::size_t>& res,
                    "JdotE does not match expected value",
                    HERE);
   }
+
+  {
+    // all the stats reduced in a single sweep
+    const std::vector<kernel::StatSpec> specs {
+      {  StatsID::E2, 1, 0 },
+      {  StatsID::E2, 2, 0 },
+      {  StatsID::E2, 3, 0 },
+      {  StatsID::B2, 1, 0 },
+      {  StatsID::B2, 2, 0 },
+      {  StatsID::B2, 3, 0 },
+      { StatsID::ExB, 1, 0 },
+      { StatsID::ExB, 2, 0 },
+      { StatsID::ExB, 3, 0 },
+      { StatsID::JdotE, 0, 0 }
+    };
+    const std::vector<real_t> expected { 1, 4, 9, 1, 4, 9, 12, -6, 0, 11 };
+    array_h_t<real_t*> buff { "buff", specs.size() };
+    Kokkos::parallel_reduce(
+      "ReduceFieldsBatch",
+      cell_range,
+      kernel::ReducedFieldsBatch_kernel<S, M>(specs, EM, J, metric),
+      buff);
+    for (auto n { 0u }; n < specs.size(); ++n) {
+      raise::ErrorIf(
+        not almost_equal(buff(n) / metric.totVolume(), expected[n], acc),
+        "batched stat #" + std::to_string(n) + " does not match expected value",
+        HERE);
+    }
+  }
 }
 
 auto main(int argc, char* argv[]) -> int {
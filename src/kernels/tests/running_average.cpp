@@ -0,0 +1,157 @@
+#include "enums.h"
+#include "global.h"
+
+#include "arch/kokkos_aliases.h"
+
+#include "framework/containers/species.h"
+#include "kernels/utils.hpp"
+
+#include <Kokkos_Core.hpp>
+
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace ntt;
+
+void errorIf(bool condition, const std::string& message) {
+  if (condition) {
+    throw std::runtime_error(message);
+  }
+}
+
+auto equal(real_t a, real_t b, const std::string& msg, real_t acc) -> bool {
+  if (not(math::abs(a - b) < acc)) {
+    std::cerr << a << " != " << b << " [" << math::abs(a - b) << "] " << msg
+              << std::endl;
+    return false;
+  }
+  return true;
+}
+
+// value of the field at a given (flattened) index & timestep
+auto value(std::size_t k, timestep_t step) -> real_t {
+  return static_cast<real_t>((7 * k + 3 * step * step) % 17) - (real_t)(8.0) +
+         HALF * static_cast<real_t>(step);
+}
+
+template <Dimension D>
+auto allocate(const std::string& name, const std::vector<std::size_t>& res)
+  -> ndfield_t<D, 6> {
+  if constexpr (D == Dim::_1D) {
+    return ndfield_t<D, 6> { name, res[0] + 2 * N_GHOSTS };
+  } else if constexpr (D == Dim::_2D) {
+    return ndfield_t<D, 6> { name,
+                             res[0] + 2 * N_GHOSTS,
+                             res[1] + 2 * N_GHOSTS };
+  } else {
+    return ndfield_t<D, 6> { name,
+                             res[0] + 2 * N_GHOSTS,
+                             res[1] + 2 * N_GHOSTS,
+                             res[2] + 2 * N_GHOSTS };
+  }
+}
+
+/*
+ * emulates the engine: the fields are averaged every step & the sub-cycled
+ * species is pushed (with the averaged fields) on the last step of the cycle
+ */
+template <Dimension D>
+void testRunningAverage(const std::vector<std::size_t>& res,
+                        unsigned short                  nsub) {
+  errorIf(res.size() != (std::size_t)D, "res.size() != D");
+  auto       fld     = allocate<D>("fld", res);
+  auto       fld_avg = allocate<D>("fld_avg", res);
+  auto       fld_h   = Kokkos::create_mirror_view(fld);
+  auto       avg_h   = Kokkos::create_mirror_view(fld_avg);
+  const auto nvals   = fld.span();
+
+  tuple_t<ncells_t, D> range_min { 0 };
+  tuple_t<ncells_t, D> range_max { 0 };
+  for (auto d { 0u }; d < (unsigned int)D; ++d) {
+    range_max[d] = fld.extent(d);
+  }
+  const auto range = CreateRangePolicy<D>(range_min, range_max);
+
+  // garbage in the average before the first cycle
+  Kokkos::deep_copy(fld_avg, (real_t)(1e3));
+
+  const auto species = ParticleSpecies(1,
+                                       "sp",
+                                       1.0,
+                                       1.0,
+                                       0,
+                                       PrtlPusher::BORIS,
+                                       false,
+                                       false,
+                                       Cooling::NONE,
+                                       0,
+                                       0,
+                                       true,
+                                       nsub);
+  errorIf(species.subcycle() != nsub, "subcycle not stored");
+
+  std::size_t npushes = 0;
+  for (timestep_t step { 0 }; step < 3 * nsub; ++step) {
+    for (std::size_t k { 0 }; k < nvals; ++k) {
+      fld_h.data()[k] = value(k, step);
+    }
+    Kokkos::deep_copy(fld, fld_h);
+    const auto n = static_cast<unsigned short>(step % nsub + 1);
+    Kokkos::parallel_for("RunningAverage",
+                         range,
+                         kernel::RunningAverage_kernel<D, 6>(fld, fld_avg, n));
+    Kokkos::deep_copy(avg_h, fld_avg);
+
+    if (n == 1) {
+      // the first step of a cycle overwrites the previous average
+      for (std::size_t k { 0 }; k < nvals; ++k) {
+        errorIf(avg_h.data()[k] != fld_h.data()[k],
+                "n = 1 does not overwrite the average at " + std::to_string(k));
+      }
+    }
+
+    errorIf(species.pushed_at(step) != (n == nsub),
+            "species pushed at the wrong step " + std::to_string(step));
+    if (species.pushed_at(step)) {
+      ++npushes;
+      // the average covers exactly the steps of the current cycle
+      const auto    cycle_start = step + 1 - nsub;
+      unsigned long wrongs      = 0;
+      for (std::size_t k { 0 }; k < nvals; ++k) {
+        real_t mean = ZERO;
+        for (auto s { cycle_start }; s <= step; ++s) {
+          mean += value(k, s);
+        }
+        mean /= static_cast<real_t>(nsub);
+        wrongs += not equal(avg_h.data()[k],
+                            mean,
+                            "average at " + std::to_string(k),
+                            (real_t)(1e-4));
+      }
+      errorIf(wrongs != 0,
+              "running average failed with " + std::to_string(wrongs) +
+                " errors");
+    }
+  }
+  errorIf(npushes != 3, "species pushed " + std::to_string(npushes) + " times");
+}
+
+auto main(int argc, char* argv[]) -> int {
+  Kokkos::initialize(argc, argv);
+
+  try {
+    testRunningAverage<Dim::_1D>({ 32 }, 1);
+    testRunningAverage<Dim::_1D>({ 32 }, 3);
+    testRunningAverage<Dim::_2D>({ 16, 12 }, 2);
+    testRunningAverage<Dim::_2D>({ 16, 12 }, 5);
+    testRunningAverage<Dim::_3D>({ 8, 10, 6 }, 4);
+  } catch (std::exception& e) {
+    std::cerr << e.what() << std::endl;
+    Kokkos::finalize();
+    return 1;
+  }
+  Kokkos::finalize();
+  return 0;
+}
@@ -3,6 +3,7 @@
  * @brief Commonly used generic kernels
  * @implements
  *   - kernel::ComputeSum_kernel<>
+ *   - kernel::RunningAverage_kernel<>
  *   - kernel::ComputeDivergence_kernel<>
  * @namespaces:
  *   - kernel::
@@ -15,6 +16,7 @@
 
 #include "arch/kokkos_aliases.h"
 #include "utils/error.h"
+#include "utils/numeric.h"
 
 namespace kernel {
 
@@ -61,6 +63,72 @@ namespace kernel {
     }
   };
 
+  /**
+   * @brief Running average of a field over consecutive timesteps
+   * @note `n`-th update: `fld_avg = fld_avg + (fld - fld_avg) / n`; the first
+   * one (`n = 1`) simply overwrites `fld_avg`
+   */
+  template <Dimension D, unsigned short N>
+  class RunningAverage_kernel {
+    const ndfield_t<D, N> fld;
+    ndfield_t<D, N>       fld_avg;
+    const bool            overwrite;
+    const real_t          inv_n;
+
+  public:
+    RunningAverage_kernel(const ndfield_t<D, N>& fld,
+                          ndfield_t<D, N>&       fld_avg,
+                          unsigned short         n)
+      : fld { fld }
+      , fld_avg { fld_avg }
+      , overwrite { n == 1 }
+      , inv_n { ONE / static_cast<real_t>(n) } {
+      raise::ErrorIf(n == 0, "Invalid number of averaged timesteps", HERE);
+    }
+
+    Inline void operator()(index_t i1) const {
+      if constexpr (D == Dim::_1D) {
+        for (auto c { 0u }; c < N; ++c) {
+          const auto f     = fld(i1, c);
+          const auto f_avg = fld_avg(i1, c);
+          fld_avg(i1, c)   = overwrite ? f : f_avg + (f - f_avg) * inv_n;
+        }
+      } else {
+        raise::KernelError(
+          HERE,
+          "1D implementation of RunningAverage_kernel called for non-1D");
+      }
+    }
+
+    Inline void operator()(index_t i1, index_t i2) const {
+      if constexpr (D == Dim::_2D) {
+        for (auto c { 0u }; c < N; ++c) {
+          const auto f       = fld(i1, i2, c);
+          const auto f_avg   = fld_avg(i1, i2, c);
+          fld_avg(i1, i2, c) = overwrite ? f : f_avg + (f - f_avg) * inv_n;
+        }
+      } else {
+        raise::KernelError(
+          HERE,
+          "2D implementation of RunningAverage_kernel called for non-2D");
+      }
+    }
+
+    Inline void operator()(index_t i1, index_t i2, index_t i3) const {
+      if constexpr (D == Dim::_3D) {
+        for (auto c { 0u }; c < N; ++c) {
+          const auto f           = fld(i1, i2, i3, c);
+          const auto f_avg       = fld_avg(i1, i2, i3, c);
+          fld_avg(i1, i2, i3, c) = overwrite ? f : f_avg + (f - f_avg) * inv_n;
+        }
+      } else {
+        raise::KernelError(
+          HERE,
+          "3D implementation of RunningAverage_kernel called for non-3D");
+      }
+    }
+  };
+
 } // namespace kernel
 
 #endif // KERNELS_UTILS_HPP
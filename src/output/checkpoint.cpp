@@ -9,8 +9,15 @@
 #include <Kokkos_Core.hpp>
 #include <adios2.h>
 
+#if defined(MPI_ENABLED)
+  #include <mpi.h>
+#endif
+
 #include <filesystem>
+#include <future>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace checkpoint {
 
@@ -46,8 +53,47 @@ namespace checkpoint {
       m_checkpoint_root);
   }
 
+  void Writer::initStaging(const path_t& local_root,
+                           timestep_t    interval,
+                           simtime_t     interval_time,
+                           int           keep) {
+    if (not m_enabled) {
+      return;
+    }
+    raise::ErrorIf(keep < 1, "At least one staged checkpoint has to be kept", HERE);
+    m_staged     = true;
+    m_local_root = local_root;
+    m_local_keep = keep;
+    m_local_tracker.init("checkpoint (staged)", interval, interval_time);
+#if defined(MPI_ENABLED)
+    MPI_Comm node_comm;
+    int      node_rank;
+    MPI_Comm_split_type(MPI_COMM_WORLD,
+                        MPI_COMM_TYPE_SHARED,
+                        0,
+                        MPI_INFO_NULL,
+                        &node_comm);
+    MPI_Comm_rank(node_comm, &node_rank);
+    MPI_Comm_free(&node_comm);
+    m_node_leader = (node_rank == 0);
+#endif
+    if (m_node_leader and not std::filesystem::exists(m_local_root)) {
+      std::filesystem::create_directories(m_local_root);
+    }
+#if defined(MPI_ENABLED)
+    MPI_Barrier(MPI_COMM_WORLD);
+#endif
+  }
+
   auto Writer::shouldSave(timestep_t step, simtime_t time) -> bool {
-    return m_enabled and m_tracker.shouldWrite(step, time);
+    if (not m_enabled) {
+      return false;
+    }
+    // both trackers are advanced at every call
+    const auto save_global = m_tracker.shouldWrite(step, time);
+    const auto save_local  = m_staged and m_local_tracker.shouldWrite(step, time);
+    m_flush_current        = m_staged and save_global;
+    return save_global or save_local;
   }
 
   void Writer::beginSaving(timestep_t step, simtime_t time) {
@@ -58,11 +104,16 @@ namespace checkpoint {
     }
     m_writing_mode = true;
     try {
-      const auto filename = m_checkpoint_root / fmt::format("step-%08lu.bp", step);
-      const auto metafilename = m_checkpoint_root /
-                                fmt::format("meta-%08lu.toml", step);
-      m_writer = m_io.Open(filename, adios2::Mode::Write);
-      m_written.push_back({ filename, metafilename });
+      const auto& root     = m_staged ? m_local_root : m_checkpoint_root;
+      const auto  filename = root / fmt::format("step-%08lu.bp", step);
+      const auto  metafilename = root / fmt::format("meta-%08lu.toml", step);
+      m_writer  = m_io.Open(filename, adios2::Mode::Write);
+      m_current = { filename, metafilename };
+      if (m_staged) {
+        m_local_written.push_back(m_current);
+      } else {
+        m_written.push_back(m_current);
+      }
       logger::Checkpoint(fmt::format("Writing checkpoint to %s and %s",
                                      filename.c_str(),
                                      metafilename.c_str()),
@@ -85,19 +136,96 @@ namespace checkpoint {
     m_writer.EndStep();
     m_writer.Close();
 
+    if (not m_staged) {
+      // optionally remove the oldest checkpoint
+      CallOnce([&]() {
+        removeOldest(m_written, m_keep);
+      });
+      return;
+    }
+    // each node removes its own part of the oldest staged checkpoints ...
+    // ... except for the one which might still be copied
+    if (m_node_leader) {
+      removeOldest(m_local_written, m_local_keep, m_flushing.first);
+    } else if (m_local_written.size() > (std::size_t)m_local_keep) {
+      m_local_written.erase(m_local_written.begin());
+    }
+    if (m_flush_current) {
+      flush(m_current);
+    }
+  }
+
+  void Writer::removeOldest(std::vector<std::pair<std::string, std::string>>& written,
+                            int                keep,
+                            const std::string& in_use) {
+    if (keep <= 0 or written.size() <= (std::size_t)keep) {
+      return;
+    }
+    const auto oldest = written.front();
+    if (oldest.first == in_use) {
+      return;
+    }
+    if (std::filesystem::exists(oldest.first)) {
+      std::filesystem::remove_all(oldest.first);
+      if (std::filesystem::exists(oldest.second)) {
+        std::filesystem::remove(oldest.second);
+      }
+      written.erase(written.begin());
+    } else {
+      raise::Warning("Checkpoint file does not exist for some reason", HERE);
+    }
+  }
+
+  void Writer::flush(const std::pair<std::string, std::string>& local) {
+    // only one copy is in flight at a time
+    waitForFlush();
+    const auto filename = m_checkpoint_root /
+                          path_t(local.first).filename();
+    const auto metafilename = m_checkpoint_root /
+                              path_t(local.second).filename();
+    m_written.push_back({ filename, metafilename });
+    m_flushing = local;
+    logger::Checkpoint(fmt::format("Copying checkpoint to %s in the background",
+                                   filename.c_str()),
+                       HERE);
+    if (not m_node_leader) {
+      return;
+    }
+    // each node copies the files it has written (the data of the ranks on
+    // the node, and the metadata on the node of the root rank), so the
+    // checkpoint is reassembled in `checkpoint_root`
+    m_flush = std::async(std::launch::async, [local, filename, metafilename]() {
+      namespace fs = std::filesystem;
+      fs::copy(local.first,
+               filename,
+               fs::copy_options::recursive | fs::copy_options::overwrite_existing);
+      if (fs::exists(local.second)) {
+        fs::copy_file(local.second,
+                      metafilename,
+                      fs::copy_options::overwrite_existing);
+      }
+    });
+  }
+
+  void Writer::waitForFlush() {
+    if (not m_staged or m_flushing.first.empty()) {
+      return;
+    }
+    try {
+      if (m_flush.valid()) {
+        m_flush.get();
+      }
+    } catch (std::exception& e) {
+      raise::Fatal(e.what(), HERE);
+    }
+#if defined(MPI_ENABLED)
+    // the copy is complete only when all the nodes are done
+    MPI_Barrier(MPI_COMM_WORLD);
+#endif
+    m_flushing = {};
     // optionally remove the oldest checkpoint
     CallOnce([&]() {
-      if (m_keep > 0 and m_written.size() > (std::size_t)m_keep) {
-        const auto oldest = m_written.front();
-        if (std::filesystem::exists(oldest.first) and
-            std::filesystem::exists(oldest.second)) {
-          std::filesystem::remove_all(oldest.first);
-          std::filesystem::remove(oldest.second);
-          m_written.erase(m_written.begin());
-        } else {
-          raise::Warning("Checkpoint file does not exist for some reason", HERE);
-        }
-      }
+      removeOldest(m_written, m_keep);
     });
   }
 
@@ -18,12 +18,19 @@
 
 #include <adios2.h>
 
+#include <future>
 #include <string>
 #include <utility>
 #include <vector>
 
 namespace checkpoint {
 
+  /**
+   * @brief Writes (and rotates) the checkpoints
+   * @note With staging enabled, checkpoints are written frequently to a
+   * node-local directory, and every `interval` steps (or `interval_time`) the
+   * latest one is copied to `checkpoint_root` in the background
+   */
   class Writer {
     adios2::ADIOS* p_adios { nullptr };
 
@@ -40,6 +47,29 @@ namespace checkpoint {
     bool   m_enabled;
     path_t m_checkpoint_root;
 
+    // files of the checkpoint being written
+    std::pair<std::string, std::string> m_current;
+
+    // node-local staging of the checkpoints
+    bool           m_staged { false };
+    path_t         m_local_root;
+    int            m_local_keep { 1 };
+    tools::Tracker m_local_tracker {};
+    std::vector<std::pair<std::string, std::string>> m_local_written;
+    // only one rank per node deletes & copies the node-local files
+    bool           m_node_leader { true };
+
+    // whether the current checkpoint has to be copied to `checkpoint_root`
+    bool                                m_flush_current { false };
+    // the background copy in flight (& the local files being copied)
+    std::future<void>                   m_flush;
+    std::pair<std::string, std::string> m_flushing;
+
+    void flush(const std::pair<std::string, std::string>&);
+    void removeOldest(std::vector<std::pair<std::string, std::string>>&,
+                      int,
+                      const std::string& = "");
+
   public:
     Writer() {}
 
@@ -52,11 +82,26 @@ namespace checkpoint {
               int,
               const std::string& = "");
 
+    /**
+     * @brief Write the checkpoints to a node-local directory first
+     * @param local_root node-local directory
+     * @param interval # of timesteps between the node-local checkpoints
+     * @param interval_time time between the node-local checkpoints
+     * @param keep # of node-local checkpoints to keep
+     */
+    void initStaging(const path_t&, timestep_t, simtime_t, int);
+
     auto shouldSave(timestep_t, simtime_t) -> bool;
 
     void beginSaving(timestep_t, simtime_t);
     void endSaving();
 
+    /**
+     * @brief Block until the checkpoint being copied from the node-local
+     * directory is complete (and remove the outdated ones)
+     */
+    void waitForFlush();
+
     [[nodiscard]]
     auto io() -> adios2::IO& {
       return m_io;
@@ -72,6 +117,14 @@ namespace checkpoint {
       return m_written;
     }
 
+    /**
+     * @brief Data & metadata files of the checkpoint being written
+     */
+    [[nodiscard]]
+    auto current() const -> const std::pair<std::string, std::string>& {
+      return m_current;
+    }
+
     [[nodiscard]]
     auto enabled() const -> bool {
       return m_enabled;
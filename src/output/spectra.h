@@ -1,16 +1,21 @@
 /**
  * @file output/spectra.h
- * @brief Defines the metadata for particle spectra
+ * @brief Defines the metadata for particle spectra & histograms
  * @implements
  *   - out::OutputSpectra
+ *   - out::OutputHistogram
  */
 
 #ifndef OUTPUT_SPECTRA_H
 #define OUTPUT_SPECTRA_H
 
+#include "enums.h"
 #include "global.h"
 
+#include "utils/error.h"
+
 #include <string>
+#include <vector>
 
 namespace out {
 
@@ -33,6 +38,88 @@ namespace out {
     }
   };
 
+  /**
+   * @brief Weighted particle histogram in up to 3 quantities
+   * @note The counts are stored row-major (last axis is the fastest)
+   * @note If no species are specified, all massive species are binned
+   */
+  class OutputHistogram {
+    const std::string m_label;
+
+  public:
+    const std::vector<spidx_t>     species;
+    const std::vector<SpecAxis>    axes;
+    const std::vector<std::size_t> n_bins;
+    const std::vector<real_t>      min, max;
+    const std::vector<bool>        log_bins;
+
+    OutputHistogram(const std::string&              label,
+                    const std::vector<spidx_t>&     species,
+                    const std::vector<SpecAxis>&    axes,
+                    const std::vector<std::size_t>& n_bins,
+                    const std::vector<real_t>&      min,
+                    const std::vector<real_t>&      max,
+                    const std::vector<bool>&        log_bins)
+      : m_label { label }
+      , species { species }
+      , axes { axes }
+      , n_bins { n_bins }
+      , min { min }
+      , max { max }
+      , log_bins { log_bins } {
+      raise::ErrorIf(axes.empty() or (axes.size() > 3),
+                     "Histogram " + label + " must have 1 to 3 axes",
+                     HERE);
+      raise::ErrorIf((n_bins.size() != axes.size()) or
+                       (min.size() != axes.size()) or
+                       (max.size() != axes.size()) or
+                       (log_bins.size() != axes.size()),
+                     "Histogram " + label + " has inconsistent axes",
+                     HERE);
+    }
+
+    ~OutputHistogram() = default;
+
+    [[nodiscard]]
+    auto name() const -> std::string {
+      return "sH_" + m_label;
+    }
+
+    /**
+     * @brief Name of the bin edges along axis `d`
+     */
+    [[nodiscard]]
+    auto binsName(std::size_t d) const -> std::string {
+      return name() + "_" + std::string(axes[d].to_string());
+    }
+
+    /**
+     * @brief Total number of bins
+     */
+    [[nodiscard]]
+    auto size() const -> std::size_t {
+      std::size_t n = 1;
+      for (const auto& nb : n_bins) {
+        n *= nb;
+      }
+      return n;
+    }
+
+    /**
+     * @brief Whether the local magnetic field is needed for binning
+     */
+    [[nodiscard]]
+    auto is_field_aligned() const -> bool {
+      for (const auto& axis : axes) {
+        if (axis == SpecAxis::Upar or axis == SpecAxis::Uperp or
+            axis == SpecAxis::Pitch) {
+          return true;
+        }
+      }
+      return false;
+    }
+  };
+
 } // namespace out
 
 #endif // OUTPUT_SPECTRA_H
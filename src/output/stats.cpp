@@ -99,14 +99,23 @@ namespace stats {
       m_stat_writers);
   }
 
-  void Writer::endWriting() {
+  void Writer::writeRow(timestep_t                 step,
+                        simtime_t                  time,
+                        const std::vector<real_t>& row) const {
     CallOnce(
-      [](auto& fname) {
+      [](auto& fname, auto& step, auto& time, auto& row) {
         std::fstream StatsOut(fname, std::fstream::out | std::fstream::app);
+        StatsOut << std::setw(14) << step << "," << std::setw(14) << time << ",";
+        for (const auto& value : row) {
+          StatsOut << std::setw(14) << value << ",";
+        }
         StatsOut << std::endl;
         StatsOut.close();
       },
-      m_fname);
+      m_fname,
+      step,
+      time,
+      row);
   }
 
 } // namespace stats
@@ -20,12 +20,6 @@
 #include "utils/formatting.h"
 #include "utils/tools.h"
 
-#if defined(MPI_ENABLED)
-  #include "arch/mpi_aliases.h"
-
-  #include <mpi.h>
-#endif
-
 #include <fstream>
 #include <iomanip>
 #include <string>
@@ -166,36 +160,11 @@ namespace stats {
     [[nodiscard]]
     auto shouldWrite(timestep_t, simtime_t) -> bool;
 
-    template <typename T>
-    inline void write(const T& value, bool communicate = true) const {
-      auto tot_value { static_cast<T>(0) };
-#if defined(MPI_ENABLED)
-      if (communicate) {
-        MPI_Reduce(&value,
-                   &tot_value,
-                   1,
-                   mpi::get_type<T>(),
-                   MPI_SUM,
-                   MPI_ROOT_RANK,
-                   MPI_COMM_WORLD);
-      } else {
-        tot_value = value;
-      }
-#else
-      (void)communicate;
-      tot_value = value;
-#endif
-      CallOnce(
-        [](auto&& fname, auto&& value) {
-          std::fstream StatsOut(fname, std::fstream::out | std::fstream::app);
-          StatsOut << std::setw(14) << value << ",";
-          StatsOut.close();
-        },
-        m_fname,
-        tot_value);
-    }
-
-    void endWriting();
+    /**
+     * @brief Append a full row of (already reduced) stats to the file
+     * @note Only the root rank writes
+     */
+    void writeRow(timestep_t, simtime_t, const std::vector<real_t>&) const;
 
     [[nodiscard]]
     auto statsWriters() const -> const std::vector<OutputStats>& {
@@ -1,31 +1,463 @@
 #include "enums.h"
 #include "global.h"
 
+#include "arch/kokkos_aliases.h"
 #include "utils/formatting.h"
 
+#include "output/utils/readers.h"
+#include "output/utils/writers.h"
 #include "output/writer.h"
 
 #include <Kokkos_Core.hpp>
 #include <adios2.h>
 #include <adios2/cxx11/KokkosView.h>
 
+#include <algorithm>
+#include <cmath>
 #include <filesystem>
 #include <iostream>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 using namespace ntt;
 
 void cleanup() {
   namespace fs = std::filesystem;
-  fs::path tempfile_path { "test.bp" };
-  fs::remove_all(tempfile_path);
+  for (const auto& tempfile :
+       { "test.bp", "test-packed.bp", "test-box.bp", "test-compr.bp" }) {
+    fs::path tempfile_path { tempfile };
+    fs::remove_all(tempfile_path);
+  }
 }
 
 #define CEILDIV(a, b)                                                          \
   (static_cast<ncells_t>(                                                      \
     math::ceil(static_cast<real_t>(a) / static_cast<real_t>(b))))
 
+/*
+ * packed particle arrays written in two blocks with `out::WritePackedArray`
+ * are read back row by row (found by name) with `out::ReadPackedRow`
+ */
+void testPackedRoundTrip(adios2::ADIOS& adios) {
+  const std::vector<std::string> fields_r { "X1", "X2", "UX1", "W" };
+  const std::vector<std::string> fields_i { "IDX", "PLDI0" };
+  const std::size_t              nblock1 = 7, nblock2 = 5;
+  const std::size_t              ntotal  = nblock1 + nblock2;
+
+  const auto value_r = [](std::size_t row, std::size_t k) -> real_t {
+    return static_cast<real_t>(100 * row + k) + HALF;
+  };
+  const auto value_i = [](std::size_t row, std::size_t k) -> npart_t {
+    return static_cast<npart_t>(1000 * row + k);
+  };
+
+  {
+    adios2::IO io = adios.DeclareIO("packed-write");
+    io.SetEngine("BPFile");
+    io.DefineVariable<real_t>("pR_1",
+                              { fields_r.size(), adios2::UnknownDim },
+                              { 0, adios2::UnknownDim },
+                              { fields_r.size(), adios2::UnknownDim });
+    io.DefineAttribute<std::string>("pR_1_fields",
+                                    fields_r.data(),
+                                    fields_r.size());
+    io.DefineVariable<npart_t>("pI_1",
+                               { fields_i.size(), adios2::UnknownDim },
+                               { 0, adios2::UnknownDim },
+                               { fields_i.size(), adios2::UnknownDim });
+    io.DefineAttribute<std::string>("pI_1_fields",
+                                    fields_i.data(),
+                                    fields_i.size());
+
+    adios2::Engine writer = io.Open("test-packed.bp", adios2::Mode::Write);
+    writer.BeginStep();
+    std::size_t offset = 0;
+    for (const auto nblock : { nblock1, nblock2 }) {
+      packed_array_t<real_t**>  buff_r { "buff_r", fields_r.size(), nblock };
+      packed_array_t<npart_t**> buff_i { "buff_i", fields_i.size(), nblock };
+      auto buff_r_h = Kokkos::create_mirror_view(buff_r);
+      auto buff_i_h = Kokkos::create_mirror_view(buff_i);
+      for (auto k { 0u }; k < nblock; ++k) {
+        for (auto row { 0u }; row < fields_r.size(); ++row) {
+          buff_r_h(row, k) = value_r(row, offset + k);
+        }
+        for (auto row { 0u }; row < fields_i.size(); ++row) {
+          buff_i_h(row, k) = value_i(row, offset + k);
+        }
+      }
+      Kokkos::deep_copy(buff_r, buff_r_h);
+      Kokkos::deep_copy(buff_i, buff_i_h);
+      // clang-format off
+      out::WritePackedArray<real_t>(io, writer, "pR_1", buff_r,
+                                    nblock, ntotal, offset);
+      out::WritePackedArray<npart_t>(io, writer, "pI_1", buff_i,
+                                     nblock, ntotal, offset);
+      // clang-format on
+      offset += nblock;
+    }
+    writer.EndStep();
+    writer.Close();
+  }
+
+  adios2::IO io = adios.DeclareIO("packed-read");
+  io.SetEngine("BPFile");
+  adios2::Engine reader = io.Open("test-packed.bp", adios2::Mode::Read);
+  raise::ErrorIf(reader.BeginStep() != adios2::StepStatus::OK,
+                 "Packed arrays not written",
+                 HERE);
+  // the whole row, and the second block into a larger (partly filled) array
+  for (auto row { 0u }; row < fields_r.size(); ++row) {
+    array_t<real_t*> data { "data", ntotal };
+    out::ReadPackedRow<real_t>(io,
+                               reader,
+                               "pR_1",
+                               fields_r[row],
+                               data,
+                               ntotal,
+                               0);
+    array_t<real_t*> data_blk { "data_blk", ntotal };
+    Kokkos::deep_copy(data_blk, -ONE);
+    out::ReadPackedRow<real_t>(io,
+                               reader,
+                               "pR_1",
+                               fields_r[row],
+                               data_blk,
+                               nblock2,
+                               nblock1);
+    auto data_h     = Kokkos::create_mirror_view(data);
+    auto data_blk_h = Kokkos::create_mirror_view(data_blk);
+    Kokkos::deep_copy(data_h, data);
+    Kokkos::deep_copy(data_blk_h, data_blk);
+    for (auto k { 0u }; k < ntotal; ++k) {
+      raise::ErrorIf(data_h(k) != value_r(row, k),
+                     fmt::format("%s is not read correctly",
+                                 fields_r[row].c_str()),
+                     HERE);
+      const auto expect = (k < nblock2) ? value_r(row, nblock1 + k) : -ONE;
+      raise::ErrorIf(data_blk_h(k) != expect,
+                     fmt::format("%s block is not read correctly",
+                                 fields_r[row].c_str()),
+                     HERE);
+    }
+  }
+  for (auto row { 0u }; row < fields_i.size(); ++row) {
+    array_t<npart_t*> data { "data", ntotal };
+    out::ReadPackedRow<npart_t>(io,
+                                reader,
+                                "pI_1",
+                                fields_i[row],
+                                data,
+                                ntotal,
+                                0);
+    auto data_h = Kokkos::create_mirror_view(data);
+    Kokkos::deep_copy(data_h, data);
+    for (auto k { 0u }; k < ntotal; ++k) {
+      raise::ErrorIf(data_h(k) != value_i(row, k),
+                     fmt::format("%s is not read correctly",
+                                 fields_i[row].c_str()),
+                     HERE);
+    }
+  }
+  // the row has to fit into the array
+  array_t<real_t*> data_small { "data_small", nblock1 };
+  auto             thrown = false;
+  try {
+    out::ReadPackedRow<real_t>(io, reader, "pR_1", "W", data_small, ntotal, 0);
+  } catch (const std::exception&) {
+    thrown = true;
+  }
+  raise::ErrorIf(not thrown, "Reading into a small array should fail", HERE);
+  reader.EndStep();
+  reader.Close();
+}
+
+/*
+ * reads a 2D field written by `out::Writer` into a host vector indexed as
+ * [i1 * nx2 + i2] (regardless of the layout)
+ */
+template <typename T>
+auto readField2D(adios2::IO&        io,
+                 adios2::Engine&    reader,
+                 const std::string& name,
+                 ncells_t           nx1,
+                 ncells_t           nx2) -> std::vector<T> {
+  auto var = io.InquireVariable<T>(name);
+  raise::ErrorIf(not var, fmt::format("%s not found", name.c_str()), HERE);
+  const auto layoutRight = io.InquireAttribute<int>("LayoutRight").Data()[0] ==
+                           1;
+  const auto shape = layoutRight ? adios2::Dims { nx1, nx2 }
+                                 : adios2::Dims { nx2, nx1 };
+  raise::ErrorIf(var.Shape() != shape,
+                 fmt::format("%s has a wrong shape", name.c_str()),
+                 HERE);
+  var.SetSelection(adios2::Box<adios2::Dims>({ 0, 0 }, shape));
+  std::vector<T> data(nx1 * nx2);
+  reader.Get(var, data.data(), adios2::Mode::Sync);
+  if (layoutRight) {
+    return data;
+  }
+  std::vector<T> data_t(nx1 * nx2);
+  for (auto i1 { 0u }; i1 < nx1; ++i1) {
+    for (auto i2 { 0u }; i2 < nx2; ++i2) {
+      data_t[i1 * nx2 + i2] = data[i2 * nx1 + i1];
+    }
+  }
+  return data_t;
+}
+
+/*
+ * a 2D field downsampled with each of the modes: every box is combined
+ * from its own cells only (the last boxes are cut short at the upper edge,
+ * and the ghost cells never leak into them)
+ */
+void testBoxReduction(Downsampling mode) {
+  constexpr ncells_t nx1 = 10, nx2 = 7;
+  constexpr ncells_t dwn1 = 3, dwn2 = 2;
+  const auto         nx1_dwn = CEILDIV(nx1, dwn1);
+  const auto         nx2_dwn = CEILDIV(nx2, dwn2);
+
+  // values at the active cells (not including ghosts)
+  const auto value = [](ncells_t i1, ncells_t i2, unsigned int c) -> real_t {
+    return static_cast<real_t>((7 * i1 + 3 * i2 * i2 + 5 * c) % 11) -
+           (real_t)(5.0);
+  };
+
+  ndfield_t<Dim::_2D, 3> field { "fld",
+                                 nx1 + 2 * N_GHOSTS,
+                                 nx2 + 2 * N_GHOSTS };
+  auto                   field_h = Kokkos::create_mirror_view(field);
+  Kokkos::deep_copy(field_h, (real_t)(1e3));
+  for (auto i1 { 0u }; i1 < nx1; ++i1) {
+    for (auto i2 { 0u }; i2 < nx2; ++i2) {
+      for (auto c { 0u }; c < 3; ++c) {
+        field_h(i1 + N_GHOSTS, i2 + N_GHOSTS, c) = value(i1, i2, c);
+      }
+    }
+  }
+  Kokkos::deep_copy(field, field_h);
+
+  std::filesystem::remove_all("test-box.bp");
+  // each writer declares its own IO, so a separate ADIOS is used
+  adios2::ADIOS            adios;
+  std::vector<std::string> names;
+  {
+    auto writer = out::Writer();
+    writer.init(&adios, "bpfile", "test-box", false);
+    writer.defineMeshLayout({ nx1, nx2 },
+                            { 0, 0 },
+                            { nx1, nx2 },
+                            { 0, 1 },
+                            { dwn1, dwn2 },
+                            false,
+                            Coord::Cart,
+                            mode);
+    writer.defineFieldOutputs(SimEngine::SRPIC, { "E" });
+    for (auto c { 0u }; c < 3; ++c) {
+      names.push_back(writer.fieldWriters()[0].name(c));
+    }
+    writer.beginWriting(WriteMode::Fields, 0, 0.0);
+    writer.writeField<Dim::_2D, 3>(names, field, { 0, 1, 2 });
+    writer.endWriting(WriteMode::Fields);
+  }
+
+  adios2::IO     io     = adios.DeclareIO("box-read");
+  adios2::Engine reader = io.Open("test-box.bp", adios2::Mode::Read);
+  raise::ErrorIf(reader.BeginStep() != adios2::StepStatus::OK,
+                 "Downsampled field not written",
+                 HERE);
+  raise::ErrorIf(io.InquireAttribute<std::string>("Downsampling").Data()[0] !=
+                   std::string(mode.to_string()),
+                 "Downsampling attribute is not correct",
+                 HERE);
+  for (auto c { 0u }; c < 3; ++c) {
+    const auto data = readField2D<real_t>(io,
+                                          reader,
+                                          names[c],
+                                          nx1_dwn,
+                                          nx2_dwn);
+    for (auto i1 { 0u }; i1 < nx1_dwn; ++i1) {
+      for (auto i2 { 0u }; i2 < nx2_dwn; ++i2) {
+        const auto j1_min = i1 * dwn1, j1_max = std::min(j1_min + dwn1, nx1);
+        const auto j2_min = i2 * dwn2, j2_max = std::min(j2_min + dwn2, nx2);
+        real_t     sum = ZERO, vmax = value(j1_min, j2_min, c), vmin = vmax;
+        for (auto j1 { j1_min }; j1 < j1_max; ++j1) {
+          for (auto j2 { j2_min }; j2 < j2_max; ++j2) {
+            sum  += value(j1, j2, c);
+            vmax  = std::max(vmax, value(j1, j2, c));
+            vmin  = std::min(vmin, value(j1, j2, c));
+          }
+        }
+        real_t expect = value(j1_min, j2_min, c);
+        if (mode == Downsampling::MEAN) {
+          expect = sum / static_cast<real_t>((j1_max - j1_min) *
+                                             (j2_max - j2_min));
+        } else if (mode == Downsampling::MAX) {
+          expect = vmax;
+        } else if (mode == Downsampling::MIN) {
+          expect = vmin;
+        }
+        raise::ErrorIf(
+          not cmp::AlmostEqual_host(data[i1 * nx2_dwn + i2],
+                                    expect,
+                                    (real_t)(1e-5)),
+          fmt::format("%s: box (%u, %u) of %s is %f instead of %f",
+                      mode.to_string(),
+                      i1,
+                      i2,
+                      names[c].c_str(),
+                      (double)data[i1 * nx2_dwn + i2],
+                      (double)expect),
+          HERE);
+      }
+    }
+  }
+  reader.EndStep();
+  reader.Close();
+}
+
+// whether the ADIOS2 operator of a given type is compiled in
+auto operatorAvailable(adios2::ADIOS& adios, const std::string& type) -> bool {
+  try {
+    if (not adios.InquireOperator("probe::" + type)) {
+      adios.DefineOperator("probe::" + type, type);
+    }
+    return true;
+  } catch (std::exception&) {
+    return false;
+  }
+}
+
+/*
+ * the requested operator falls back to blosc -> bzip2 -> none (without
+ * throwing), and the compressed (and the single-precision) fields are read
+ * back within the tolerance
+ */
+void testCompression() {
+  constexpr real_t accuracy = 1e-3;
+  {
+    adios2::ADIOS adios;
+    auto          fallback = std::string { "none" };
+    for (const auto& t : { "blosc", "bzip2" }) {
+      if (operatorAvailable(adios, t)) {
+        fallback = t;
+        break;
+      }
+    }
+    const auto none = out::DefineCompression(&adios, "none", accuracy, 5);
+    raise::ErrorIf(none.enabled(), "`none` compression should be disabled", HERE);
+    for (const auto& type : { "blosc", "bzip2", "zfp", "not-an-operator" }) {
+      const auto expect = operatorAvailable(adios, type) ? std::string { type }
+                                                         : fallback;
+      // the second call reuses the operator defined by the first one
+      for (auto n { 0 }; n < 2; ++n) {
+        const auto compr = out::DefineCompression(&adios, type, accuracy, 5);
+        raise::ErrorIf(compr.type != expect,
+                       fmt::format("`%s` compression falls back to `%s` "
+                                   "instead of `%s`",
+                                   type,
+                                   compr.type.c_str(),
+                                   expect.c_str()),
+                       HERE);
+        raise::ErrorIf(compr.enabled() != (expect != "none"),
+                       fmt::format("`%s` compression has a wrong state", type),
+                       HERE);
+      }
+    }
+  }
+
+  constexpr ncells_t nx1 = 12, nx2 = 9;
+  const auto         value = [](ncells_t i1, ncells_t i2, unsigned int c) {
+    return static_cast<real_t>(c) + (real_t)(0.1) * static_cast<real_t>(i1) +
+           (real_t)(0.01) * static_cast<real_t>(i2 * i2);
+  };
+  ndfield_t<Dim::_2D, 3> field { "fld",
+                                 nx1 + 2 * N_GHOSTS,
+                                 nx2 + 2 * N_GHOSTS };
+  auto                   field_h = Kokkos::create_mirror_view(field);
+  for (auto i1 { 0u }; i1 < nx1; ++i1) {
+    for (auto i2 { 0u }; i2 < nx2; ++i2) {
+      for (auto c { 0u }; c < 3; ++c) {
+        field_h(i1 + N_GHOSTS, i2 + N_GHOSTS, c) = value(i1, i2, c);
+      }
+    }
+  }
+  Kokkos::deep_copy(field, field_h);
+
+  for (const auto& type : { "none", "blosc", "zfp", "not-an-operator" }) {
+    for (const auto single : { false, true }) {
+      std::filesystem::remove_all("test-compr.bp");
+      // each writer declares its own IO, so a separate ADIOS is used
+      adios2::ADIOS            adios;
+      std::vector<std::string> names;
+      {
+        auto writer = out::Writer();
+        writer.init(&adios, "bpfile", "test-compr", false);
+        writer.setCompression(type, type, accuracy, 5, single);
+        writer.defineMeshLayout({ nx1, nx2 },
+                                { 0, 0 },
+                                { nx1, nx2 },
+                                { 0, 1 },
+                                { 1, 1 },
+                                false,
+                                Coord::Cart);
+        writer.defineFieldOutputs(SimEngine::SRPIC, { "E" });
+        for (auto c { 0u }; c < 3; ++c) {
+          names.push_back(writer.fieldWriters()[0].name(c));
+        }
+        writer.beginWriting(WriteMode::Fields, 0, 0.0);
+        writer.writeField<Dim::_2D, 3>(names, field, { 0, 1, 2 });
+        writer.endWriting(WriteMode::Fields);
+      }
+
+      // fields are only converted when real_t is double
+      const auto as_float = single and std::is_same<real_t, double>::value;
+      adios2::IO     io     = adios.DeclareIO("compr-read");
+      adios2::Engine reader = io.Open("test-compr.bp", adios2::Mode::Read);
+      raise::ErrorIf(reader.BeginStep() != adios2::StepStatus::OK,
+                     "Compressed field not written",
+                     HERE);
+      for (auto c { 0u }; c < 3; ++c) {
+        std::vector<double> data;
+        if (as_float) {
+          const auto data_f = readField2D<float>(io,
+                                                 reader,
+                                                 names[c],
+                                                 nx1,
+                                                 nx2);
+          data = std::vector<double>(data_f.begin(), data_f.end());
+        } else {
+          const auto data_r = readField2D<real_t>(io,
+                                                  reader,
+                                                  names[c],
+                                                  nx1,
+                                                  nx2);
+          data = std::vector<double>(data_r.begin(), data_r.end());
+        }
+        for (auto i1 { 0u }; i1 < nx1; ++i1) {
+          for (auto i2 { 0u }; i2 < nx2; ++i2) {
+            const auto expect = static_cast<double>(value(i1, i2, c));
+            raise::ErrorIf(
+              std::abs(data[i1 * nx2 + i2] - expect) >
+                (double)accuracy + 1e-6 * std::abs(expect),
+              fmt::format("`%s`%s: %s(%u, %u) is %f instead of %f",
+                          type,
+                          single ? " (single)" : "",
+                          names[c].c_str(),
+                          i1,
+                          i2,
+                          data[i1 * nx2 + i2],
+                          expect),
+              HERE);
+          }
+        }
+      }
+      reader.EndStep();
+      reader.Close();
+    }
+  }
+}
+
 auto main(int argc, char* argv[]) -> int {
   Kokkos::initialize(argc, argv);
 
@@ -204,6 +636,15 @@ auto main(int argc, char* argv[]) -> int {
       }
       reader.Close();
     }
+
+    testPackedRoundTrip(adios);
+    for (const auto mode : { Downsampling::SAMPLE,
+                             Downsampling::MEAN,
+                             Downsampling::MAX,
+                             Downsampling::MIN }) {
+      testBoxReduction(mode);
+    }
+    testCompression();
   } catch (std::exception& e) {
     std::cerr << e.what() << std::endl;
     cleanup();
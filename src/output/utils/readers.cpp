@@ -8,6 +8,8 @@
 
 #include <adios2.h>
 
+#include <algorithm>
+#include <iterator>
 #include <string>
 
 namespace out {
@@ -35,11 +37,12 @@ namespace out {
                    const std::string& quantity,
                    array_t<T*>&       data,
                    std::size_t        local_size,
-                   std::size_t        local_offset) {
+                   std::size_t        local_offset,
+                   std::size_t        data_offset) {
     auto var = io.InquireVariable<T>(quantity);
     if (var) {
       var.SetSelection(adios2::Box<adios2::Dims>({ local_offset }, { local_size }));
-      const auto slice  = range_tuple_t(0, local_size);
+      const auto slice  = range_tuple_t(data_offset, data_offset + local_size);
       auto       data_h = Kokkos::create_mirror_view(data);
       reader.Get(var, Kokkos::subview(data_h, slice).data(), adios2::Mode::Sync);
       Kokkos::deep_copy(Kokkos::subview(data, slice),
@@ -56,17 +59,56 @@ namespace out {
                    array_t<T**>&      data,
                    unsigned short     dim2_size,
                    std::size_t        local_size,
-                   std::size_t        local_offset) {
+                   std::size_t        local_offset,
+                   std::size_t        data_offset) {
     auto var = io.InquireVariable<T>(quantity);
     if (var) {
       var.SetSelection(adios2::Box<adios2::Dims>({ local_offset, 0 },
                                                  { local_size, dim2_size }));
-      const auto slice  = range_tuple_t(0, local_size);
+      const auto slice  = range_tuple_t(data_offset, data_offset + local_size);
       auto       data_h = Kokkos::create_mirror_view(data);
       reader.Get(var,
                  Kokkos::subview(data_h, slice, range_tuple_t(0, dim2_size)).data(),
                  adios2::Mode::Sync);
-      Kokkos::deep_copy(data, data_h);
+      // only the rows that were read are copied back
+      Kokkos::deep_copy(Kokkos::subview(data, slice, Kokkos::ALL),
+                        Kokkos::subview(data_h, slice, Kokkos::ALL));
+    } else {
+      raise::Error(fmt::format("Variable: %s not found", quantity.c_str()), HERE);
+    }
+  }
+
+  template <typename T>
+  void ReadPackedRow(adios2::IO&        io,
+                     adios2::Engine&    reader,
+                     const std::string& quantity,
+                     const std::string& field,
+                     array_t<T*>&       data,
+                     std::size_t        local_size,
+                     std::size_t        local_offset) {
+    auto var    = io.InquireVariable<T>(quantity);
+    auto fields = io.InquireAttribute<std::string>(quantity + "_fields");
+    if (var and fields) {
+      const auto names = fields.Data();
+      const auto it    = std::find(names.begin(), names.end(), field);
+      raise::ErrorIf(it == names.end(),
+                     fmt::format("Field %s not found in %s",
+                                 field.c_str(),
+                                 quantity.c_str()),
+                     HERE);
+      raise::ErrorIf(local_size > data.extent(0),
+                     fmt::format("Array too small to read %s of %s",
+                                 field.c_str(),
+                                 quantity.c_str()),
+                     HERE);
+      const std::size_t row = std::distance(names.begin(), it);
+      var.SetSelection(
+        adios2::Box<adios2::Dims>({ row, local_offset }, { 1, local_size }));
+      const auto slice  = range_tuple_t(0, local_size);
+      auto       data_h = Kokkos::create_mirror_view(data);
+      reader.Get(var, Kokkos::subview(data_h, slice).data(), adios2::Mode::Sync);
+      Kokkos::deep_copy(Kokkos::subview(data, slice),
+                        Kokkos::subview(data_h, slice));
     } else {
       raise::Error(fmt::format("Variable: %s not found", quantity.c_str()), HERE);
     }
@@ -101,6 +143,7 @@ namespace out {
                                const std::string&,                             \
                                array_t<T*>&,                                   \
                                std::size_t,                                    \
+                               std::size_t,                                    \
                                std::size_t);                                   \
   template void Read2DArray<T>(adios2::IO&,                                    \
                                adios2::Engine&,                                \
@@ -108,7 +151,15 @@ namespace out {
                                array_t<T**>&,                                  \
                                unsigned short,                                 \
                                std::size_t,                                    \
-                               std::size_t);
+                               std::size_t,                                    \
+                               std::size_t);                                   \
+  template void ReadPackedRow<T>(adios2::IO&,                                  \
+                                 adios2::Engine&,                              \
+                                 const std::string&,                           \
+                                 const std::string&,                           \
+                                 array_t<T*>&,                                 \
+                                 std::size_t,                                  \
+                                 std::size_t);
 
   ARRAY_READERS(short)
   ARRAY_READERS(unsigned short)
@@ -6,6 +6,7 @@
  *   - out::ReadVariable<> -> void
  *   - out::Read1DArray<> -> void
  *   - out::Read2DArray<> -> void
+ *   - out::ReadPackedRow<> -> void
  *   - out::ReadNDField<> -> void
  * @cpp:
  *   - readers.cpp
@@ -33,7 +34,8 @@ namespace out {
                    const std::string&,
                    array_t<T*>&,
                    std::size_t,
-                   std::size_t);
+                   std::size_t,
+                   std::size_t = 0);
 
   template <typename T>
   void Read2DArray(adios2::IO&,
@@ -42,7 +44,22 @@ namespace out {
                    array_t<T**>&,
                    unsigned short,
                    std::size_t,
-                   std::size_t);
+                   std::size_t,
+                   std::size_t = 0);
+
+  /**
+   * @brief Read one quantity of an array written with `out::WritePackedArray`
+   * @note The row is found by name in the `<variable>_fields` attribute
+   * @note Only the first `local_size` elements of the array are filled
+   */
+  template <typename T>
+  void ReadPackedRow(adios2::IO&,
+                     adios2::Engine&,
+                     const std::string&,
+                     const std::string&,
+                     array_t<T*>&,
+                     std::size_t,
+                     std::size_t);
 
   template <Dimension D, int N>
   void ReadNDField(adios2::IO&,
@@ -1,6 +1,7 @@
 #include "output/utils/writers.h"
 
 #include "arch/kokkos_aliases.h"
+#include "utils/error.h"
 
 #include <adios2.h>
 
@@ -18,7 +19,7 @@ namespace out {
     auto var = io.InquireVariable<T>(name);
     var.SetShape({ global_size });
     var.SetSelection(adios2::Box<adios2::Dims>({ local_offset }, { 1 }));
-    writer.Put(var, &data);
+    writer.Put(var, &data, adios2::Mode::Sync);
   }
 
   template <typename T>
@@ -62,14 +63,39 @@ namespace out {
     writer.Put(var, data_sub.data(), adios2::Mode::Sync);
   }
 
+  template <typename T>
+  void WritePackedArray(adios2::IO&                io,
+                        adios2::Engine&            writer,
+                        const std::string&         name,
+                        const packed_array_t<T**>& data,
+                        std::size_t                local_size,
+                        std::size_t                global_size,
+                        std::size_t                local_offset) {
+    const std::size_t nrows = data.extent(0);
+    raise::ErrorIf(data.extent(1) != local_size,
+                   "Packed array has to be of the local size",
+                   HERE);
+    auto var = io.InquireVariable<T>(name);
+    var.SetShape({ nrows, global_size });
+    var.SetSelection(
+      adios2::Box<adios2::Dims>({ 0, local_offset }, { nrows, local_size }));
+
+    auto data_h = Kokkos::create_mirror_view(data);
+    Kokkos::deep_copy(data_h, data);
+    writer.Put(var, data_h.data(), adios2::Mode::Sync);
+  }
+
   template <Dimension D, int N>
-  void WriteNDField(adios2::IO&            io,
-                    adios2::Engine&        writer,
-                    const std::string&     name,
-                    const ndfield_t<D, N>& data) {
+  void WriteNDField(adios2::IO&                      io,
+                    adios2::Engine&                  writer,
+                    const std::string&               name,
+                    const ndfield_t<D, N>&           data,
+                    const adios2::Box<adios2::Dims>& range) {
+    auto var = io.InquireVariable<real_t>(name);
+    var.SetSelection(range);
     auto data_h = Kokkos::create_mirror_view(data);
     Kokkos::deep_copy(data_h, data);
-    writer.Put(io.InquireVariable<real_t>(name), data_h.data(), adios2::Mode::Sync);
+    writer.Put(var, data_h.data(), adios2::Mode::Sync);
   }
 
 #define ARRAY_WRITERS(T)                                                       \
@@ -93,7 +119,14 @@ namespace out {
                                 unsigned short,                                \
                                 std::size_t,                                   \
                                 std::size_t,                                   \
-                                std::size_t);
+                                std::size_t);                                  \
+  template void WritePackedArray<T>(adios2::IO&,                               \
+                                    adios2::Engine&,                           \
+                                    const std::string&,                        \
+                                    const packed_array_t<T**>&,                \
+                                    std::size_t,                               \
+                                    std::size_t,                               \
+                                    std::size_t);
 
   ARRAY_WRITERS(short)
   ARRAY_WRITERS(unsigned short)
@@ -108,7 +141,8 @@ namespace out {
   template void WriteNDField<D, N>(adios2::IO&,                                \
                                    adios2::Engine&,                            \
                                    const std::string&,                         \
-                                   const ndfield_t<D, N>&);
+                                   const ndfield_t<D, N>&,                     \
+                                   const adios2::Box<adios2::Dims>&);
   NDFIELD_WRITERS(Dim::_1D, 3)
   NDFIELD_WRITERS(Dim::_1D, 6)
   NDFIELD_WRITERS(Dim::_2D, 3)
@@ -6,6 +6,7 @@
  *  - out::WriteVariable<> -> void
  *  - out::Write1DArray<> -> void
  *  - out::Write2DArray<> -> void
+ *  - out::WritePackedArray<> -> void
  *  - out::WriteNDField<> -> void
  * @cpp:
  *   - writers.cpp
@@ -83,11 +84,26 @@ namespace out {
                     std::size_t,
                     std::size_t);
 
+  /**
+   * @brief Write a row-major array with one row per quantity at once
+   * @note The rows are concatenated across the ranks: the global shape is
+   * (nrows, global_size), and the local block starts at (0, local_offset)
+   */
+  template <typename T>
+  void WritePackedArray(adios2::IO&,
+                        adios2::Engine&,
+                        const std::string&,
+                        const packed_array_t<T**>&,
+                        std::size_t,
+                        std::size_t,
+                        std::size_t);
+
   template <Dimension D, int N>
   void WriteNDField(adios2::IO&,
                     adios2::Engine&,
                     const std::string&,
-                    const ndfield_t<D, N>&);
+                    const ndfield_t<D, N>&,
+                    const adios2::Box<adios2::Dims>&);
 
 } // namespace out
 
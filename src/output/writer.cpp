@@ -5,6 +5,7 @@
 #include "arch/kokkos_aliases.h"
 #include "utils/error.h"
 #include "utils/formatting.h"
+#include "utils/log.h"
 #include "utils/param_container.h"
 #include "utils/tools.h"
 
@@ -18,8 +19,11 @@
   #include <mpi.h>
 #endif
 
+#include <algorithm>
+#include <chrono>
 #include <filesystem>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 namespace out {
@@ -27,15 +31,25 @@ namespace out {
   void Writer::init(adios2::ADIOS*     ptr_adios,
                     const std::string& engine,
                     const std::string& title,
-                    bool               use_separate_files) {
+                    bool               use_separate_files,
+                    bool               use_async) {
     m_separate_files = use_separate_files;
+    m_async          = use_async;
     m_engine         = fmt::toLower(engine);
     p_adios          = ptr_adios;
 
     raise::ErrorIf(p_adios == nullptr, "ADIOS pointer is null", HERE);
+    raise::ErrorIf(m_async and (m_engine == "hdf5"),
+                   "Asynchronous output requires the BPFile engine",
+                   HERE);
 
     m_io = p_adios->DeclareIO("Entity::Output");
     m_io.SetEngine(engine);
+    if (m_async) {
+      // BP5 copies the data into its own buffers at `Put` (Sync) / `EndStep`
+      // and flushes them to disk from a background thread
+      m_io.SetParameter("AsyncWrite", "true");
+    }
 
     m_io.DefineVariable<timestep_t>("Step");
     m_io.DefineVariable<simtime_t>("Time");
@@ -62,6 +76,164 @@ namespace out {
     m_mode = mode;
   }
 
+  auto WriteModeName(WriteModeTags write_mode) -> std::string {
+    if (write_mode == WriteMode::Fields) {
+      return "fields";
+    } else if (write_mode == WriteMode::Particles) {
+      return "particles";
+    } else if (write_mode == WriteMode::Spectra) {
+      return "spectra";
+    } else {
+      raise::Fatal("Unknown write mode", HERE);
+      return "";
+    }
+  }
+
+  /**
+   * @brief Parameters of the ADIOS2 operator of a given type
+   * @param accuracy absolute error tolerance of the lossy operators
+   * @param level compression level of the lossless operators
+   */
+  auto CompressionParams(const std::string& type, real_t accuracy, unsigned short level)
+    -> adios2::Params {
+    if (type == "blosc") {
+      return {
+        {  "compressor",                                 "zstd" },
+        {      "clevel", std::to_string(std::min(level, (unsigned short)9)) },
+        {   "doshuffle",                        "BLOSC_SHUFFLE" }
+      };
+    } else if (type == "bzip2") {
+      return {
+        { "blockSize100k",
+         std::to_string(std::clamp(level, (unsigned short)1, (unsigned short)9)) }
+      };
+    } else {
+      return {
+        { "accuracy", fmt::format("%.6e", (double)accuracy) }
+      };
+    }
+  }
+
+  auto DefineCompression(adios2::ADIOS*     ptr_adios,
+                         const std::string& type,
+                         real_t             accuracy,
+                         unsigned short     level) -> Compression {
+    if (type == "none") {
+      return {};
+    }
+    for (const auto& t : std::vector<std::string> { type, "blosc", "bzip2" }) {
+      try {
+        auto op = ptr_adios->InquireOperator("Entity::" + t);
+        if (not op) {
+          op = ptr_adios->DefineOperator("Entity::" + t, t);
+        }
+        if (t != type) {
+          raise::Warning(fmt::format("`%s` compression is unavailable, using `%s`",
+                                     type.c_str(),
+                                     t.c_str()),
+                         HERE);
+        }
+        return { t, op, CompressionParams(t, accuracy, level) };
+      } catch (std::exception&) {
+        // operator is not compiled into ADIOS2: try the next one
+      }
+    }
+    raise::Warning(fmt::format("`%s` compression is unavailable, writing as is",
+                               type.c_str()),
+                   HERE);
+    return {};
+  }
+
+  /**
+   * @brief Size of a file (or of all files in a directory) in bytes
+   */
+  auto DiskUsage(const path_t& path) -> std::size_t {
+    std::size_t nbytes = 0;
+    if (std::filesystem::is_directory(path)) {
+      for (const auto& entry :
+           std::filesystem::recursive_directory_iterator(path)) {
+        if (entry.is_regular_file()) {
+          nbytes += entry.file_size();
+        }
+      }
+    } else if (std::filesystem::exists(path)) {
+      nbytes = std::filesystem::file_size(path);
+    }
+    return nbytes;
+  }
+
+  void ReportWrite(WriteModeTags write_mode, const WriteReport& report) {
+    if (not report.enabled) {
+      return;
+    }
+    CallOnce([&]() {
+      const auto nbytes_disk = DiskUsage(report.filename);
+      const auto nbytes_new  = (nbytes_disk > report.nbytes_disk_before)
+                                 ? nbytes_disk - report.nbytes_disk_before
+                                 : 0;
+      const auto ratio = (nbytes_new > 0) ? (double)report.nbytes_raw /
+                                              (double)nbytes_new
+                                          : 0.0;
+      info::Print(fmt::format("%s output: %.3f MB -> %.3f MB (ratio %.2f) in %.3f s",
+                              WriteModeName(write_mode).c_str(),
+                              (double)report.nbytes_raw / 1e6,
+                              (double)nbytes_new / 1e6,
+                              ratio,
+                              report.seconds),
+                  false,
+                  false);
+    });
+  }
+
+  /**
+   * @brief Close the engine (waiting for the data to reach the disk)
+   */
+  void CloseWriter(WriteModeTags   write_mode,
+                   adios2::Engine& engine,
+                   WriteReport&    report) {
+    const auto start = std::chrono::steady_clock::now();
+    engine.Close();
+    report.seconds += std::chrono::duration<double>(
+                        std::chrono::steady_clock::now() - start)
+                        .count();
+    ReportWrite(write_mode, report);
+  }
+
+  void Writer::setCompression(const std::string& flds_type,
+                              const std::string& prtl_type,
+                              real_t             accuracy,
+                              unsigned short     level,
+                              bool               flds_single) {
+    raise::ErrorIf(p_adios == nullptr, "ADIOS pointer is null", HERE);
+    raise::ErrorIf(not m_flds_writers.empty(),
+                   "Compression must be set before the field outputs",
+                   HERE);
+    m_flds_compression = DefineCompression(p_adios, flds_type, accuracy, level);
+    m_prtl_compression = DefineCompression(p_adios, prtl_type, accuracy, level);
+    m_flds_single = flds_single and std::is_same<real_t, double>::value;
+  }
+
+  void Writer::compressParticleOutputs() {
+    if (not m_prtl_compression.enabled()) {
+      return;
+    }
+    const auto& op        = m_prtl_compression.op;
+    const auto& op_params = m_prtl_compression.params;
+    for (const auto& [name, _] : m_io.AvailableVariables()) {
+      // particle quantities are prefixed with `p`
+      if (name.rfind("p", 0) != 0) {
+        continue;
+      }
+      if (auto var = m_io.InquireVariable<real_t>(name)) {
+        var.AddOperation(op, op_params);
+      } else if (m_prtl_compression.is_lossless()) {
+        if (auto var_i = m_io.InquireVariable<npart_t>(name)) {
+          var_i.AddOperation(op, op_params);
+        }
+      }
+    }
+  }
+
   void Writer::defineMeshLayout(
     const std::vector<std::size_t>&              glob_shape,
     const std::vector<std::size_t>&              loc_corner,
@@ -69,54 +241,49 @@ namespace out {
     const std::pair<unsigned int, unsigned int>& domain_idx,
     const std::vector<unsigned int>&             dwn,
     bool                                         incl_ghosts,
-    Coord                                        coords) {
+    Coord                                        coords,
+    Downsampling                                 dwn_mode) {
     m_flds_ghosts = incl_ghosts;
     m_dwn         = dwn;
+    m_dwn_mode    = dwn_mode;
 
-    m_flds_g_shape  = glob_shape;
-    m_flds_l_corner = loc_corner;
-    m_flds_l_shape  = loc_shape;
+    m_flds_g_shape = glob_shape;
+    m_flds_g_shape_dwn.clear();
+    m_flds_blocks.clear();
 
     for (auto i { 0u }; i < glob_shape.size(); ++i) {
       raise::ErrorIf(dwn[i] != 1 && incl_ghosts,
                      "Downsampling with ghosts not supported",
                      HERE);
-
       const double g = glob_shape[i];
       const double d = m_dwn[i];
-      const double l = loc_corner[i];
-      const double n = loc_shape[i];
-      const double f = math::ceil(l / d) * d - l;
       m_flds_g_shape_dwn.push_back(static_cast<ncells_t>(math::ceil(g / d)));
-      m_flds_l_corner_dwn.push_back(static_cast<ncells_t>(math::ceil(l / d)));
-      m_flds_l_first.push_back(static_cast<ncells_t>(f));
-      m_flds_l_shape_dwn.push_back(static_cast<ncells_t>(math::ceil((n - f) / d)));
     }
+    addMeshBlock(loc_corner, loc_shape, domain_idx.first);
+    const auto& block = m_flds_blocks.front();
 
     m_io.DefineAttribute("NGhosts", incl_ghosts ? N_GHOSTS : 0);
     m_io.DefineAttribute("Dimension", m_flds_g_shape.size());
     m_io.DefineAttribute("Coordinates", std::string(coords.to_string()));
+    m_io.DefineAttribute("Downsampling", std::string(dwn_mode.to_string()));
 
+    // the selections are (re)set for each of the local blocks when writing
     for (auto i { 0u }; i < m_flds_g_shape.size(); ++i) {
       // cell-centers
       m_io.DefineVariable<real_t>("X" + std::to_string(i + 1),
                                   { m_flds_g_shape_dwn[i] },
-                                  { m_flds_l_corner_dwn[i] },
-                                  { m_flds_l_shape_dwn[i] },
-                                  adios2::ConstantDims);
+                                  { block.l_corner_dwn[i] },
+                                  { block.l_shape_dwn[i] });
       // cell-edges
-      const auto is_last = (m_flds_l_corner[i] + m_flds_l_shape[i] ==
-                            m_flds_g_shape[i]);
-      m_io.DefineVariable<real_t>("X" + std::to_string(i + 1) + "e",
-                                  { m_flds_g_shape_dwn[i] + 1 },
-                                  { m_flds_l_corner_dwn[i] },
-                                  { m_flds_l_shape_dwn[i] + (is_last ? 1 : 0) },
-                                  adios2::ConstantDims);
+      m_io.DefineVariable<real_t>(
+        "X" + std::to_string(i + 1) + "e",
+        { m_flds_g_shape_dwn[i] + 1 },
+        { block.l_corner_dwn[i] },
+        { block.l_shape_dwn[i] + (block.is_last[i] ? 1 : 0) });
       m_io.DefineVariable<std::size_t>("N" + std::to_string(i + 1) + "l",
                                        { 2 * domain_idx.second },
                                        { 2 * domain_idx.first },
-                                       { 2 },
-                                       adios2::ConstantDims);
+                                       { 2 });
     }
 
     if constexpr (std::is_same<typename ndfield_t<Dim::_3D, 6>::array_layout,
@@ -124,39 +291,86 @@ namespace out {
       m_io.DefineAttribute("LayoutRight", 1);
     } else {
       std::reverse(m_flds_g_shape_dwn.begin(), m_flds_g_shape_dwn.end());
-      std::reverse(m_flds_l_corner_dwn.begin(), m_flds_l_corner_dwn.end());
-      std::reverse(m_flds_l_shape_dwn.begin(), m_flds_l_shape_dwn.end());
       m_io.DefineAttribute("LayoutRight", 0);
     }
   }
 
+  auto Writer::addMeshBlock(const std::vector<std::size_t>& loc_corner,
+                            const std::vector<std::size_t>& loc_shape,
+                            unsigned int domain_idx) -> std::size_t {
+    raise::ErrorIf((loc_corner.size() != m_flds_g_shape.size()) ||
+                     (loc_shape.size() != m_flds_g_shape.size()),
+                   "Meshblock layout does not match the global one",
+                   HERE);
+    MeshBlock block;
+    block.domain_idx = domain_idx;
+    block.l_corner   = loc_corner;
+    block.l_shape    = loc_shape;
+    for (auto i { 0u }; i < m_flds_g_shape.size(); ++i) {
+      const double d = m_dwn[i];
+      const double l = loc_corner[i];
+      const double n = loc_shape[i];
+      const double f = math::ceil(l / d) * d - l;
+      block.l_corner_dwn.push_back(static_cast<ncells_t>(math::ceil(l / d)));
+      block.l_first.push_back(static_cast<ncells_t>(f));
+      block.l_shape_dwn.push_back(static_cast<ncells_t>(math::ceil((n - f) / d)));
+      block.is_last.push_back(loc_corner[i] + loc_shape[i] == m_flds_g_shape[i]);
+    }
+    m_flds_blocks.push_back(block);
+    return m_flds_blocks.size() - 1;
+  }
+
+  /**
+   * @brief Selection of a meshblock in the (downsampled) fields array
+   */
+  auto FieldSelection(const MeshBlock& block) -> adios2::Box<adios2::Dims> {
+    auto corner = block.l_corner_dwn;
+    auto shape  = block.l_shape_dwn;
+    if constexpr (not std::is_same<typename ndfield_t<Dim::_3D, 6>::array_layout,
+                                   Kokkos::LayoutRight>::value) {
+      std::reverse(corner.begin(), corner.end());
+      std::reverse(shape.begin(), shape.end());
+    }
+    return adios2::Box<adios2::Dims>(corner, shape);
+  }
+
   void Writer::defineFieldOutputs(const SimEngine&                S,
                                   const std::vector<std::string>& flds_out) {
     m_flds_writers.clear();
-    raise::ErrorIf((m_flds_g_shape_dwn.size() == 0) ||
-                     (m_flds_l_corner_dwn.size() == 0) ||
-                     (m_flds_l_shape_dwn.size() == 0),
+    raise::ErrorIf((m_flds_g_shape_dwn.size() == 0) || m_flds_blocks.empty(),
                    "Mesh layout must be defined before field output",
                    HERE);
+    const auto selection = FieldSelection(m_flds_blocks.front());
     for (const auto& fld : flds_out) {
       m_flds_writers.emplace_back(S, fld);
     }
+    const auto define = [&](const std::string& name) {
+      if (m_flds_single) {
+        auto var = m_io.DefineVariable<float>(name,
+                                              m_flds_g_shape_dwn,
+                                              selection.first,
+                                              selection.second);
+        if (m_flds_compression.enabled()) {
+          var.AddOperation(m_flds_compression.op, m_flds_compression.params);
+        }
+      } else {
+        auto var = m_io.DefineVariable<real_t>(name,
+                                               m_flds_g_shape_dwn,
+                                               selection.first,
+                                               selection.second);
+        if (m_flds_compression.enabled()) {
+          var.AddOperation(m_flds_compression.op, m_flds_compression.params);
+        }
+      }
+    };
     for (const auto& fld : m_flds_writers) {
       if (fld.comp.size() == 0) {
         // scalar
-        m_io.DefineVariable<real_t>(fld.name(),
-                                    m_flds_g_shape_dwn,
-                                    m_flds_l_corner_dwn,
-                                    m_flds_l_shape_dwn,
-                                    adios2::ConstantDims);
+        define(fld.name());
       } else {
         // vector or tensor
         for (auto i { 0u }; i < fld.comp.size(); ++i) {
-          m_io.DefineVariable<real_t>(fld.name(i),
-                                      m_flds_g_shape_dwn,
-                                      m_flds_l_corner_dwn,
-                                      m_flds_l_shape_dwn,
-                                      adios2::ConstantDims);
+          define(fld.name(i));
         }
       }
     }
@@ -173,10 +387,63 @@ namespace out {
     }
   }
 
+  void Writer::defineHistogramOutputs(const std::vector<OutputHistogram>& hists) {
+    m_histogram_writers.clear();
+    for (const auto& hist : hists) {
+      m_histogram_writers.push_back(hist);
+      m_io.DefineVariable<real_t>(hist.name(),
+                                  {},
+                                  {},
+                                  adios2::Dims(hist.n_bins.begin(),
+                                               hist.n_bins.end()));
+      for (auto d { 0u }; d < hist.axes.size(); ++d) {
+        m_io.DefineVariable<real_t>(hist.binsName(d),
+                                    {},
+                                    {},
+                                    { adios2::UnknownDim });
+      }
+    }
+  }
+
   void Writer::writeAttrs(const prm::Parameters& params) {
     params.write(m_io);
   }
 
+  /**
+   * @brief Combines the cells of a downsampled box into a single value
+   */
+  struct BoxReduction {
+    bool is_mean, is_max;
+
+    BoxReduction(Downsampling mode)
+      : is_mean { mode == Downsampling::MEAN }
+      , is_max { mode == Downsampling::MAX } {}
+
+    Inline auto init() const -> real_t {
+      if (is_mean) {
+        return ZERO;
+      } else if (is_max) {
+        return Kokkos::reduction_identity<real_t>::max();
+      } else {
+        return Kokkos::reduction_identity<real_t>::min();
+      }
+    }
+
+    Inline void add(real_t& acc, real_t value) const {
+      if (is_mean) {
+        acc += value;
+      } else if (is_max) {
+        acc = math::max(acc, value);
+      } else {
+        acc = math::min(acc, value);
+      }
+    }
+
+    Inline auto result(real_t acc, ncells_t ncells) const -> real_t {
+      return is_mean ? acc / static_cast<real_t>(ncells) : acc;
+    }
+  };
+
   template <Dimension D, int N>
   void WriteField(adios2::IO&               io,
                   adios2::Engine&           writer,
@@ -185,12 +452,18 @@ namespace out {
                   std::size_t               comp,
                   std::vector<unsigned int> dwn,
                   std::vector<ncells_t>     first_cell,
-                  bool                      ghosts) {
+                  bool                      ghosts,
+                  Downsampling              dwn_mode,
+                  bool                      single_precision) {
     // when dwn != 1 in any direction, it is assumed that ghosts == false
-    auto         var      = io.InquireVariable<real_t>(varname);
     const auto   gh_zones = ghosts ? 0 : N_GHOSTS;
     ndarray_t<D> output_field {};
 
+    // the boxes are aligned with the global grid, so a box crossing the
+    // upper subdomain boundary only includes the cells of this subdomain
+    const auto sample = (dwn_mode == Downsampling::SAMPLE);
+    const auto reduce = BoxReduction { dwn_mode };
+
     if constexpr (D == Dim::_1D) {
       if (ghosts || dwn[0] == 1) {
         auto slice_i1 = range_tuple_t(gh_zones, field.extent(0) - gh_zones);
@@ -203,17 +476,33 @@ namespace out {
         const double first_cell1_d = first_cell[0];
         const double nx1_full      = field.extent(0) - 2 * N_GHOSTS;
         const auto   first_cell1   = first_cell[0];
+        const auto   nx1           = static_cast<ncells_t>(nx1_full);
 
         const auto nx1_dwn = static_cast<ncells_t>(
           math::ceil((nx1_full - first_cell1_d) / dwn1));
 
         output_field = array_t<real_t*> { "output_field", nx1_dwn };
-        Kokkos::parallel_for(
-          "outputField",
-          nx1_dwn,
-          Lambda(index_t i1) {
-            output_field(i1) = field(first_cell1 + i1 * dwn1 + N_GHOSTS, comp);
-          });
+        if (sample) {
+          Kokkos::parallel_for(
+            "outputField",
+            nx1_dwn,
+            Lambda(index_t i1) {
+              output_field(i1) = field(first_cell1 + i1 * dwn1 + N_GHOSTS, comp);
+            });
+        } else {
+          Kokkos::parallel_for(
+            "outputFieldReduce",
+            nx1_dwn,
+            Lambda(index_t i1) {
+              const ncells_t j1_min = first_cell1 + i1 * dwn1;
+              const ncells_t j1_max = math::min(j1_min + dwn1, nx1);
+              auto           acc    = reduce.init();
+              for (auto j1 { j1_min }; j1 < j1_max; ++j1) {
+                reduce.add(acc, field(j1 + N_GHOSTS, comp));
+              }
+              output_field(i1) = reduce.result(acc, j1_max - j1_min);
+            });
+        }
       }
     } else if constexpr (D == Dim::_2D) {
       if (ghosts || (dwn[0] == 1 && dwn[1] == 1)) {
@@ -233,20 +522,43 @@ namespace out {
         const double nx2_full      = field.extent(1) - 2 * N_GHOSTS;
         const auto   first_cell1   = first_cell[0];
         const auto   first_cell2   = first_cell[1];
+        const auto   nx1           = static_cast<ncells_t>(nx1_full);
+        const auto   nx2           = static_cast<ncells_t>(nx2_full);
 
         const auto nx1_dwn = static_cast<ncells_t>(
           math::ceil((nx1_full - first_cell1_d) / dwn1));
         const auto nx2_dwn = static_cast<ncells_t>(
           math::ceil((nx2_full - first_cell2_d) / dwn2));
         output_field = array_t<real_t**> { "output_field", nx1_dwn, nx2_dwn };
-        Kokkos::parallel_for(
-          "outputField",
-          CreateRangePolicy<Dim::_2D>({ 0, 0 }, { nx1_dwn, nx2_dwn }),
-          Lambda(index_t i1, index_t i2) {
-            output_field(i1, i2) = field(first_cell1 + i1 * dwn1 + N_GHOSTS,
-                                         first_cell2 + i2 * dwn2 + N_GHOSTS,
-                                         comp);
-          });
+        if (sample) {
+          Kokkos::parallel_for(
+            "outputField",
+            CreateRangePolicy<Dim::_2D>({ 0, 0 }, { nx1_dwn, nx2_dwn }),
+            Lambda(index_t i1, index_t i2) {
+              output_field(i1, i2) = field(first_cell1 + i1 * dwn1 + N_GHOSTS,
+                                           first_cell2 + i2 * dwn2 + N_GHOSTS,
+                                           comp);
+            });
+        } else {
+          Kokkos::parallel_for(
+            "outputFieldReduce",
+            CreateRangePolicy<Dim::_2D>({ 0, 0 }, { nx1_dwn, nx2_dwn }),
+            Lambda(index_t i1, index_t i2) {
+              const ncells_t j1_min = first_cell1 + i1 * dwn1;
+              const ncells_t j2_min = first_cell2 + i2 * dwn2;
+              const ncells_t j1_max = math::min(j1_min + dwn1, nx1);
+              const ncells_t j2_max = math::min(j2_min + dwn2, nx2);
+              auto           acc    = reduce.init();
+              for (auto j1 { j1_min }; j1 < j1_max; ++j1) {
+                for (auto j2 { j2_min }; j2 < j2_max; ++j2) {
+                  reduce.add(acc, field(j1 + N_GHOSTS, j2 + N_GHOSTS, comp));
+                }
+              }
+              output_field(i1, i2) = reduce.result(
+                acc,
+                (j1_max - j1_min) * (j2_max - j2_min));
+            });
+        }
       }
     } else if constexpr (D == Dim::_3D) {
       if (ghosts || (dwn[0] == 1 && dwn[1] == 1 && dwn[2] == 1)) {
@@ -272,6 +584,9 @@ namespace out {
         const auto   first_cell1   = first_cell[0];
         const auto   first_cell2   = first_cell[1];
         const auto   first_cell3   = first_cell[2];
+        const auto   nx1           = static_cast<ncells_t>(nx1_full);
+        const auto   nx2           = static_cast<ncells_t>(nx2_full);
+        const auto   nx3           = static_cast<ncells_t>(nx3_full);
 
         const auto nx1_dwn = static_cast<ncells_t>(
           math::ceil((nx1_full - first_cell1_d) / dwn1));
@@ -281,41 +596,90 @@ namespace out {
           math::ceil((nx3_full - first_cell3_d) / dwn3));
 
         output_field = array_t<real_t***> { "output_field", nx1_dwn, nx2_dwn, nx3_dwn };
-        Kokkos::parallel_for(
-          "outputField",
-          CreateRangePolicy<Dim::_3D>({ 0, 0, 0 }, { nx1_dwn, nx2_dwn, nx3_dwn }),
-          Lambda(index_t i1, index_t i2, index_t i3) {
-            output_field(i1, i2, i3) = field(first_cell1 + i1 * dwn1 + N_GHOSTS,
-                                             first_cell2 + i2 * dwn2 + N_GHOSTS,
-                                             first_cell3 + i3 * dwn3 + N_GHOSTS,
-                                             comp);
-          });
+        if (sample) {
+          Kokkos::parallel_for(
+            "outputField",
+            CreateRangePolicy<Dim::_3D>({ 0, 0, 0 }, { nx1_dwn, nx2_dwn, nx3_dwn }),
+            Lambda(index_t i1, index_t i2, index_t i3) {
+              output_field(i1, i2, i3) = field(first_cell1 + i1 * dwn1 + N_GHOSTS,
+                                               first_cell2 + i2 * dwn2 + N_GHOSTS,
+                                               first_cell3 + i3 * dwn3 + N_GHOSTS,
+                                               comp);
+            });
+        } else {
+          Kokkos::parallel_for(
+            "outputFieldReduce",
+            CreateRangePolicy<Dim::_3D>({ 0, 0, 0 }, { nx1_dwn, nx2_dwn, nx3_dwn }),
+            Lambda(index_t i1, index_t i2, index_t i3) {
+              const ncells_t j1_min = first_cell1 + i1 * dwn1;
+              const ncells_t j2_min = first_cell2 + i2 * dwn2;
+              const ncells_t j3_min = first_cell3 + i3 * dwn3;
+              const ncells_t j1_max = math::min(j1_min + dwn1, nx1);
+              const ncells_t j2_max = math::min(j2_min + dwn2, nx2);
+              const ncells_t j3_max = math::min(j3_min + dwn3, nx3);
+              auto           acc    = reduce.init();
+              for (auto j1 { j1_min }; j1 < j1_max; ++j1) {
+                for (auto j2 { j2_min }; j2 < j2_max; ++j2) {
+                  for (auto j3 { j3_min }; j3 < j3_max; ++j3) {
+                    reduce.add(acc,
+                               field(j1 + N_GHOSTS, j2 + N_GHOSTS, j3 + N_GHOSTS, comp));
+                  }
+                }
+              }
+              output_field(i1, i2, i3) = reduce.result(
+                acc,
+                (j1_max - j1_min) * (j2_max - j2_min) * (j3_max - j3_min));
+            });
+        }
       }
     }
     auto output_field_h = Kokkos::create_mirror_view(output_field);
     Kokkos::deep_copy(output_field_h, output_field);
-    writer.Put(var, output_field_h, adios2::Mode::Sync);
+    if (single_precision) {
+      // the host copy is contiguous and ordered as the variable
+      const std::vector<float> output_field_f(
+        output_field_h.data(),
+        output_field_h.data() + output_field_h.size());
+      writer.Put(io.InquireVariable<float>(varname),
+                 output_field_f.data(),
+                 adios2::Mode::Sync);
+    } else {
+      writer.Put(io.InquireVariable<real_t>(varname),
+                 output_field_h,
+                 adios2::Mode::Sync);
+    }
   }
 
   template <Dimension D, int N>
   void Writer::writeField(const std::vector<std::string>& names,
                           const ndfield_t<D, N>&          fld,
-                          const std::vector<std::size_t>& addresses) {
+                          const std::vector<std::size_t>& addresses,
+                          std::size_t                     block_idx) {
     raise::ErrorIf(addresses.size() > N,
                    "addresses vector size must be less than N",
                    HERE);
     raise::ErrorIf(names.size() != addresses.size(),
                    "# of names != # of addresses ",
                    HERE);
+    raise::ErrorIf(block_idx >= m_flds_blocks.size(), "Invalid meshblock", HERE);
+    const auto& block     = m_flds_blocks[block_idx];
+    const auto  selection = FieldSelection(block);
     for (auto i { 0u }; i < addresses.size(); ++i) {
+      if (m_flds_single) {
+        m_io.InquireVariable<float>(names[i]).SetSelection(selection);
+      } else {
+        m_io.InquireVariable<real_t>(names[i]).SetSelection(selection);
+      }
       WriteField<D, N>(m_io,
                        m_writer,
                        names[i],
                        fld,
                        addresses[i],
                        m_dwn,
-                       m_flds_l_first,
-                       m_flds_ghosts);
+                       block.l_first,
+                       m_flds_ghosts,
+                       m_dwn_mode,
+                       m_flds_single);
     }
   }
 
@@ -363,6 +727,40 @@ namespace out {
 #endif
   }
 
+  void Writer::writeHistogram(const array_t<real_t*>& counts,
+                              const OutputHistogram&  hist) {
+    raise::ErrorIf(counts.extent(0) != hist.size(),
+                   "Histogram buffer has a wrong size",
+                   HERE);
+    auto var      = m_io.InquireVariable<real_t>(hist.name());
+    auto counts_h = Kokkos::create_mirror_view(counts);
+    Kokkos::deep_copy(counts_h, counts);
+    const adios2::Dims shape(hist.n_bins.begin(), hist.n_bins.end());
+#if defined(MPI_ENABLED)
+    // only the root rank writes the histogram summed over all ranks
+    array_h_t<real_t*> counts_h_all { "counts_all", counts.extent(0) };
+    int                rank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Reduce(counts_h.data(),
+               counts_h_all.data(),
+               counts_h.extent(0),
+               mpi::get_type<real_t>(),
+               MPI_SUM,
+               MPI_ROOT_RANK,
+               MPI_COMM_WORLD);
+    if (rank == MPI_ROOT_RANK) {
+      var.SetSelection(adios2::Box<adios2::Dims>({}, shape));
+      m_writer.Put<real_t>(var, counts_h_all.data(), adios2::Mode::Sync);
+    } else {
+      var.SetSelection(adios2::Box<adios2::Dims>({}, adios2::Dims(shape.size(), 0)));
+      m_writer.Put<real_t>(var, nullptr, adios2::Mode::Sync);
+    }
+#else
+    var.SetSelection(adios2::Box<adios2::Dims>({}, shape));
+    m_writer.Put<real_t>(var, counts_h.data(), adios2::Mode::Sync);
+#endif
+  }
+
   void Writer::writeSpectrumBins(const array_t<real_t*>& e_bins,
                                  const std::string&      varname) {
     auto var      = m_io.InquireVariable<real_t>(varname);
@@ -387,9 +785,17 @@ namespace out {
   void Writer::writeMesh(unsigned short                  dim,
                          const array_t<real_t*>&         xc,
                          const array_t<real_t*>&         xe,
-                         const std::vector<std::size_t>& loc_off_sz) {
+                         const std::vector<std::size_t>& loc_off_sz,
+                         std::size_t                     block_idx) {
+    raise::ErrorIf(block_idx >= m_flds_blocks.size(), "Invalid meshblock", HERE);
+    const auto& block = m_flds_blocks[block_idx];
     auto varc = m_io.InquireVariable<real_t>("X" + std::to_string(dim + 1));
     auto vare = m_io.InquireVariable<real_t>("X" + std::to_string(dim + 1) + "e");
+    varc.SetSelection(adios2::Box<adios2::Dims>({ block.l_corner_dwn[dim] },
+                                                { block.l_shape_dwn[dim] }));
+    vare.SetSelection(adios2::Box<adios2::Dims>(
+      { block.l_corner_dwn[dim] },
+      { block.l_shape_dwn[dim] + (block.is_last[dim] ? 1 : 0) }));
     auto xc_h = Kokkos::create_mirror_view(xc);
     auto xe_h = Kokkos::create_mirror_view(xe);
     Kokkos::deep_copy(xc_h, xc);
@@ -398,6 +804,8 @@ namespace out {
     m_writer.Put(vare, xe_h, adios2::Mode::Sync);
     auto vard = m_io.InquireVariable<std::size_t>(
       "N" + std::to_string(dim + 1) + "l");
+    vard.SetSelection(
+      adios2::Box<adios2::Dims>({ 2 * (std::size_t)block.domain_idx }, { 2 }));
     m_writer.Put(vard, loc_off_sz.data(), adios2::Mode::Sync);
   }
 
@@ -409,21 +817,15 @@ namespace out {
     if (m_active_mode != WriteMode::None) {
       raise::Fatal("Already writing", HERE);
     }
+    // back-pressure: the previous output of the same kind has to be on disk
+    // before the next one starts (any kind, when all share a single file)
+    waitForWriting(m_separate_files ? write_mode : WriteMode::None);
     try {
       path_t filename;
 
       const std::string ext = (m_engine == "hdf5") ? "h5" : "bp";
       if (m_separate_files) {
-        std::string mode_str;
-        if (write_mode == WriteMode::Fields) {
-          mode_str = "fields";
-        } else if (write_mode == WriteMode::Particles) {
-          mode_str = "particles";
-        } else if (write_mode == WriteMode::Spectra) {
-          mode_str = "spectra";
-        } else {
-          raise::Fatal("Unknown write mode", HERE);
-        }
+        const auto mode_str = WriteModeName(write_mode);
         CallOnce(
           [](auto&& main_path, auto&& mode_path) {
             const path_t main { main_path };
@@ -448,7 +850,19 @@ namespace out {
         m_mode   = std::filesystem::exists(filename) ? adios2::Mode::Append
                                                      : adios2::Mode::Write;
       }
-      m_writer = m_io.Open(filename, m_mode);
+      m_report         = {};
+      m_report.enabled = ((write_mode == WriteMode::Fields) and
+                          (m_flds_compression.enabled() or m_flds_single)) or
+                         ((write_mode == WriteMode::Particles) and
+                          m_prtl_compression.enabled());
+      if (m_report.enabled) {
+        m_report.filename = filename;
+        CallOnce([&]() {
+          m_report.nbytes_disk_before = DiskUsage(filename);
+        });
+      }
+      m_write_start = std::chrono::steady_clock::now();
+      m_writer      = m_io.Open(filename, m_mode);
       m_writer.BeginStep();
       m_writer.Put(m_io.InquireVariable<timestep_t>("Step"), &tstep);
       m_writer.Put(m_io.InquireVariable<simtime_t>("Time"), &time);
@@ -468,14 +882,71 @@ namespace out {
       raise::Fatal("Writing mode mismatch", HERE);
     }
     m_active_mode = WriteMode::None;
+    if (m_report.enabled) {
+      // uncompressed (real_t) size of the global arrays written in this step
+      if (write_mode == WriteMode::Fields) {
+        std::size_t ncells = 1;
+        for (const auto& n : m_flds_g_shape_dwn) {
+          ncells *= n;
+        }
+        for (const auto& fld : m_flds_writers) {
+          m_report.nbytes_raw += std::max(fld.comp.size(), (std::size_t)1) *
+                                 ncells * sizeof(real_t);
+        }
+      } else {
+        // (packed species records are 2D: quantities x particles)
+        const auto nelems = [](const adios2::Dims& shape) {
+          std::size_t n = 1;
+          for (const auto& s : shape) {
+            n *= s;
+          }
+          return n;
+        };
+        for (const auto& [name, _] : m_io.AvailableVariables()) {
+          if (name.rfind("p", 0) != 0) {
+            continue;
+          }
+          if (auto var = m_io.InquireVariable<real_t>(name)) {
+            m_report.nbytes_raw += nelems(var.Shape()) * sizeof(real_t);
+          } else if (auto var_i = m_io.InquireVariable<npart_t>(name)) {
+            m_report.nbytes_raw += nelems(var_i.Shape()) * sizeof(npart_t);
+          }
+        }
+      }
+    }
     m_writer.EndStep();
-    m_writer.Close();
+    m_report.seconds = std::chrono::duration<double>(
+                         std::chrono::steady_clock::now() - m_write_start)
+                         .count();
+    if (m_async) {
+      // closing blocks until the data is on disk, so it is deferred until
+      // the next output of the same kind (or `waitForWriting`)
+      m_pending_writers[write_mode] = { m_writer, m_report };
+    } else {
+      CloseWriter(write_mode, m_writer, m_report);
+    }
+  }
+
+  void Writer::waitForWriting(WriteModeTags write_mode) {
+    try {
+      for (auto it = m_pending_writers.begin(); it != m_pending_writers.end();) {
+        if ((write_mode == WriteMode::None) or (it->first == write_mode)) {
+          CloseWriter(it->first, it->second.first, it->second.second);
+          it = m_pending_writers.erase(it);
+        } else {
+          ++it;
+        }
+      }
+    } catch (std::exception& e) {
+      raise::Fatal(e.what(), HERE);
+    }
   }
 
 #define WRITE_FIELD(D, N)                                                      \
   template void Writer::writeField<D, N>(const std::vector<std::string>&,      \
                                          const ndfield_t<D, N>&,               \
-                                         const std::vector<std::size_t>&);     \
+                                         const std::vector<std::size_t>&,      \
+                                         std::size_t);                         \
   template void WriteField<D, N>(adios2::IO&,                                  \
                                  adios2::Engine&,                              \
                                  const std::string&,                           \
@@ -483,6 +954,8 @@ namespace out {
                                  std::size_t,                                  \
                                  std::vector<unsigned int>,                    \
                                  std::vector<ncells_t>,                        \
+                                 bool,                                         \
+                                 Downsampling,                                 \
                                  bool);
   WRITE_FIELD(Dim::_1D, 3)
   WRITE_FIELD(Dim::_1D, 6)
@@ -23,11 +23,72 @@
   #include <mpi.h>
 #endif
 
+#include <chrono>
+#include <map>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace out {
 
+  /**
+   * @brief Layout of a local meshblock within the global fields array
+   */
+  struct MeshBlock {
+    // index of the domain
+    unsigned int          domain_idx;
+    // local corner & shape of the fields array to output
+    std::vector<ncells_t> l_corner, l_shape;
+    // starting cell in each dimension (not including ghosts)
+    std::vector<ncells_t> l_first;
+    // same but downsampled
+    adios2::Dims          l_corner_dwn, l_shape_dwn;
+    // whether the block touches the upper edge in each dimension
+    std::vector<bool>     is_last;
+  };
+
+  /**
+   * @brief ADIOS2 compression operator attached to the output variables
+   */
+  struct Compression {
+    // "none", "blosc", "bzip2" (lossless) or "zfp", "sz", "mgard" (lossy)
+    std::string      type { "none" };
+    adios2::Operator op;
+    adios2::Params   params;
+
+    [[nodiscard]]
+    auto enabled() const -> bool {
+      return type != "none";
+    }
+
+    [[nodiscard]]
+    auto is_lossless() const -> bool {
+      return type == "blosc" || type == "bzip2";
+    }
+  };
+
+  /**
+   * @brief Define (or reuse) the ADIOS2 operator of a given type
+   * @param accuracy absolute error tolerance of the lossy operators
+   * @param level compression level of the lossless operators
+   * @note Unavailable operators fall back to blosc, then bzip2, then none
+   */
+  auto DefineCompression(adios2::ADIOS*,
+                         const std::string&,
+                         real_t,
+                         unsigned short) -> Compression;
+
+  /**
+   * @brief Raw vs on-disk size and duration of a single write
+   */
+  struct WriteReport {
+    path_t      filename;
+    std::size_t nbytes_raw { 0 };
+    std::size_t nbytes_disk_before { 0 };
+    double      seconds { 0.0 };
+    bool        enabled { false };
+  };
+
   class Writer {
     adios2::ADIOS* p_adios { nullptr };
 
@@ -37,22 +98,32 @@ namespace out {
 
     bool m_separate_files;
 
+    // if true, the data is written to disk in the background after `EndStep`
+    bool                                    m_async { false };
+    // engines with an unfinished asynchronous write (one per write mode)
+    std::map<WriteModeTags, std::pair<adios2::Engine, WriteReport>> m_pending_writers;
+
+    // compression of the field & particle outputs
+    Compression m_flds_compression, m_prtl_compression;
+    // if true (and real_t is double), fields are converted to float
+    bool        m_flds_single { false };
+    // report of the current write & when it started
+    WriteReport m_report;
+    std::chrono::steady_clock::time_point m_write_start;
+
     // global shape of the fields array to output
     std::vector<ncells_t> m_flds_g_shape;
-    // local corner of the fields array to output
-    std::vector<ncells_t> m_flds_l_corner;
-    // local shape of the fields array to output
-    std::vector<ncells_t> m_flds_l_shape;
 
     // downsampling factors for each dimension
     std::vector<unsigned int> m_dwn;
-    // starting cell in each dimension (not including ghosts)
-    std::vector<ncells_t>     m_flds_l_first;
+    // how the cells within each downsampled box are combined
+    Downsampling              m_dwn_mode { Downsampling::SAMPLE };
 
     // same but downsampled
     adios2::Dims m_flds_g_shape_dwn;
-    adios2::Dims m_flds_l_corner_dwn;
-    adios2::Dims m_flds_l_shape_dwn;
+
+    // layouts of the local meshblocks (one per local domain)
+    std::vector<MeshBlock> m_flds_blocks;
 
     bool        m_flds_ghosts;
     std::string m_engine;
@@ -61,7 +132,8 @@ namespace out {
     std::map<std::string, tools::Tracker> m_trackers;
 
     std::vector<OutputField>   m_flds_writers;
-    std::vector<OutputSpectra> m_spectra_writers;
+    std::vector<OutputSpectra>   m_spectra_writers;
+    std::vector<OutputHistogram> m_histogram_writers;
 
     std::vector<spidx_t> m_species_indices;
 
@@ -74,10 +146,32 @@ namespace out {
 
     Writer(Writer&&) = default;
 
-    void init(adios2::ADIOS*, const std::string&, const std::string&, bool);
+    void init(adios2::ADIOS*,
+              const std::string&,
+              const std::string&,
+              bool,
+              bool = false);
 
     void setMode(adios2::Mode);
 
+    /**
+     * @brief Set up the compression of the outputs
+     * @note Has to be called before the field/particle outputs are defined
+     * @note Unavailable operators fall back to blosc (byte-shuffle + zstd),
+     * ... then bzip2, and finally to no compression
+     */
+    void setCompression(const std::string&,
+                        const std::string&,
+                        real_t,
+                        unsigned short,
+                        bool);
+
+    /**
+     * @brief Attach the particle compression to the declared particle outputs
+     * @note Lossy operators are only applied to the floating-point quantities
+     */
+    void compressParticleOutputs();
+
     void addTracker(const std::string&, timestep_t, simtime_t);
     auto shouldWrite(const std::string&, timestep_t, simtime_t) -> bool;
 
@@ -89,20 +183,42 @@ namespace out {
                           const std::pair<unsigned int, unsigned int>&,
                           const std::vector<unsigned int>&,
                           bool,
-                          Coord);
+                          Coord,
+                          Downsampling = Downsampling::SAMPLE);
+
+    /**
+     * @brief Add a local meshblock to the layout defined in `defineMeshLayout`
+     * @param loc_corner The corner of the block in the global array
+     * @param loc_shape The shape of the block
+     * @param domain_idx The index of the domain
+     * @returns The index of the block (to be passed to `writeMesh`/`writeField`)
+     */
+    auto addMeshBlock(const std::vector<std::size_t>&,
+                      const std::vector<std::size_t>&,
+                      unsigned int) -> std::size_t;
+
+    /**
+     * @brief Drop the local meshblocks (e.g., when the domains are resized)
+     */
+    void clearMeshBlocks() {
+      m_flds_blocks.clear();
+    }
 
     void defineFieldOutputs(const SimEngine&, const std::vector<std::string>&);
     void defineSpectraOutputs(const std::vector<spidx_t>&);
+    void defineHistogramOutputs(const std::vector<OutputHistogram>&);
 
     void writeMesh(unsigned short,
                    const array_t<real_t*>&,
                    const array_t<real_t*>&,
-                   const std::vector<std::size_t>&);
+                   const std::vector<std::size_t>&,
+                   std::size_t = 0);
 
     template <Dimension D, int N>
     void writeField(const std::vector<std::string>&,
                     const ndfield_t<D, N>&,
-                    const std::vector<std::size_t>&);
+                    const std::vector<std::size_t>&,
+                    std::size_t = 0);
 
     void writeParticleQuantity(const array_t<real_t*>&,
                                npart_t,
@@ -110,10 +226,18 @@ namespace out {
                                const std::string&);
     void writeSpectrum(const array_t<real_t*>&, const std::string&);
     void writeSpectrumBins(const array_t<real_t*>&, const std::string&);
+    void writeHistogram(const array_t<real_t*>&, const OutputHistogram&);
 
     void beginWriting(WriteModeTags, timestep_t, simtime_t);
     void endWriting(WriteModeTags);
 
+    /**
+     * @brief Block until the pending asynchronous writes are finished
+     * @param write_mode only wait for the given mode (all modes if None)
+     * @note Collective: has to be called by all ranks in the same order
+     */
+    void waitForWriting(WriteModeTags = WriteMode::None);
+
     void addSpeciesIndex(spidx_t idx) {
       m_species_indices.push_back(idx);
     }
@@ -143,6 +267,16 @@ namespace out {
       return m_root;
     }
 
+    [[nodiscard]]
+    auto meshBlocks() const -> const std::vector<MeshBlock>& {
+      return m_flds_blocks;
+    }
+
+    [[nodiscard]]
+    auto fieldsWithGhosts() const -> bool {
+      return m_flds_ghosts;
+    }
+
     [[nodiscard]]
     auto fieldWriters() const -> const std::vector<OutputField>& {
       return m_flds_writers;
@@ -152,6 +286,11 @@ namespace out {
     auto spectraWriters() const -> const std::vector<OutputSpectra>& {
       return m_spectra_writers;
     }
+
+    [[nodiscard]]
+    auto histogramWriters() const -> const std::vector<OutputHistogram>& {
+      return m_histogram_writers;
+    }
   };
 
 } // namespace out